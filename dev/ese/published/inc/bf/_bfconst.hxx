@@ -218,6 +218,7 @@ enum BFRequestTraceFlags
     bfrtfUseHistory         = 0x00000004,
     bfrtfFileCacheEnabled   = 0x00000008,
     bfrtfDBScan             = 0x00000010,
+    bfrtfPrefetchHit        = 0x00000020,
 };
 
 enum BFCleanFlags
@@ -9,6 +9,13 @@ typedef unsigned __int64 XECHECKSUM;
 
 ULONG ChecksumOldFormat( const unsigned char * const pb, const ULONG cb );
 XECHECKSUM ChecksumNewFormat( const unsigned char * const pb, const ULONG cb, const ULONG pgno, BOOL fHeaderBlock = fTrue );
+void ChecksumNewFormatMultiple(
+    const unsigned char * const * const rgpb,
+    const ULONG cb,
+    const ULONG * const rgpgno,
+    BOOL fHeaderBlock,
+    XECHECKSUM * const rgxeChecksum,
+    const ULONG cpb );
 
 ULONG DwECCChecksumFromXEChecksum( const XECHECKSUM checksum );
 ULONG DwXORChecksumFromXEChecksum( const XECHECKSUM checksum );
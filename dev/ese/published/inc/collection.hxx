@@ -2915,8 +2915,12 @@ class CPool
         ERR ErrInit( const double dblSpeedSizeTradeoff );
         void Term();
 
-        void Insert( CObject* const pobj, const BOOL fMRU = fTrue );
-        ERR ErrRemove( CObject** const ppobj, const INT cmsecTimeout = cmsecInfinite, const BOOL fMRU = fTrue );
+        void Insert( CObject* const pobj, const BOOL fMRU = fTrue, const INT iprocPreferred = -1 );
+        ERR ErrRemove(  CObject** const     ppobj,
+                        const INT           cmsecTimeout        = cmsecInfinite,
+                        const BOOL          fMRU                = fTrue,
+                        const INT* const    rgiprocPreferred    = NULL,
+                        const INT           ciprocPreferred     = 0 );
 
         void BeginPoolScan( CLock* const plock );
         ERR ErrGetNextObject( CLock* const plock, CObject** const ppobj );
@@ -3015,7 +3019,10 @@ ErrInit( const double dblSpeedSizeTradeoff )
     }
 
 
-    m_cbucket = OSSyncGetProcessorCount();
+    //  one bucket per possible processor index so that a preferred processor
+    //  passed to Insert() or ErrRemove() always names its own bucket
+
+    m_cbucket = OSSyncGetProcessorCountMax();
     const SIZE_T cbrgbucket = sizeof( CBucket ) * m_cbucket;
     if ( !( m_rgbucket = (CBucket*)_PvMEMAlloc( cbrgbucket, cbCacheLine ) ) )
     {
@@ -3061,10 +3068,12 @@ Term()
 
 template< class CObject, PfnOffsetOf OffsetOfIC >
 inline void CPool< CObject, OffsetOfIC >::
-Insert( CObject* const pobj, const BOOL fMRU )
+Insert( CObject* const pobj, const BOOL fMRU, const INT iprocPreferred )
 {
 
-    const DWORD_PTR ibucketBase = ( fMRU ? OSSyncGetCurrentProcessor() : ( DWORD_PTR( pobj ) / sizeof( CObject ) ) );
+    const DWORD_PTR ibucketBase = ( iprocPreferred >= 0 ?
+                                        iprocPreferred :
+                                        ( fMRU ? OSSyncGetCurrentProcessor() : ( DWORD_PTR( pobj ) / sizeof( CObject ) ) ) );
     DWORD           ibucket     = 0;
 
     do  {
@@ -3103,7 +3112,11 @@ Insert( CObject* const pobj, const BOOL fMRU )
 
 template< class CObject, PfnOffsetOf OffsetOfIC >
 inline typename CPool< CObject, OffsetOfIC >::ERR CPool< CObject, OffsetOfIC >::
-ErrRemove( CObject** const ppobj, const INT cmsecTimeout, const BOOL fMRU )
+ErrRemove(  CObject** const     ppobj,
+            const INT           cmsecTimeout,
+            const BOOL          fMRU,
+            const INT* const    rgiprocPreferred,
+            const INT           ciprocPreferred )
 {
 
     *ppobj = NULL;
@@ -3125,10 +3138,36 @@ ErrRemove( CObject** const ppobj, const INT cmsecTimeout, const BOOL fMRU )
     }
 
 
+    //  try the preferred buckets first without blocking.  we own a count on the
+    //  semaphore so an object is guaranteed to be somewhere in the pool and the
+    //  full scan below will find it if none of the preferred buckets yield one
+
+    const INT iiprocBase = ciprocPreferred > 0 ? OSSyncGetCurrentProcessor() % ciprocPreferred : 0;
+
+    for ( INT iiproc = 0; iiproc < ciprocPreferred && *ppobj == NULL; iiproc++ )
+    {
+        const INT       iproc   = rgiprocPreferred[ ( iiprocBase + iiproc ) % ciprocPreferred ];
+        CBucket* const  pbucket = m_rgbucket + DWORD( iproc ) % m_cbucket;
+
+        if ( pbucket->m_il.FEmpty() || !pbucket->m_crit.FTryEnter() )
+        {
+            continue;
+        }
+
+        if ( !pbucket->m_il.FEmpty() )
+        {
+            *ppobj = fMRU ? pbucket->m_il.PrevMost() : pbucket->m_il.NextMost();
+            pbucket->m_il.Remove( *ppobj );
+        }
+        pbucket->m_crit.Leave();
+    }
+
+
     const DWORD ibucketBase = OSSyncGetCurrentProcessor();
     DWORD       ibucket     = 0;
 
-    do  {
+    while ( *ppobj == NULL )
+    {
         CBucket* const pbucket = m_rgbucket + ( ibucketBase + ibucket++ ) % m_cbucket;
 
         if ( pbucket->m_il.FEmpty() )
@@ -3162,7 +3201,6 @@ ErrRemove( CObject** const ppobj, const INT cmsecTimeout, const BOOL fMRU )
         }
         pbucket->m_crit.Leave();
     }
-    while ( *ppobj == NULL );
 
 
     AtomicIncrement( (LONG*)&m_cRemove );
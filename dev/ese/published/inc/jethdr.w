@@ -534,6 +534,7 @@ typedef void (JET_API *JET_SPCATCALLBACK)( _In_ const unsigned long pgno, _In_ c
 #define JET_efvXpress10Compression                          9340
 #define JET_efvRevertSnapshot                               9360
 #define JET_efvApplyRevertSnapshot                          9380
+#define JET_efvCompressionDictionaries                      9400
 
 #define JET_efvUseEngineDefault             (0x40000001)
 #define JET_efvUsePersistedFormat           (0x40000002)
@@ -4098,6 +4099,23 @@ typedef struct
     JET_ERR             err;
 } JET_RETRIEVECOLUMN;
 
+#if ( JET_VERSION >= 0x0A01 )
+
+typedef struct
+{
+    const void *        pvBookmark;
+    unsigned long       cbBookmark;
+    JET_COLUMNID        columnid;
+    unsigned long       itagSequence;
+    unsigned long       ibLongValue;
+    void *              pvData;
+    unsigned long       cbData;
+    unsigned long       cbActual;
+    JET_ERR             err;
+} JET_RETRIEVELONGVALUE;
+
+#endif
+
 
 typedef struct
 {
@@ -4567,6 +4585,7 @@ typedef JET_ERR (JET_API * JET_PFNEMITLOGDATA)(
 #if ( JET_VERSION >= 0x0A01 )
 #define JET_TblInfoLVChunkMax   13U
 #define JET_TblInfoEncryptionKey    14U
+#define JET_TblInfoCompressionDictionary    15U
 #endif
 
 
@@ -5422,6 +5441,7 @@ typedef JET_ERR (JET_API * JET_PFNEMITLOGDATA)(
 #define JET_errUpdateMustVersion            -1621
 #define JET_errDecryptionFailed             -1622
 #define JET_errEncryptionBadItag            -1623
+#define JET_errCompressionDictionaryLimit   -1624
 
 
 #define JET_errTooManySorts                 -1701
@@ -10587,6 +10607,20 @@ JET_ERR JET_API JetPrereadColumnsByReference(
     _Out_opt_ unsigned long * const                         pcReferencesPreread,
     _In_ const JET_GRBIT                                    grbit );
 
+JET_ERR JET_API JetRetrieveLongValues(
+    _In_ const JET_SESID                                            sesid,
+    _In_ const JET_TABLEID                                          tableid,
+    _Inout_updates_( cretrievelv ) JET_RETRIEVELONGVALUE * const    rgretrievelv,
+    _In_ const unsigned long                                        cretrievelv,
+    _In_ const JET_GRBIT                                            grbit );
+
+JET_ERR JET_API JetPrepareRetrieveColumns(
+    _In_ const JET_SESID                                                sesid,
+    _In_ const JET_TABLEID                                              tableid,
+    _In_reads_opt_( cretrievecolumn ) const JET_RETRIEVECOLUMN * const  rgretrievecolumn,
+    _In_ const unsigned long                                            cretrievecolumn,
+    _In_ const JET_GRBIT                                                grbit );
+
 #endif
 
 #if ( JET_VERSION >= 0x0A01 )
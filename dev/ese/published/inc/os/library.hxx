@@ -81,6 +81,12 @@ INLINE Ret ErrorFailed( Args... )
     return Ret( ErrorThunkNotSupported() );
 }
 
+template< typename Ret, typename... Args >
+INLINE Ret HrFailed( Args... )
+{
+    return Ret( HRESULT_FROM_WIN32( ErrorThunkNotSupported() ) );
+}
+
 template< typename Ret, typename... Args >
 INLINE Ret PnullFailedWithGLE( Args... )
 {
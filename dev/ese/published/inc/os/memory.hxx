@@ -145,6 +145,16 @@ VOID OSMemoryPageResidenceMapScanStop();
 BOOL FOSMemoryPageResident( void* const pv, const size_t cb );
 
 
+const DWORD cOSMemoryNumaNodeMax    = 64;
+const DWORD iOSMemoryNumaNodeNil    = DWORD( ~0 );
+
+DWORD OSMemoryNumaNodeCount();
+DWORD OSMemoryNumaNodeProcessor( const INT iProc );
+DWORD OSMemoryNumaNodeCurrent();
+
+BOOL FOSMemoryPageNumaNode( const void* const pv, DWORD* const piNode );
+
+
 
 BOOL FOSMemoryPageAllocated( const void * const pv, const size_t cb );
 
@@ -280,6 +290,8 @@ void OSMemoryPageUnprotect( void* const pv, const size_t cbSize );
 
 BOOL FOSMemoryPageCommit( void* const pv, const size_t cb );
 
+BOOL FOSMemoryPageCommitNuma( void* const pv, const size_t cb, const DWORD iNode );
+
 
 void OSMemoryPageDecommit( void* const pv, const size_t cb );
 
@@ -142,6 +142,12 @@ class ICache
             cpBestEffort = 1,
         };
 
+
+        //  Reads issued with this QOS are read-ahead from a file filter.  They are not reported
+        //  as cache requests.
+
+        static const OSFILEQOS qosPrefetch = qosIODispatchBackground | qosIOOSLowPriority;
+
     public:
 
         virtual ~ICache() {}
@@ -266,6 +272,14 @@ class ICacheTelemetry
         virtual void Evict( _In_ const FileNumber   filenumber, 
                             _In_ const BlockNumber  blocknumber,
                             _In_ const BOOL         fReplacementPolicy ) = 0;
+
+
+        virtual void Prefetch(  _In_ const FileNumber   filenumber,
+                                _In_ const BlockNumber  blocknumber ) = 0;
+
+
+        virtual void PrefetchHit(   _In_ const FileNumber   filenumber,
+                                    _In_ const BlockNumber  blocknumber ) = 0;
 };
 
 constexpr ICacheTelemetry::FileNumber filenumberInvalid = ICacheTelemetry::FileNumber::filenumberInvalid;
@@ -542,5 +556,10 @@ ERR ErrOSBCCreateJournal(   _Inout_ IJournalSegmentManager** const  ppjsm,
                             _In_    const size_t                    cbCache,
                             _Out_   IJournal** const                ppj );
 
+ERR ErrOSBCGetHashedLRUKCacheJournal(   _In_    IFileSystemConfiguration* const pfsconfig,
+                                        _In_    IFileFilter* const              pff,
+                                        _Out_   QWORD* const                    pibJournal,
+                                        _Out_   QWORD* const                    pcbJournal );
+
 #endif
 
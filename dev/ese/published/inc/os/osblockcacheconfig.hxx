@@ -25,6 +25,9 @@ class ICachedFileConfiguration
         virtual ULONG CConcurrentBlockWriteBackMax() = 0;
 
 
+        virtual ULONG CBlockPrefetchMax() = 0;
+
+
         virtual ULONG LCacheTelemetryFileNumber() = 0;
 };
 
@@ -41,6 +44,7 @@ class CDefaultCachedFileConfiguration : public ICachedFileConfiguration
         VOID CachingFilePath( __out_bcount( cbOSFSAPI_MAX_PATHW ) WCHAR* const wszAbsPath ) override;
         ULONG CbBlockSize() override;
         ULONG CConcurrentBlockWriteBackMax() override;
+        ULONG CBlockPrefetchMax() override;
         ULONG LCacheTelemetryFileNumber() override;
 
     protected:
@@ -49,6 +53,7 @@ class CDefaultCachedFileConfiguration : public ICachedFileConfiguration
         WCHAR   m_wszAbsPathCachingFile[ OSFSAPI_MAX_PATH ];
         ULONG   m_cbBlockSize;
         ULONG   m_cConcurrentBlockWriteBackMax;
+        ULONG   m_cBlockPrefetchMax;
         ULONG   m_lCacheTelemetryFileNumber;
 };
 
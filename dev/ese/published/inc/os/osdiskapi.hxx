@@ -130,5 +130,10 @@ public:
 #define bitUseMetedQEseTasks	0x8
 #define bitNewQueueOptionsMask  ( bitUseMetedQ | bitAllowIoBoost | bitUseMetedQEseTasks )
 
+
+BOOL FOSDiskRegistersIOBuffers();
+BOOL FOSDiskRegisterIOBuffer( void * const pv, const size_t cb );
+void OSDiskUnregisterIOBuffer( void * const pv, const size_t cb );
+
 #endif
 
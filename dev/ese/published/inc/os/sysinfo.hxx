@@ -19,6 +19,12 @@ BOOL FPopcntAvailable();
 BOOL FAVXEnabled();
 
 
+BOOL FAVX2Enabled();
+
+
+BOOL FAVX512Enabled();
+
+
 
 
 DWORD DwUtilSystemVersionMajor();
@@ -263,6 +263,25 @@ class CGPTaskManager
 };
 
 
+
+//  Runs cjob jobs on the calling thread and on up to cthreadMax - 1 tasks posted to ptaskmgr,
+//  and returns once every job has finished.  Posted tasks that start after the last job is
+//  taken return without touching pvJobs, so the job state may live on the caller's stack.
+//  pfnWorker, if given, is called with fTrue on a posted task before its first job and with
+//  fFalse after its last one (it is never called on the calling thread).  Without ptaskmgr,
+//  or if the tracking state cannot be allocated, the jobs simply run on the calling thread.
+
+typedef VOID (*PFNTMJOB)( VOID * const pvJobs, const LONG ijob );
+typedef VOID (*PFNTMWORKER)( VOID * const pvWorker, const BOOL fEnter );
+
+VOID TMRunJobs( CGPTaskManager * const  ptaskmgr,
+                const LONG              cthreadMax,
+                const PFNTMJOB          pfnJob,
+                VOID * const            pvJobs,
+                const LONG              cjob,
+                const PFNTMWORKER       pfnWorker   = NULL,
+                VOID * const            pvWorker    = NULL );
+
 BOOL FOSTaskIsTaskThread( void );
 
 #endif
@@ -3271,6 +3271,431 @@ _ValidateTickProgress( __in_z const WCHAR * szStateVarName, const TICK tickStore
 }
 
 
+template< INT m_cShardMax, INT m_Kmax, class CResource, PfnOffsetOf OffsetOfIC, class CKey, CKey (*PfnKeyOfResource)( const CResource* const ) >
+class CShardedLRUKResourceUtilityManager
+{
+    public:
+
+        typedef CLRUKResourceUtilityManager< m_Kmax, CResource, OffsetOfIC, CKey > CShard;
+
+        typedef typename CShard::TICK               TICK;
+        typedef typename CShard::ERR                ERR;
+        typedef typename CShard::ResMgrTouchFlags   ResMgrTouchFlags;
+        typedef typename CShard::CInvasiveContext   CInvasiveContext;
+        typedef typename CShard::CHistory           CHistory;
+
+        enum { tickUnindexed = CShard::tickUnindexed };
+        static const ResMgrTouchFlags kNoTouch             = CShard::kNoTouch;
+        static const ResMgrTouchFlags k1Touch              = CShard::k1Touch;
+        static const ResMgrTouchFlags k2Touch              = CShard::k2Touch;
+        static const ResMgrTouchFlags k1CorrelatedTouch    = CShard::k1CorrelatedTouch;
+
+
+        class CLock
+        {
+            public:
+
+                CLock() :
+                    m_ishard( 0 ),
+                    m_fShardScan( fFalse ),
+                    m_fScanHorizon( fFalse ),
+                    m_fScanHorizonLow( fFalse ),
+                    m_fShardBeyondHorizon( fFalse ),
+                    m_tickHorizonLow( 0 ),
+                    m_tickHorizonHigh( 0 ),
+                    m_tickBeyondHorizonMin( 0 )
+                {
+                }
+                ~CLock() {}
+
+            private:
+
+                friend class CShardedLRUKResourceUtilityManager< m_cShardMax, m_Kmax, CResource, OffsetOfIC, CKey, PfnKeyOfResource >;
+
+                typename CShard::CLock  m_lock;
+                INT                     m_ishard;
+                BOOL                    m_fShardScan;
+
+                BOOL                    m_fScanHorizon;
+                BOOL                    m_fScanHorizonLow;
+                BOOL                    m_fShardBeyondHorizon;
+                TICK                    m_tickHorizonLow;
+                TICK                    m_tickHorizonHigh;
+                TICK                    m_tickBeyondHorizonMin;
+        };
+
+    public:
+
+        CShardedLRUKResourceUtilityManager( const INT Rank );
+        ~CShardedLRUKResourceUtilityManager();
+
+        void SetTimeBar( const TICK dtickHighBar, const TICK dtickLifetimeBar );
+#ifdef DEBUG
+        void SetFaultInjection( DWORD grbit );
+#endif
+        ERR ErrInit(    const INT       K,
+                        const double    csecCorrelatedTouch,
+                        const double    csecTimeout,
+                        const double    csecUncertainty,
+                        const double    dblHashLoadFactor,
+                        const double    dblHashUniformity,
+                        const double    dblSpeedSizeTradeoff,
+                        const INT       cShard = 1 );
+        void Term();
+
+        INT CShards() const { return m_cShard; }
+
+        ERR ErrCacheResource( const CKey& key, CResource* const pres, __in TICK tickNowExternal, const ULONG_PTR pctCachePriorityExternal, const BOOL fUseHistory = fTrue, __out_opt BOOL * pfInHistory = NULL, const CResource* const presHistoryProvided = NULL )
+        {
+            return _Shard( _IshardFromKey( key ) ).ErrCacheResource( key, pres, tickNowExternal, pctCachePriorityExternal, fUseHistory, pfInHistory, presHistoryProvided );
+        }
+        ResMgrTouchFlags RmtfTouchResource( CResource* const pres, const ULONG_PTR pctCachePriorityExternal, const TICK tickNowExternal = TickRESMGRTimeCurrent() )
+        {
+            return _Shard( _IshardFromPres( pres ) ).RmtfTouchResource( pres, pctCachePriorityExternal, tickNowExternal );
+        }
+        void PuntResource( CResource* const pres, const TICK dtick )
+        {
+            _Shard( _IshardFromPres( pres ) ).PuntResource( pres, dtick );
+        }
+        BOOL FRecentlyTouched( CResource* const pres, const TICK dtickRecent )
+        {
+            return _Shard( _IshardFromPres( pres ) ).FRecentlyTouched( pres, dtickRecent );
+        }
+        BOOL FSuperHotResource( CResource* const pres )
+        {
+            return _Shard( _IshardFromPres( pres ) ).FSuperHotResource( pres );
+        }
+        void MarkAsSuperCold( CResource* const pres )
+        {
+            _Shard( _IshardFromPres( pres ) ).MarkAsSuperCold( pres );
+        }
+        ERR ErrEvictResource( const CKey& key, CResource* const pres, const BOOL fKeepHistory = fTrue )
+        {
+            return _Shard( _IshardFromKey( key ) ).ErrEvictResource( key, pres, fKeepHistory );
+        }
+
+        void LockResourceForEvict( CResource* const pres, CLock* const plock );
+        void UnlockResourceForEvict( CLock* const plock );
+
+        void BeginResourceScan( CLock* const plock );
+        ERR ErrGetCurrentResource( CLock* const plock, CResource** const ppres );
+        ERR ErrGetNextResource( CLock* const plock, CResource** const ppres );
+        ERR ErrEvictCurrentResource( CLock* const plock, const CKey& key, const BOOL fKeepHistory = fTrue );
+        void EndResourceScan( CLock* const plock );
+
+        DWORD CHistoryRecord()                      { return _DwSum( &CShard::CHistoryRecord ); }
+        DWORD CHistoryHit()                         { return _DwSum( &CShard::CHistoryHit ); }
+        DWORD CHistoryRequest()                     { return _DwSum( &CShard::CHistoryRequest ); }
+
+        DWORD CResourceScanned()                    { return _DwSum( &CShard::CResourceScanned ); }
+        DWORD CResourceScannedMoves()               { return _DwSum( &CShard::CResourceScannedMoves ); }
+        DWORD CResourceScannedOutOfOrder()          { return _DwSum( &CShard::CResourceScannedOutOfOrder ); }
+
+        LONG DtickScanFirstEvictedIndexTarget() const       { return _LMax( &CShard::DtickScanFirstEvictedIndexTarget ); }
+        LONG DtickScanFirstEvictedIndexTargetHW() const     { return _LMax( &CShard::DtickScanFirstEvictedIndexTargetHW ); }
+        LONG DtickScanFirstFoundNormal() const              { return _LMax( &CShard::DtickScanFirstFoundNormal ); }
+        LONG DtickScanFirstEvictedIndexTargetVar() const    { return _LMax( &CShard::DtickScanFirstEvictedIndexTargetVar ); }
+        LONG DtickScanFirstEvictedTouchK1() const           { return _LMax( &CShard::DtickScanFirstEvictedTouchK1 ); }
+        LONG DtickScanFirstEvictedTouchK2() const           { return _LMax( &CShard::DtickScanFirstEvictedTouchK2 ); }
+
+        LONG DtickFoundToEvictDelta() const         { return _LMax( &CShard::DtickFoundToEvictDelta ); }
+
+        LONG CLastScanEnumeratedEntries() const     { return _LSum( &CShard::CLastScanEnumeratedEntries ); }
+        LONG CLastScanBucketsScanned() const        { return _LSum( &CShard::CLastScanBucketsScanned ); }
+        LONG CLastScanEmptyBucketsScanned() const   { return _LSum( &CShard::CLastScanEmptyBucketsScanned ); }
+        LONG CLastScanEnumeratedIDRange() const     { return _LSum( &CShard::CLastScanEnumeratedIDRange ); }
+        LONG DtickLastScanEnumeratedRange() const   { return _LMax( &CShard::DtickLastScanEnumeratedRange ); }
+
+        LONG CSuperColdedResources() const          { return _LSum( &CShard::CSuperColdedResources ); }
+
+        LONG CSuperColdAttempts() const             { return _LSum( &CShard::CSuperColdAttempts ); }
+        LONG CSuperColdSuccesses() const            { return _LSum( &CShard::CSuperColdSuccesses ); }
+
+    private:
+
+        CShard& _Shard( const INT ishard )              { RESMGRAssert( ishard >= 0 && ishard < m_cShard ); return *(CShard*)m_rgqwShard[ ishard ]; }
+        const CShard& _Shard( const INT ishard ) const  { RESMGRAssert( ishard >= 0 && ishard < m_cShard ); return *(const CShard*)m_rgqwShard[ ishard ]; }
+
+        INT _IshardFromKey( const CKey& key ) const
+        {
+            return INT( ( ( ULONG( key.Hash() ) * 0x9E3779B1 ) >> 16 ) % ULONG( m_cShard ) );
+        }
+        INT _IshardFromPres( const CResource* const pres ) const
+        {
+            return _IshardFromKey( PfnKeyOfResource( pres ) );
+        }
+        static TICK _TickIndexTarget( const CResource* const pres )
+        {
+            return ( (const CInvasiveContext*)( (const BYTE*)pres + OffsetOfIC() ) )->TickIndexTargetTime();
+        }
+
+        DWORD _DwSum( DWORD (CShard::*pfn)() )
+        {
+            DWORD dw = 0;
+            for ( INT ishard = 0; ishard < m_cShard; ishard++ )
+            {
+                dw += ( _Shard( ishard ).*pfn )();
+            }
+            return dw;
+        }
+        LONG _LSum( LONG (CShard::*pfn)() const ) const
+        {
+            LONG l = 0;
+            for ( INT ishard = 0; ishard < m_cShard; ishard++ )
+            {
+                l += ( _Shard( ishard ).*pfn )();
+            }
+            return l;
+        }
+        LONG _LMax( LONG (CShard::*pfn)() const ) const
+        {
+            LONG l = ( _Shard( 0 ).*pfn )();
+            for ( INT ishard = 1; ishard < m_cShard; ishard++ )
+            {
+                l = max( l, ( _Shard( ishard ).*pfn )() );
+            }
+            return l;
+        }
+
+    private:
+
+        QWORD           m_rgqwShard[ m_cShardMax ][ ( sizeof( CShard ) + sizeof( QWORD ) - 1 ) / sizeof( QWORD ) ];
+        INT             m_cShard;
+        TICK            m_dtickHorizon;
+};
+
+
+template< INT m_cShardMax, INT m_Kmax, class CResource, PfnOffsetOf OffsetOfIC, class CKey, CKey (*PfnKeyOfResource)( const CResource* const ) >
+inline CShardedLRUKResourceUtilityManager< m_cShardMax, m_Kmax, CResource, OffsetOfIC, CKey, PfnKeyOfResource >::
+CShardedLRUKResourceUtilityManager( const INT Rank )
+    :   m_cShard( 1 ),
+        m_dtickHorizon( 0 )
+{
+    for ( INT ishard = 0; ishard < m_cShardMax; ishard++ )
+    {
+        new( m_rgqwShard[ ishard ] ) CShard( Rank );
+    }
+}
+
+
+template< INT m_cShardMax, INT m_Kmax, class CResource, PfnOffsetOf OffsetOfIC, class CKey, CKey (*PfnKeyOfResource)( const CResource* const ) >
+inline CShardedLRUKResourceUtilityManager< m_cShardMax, m_Kmax, CResource, OffsetOfIC, CKey, PfnKeyOfResource >::
+~CShardedLRUKResourceUtilityManager()
+{
+    for ( INT ishard = 0; ishard < m_cShardMax; ishard++ )
+    {
+        ( (CShard*)m_rgqwShard[ ishard ] )->~CShard();
+    }
+}
+
+
+template< INT m_cShardMax, INT m_Kmax, class CResource, PfnOffsetOf OffsetOfIC, class CKey, CKey (*PfnKeyOfResource)( const CResource* const ) >
+inline void CShardedLRUKResourceUtilityManager< m_cShardMax, m_Kmax, CResource, OffsetOfIC, CKey, PfnKeyOfResource >::
+SetTimeBar( const TICK dtickLifetimeBar, const TICK dtickHighBar )
+{
+    for ( INT ishard = 0; ishard < m_cShardMax; ishard++ )
+    {
+        ( (CShard*)m_rgqwShard[ ishard ] )->SetTimeBar( dtickLifetimeBar, dtickHighBar );
+    }
+}
+
+#ifdef DEBUG
+
+template< INT m_cShardMax, INT m_Kmax, class CResource, PfnOffsetOf OffsetOfIC, class CKey, CKey (*PfnKeyOfResource)( const CResource* const ) >
+inline void CShardedLRUKResourceUtilityManager< m_cShardMax, m_Kmax, CResource, OffsetOfIC, CKey, PfnKeyOfResource >::
+SetFaultInjection( const DWORD grbit )
+{
+    for ( INT ishard = 0; ishard < m_cShard; ishard++ )
+    {
+        _Shard( ishard ).SetFaultInjection( grbit );
+    }
+}
+#endif
+
+
+template< INT m_cShardMax, INT m_Kmax, class CResource, PfnOffsetOf OffsetOfIC, class CKey, CKey (*PfnKeyOfResource)( const CResource* const ) >
+inline typename CShardedLRUKResourceUtilityManager< m_cShardMax, m_Kmax, CResource, OffsetOfIC, CKey, PfnKeyOfResource >::ERR CShardedLRUKResourceUtilityManager< m_cShardMax, m_Kmax, CResource, OffsetOfIC, CKey, PfnKeyOfResource >::
+ErrInit(    const INT       K,
+            const double    csecCorrelatedTouch,
+            const double    csecTimeout,
+            const double    csecUncertainty,
+            const double    dblHashLoadFactor,
+            const double    dblHashUniformity,
+            const double    dblSpeedSizeTradeoff,
+            const INT       cShard )
+{
+    if ( cShard < 1 || cShard > m_cShardMax )
+    {
+        return ERR::errInvalidParameter;
+    }
+
+    m_cShard        = cShard;
+    m_dtickHorizon  = 2 * TICK( max( csecUncertainty * 1000.0, 2.0 ) );
+
+    for ( INT ishard = 0; ishard < m_cShard; ishard++ )
+    {
+        const ERR err = _Shard( ishard ).ErrInit(   K,
+                                                    csecCorrelatedTouch,
+                                                    csecTimeout,
+                                                    csecUncertainty,
+                                                    dblHashLoadFactor,
+                                                    dblHashUniformity,
+                                                    dblSpeedSizeTradeoff );
+        if ( err != ERR::errSuccess )
+        {
+            Term();
+            return err;
+        }
+    }
+
+    return ERR::errSuccess;
+}
+
+
+template< INT m_cShardMax, INT m_Kmax, class CResource, PfnOffsetOf OffsetOfIC, class CKey, CKey (*PfnKeyOfResource)( const CResource* const ) >
+inline void CShardedLRUKResourceUtilityManager< m_cShardMax, m_Kmax, CResource, OffsetOfIC, CKey, PfnKeyOfResource >::
+Term()
+{
+    for ( INT ishard = 0; ishard < m_cShard; ishard++ )
+    {
+        _Shard( ishard ).Term();
+    }
+}
+
+
+template< INT m_cShardMax, INT m_Kmax, class CResource, PfnOffsetOf OffsetOfIC, class CKey, CKey (*PfnKeyOfResource)( const CResource* const ) >
+inline void CShardedLRUKResourceUtilityManager< m_cShardMax, m_Kmax, CResource, OffsetOfIC, CKey, PfnKeyOfResource >::
+LockResourceForEvict( CResource* const pres, CLock* const plock )
+{
+    RESMGRAssert( !plock->m_fShardScan );
+
+    plock->m_ishard = _IshardFromPres( pres );
+    _Shard( plock->m_ishard ).LockResourceForEvict( pres, &plock->m_lock );
+}
+
+
+template< INT m_cShardMax, INT m_Kmax, class CResource, PfnOffsetOf OffsetOfIC, class CKey, CKey (*PfnKeyOfResource)( const CResource* const ) >
+inline void CShardedLRUKResourceUtilityManager< m_cShardMax, m_Kmax, CResource, OffsetOfIC, CKey, PfnKeyOfResource >::
+UnlockResourceForEvict( CLock* const plock )
+{
+    _Shard( plock->m_ishard ).UnlockResourceForEvict( &plock->m_lock );
+}
+
+
+template< INT m_cShardMax, INT m_Kmax, class CResource, PfnOffsetOf OffsetOfIC, class CKey, CKey (*PfnKeyOfResource)( const CResource* const ) >
+inline void CShardedLRUKResourceUtilityManager< m_cShardMax, m_Kmax, CResource, OffsetOfIC, CKey, PfnKeyOfResource >::
+BeginResourceScan( CLock* const plock )
+{
+    RESMGRAssert( !plock->m_fShardScan );
+
+    plock->m_ishard                 = 0;
+    plock->m_fScanHorizon           = fFalse;
+    plock->m_fScanHorizonLow        = fFalse;
+    plock->m_fShardBeyondHorizon    = fFalse;
+
+    _Shard( 0 ).BeginResourceScan( &plock->m_lock );
+    plock->m_fShardScan = fTrue;
+}
+
+
+template< INT m_cShardMax, INT m_Kmax, class CResource, PfnOffsetOf OffsetOfIC, class CKey, CKey (*PfnKeyOfResource)( const CResource* const ) >
+inline typename CShardedLRUKResourceUtilityManager< m_cShardMax, m_Kmax, CResource, OffsetOfIC, CKey, PfnKeyOfResource >::ERR CShardedLRUKResourceUtilityManager< m_cShardMax, m_Kmax, CResource, OffsetOfIC, CKey, PfnKeyOfResource >::
+ErrGetCurrentResource( CLock* const plock, CResource** const ppres )
+{
+    return _Shard( plock->m_ishard ).ErrGetCurrentResource( &plock->m_lock, ppres );
+}
+
+
+template< INT m_cShardMax, INT m_Kmax, class CResource, PfnOffsetOf OffsetOfIC, class CKey, CKey (*PfnKeyOfResource)( const CResource* const ) >
+inline typename CShardedLRUKResourceUtilityManager< m_cShardMax, m_Kmax, CResource, OffsetOfIC, CKey, PfnKeyOfResource >::ERR CShardedLRUKResourceUtilityManager< m_cShardMax, m_Kmax, CResource, OffsetOfIC, CKey, PfnKeyOfResource >::
+ErrGetNextResource( CLock* const plock, CResource** const ppres )
+{
+    if ( m_cShard == 1 )
+    {
+        return _Shard( 0 ).ErrGetNextResource( &plock->m_lock, ppres );
+    }
+
+    while ( fTrue )
+    {
+        if ( !plock->m_fShardScan )
+        {
+            _Shard( plock->m_ishard ).BeginResourceScan( &plock->m_lock );
+            plock->m_fShardScan = fTrue;
+        }
+
+        while ( _Shard( plock->m_ishard ).ErrGetNextResource( &plock->m_lock, ppres ) == ERR::errSuccess )
+        {
+            const TICK tickIndexTarget = _TickIndexTarget( *ppres );
+
+            if ( !plock->m_fScanHorizon )
+            {
+                plock->m_fScanHorizon       = fTrue;
+                plock->m_tickHorizonHigh    = tickIndexTarget + m_dtickHorizon;
+            }
+
+            if ( plock->m_fScanHorizonLow && CShard::_CmpTick( tickIndexTarget, plock->m_tickHorizonLow ) <= 0 )
+            {
+                continue;
+            }
+
+            if ( CShard::_CmpTick( tickIndexTarget, plock->m_tickHorizonHigh ) <= 0 )
+            {
+                return ERR::errSuccess;
+            }
+
+            if ( !plock->m_fShardBeyondHorizon || CShard::_CmpTick( tickIndexTarget, plock->m_tickBeyondHorizonMin ) < 0 )
+            {
+                plock->m_tickBeyondHorizonMin = tickIndexTarget;
+            }
+            plock->m_fShardBeyondHorizon = fTrue;
+            break;
+        }
+
+        _Shard( plock->m_ishard ).EndResourceScan( &plock->m_lock );
+        plock->m_fShardScan = fFalse;
+
+        if ( ++plock->m_ishard < m_cShard )
+        {
+            continue;
+        }
+
+        if ( !plock->m_fShardBeyondHorizon )
+        {
+            *ppres = NULL;
+            plock->m_ishard = 0;
+            return ERR::errNoCurrentResource;
+        }
+
+        plock->m_ishard                 = 0;
+        plock->m_fScanHorizonLow        = fTrue;
+        plock->m_tickHorizonLow         = plock->m_tickHorizonHigh;
+        plock->m_tickHorizonHigh        = plock->m_tickBeyondHorizonMin + m_dtickHorizon;
+        plock->m_fShardBeyondHorizon    = fFalse;
+    }
+}
+
+
+template< INT m_cShardMax, INT m_Kmax, class CResource, PfnOffsetOf OffsetOfIC, class CKey, CKey (*PfnKeyOfResource)( const CResource* const ) >
+inline typename CShardedLRUKResourceUtilityManager< m_cShardMax, m_Kmax, CResource, OffsetOfIC, CKey, PfnKeyOfResource >::ERR CShardedLRUKResourceUtilityManager< m_cShardMax, m_Kmax, CResource, OffsetOfIC, CKey, PfnKeyOfResource >::
+ErrEvictCurrentResource( CLock* const plock, const CKey& key, const BOOL fKeepHistory )
+{
+    RESMGRAssert( _IshardFromKey( key ) == plock->m_ishard );
+    return _Shard( plock->m_ishard ).ErrEvictCurrentResource( &plock->m_lock, key, fKeepHistory );
+}
+
+
+template< INT m_cShardMax, INT m_Kmax, class CResource, PfnOffsetOf OffsetOfIC, class CKey, CKey (*PfnKeyOfResource)( const CResource* const ) >
+inline void CShardedLRUKResourceUtilityManager< m_cShardMax, m_Kmax, CResource, OffsetOfIC, CKey, PfnKeyOfResource >::
+EndResourceScan( CLock* const plock )
+{
+    if ( plock->m_fShardScan )
+    {
+        _Shard( plock->m_ishard ).EndResourceScan( &plock->m_lock );
+        plock->m_fShardScan = fFalse;
+    }
+}
+
+
 #define DECLARE_LRUK_RESOURCE_UTILITY_MANAGER( m_Kmax, CResource, OffsetOfIC, CKey, Typedef )                                   \
                                                                                                                                 \
 typedef CLRUKResourceUtilityManager< m_Kmax, CResource, OffsetOfIC, CKey > Typedef;                                             \
@@ -3311,6 +3736,13 @@ Hash( const CKey& key )
 }
 
 
+#define DECLARE_SHARDED_LRUK_RESOURCE_UTILITY_MANAGER( m_cShardMax, m_Kmax, CResource, OffsetOfIC, CKey, PfnKeyOfResource, Typedef )  \
+                                                                                                                                \
+DECLARE_LRUK_RESOURCE_UTILITY_MANAGER( m_Kmax, CResource, OffsetOfIC, CKey, Typedef##Shard );                                   \
+                                                                                                                                \
+typedef CShardedLRUKResourceUtilityManager< m_cShardMax, m_Kmax, CResource, OffsetOfIC, CKey, PfnKeyOfResource > Typedef;
+
+
 NAMESPACE_END( RESMGR )
 
 
@@ -0,0 +1,313 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+
+#include "checksumstd.hxx"
+
+inline XECHECKSUM MakeChecksumFromECCXORAndPgno(
+    const ULONG eccChecksum,
+    const ULONG xorChecksum,
+    const ULONG pgno )
+{
+    const XECHECKSUM low    = xorChecksum ^ pgno;
+    const XECHECKSUM high   = (XECHECKSUM)eccChecksum << 32;
+    return ( high | low );
+}
+
+#if ( defined _AMD64_ || defined _X86_ ) && !defined _CHPE_X86_ARM64_
+
+#include <intrin.h>
+#include <immintrin.h>
+
+typedef unsigned __int64 XECHECKSUM;
+
+typedef XECHECKSUM  (*PFNCHECKSUMNEWFORMAT)( const unsigned char * const, const ULONG, const ULONG, BOOL );
+
+
+inline LONG lParityMaskAVX2( const __m256i qq )
+{
+    const __m128i dq1 = _mm_xor_si128( _mm256_castsi256_si128( qq ), _mm256_extracti128_si256( qq, 1 ) );
+    const __m128i dq2 = _mm_xor_si128( dq1, _mm_unpackhi_epi64( dq1, dq1 ) );
+
+#if ( defined _X86_ )
+    const __m128i dq3 = _mm_xor_si128( dq2, _mm_shuffle_epi32( dq2, 0x01 ) );
+    INT popcnt = _mm_popcnt_u32( _mm_cvtsi128_si32( dq3 ) );
+#else
+    INT popcnt = (INT) _mm_popcnt_u64( _mm_cvtsi128_si64( dq2 ) );
+#endif
+
+    return -(popcnt & 0x01);
+}
+
+extern __declspec( align( 128 ) ) const unsigned char g_bECCLookupTable[ 256 ];
+
+inline ULONG lECCLookup8bit(const ULONG byte)
+{
+    return g_bECCLookupTable[ byte & 0xff ];
+}
+
+//  Reduces the column accumulators and row parities of one block to its checksum.
+
+inline XECHECKSUM XeChecksumAVX2Finish(
+    const __m256i qq0,
+    const __m256i qq1,
+    const __m256i qq2,
+    const __m256i qq3,
+    const ULONG p,
+    const ULONG cb,
+    const ULONG pgno )
+{
+    const __m256i qqAcc = _mm256_xor_si256( _mm256_xor_si256( qq0, qq1 ), _mm256_xor_si256( qq2, qq3 ) );
+    __declspec( align( 32 ) ) __m256i aryqq[1];
+    _mm256_store_si256( &aryqq[0], qqAcc );
+
+    ULONG q = 0;
+    ULONG idxq = 0xff000000;
+
+    q ^= idxq & lParityMaskAVX2( qq0 );
+    idxq += 0xff000100;
+    q ^= idxq & lParityMaskAVX2( qq1 );
+    idxq += 0xff000100;
+    q ^= idxq & lParityMaskAVX2( qq2 );
+    idxq += 0xff000100;
+    q ^= idxq & lParityMaskAVX2( qq3 );
+
+    ULONG q_ = 0;
+    ULONG idxq_ = 0xffe00000;
+    const UINT *pdw = ( const UINT* )aryqq;
+    UINT dwAcc = 0;
+    for ( ULONG i = 0; i < 8; i++ )
+    {
+        const UINT dwT = pdw[i];
+        dwAcc ^= dwT;
+        q_ ^= idxq_ & -INT( _mm_popcnt_u32( dwT ) & 0x01 );
+        idxq_ += 0xffe00020;
+    }
+
+    ULONG r = 0;
+    UINT byteT = dwAcc;
+    ULONG byte0 = 0;
+    ULONG idxr = 0xfff80000;
+    for ( ULONG i = 0; i < 4; i++ )
+    {
+        r ^= idxr & -INT( _mm_popcnt_u32( byteT & 0xff ) & 0x01 );
+        byte0 ^= byteT;
+        byteT >>= 8;
+        idxr += 0xfff80008;
+    }
+
+    const LONG bits = lECCLookup8bit( byte0 );
+    r |= ( bits & 0x07 );
+    r |= ( ( bits << 12 ) & 0x00070000 );
+
+    const ULONG mask = ( cb << 19 ) - 1;
+
+    const ULONG ecc = p & 0xfc00fc00 & mask | q & 0x03000300 | q_ & 0x00e000e0 | r & 0x001f001f;
+    const ULONG xor = dwAcc;
+    return MakeChecksumFromECCXORAndPgno( ecc, xor, pgno );
+}
+
+XECHECKSUM ChecksumNewFormatAVX2( const unsigned char * const pb, const ULONG cb, const ULONG pgno, BOOL fHeaderBlock )
+{
+    PFNCHECKSUMNEWFORMAT pfn = ChecksumNewFormatAVX2;
+    Unused( pfn );
+
+    Assert( 32 == sizeof( __m256i ) );
+    Assert( 4 == sizeof( ULONG ) );
+
+    Assert( 0 == ( cb & ( cb -1 ) ) );
+    Assert( 1024 <= cb && cb <= 8192 );
+
+    Assert( 0 == ( ( uintptr_t )pb & ( 256 - 1 ) ) );
+
+    const ULONG cqq = cb / 32;
+
+    ULONG p = 0;
+
+    __m256i qq0 = _mm256_setzero_si256();
+    __m256i qq1 = _mm256_setzero_si256();
+    __m256i qq2 = _mm256_setzero_si256();
+    __m256i qq3 = _mm256_setzero_si256();
+    {
+        ULONG idxp = 0xfc000000;
+
+        const __m256i* pqq = ( const __m256i* )pb;
+        const __m256i qqAllOnes = _mm256_set1_epi32( -1 );
+        __m256i qqMaskL0 = fHeaderBlock ? _mm256_set_epi64x( -1, -1, -1, 0 ) : qqAllOnes;
+
+        ULONG i = 0;
+        do
+        {
+            _mm_prefetch( ( char *)&pqq[ i + 16 ], _MM_HINT_NTA );
+            _mm_prefetch( ( char *)&pqq[ i + 16 + 2 ], _MM_HINT_NTA );
+            _mm_prefetch( ( char *)&pqq[ i + 16 + 4 ], _MM_HINT_NTA );
+            _mm_prefetch( ( char *)&pqq[ i + 16 + 6 ], _MM_HINT_NTA );
+
+            const __m256i qqL0 = _mm256_and_si256( pqq[ i + 0 ], qqMaskL0 );
+            const __m256i qqL1 = pqq[ i + 1 ];
+            const __m256i qqL2 = pqq[ i + 2 ];
+            const __m256i qqL3 = pqq[ i + 3 ];
+            const __m256i qqH0 = pqq[ i + 4 ];
+            const __m256i qqH1 = pqq[ i + 5 ];
+            const __m256i qqH2 = pqq[ i + 6 ];
+            const __m256i qqH3 = pqq[ i + 7 ];
+            qqMaskL0 = qqAllOnes;
+
+            const __m256i qqLAcc = _mm256_xor_si256( _mm256_xor_si256( qqL0, qqL1 ), _mm256_xor_si256( qqL2, qqL3 ) );
+            const __m256i qqHAcc = _mm256_xor_si256( _mm256_xor_si256( qqH0, qqH1 ), _mm256_xor_si256( qqH2, qqH3 ) );
+
+            qq0 = _mm256_xor_si256( qq0, _mm256_xor_si256( qqL0, qqH0 ) );
+            qq1 = _mm256_xor_si256( qq1, _mm256_xor_si256( qqL1, qqH1 ) );
+            qq2 = _mm256_xor_si256( qq2, _mm256_xor_si256( qqL2, qqH2 ) );
+            qq3 = _mm256_xor_si256( qq3, _mm256_xor_si256( qqL3, qqH3 ) );
+
+            p ^= idxp & lParityMaskAVX2( qqLAcc );
+            idxp += 0xfc000400;
+
+            p ^= idxp & lParityMaskAVX2( qqHAcc );
+            idxp += 0xfc000400;
+
+            i += 8;
+
+            __assume( 8 < cqq );
+        }
+        while ( i < cqq );
+    }
+
+    const XECHECKSUM xeChecksum = XeChecksumAVX2Finish( qq0, qq1, qq2, qq3, p, cb, pgno );
+
+    _mm256_zeroupper();
+
+    return xeChecksum;
+}
+
+//  Checksums two blocks of the same size in one pass. Each row of the two blocks is
+//  loaded and reduced in the same iteration, so the row parity reductions of one block,
+//  which serialize on the popcount, overlap with those of the other.
+
+void ChecksumNewFormatAVX2x2(
+    const unsigned char * const pb0,
+    const unsigned char * const pb1,
+    const ULONG cb,
+    const ULONG pgno0,
+    const ULONG pgno1,
+    BOOL fHeaderBlock,
+    XECHECKSUM * const pxeChecksum0,
+    XECHECKSUM * const pxeChecksum1 )
+{
+    Assert( 0 == ( cb & ( cb -1 ) ) );
+    Assert( 1024 <= cb && cb <= 8192 );
+
+    Assert( 0 == ( ( uintptr_t )pb0 & ( 256 - 1 ) ) );
+    Assert( 0 == ( ( uintptr_t )pb1 & ( 256 - 1 ) ) );
+
+    const ULONG cqq = cb / 32;
+
+    ULONG p0 = 0;
+    ULONG p1 = 0;
+
+    __m256i qq00 = _mm256_setzero_si256();
+    __m256i qq01 = _mm256_setzero_si256();
+    __m256i qq02 = _mm256_setzero_si256();
+    __m256i qq03 = _mm256_setzero_si256();
+    __m256i qq10 = _mm256_setzero_si256();
+    __m256i qq11 = _mm256_setzero_si256();
+    __m256i qq12 = _mm256_setzero_si256();
+    __m256i qq13 = _mm256_setzero_si256();
+    {
+        ULONG idxp = 0xfc000000;
+
+        const __m256i* pqq0 = ( const __m256i* )pb0;
+        const __m256i* pqq1 = ( const __m256i* )pb1;
+        const __m256i qqAllOnes = _mm256_set1_epi32( -1 );
+        __m256i qqMaskL0 = fHeaderBlock ? _mm256_set_epi64x( -1, -1, -1, 0 ) : qqAllOnes;
+
+        ULONG i = 0;
+        do
+        {
+            _mm_prefetch( ( char *)&pqq0[ i + 16 ], _MM_HINT_NTA );
+            _mm_prefetch( ( char *)&pqq0[ i + 16 + 2 ], _MM_HINT_NTA );
+            _mm_prefetch( ( char *)&pqq0[ i + 16 + 4 ], _MM_HINT_NTA );
+            _mm_prefetch( ( char *)&pqq0[ i + 16 + 6 ], _MM_HINT_NTA );
+            _mm_prefetch( ( char *)&pqq1[ i + 16 ], _MM_HINT_NTA );
+            _mm_prefetch( ( char *)&pqq1[ i + 16 + 2 ], _MM_HINT_NTA );
+            _mm_prefetch( ( char *)&pqq1[ i + 16 + 4 ], _MM_HINT_NTA );
+            _mm_prefetch( ( char *)&pqq1[ i + 16 + 6 ], _MM_HINT_NTA );
+
+            const __m256i qqL00 = _mm256_and_si256( pqq0[ i + 0 ], qqMaskL0 );
+            const __m256i qqL01 = pqq0[ i + 1 ];
+            const __m256i qqL02 = pqq0[ i + 2 ];
+            const __m256i qqL03 = pqq0[ i + 3 ];
+            const __m256i qqH00 = pqq0[ i + 4 ];
+            const __m256i qqH01 = pqq0[ i + 5 ];
+            const __m256i qqH02 = pqq0[ i + 6 ];
+            const __m256i qqH03 = pqq0[ i + 7 ];
+            const __m256i qqL10 = _mm256_and_si256( pqq1[ i + 0 ], qqMaskL0 );
+            const __m256i qqL11 = pqq1[ i + 1 ];
+            const __m256i qqL12 = pqq1[ i + 2 ];
+            const __m256i qqL13 = pqq1[ i + 3 ];
+            const __m256i qqH10 = pqq1[ i + 4 ];
+            const __m256i qqH11 = pqq1[ i + 5 ];
+            const __m256i qqH12 = pqq1[ i + 6 ];
+            const __m256i qqH13 = pqq1[ i + 7 ];
+            qqMaskL0 = qqAllOnes;
+
+            const __m256i qqLAcc0 = _mm256_xor_si256( _mm256_xor_si256( qqL00, qqL01 ), _mm256_xor_si256( qqL02, qqL03 ) );
+            const __m256i qqHAcc0 = _mm256_xor_si256( _mm256_xor_si256( qqH00, qqH01 ), _mm256_xor_si256( qqH02, qqH03 ) );
+            const __m256i qqLAcc1 = _mm256_xor_si256( _mm256_xor_si256( qqL10, qqL11 ), _mm256_xor_si256( qqL12, qqL13 ) );
+            const __m256i qqHAcc1 = _mm256_xor_si256( _mm256_xor_si256( qqH10, qqH11 ), _mm256_xor_si256( qqH12, qqH13 ) );
+
+            qq00 = _mm256_xor_si256( qq00, _mm256_xor_si256( qqL00, qqH00 ) );
+            qq01 = _mm256_xor_si256( qq01, _mm256_xor_si256( qqL01, qqH01 ) );
+            qq02 = _mm256_xor_si256( qq02, _mm256_xor_si256( qqL02, qqH02 ) );
+            qq03 = _mm256_xor_si256( qq03, _mm256_xor_si256( qqL03, qqH03 ) );
+            qq10 = _mm256_xor_si256( qq10, _mm256_xor_si256( qqL10, qqH10 ) );
+            qq11 = _mm256_xor_si256( qq11, _mm256_xor_si256( qqL11, qqH11 ) );
+            qq12 = _mm256_xor_si256( qq12, _mm256_xor_si256( qqL12, qqH12 ) );
+            qq13 = _mm256_xor_si256( qq13, _mm256_xor_si256( qqL13, qqH13 ) );
+
+            p0 ^= idxp & lParityMaskAVX2( qqLAcc0 );
+            p1 ^= idxp & lParityMaskAVX2( qqLAcc1 );
+            idxp += 0xfc000400;
+
+            p0 ^= idxp & lParityMaskAVX2( qqHAcc0 );
+            p1 ^= idxp & lParityMaskAVX2( qqHAcc1 );
+            idxp += 0xfc000400;
+
+            i += 8;
+
+            __assume( 8 < cqq );
+        }
+        while ( i < cqq );
+    }
+
+    *pxeChecksum0 = XeChecksumAVX2Finish( qq00, qq01, qq02, qq03, p0, cb, pgno0 );
+    *pxeChecksum1 = XeChecksumAVX2Finish( qq10, qq11, qq12, qq13, p1, cb, pgno1 );
+
+    _mm256_zeroupper();
+}
+
+#else
+
+XECHECKSUM ChecksumNewFormatAVX2( const unsigned char * const pb, const ULONG cb, const ULONG pgno, BOOL fHeaderBlock )
+{
+    Enforce( fFalse );
+    return MakeChecksumFromECCXORAndPgno( 0, 0, pgno );
+}
+
+void ChecksumNewFormatAVX2x2(
+    const unsigned char * const pb0,
+    const unsigned char * const pb1,
+    const ULONG cb,
+    const ULONG pgno0,
+    const ULONG pgno1,
+    BOOL fHeaderBlock,
+    XECHECKSUM * const pxeChecksum0,
+    XECHECKSUM * const pxeChecksum1 )
+{
+    Enforce( fFalse );
+    *pxeChecksum0 = MakeChecksumFromECCXORAndPgno( 0, 0, pgno0 );
+    *pxeChecksum1 = MakeChecksumFromECCXORAndPgno( 0, 0, pgno1 );
+}
+
+#endif
@@ -0,0 +1,140 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+
+#include "checksumstd.hxx"
+
+inline XECHECKSUM MakeChecksumFromECCXORAndPgno(
+    const ULONG eccChecksum,
+    const ULONG xorChecksum,
+    const ULONG pgno )
+{
+    const XECHECKSUM low    = xorChecksum ^ pgno;
+    const XECHECKSUM high   = (XECHECKSUM)eccChecksum << 32;
+    return ( high | low );
+}
+
+#if defined _AMD64_ && !defined _CHPE_X86_ARM64_
+
+#include <intrin.h>
+#include <immintrin.h>
+
+typedef unsigned __int64 XECHECKSUM;
+
+typedef XECHECKSUM  (*PFNCHECKSUMNEWFORMAT)( const unsigned char * const, const ULONG, const ULONG, BOOL );
+
+
+inline ULONG UlParity( const unsigned __int64 qw )
+{
+    return (ULONG)( _mm_popcnt_u64( qw ) & 0x01 );
+}
+
+inline unsigned __int64 QwXorFold( const __m512i zmm )
+{
+    const __m256i qq = _mm256_xor_si256( _mm512_castsi512_si256( zmm ), _mm512_extracti64x4_epi64( zmm, 1 ) );
+    const __m128i dq = _mm_xor_si128( _mm256_castsi256_si128( qq ), _mm256_extracti128_si256( qq, 1 ) );
+    return (unsigned __int64)_mm_cvtsi128_si64( _mm_xor_si128( dq, _mm_unpackhi_epi64( dq, dq ) ) );
+}
+
+const unsigned __int64 g_rgqwIndexBitMask[ 6 ] =
+{
+    0xaaaaaaaaaaaaaaaa,
+    0xcccccccccccccccc,
+    0xf0f0f0f0f0f0f0f0,
+    0xff00ff00ff00ff00,
+    0xffff0000ffff0000,
+    0xffffffff00000000,
+};
+
+XECHECKSUM ChecksumNewFormatAVX512( const unsigned char * const pb, const ULONG cb, const ULONG pgno, BOOL fHeaderBlock )
+{
+    PFNCHECKSUMNEWFORMAT pfn = ChecksumNewFormatAVX512;
+    Unused( pfn );
+
+    Assert( 64 == sizeof( __m512i ) );
+    Assert( 4 == sizeof( ULONG ) );
+
+    Assert( 0 == ( cb & ( cb -1 ) ) );
+    Assert( 1024 <= cb && cb <= 8192 );
+
+    Assert( 0 == ( ( uintptr_t )pb & ( 256 - 1 ) ) );
+
+    const ULONG crow = cb / 128;
+    C_ASSERT( 8192 / 128 <= 64 );
+
+    const __m512i* pzmm = ( const __m512i* )pb;
+    const __m512i zmmOne = _mm512_set1_epi64( 1 );
+    __m512i zmmMaskL0 = _mm512_maskz_set1_epi64( fHeaderBlock ? 0xfe : 0xff, -1 );
+
+    __m512i zmmAccL = _mm512_setzero_si512();
+    __m512i zmmAccH = _mm512_setzero_si512();
+    __m512i zmmRowParity = _mm512_setzero_si512();
+
+    for ( ULONG irow = 0; irow < crow; irow += 2 )
+    {
+        _mm_prefetch( ( char *)&pzmm[ 2 * irow + 16 ], _MM_HINT_NTA );
+        _mm_prefetch( ( char *)&pzmm[ 2 * irow + 16 + 1 ], _MM_HINT_NTA );
+        _mm_prefetch( ( char *)&pzmm[ 2 * irow + 16 + 2 ], _MM_HINT_NTA );
+        _mm_prefetch( ( char *)&pzmm[ 2 * irow + 16 + 3 ], _MM_HINT_NTA );
+
+        const __m512i zmmL0 = _mm512_and_si512( _mm512_load_si512( &pzmm[ 2 * irow + 0 ] ), zmmMaskL0 );
+        const __m512i zmmH0 = _mm512_load_si512( &pzmm[ 2 * irow + 1 ] );
+        const __m512i zmmL1 = _mm512_load_si512( &pzmm[ 2 * irow + 2 ] );
+        const __m512i zmmH1 = _mm512_load_si512( &pzmm[ 2 * irow + 3 ] );
+        zmmMaskL0 = _mm512_set1_epi64( -1 );
+
+        zmmAccL = _mm512_ternarylogic_epi64( zmmAccL, zmmL0, zmmL1, 0x96 );
+        zmmAccH = _mm512_ternarylogic_epi64( zmmAccH, zmmH0, zmmH1, 0x96 );
+
+        const __m512i zmmPopcnt0 = _mm512_popcnt_epi64( _mm512_xor_si512( zmmL0, zmmH0 ) );
+        const __m512i zmmPopcnt1 = _mm512_popcnt_epi64( _mm512_xor_si512( zmmL1, zmmH1 ) );
+
+        zmmRowParity = _mm512_ternarylogic_epi64( _mm512_slli_epi64( zmmRowParity, 1 ), zmmPopcnt0, zmmOne, 0x78 );
+        zmmRowParity = _mm512_ternarylogic_epi64( _mm512_slli_epi64( zmmRowParity, 1 ), zmmPopcnt1, zmmOne, 0x78 );
+    }
+
+    const __m512i zmmAcc = _mm512_xor_si512( zmmAccL, zmmAccH );
+
+
+    ULONG ibitXor = 0;
+
+    for ( ULONG ibit = 0; ibit < 6; ibit++ )
+    {
+        const __m512i zmmPopcnt = _mm512_popcnt_epi64( _mm512_and_si512( zmmAcc, _mm512_set1_epi64( g_rgqwIndexBitMask[ ibit ] ) ) );
+        ibitXor |= UlParity( _mm512_test_epi64_mask( zmmPopcnt, zmmOne ) ) << ibit;
+    }
+
+    const ULONG maskLaneParity = _mm512_test_epi64_mask( _mm512_popcnt_epi64( zmmAcc ), zmmOne );
+    ibitXor |= UlParity( maskLaneParity & 0xaa ) << 6;
+    ibitXor |= UlParity( maskLaneParity & 0xcc ) << 7;
+    ibitXor |= UlParity( maskLaneParity & 0xf0 ) << 8;
+    ibitXor |= UlParity( _mm512_test_epi64_mask( _mm512_popcnt_epi64( zmmAccH ), zmmOne ) ) << 9;
+
+    const unsigned __int64 qwRowParity = QwXorFold( zmmRowParity );
+    const unsigned __int64 qwRowMask = ( crow < 64 ) ? ( ( 1ULL << crow ) - 1 ) : ~0ULL;
+    for ( ULONG ibit = 0; ( 1UL << ibit ) < crow; ibit++ )
+    {
+        ibitXor |= UlParity( qwRowParity & ~g_rgqwIndexBitMask[ ibit ] & qwRowMask ) << ( 10 + ibit );
+    }
+
+    const unsigned __int64 qwAcc = QwXorFold( zmmAcc );
+
+    _mm256_zeroupper();
+
+    const ULONG ibitXorComplement = ibitXor ^ ( UlParity( maskLaneParity ) ? 0xffff : 0 );
+    const ULONG mask = ( cb << 19 ) - 1;
+
+    const ULONG ecc = ( ( ibitXorComplement << 16 ) | ibitXor ) & mask;
+    const ULONG xor = (ULONG)( qwAcc ^ ( qwAcc >> 32 ) );
+    return MakeChecksumFromECCXORAndPgno( ecc, xor, pgno );
+}
+
+#else
+
+XECHECKSUM ChecksumNewFormatAVX512( const unsigned char * const pb, const ULONG cb, const ULONG pgno, BOOL fHeaderBlock )
+{
+    Enforce( fFalse );
+    return MakeChecksumFromECCXORAndPgno( 0, 0, pgno );
+}
+
+#endif
@@ -57,6 +57,18 @@ XECHECKSUM ChecksumNewFormat64Bit( const unsigned char * const pb, const ULONG c
 XECHECKSUM ChecksumNewFormatSSE( const unsigned char * const pb, const ULONG cb, const ULONG pgno, BOOL fHeaderBlock = fTrue );
 template <ChecksumParityMaskFunc TParityMaskFunc> XECHECKSUM ChecksumNewFormatSSE2( const unsigned char * const pb, const ULONG cb, const ULONG pgno, BOOL fHeaderBlock = fTrue);
 XECHECKSUM ChecksumNewFormatAVX( const unsigned char * const pb, const ULONG cb, const ULONG pgno, BOOL fHeaderBlock = fTrue );
+XECHECKSUM ChecksumNewFormatAVX2( const unsigned char * const pb, const ULONG cb, const ULONG pgno, BOOL fHeaderBlock = fTrue );
+XECHECKSUM ChecksumNewFormatAVX512( const unsigned char * const pb, const ULONG cb, const ULONG pgno, BOOL fHeaderBlock = fTrue );
+
+void ChecksumNewFormatAVX2x2(
+    const unsigned char * const pb0,
+    const unsigned char * const pb1,
+    const ULONG cb,
+    const ULONG pgno0,
+    const ULONG pgno1,
+    BOOL fHeaderBlock,
+    XECHECKSUM * const pxeChecksum0,
+    XECHECKSUM * const pxeChecksum1 );
 
 PFNCHECKSUMNEWFORMAT pfnChecksumNewFormat = ChecksumSelectNewFormat;
 
@@ -68,6 +80,50 @@ XECHECKSUM ChecksumNewFormat( const unsigned char * const pb, const ULONG cb, co
     return pfnChecksumNewFormat( pb, cb, pgno, fHeaderBlock );
 }
 
+//  Checksums cpb blocks of the same size. When the AVX2 kernel is selected the blocks are
+//  done two at a time, so the serial row parity reductions of a pair overlap. Every other
+//  kernel is called once per block (the AVX-512 kernel already defers its row reductions).
+
+void ChecksumNewFormatMultiple(
+    const unsigned char * const * const rgpb,
+    const ULONG cb,
+    const ULONG * const rgpgno,
+    BOOL fHeaderBlock,
+    XECHECKSUM * const rgxeChecksum,
+    const ULONG cpb )
+{
+    if ( 0 == cpb )
+    {
+        return;
+    }
+
+    //  the first block goes through the dispatcher so that the kernel is selected
+
+    rgxeChecksum[ 0 ] = ChecksumNewFormat( rgpb[ 0 ], cb, rgpgno[ 0 ], fHeaderBlock );
+
+    ULONG ipb = 1;
+    if ( pfnChecksumNewFormat == ChecksumNewFormatAVX2 )
+    {
+        for ( ; ipb + 1 < cpb; ipb += 2 )
+        {
+            ChecksumNewFormatAVX2x2(
+                rgpb[ ipb ],
+                rgpb[ ipb + 1 ],
+                cb,
+                rgpgno[ ipb ],
+                rgpgno[ ipb + 1 ],
+                fHeaderBlock,
+                &rgxeChecksum[ ipb ],
+                &rgxeChecksum[ ipb + 1 ] );
+        }
+    }
+
+    for ( ; ipb < cpb; ipb++ )
+    {
+        rgxeChecksum[ ipb ] = pfnChecksumNewFormat( rgpb[ ipb ], cb, rgpgno[ ipb ], fHeaderBlock );
+    }
+}
+
 
 ULONG ChecksumSelectOldFormat( const unsigned char * const pb, const ULONG cb )
 {
@@ -179,7 +235,15 @@ XECHECKSUM ChecksumSelectNewFormat( const unsigned char * const pb, const ULONG
 #if defined _X86_ && defined _CHPE_X86_ARM64_
     pfn = ChecksumNewFormatSlowly;
 #else
-    if( FAVXEnabled() && FPopcntAvailable() )
+    if( FAVX512Enabled() && FPopcntAvailable() )
+    {
+        pfn = ChecksumNewFormatAVX512;
+    }
+    else if( FAVX2Enabled() && FPopcntAvailable() )
+    {
+        pfn = ChecksumNewFormatAVX2;
+    }
+    else if( FAVXEnabled() && FPopcntAvailable() )
     {
         pfn = ChecksumNewFormatAVX;
     }
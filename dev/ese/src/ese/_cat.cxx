@@ -119,6 +119,8 @@ LOCAL const CDESC   rgcdescMSO[]    =
 
     "LVChunkMax",           fidMSO_LVChunkMax,          JET_coltypLong,         NO_GRBIT,
 
+    "CompressionDictionary", fidMSO_CompressionDictionary, JET_coltypLongBinary, JET_bitColumnTagged,
+
 };
 
 LOCAL const ULONG   cColumnsMSO     = _countof(rgcdescMSO);
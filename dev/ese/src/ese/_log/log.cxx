@@ -107,6 +107,7 @@ LOG::LOG( INST *pinst )
     m_pLogWriteBuffer = NULL;
     m_pctablehash = NULL;
     m_pcsessionhash = NULL;
+    m_predopageworkers = NULL;
     PERFOpt( ibLGCheckpoint.Clear( m_pinst ) );
     PERFOpt( ibLGDbConsistency.Clear( m_pinst ) );
     PERFOpt( cbLGCheckpointDepthMax.Clear( m_pinst ) );
@@ -128,6 +129,7 @@ LOG::~LOG()
 
     Assert( m_pctablehash == NULL || m_fLGNoMoreLogWrite );
     Assert( m_pcsessionhash == NULL || m_fLGNoMoreLogWrite );
+    Assert( m_predopageworkers == NULL );
 
     delete m_pctablehash;
     delete m_pcsessionhash;
@@ -2269,9 +2271,11 @@ VOID LOG::LGIUpdateCheckpoint( CHECKPOINT *pcheckpoint )
         return;
 #endif
 
+    const LGPOS lgposRedoApplied = ( m_fRecoveringMode == fRecoveringRedo ) ? LgposLGRIRedoApplied() : lgposMin;
+
     m_pLogWriteBuffer->LockBuffer();
 
-    const LGPOS lgposWrittenTip = ( m_fRecoveringMode == fRecoveringRedo ) ? m_lgposRedo : m_pLogWriteBuffer->LgposWriteTip();
+    const LGPOS lgposWrittenTip = ( m_fRecoveringMode == fRecoveringRedo ) ? lgposRedoApplied : m_pLogWriteBuffer->LgposWriteTip();
 
     lgposDbConsistency = lgposWrittenTip;
     lgposToFlushT = lgposWrittenTip;
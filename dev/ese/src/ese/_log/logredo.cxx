@@ -1530,6 +1530,8 @@ ERR LOG::ErrLGRIEndAllSessionsWithError()
 
     OSTraceWriteRefLog( ostrlSystemFixed, sysosrtlDatapoint|sysosrtlContextInst, m_pinst, (PVOID)&(m_pinst->m_iInstance), sizeof(m_pinst->m_iInstance) );
 
+    LGRITermRedoPageWorkers();
+
     for (DBID dbid = dbidUserLeast; dbid < dbidMax; dbid++ )
     {
         IFMP ifmp = m_pinst->m_mpdbidifmp[ dbid ];
@@ -1828,7 +1830,7 @@ ERR LOG::ErrLGRIEndAllSessions(
     BOOL                    fNeedCallINSTTerm   = fTrue;
     DBID dbid;
 
-
+    LGRITermRedoPageWorkers();
 
     for (dbid = dbidUserLeast; dbid < dbidMax; dbid++ )
     {
@@ -2375,23 +2377,10 @@ ERR LOG::ErrLGRIRedoNodeOperation( const LRNODE_ *plrnode, ERR *perr )
     ERR             err;
     PIB             *ppib;
     const PGNO      pgno        = plrnode->le_pgno;
-    const PGNO      pgnoFDP     = plrnode->le_pgnoFDP;
     const OBJID     objidFDP    = plrnode->le_objidFDP;
     const PROCID    procid      = plrnode->le_procid;
     const DBID      dbid        = plrnode->dbid;
     const DBTIME    dbtime      = plrnode->le_dbtime;
-    const BOOL      fUnique     = plrnode->FUnique();
-    const BOOL      fSpace      = plrnode->FSpace();
-    const DIRFLAG   dirflag     = plrnode->FVersioned() ? fDIRNull : fDIRNoVersion;
-    VERPROXY        verproxy;
-
-    verproxy.rceid = plrnode->le_rceid;
-    verproxy.level = plrnode->level;
-    verproxy.proxy = proxyRedo;
-
-    Assert( !plrnode->FVersioned() || !plrnode->FSpace() );
-    Assert( !plrnode->FVersioned() || rceidNull != verproxy.rceid );
-    Assert( !plrnode->FVersioned() || verproxy.level > 0 );
 
     BOOL fSkip;
     CallR( ErrLGRICheckRedoConditionInTrx(
@@ -2417,11 +2406,47 @@ ERR LOG::ErrLGRIRedoNodeOperation( const LRNODE_ *plrnode, ERR *perr )
             || lrtypUndoInfo == plrnode->lrtyp );
     }
 
+    if ( m_cLGRedoPageWorker > 0 )
+    {
+        const IFMP  ifmp = m_pinst->m_mpdbidifmp[ dbid ];
+
+        if ( FLGRIRedoOnPageWorker( plrnode, ifmp ) )
+        {
+            return ErrLGRIDispatchRedoPageWorker( ifmp, pgno, plrnode );
+        }
+
+        CallR( ErrLGRIWaitRedoPageWorker( ifmp, pgno ) );
+    }
+
+    return ErrLGRIRedoNodeOperationOnPage( ppib, m_pctablehash, plrnode );
+}
+
+ERR LOG::ErrLGRIRedoNodeOperationOnPage( PIB *ppib, CTableHash *pctablehash, const LRNODE_ *plrnode )
+{
+    ERR             err;
+    const PGNO      pgno        = plrnode->le_pgno;
+    const PGNO      pgnoFDP     = plrnode->le_pgnoFDP;
+    const OBJID     objidFDP    = plrnode->le_objidFDP;
+    const DBID      dbid        = plrnode->dbid;
+    const DBTIME    dbtime      = plrnode->le_dbtime;
+    const BOOL      fUnique     = plrnode->FUnique();
+    const BOOL      fSpace      = plrnode->FSpace();
+    const DIRFLAG   dirflag     = plrnode->FVersioned() ? fDIRNull : fDIRNoVersion;
+    VERPROXY        verproxy;
+
+    verproxy.rceid = plrnode->le_rceid;
+    verproxy.level = plrnode->level;
+    verproxy.proxy = proxyRedo;
+
+    Assert( !plrnode->FVersioned() || !plrnode->FSpace() );
+    Assert( !plrnode->FVersioned() || rceidNull != verproxy.rceid );
+    Assert( !plrnode->FVersioned() || verproxy.level > 0 );
+
     INST    *pinst = PinstFromPpib( ppib );
     IFMP    ifmp = pinst->m_mpdbidifmp[ dbid ];
     FUCB    *pfucb;
 
-    CallR( ErrLGRIGetFucb( m_pctablehash, ppib, ifmp, pgnoFDP, objidFDP, fUnique, fSpace, &pfucb ) );
+    CallR( ErrLGRIGetFucb( pctablehash, ppib, ifmp, pgnoFDP, objidFDP, fUnique, fSpace, &pfucb ) );
 
     Assert( pfucb->ppib == ppib );
 
@@ -3148,8 +3173,6 @@ ERR LOG::ErrLGRIRedoScrub( const LRSCRUB * const plrscrub )
     PIB *ppib;
     BOOL fSkip;
 
-    CSR csr;
-    
     Call( ErrLGRICheckRedoConditionInTrx(
             plrscrub->le_procid,
             plrscrub->dbid,
@@ -3161,31 +3184,546 @@ ERR LOG::ErrLGRIRedoScrub( const LRSCRUB * const plrscrub )
     if ( !fSkip )
     {
         const IFMP ifmp = m_pinst->m_mpdbidifmp[ plrscrub->dbid ];
-        Call( ErrLGIAccessPage( ppib, &csr, ifmp, plrscrub->le_pgno, plrscrub->le_objidFDP, fFalse ) );
-        const BOOL fRedo = FLGNeedRedoCheckDbtimeBefore( csr, plrscrub->le_dbtime, plrscrub->le_dbtimeBefore, &err );
-        Call( err );
-        if( fRedo )
+
+        if ( m_cLGRedoPageWorker > 0 )
         {
-            csr.UpgradeFromRIWLatch();
-            if( plrscrub->FUnusedPage() )
+            if ( FLGRIRedoOnPageWorker( plrscrub, ifmp ) )
             {
-                Call( ErrNDScrubOneUnusedPage( ppib, ifmp, &csr, fDIRRedo ) );
+                return ErrLGRIDispatchRedoPageWorker( ifmp, plrscrub->le_pgno, plrscrub );
             }
-            else
+
+            Call( ErrLGRIWaitRedoPageWorker( ifmp, plrscrub->le_pgno ) );
+        }
+
+        Call( ErrLGRIRedoScrubOnPage( ppib, ifmp, plrscrub ) );
+    }
+HandleError:
+    return err;
+}
+
+ERR LOG::ErrLGRIRedoScrubOnPage( PIB *ppib, const IFMP ifmp, const LRSCRUB * const plrscrub )
+{
+    ERR err = JET_errSuccess;
+    CSR csr;
+    BOOL fRedo;
+
+    Call( ErrLGIAccessPage( ppib, &csr, ifmp, plrscrub->le_pgno, plrscrub->le_objidFDP, fFalse ) );
+    fRedo = FLGNeedRedoCheckDbtimeBefore( csr, plrscrub->le_dbtime, plrscrub->le_dbtimeBefore, &err );
+    Call( err );
+    if( fRedo )
+    {
+        csr.UpgradeFromRIWLatch();
+        if( plrscrub->FUnusedPage() )
+        {
+            Call( ErrNDScrubOneUnusedPage( ppib, ifmp, &csr, fDIRRedo ) );
+        }
+        else
+        {
+            const SCRUBOPER * const pscrubOper = (SCRUBOPER *) plrscrub->PbData();
+            const INT cscrubOper = plrscrub->CscrubOper();
+            Call( ErrNDScrubOneUsedPage( ppib, ifmp, &csr, pscrubOper, cscrubOper, fDIRRedo ) );
+        }
+        CallS( err );
+        csr.SetDbtime( plrscrub->le_dbtime );
+    }
+HandleError:
+    csr.ReleasePage();
+    return err;
+}
+
+const INT cLGRedoPageWorkerMax = 16;
+
+class CRedoPageWorkers
+{
+    public:
+        CRedoPageWorkers( LOG * const plog, INST * const pinst );
+        ~CRedoPageWorkers();
+
+        ERR ErrInit( const INT cworker );
+
+        ERR ErrDispatch( const IFMP ifmp, const PGNO pgno, const LGPOS& lgpos, const LR * const plr );
+        ERR ErrWaitForPage( const IFMP ifmp, const PGNO pgno );
+        ERR ErrDrain();
+        VOID PurgeSessions();
+        VOID MinPendingLgpos( LGPOS * const plgpos );
+
+    private:
+        enum { citemQueueMax = 1024 };
+
+        struct ITEM
+        {
+            ITEM *      pitemNext;
+            LGPOS       lgpos;
+            IFMP        ifmp;
+        };
+
+        struct WORKER
+        {
+            WORKER() :
+                crit( CLockBasicInfo( CSyncBasicInfo( szLGRedoPageWorker ), rankLGRedoPageWorker, 0 ) ),
+                asigWork( CSyncBasicInfo( _T( "CRedoPageWorkers::WORKER::asigWork" ) ) ),
+                msigIdle( CSyncBasicInfo( _T( "CRedoPageWorkers::WORKER::msigIdle" ) ) ),
+                pworkers( NULL ),
+                thread( NULL ),
+                ppib( ppibNil ),
+                pctablehash( NULL ),
+                pitemHead( NULL ),
+                pitemTail( NULL ),
+                citem( 0 ),
+                err( JET_errSuccess ),
+                fTerm( fFalse )
+            {
+                msigIdle.Set();
+            }
+
+            CCriticalSection    crit;
+            CAutoResetSignal    asigWork;
+            CManualResetSignal  msigIdle;
+            CRedoPageWorkers *  pworkers;
+            THREAD              thread;
+            PIB *               ppib;
+            CTableHash *        pctablehash;
+            ITEM *              pitemHead;
+            ITEM *              pitemTail;
+            INT                 citem;
+            ERR                 err;
+            BOOL                fTerm;
+        };
+
+        static DWORD DwWorkerThreadProc( DWORD_PTR dwContext );
+
+        WORKER * PworkerFromPage( const IFMP ifmp, const PGNO pgno ) const
+        {
+            return &m_rgworker[ ( ( ULONG( ifmp ) << 24 ) ^ pgno ) % m_cworker ];
+        }
+
+        ERR ErrWorker( WORKER * const pworker );
+        VOID PurgeSession( WORKER * const pworker );
+        VOID TermWorker( WORKER * const pworker );
+
+        LOG * const     m_plog;
+        INST * const    m_pinst;
+        INT             m_cworker;
+        WORKER *        m_rgworker;
+};
+
+CRedoPageWorkers::CRedoPageWorkers( LOG * const plog, INST * const pinst ) :
+    m_plog( plog ),
+    m_pinst( pinst ),
+    m_cworker( 0 ),
+    m_rgworker( NULL )
+{
+}
+
+CRedoPageWorkers::~CRedoPageWorkers()
+{
+    for ( INT iworker = 0; iworker < m_cworker; iworker++ )
+    {
+        TermWorker( &m_rgworker[ iworker ] );
+    }
+
+    delete[] m_rgworker;
+}
+
+ERR CRedoPageWorkers::ErrInit( const INT cworker )
+{
+    ERR err = JET_errSuccess;
+
+    Assert( cworker > 0 );
+    Assert( NULL == m_rgworker );
+
+    Alloc( m_rgworker = new WORKER[ cworker ] );
+    m_cworker = cworker;
+
+    for ( INT iworker = 0; iworker < m_cworker; iworker++ )
+    {
+        WORKER * const pworker = &m_rgworker[ iworker ];
+
+        pworker->pworkers = this;
+        Alloc( pworker->pctablehash = new CTableHash( (ULONG)UlParam( m_pinst, JET_paramMaxCursors ) ) );
+        Call( pworker->pctablehash->ErrInit() );
+        Call( ErrPIBBeginSession( m_pinst, &pworker->ppib, procidNil, fFalse ) );
+        Call( ErrUtilThreadCreate( DwWorkerThreadProc, 0, priorityNormal, &pworker->thread, (DWORD_PTR)pworker ) );
+    }
+
+HandleError:
+    return err;
+}
+
+DWORD CRedoPageWorkers::DwWorkerThreadProc( DWORD_PTR dwContext )
+{
+    WORKER * const  pworker = (WORKER *)dwContext;
+    LOG * const     plog    = pworker->pworkers->m_plog;
+    BOOL            fTerm   = fFalse;
+
+    while ( !fTerm )
+    {
+        pworker->asigWork.Wait();
+
+        pworker->crit.Enter();
+        while ( NULL != pworker->pitemHead )
+        {
+            ITEM * const    pitem   = pworker->pitemHead;
+            ERR             err     = pworker->err;
+            pworker->crit.Leave();
+
+            if ( err >= JET_errSuccess )
             {
-                const SCRUBOPER * const pscrubOper = (SCRUBOPER *) plrscrub->PbData();
-                const INT cscrubOper = plrscrub->CscrubOper();
-                Call( ErrNDScrubOneUsedPage( ppib, ifmp, &csr, pscrubOper, cscrubOper, fDIRRedo ) );
+                err = plog->ErrLGRIRedoOnPageWorker( pworker->ppib, pworker->pctablehash, pitem->ifmp, pitem->lgpos, (LR *)( pitem + 1 ) );
             }
-            CallS( err );
-            csr.SetDbtime( plrscrub->le_dbtime );
+
+            pworker->crit.Enter();
+            pworker->pitemHead = pitem->pitemNext;
+            if ( NULL == pworker->pitemHead )
+            {
+                pworker->pitemTail = NULL;
+            }
+            pworker->citem--;
+            if ( err < JET_errSuccess && pworker->err >= JET_errSuccess )
+            {
+                pworker->err = err;
+            }
+            pworker->crit.Leave();
+
+            OSMemoryHeapFree( pitem );
+
+            pworker->crit.Enter();
         }
+        Assert( 0 == pworker->citem );
+        pworker->msigIdle.Set();
+        fTerm = pworker->fTerm;
+        pworker->crit.Leave();
+    }
+
+    return 0;
+}
+
+ERR CRedoPageWorkers::ErrWorker( WORKER * const pworker )
+{
+    pworker->crit.Enter();
+    const ERR err = pworker->err;
+    pworker->crit.Leave();
+
+    return err;
+}
+
+ERR CRedoPageWorkers::ErrDispatch( const IFMP ifmp, const PGNO pgno, const LGPOS& lgpos, const LR * const plr )
+{
+    ERR             err     = JET_errSuccess;
+    WORKER * const  pworker = PworkerFromPage( ifmp, pgno );
+    const ULONG     cbLR    = CbLGSizeOfRec( plr );
+    ITEM *          pitem   = NULL;
+
+    pworker->crit.Enter();
+    const BOOL fQueueFull = pworker->citem >= citemQueueMax;
+    pworker->crit.Leave();
+
+    if ( fQueueFull )
+    {
+        pworker->msigIdle.Wait();
+    }
+
+    Call( ErrWorker( pworker ) );
+
+    Alloc( pitem = (ITEM *)PvOSMemoryHeapAlloc( sizeof( ITEM ) + cbLR ) );
+    pitem->pitemNext = NULL;
+    pitem->lgpos = lgpos;
+    pitem->ifmp = ifmp;
+    UtilMemCpy( pitem + 1, plr, cbLR );
+
+    pworker->crit.Enter();
+    if ( NULL == pworker->pitemTail )
+    {
+        pworker->pitemHead = pitem;
+    }
+    else
+    {
+        pworker->pitemTail->pitemNext = pitem;
     }
+    pworker->pitemTail = pitem;
+    pworker->citem++;
+    pworker->msigIdle.Reset();
+    pworker->crit.Leave();
+
+    pworker->asigWork.Set();
+
 HandleError:
-    csr.ReleasePage();
     return err;
 }
 
+ERR CRedoPageWorkers::ErrWaitForPage( const IFMP ifmp, const PGNO pgno )
+{
+    WORKER * const pworker = PworkerFromPage( ifmp, pgno );
+
+    pworker->msigIdle.Wait();
+
+    return ErrWorker( pworker );
+}
+
+ERR CRedoPageWorkers::ErrDrain()
+{
+    ERR err = JET_errSuccess;
+
+    for ( INT iworker = 0; iworker < m_cworker; iworker++ )
+    {
+        m_rgworker[ iworker ].msigIdle.Wait();
+
+        const ERR errT = ErrWorker( &m_rgworker[ iworker ] );
+        if ( errT < JET_errSuccess && err >= JET_errSuccess )
+        {
+            err = errT;
+        }
+    }
+
+    return err;
+}
+
+VOID CRedoPageWorkers::PurgeSession( WORKER * const pworker )
+{
+    Assert( pworker->msigIdle.FIsSet() );
+
+    if ( NULL != pworker->pctablehash )
+    {
+        pworker->pctablehash->PurgeUnversionedTables();
+    }
+
+    if ( ppibNil != pworker->ppib )
+    {
+        for ( DBID dbid = dbidUserLeast; dbid < dbidMax; dbid++ )
+        {
+            while ( FPIBUserOpenedDatabase( pworker->ppib, dbid ) )
+            {
+                DBResetOpenDatabaseFlag( pworker->ppib, m_pinst->m_mpdbidifmp[ dbid ] );
+            }
+        }
+    }
+}
+
+VOID CRedoPageWorkers::PurgeSessions()
+{
+    for ( INT iworker = 0; iworker < m_cworker; iworker++ )
+    {
+        PurgeSession( &m_rgworker[ iworker ] );
+    }
+}
+
+VOID CRedoPageWorkers::MinPendingLgpos( LGPOS * const plgpos )
+{
+    for ( INT iworker = 0; iworker < m_cworker; iworker++ )
+    {
+        WORKER * const pworker = &m_rgworker[ iworker ];
+
+        pworker->crit.Enter();
+        if ( NULL != pworker->pitemHead && CmpLgpos( pworker->pitemHead->lgpos, *plgpos ) < 0 )
+        {
+            *plgpos = pworker->pitemHead->lgpos;
+        }
+        pworker->crit.Leave();
+    }
+}
+
+VOID CRedoPageWorkers::TermWorker( WORKER * const pworker )
+{
+    if ( NULL != pworker->thread )
+    {
+        pworker->crit.Enter();
+        pworker->fTerm = fTrue;
+        pworker->crit.Leave();
+
+        pworker->asigWork.Set();
+        UtilThreadEnd( pworker->thread );
+        pworker->thread = NULL;
+    }
+
+    Assert( NULL == pworker->pitemHead );
+
+    PurgeSession( pworker );
+
+    if ( ppibNil != pworker->ppib )
+    {
+        PIBEndSession( pworker->ppib );
+        pworker->ppib = ppibNil;
+    }
+
+    delete pworker->pctablehash;
+    pworker->pctablehash = NULL;
+}
+
+BOOL LOG::FLGRIRedoOnPageWorker( const LR * const plr, const IFMP ifmp ) const
+{
+    if ( FRedoMapNeeded( ifmp ) || NULL != g_rgfmp[ ifmp ].PLogRedoMapZeroed() )
+    {
+        return fFalse;
+    }
+
+    switch ( plr->lrtyp )
+    {
+        case lrtypScrub:
+            return fTrue;
+
+        case lrtypInsert:
+        case lrtypFlagInsert:
+        case lrtypReplace:
+        case lrtypReplaceD:
+        case lrtypFlagDelete:
+        case lrtypDelta:
+        case lrtypDelta64:
+        case lrtypSetExternalHeader:
+            return !( (const LRNODE_ *)plr )->FVersioned();
+
+        default:
+            return fFalse;
+    }
+}
+
+ERR LOG::ErrLGRIRedoOnPageWorker( PIB *ppib, CTableHash *pctablehash, const IFMP ifmp, const LGPOS& lgpos, const LR * const plr )
+{
+    ERR err;
+
+    if ( !FPIBUserOpenedDatabase( ppib, g_rgfmp[ ifmp ].Dbid() ) )
+    {
+        DBSetOpenDatabaseFlag( ppib, ifmp );
+    }
+
+    //  CPAGE::Dirty() takes the page's begin0 from the session, so the worker session
+    //  must carry the position of the record it is redoing for the checkpoint to stay
+    //  behind the page until it is flushed
+
+    Assert( CmpLgpos( &ppib->lgposStart, &lgposMax ) == 0 );
+    ppib->lgposStart = lgpos;
+
+    if ( lrtypScrub == plr->lrtyp )
+    {
+        err = ErrLGRIRedoScrubOnPage( ppib, ifmp, (const LRSCRUB *)plr );
+    }
+    else
+    {
+        err = ErrLGRIRedoNodeOperationOnPage( ppib, pctablehash, (const LRNODE_ *)plr );
+    }
+
+    ppib->lgposStart = lgposMax;
+
+    if ( errSkipLogRedoOperation == err )
+    {
+        err = JET_errSuccess;
+    }
+
+    return err;
+}
+
+ERR LOG::ErrLGRIDispatchRedoPageWorker( const IFMP ifmp, const PGNO pgno, const LR * const plr )
+{
+    ERR                 err                 = JET_errSuccess;
+    CRedoPageWorkers    *predopageworkers   = NULL;
+
+    Assert( m_cLGRedoPageWorker > 0 );
+
+    if ( NULL == m_predopageworkers )
+    {
+        Alloc( predopageworkers = new CRedoPageWorkers( this, m_pinst ) );
+        Call( predopageworkers->ErrInit( m_cLGRedoPageWorker ) );
+
+        m_critCheckpoint.Enter();
+        m_predopageworkers = predopageworkers;
+        m_critCheckpoint.Leave();
+        predopageworkers = NULL;
+    }
+
+    Call( m_predopageworkers->ErrDispatch( ifmp, pgno, m_lgposRedo, plr ) );
+
+HandleError:
+    delete predopageworkers;
+    return err;
+}
+
+ERR LOG::ErrLGRIWaitRedoPageWorker( const IFMP ifmp, const PGNO pgno )
+{
+    if ( NULL == m_predopageworkers )
+    {
+        return JET_errSuccess;
+    }
+
+    return m_predopageworkers->ErrWaitForPage( ifmp, pgno );
+}
+
+ERR LOG::ErrLGRIRedoPageWorkerBarrier( const LR * const plr )
+{
+    if ( NULL == m_predopageworkers )
+    {
+        return JET_errSuccess;
+    }
+
+    switch ( plr->lrtyp )
+    {
+        case lrtypNOP:
+        case lrtypNOP2:
+        case lrtypChecksum:
+        case lrtypTrace:
+        case lrtypJetOp:
+        case lrtypForceWriteLog:
+        case lrtypForceLogRollover:
+        case lrtypBegin:
+        case lrtypBegin0:
+        case lrtypBeginDT:
+        case lrtypRefresh:
+        case lrtypCommit0:
+        case lrtypMacroBegin:
+        case lrtypInsert:
+        case lrtypFlagInsert:
+        case lrtypFlagInsertAndReplaceData:
+        case lrtypReplace:
+        case lrtypReplaceD:
+        case lrtypFlagDelete:
+        case lrtypDelete:
+        case lrtypDelta:
+        case lrtypDelta64:
+        case lrtypUndo:
+        case lrtypUndoInfo:
+        case lrtypSetExternalHeader:
+        case lrtypScrub:
+            return JET_errSuccess;
+
+        default:
+            return ErrLGRIDrainRedoPageWorkers();
+    }
+}
+
+ERR LOG::ErrLGRIDrainRedoPageWorkers()
+{
+    if ( NULL == m_predopageworkers )
+    {
+        return JET_errSuccess;
+    }
+
+    const ERR err = m_predopageworkers->ErrDrain();
+    m_predopageworkers->PurgeSessions();
+
+    return err;
+}
+
+VOID LOG::LGRITermRedoPageWorkers()
+{
+    m_critCheckpoint.Enter();
+    CRedoPageWorkers * const predopageworkers = m_predopageworkers;
+    m_predopageworkers = NULL;
+    m_critCheckpoint.Leave();
+
+    delete predopageworkers;
+}
+
+LGPOS LOG::LgposLGRIRedoApplied()
+{
+    Assert( m_critCheckpoint.FOwner() );
+
+    LGPOS lgpos = m_lgposRedo;
+    if ( NULL != m_predopageworkers )
+    {
+        m_predopageworkers->MinPendingLgpos( &lgpos );
+    }
+
+    return lgpos;
+}
+
 ERR LOG::ErrLGEvaluateDestructiveCorrectiveLogOptions(
     __in const LONG lgenBad,
     __in const ERR errCondition
@@ -9932,6 +10470,7 @@ ERR LOG::ErrLGRIRedoOperations(
     BOOL                fShowSectorStatus       = fFalse;
 
     LGPOS               lgposLastRedoLogRec     = lgposMin;
+    WCHAR               wszRedoPageWorker[ 16 ] = { 0 };
 
     double secInCallbackBegin, secInCallbackEnd, secThrottledBegin, secThrottledEnd;
     __int64 cCallbacksBegin, cCallbacksEnd, cThrottledBegin, cThrottledEnd;
@@ -9986,6 +10525,16 @@ ERR LOG::ErrLGRIRedoOperations(
     Assert( m_pPrereadWatermarks == pNil );
     AllocR( m_pPrereadWatermarks = new CSimpleQueue<LGPOSQueueNode>() );
 
+    Assert( NULL == m_predopageworkers );
+    m_cLGRedoPageWorker = (INT)UlConfigOverrideInjection( 36438, 0 );
+    if ( 0 == m_cLGRedoPageWorker &&
+            FOSConfigGet( L"LOG", L"Parallel Redo Workers", wszRedoPageWorker, sizeof( wszRedoPageWorker ) ) &&
+            wszRedoPageWorker[ 0 ] )
+    {
+        m_cLGRedoPageWorker = (INT)_wtol( wszRedoPageWorker );
+    }
+    m_cLGRedoPageWorker = max( 0, min( cLGRedoPageWorkerMax, m_cLGRedoPageWorker ) );
+
     LONG lgenHighAtStartOfRedo;
     Call( m_pLogStream->ErrLGGetGenerationRange( m_wszLogCurrent, NULL, &lgenHighAtStartOfRedo ) );
     if ( m_pLogStream->FCurrentLogExists() )
@@ -10314,6 +10863,8 @@ ProcessNextRec:
             IFMP rgifmpsAttached[ dbidMax ];
             ULONG cifmpsAttached = 0;
 
+            Call( ErrLGRIDrainRedoPageWorkers() );
+
             if ( m_lgposRedo.lGeneration > m_lgposFlushTip.lGeneration + LLGElasticWaypointLatency() )
             {
                 BOOL fFlushed = fFalse;
@@ -10372,6 +10923,7 @@ ProcessNextRec:
             }
         }
 
+        Call( ErrLGRIRedoPageWorkerBarrier( plr ) );
 
         switch ( plr->lrtyp )
         {
@@ -11139,6 +11691,15 @@ Done:
     err = errT;
 
 HandleError:
+
+    {
+        const ERR errDrain = ErrLGRIDrainRedoPageWorkers();
+        if ( err >= JET_errSuccess && errDrain < JET_errSuccess )
+        {
+            err = errDrain;
+        }
+        LGRITermRedoPageWorkers();
+    }
     
 #ifndef RFS2
     AssertSz( err >= 0,     "Debug Only, Ignore this Assert");
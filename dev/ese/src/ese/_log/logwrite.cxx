@@ -240,6 +240,13 @@ LOG_WRITE_BUFFER::ErrLGInit()
     ERR err;
     Alloc( m_pvPartialSegment = (BYTE *)PvOSMemoryPageAlloc( LOG_SEGMENT_SIZE, NULL ) );
 
+    WCHAR wszBuf[ 16 ] = { 0 };
+    if (    FOSConfigGet( L"LOG", L"Copy Completion Tracking", wszBuf, sizeof( wszBuf ) ) &&
+            wszBuf[ 0 ] )
+    {
+        m_fCopyCompletionTracking = !!_wtol( wszBuf );
+    }
+
 HandleError:
     return err;
 }
@@ -997,6 +1004,131 @@ LOG_WRITE_BUFFER::FLGIAddLogRec(
 }
 
 
+BOOL LOG_WRITE_BUFFER::FLGICopySlotAvailable()
+{
+    Assert( m_critLGBuf.FOwner() );
+
+    if ( !m_fCopyCompletionTracking )
+    {
+        return fTrue;
+    }
+
+    LGIRetireCopySlots();
+    return m_icopyslotNext - m_icopyslotOldest < cLGCopySlot;
+}
+
+
+ULONG LOG_WRITE_BUFFER::IcopyslotLGIReserve( BYTE* const pbLogRec, const LGPOS& lgposMaxWritePoint )
+{
+    Assert( m_critLGBuf.FOwner() );
+    Assert( m_fCopyCompletionTracking );
+
+    //  ErrLGLogRec checked for a free slot before reserving any buffer space and has held
+    //  m_critLGBuf since, so the ring cannot have filled up
+
+    Assert( m_icopyslotNext - m_icopyslotOldest < cLGCopySlot );
+
+    LGCOPYSLOT* const pcopyslot = &m_rgcopyslot[ m_icopyslotNext % cLGCopySlot ];
+    pcopyslot->pbStart = pbLogRec;
+    pcopyslot->lgposMaxWritePoint = lgposMaxWritePoint;
+    pcopyslot->fCopied = fFalse;
+
+    return m_icopyslotNext++;
+}
+
+
+VOID LOG_WRITE_BUFFER::LGICompleteCopySlot( const ULONG icopyslot )
+{
+    Assert( m_critLGBuf.FNotOwner() );
+
+    AtomicExchange( &m_rgcopyslot[ icopyslot % cLGCopySlot ].fCopied, fTrue );
+}
+
+
+VOID LOG_WRITE_BUFFER::LGIRetireCopySlots()
+{
+    Assert( m_critLGBuf.FOwner() );
+
+    while ( m_icopyslotOldest != m_icopyslotNext &&
+            AtomicRead( &m_rgcopyslot[ m_icopyslotOldest % cLGCopySlot ].fCopied ) )
+    {
+        m_icopyslotOldest++;
+    }
+}
+
+
+//  Waits for every record reserved before icopyslotEnd to be copied into the log buffer.
+//  Called without m_critLGBuf so that inserting threads are not held up by the wait. A slot
+//  is only reused once it has been retired, so a slot that has not been retired yet still
+//  belongs to the record we are waiting for.
+
+VOID LOG_WRITE_BUFFER::LGIWaitForCopySlots( const ULONG icopyslotEnd )
+{
+    Assert( m_critLGBuf.FNotOwner() );
+
+    for ( ULONG icopyslot = (ULONG)AtomicRead( (LONG*)&m_icopyslotOldest ); LONG( icopyslotEnd - icopyslot ) > 0; icopyslot++ )
+    {
+        while ( LONG( AtomicRead( (LONG*)&m_icopyslotOldest ) - icopyslot ) <= 0 &&
+                !AtomicRead( &m_rgcopyslot[ icopyslot % cLGCopySlot ].fCopied ) )
+        {
+            UtilSleep( 0 );
+        }
+    }
+}
+
+
+//  Finds how far the log buffer has been copied into without giving up m_critLGBuf. When a
+//  record we need is still being copied this returns fFalse and the slot to wait for, and the
+//  caller must leave m_critLGBuf, call LGIWaitForCopySlots() and then start over, because any
+//  state it looked at under the lock may have changed while it waited.
+
+BOOL LOG_WRITE_BUFFER::FLGICopiedEntry( BYTE** const ppbCopiedEntry, LGPOS* const plgposMaxWritePoint, ULONG* const picopyslotWait )
+{
+    Assert( m_critLGBuf.FOwner() );
+
+    if ( !m_fCopyCompletionTracking )
+    {
+        m_msLGPendingCopyIntoBuffer.Partition();
+    }
+    else
+    {
+        LGIRetireCopySlots();
+
+        if ( pbNil != m_pbLGFileEnd )
+        {
+            //  while closing out a generation everything up to the file end must be copied,
+            //  records reserved after it land in the next generation
+
+            if ( LONG( m_icopyslotFileEnd - m_icopyslotOldest ) > 0 )
+            {
+                *picopyslotWait = m_icopyslotFileEnd;
+                return fFalse;
+            }
+        }
+        else if ( m_icopyslotOldest != m_icopyslotNext )
+        {
+            //  otherwise we only need the oldest record still being copied to finish
+
+            const LGCOPYSLOT* const pcopyslot = &m_rgcopyslot[ m_icopyslotOldest % cLGCopySlot ];
+            if ( pcopyslot->pbStart == m_pbWrite ||
+                 CmpLgpos( &pcopyslot->lgposMaxWritePoint, &m_lgposToWrite ) < 0 )
+            {
+                *picopyslotWait = m_icopyslotOldest + 1;
+                return fFalse;
+            }
+
+            *ppbCopiedEntry = pcopyslot->pbStart;
+            *plgposMaxWritePoint = pcopyslot->lgposMaxWritePoint;
+            return fTrue;
+        }
+    }
+
+    *ppbCopiedEntry = m_pbEntry;
+    *plgposMaxWritePoint = m_lgposMaxWritePoint;
+    return fTrue;
+}
+
+
 
 #ifdef DEBUG
 BYTE g_rgbDumpLogRec[ g_cbPageMax ];
@@ -1019,6 +1151,7 @@ LOG_WRITE_BUFFER::ErrLGLogRec(
     BYTE*       pbLogRec            = pbNil;
     BOOL        fForcedNewGen       = fFalse;
     LGPOS       lgposLogRecTmpLog   = lgposMax;
+    LGPOS       lgposMaxWritePointPrev  = lgposMin;
 
     Assert( ( fLGFlags & fLGFillPartialSector ) || rgdata[0].Pv() != NULL );
     Expected( !(( fLGFlags & fLGFillPartialSector ) && ( fLGFlags & fLGCreateNewGen )) );
@@ -1062,6 +1195,15 @@ LOG_WRITE_BUFFER::ErrLGLogRec(
             return ErrERRCheck( JET_errLogWriteFail );
         }
 
+        //  every copy slot is in use, wait for copies to finish without holding up the buffer
+
+        if ( !FLGICopySlotAvailable() )
+        {
+            m_critLGBuf.Leave();
+            UtilSleep( 0 );
+            continue;
+        }
+
         const LRTYP lrtyp = rgdata ? *( (LRTYP *)rgdata[0].Pv() ) : lrtypNOP;
         if ( lrtyp == lrtypCommit0 )
         {
@@ -1313,6 +1455,7 @@ LOG_WRITE_BUFFER::ErrLGLogRec(
         m_pbLGFileEnd = m_pbEntry;
         Assert( m_pLogStream->PbSecAligned( m_pbLGFileEnd, m_pbLGBufMin ) == m_pbLGFileEnd );
         m_isecLGFileEnd = isecLGFileEndT;
+        m_icopyslotFileEnd = m_icopyslotNext;
 
         OSTraceWriteRefLog( ostrlSystemFixed, sysosrtlDatapoint|sysosrtlContextInst, m_pinst, (PVOID)&(m_pinst->m_iInstance), sizeof(m_pinst->m_iInstance) );
 
@@ -1376,6 +1519,8 @@ LOG_WRITE_BUFFER::ErrLGLogRec(
 
 
 
+    lgposMaxWritePointPrev = m_lgposMaxWritePoint;
+
     pbSectorBoundary = m_pLogStream->PbSecAligned( m_pbEntry + cbReq, m_pbLGBufMin );
 
     if ( m_pLogStream->PbSecAligned( m_pbEntry, m_pbLGBufMin ) == pbSectorBoundary )
@@ -1482,7 +1627,8 @@ LOG_WRITE_BUFFER::ErrLGLogRec(
         lgposLogRecTmpLog = m_lgposLogRec;
     }
 
-    const INT   iGroup  = m_msLGPendingCopyIntoBuffer.Enter();
+    const INT   iGroup      = m_fCopyCompletionTracking ? 0 : m_msLGPendingCopyIntoBuffer.Enter();
+    const ULONG icopyslot   = m_fCopyCompletionTracking ? IcopyslotLGIReserve( pbLogRec, lgposMaxWritePointPrev ) : 0;
 
     if ( fLGFlags & fLGFillPartialSector )
     {
@@ -1510,7 +1656,14 @@ LOG_WRITE_BUFFER::ErrLGLogRec(
         Enforce( fCopiedLR );
     }
 
-    m_msLGPendingCopyIntoBuffer.Leave( iGroup );
+    if ( m_fCopyCompletionTracking )
+    {
+        LGICompleteCopySlot( icopyslot );
+    }
+    else
+    {
+        m_msLGPendingCopyIntoBuffer.Leave( iGroup );
+    }
 
     TLS* ptls;
     ptls = Ptls();
@@ -1821,11 +1974,17 @@ VOID LOG_WRITE_BUFFER::DecommitLogBufferTask( VOID * pvGroupContext, VOID * pvLo
 VOID LOG_WRITE_BUFFER::InitLogBuffer( const BOOL fLGFlags )
 {
     Assert( m_critLGBuf.FOwner() );
+
+    //  nothing is being copied into the buffer when it is reset, only records for the
+    //  next generation can still be in flight when the old one is closed out
+
+    LGIRetireCopySlots();
     
     if ( fLGFlags == fLGOldLogExists || fLGFlags == fLGOldLogInBackup )
     {
         if ( m_pLog->FRecovering() && m_pLog->FRecoveringMode() == fRecoveringRedo )
         {
+            Assert( m_icopyslotOldest == m_icopyslotNext );
             m_pbWrite = m_pbLGBufMin;
             m_pbEntry = m_pbLGBufMin;
         }
@@ -1838,6 +1997,7 @@ VOID LOG_WRITE_BUFFER::InitLogBuffer( const BOOL fLGFlags )
     }
     else
     {
+        Assert( m_icopyslotOldest == m_icopyslotNext );
         m_pbWrite = m_pbLGBufMin;
         m_pbEntry = m_pbLGBufMin;
     }
@@ -2412,17 +2572,22 @@ ERR LOG_WRITE_BUFFER::ErrLGIDeferredWrite( const IOREASONPRIMARY iorp, const BOO
     UINT    isecWrite;
     BYTE*   pbWrite = pbNil;
     LGPOS   lgposWriteEnd = lgposMax;
+    ULONG   icopyslotWait = 0;
 
-    m_critLGBuf.Enter();
+    forever
+    {
+        m_critLGBuf.Enter();
 
-    m_msLGPendingCopyIntoBuffer.Partition();
+        if ( FLGICopiedEntry( &pbEndOfData, &lgposWriteEnd, &icopyslotWait ) )
+        {
+            break;
+        }
 
-    if ( pbNil == m_pbLGFileEnd )
-    {
-        pbEndOfData = m_pbEntry;
-        lgposWriteEnd = m_lgposMaxWritePoint;
+        m_critLGBuf.Leave();
+        LGIWaitForCopySlots( icopyslotWait );
     }
-    else
+
+    if ( pbNil != m_pbLGFileEnd )
     {
         pbEndOfData = m_pbLGFileEnd;
         Assert( m_pLogStream->PbSecAligned( pbEndOfData, m_pbLGBufMin ) == pbEndOfData );
@@ -2537,6 +2702,9 @@ ERR LOG_WRITE_BUFFER::ErrLGIWriteLog( const IOREASONPRIMARY iorp, const BOOL fWr
     BYTE*   pbEndOfData;
     LGPOS   lgposWriteEnd;
     BOOL    fNewGeneration;
+    BYTE*   pbCopiedEntry;
+    LGPOS   lgposCopiedMaxWritePoint;
+    ULONG   icopyslotWait;
 
 Repeat:
     fNewGeneration  = fFalse;
@@ -2581,7 +2749,15 @@ Repeat:
         goto HandleError;
     }
 
-    m_msLGPendingCopyIntoBuffer.Partition();
+    //  the checks above only hold while we own m_critLGBuf, so if we have to wait for a
+    //  record to be copied we make them again afterwards
+
+    if ( !FLGICopiedEntry( &pbCopiedEntry, &lgposCopiedMaxWritePoint, &icopyslotWait ) )
+    {
+        m_critLGBuf.Leave();
+        LGIWaitForCopySlots( icopyslotWait );
+        goto Repeat;
+    }
 
     if ( pbNil != m_pbLGFileEnd )
     {
@@ -2595,7 +2771,7 @@ Repeat:
     {
         LGPOS   lgposEndOfData = lgposMin;
 
-        pbEndOfData = m_pbEntry;
+        pbEndOfData = pbCopiedEntry;
 
         m_pLogBuffer->GetLgpos( pbEndOfData, &lgposEndOfData, m_pLogStream );
 
@@ -2606,7 +2782,7 @@ Repeat:
             goto HandleError;
         }
 
-        lgposWriteEnd = m_lgposMaxWritePoint;
+        lgposWriteEnd = lgposCopiedMaxWritePoint;
     }
 
     isecWrite = m_isecWrite;
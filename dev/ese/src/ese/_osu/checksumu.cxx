@@ -354,6 +354,82 @@ void ChecksumPage(
 }
 
 
+//  Pages using the new checksum format are checksummed a chunk at a time: the header blocks
+//  of the chunk in one call and the remaining blocks in another, so that the kernel can work
+//  on more than one block per pass. Any other page is checksummed on its own.
+
+void ChecksumPages(
+    const void * const * const rgpv,
+    const ULONG * const rgpgno,
+    const UINT cpage,
+    const UINT cb,
+    const PAGETYPE pagetype,
+    PAGECHECKSUM * const rgchecksumExpected,
+    PAGECHECKSUM * const rgchecksumActual )
+{
+    const UINT cpageChunkMax = 16;
+    const UINT cbBlock = CbBlockSize( cb );
+    const UINT cblkBody = cb / cbBlock - 1;
+    const BOOL fBlocksEven = ( 0 == cb % cbBlock ) && ( cblkBody < cxeChecksumPerPage );
+
+    const unsigned char *   rgpbHeader[ cpageChunkMax ];
+    ULONG                   rgpgnoHeader[ cpageChunkMax ];
+    XECHECKSUM              rgxeHeader[ cpageChunkMax ];
+    UINT                    rgipageHeader[ cpageChunkMax ];
+    const unsigned char *   rgpbBody[ cpageChunkMax * ( cxeChecksumPerPage - 1 ) ];
+    ULONG                   rgpgnoBody[ cpageChunkMax * ( cxeChecksumPerPage - 1 ) ];
+    XECHECKSUM              rgxeBody[ cpageChunkMax * ( cxeChecksumPerPage - 1 ) ];
+
+    for ( UINT ipage = 0; ipage < cpage; ipage++ )
+    {
+        rgchecksumExpected[ ipage ] = ChecksumFromPage( rgpv[ ipage ], cb, pagetype );
+    }
+
+    for ( UINT ipageChunk = 0; ipageChunk < cpage; ipageChunk += cpageChunkMax )
+    {
+        const UINT ipageChunkMac = min( cpage, ipageChunk + cpageChunkMax );
+        UINT cpageNew = 0;
+
+        for ( UINT ipage = ipageChunk; ipage < ipageChunkMac; ipage++ )
+        {
+            const unsigned char * const pb = (const unsigned char *)rgpv[ ipage ];
+
+            if ( !fBlocksEven ||
+                !FPageHasLongChecksum( pagetype ) ||
+                !FPageHasNewChecksumFormat( pb, pagetype ) )
+            {
+                rgchecksumActual[ ipage ] = ComputePageChecksum( pb, cb, pagetype, rgpgno[ ipage ] );
+                continue;
+            }
+
+            rgpbHeader[ cpageNew ] = pb;
+            rgpgnoHeader[ cpageNew ] = rgpgno[ ipage ];
+            rgipageHeader[ cpageNew ] = ipage;
+            for ( UINT iblk = 0; iblk < cblkBody; iblk++ )
+            {
+                rgpbBody[ cpageNew * cblkBody + iblk ] = pb + ( iblk + 1 ) * cbBlock;
+                rgpgnoBody[ cpageNew * cblkBody + iblk ] = rgpgno[ ipage ];
+            }
+            cpageNew++;
+        }
+
+        ChecksumNewFormatMultiple( rgpbHeader, cbBlock, rgpgnoHeader, fTrue, rgxeHeader, cpageNew );
+        ChecksumNewFormatMultiple( rgpbBody, cbBlock, rgpgnoBody, fFalse, rgxeBody, cpageNew * cblkBody );
+
+        for ( UINT ipageNew = 0; ipageNew < cpageNew; ipageNew++ )
+        {
+            PAGECHECKSUM checksum;
+            checksum.rgChecksum[ 0 ] = rgxeHeader[ ipageNew ];
+            for ( UINT iblk = 0; iblk < cblkBody; iblk++ )
+            {
+                checksum.rgChecksum[ iblk + 1 ] = rgxeBody[ ipageNew * cblkBody + iblk ];
+            }
+            rgchecksumActual[ rgipageHeader[ ipageNew ] ] = checksum;
+        }
+    }
+}
+
+
 void ChecksumAndPossiblyFixPage(
     void * const pv,
     const UINT cb,
@@ -10,6 +10,24 @@
 
 extern VOID ITDBGSetConstants( INST * pinst = NULL);
 
+#ifdef PERFMON_SUPPORT
+
+PERFInstanceDelayedTotal<QWORD>     cBKReadBytes;
+LONG LBKReadBytesCEFLPv( LONG iInstance, VOID * pvBuf )
+{
+    cBKReadBytes.PassTo( iInstance, pvBuf );
+    return 0;
+}
+
+PERFInstanceDelayedTotal<>          cBKReadPipelineStalls;
+LONG LBKReadPipelineStallsCEFLPv( LONG iInstance, VOID * pvBuf )
+{
+    cBKReadPipelineStalls.PassTo( iInstance, pvBuf );
+    return 0;
+}
+
+#endif
+
 BACKUP_CONTEXT::BACKUP_CONTEXT( INST * pinst )
     : CZeroInit( sizeof( BACKUP_CONTEXT ) ),
       m_pinst( pinst ),
@@ -129,6 +147,319 @@ HandleError:
 }
 
 
+const INT   cbkreadslotMax          = 64;
+const ULONG cbBKReadSlotDefault     = 4 * 1024 * 1024;
+const ULONG cbBKReadSlotMax         = 64 * 1024 * 1024;
+const ULONG cbBKReadAheadMax        = 256 * 1024 * 1024;
+
+//  Read-ahead is bounded by the bytes in flight ("Read Ahead Size", 0 disables the
+//  pipeline), split into reads of at most "Read Pipeline Slot Size" bytes.
+
+LOCAL VOID BKIGetReadPipelineConfig( CPG * const pcpgReadAhead, CPG * const pcpgSlot )
+{
+    WCHAR   wszBuf[ 16 ];
+    ULONG   cbReadAhead = 0;
+    ULONG   cbSlot      = cbBKReadSlotDefault;
+
+    if (    FOSConfigGet( L"BACKUP", L"Read Ahead Size", wszBuf, sizeof( wszBuf ) ) &&
+            wszBuf[ 0 ] )
+    {
+        cbReadAhead = (ULONG)_wtol( wszBuf );
+    }
+    cbReadAhead = min( cbBKReadAheadMax, (ULONG)UlConfigOverrideInjection( 47260, cbReadAhead ) );
+
+    if (    FOSConfigGet( L"BACKUP", L"Read Pipeline Slot Size", wszBuf, sizeof( wszBuf ) ) &&
+            wszBuf[ 0 ] )
+    {
+        cbSlot = (ULONG)_wtol( wszBuf );
+    }
+    cbSlot = max( (ULONG)g_cbPage, min( cbBKReadSlotMax, (ULONG)UlConfigOverrideInjection( 47276, cbSlot ) ) );
+
+    *pcpgReadAhead = (CPG)( cbReadAhead / g_cbPage );
+    *pcpgSlot = max( 1, min( *pcpgReadAhead, (CPG)( cbSlot / g_cbPage ) ) );
+}
+
+
+
+class BKREADPIPELINE
+{
+    public:
+        BKREADPIPELINE( const IFMP ifmp, const CPG cpgReadAhead, const CPG cpgSlot, const BOOL fExtensiveChecks );
+        ~BKREADPIPELINE();
+
+        ERR ErrInit( const PGNO pgnoFirst );
+
+        IFMP Ifmp() const       { return m_ifmp; }
+        PGNO PgnoNext() const   { return m_pgnoNext; }
+
+        ERR ErrReadPages( const PGNO pgnoStart, const PGNO pgnoEnd, BYTE * const pbData );
+
+    private:
+        struct SLOT
+        {
+            SLOT() : asigDone( CSyncBasicInfo( _T( "BKREADPIPELINE::SLOT::asigDone" ) ) ) {}
+
+            BYTE *              pb;
+            PGNO                pgnoStart;
+            PGNO                pgnoEnd;
+            BOOL                fIssued;
+            BOOL                fComplete;
+            ERR                 errIssue;
+            volatile LONG       acRead;
+            CAutoResetSignal    asigDone;
+            READPAGE_DATA       readdata;
+        };
+
+        PGNO PgnoIssueEnd_() const;
+        ERR ErrIssue_( SLOT * const pslot, const PGNO pgnoEnd );
+        ERR ErrComplete_( SLOT * const pslot );
+        ERR ErrFill_();
+
+        const IFMP  m_ifmp;
+        const CPG   m_cpgReadAhead;
+        const CPG   m_cpgSlot;
+        const INT   m_cslot;
+        const BOOL  m_fExtensiveChecks;
+        SLOT *      m_rgslot;
+        INT         m_islotHead;
+        INT         m_cslotIssued;
+        CPG         m_cpgIssued;
+        PGNO        m_pgnoIssueNext;
+        PGNO        m_pgnoNext;
+};
+
+BKREADPIPELINE::BKREADPIPELINE( const IFMP ifmp, const CPG cpgReadAhead, const CPG cpgSlot, const BOOL fExtensiveChecks )
+    :   m_ifmp( ifmp ),
+        m_cpgReadAhead( cpgReadAhead ),
+        m_cpgSlot( cpgSlot ),
+        m_cslot( min( cbkreadslotMax, ( cpgReadAhead + cpgSlot - 1 ) / cpgSlot ) ),
+        m_fExtensiveChecks( fExtensiveChecks ),
+        m_rgslot( NULL ),
+        m_islotHead( 0 ),
+        m_cslotIssued( 0 ),
+        m_cpgIssued( 0 ),
+        m_pgnoIssueNext( pgnoNull ),
+        m_pgnoNext( pgnoNull )
+{
+    Assert( m_cpgReadAhead >= m_cpgSlot );
+    Assert( m_cpgSlot > 0 );
+    Assert( m_cslot > 0 );
+}
+
+BKREADPIPELINE::~BKREADPIPELINE()
+{
+    if ( m_rgslot == NULL )
+    {
+        return;
+    }
+
+    
+    for ( INT islot = 0; islot < m_cslotIssued; islot++ )
+    {
+        (VOID)ErrComplete_( &m_rgslot[ ( m_islotHead + islot ) % m_cslot ] );
+    }
+
+    for ( INT islot = 0; islot < m_cslot; islot++ )
+    {
+        OSMemoryPageFree( m_rgslot[ islot ].pb );
+    }
+    delete[] m_rgslot;
+}
+
+ERR BKREADPIPELINE::ErrInit( const PGNO pgnoFirst )
+{
+    ERR err = JET_errSuccess;
+
+    Alloc( m_rgslot = new SLOT[ m_cslot ] );
+    for ( INT islot = 0; islot < m_cslot; islot++ )
+    {
+        m_rgslot[ islot ].pb = NULL;
+        m_rgslot[ islot ].fIssued = fFalse;
+    }
+    for ( INT islot = 0; islot < m_cslot; islot++ )
+    {
+        Alloc( m_rgslot[ islot ].pb = (BYTE *)PvOSMemoryPageAlloc( m_cpgSlot * g_cbPage, NULL ) );
+    }
+
+    m_pgnoIssueNext = pgnoFirst;
+    m_pgnoNext = pgnoFirst;
+
+HandleError:
+    return err;
+}
+
+//  reads are aligned to the slot size in the file so that each one can be coalesced
+
+PGNO BKREADPIPELINE::PgnoIssueEnd_() const
+{
+    return min( PGNO( ( ( m_pgnoIssueNext + cpgDBReserved - 1 ) / m_cpgSlot + 1 ) * m_cpgSlot - cpgDBReserved ), g_rgfmp[ m_ifmp ].PgnoBackupMost() );
+}
+
+ERR BKREADPIPELINE::ErrIssue_( SLOT * const pslot, const PGNO pgnoEnd )
+{
+    ERR         err         = JET_errSuccess;
+    FMP * const pfmp        = &g_rgfmp[ m_ifmp ];
+    TraceContextScope tcBackupT( iorpBackup );
+
+    Assert( !pslot->fIssued );
+
+    pslot->pgnoStart = m_pgnoIssueNext;
+    pslot->pgnoEnd = pgnoEnd;
+    Assert( pslot->pgnoStart <= pslot->pgnoEnd );
+    Assert( pslot->pgnoEnd - pslot->pgnoStart + 1 <= (PGNO)m_cpgSlot );
+
+
+    //  the range lock is released by the read completion, so a slot waiting to be
+    //  consumed does not hold off writers to its pages
+
+    Call( pfmp->ErrRangeLock( pslot->pgnoStart, pslot->pgnoEnd ) );
+
+    pslot->fIssued = fTrue;
+    pslot->fComplete = fFalse;
+    pslot->errIssue = JET_errSuccess;
+    pslot->acRead = 0;
+    pslot->readdata.err = JET_errSuccess;
+    pslot->readdata.pacRead = &pslot->acRead;
+    pslot->readdata.pasigDone = &pslot->asigDone;
+    pslot->readdata.fCheckPagesOffset = fTrue;
+    pslot->readdata.fExtensiveChecks = m_fExtensiveChecks;
+    pslot->readdata.ifmp = m_ifmp;
+    pslot->readdata.pgnoMost = 0;
+    pslot->readdata.pgnoUnlockStart = pslot->pgnoStart;
+    pslot->readdata.pgnoUnlockEnd = pslot->pgnoEnd;
+
+    m_pgnoIssueNext = pslot->pgnoEnd + 1;
+
+
+    //  a failure to issue still completes the slot (and so releases its range lock)
+    //  through the read completion, so the slot stays issued and the failure is
+    //  returned once the caller asks for its pages, as ErrIOReadDbPages() would
+
+    pslot->errIssue = ErrIOIssueReadDbPages( m_ifmp, pfmp->Pfapi(), pslot->pb, pslot->pgnoStart, pslot->pgnoEnd, *tcBackupT, &pslot->readdata );
+
+HandleError:
+    return err;
+}
+
+ERR BKREADPIPELINE::ErrComplete_( SLOT * const pslot )
+{
+    Assert( pslot->fIssued );
+
+    if ( !pslot->fComplete )
+    {
+        if ( pslot->acRead != 0 )
+        {
+            PERFOpt( cBKReadPipelineStalls.Inc( PinstFromIfmp( m_ifmp ) ) );
+        }
+        pslot->asigDone.Wait();
+        pslot->fComplete = fTrue;
+    }
+
+    return pslot->errIssue < JET_errSuccess ? pslot->errIssue : pslot->readdata.err;
+}
+
+ERR BKREADPIPELINE::ErrFill_()
+{
+    ERR err = JET_errSuccess;
+
+    while ( m_cslotIssued < m_cslot && m_pgnoIssueNext <= g_rgfmp[ m_ifmp ].PgnoBackupMost() )
+    {
+        const PGNO  pgnoEnd = PgnoIssueEnd_();
+        const CPG   cpg     = CPG( pgnoEnd - m_pgnoIssueNext + 1 );
+
+        if ( m_cslotIssued > 0 && m_cpgIssued + cpg > m_cpgReadAhead )
+        {
+            break;
+        }
+
+        SLOT * const pslot = &m_rgslot[ ( m_islotHead + m_cslotIssued ) % m_cslot ];
+        Call( ErrIssue_( pslot, pgnoEnd ) );
+        m_cslotIssued++;
+        m_cpgIssued += cpg;
+
+        //  no point reading further ahead once a read could not be issued
+
+        if ( pslot->errIssue < JET_errSuccess )
+        {
+            break;
+        }
+    }
+
+HandleError:
+    return err;
+}
+
+//  Read-ahead is only issued from here, while a caller is asking for pages. Slots issued
+//  past pgnoEnd, up to the read-ahead size, are still in flight when this returns. Each
+//  one releases its range lock from its read completion, so between backup reads only
+//  the reads that have not completed yet hold off writers to their pages.
+
+ERR BKREADPIPELINE::ErrReadPages( const PGNO pgnoStart, const PGNO pgnoEnd, BYTE * const pbData )
+{
+    ERR     err     = JET_errSuccess;
+    PGNO    pgno    = pgnoStart;
+
+    Assert( pgnoStart == m_pgnoNext );
+    Assert( pgnoEnd <= g_rgfmp[ m_ifmp ].PgnoBackupMost() );
+
+    while ( pgno <= pgnoEnd )
+    {
+        Call( ErrFill_() );
+
+        SLOT * const pslot = &m_rgslot[ m_islotHead ];
+        Assert( m_cslotIssued > 0 );
+        Assert( pgno >= pslot->pgnoStart && pgno <= pslot->pgnoEnd );
+
+        Call( ErrComplete_( pslot ) );
+
+        const PGNO pgnoCopyEnd = min( pgnoEnd, pslot->pgnoEnd );
+        UtilMemCpy( pbData + ( pgno - pgnoStart ) * g_cbPage, pslot->pb + ( pgno - pslot->pgnoStart ) * g_cbPage, ( pgnoCopyEnd - pgno + 1 ) * g_cbPage );
+        pgno = pgnoCopyEnd + 1;
+
+        if ( pgno > pslot->pgnoEnd )
+        {
+            pslot->fIssued = fFalse;
+            m_islotHead = ( m_islotHead + 1 ) % m_cslot;
+            m_cslotIssued--;
+            m_cpgIssued -= CPG( pslot->pgnoEnd - pslot->pgnoStart + 1 );
+        }
+    }
+
+    m_pgnoNext = pgno;
+
+HandleError:
+    return err;
+}
+
+ERR BACKUP_CONTEXT::ErrBKIPipelineReadPages( const IFMP ifmp, const PGNO pgnoStart, const PGNO pgnoEnd, BYTE * const pbData, const BOOL fExtensiveChecks )
+{
+    ERR err = JET_errSuccess;
+
+    if ( m_pbkreadpipeline != NULL &&
+        ( m_pbkreadpipeline->Ifmp() != ifmp || m_pbkreadpipeline->PgnoNext() != pgnoStart ) )
+    {
+        BKIPipelineTerm();
+    }
+
+    if ( m_pbkreadpipeline == NULL )
+    {
+        Alloc( m_pbkreadpipeline = new BKREADPIPELINE( ifmp, m_cpgbkreadahead, m_cpgbkreadslot, fExtensiveChecks ) );
+        Call( m_pbkreadpipeline->ErrInit( pgnoStart ) );
+    }
+
+    Call( m_pbkreadpipeline->ErrReadPages( pgnoStart, pgnoEnd, pbData ) );
+
+HandleError:
+    return err;
+}
+
+VOID BACKUP_CONTEXT::BKIPipelineTerm()
+{
+    delete m_pbkreadpipeline;
+    m_pbkreadpipeline = NULL;
+}
+
+
 #define DISABLE_EXTENSIVE_CHECKS_DURING_STREAMING_BACKUP 1
 
 ERR BACKUP_CONTEXT::ErrBKIReadPages(
@@ -197,6 +528,12 @@ ERR BACKUP_CONTEXT::ErrBKIReadPages(
 
 #endif
 
+    if ( pfmp->PgnoBackupCopyMost() == 0 )
+    {
+        BKIPipelineTerm();
+        BKIGetReadPipelineConfig( &m_cpgbkreadahead, &m_cpgbkreadslot );
+    }
+
     Assert( cpage > 0 );
 
     
@@ -234,18 +571,7 @@ ERR BACKUP_CONTEXT::ErrBKIReadPages(
 
     const PGNO  pgnoStart   = pfmp->PgnoBackupCopyMost() + 1;
     const PGNO  pgnoEnd     = pfmp->PgnoBackupCopyMost() + ( cpageT - ipageT );
-
-    if ( pgnoStart <= pgnoEnd  )
-    {
-        CallR( pfmp->ErrRangeLock( pgnoStart, pgnoEnd ) );
-
-        pfmp->SetPgnoBackupCopyMost( pgnoEnd );
-    }
-    else
-    {
-        Assert( fRoomForFinalHeaderPage );
-    }
-
+    const BOOL  fExtensiveChecks    = !!( UlParam( m_pinst, JET_paramDisableVerifications ) & DISABLE_EXTENSIVE_CHECKS_DURING_STREAMING_BACKUP );
 
     const TICK  tickStart   = TickOSTimeCurrent();
     const TICK  tickBackoff = 100;
@@ -259,11 +585,31 @@ ERR BACKUP_CONTEXT::ErrBKIReadPages(
         goto CopyFinalHeaderPage;
     }
 
+    
+    if ( !fScrub && m_cpgbkreadahead > 0 )
+    {
+        err = ErrBKIPipelineReadPages( ifmp, pgnoStart, pgnoEnd, (BYTE *)pvPageMin + ipageT * g_cbPage, fExtensiveChecks );
+        if ( err >= JET_errSuccess )
+        {
+            pfmp->SetPgnoBackupCopyMost( pgnoEnd );
+            *pcbActual += g_cbPage * ( cpageT - ipageT );
+            goto CopyFinalHeaderPage;
+        }
+
+        
+        BKIPipelineTerm();
+        err = JET_errSuccess;
+    }
+
+    CallR( pfmp->ErrRangeLock( pgnoStart, pgnoEnd ) );
+
+    pfmp->SetPgnoBackupCopyMost( pgnoEnd );
+
     do
     {
         TraceContextScope tcBackupT( iorpBackup );
 
-        err = ErrIOReadDbPages( ifmp, pfmp->Pfapi(), (BYTE *) pvPageMin + ipageT * g_cbPage, pgnoStart, pgnoEnd, fTrue, 0, *tcBackupT, !!( UlParam( m_pinst, JET_paramDisableVerifications ) & DISABLE_EXTENSIVE_CHECKS_DURING_STREAMING_BACKUP ) );
+        err = ErrIOReadDbPages( ifmp, pfmp->Pfapi(), (BYTE *) pvPageMin + ipageT * g_cbPage, pgnoStart, pgnoEnd, fTrue, 0, *tcBackupT, fExtensiveChecks );
 
         if ( err < JET_errSuccess )
         {
@@ -448,6 +794,10 @@ HandleError:
     {
         *pcbActual = 0;
     }
+    else
+    {
+        PERFOpt( cBKReadBytes.Add( m_pinst, *pcbActual ) );
+    }
 
 #ifdef MINIMAL_FUNCTIONALITY
 #else
@@ -2678,6 +3028,8 @@ ERR BACKUP_CONTEXT::ErrBKCloseFile( JET_HANDLE hfFile )
         }
 #endif
 
+        BKIPipelineTerm();
+
         CallS( ErrDBCloseDatabase( m_ppibBackup, ifmpT, 0 ) );
     }
     else
@@ -3672,6 +4024,8 @@ ERR BACKUP_CONTEXT::ErrBKExternalBackupCleanUp( ERR error, const JET_GRBIT grbit
     }
 
 
+    BKIPipelineTerm();
+
     
     for ( INT irhf = 0; irhf < crhfMax; ++irhf )
     {
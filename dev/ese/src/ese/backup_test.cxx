@@ -0,0 +1,155 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "std.hxx"
+
+#ifndef ENABLE_JET_UNIT_TEST
+#error This file should only be compiled with the unit tests!
+#endif
+
+//  streams the attached database through JetReadFile() into a buffer that the caller frees
+//  with OSMemoryPageFree(). the read size is deliberately not a multiple of the pipeline slot
+//  size so that reads straddle slots.
+
+LOCAL ERR ErrBackupTestReadDatabase(
+    const JET_INSTANCE  inst,
+    const CPG           cpgRead,
+    BYTE ** const       ppbBackup,
+    ULONG * const       pcbBackup )
+{
+    ERR         err                 = JET_errSuccess;
+    WCHAR       wszzDatabases[ 256 ];
+    ULONG       cbDatabases         = 0;
+    JET_HANDLE  hf                  = 0;
+    ULONG       cbFileLow           = 0;
+    ULONG       cbFileHigh          = 0;
+    BYTE *      pbRead              = NULL;
+    const ULONG cbRead              = cpgRead * g_cbPage;
+    ULONG       cbBackupMax         = 0;
+    ULONG       cbActual            = 0;
+    BOOL        fBackup             = fFalse;
+    BOOL        fOpen               = fFalse;
+
+    *ppbBackup = NULL;
+    *pcbBackup = 0;
+
+    Alloc( pbRead = (BYTE *)PvOSMemoryPageAlloc( cbRead, NULL ) );
+
+    Call( JetBeginExternalBackupInstance( inst, NO_GRBIT ) );
+    fBackup = fTrue;
+
+    Call( JetGetAttachInfoInstanceW( inst, wszzDatabases, sizeof( wszzDatabases ), &cbDatabases ) );
+    Call( JetOpenFileInstanceW( inst, wszzDatabases, &hf, &cbFileLow, &cbFileHigh ) );
+    fOpen = fTrue;
+
+    if ( cbFileHigh != 0 )
+    {
+        Error( ErrERRCheck( JET_errOutOfMemory ) );
+    }
+
+    //  the stream carries a final copy of the header page after the database pages
+
+    cbBackupMax = cbFileLow + g_cbPage;
+    Alloc( *ppbBackup = (BYTE *)PvOSMemoryPageAlloc( cbBackupMax, NULL ) );
+
+    do
+    {
+        Call( JetReadFileInstance( inst, hf, pbRead, cbRead, &cbActual ) );
+        if ( *pcbBackup + cbActual > cbBackupMax )
+        {
+            Error( ErrERRCheck( JET_errBufferTooSmall ) );
+        }
+        UtilMemCpy( *ppbBackup + *pcbBackup, pbRead, cbActual );
+        *pcbBackup += cbActual;
+    }
+    while ( cbActual > 0 );
+
+HandleError:
+    if ( fOpen )
+    {
+        (void)JetCloseFileInstance( inst, hf );
+    }
+    if ( fBackup )
+    {
+        (void)JetEndExternalBackupInstance2( inst, JET_bitBackupEndAbort );
+    }
+    if ( err < JET_errSuccess )
+    {
+        OSMemoryPageFree( *ppbBackup );
+        *ppbBackup = NULL;
+        *pcbBackup = 0;
+    }
+    OSMemoryPageFree( pbRead );
+    return err;
+}
+
+//  the pipelined path must deliver exactly the pages the synchronous path does
+
+JETUNITTEST( BKREADPIPELINE, ReadFileMatchesSynchronousRead )
+{
+    const LONG          crec            = 4000;
+    const ULONG         cbData          = 1000;
+    JetTestDatabase     db;
+    JET_TABLEID         tableid         = JET_tableidNil;
+    JET_COLUMNID        columnidKey;
+    JET_COLUMNID        columnidData;
+    JET_COLUMNDEF       columndef       = { sizeof( JET_COLUMNDEF ), 0, JET_coltypLong, 0, 0, 0, 0, 0, JET_bitColumnFixed };
+    BYTE                rgbData[ cbData ];
+    BYTE *              pbSync          = NULL;
+    BYTE *              pbPipeline      = NULL;
+    ULONG               cbSync          = 0;
+    ULONG               cbPipeline      = 0;
+
+    CHECKCALLS( db.ErrInit( L"BackupReadAhead", JetTestDatabase::bitRecovery ) );
+    CHECKCALLS( JetCreateTableA( db.Sesid(), db.Dbid(), "ReadAhead", 16, 100, &tableid ) );
+    CHECKCALLS( JetAddColumnA( db.Sesid(), tableid, "Key", &columndef, NULL, 0, &columnidKey ) );
+    columndef.coltyp = JET_coltypLongBinary;
+    columndef.grbit = NO_GRBIT;
+    CHECKCALLS( JetAddColumnA( db.Sesid(), tableid, "Data", &columndef, NULL, 0, &columnidData ) );
+    CHECKCALLS( JetCreateIndexA( db.Sesid(), tableid, "Primary", JET_bitIndexPrimary, "+Key\0", 6, 100 ) );
+
+    CHECKCALLS( JetBeginTransaction( db.Sesid() ) );
+    for ( LONG irec = 0; irec < crec; irec++ )
+    {
+        memset( rgbData, (BYTE)irec, sizeof( rgbData ) );
+        CHECKCALLS( JetPrepareUpdate( db.Sesid(), tableid, JET_prepInsert ) );
+        CHECKCALLS( JetSetColumn( db.Sesid(), tableid, columnidKey, &irec, sizeof( irec ), NO_GRBIT, NULL ) );
+        CHECKCALLS( JetSetColumn( db.Sesid(), tableid, columnidData, rgbData, sizeof( rgbData ), NO_GRBIT, NULL ) );
+        CHECKCALLS( JetUpdate( db.Sesid(), tableid, NULL, 0, NULL ) );
+    }
+    CHECKCALLS( JetCommitTransaction( db.Sesid(), NO_GRBIT ) );
+    CHECKCALLS( JetCloseTable( db.Sesid(), tableid ) );
+    CHECKCALLS( db.ErrTerm() );
+
+    //  reattach cleanly so nothing is flushed to the file between the two backups
+
+    CHECKCALLS( db.ErrInit( L"BackupReadAhead", JetTestDatabase::bitRecovery | JetTestDatabase::bitAttachExisting ) );
+
+    CHECKCALLS( ErrEnableTestInjection( 47260, 0, JET_TestInjectConfigOverride, 100, JET_bitInjectionProbabilityPct ) );
+    const ERR errSync = ErrBackupTestReadDatabase( db.Inst(), 12, &pbSync, &cbSync );
+
+    //  1 MB of read-ahead in 64 KB slots keeps 16 reads in flight over a ~5 MB file
+
+    CHECKCALLS( ErrEnableTestInjection( 47260, 1024 * 1024, JET_TestInjectConfigOverride, 100, JET_bitInjectionProbabilityPct ) );
+    CHECKCALLS( ErrEnableTestInjection( 47276, 64 * 1024, JET_TestInjectConfigOverride, 100, JET_bitInjectionProbabilityPct ) );
+    const ERR errPipeline = ErrBackupTestReadDatabase( db.Inst(), 12, &pbPipeline, &cbPipeline );
+
+    CHECKCALLS( ErrEnableTestInjection( 47260, 0, JET_TestInjectConfigOverride, 0, JET_bitInjectionProbabilityPct ) );
+    CHECKCALLS( ErrEnableTestInjection( 47276, 0, JET_TestInjectConfigOverride, 0, JET_bitInjectionProbabilityPct ) );
+
+    CHECKCALLS( errSync );
+    CHECKCALLS( errPipeline );
+
+    //  the header pages at either end of the stream carry backup state, so only the
+    //  database pages between them are compared
+
+    CHECK( cbSync == cbPipeline );
+    CHECK( cbSync > ( cpgDBReserved + 1 ) * (ULONG)g_cbPage + 1024 * 1024 );
+    CHECK( 0 == memcmp( pbSync + cpgDBReserved * g_cbPage,
+                        pbPipeline + cpgDBReserved * g_cbPage,
+                        cbSync - ( cpgDBReserved + 1 ) * g_cbPage ) );
+
+    OSMemoryPageFree( pbSync );
+    OSMemoryPageFree( pbPipeline );
+    CHECKCALLS( db.ErrTerm() );
+}
@@ -2079,6 +2079,7 @@ void BFDirty( const BFLatch* pbfl, BFDirtyFlags bfdf, const TraceContext& tc )
         PagePatching::CancelPatchRequest( pbf->ifmp, pbf->pgno );
     }
 
+    NDInvalidateSearchHint( pbf->ifmp, pbf->pgno );
 
     BFIDirtyPage( pbf, bfdf, tc );
 }
@@ -5441,6 +5442,7 @@ BFCacheStatsChanges g_statsBFCacheResidency;
 LONG_PTR        g_cpgChunk;
 void**          g_rgpvChunk;
 ICBPage         g_icbCacheMax;
+BOOL            g_fBFIORegisteredChunks;
 
 
 
@@ -5449,6 +5451,207 @@ LONG_PTR        g_cbfChunk;
 BF**            g_rgpbfChunk;
 
 
+const size_t    cbBFNumaStripe              = 2 * 1024 * 1024;
+
+BOOL            g_fBFNumaAware;
+DWORD           g_cBFNumaNode               = 1;
+LONG_PTR        g_cpgBFNumaStripe;
+DWORD           g_rgiNodeBFNuma[ cOSMemoryNumaNodeMax ];
+BYTE*           g_rgiBFNumaNodeProc;
+INT*            g_rgiprocBFNumaNode;
+INT             g_rgiiprocBFNumaNodeMic[ cOSMemoryNumaNodeMax + 1 ];
+LONG            g_rgcbfAvailNuma[ cOSMemoryNumaNodeMax ];
+LONG            g_cBFNumaAllocLocal;
+LONG            g_cBFNumaAllocRemote;
+
+ERR ErrBFICacheINumaInit()
+{
+    ERR err = JET_errSuccess;
+
+    g_fBFNumaAware          = fFalse;
+    g_cBFNumaNode           = 1;
+    g_cpgBFNumaStripe       = 0;
+    g_rgiBFNumaNodeProc     = NULL;
+    g_rgiprocBFNumaNode     = NULL;
+    g_cBFNumaAllocLocal     = 0;
+    g_cBFNumaAllocRemote    = 0;
+    memset( g_rgiNodeBFNuma, 0, sizeof( g_rgiNodeBFNuma ) );
+    memset( g_rgiiprocBFNumaNodeMic, 0, sizeof( g_rgiiprocBFNumaNodeMic ) );
+    memset( g_rgcbfAvailNuma, 0, sizeof( g_rgcbfAvailNuma ) );
+
+    WCHAR   wszBuf[ 16 ]        = { 0 };
+    BOOL    fEnableNumaAware    = fFalse;
+    if (    FOSConfigGet( L"BF", L"NUMA Aware Cache", wszBuf, sizeof( wszBuf ) ) &&
+            wszBuf[ 0 ] )
+    {
+        fEnableNumaAware = !!_wtol( wszBuf );
+    }
+
+    if ( !fEnableNumaAware || BoolParam( JET_paramEnableViewCache ) || OSMemoryNumaNodeCount() < 2 )
+    {
+        return JET_errSuccess;
+    }
+
+
+    const INT cproc = OSSyncGetProcessorCountMax();
+    DWORD rgiNodeBFNumaOS[ cOSMemoryNumaNodeMax ];
+    INT rgcprocNodeOS[ cOSMemoryNumaNodeMax ] = { 0 };
+
+    Alloc( g_rgiBFNumaNodeProc = new BYTE[ cproc ] );
+    Alloc( g_rgiprocBFNumaNode = new INT[ cproc ] );
+
+    for ( INT iproc = 0; iproc < cproc; iproc++ )
+    {
+        rgcprocNodeOS[ OSMemoryNumaNodeProcessor( iproc ) ]++;
+    }
+
+    DWORD cNode = 0;
+    for ( DWORD iNodeOS = 0; iNodeOS < OSMemoryNumaNodeCount(); iNodeOS++ )
+    {
+        rgiNodeBFNumaOS[ iNodeOS ] = cNode;
+        if ( rgcprocNodeOS[ iNodeOS ] )
+        {
+            g_rgiNodeBFNuma[ cNode ] = iNodeOS;
+            g_rgiiprocBFNumaNodeMic[ cNode + 1 ] = g_rgiiprocBFNumaNodeMic[ cNode ] + rgcprocNodeOS[ iNodeOS ];
+            cNode++;
+        }
+    }
+
+    if ( cNode < 2 )
+    {
+        BFICacheINumaTerm();
+        return JET_errSuccess;
+    }
+
+    INT rgiiprocNode[ cOSMemoryNumaNodeMax ];
+    memcpy( rgiiprocNode, g_rgiiprocBFNumaNodeMic, sizeof( rgiiprocNode ) );
+    for ( INT iproc = 0; iproc < cproc; iproc++ )
+    {
+        const DWORD iNode = rgiNodeBFNumaOS[ OSMemoryNumaNodeProcessor( iproc ) ];
+        g_rgiBFNumaNodeProc[ iproc ] = (BYTE)iNode;
+        g_rgiprocBFNumaNode[ rgiiprocNode[ iNode ]++ ] = iproc;
+    }
+
+    g_cBFNumaNode       = cNode;
+    g_cpgBFNumaStripe   = max( 1, (LONG_PTR)( cbBFNumaStripe / g_rgcbPageSize[ g_icbCacheMax ] ) );
+    g_fBFNumaAware      = fTrue;
+
+HandleError:
+    if ( err < JET_errSuccess )
+    {
+        BFICacheINumaTerm();
+    }
+    return err;
+}
+
+void BFICacheINumaTerm()
+{
+    if ( g_fBFNumaAware )
+    {
+        OSTrace( JET_tracetagBufferManager, OSFormat( "BF: NUMA aware cache allocated %d local and %d remote buffers across %d nodes\n",
+                    g_cBFNumaAllocLocal, g_cBFNumaAllocRemote, g_cBFNumaNode ) );
+    }
+
+    g_fBFNumaAware  = fFalse;
+    g_cBFNumaNode   = 1;
+
+    delete [] g_rgiprocBFNumaNode;
+    g_rgiprocBFNumaNode = NULL;
+
+    delete [] g_rgiBFNumaNodeProc;
+    g_rgiBFNumaNodeProc = NULL;
+}
+
+INLINE DWORD IBFICacheINumaNodeIpg( const IPG ipg )
+{
+    return g_fBFNumaAware ? (DWORD)( ( ipg / g_cpgBFNumaStripe ) % g_cBFNumaNode ) : 0;
+}
+
+INLINE DWORD IBFICacheINumaNodeCurrent()
+{
+    return g_fBFNumaAware ? g_rgiBFNumaNodeProc[ OSSyncGetCurrentProcessor() ] : 0;
+}
+
+BOOL FBFICacheICommit( const LONG_PTR ipgChunk, void* const pvStart, const size_t cb )
+{
+    if ( !g_fBFNumaAware )
+    {
+        return FOSMemoryPageCommit( pvStart, cb );
+    }
+
+    const size_t cbPage = g_rgcbPageSize[ g_icbCacheMax ];
+    const IPG ipgMin = ipgChunk * g_cpgChunk + ( (BYTE*)pvStart - (BYTE*)g_rgpvChunk[ ipgChunk ] ) / cbPage;
+    const IPG ipgMax = ipgMin + cb / cbPage;
+
+    for ( IPG ipg = ipgMin; ipg < ipgMax; )
+    {
+        const IPG ipgStripeMax = min( ipgMax, ( ipg / g_cpgBFNumaStripe + 1 ) * g_cpgBFNumaStripe );
+        const DWORD iNode = g_rgiNodeBFNuma[ IBFICacheINumaNodeIpg( ipg ) ];
+
+        if ( !FOSMemoryPageCommitNuma( (BYTE*)pvStart + ( ipg - ipgMin ) * cbPage, ( ipgStripeMax - ipg ) * cbPage, iNode ) )
+        {
+            return fFalse;
+        }
+
+        ipg = ipgStripeMax;
+    }
+
+    return fTrue;
+}
+
+INLINE void BFIAvailInsert( const PBF pbf, const BOOL fMRU )
+{
+    if ( !g_fBFNumaAware )
+    {
+        g_bfavail.Insert( pbf, fMRU );
+        return;
+    }
+
+    //  the avail pool has one bucket per processor index so placing the BF in the
+    //  bucket of a processor on its home node keeps it on that node's free list
+
+    const INT iproc = OSSyncGetCurrentProcessor();
+    const INT iiprocMic = g_rgiiprocBFNumaNodeMic[ pbf->iNumaNode ];
+    const INT ciproc = g_rgiiprocBFNumaNodeMic[ pbf->iNumaNode + 1 ] - iiprocMic;
+
+    AtomicIncrement( &g_rgcbfAvailNuma[ pbf->iNumaNode ] );
+    g_bfavail.Insert( pbf,
+                      fMRU,
+                      g_rgiBFNumaNodeProc[ iproc ] == pbf->iNumaNode ? iproc : g_rgiprocBFNumaNode[ iiprocMic + iproc % ciproc ] );
+}
+
+INLINE BFAvail::ERR ErrBFIAvailRemove( PBF* const ppbf, const INT cmsecTimeout, const BOOL fMRU )
+{
+    if ( !g_fBFNumaAware )
+    {
+        return g_bfavail.ErrRemove( ppbf, cmsecTimeout, fMRU );
+    }
+
+    //  drain the buckets of our own node before falling back to the rest of the
+    //  pool.  the node is sampled once so a BF only counts as remote when the
+    //  node local pass really came up empty, not because we migrated afterwards
+
+    const DWORD iNode = IBFICacheINumaNodeCurrent();
+    const INT iiprocMic = g_rgiiprocBFNumaNodeMic[ iNode ];
+    const INT ciproc = g_rgiiprocBFNumaNodeMic[ iNode + 1 ] - iiprocMic;
+
+    const BFAvail::ERR errAvail = g_bfavail.ErrRemove( ppbf, cmsecTimeout, fMRU, g_rgiprocBFNumaNode + iiprocMic, ciproc );
+
+    if ( errAvail == BFAvail::ERR::errSuccess )
+    {
+        AtomicDecrement( &g_rgcbfAvailNuma[ (*ppbf)->iNumaNode ] );
+        AtomicIncrement( (*ppbf)->iNumaNode == iNode ? &g_cBFNumaAllocLocal : &g_cBFNumaAllocRemote );
+    }
+
+    return errAvail;
+}
+
+INLINE BOOL FBFIAvailPoolLowNuma()
+{
+    return g_fBFNumaAware && g_rgcbfAvailNuma[ IBFICacheINumaNodeCurrent() ] <= cbfAvailPoolLow / (LONG_PTR)g_cBFNumaNode;
+}
+
+
 
 ERR ErrBFICacheInit( __in const LONG cbPageSizeMax )
 {
@@ -5485,6 +5688,11 @@ ERR ErrBFICacheInit( __in const LONG cbPageSizeMax )
     g_cpgChunk            = 0;
     g_rgpvChunk           = NULL;
 
+    //  registered buffers must stay committed, so this is decided once for the life of the
+    //  cache rather than per chunk
+
+    g_fBFIORegisteredChunks = FOSDiskRegistersIOBuffers();
+
     cbfInit             = 0;
     g_cbfChunk            = 0;
     g_rgpbfChunk          = NULL;
@@ -5536,6 +5744,7 @@ ERR ErrBFICacheInit( __in const LONG cbPageSizeMax )
     RFSSuppressFaultInjection( 44808 );
     RFSSuppressFaultInjection( 61192 );
 
+    Call( ErrBFICacheINumaInit() );
     Call( ErrBFICacheGrow() );
 
     RFSUnsuppressFaultInjection( 33032 );
@@ -5616,6 +5825,8 @@ void BFICacheTerm()
         delete [] g_rgpvChunk;
         g_rgpvChunk = NULL;
     }
+
+    BFICacheINumaTerm();
 }
 
 INLINE INT CbBFISize( ICBPage icb )
@@ -6910,6 +7121,14 @@ BOOL FBFIValidPvAllocType( const BF * const pbf )
     }                                                   \
 }
 
+void BFICacheIRegisterIOBuffer( void* const pvStart, const size_t cb )
+{
+    if ( g_fBFIORegisteredChunks )
+    {
+        (void)FOSDiskRegisterIOBuffer( pvStart, cb );
+    }
+}
+
 ERR ErrBFICacheISetDataSize( const LONG_PTR cpgCacheStart, const LONG_PTR cpgCacheNew )
 {
     ERR err = JET_errSuccess;
@@ -6940,10 +7159,11 @@ ERR ErrBFICacheISetDataSize( const LONG_PTR cpgCacheStart, const LONG_PTR cpgCac
             const size_t cb = ( ( ipgChunkStart + 1 ) * g_cpgChunk - cpgCacheStart ) * g_rgcbPageSize[g_icbCacheMax];
             void* const pvStart = (BYTE*)g_rgpvChunk[ ipgChunkStart ] + ib;
 
-            if ( !FOpFI( 33032 ) || !FOSMemoryPageCommit( pvStart, cb ) )
+            if ( !FOpFI( 33032 ) || !FBFICacheICommit( ipgChunkStart, pvStart, cb ) )
             {
                 Call( ErrERRCheck( JET_errOutOfMemory ) );
             }
+            BFICacheIRegisterIOBuffer( pvStart, cb );
         }
 
 
@@ -6963,10 +7183,11 @@ ERR ErrBFICacheISetDataSize( const LONG_PTR cpgCacheStart, const LONG_PTR cpgCac
             const size_t cb = min( g_cpgChunk, cpgCacheNew - ipgChunkAlloc * g_cpgChunk ) * g_rgcbPageSize[g_icbCacheMax];
             void* const pvStart = (BYTE*)g_rgpvChunk[ ipgChunkAlloc ] + ib;
 
-            if ( !FOpFI( 48904 ) || !FOSMemoryPageCommit( pvStart, cb ) )
+            if ( !FOpFI( 48904 ) || !FBFICacheICommit( ipgChunkAlloc, pvStart, cb ) )
             {
                 Call( ErrERRCheck( JET_errOutOfMemory ) );
             }
+            BFICacheIRegisterIOBuffer( pvStart, cb );
         }
     }
 
@@ -6980,6 +7201,7 @@ ERR ErrBFICacheISetDataSize( const LONG_PTR cpgCacheStart, const LONG_PTR cpgCac
 
             g_rgpvChunk[ ipgChunkFree ] = NULL;
             const size_t cbChunkFree = g_cpgChunk * g_rgcbPageSize[g_icbCacheMax];
+            OSDiskUnregisterIOBuffer( pvChunkFree, cbChunkFree );
             OSMemoryPageDecommit( pvChunkFree, cbChunkFree );
             OSMemoryPageFree( pvChunkFree );
 
@@ -7017,10 +7239,11 @@ ERR ErrBFICacheISetDataSize( const LONG_PTR cpgCacheStart, const LONG_PTR cpgCac
             const size_t cb = ( cpgCacheNew - cpgCacheStart ) * g_rgcbPageSize[g_icbCacheMax];
             void* const pvStart = (BYTE*)g_rgpvChunk[ ipgChunkStart ] + ib;
 
-            if ( !FOpFI( 65288 ) || !FOSMemoryPageCommit( pvStart, cb ) )
+            if ( !FOpFI( 65288 ) || !FBFICacheICommit( ipgChunkStart, pvStart, cb ) )
             {
                 Call( ErrERRCheck( JET_errOutOfMemory ) );
             }
+            BFICacheIRegisterIOBuffer( pvStart, cb );
         }
 
 
@@ -7256,6 +7479,7 @@ ERR ErrBFICacheISetSize( const LONG_PTR cbfCacheAddressableNew )
 
 
             pbf->pv = PvBFICacheIpg( ibfInit );
+            pbf->iNumaNode = (BYTE)IBFICacheINumaNodeIpg( ibfInit );
 
 
             pbf->fNewlyEvicted = fFalse;
@@ -7310,8 +7534,9 @@ ERR ErrBFICacheISetSize( const LONG_PTR cbfCacheAddressableNew )
 
             if ( pbf->bfat == bfatFracCommit )
             {
-                OnDebug( const LONG_PTR cbCacheCommittedSizeInitial = (LONG_PTR)) AtomicExchangeAddPointer( (void**)&g_cbCacheCommittedSize, (void*)( -( (LONG_PTR)g_rgcbPageSize[pbf->icbBuffer] ) ) );
-                Assert( cbCacheCommittedSizeInitial >= g_rgcbPageSize[pbf->icbBuffer] );
+                const ICBPage icbCommitted = g_fBFIORegisteredChunks ? g_icbCacheMax : (ICBPage)pbf->icbBuffer;
+                OnDebug( const LONG_PTR cbCacheCommittedSizeInitial = (LONG_PTR)) AtomicExchangeAddPointer( (void**)&g_cbCacheCommittedSize, (void*)( -( (LONG_PTR)g_rgcbPageSize[icbCommitted] ) ) );
+                Assert( cbCacheCommittedSizeInitial >= g_rgcbPageSize[icbCommitted] );
             }
 
             pbf->fNewlyEvicted = fFalse;
@@ -8244,7 +8469,7 @@ ERR ErrBFIMaintAvailPoolRequest( const BFIMaintAvailPoolRequestType bfmaprt )
     }
 
     const BOOL fSmallPool = ( ( cbfAvailPoolHigh - cbfAvailPoolLow ) < 10 ) || ( cbfAvailPoolLow < 5 );
-    const BOOL fLowPool = ( cbfAvail <= (DWORD)cbfAvailPoolLow );
+    const BOOL fLowPool = ( cbfAvail <= (DWORD)cbfAvailPoolLow ) || FBFIAvailPoolLowNuma();
 
     if ( fForceSync || ( fAllowSync && fSmallPool && fLowPool ) )
     {
@@ -8776,6 +9001,10 @@ ERR ErrBFIMaintScavengeIScavengePages( const char* const szContextTraceOnly, con
                 Assert( !pbf->fInOB0OL && pbf->ob0ic.FUninitialized() );
                 if ( g_bfavail.ErrRemoveCurrentObject( &lockAvail ) == BFAvail::ERR::errSuccess )
                 {
+                    if ( g_fBFNumaAware )
+                    {
+                        AtomicDecrement( &g_rgcbfAvailNuma[ pbf->iNumaNode ] );
+                    }
                     pbf->sxwl.ClaimOwnership( bfltWrite );
                     BFIReleaseBuffer( pbf );
                     statsCurrRun.cbfShrinkFromAvailPool++;
@@ -9434,13 +9663,22 @@ ERR ErrBFIMaintScavengePreInit(
 {
     Expected( K == 1 || K == 2 );
 
+    WCHAR   wszBuf[ 16 ]    = { 0 };
+    INT     cShard          = 1;
+    if (    FOSConfigGet( L"BF", L"LRUK Shards", wszBuf, sizeof( wszBuf ) ) &&
+            wszBuf[ 0 ] )
+    {
+        cShard = max( 1, min( cBFLRUKShardMax, (INT)_wtol( wszBuf ) ) );
+    }
+
     switch ( g_bflruk.ErrInit(    K,
                                 csecCorrelatedTouch,
                                 csecTimeout,
                                 csecUncertainty,
                                 dblHashLoadFactor,
                                 dblHashUniformity,
-                                dblSpeedSizeTradeoff ) )
+                                dblSpeedSizeTradeoff,
+                                cShard ) )
     {
         default:
             AssertSz( fFalse, "Unexpected error initializing BF LRUK Manager" );
@@ -13064,10 +13302,16 @@ ERR ErrBFISetBufferSize( __inout PBF pbf, __in const ICBPage icbNewSize, __in co
             Assert( 0 == ( ( (INT)cbBufferOld - (INT)cbBufferNew ) % OSMemoryPageCommitGranularity() ) );
 
 
-            OSMemoryPageDecommit( ((BYTE*)((pbf)->pv))+cbBufferNew, cbBufferOld - cbBufferNew );
+            //  registered buffers keep their whole commit (and it stays counted) until the chunk
+            //  is freed
+
+            if ( !g_fBFIORegisteredChunks )
+            {
+                OSMemoryPageDecommit( ((BYTE*)((pbf)->pv))+cbBufferNew, cbBufferOld - cbBufferNew );
 
-            OnDebug( const LONG_PTR cbCacheCommittedSizeInitial = (LONG_PTR)) AtomicExchangeAddPointer( (void**)&g_cbCacheCommittedSize, (void*)( -( (LONG_PTR)( cbBufferOld - cbBufferNew ) ) ) );
-            Assert( cbCacheCommittedSizeInitial >= (LONG_PTR)( cbBufferOld - cbBufferNew ) );
+                OnDebug( const LONG_PTR cbCacheCommittedSizeInitial = (LONG_PTR)) AtomicExchangeAddPointer( (void**)&g_cbCacheCommittedSize, (void*)( -( (LONG_PTR)( cbBufferOld - cbBufferNew ) ) ) );
+                Assert( cbCacheCommittedSizeInitial >= (LONG_PTR)( cbBufferOld - cbBufferNew ) );
+            }
 
 
             if ( !pbf->fAvailable && !pbf->fQuiesced )
@@ -13088,23 +13332,30 @@ ERR ErrBFISetBufferSize( __inout PBF pbf, __in const ICBPage icbNewSize, __in co
     else if ( cbBufferNew > cbBufferOld )
     {
 
-        const BOOL fCleanUpStateSaved = FOSSetCleanupState( fFalse );
-        if ( fWait )
+        //  a registered buffer was never decommitted when it shrank, so there is nothing to
+        //  commit or count here
+
+        if ( !g_fBFIORegisteredChunks )
         {
-            const LONG cRFSCountdownOld = RFSThreadDisable( 10 );
-            while( !FOSMemoryPageCommit( ((BYTE*)((pbf)->pv))+cbBufferOld, cbBufferNew - cbBufferOld ) )
+            const DWORD iNodeCommit = g_fBFNumaAware ? g_rgiNodeBFNuma[ pbf->iNumaNode ] : iOSMemoryNumaNodeNil;
+            const BOOL fCleanUpStateSaved = FOSSetCleanupState( fFalse );
+            if ( fWait )
             {
+                const LONG cRFSCountdownOld = RFSThreadDisable( 10 );
+                while( !FOSMemoryPageCommitNuma( ((BYTE*)((pbf)->pv))+cbBufferOld, cbBufferNew - cbBufferOld, iNodeCommit ) )
+                {
+                }
+                RFSThreadReEnable( cRFSCountdownOld );
             }
-            RFSThreadReEnable( cRFSCountdownOld );
-        }
-        else if ( !FOSMemoryPageCommit( ((BYTE*)((pbf)->pv))+cbBufferOld, cbBufferNew - cbBufferOld ) )
-        {
-            Error( ErrERRCheck( JET_errOutOfMemory ) );
-        }
-        FOSSetCleanupState( fCleanUpStateSaved );
+            else if ( !FOSMemoryPageCommitNuma( ((BYTE*)((pbf)->pv))+cbBufferOld, cbBufferNew - cbBufferOld, iNodeCommit ) )
+            {
+                Error( ErrERRCheck( JET_errOutOfMemory ) );
+            }
+            FOSSetCleanupState( fCleanUpStateSaved );
 
-        OnDebug( const LONG_PTR cbCacheCommittedSizeInitial = (LONG_PTR)) AtomicExchangeAddPointer( (void**)&g_cbCacheCommittedSize, (void*)( cbBufferNew - cbBufferOld ) );
-        Assert( cbCacheCommittedSizeInitial >= 0 );
+            OnDebug( const LONG_PTR cbCacheCommittedSizeInitial = (LONG_PTR)) AtomicExchangeAddPointer( (void**)&g_cbCacheCommittedSize, (void*)( cbBufferNew - cbBufferOld ) );
+            Assert( cbCacheCommittedSizeInitial >= 0 );
+        }
 
 
         if ( !pbf->fAvailable && !pbf->fQuiesced )
@@ -13207,14 +13458,14 @@ ERR ErrBFIAllocPage( PBF* const ppbf, __in const ICBPage icbBufferSize, const BO
         *ppbf = pbfNil;
         BFAvail::ERR errAvail;
         ERR errAvailPoolRequest = JET_errSuccess;
-        if ( ( errAvail = g_bfavail.ErrRemove( ppbf, cmsecTest, fMRU ) ) != BFAvail::ERR::errSuccess )
+        if ( ( errAvail = ErrBFIAvailRemove( ppbf, cmsecTest, fMRU ) ) != BFAvail::ERR::errSuccess )
         {
             Assert( errAvail == BFAvail::ERR::errOutOfObjects );
 
             do
             {
                 BFICacheSizeBoost();
-                errAvail = g_bfavail.ErrRemove( ppbf, cmsecTest, fMRU );
+                errAvail = ErrBFIAvailRemove( ppbf, cmsecTest, fMRU );
 
                 if ( errAvail == BFAvail::ERR::errSuccess )
                 {
@@ -13259,7 +13510,7 @@ ERR ErrBFIAllocPage( PBF* const ppbf, __in const ICBPage icbBufferSize, const BO
                     }
                 }
 
-                errAvail = g_bfavail.ErrRemove( ppbf, fWait ? dtickFastRetry : cmsecTest, fMRU );
+                errAvail = ErrBFIAvailRemove( ppbf, fWait ? dtickFastRetry : cmsecTest, fMRU );
             } while ( ( errAvail != BFAvail::ERR::errSuccess ) && ( errAvailPoolRequest >= JET_errSuccess ) && fWait );
         }
 
@@ -13348,7 +13599,7 @@ ERR ErrBFIAllocPage( PBF* const ppbf, __in const ICBPage icbBufferSize, const BO
         (*ppbf)->sxwl.ReleaseOwnership( bfltWrite );
         Assert( !(*ppbf)->fInOB0OL && (*ppbf)->ob0ic.FUninitialized() );
 
-        g_bfavail.Insert( *ppbf, !fMRU );
+        BFIAvailInsert( *ppbf, !fMRU );
         *ppbf = pbfNil;
 
 
@@ -13676,7 +13927,7 @@ void BFIFreePage( PBF pbf, const BOOL fMRU, const BFFreePageFlags bffpfDangerous
 
 
         Assert( !pbf->fInOB0OL && pbf->ob0ic.FUninitialized() );
-        g_bfavail.Insert( pbf, fMRU );
+        BFIAvailInsert( pbf, fMRU );
     }
 }
 
@@ -17638,8 +17889,12 @@ private:
     ERR ErrAddBF_( const PBF pbf );
     void RevertBFs_( ULONG ibfStart = 0);
     void FlushUsefulBFs_();
+    bool FVerifyCleanBF_( const ULONG ibf );
+    bool FVerifyCleanBFBatch_( const ULONG * const rgibf, const ULONG cbf );
     bool FVerifyCleanBFs_();
 
+    enum { cbfVerifyBatchMax = 16 };
+
     ERR ErrPrepareBFForOpportuneWrite_( const PBF pbf );
     void GetFlushableNeighboringBFs_( const IFMP ifmp, const PGNO pgno, const INT iDelta );
 
@@ -17781,15 +18036,101 @@ void CBFOpportuneWriter::FlushUsefulBFs_()
     }
 }
 
+bool CBFOpportuneWriter::FVerifyCleanBF_( const ULONG ibf )
+{
+    const PBF pbf = m_rgpbf[ ibf ];
+    Assert( pbf->sxwl.FOwnExclusiveLatch() );
+    Assert( bfdfClean == pbf->bfdf );
+
+    ERR errPreVerify = pbf->err;
+
+    const ERR errReVerify = ErrBFIVerifyPage( pbf, CPageValidationLogEvent::LOG_NONE, fFalse );
+    if ( errPreVerify >= JET_errSuccess && errReVerify == JET_errPageNotInitialized )
+    {
+        return false;
+    }
+    if ( errReVerify != JET_errSuccess )
+    {
+        if ( errPreVerify >= JET_errSuccess )
+        {
+            UtilReportEvent( eventError,
+                    BUFFER_MANAGER_CATEGORY,
+                    TRANSIENT_IN_MEMORY_CORRUPTION_DETECTED_ID,
+                    0, NULL );
+            EnforceSz( fFalse, "TransientMemoryCorruption" );
+        }
+        else
+        {
+            AssertSz( fFalse, "Unexpected error here, this should have been clean by now as ErrBFIPrepareFlushPage() rejects BFs with errors." );
+        }
+
+        AssertTrack( pbf->bfbitfield.FRangeLocked(), "BFVerCleanRangeNotLocked" );
+        g_rgfmp[ pbf->ifmp ].LeaveRangeLock( pbf->pgno, pbf->irangelock );
+        pbf->bfbitfield.SetFRangeLocked( fFalse );
+
+        Assert( FBFIUpdatablePage( pbf ) );
+
+        pbf->sxwl.ReleaseExclusiveLatch();
+
+        m_rgpbf[ ibf ] = NULL;
+
+        return false;
+    }
+
+    return true;
+}
+
+bool CBFOpportuneWriter::FVerifyCleanBFBatch_( const ULONG * const rgibf, const ULONG cbf )
+{
+    Assert( cbf <= cbfVerifyBatchMax );
+
+    if ( 0 == cbf )
+    {
+        return true;
+    }
+
+    const void *    rgpv[ cbfVerifyBatchMax ];
+    ULONG           rgpgno[ cbfVerifyBatchMax ];
+    PAGECHECKSUM    rgchecksumExpected[ cbfVerifyBatchMax ];
+    PAGECHECKSUM    rgchecksumActual[ cbfVerifyBatchMax ];
+    const UINT      cbPage  = CbBFIPageSize( m_rgpbf[ rgibf[ 0 ] ] );
+
+    for ( ULONG iibf = 0; iibf < cbf; iibf++ )
+    {
+        const PBF pbf = m_rgpbf[ rgibf[ iibf ] ];
+        Assert( CbBFIPageSize( pbf ) == cbPage );
+        rgpv[ iibf ] = pbf->pv;
+        rgpgno[ iibf ] = pbf->pgno;
+    }
+
+    ChecksumPages( rgpv, rgpgno, cbf, cbPage, databasePage, rgchecksumExpected, rgchecksumActual );
+
+    for ( ULONG iibf = 0; iibf < cbf; iibf++ )
+    {
+        if ( rgchecksumExpected[ iibf ] == rgchecksumActual[ iibf ] )
+        {
+            continue;
+        }
+
+        if ( !FVerifyCleanBF_( rgibf[ iibf ] ) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool CBFOpportuneWriter::FVerifyCleanBFs_()
 {
+    ULONG   rgibfBatch[ cbfVerifyBatchMax ];
+    ULONG   cbfBatch    = 0;
+
     for ( ULONG ibf = 0; ibf < m_cbfUseful; ++ibf )
     {
         const PBF pbf = m_rgpbf[ ibf ];
         Assert( pbf->sxwl.FOwnExclusiveLatch() );
 
-        ERR errPreVerify = pbf->err;
-
         if ( bfdfClean == pbf->bfdf )
         {
 
@@ -17807,42 +18148,30 @@ bool CBFOpportuneWriter::FVerifyCleanBFs_()
                 }
             }
 
-            const ERR errReVerify = ErrBFIVerifyPage( pbf, CPageValidationLogEvent::LOG_NONE, fFalse );
-            if ( errPreVerify >= JET_errSuccess && errReVerify == JET_errPageNotInitialized )
-            {
-                return false;
-            }
-            if ( errReVerify != JET_errSuccess )
+            if ( !FBFIDatabasePage( pbf ) || pbf->err < JET_errSuccess )
             {
-                if ( errPreVerify >= JET_errSuccess )
+                if ( !FVerifyCleanBF_( ibf ) )
                 {
-                    UtilReportEvent( eventError,
-                            BUFFER_MANAGER_CATEGORY,
-                            TRANSIENT_IN_MEMORY_CORRUPTION_DETECTED_ID,
-                            0, NULL );
-                    EnforceSz( fFalse, "TransientMemoryCorruption" );
+                    return false;
                 }
-                else
+                continue;
+            }
+
+            if ( cbfBatch == cbfVerifyBatchMax ||
+                ( cbfBatch > 0 && CbBFIPageSize( m_rgpbf[ rgibfBatch[ 0 ] ] ) != CbBFIPageSize( pbf ) ) )
+            {
+                if ( !FVerifyCleanBFBatch_( rgibfBatch, cbfBatch ) )
                 {
-                    AssertSz( fFalse, "Unexpected error here, this should have been clean by now as ErrBFIPrepareFlushPage() rejects BFs with errors." );
+                    return false;
                 }
-
-                AssertTrack( pbf->bfbitfield.FRangeLocked(), "BFVerCleanRangeNotLocked" );
-                g_rgfmp[ pbf->ifmp ].LeaveRangeLock( pbf->pgno, pbf->irangelock );
-                pbf->bfbitfield.SetFRangeLocked( fFalse );
-
-                Assert( FBFIUpdatablePage( pbf ) );
-
-                pbf->sxwl.ReleaseExclusiveLatch();
-
-                m_rgpbf[ ibf ] = NULL;
-
-                return false;
+                cbfBatch = 0;
             }
+
+            rgibfBatch[ cbfBatch++ ] = ibf;
         }
     }
 
-    return true;
+    return FVerifyCleanBFBatch_( rgibfBatch, cbfBatch );
 }
 
 ERR CBFOpportuneWriter::ErrPrepareBFForOpportuneWrite_( const PBF pbf  )
@@ -0,0 +1,686 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "std.hxx"
+
+#ifndef ENABLE_JET_UNIT_TEST
+#error This file should only be compiled with the unit tests!
+#endif
+
+const WCHAR* const  wszBCTestCachedFile     = L".\\BlockCacheTest.dat";
+const WCHAR* const  wszBCTestCachingFile    = L".\\BlockCacheTest.bcf";
+const QWORD         cbBCTestCache           = 16 * 1024 * 1024;
+const DWORD         cbBCTestBlock           = 4096;
+const DWORD         cBCTestBlock            = 256;
+const DWORD         cbBCTestJournalSegment  = 4096;
+
+double              g_pctBCTestWrite        = 100;
+
+const BYTE c_rgbBCTestHashedLRUKCacheType[ sizeof( GUID ) ] = { 0x4D, 0xCC, 0x73, 0x1C, 0x35, 0xAC, 0xD9, 0x41, 0xA9, 0xE0, 0xE4, 0x61, 0x12, 0xC0, 0x3A, 0x87 };
+
+class CBCTestCachedFileConfiguration : public CDefaultCachedFileConfiguration
+{
+    public:
+
+        CBCTestCachedFileConfiguration( _In_z_ const WCHAR* const wszKeyPathCachedFile )
+        {
+            m_fCachingEnabled = wcsstr( wszKeyPathCachedFile, L"BlockCacheTest.dat" ) != NULL;
+            OSStrCbCopyW( m_wszAbsPathCachingFile, sizeof( m_wszAbsPathCachingFile ), wszBCTestCachingFile );
+            m_cbBlockSize = cbBCTestBlock;
+        }
+};
+
+class CBCTestCacheConfiguration : public CDefaultCacheConfiguration
+{
+    public:
+
+        CBCTestCacheConfiguration()
+        {
+            m_fCacheEnabled = fTrue;
+            UtilMemCpy( m_rgbCacheType, c_rgbBCTestHashedLRUKCacheType, sizeof( m_rgbCacheType ) );
+            OSStrCbCopyW( m_wszAbsPathCachingFile, sizeof( m_wszAbsPathCachingFile ), wszBCTestCachingFile );
+            m_cbMaximumSize = cbBCTestCache;
+            m_pctWrite = g_pctBCTestWrite;
+        }
+};
+
+class CBCTestBlockCacheConfiguration : public CDefaultBlockCacheConfiguration
+{
+    public:
+
+        ERR ErrGetCachedFileConfiguration(  _In_z_  const WCHAR* const                  wszKeyPathCachedFile,
+                                            _Out_   ICachedFileConfiguration** const    ppcfconfig  ) override
+        {
+            *ppcfconfig = new CBCTestCachedFileConfiguration( wszKeyPathCachedFile );
+            return *ppcfconfig ? JET_errSuccess : ErrERRCheck( JET_errOutOfMemory );
+        }
+
+        ERR ErrGetCacheConfiguration(   _In_z_  const WCHAR* const          wszKeyPathCachingFile,
+                                        _Out_   ICacheConfiguration** const ppcconfig ) override
+        {
+            *ppcconfig = new CBCTestCacheConfiguration();
+            return *ppcconfig ? JET_errSuccess : ErrERRCheck( JET_errOutOfMemory );
+        }
+};
+
+class CBCTestFileSystemConfiguration : public CDefaultFileSystemConfiguration
+{
+    public:
+
+        CBCTestFileSystemConfiguration()
+        {
+            m_fBlockCacheEnabled = fTrue;
+        }
+
+        ERR ErrGetBlockCacheConfiguration( _Out_ IBlockCacheConfiguration** const ppbcconfig ) override
+        {
+            *ppbcconfig = new CBCTestBlockCacheConfiguration();
+            return *ppbcconfig ? JET_errSuccess : ErrERRCheck( JET_errOutOfMemory );
+        }
+};
+
+class CBCTestCacheTelemetry : public ICacheTelemetry
+{
+    public:
+
+        CBCTestCacheTelemetry()
+            :   m_cMiss( 0 ),
+                m_cHit( 0 ),
+                m_cPrefetch( 0 ),
+                m_cPrefetchHit( 0 ),
+                m_cWriteBack( 0 )
+        {
+        }
+
+        void Miss( const FileNumber filenumber, const BlockNumber blocknumber, const BOOL fRead, const BOOL fCacheIfPossible ) override
+        {
+            AtomicIncrement( &m_cMiss );
+        }
+
+        void Hit( const FileNumber filenumber, const BlockNumber blocknumber, const BOOL fRead, const BOOL fCacheIfPossible ) override
+        {
+            AtomicIncrement( &m_cHit );
+        }
+
+        void Update( const FileNumber filenumber, const BlockNumber blocknumber ) override {}
+
+        void Write( const FileNumber filenumber, const BlockNumber blocknumber, const BOOL fReplacementPolicy ) override
+        {
+            if ( fReplacementPolicy )
+            {
+                AtomicIncrement( &m_cWriteBack );
+            }
+        }
+
+        void Evict( const FileNumber filenumber, const BlockNumber blocknumber, const BOOL fReplacementPolicy ) override {}
+
+        void Prefetch( const FileNumber filenumber, const BlockNumber blocknumber ) override
+        {
+            AtomicIncrement( &m_cPrefetch );
+        }
+
+        void PrefetchHit( const FileNumber filenumber, const BlockNumber blocknumber ) override
+        {
+            AtomicIncrement( &m_cPrefetchHit );
+        }
+
+    public:
+
+        LONG m_cMiss;
+        LONG m_cHit;
+        LONG m_cPrefetch;
+        LONG m_cPrefetchHit;
+        LONG m_cWriteBack;
+};
+
+class CBCTestStack
+{
+    public:
+
+        CBCTestStack()
+            :   m_pfident( NULL ),
+                m_pcrep( NULL ),
+                m_pfsf( NULL )
+        {
+        }
+
+        ERR ErrInit()
+        {
+            ERR             err         = JET_errSuccess;
+            IFileSystemAPI* pfsapiInner = NULL;
+
+            Call( ErrOSFSCreate( &pfsapiInner ) );
+            Call( ErrOSBCCreateFileIdentification( &m_pfident ) );
+            Call( ErrOSBCCreateCacheRepository( m_pfident, &m_ctm, &m_pcrep ) );
+            Call( ErrOSBCCreateFileSystemFilter( &m_fsconfig, &pfsapiInner, m_pfident, &m_ctm, m_pcrep, &m_pfsf ) );
+
+        HandleError:
+            delete pfsapiInner;
+            return err;
+        }
+
+        ~CBCTestStack()
+        {
+            delete m_pfsf;
+            delete m_pcrep;
+            delete m_pfident;
+        }
+
+    public:
+
+        CBCTestFileSystemConfiguration  m_fsconfig;
+        CBCTestCacheTelemetry           m_ctm;
+        IFileIdentification*            m_pfident;
+        ICacheRepository*               m_pcrep;
+        IFileSystemFilter*              m_pfsf;
+};
+
+LOCAL void BlockCacheTestIFillBlock( BYTE* const pb, const DWORD iBlock, const DWORD dwGeneration )
+{
+    for ( DWORD idw = 0; idw < cbBCTestBlock / sizeof( DWORD ); idw++ )
+    {
+        ( (DWORD*)pb )[ idw ] = ( iBlock << 16 ) ^ ( dwGeneration << 8 ) ^ idw;
+    }
+}
+
+LOCAL BOOL FBlockCacheTestIBlockMatches( const BYTE* const pb, const DWORD iBlock, const DWORD dwGeneration )
+{
+    BYTE rgbExpected[ cbBCTestBlock ];
+
+    BlockCacheTestIFillBlock( rgbExpected, iBlock, dwGeneration );
+    return memcmp( pb, rgbExpected, cbBCTestBlock ) == 0;
+}
+
+LOCAL ERR ErrBlockCacheTestIWriteBlocks( IFileAPI* const pfapi, BYTE* const pb, const DWORD dwGeneration )
+{
+    ERR                 err     = JET_errSuccess;
+    TraceContextScope   tcScope( iorpBlockCache );
+
+    for ( DWORD iBlock = 0; iBlock < cBCTestBlock; iBlock++ )
+    {
+        BlockCacheTestIFillBlock( pb, iBlock, dwGeneration );
+        Call( pfapi->ErrIOWrite( *tcScope, (QWORD)iBlock * cbBCTestBlock, cbBCTestBlock, pb, qosIONormal ) );
+    }
+
+HandleError:
+    return err;
+}
+
+//  Reads or writes a file directly through the OS file system, bypassing the block cache.
+
+LOCAL ERR ErrBlockCacheTestIRawIO(  const WCHAR* const  wszFile,
+                                    const QWORD         ib,
+                                    const DWORD         cb,
+                                    BYTE* const         pb,
+                                    const BOOL          fWrite )
+{
+    ERR                 err     = JET_errSuccess;
+    IFileSystemAPI*     pfsapi  = NULL;
+    IFileAPI*           pfapi   = NULL;
+    TraceContextScope   tcScope( iorpBlockCache );
+
+    Call( ErrOSFSCreate( &pfsapi ) );
+    Call( pfsapi->ErrFileOpen( wszFile, fWrite ? IFileAPI::fmfNone : IFileAPI::fmfReadOnly, &pfapi ) );
+    if ( fWrite )
+    {
+        Call( pfapi->ErrIOWrite( *tcScope, ib, cb, pb, qosIONormal ) );
+        Call( pfapi->ErrFlushFileBuffers( iofrUtility ) );
+    }
+    else
+    {
+        Call( pfapi->ErrIORead( *tcScope, ib, cb, pb, qosIONormal ) );
+    }
+
+HandleError:
+    delete pfapi;
+    delete pfsapi;
+    return err;
+}
+
+struct BCTestJournalTail
+{
+    SegmentPosition sposLast;
+    QWORD           ibLast;
+};
+
+LOCAL BOOL FBlockCacheTestIFindJournalTail( const SegmentPosition   spos,
+                                            const ERR               err,
+                                            IJournalSegment* const  pjs,
+                                            const DWORD_PTR         keyVisitSegment )
+{
+    BCTestJournalTail* const ptail = (BCTestJournalTail*)keyVisitSegment;
+
+    if ( spos == ptail->sposLast && pjs )
+    {
+        (void)pjs->ErrGetPhysicalId( &ptail->ibLast );
+    }
+
+    return fTrue;
+}
+
+//  Finds where the journal of the caching file will write its next segment and the offset of its
+//  current last segment.
+
+LOCAL ERR ErrBlockCacheTestIFindJournalTail( CBCTestStack* const pstack, QWORD* const pibLast, QWORD* const pibNext )
+{
+    ERR                     err         = JET_errSuccess;
+    IFileFilter*            pff         = NULL;
+    IJournalSegmentManager* pjsm        = NULL;
+    QWORD                   ibJournal   = 0;
+    QWORD                   cbJournal   = 0;
+    BCTestJournalTail       tail        = { sposInvalid, qwMax };
+
+    *pibLast = qwMax;
+    *pibNext = qwMax;
+
+    Call( pstack->m_pfsf->ErrFileOpen( wszBCTestCachingFile, IFileAPI::fmfNone, (IFileAPI**)&pff ) );
+    Call( ErrOSBCGetHashedLRUKCacheJournal( &pstack->m_fsconfig, pff, &ibJournal, &cbJournal ) );
+    Call( ErrOSBCCreateJournalSegmentManager( pff, ibJournal, cbJournal, &pjsm ) );
+    Call( pjsm->ErrGetProperties( NULL, NULL, &tail.sposLast ) );
+    Call( pjsm->ErrVisitSegments( FBlockCacheTestIFindJournalTail, (DWORD_PTR)&tail ) );
+    if ( tail.ibLast == qwMax )
+    {
+        Error( ErrERRCheck( JET_errInternalError ) );
+    }
+
+    *pibLast = tail.ibLast;
+    *pibNext = tail.ibLast + cbBCTestJournalSegment < ibJournal + cbJournal ? tail.ibLast + cbBCTestJournalSegment : ibJournal;
+
+HandleError:
+    delete pjsm;
+    delete pff;
+    return err;
+}
+
+JETUNITTEST( BlockCache, HashedLRUKCacheWriteBackSurvivesRemount )
+{
+    BYTE*               pb          = (BYTE*)PvOSMemoryPageAlloc( cbBCTestBlock, NULL );
+    CBCTestStack*       pstack      = NULL;
+    IFileAPI*           pfapi       = NULL;
+    LONG                cHitBefore  = 0;
+    TraceContextScope   tcScope( iorpBlockCache );
+
+    CHECK( pb != NULL );
+
+
+    pstack = new CBCTestStack();
+    CHECK( pstack != NULL );
+    CHECKCALLS( pstack->ErrInit() );
+    (void)pstack->m_pfsf->ErrFileDelete( wszBCTestCachedFile );
+    (void)pstack->m_pfsf->ErrFileDelete( wszBCTestCachingFile );
+    CHECKCALLS( pstack->m_pfsf->ErrFileCreate( wszBCTestCachedFile, IFileAPI::fmfNone, &pfapi ) );
+    CHECKCALLS( pfapi->ErrSetSize( *tcScope, (QWORD)cBCTestBlock * cbBCTestBlock, fTrue, qosIONormal ) );
+
+    CHECKCALLS( ErrBlockCacheTestIWriteBlocks( pfapi, pb, 1 ) );
+
+    cHitBefore = pstack->m_ctm.m_cHit;
+    for ( DWORD iBlock = 0; iBlock < cBCTestBlock; iBlock++ )
+    {
+        CHECKCALLS( pfapi->ErrIORead( *tcScope, (QWORD)iBlock * cbBCTestBlock, cbBCTestBlock, pb, qosIONormal ) );
+        CHECK( FBlockCacheTestIBlockMatches( pb, iBlock, 1 ) );
+    }
+    CHECK( pstack->m_ctm.m_cHit > cHitBefore );
+
+    CHECKCALLS( pfapi->ErrFlushFileBuffers( iofrUtility ) );
+    delete pfapi;
+    pfapi = NULL;
+    delete pstack;
+
+
+    pstack = new CBCTestStack();
+    CHECK( pstack != NULL );
+    CHECKCALLS( pstack->ErrInit() );
+    CHECKCALLS( pstack->m_pfsf->ErrFileOpen( wszBCTestCachedFile, IFileAPI::fmfNone, &pfapi ) );
+    for ( DWORD iBlock = 0; iBlock < cBCTestBlock; iBlock++ )
+    {
+        CHECKCALLS( pfapi->ErrIORead( *tcScope, (QWORD)iBlock * cbBCTestBlock, cbBCTestBlock, pb, qosIONormal ) );
+        CHECK( FBlockCacheTestIBlockMatches( pb, iBlock, 1 ) );
+    }
+
+    CHECKCALLS( ErrBlockCacheTestIWriteBlocks( pfapi, pb, 2 ) );
+    CHECKCALLS( pfapi->ErrFlushFileBuffers( iofrUtility ) );
+    delete pfapi;
+    pfapi = NULL;
+    delete pstack;
+
+
+    pstack = new CBCTestStack();
+    CHECK( pstack != NULL );
+    CHECKCALLS( pstack->ErrInit() );
+    CHECKCALLS( pstack->m_pfsf->ErrFileOpen( wszBCTestCachedFile, IFileAPI::fmfNone, &pfapi ) );
+    for ( DWORD iBlock = 0; iBlock < cBCTestBlock; iBlock++ )
+    {
+        CHECKCALLS( pfapi->ErrIORead( *tcScope, (QWORD)iBlock * cbBCTestBlock, cbBCTestBlock, pb, qosIONormal ) );
+        CHECK( FBlockCacheTestIBlockMatches( pb, iBlock, 2 ) );
+    }
+    delete pfapi;
+    pfapi = NULL;
+
+    (void)pstack->m_pfsf->ErrFileDelete( wszBCTestCachedFile );
+    (void)pstack->m_pfsf->ErrFileDelete( wszBCTestCachingFile );
+    delete pstack;
+
+    OSMemoryPageFree( pb );
+}
+
+JETUNITTEST( BlockCache, HashedLRUKCacheWritesBackToCachedFile )
+{
+    BYTE*               pb          = (BYTE*)PvOSMemoryPageAlloc( cbBCTestBlock, NULL );
+    CBCTestStack*       pstack      = NULL;
+    IFileAPI*           pfapi       = NULL;
+    DWORD               cMatch      = 0;
+    TraceContextScope   tcScope( iorpBlockCache );
+
+    CHECK( pb != NULL );
+
+    //  write back every dirty cluster as soon as possible
+
+    g_pctBCTestWrite = 0;
+
+    pstack = new CBCTestStack();
+    CHECK( pstack != NULL );
+    CHECKCALLS( pstack->ErrInit() );
+    (void)pstack->m_pfsf->ErrFileDelete( wszBCTestCachedFile );
+    (void)pstack->m_pfsf->ErrFileDelete( wszBCTestCachingFile );
+    CHECKCALLS( pstack->m_pfsf->ErrFileCreate( wszBCTestCachedFile, IFileAPI::fmfNone, &pfapi ) );
+    CHECKCALLS( pfapi->ErrSetSize( *tcScope, (QWORD)cBCTestBlock * cbBCTestBlock, fTrue, qosIONormal ) );
+    CHECKCALLS( ErrBlockCacheTestIWriteBlocks( pfapi, pb, 1 ) );
+    CHECKCALLS( pfapi->ErrFlushFileBuffers( iofrUtility ) );
+
+    //  block 0 holds the cached file header and one dirty cluster may stay below the threshold
+
+    for ( INT cmsec = 0; cmsec < 10000 && pstack->m_ctm.m_cWriteBack < (LONG)cBCTestBlock - 2; cmsec += 10 )
+    {
+        UtilSleep( 10 );
+    }
+    CHECK( pstack->m_ctm.m_cWriteBack >= (LONG)cBCTestBlock - 2 );
+    delete pfapi;
+    pfapi = NULL;
+    delete pstack;
+    pstack = NULL;
+
+    g_pctBCTestWrite = 100;
+
+
+    for ( DWORD iBlock = 1; iBlock < cBCTestBlock; iBlock++ )
+    {
+        CHECKCALLS( ErrBlockCacheTestIRawIO( wszBCTestCachedFile, (QWORD)iBlock * cbBCTestBlock, cbBCTestBlock, pb, fFalse ) );
+        if ( FBlockCacheTestIBlockMatches( pb, iBlock, 1 ) )
+        {
+            cMatch++;
+        }
+        else
+        {
+            CHECK( pb[ 0 ] == 0 && memcmp( pb, pb + 1, cbBCTestBlock - 1 ) == 0 );
+        }
+    }
+    CHECK( cMatch >= cBCTestBlock - 2 );
+
+
+    pstack = new CBCTestStack();
+    CHECK( pstack != NULL );
+    CHECKCALLS( pstack->ErrInit() );
+    CHECKCALLS( pstack->m_pfsf->ErrFileOpen( wszBCTestCachedFile, IFileAPI::fmfNone, &pfapi ) );
+    for ( DWORD iBlock = 0; iBlock < cBCTestBlock; iBlock++ )
+    {
+        CHECKCALLS( pfapi->ErrIORead( *tcScope, (QWORD)iBlock * cbBCTestBlock, cbBCTestBlock, pb, qosIONormal ) );
+        CHECK( FBlockCacheTestIBlockMatches( pb, iBlock, 1 ) );
+    }
+    delete pfapi;
+    pfapi = NULL;
+
+    (void)pstack->m_pfsf->ErrFileDelete( wszBCTestCachedFile );
+    (void)pstack->m_pfsf->ErrFileDelete( wszBCTestCachingFile );
+    delete pstack;
+
+    OSMemoryPageFree( pb );
+}
+
+JETUNITTEST( BlockCache, HashedLRUKCacheRecoversFromTornJournal )
+{
+    BYTE*               pb          = (BYTE*)PvOSMemoryPageAlloc( max( cbBCTestBlock, cbBCTestJournalSegment ), NULL );
+    CBCTestStack*       pstack      = NULL;
+    IFileAPI*           pfapi       = NULL;
+    QWORD               ibLast      = 0;
+    QWORD               ibNext      = 0;
+    TraceContextScope   tcScope( iorpBlockCache );
+
+    CHECK( pb != NULL );
+
+
+    pstack = new CBCTestStack();
+    CHECK( pstack != NULL );
+    CHECKCALLS( pstack->ErrInit() );
+    (void)pstack->m_pfsf->ErrFileDelete( wszBCTestCachedFile );
+    (void)pstack->m_pfsf->ErrFileDelete( wszBCTestCachingFile );
+    CHECKCALLS( pstack->m_pfsf->ErrFileCreate( wszBCTestCachedFile, IFileAPI::fmfNone, &pfapi ) );
+    CHECKCALLS( pfapi->ErrSetSize( *tcScope, (QWORD)cBCTestBlock * cbBCTestBlock, fTrue, qosIONormal ) );
+    CHECKCALLS( ErrBlockCacheTestIWriteBlocks( pfapi, pb, 1 ) );
+    CHECKCALLS( ErrBlockCacheTestIWriteBlocks( pfapi, pb, 2 ) );
+    CHECKCALLS( pfapi->ErrFlushFileBuffers( iofrUtility ) );
+    delete pfapi;
+    pfapi = NULL;
+    delete pstack;
+
+
+    //  simulate a crash in the middle of writing the next journal segment:  only the first half of
+    //  the segment reaches the disk
+
+    pstack = new CBCTestStack();
+    CHECK( pstack != NULL );
+    CHECKCALLS( pstack->ErrInit() );
+    CHECKCALLS( ErrBlockCacheTestIFindJournalTail( pstack, &ibLast, &ibNext ) );
+    delete pstack;
+
+    CHECKCALLS( ErrBlockCacheTestIRawIO( wszBCTestCachingFile, ibLast, cbBCTestJournalSegment, pb, fFalse ) );
+    CHECKCALLS( ErrBlockCacheTestIRawIO( wszBCTestCachingFile, ibNext, cbBCTestJournalSegment / 2, pb, fTrue ) );
+
+
+    //  the torn segment is discarded and every acknowledged write survives
+
+    pstack = new CBCTestStack();
+    CHECK( pstack != NULL );
+    CHECKCALLS( pstack->ErrInit() );
+    CHECKCALLS( pstack->m_pfsf->ErrFileOpen( wszBCTestCachedFile, IFileAPI::fmfNone, &pfapi ) );
+    for ( DWORD iBlock = 0; iBlock < cBCTestBlock; iBlock++ )
+    {
+        CHECKCALLS( pfapi->ErrIORead( *tcScope, (QWORD)iBlock * cbBCTestBlock, cbBCTestBlock, pb, qosIONormal ) );
+        CHECK( FBlockCacheTestIBlockMatches( pb, iBlock, 2 ) );
+    }
+
+    CHECKCALLS( ErrBlockCacheTestIWriteBlocks( pfapi, pb, 3 ) );
+    CHECKCALLS( pfapi->ErrFlushFileBuffers( iofrUtility ) );
+    for ( DWORD iBlock = 0; iBlock < cBCTestBlock; iBlock++ )
+    {
+        CHECKCALLS( pfapi->ErrIORead( *tcScope, (QWORD)iBlock * cbBCTestBlock, cbBCTestBlock, pb, qosIONormal ) );
+        CHECK( FBlockCacheTestIBlockMatches( pb, iBlock, 3 ) );
+    }
+    delete pfapi;
+    pfapi = NULL;
+
+    (void)pstack->m_pfsf->ErrFileDelete( wszBCTestCachedFile );
+    (void)pstack->m_pfsf->ErrFileDelete( wszBCTestCachingFile );
+    delete pstack;
+
+    OSMemoryPageFree( pb );
+}
+
+JETUNITTEST( BlockCache, SequentialReadsArePrefetched )
+{
+    BYTE*               pb          = (BYTE*)PvOSMemoryPageAlloc( cbBCTestBlock, NULL );
+    CBCTestStack*       pstack      = new CBCTestStack();
+    IFileAPI*           pfapi       = NULL;
+    DWORD               iBlock      = 0;
+    LONG                cMissBefore = 0;
+    TraceContextScope   tcScope( iorpBlockCache );
+
+    CHECK( pb != NULL );
+    CHECK( pstack != NULL );
+    CHECKCALLS( pstack->ErrInit() );
+
+    (void)pstack->m_pfsf->ErrFileDelete( wszBCTestCachedFile );
+    (void)pstack->m_pfsf->ErrFileDelete( wszBCTestCachingFile );
+    CHECKCALLS( pstack->m_pfsf->ErrFileCreate( wszBCTestCachedFile, IFileAPI::fmfNone, &pfapi ) );
+    CHECKCALLS( pfapi->ErrSetSize( *tcScope, (QWORD)cBCTestBlock * cbBCTestBlock, fTrue, qosIONormal ) );
+    CHECKCALLS( ErrBlockCacheTestIWriteBlocks( pfapi, pb, 1 ) );
+
+
+    for ( iBlock = 1; iBlock < 4; iBlock++ )
+    {
+        CHECKCALLS( pfapi->ErrIORead( *tcScope, (QWORD)iBlock * cbBCTestBlock, cbBCTestBlock, pb, qosIONormal ) );
+    }
+    cMissBefore = pstack->m_ctm.m_cMiss;
+
+    for ( INT cmsec = 0; cmsec < 10000 && pstack->m_ctm.m_cPrefetch == 0; cmsec += 10 )
+    {
+        UtilSleep( 10 );
+    }
+    CHECK( pstack->m_ctm.m_cPrefetch > 0 );
+
+    //  the read-ahead itself is not reported as cache requests
+
+    CHECK( pstack->m_ctm.m_cMiss == cMissBefore );
+
+    for ( ; iBlock < cBCTestBlock; iBlock++ )
+    {
+        CHECKCALLS( pfapi->ErrIORead( *tcScope, (QWORD)iBlock * cbBCTestBlock, cbBCTestBlock, pb, qosIONormal ) );
+        CHECK( FBlockCacheTestIBlockMatches( pb, iBlock, 1 ) );
+    }
+    CHECK( pstack->m_ctm.m_cPrefetchHit > 0 );
+    CHECK( pstack->m_ctm.m_cPrefetchHit <= pstack->m_ctm.m_cPrefetch );
+
+    delete pfapi;
+    (void)pstack->m_pfsf->ErrFileDelete( wszBCTestCachedFile );
+    (void)pstack->m_pfsf->ErrFileDelete( wszBCTestCachingFile );
+    delete pstack;
+
+    OSMemoryPageFree( pb );
+}
+
+struct BCTestAsyncIO
+{
+    volatile LONG   cioPending;
+    volatile LONG   cioFailed;
+};
+
+LOCAL void BlockCacheTestIAsyncIOComplete(  const ERR               err,
+                                            IFileAPI* const         pfapi,
+                                            const FullTraceContext& tc,
+                                            const OSFILEQOS         grbitQOS,
+                                            const QWORD             ibOffset,
+                                            const DWORD             cbData,
+                                            const BYTE* const       pbData,
+                                            const DWORD_PTR         keyIOComplete )
+{
+    BCTestAsyncIO* const pasyncio = (BCTestAsyncIO*)keyIOComplete;
+
+    if ( err < JET_errSuccess )
+    {
+        AtomicIncrement( (LONG*)&pasyncio->cioFailed );
+    }
+    AtomicDecrement( (LONG*)&pasyncio->cioPending );
+}
+
+LOCAL BOOL FBlockCacheTestIAsyncIOWait( IFileAPI* const pfapi, BCTestAsyncIO* const pasyncio )
+{
+    CallS( pfapi->ErrIOIssue() );
+    for ( INT cmsec = 0; cmsec < 10000 && pasyncio->cioPending > 0; cmsec += 1 )
+    {
+        UtilSleep( 1 );
+    }
+    return pasyncio->cioPending == 0 && pasyncio->cioFailed == 0;
+}
+
+//  Half block requests are neither cached on a write nor inserted on a read miss so they go
+//  to the cached file asynchronously.  Full block reads are inserted into the cache and still
+//  complete through the callback.
+
+JETUNITTEST( BlockCache, HashedLRUKCacheCompletesAsyncIO )
+{
+    const DWORD         cbHalf      = cbBCTestBlock / 2;
+    const DWORD         cBlockAsync = 16;
+    BYTE*               pb          = (BYTE*)PvOSMemoryPageAlloc( cBlockAsync * cbBCTestBlock, NULL );
+    CBCTestStack*       pstack      = new CBCTestStack();
+    IFileAPI*           pfapi       = NULL;
+    BCTestAsyncIO       asyncio     = { 0, 0 };
+    TraceContextScope   tcScope( iorpBlockCache );
+
+    CHECK( pb != NULL );
+    CHECK( pstack != NULL );
+    CHECKCALLS( pstack->ErrInit() );
+
+    (void)pstack->m_pfsf->ErrFileDelete( wszBCTestCachedFile );
+    (void)pstack->m_pfsf->ErrFileDelete( wszBCTestCachingFile );
+    CHECKCALLS( pstack->m_pfsf->ErrFileCreate( wszBCTestCachedFile, IFileAPI::fmfNone, &pfapi ) );
+    CHECKCALLS( pfapi->ErrSetSize( *tcScope, (QWORD)cBCTestBlock * cbBCTestBlock, fTrue, qosIONormal ) );
+
+
+    for ( DWORD iBlock = 0; iBlock < cBlockAsync; iBlock++ )
+    {
+        BYTE* const pbBlock = pb + iBlock * cbBCTestBlock;
+
+        BlockCacheTestIFillBlock( pbBlock, iBlock, 1 );
+        for ( DWORD ib = 0; ib < cbBCTestBlock; ib += cbHalf )
+        {
+            AtomicIncrement( (LONG*)&asyncio.cioPending );
+            CHECKCALLS( pfapi->ErrIOWrite(  *tcScope,
+                                            (QWORD)iBlock * cbBCTestBlock + ib,
+                                            cbHalf,
+                                            pbBlock + ib,
+                                            qosIONormal,
+                                            BlockCacheTestIAsyncIOComplete,
+                                            DWORD_PTR( &asyncio ) ) );
+        }
+    }
+    CHECK( FBlockCacheTestIAsyncIOWait( pfapi, &asyncio ) );
+
+
+    memset( pb, 0, cBlockAsync * cbBCTestBlock );
+    for ( DWORD iBlock = 0; iBlock < cBlockAsync; iBlock++ )
+    {
+        BYTE* const pbBlock = pb + iBlock * cbBCTestBlock;
+
+        for ( DWORD ib = 0; ib < cbBCTestBlock; ib += cbHalf )
+        {
+            AtomicIncrement( (LONG*)&asyncio.cioPending );
+            CHECKCALLS( pfapi->ErrIORead(   *tcScope,
+                                            (QWORD)iBlock * cbBCTestBlock + ib,
+                                            cbHalf,
+                                            pbBlock + ib,
+                                            qosIONormal,
+                                            BlockCacheTestIAsyncIOComplete,
+                                            DWORD_PTR( &asyncio ) ) );
+        }
+    }
+    CHECK( FBlockCacheTestIAsyncIOWait( pfapi, &asyncio ) );
+    for ( DWORD iBlock = 0; iBlock < cBlockAsync; iBlock++ )
+    {
+        CHECK( FBlockCacheTestIBlockMatches( pb + iBlock * cbBCTestBlock, iBlock, 1 ) );
+    }
+
+
+    memset( pb, 0, cBlockAsync * cbBCTestBlock );
+    for ( DWORD iBlock = 0; iBlock < cBlockAsync; iBlock++ )
+    {
+        AtomicIncrement( (LONG*)&asyncio.cioPending );
+        CHECKCALLS( pfapi->ErrIORead(   *tcScope,
+                                        (QWORD)iBlock * cbBCTestBlock,
+                                        cbBCTestBlock,
+                                        pb + iBlock * cbBCTestBlock,
+                                        qosIONormal,
+                                        BlockCacheTestIAsyncIOComplete,
+                                        DWORD_PTR( &asyncio ) ) );
+    }
+    CHECK( FBlockCacheTestIAsyncIOWait( pfapi, &asyncio ) );
+    for ( DWORD iBlock = 0; iBlock < cBlockAsync; iBlock++ )
+    {
+        CHECK( FBlockCacheTestIBlockMatches( pb + iBlock * cbBCTestBlock, iBlock, 1 ) );
+    }
+
+    delete pfapi;
+    (void)pstack->m_pfsf->ErrFileDelete( wszBCTestCachedFile );
+    (void)pstack->m_pfsf->ErrFileDelete( wszBCTestCachingFile );
+    delete pstack;
+
+    OSMemoryPageFree( pb );
+}
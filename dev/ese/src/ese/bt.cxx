@@ -659,6 +659,7 @@ VOID BTClose( FUCB *pfucb )
     {
         Assert( !FFUCBSpace( pfucb ) );
         RECRemoveCursorFilter( pfucb );
+        RECRemoveRetrievePlan( pfucb );
         FUCBRemoveEncryptionKey( pfucb );
         FUCBSetDeferClose( pfucb );
     }
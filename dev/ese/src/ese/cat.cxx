@@ -439,7 +439,7 @@ ERR ErrCATIRetrieveTaggedColumn(
     ERR err;
 
     Assert( FTaggedFid( fid ) );
-    Assert( 1 == itagSequence );
+    Assert( 1 == itagSequence || fidMSO_CompressionDictionary == fid );
     Assert( Pcsr( pfucb )->FLatched() );
 
     DATA dataRetrieved;
@@ -7121,6 +7121,63 @@ HandleError:
 }
 
 
+LOCAL ERR ErrCATILoadCompressionDictionaries( FUCB * const pfucbCatalog, PKDICTIONARY ** const ppdict )
+{
+    ERR             err             = JET_errSuccess;
+    BYTE *          pbDictionary    = NULL;
+    PKDICTIONARY *  pdict           = NULL;
+
+    Assert( FTaggedFid( fidMSO_CompressionDictionary ) );
+    Assert( Pcsr( pfucbCatalog )->FLatched() );
+
+    *ppdict = NULL;
+
+    Alloc( pbDictionary = new BYTE[ cbPKDictionaryMax ] );
+
+    for ( ULONG itagSequence = 1; ; itagSequence++ )
+    {
+        ULONG cbActual = 0;
+        Call( ErrCATIRetrieveTaggedColumn(
+                    pfucbCatalog,
+                    fidMSO_CompressionDictionary,
+                    itagSequence,
+                    pfucbCatalog->kdfCurr.data,
+                    pbDictionary,
+                    cbPKDictionaryMax,
+                    &cbActual ) );
+        if ( JET_wrnColumnNull == err )
+        {
+            break;
+        }
+
+        if ( JET_errSuccess != err || itagSequence > cPKDictionaryMax )
+        {
+            AssertSz( fFalse, "Invalid fidMSO_CompressionDictionary column in catalog." );
+            Error( ErrERRCheck( JET_errCatalogCorrupted ) );
+        }
+
+        DATA dataDictionary;
+        dataDictionary.SetPv( pbDictionary );
+        dataDictionary.SetCb( cbActual );
+        err = ErrPKCreateDictionary( (BYTE)itagSequence, dataDictionary, pdict, &pdict );
+        if ( JET_errInvalidParameter == err )
+        {
+            AssertSz( fFalse, "Invalid fidMSO_CompressionDictionary column in catalog, size not right." );
+            Error( ErrERRCheck( JET_errCatalogCorrupted ) );
+        }
+        Call( err );
+    }
+
+    *ppdict = pdict;
+    pdict = NULL;
+    err = JET_errSuccess;
+
+HandleError:
+    PKDeleteDictionaries( pdict );
+    delete[] pbDictionary;
+    return err;
+}
+
 ERR ErrCATInitFCB( FUCB *pfucbTable, OBJID objidTable )
 {
     ERR         err;
@@ -7140,6 +7197,7 @@ ERR ErrCATInitFCB( FUCB *pfucbTable, OBJID objidTable )
     JET_SPACEHINTS jsphTemplate;
     JET_SPACEHINTS jsphPrimaryDeferredLV = { 0 };
     BOOL        fSetDeferredLVSpacehints = fFalse;
+    PKDICTIONARY *pdictCompression      = NULL;
 
     if ( FFMPIsTempDB( ifmp ) )
     {
@@ -7372,6 +7430,8 @@ ERR ErrCATInitFCB( FUCB *pfucbTable, OBJID objidTable )
         cbLVChunkMost = (LONG)UlParam( JET_paramLVChunkSizeMost );
     }
 
+    Call( ErrCATILoadCompressionDictionaries( pfucbCatalog, &pdictCompression ) );
+
     Assert( locOnCurBM == pfucbCatalog->locLogical );
     Assert( Pcsr( pfucbCatalog )->FLatched() );
     Call( ErrBTRelease( pfucbCatalog ) );
@@ -7413,6 +7473,9 @@ ERR ErrCATInitFCB( FUCB *pfucbTable, OBJID objidTable )
     Assert( cbLVChunkMost <= (LONG)UlParam( JET_paramLVChunkSizeMost ) );
     ptdb->SetLVChunkMost( cbLVChunkMost );
 
+    ptdb->SetPdictCompression( pdictCompression );
+    pdictCompression = NULL;
+
     if ( fHitEOF )
     {
         Call( ErrFILEIInitializeFCB(
@@ -7492,6 +7555,8 @@ HandleError:
         pfcbTemplateTable = pfcbNil;
     }
 
+    PKDeleteDictionaries( pdictCompression );
+
     CallS( ErrCATClose( ppib, pfucbCatalog ) );
 
     return err;
@@ -7901,6 +7966,228 @@ HandleError:
     return err;
 }
 
+LOCAL ERR ErrCATIAddCompressionDictionary(
+    PIB         * const ppib,
+    FUCB        * const pfucbCatalog,
+    const DATA& dataDictionary,
+    BYTE        * const pidDictionary )
+{
+    ERR         err;
+    ULONG       itagSequence;
+    JET_RETINFO retinfo;
+    JET_SETINFO setinfo;
+
+    CallR( ErrIsamPrepareUpdate( ppib, pfucbCatalog, JET_prepReplaceNoLock ) );
+
+    for ( itagSequence = 1; ; itagSequence++ )
+    {
+        ULONG cbActual;
+        retinfo.cbStruct = sizeof( retinfo );
+        retinfo.ibLongValue = 0;
+        retinfo.itagSequence = itagSequence;
+        Call( ErrIsamRetrieveColumn(
+                ppib,
+                pfucbCatalog,
+                fidMSO_CompressionDictionary,
+                NULL,
+                0,
+                &cbActual,
+                JET_bitRetrieveCopy,
+                &retinfo ) );
+        if ( JET_wrnColumnNull == err )
+        {
+            break;
+        }
+    }
+
+    if ( itagSequence > cPKDictionaryMax )
+    {
+        Error( ErrERRCheck( JET_errCompressionDictionaryLimit ) );
+    }
+
+    Assert( 0 == *pidDictionary || itagSequence == *pidDictionary );
+    *pidDictionary = (BYTE)itagSequence;
+
+    setinfo.cbStruct = sizeof( setinfo );
+    setinfo.ibLongValue = 0;
+    setinfo.itagSequence = 0;
+    Call( ErrIsamSetColumn(
+                ppib,
+                pfucbCatalog,
+                fidMSO_CompressionDictionary,
+                dataDictionary.Pv(),
+                dataDictionary.Cb(),
+                NO_GRBIT,
+                &setinfo ) );
+    Call( ErrIsamUpdate( ppib, pfucbCatalog, NULL, 0, NULL, NO_GRBIT ) );
+
+HandleError:
+    if( err < 0 )
+    {
+        CallS( ErrIsamPrepareUpdate( ppib, pfucbCatalog, JET_prepCancel ) );
+    }
+    return err;
+}
+
+ERR ErrCATAddCompressionDictionary(
+    PIB         *ppib,
+    const IFMP  ifmp,
+    const OBJID objidTable,
+    const DATA& dataDictionary,
+    BYTE        *pidDictionary )
+{
+    ERR         err;
+    FUCB *      pfucbCatalog        = pfucbNil;
+    BOOKMARK    bm;
+    BYTE        *pbBookmark         = NULL;
+    ULONG       cbBookmark;
+
+    *pidDictionary = 0;
+
+    CallR( ErrDIRBeginTransaction( ppib, 39461, NO_GRBIT ) );
+
+    Alloc( pbBookmark = (BYTE *)RESBOOKMARK.PvRESAlloc() );
+
+    Call( ErrCATOpen( ppib, ifmp, &pfucbCatalog, fFalse ) );
+    Call( ErrCATISeekTable( ppib, pfucbCatalog, objidTable ) );
+
+    Call( ErrDIRRelease( pfucbCatalog ) );
+
+    Assert( pfucbCatalog->bmCurr.key.prefix.FNull() );
+    Assert( pfucbCatalog->bmCurr.data.FNull() );
+    Assert( pfucbCatalog->bmCurr.key.Cb() <= cbBookmarkAlloc );
+    cbBookmark = min( pfucbCatalog->bmCurr.key.Cb(), cbBookmarkAlloc );
+    pfucbCatalog->bmCurr.key.CopyIntoBuffer( pbBookmark, cbBookmark );
+
+    bm.key.prefix.Nullify();
+    bm.key.suffix.SetPv( pbBookmark );
+    bm.key.suffix.SetCb( cbBookmark );
+    bm.data.Nullify();
+
+    Call( ErrCATIAddCompressionDictionary( ppib, pfucbCatalog, dataDictionary, pidDictionary ) );
+    Call( ErrCATClose( ppib, pfucbCatalog ) );
+    pfucbCatalog = pfucbNil;
+
+    Call( ErrCATOpen( ppib, ifmp, &pfucbCatalog, fTrue ) );
+    Call( ErrDIRGotoBookmark( pfucbCatalog, bm ) );
+    Call( ErrCATIAddCompressionDictionary( ppib, pfucbCatalog, dataDictionary, pidDictionary ) );
+    Call( ErrCATClose( ppib, pfucbCatalog ) );
+    pfucbCatalog = pfucbNil;
+
+    Call( ErrDIRCommitTransaction( ppib, NO_GRBIT ) );
+
+HandleError:
+    if( pfucbNil != pfucbCatalog )
+    {
+        CallS( ErrCATClose( ppib, pfucbCatalog ) );
+    }
+
+    RESBOOKMARK.Free( pbBookmark );
+
+    if( err < 0 )
+    {
+        *pidDictionary = 0;
+        CallSx( ErrDIRRollback( ppib ), JET_errRollbackError );
+    }
+    return err;
+}
+
+//  Compaction copies intrinsic long values byte for byte, and those compressed with a dictionary
+//  name it by id, so the destination table gets the source's dictionaries in the same order (and
+//  therefore with the same ids) before any record is copied.  They are also loaded into the
+//  destination TDB so that index keys built over the copied values can decompress them.
+
+ERR ErrCATCopyCompressionDictionaries(
+    PIB         * const ppib,
+    const IFMP  ifmpSrc,
+    const OBJID objidSrc,
+    FUCB        * const pfucbDest )
+{
+    ERR             err                 = JET_errSuccess;
+    FCB * const     pfcbDest            = pfucbDest->u.pfcb;
+    FUCB *          pfucbCatalog        = pfucbNil;
+    BYTE *          pbDictionary        = NULL;
+    PKDICTIONARY *  pdict               = NULL;
+    BOOL            fInTransaction      = fFalse;
+
+    Alloc( pbDictionary = new BYTE[ cbPKDictionaryMax ] );
+
+    Call( ErrDIRBeginTransaction( ppib, 47228, NO_GRBIT ) );
+    fInTransaction = fTrue;
+
+    Call( ErrCATOpen( ppib, ifmpSrc, &pfucbCatalog ) );
+    Call( ErrCATISeekTable( ppib, pfucbCatalog, objidSrc ) );
+    Call( ErrDIRRelease( pfucbCatalog ) );
+
+    for ( ULONG itagSequence = 1; ; itagSequence++ )
+    {
+        ULONG       cbActual        = 0;
+        BYTE        idDictionary    = 0;
+        JET_RETINFO retinfo;
+        DATA        dataDictionary;
+
+        retinfo.cbStruct = sizeof( retinfo );
+        retinfo.ibLongValue = 0;
+        retinfo.itagSequence = itagSequence;
+        Call( ErrIsamRetrieveColumn(
+                ppib,
+                pfucbCatalog,
+                fidMSO_CompressionDictionary,
+                pbDictionary,
+                cbPKDictionaryMax,
+                &cbActual,
+                NO_GRBIT,
+                &retinfo ) );
+        if ( JET_wrnColumnNull == err )
+        {
+            break;
+        }
+
+        if ( JET_errSuccess != err || itagSequence > cPKDictionaryMax )
+        {
+            AssertSz( fFalse, "Invalid fidMSO_CompressionDictionary column in catalog." );
+            Error( ErrERRCheck( JET_errCatalogCorrupted ) );
+        }
+
+        dataDictionary.SetPv( pbDictionary );
+        dataDictionary.SetCb( cbActual );
+
+        Call( ErrCATAddCompressionDictionary( ppib, pfucbDest->ifmp, pfcbDest->ObjidFDP(), dataDictionary, &idDictionary ) );
+        if ( idDictionary != itagSequence )
+        {
+            AssertSz( fFalse, "Destination table already had compression dictionaries." );
+            Error( ErrERRCheck( JET_errInternalError ) );
+        }
+
+        Call( ErrPKCreateDictionary( idDictionary, dataDictionary, pdict, &pdict ) );
+    }
+
+    Call( ErrCATClose( ppib, pfucbCatalog ) );
+    pfucbCatalog = pfucbNil;
+
+    Call( ErrDIRCommitTransaction( ppib, NO_GRBIT ) );
+    fInTransaction = fFalse;
+
+    pfcbDest->EnterDML();
+    Assert( NULL == pfcbDest->Ptdb()->PdictCompression() );
+    pfcbDest->Ptdb()->SetPdictCompression( pdict );
+    pfcbDest->LeaveDML();
+    pdict = NULL;
+
+HandleError:
+    if ( pfucbNil != pfucbCatalog )
+    {
+        CallS( ErrCATClose( ppib, pfucbCatalog ) );
+    }
+    if ( fInTransaction )
+    {
+        CallSx( ErrDIRRollback( ppib ), JET_errRollbackError );
+    }
+    PKDeleteDictionaries( pdict );
+    delete[] pbDictionary;
+    return err;
+}
+
 LOCAL ERR ErrCATIUpgradeLocaleForOneIndex(
     _In_ PIB * const ppib,
     _In_ IDB * const pidb,
@@ -81,6 +81,17 @@ XECHECKSUM ChecksumNewFormat64Bit( const unsigned char * const pb, const ULONG c
 XECHECKSUM ChecksumNewFormatSSE( const unsigned char * const pb, const ULONG cb, const ULONG pgno, BOOL fHeaderBlock = fTrue );
 template <ChecksumParityMaskFunc TParityMaskFunc> XECHECKSUM ChecksumNewFormatSSE2( const unsigned char * const pb, const ULONG cb, const ULONG pgno, BOOL fHeaderBlock = fTrue);
 XECHECKSUM ChecksumNewFormatAVX( const unsigned char * const pb, const ULONG cb, const ULONG pgno, BOOL fHeaderBlock = fTrue );
+XECHECKSUM ChecksumNewFormatAVX2( const unsigned char * const pb, const ULONG cb, const ULONG pgno, BOOL fHeaderBlock = fTrue );
+XECHECKSUM ChecksumNewFormatAVX512( const unsigned char * const pb, const ULONG cb, const ULONG pgno, BOOL fHeaderBlock = fTrue );
+void ChecksumNewFormatAVX2x2(
+    const unsigned char * const pb0,
+    const unsigned char * const pb1,
+    const ULONG cb,
+    const ULONG pgno0,
+    const ULONG pgno1,
+    BOOL fHeaderBlock,
+    XECHECKSUM * const pxeChecksum0,
+    XECHECKSUM * const pxeChecksum1 );
 
 
 
@@ -164,6 +175,8 @@ static void ECCChecksumUnitTest( const unsigned char * const pb )
     const XECHECKSUM checksum4KB64Bit       = ChecksumNewFormat64Bit( pb, 4096, pgno );
     const XECHECKSUM checksum4KBSSE2_Popcnt = FPopcntAvailable()  ? ChecksumNewFormatSSE2<ParityMaskFuncPopcnt>( pb, 4096, pgno ) : checksum4KB;
     const XECHECKSUM checksum4KBAVX         = FAVXEnabled() ? ChecksumNewFormatAVX( pb, 4096, pgno ) : checksum4KB;
+    const XECHECKSUM checksum4KBAVX2        = FAVX2Enabled() ? ChecksumNewFormatAVX2( pb, 4096, pgno ) : checksum4KB;
+    const XECHECKSUM checksum4KBAVX512      = FAVX512Enabled() ? ChecksumNewFormatAVX512( pb, 4096, pgno ) : checksum4KB;
 
     Enforce( checksum4KB == checksum4KBSSE );
     Enforce( checksum4KB == checksum4KBSSE2 );
@@ -171,6 +184,8 @@ static void ECCChecksumUnitTest( const unsigned char * const pb )
     Enforce( checksum4KB == checksum4KBSelect );
     Enforce( checksum4KB == checksum4KBSSE2_Popcnt );
     Enforce( checksum4KB == checksum4KBAVX );
+    Enforce( checksum4KB == checksum4KBAVX2 );
+    Enforce( checksum4KB == checksum4KBAVX512 );
 
     const XECHECKSUM checksum8KB            = ChecksumNewFormatSlowly( pb, 8192, pgno );
     const XECHECKSUM checksum8KBSSE         = FSSEInstructionsAvailable()  ? ChecksumNewFormatSSE( pb, 8192, pgno ) : checksum8KB;
@@ -179,6 +194,8 @@ static void ECCChecksumUnitTest( const unsigned char * const pb )
     const XECHECKSUM checksum8KB64Bit       = ChecksumNewFormat64Bit( pb, 8192, pgno );
     const XECHECKSUM checksum8KBSSE2_Popcnt = FPopcntAvailable()  ? ChecksumNewFormatSSE2<ParityMaskFuncPopcnt>( pb, 8192, pgno ) : checksum8KB;
     const XECHECKSUM checksum8KBAVX         = FAVXEnabled() ? ChecksumNewFormatAVX( pb, 8192, pgno ) : checksum8KB;
+    const XECHECKSUM checksum8KBAVX2        = FAVX2Enabled() ? ChecksumNewFormatAVX2( pb, 8192, pgno ) : checksum8KB;
+    const XECHECKSUM checksum8KBAVX512      = FAVX512Enabled() ? ChecksumNewFormatAVX512( pb, 8192, pgno ) : checksum8KB;
 
     Enforce( checksum8KB == checksum8KBSSE );
     Enforce( checksum8KB == checksum8KBSSE2 );
@@ -186,6 +203,21 @@ static void ECCChecksumUnitTest( const unsigned char * const pb )
     Enforce( checksum8KB == checksum8KBSelect );
     Enforce( checksum8KB == checksum8KBSSE2_Popcnt );
     Enforce( checksum8KB == checksum8KBAVX );
+    Enforce( checksum8KB == checksum8KBAVX2 );
+    Enforce( checksum8KB == checksum8KBAVX512 );
+
+    for ( ULONG cbBlock = 1024; cbBlock <= 8192; cbBlock *= 2 )
+    {
+        for ( INT fHeaderBlock = 0; fHeaderBlock <= 1; fHeaderBlock++ )
+        {
+            const XECHECKSUM checksum       = ChecksumNewFormat64Bit( pb, cbBlock, pgno, fHeaderBlock );
+            const XECHECKSUM checksumAVX2   = FAVX2Enabled() ? ChecksumNewFormatAVX2( pb, cbBlock, pgno, fHeaderBlock ) : checksum;
+            const XECHECKSUM checksumAVX512 = FAVX512Enabled() ? ChecksumNewFormatAVX512( pb, cbBlock, pgno, fHeaderBlock ) : checksum;
+
+            Enforce( checksum == checksumAVX2 );
+            Enforce( checksum == checksumAVX512 );
+        }
+    }
 }
 
 
@@ -193,7 +225,15 @@ extern PFNCHECKSUMNEWFORMAT pfnChecksumNewFormat;
 
 static void TestECCChecksumSelection()
 {
-    if ( FAVXEnabled() )
+    if ( FAVX512Enabled() )
+    {
+        Enforce( pfnChecksumNewFormat == ChecksumNewFormatAVX512 );
+    }
+    else if ( FAVX2Enabled() )
+    {
+        Enforce( pfnChecksumNewFormat == ChecksumNewFormatAVX2 );
+    }
+    else if ( FAVXEnabled() )
     {
         Enforce( pfnChecksumNewFormat == ChecksumNewFormatAVX );
     }
@@ -414,6 +454,90 @@ static void TestSetAndChecksum( unsigned char * const pb )
     TestCorruptOnePage( pb, 4096, logfileHeader );
 }
 
+static void TestChecksumNewFormatMultiple( unsigned char * const pb )
+{
+    const ULONG cblk = 3;
+
+    for ( ULONG cbBlock = 1024; cbBlock <= 8192; cbBlock *= 2 )
+    {
+        AssertRTL( cblk * cbBlock <= (ULONG)g_cbPageMax );
+
+        for ( INT iHeader = 0; iHeader < 2; iHeader++ )
+        {
+            const BOOL          fHeaderBlock = ( 0 == iHeader );
+            const unsigned char *   rgpb[ cblk ];
+            ULONG               rgpgno[ cblk ];
+            XECHECKSUM          rgxeChecksum[ cblk ];
+
+            for ( ULONG iblk = 0; iblk < cblk; iblk++ )
+            {
+                rgpb[ iblk ] = pb + iblk * cbBlock;
+                rgpgno[ iblk ] = 200 + iblk;
+            }
+
+            ChecksumNewFormatMultiple( rgpb, cbBlock, rgpgno, fHeaderBlock, rgxeChecksum, cblk );
+
+            for ( ULONG iblk = 0; iblk < cblk; iblk++ )
+            {
+                AssertRTL( ChecksumNewFormatSlowly( rgpb[ iblk ], cbBlock, rgpgno[ iblk ], fHeaderBlock ) == rgxeChecksum[ iblk ] );
+            }
+
+            if ( FAVX2Enabled() && FPopcntAvailable() )
+            {
+                XECHECKSUM xeChecksum0;
+                XECHECKSUM xeChecksum1;
+                ChecksumNewFormatAVX2x2( rgpb[ 0 ], rgpb[ 1 ], cbBlock, rgpgno[ 0 ], rgpgno[ 1 ], fHeaderBlock, &xeChecksum0, &xeChecksum1 );
+
+                AssertRTL( ChecksumNewFormatSlowly( rgpb[ 0 ], cbBlock, rgpgno[ 0 ], fHeaderBlock ) == xeChecksum0 );
+                AssertRTL( ChecksumNewFormatSlowly( rgpb[ 1 ], cbBlock, rgpgno[ 1 ], fHeaderBlock ) == xeChecksum1 );
+            }
+        }
+    }
+}
+
+static void TestChecksumPages( unsigned char * const pb )
+{
+    const UINT      cpage       = 3;
+    const void *    rgpv[ cpage ];
+    ULONG           rgpgno[ cpage ];
+    PAGECHECKSUM    rgchecksumExpected[ cpage ];
+    PAGECHECKSUM    rgchecksumActual[ cpage ];
+
+    unsigned char * const pbPages = ( unsigned char* )PvOSMemoryPageAlloc( cpage * g_cbPageMax, NULL );
+    AssertRTL( NULL != pbPages );
+
+    for ( UINT cbPageTest = 8192; cbPageTest <= (UINT)g_cbPageMax; cbPageTest *= 2 )
+    {
+        for ( UINT ipage = 0; ipage < cpage; ipage++ )
+        {
+            unsigned char * const pbPage = pbPages + ipage * cbPageTest;
+            memcpy( pbPage, pb, cbPageTest );
+            pbPage[ cbPageTest - 1 ] ^= (unsigned char)( ipage + 1 );
+
+            rgpv[ ipage ] = pbPage;
+            rgpgno[ ipage ] = 100 + ipage;
+            SetPageChecksum( pbPage, cbPageTest, databasePage, rgpgno[ ipage ] );
+        }
+
+        FlipBit( pbPages + cbPageTest, 1000 );
+
+        ChecksumPages( rgpv, rgpgno, cpage, cbPageTest, databasePage, rgchecksumExpected, rgchecksumActual );
+
+        for ( UINT ipage = 0; ipage < cpage; ipage++ )
+        {
+            PAGECHECKSUM checksumExpected;
+            PAGECHECKSUM checksumActual;
+            ChecksumPage( rgpv[ ipage ], cbPageTest, databasePage, rgpgno[ ipage ], &checksumExpected, &checksumActual );
+
+            AssertRTL( checksumExpected == rgchecksumExpected[ ipage ] );
+            AssertRTL( checksumActual == rgchecksumActual[ ipage ] );
+            AssertRTL( ( 1 == ipage ) == ( rgchecksumExpected[ ipage ] != rgchecksumActual[ ipage ] ) );
+        }
+    }
+
+    OSMemoryPageFree( pbPages );
+}
+
 static void TestDehydratedPageChecksum( unsigned char * const pb )
 {
     for ( INT cb = 4096; cb <= g_cbPageMax; cb += 4096 )
@@ -969,11 +1093,13 @@ ERR ErrChecksumUnitTest( INT cIterations )
 {
     ERR err = JET_errSuccess;
 
-    wprintf(L"\nProcessor Capabilities: %s%s%s%s\n",
+    wprintf(L"\nProcessor Capabilities: %s%s%s%s%s%s\n",
         FSSEInstructionsAvailable() ? L"SSE " : L"",
         FSSE2InstructionsAvailable() ? L"SSE2 " : L"",
         FPopcntAvailable() ? L"POPCNT " : L"",
-        FAVXEnabled() ? L"AVX " : L"");
+        FAVXEnabled() ? L"AVX " : L"",
+        FAVX2Enabled() ? L"AVX2 " : L"",
+        FAVX512Enabled() ? L"AVX512 " : L"");
     
     unsigned char* pb = ( unsigned char* )PvOSMemoryPageAlloc( g_cbPageMax, NULL );
     if( NULL == pb )
@@ -999,6 +1125,8 @@ ERR ErrChecksumUnitTest( INT cIterations )
         ECCChecksumUnitTest( pb );
         TestSetAndChecksum( pb );
         TestDehydratedPageChecksum( pb );
+        TestChecksumNewFormatMultiple( pb );
+        TestChecksumPages( pb );
         TestECCChecksumSelection();
     }
 
@@ -1006,7 +1134,7 @@ ERR ErrChecksumUnitTest( INT cIterations )
     return err;
 }
 
-ERR ErrChecksumPerfTest( PFNCHECKSUMNEWFORMAT pfnChecksumMethod, UINT cbPageTest, UINT cbDataset )
+ERR ErrChecksumPerfTest( PFNCHECKSUMNEWFORMAT pfnChecksumMethod, UINT cbPageTest, UINT cbDataset, QWORD * const pcnsecAvg )
 {
     const INT cSamples = 1000000;
     Assert( cbDataset % cbPageTest == 0);
@@ -1078,14 +1206,22 @@ ERR ErrChecksumPerfTest( PFNCHECKSUMNEWFORMAT pfnChecksumMethod, UINT cbPageTest
     wprintf( L"Min = %I64d, Max = %I64d\n", sample_min, sample_max );
     wprintf( L"Std. Dev. (timer-cycles) = %.1lf\n", sqrt( variance ) );
 
+    *pcnsecAvg = (QWORD)( avg * 1000.0 * 1000.0 * 1000.0 / HrtHRTFreq() );
+
     OSMemoryPageFree( pb );
     OSMemoryPageFree( pSamples );
     return JET_errSuccess;
 }
 
 #define CHECKSUM_PERF_TEST( method, cbPage, cbDataset ) \
-    wprintf( L"\nTesting perf for %hs\n", #method ); \
-    ErrChecksumPerfTest( (method), (cbPage), (cbDataset) );
+    { \
+        QWORD   cnsecAvg    = 0; \
+        CHAR    szMetric[ 128 ]; \
+        wprintf( L"\nTesting perf for %hs\n", #method ); \
+        CHECKCALLS( ErrChecksumPerfTest( (method), (cbPage), (cbDataset), &cnsecAvg ) ); \
+        OSStrCbFormatA( szMetric, sizeof( szMetric ), "%s, %uk pages", #method, (cbPage) / 1024 ); \
+        REPORTMETRIC( szMetric, cnsecAvg, "nsec/page" ); \
+    }
 
 
 
@@ -1101,28 +1237,50 @@ JETUNITTESTEX( CHECKSUM, ExtendedFunctionalValidation, JetSimpleUnitTest::dwDont
 
 JETUNITTESTEX( CHECKSUM, Perf, JetSimpleUnitTest::dwDontRunByDefault )
 {
-    CHECKSUM_PERF_TEST( ChecksumNewFormat64Bit, 32768, 100 * 1024 * 1024 );
-    CHECKSUM_PERF_TEST( ChecksumNewFormatSSE, 32768, 100 * 1024 * 1024 );
-    CHECKSUM_PERF_TEST( ChecksumNewFormatSSE2<ParityMaskFuncDefault>, 32768, 100 * 1024 * 1024 );
-
-    if ( FPopcntAvailable() )
+    for ( UINT cbPage = 4096; cbPage <= 32768; cbPage *= 2 )
     {
-        wprintf( L"\nPOPCNT supported !" );
-        CHECKSUM_PERF_TEST( ChecksumNewFormatSSE2<ParityMaskFuncPopcnt>, 32768, 100 * 1024 * 1024 );
-    }
-    else
-    {
-        wprintf( L"\nPOPCNT not supported !\nChecksumNewFormatSSE2<ParityMaskFuncPopcnt> will not run.\n" );
-    }
+        CHECKSUM_PERF_TEST( ChecksumNewFormat64Bit, cbPage, 100 * 1024 * 1024 );
+        CHECKSUM_PERF_TEST( ChecksumNewFormatSSE, cbPage, 100 * 1024 * 1024 );
+        CHECKSUM_PERF_TEST( ChecksumNewFormatSSE2<ParityMaskFuncDefault>, cbPage, 100 * 1024 * 1024 );
 
-    if ( FAVXEnabled() )
-    {
-        wprintf( L"\nAVX supported !" );
-        CHECKSUM_PERF_TEST( ChecksumNewFormatAVX, 32768, 100 * 1024 * 1024 );
-    }
-    else
-    {
-        wprintf( L"\nAVX not supported !\nChecksumNewFormatAVX will not run.\n" );
+        if ( FPopcntAvailable() )
+        {
+            wprintf( L"\nPOPCNT supported !" );
+            CHECKSUM_PERF_TEST( ChecksumNewFormatSSE2<ParityMaskFuncPopcnt>, cbPage, 100 * 1024 * 1024 );
+        }
+        else
+        {
+            wprintf( L"\nPOPCNT not supported !\nChecksumNewFormatSSE2<ParityMaskFuncPopcnt> will not run.\n" );
+        }
+
+        if ( FAVXEnabled() )
+        {
+            wprintf( L"\nAVX supported !" );
+            CHECKSUM_PERF_TEST( ChecksumNewFormatAVX, cbPage, 100 * 1024 * 1024 );
+        }
+        else
+        {
+            wprintf( L"\nAVX not supported !\nChecksumNewFormatAVX will not run.\n" );
+        }
+
+        if ( FAVX2Enabled() )
+        {
+            wprintf( L"\nAVX2 supported !" );
+            CHECKSUM_PERF_TEST( ChecksumNewFormatAVX2, cbPage, 100 * 1024 * 1024 );
+        }
+        else
+        {
+            wprintf( L"\nAVX2 not supported !\nChecksumNewFormatAVX2 will not run.\n" );
+        }
+
+        if ( FAVX512Enabled() )
+        {
+            wprintf( L"\nAVX512 supported !" );
+            CHECKSUM_PERF_TEST( ChecksumNewFormatAVX512, cbPage, 100 * 1024 * 1024 );
+        }
+        else
+        {
+            wprintf( L"\nAVX512 not supported !\nChecksumNewFormatAVX512 will not run.\n" );
+        }
     }
 }
-
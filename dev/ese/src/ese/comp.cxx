@@ -1144,6 +1144,15 @@ LOCAL ERR ErrCMPCopyTable(
 
     Call( Param( pinst, JET_paramDbExtensionSize )->Set( pinst, ppibNil, max( cpgDbExtensionSizeSave, (CPG)min( g_rgfmp[ pcompactinfo->ifmpSrc ].CbPage(), cpgTableSrc / 100 ) ), NULL ) );
 
+    if ( NULL != pfucbSrc->u.pfcb->Ptdb()->PdictCompression() )
+    {
+        Call( ErrCATCopyCompressionDictionaries(
+                    ppib,
+                    pcompactinfo->ifmpSrc,
+                    pfucbSrc->u.pfcb->ObjidFDP(),
+                    pfucbDest ) );
+    }
+
     Call( ErrSORTCopyRecords(
                 ppib,
                 pfucbSrc,
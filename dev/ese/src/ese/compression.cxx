@@ -432,6 +432,24 @@ void CCompressionBufferCache::Free( BYTE * const pb )
 
 static CCompressionBufferCache g_compressionBufferCache;
 
+struct PKDICTIONARY
+{
+    static const INT cbitHash = 12;
+    static const INT cHash = 1 << cbitHash;
+
+    PKDICTIONARY *  pdictPrev;
+    BYTE            idDictionary;
+    INT             cb;
+    BYTE *          pb;
+    INT             rgiHash[ cHash ];
+};
+
+INLINE ULONG UlPKIDictionaryHash( const BYTE * const pb )
+{
+    const ULONG ul = *(UnalignedLittleEndian<ULONG> *)pb;
+    return ( ul * 2654435761U ) >> ( 32 - PKDICTIONARY::cbitHash );
+}
+
 class CDataCompressor
 {
     public:
@@ -447,18 +465,22 @@ class CDataCompressor
             IDataCompressorStats * const pstats,
             _Out_writes_bytes_to_opt_( cbDataCompressedMax, *pcbDataCompressedActual ) BYTE * const pbDataCompressed,
             const INT cbDataCompressedMax,
-            _Out_ INT * const pcbDataCompressedActual );
+            _Out_ INT * const pcbDataCompressedActual,
+            const PKDICTIONARY * const pdict = NULL );
         
         ERR ErrDecompress(
             const DATA& dataCompressed,
             IDataCompressorStats * const pstats,
             _Out_writes_bytes_to_opt_( cbDataMax, min( cbDataMax, *pcbDataActual ) ) BYTE * const pbData,
             const INT cbDataMax,
-            _Out_ INT * const pcbDataActual );
+            _Out_ INT * const pcbDataActual,
+            const PKDICTIONARY * const pdict = NULL );
 
         ERR ErrScrub(
             DATA& data,
             const CHAR chScrub );
+
+        static BOOL FCompressedWithDictionary( const DATA& dataCompressed );
         
     private:
         enum COMPRESSION_SCHEME
@@ -470,6 +492,7 @@ class CDataCompressor
                 COMPRESS_SCRUB = 0x4,
                 COMPRESS_XPRESS9 = 0x5,
                 COMPRESS_XPRESS10 = 0x6,
+                COMPRESS_DICTIONARY = 0x7,
                 COMPRESS_MAXIMUM = 0x1f,
             };
 
@@ -489,6 +512,14 @@ class CDataCompressor
             UnalignedLittleEndian<ULONG>        mle_ulUncompressedChecksum;
             UnalignedLittleEndian<ULONGLONG>    mle_ullCompressedChecksum;
         };
+
+        PERSISTED
+        struct DictionaryHeader
+        {
+            BYTE                            m_fCompressScheme;
+            BYTE                            m_idDictionary;
+            UnalignedLittleEndian<WORD>     mle_cbUncompressed;
+        };
 #include <poppack.h>
 
     private:
@@ -496,11 +527,25 @@ class CDataCompressor
 
         static const INT pctCompressionWastedEffort = 10;
 
+        static const INT cbDictionaryCompressMin = 32;
+
+        //  Positions of the value being compressed, layered over the dictionary's own hash table.
+        //  An entry only applies when its generation matches the current call, so the scratch
+        //  never has to be reset or copied between calls.
+
+        struct DictionaryEncode
+        {
+            ULONG   ulGeneration;
+            ULONG   rgulGeneration[ PKDICTIONARY::cHash ];
+            INT     rgipos[ PKDICTIONARY::cHash ];
+        };
+
         INT m_cencodeCachedMax;
         INT m_cdecodeCachedMax;
 
         XpressEncodeStream* m_rgencodeXpress;
         XpressDecodeStream* m_rgdecodeXpress;
+        DictionaryEncode** m_rgpencodeDictionary;
 #ifdef XPRESS9_COMPRESSION
         XPRESS9_ENCODER* m_rgencodeXpress9;
         XPRESS9_DECODER* m_rgdecodeXpress9;
@@ -516,6 +561,8 @@ class CDataCompressor
         ERR ErrXpressDecodeOpen_( _Out_ XpressDecodeStream * const pdecode );
         void XpressDecodeClose_( XpressDecodeStream decode );
         void XpressDecodeRelease_( XpressDecodeStream decode );
+        ERR ErrDictionaryEncodeOpen_( _Out_ DictionaryEncode ** const ppencode );
+        void DictionaryEncodeClose_( DictionaryEncode * const pencode );
 
 #ifdef XPRESS9_COMPRESSION
         ERR ErrXpress9EncodeOpen_( _Out_ XPRESS9_ENCODER * const pencode );
@@ -585,6 +632,13 @@ class CDataCompressor
             const INT cbDataUncompressed,
             IDataCompressorStats * const pstats );
 #endif
+        ERR ErrCompressDictionary_(
+            const DATA& data,
+            const PKDICTIONARY * const pdict,
+            _Out_writes_bytes_to_( cbDataCompressedMax, *pcbDataCompressedActual ) BYTE * const pbDataCompressed,
+            const INT cbDataCompressedMax,
+            _Out_ INT * const pcbDataCompressedActual,
+            IDataCompressorStats * const pstats );
 
         ERR ErrDecompress7BitAscii_(
             const DATA& dataCompressed,
@@ -622,6 +676,13 @@ class CDataCompressor
             const BOOL fForceSoftwareDecompression,
             BOOL * pfUsedCorsica );
 #endif
+        ERR ErrDecompressDictionary_(
+            const DATA& dataCompressed,
+            const PKDICTIONARY * const pdict,
+            _Out_writes_bytes_to_opt_( cbDataMax, min( cbDataMax, *pcbDataActual ) ) BYTE * const pbData,
+            const INT cbDataMax,
+            _Out_ INT * const pcbDataActual,
+            IDataCompressorStats * const pstats );
 
 private:
     CDataCompressor( const CDataCompressor& );
@@ -634,7 +695,8 @@ CDataCompressor::CDataCompressor() :
     m_cencodeCachedMax( 0 ),
     m_cdecodeCachedMax( 0 ),
     m_rgencodeXpress( NULL ),
-    m_rgdecodeXpress( NULL )
+    m_rgdecodeXpress( NULL ),
+    m_rgpencodeDictionary( NULL )
 #ifdef XPRESS9_COMPRESSION
     ,m_rgencodeXpress9( NULL )
     ,m_rgdecodeXpress9 ( NULL )
@@ -747,6 +809,32 @@ void CDataCompressor::XpressDecodeRelease_( XpressDecodeStream decode )
     }
 }
 
+ERR CDataCompressor::ErrDictionaryEncodeOpen_( _Out_ DictionaryEncode ** const ppencode )
+{
+    *ppencode = GetCachedPtr<DictionaryEncode *>( m_rgpencodeDictionary, m_cencodeCachedMax );
+    if ( NULL != *ppencode )
+    {
+        return JET_errSuccess;
+    }
+
+    DictionaryEncode * const pencode = new DictionaryEncode;
+    if ( NULL == pencode )
+    {
+        return ErrERRCheck( JET_errOutOfMemory );
+    }
+    memset( pencode, 0, sizeof( DictionaryEncode ) );
+    *ppencode = pencode;
+    return JET_errSuccess;
+}
+
+void CDataCompressor::DictionaryEncodeClose_( DictionaryEncode * const pencode )
+{
+    if ( pencode && !FCachePtr<DictionaryEncode *>( pencode, m_rgpencodeDictionary, m_cencodeCachedMax ) )
+    {
+        delete pencode;
+    }
+}
+
 #ifdef XPRESS9_COMPRESSION
 ERR CDataCompressor::ErrXpress9EncodeOpen_( _Out_ XPRESS9_ENCODER * const pencode )
 {
@@ -2020,19 +2108,340 @@ ERR CDataCompressor::ErrDecompressXpress10_(
 }
 #endif
 
+LOCAL BYTE * PbPKIWriteLength( BYTE * pb, const BYTE * const pbMax, INT cb )
+{
+    for ( ; cb >= 0xFF; cb -= 0xFF )
+    {
+        if ( pb >= pbMax )
+        {
+            return NULL;
+        }
+        *pb++ = 0xFF;
+    }
+
+    if ( pb >= pbMax )
+    {
+        return NULL;
+    }
+    *pb++ = (BYTE)cb;
+    return pb;
+}
+
+LOCAL ERR ErrPKIReadLength( const BYTE ** const ppb, const BYTE * const pbMax, INT * const pcb )
+{
+    BYTE b;
+    do
+    {
+        if ( *ppb >= pbMax || *pcb > (INT)wMax )
+        {
+            return ErrERRCheck( JET_errDecompressionFailed );
+        }
+        b = *(*ppb)++;
+        *pcb += b;
+    }
+    while ( 0xFF == b );
+
+    return JET_errSuccess;
+}
+
+LOCAL BYTE * PbPKIWriteSequence(
+    BYTE * pbOut,
+    const BYTE * const pbOutMax,
+    const BYTE * const pbLiteral,
+    const INT cbLiteral,
+    const INT cbMatch,
+    const INT ibOffset )
+{
+    if ( pbOut >= pbOutMax )
+    {
+        return NULL;
+    }
+
+    const INT cbMatchCode = cbMatch ? cbMatch - cbPKDictionaryMatchMin : 0;
+    *pbOut++ = (BYTE)( ( min( cbLiteral, 0xF ) << 4 ) | min( cbMatchCode, 0xF ) );
+
+    if ( cbLiteral >= 0xF && NULL == ( pbOut = PbPKIWriteLength( pbOut, pbOutMax, cbLiteral - 0xF ) ) )
+    {
+        return NULL;
+    }
+    if ( cbLiteral > pbOutMax - pbOut )
+    {
+        return NULL;
+    }
+    UtilMemCpy( pbOut, pbLiteral, cbLiteral );
+    pbOut += cbLiteral;
+
+    if ( cbMatch )
+    {
+        if ( pbOutMax - pbOut < sizeof( WORD ) )
+        {
+            return NULL;
+        }
+        *(UnalignedLittleEndian<WORD> *)pbOut = (WORD)ibOffset;
+        pbOut += sizeof( WORD );
+
+        if ( cbMatchCode >= 0xF && NULL == ( pbOut = PbPKIWriteLength( pbOut, pbOutMax, cbMatchCode - 0xF ) ) )
+        {
+            return NULL;
+        }
+    }
+
+    return pbOut;
+}
+
+ERR CDataCompressor::ErrCompressDictionary_(
+    const DATA& data,
+    const PKDICTIONARY * const pdict,
+    _Out_writes_bytes_to_( cbDataCompressedMax, *pcbDataCompressedActual ) BYTE * const pbDataCompressed,
+    const INT cbDataCompressedMax,
+    _Out_ INT * const pcbDataCompressedActual,
+    IDataCompressorStats * const pstats )
+{
+    PERFOptDeclare( const HRT hrtStart = HrtHRTCount() );
+
+    Assert( data.Cb() <= wMax );
+    Assert( pdict );
+    Assert( pstats );
+
+    ERR err = JET_errSuccess;
+    DictionaryEncode * pencode = NULL;
+    ULONG ulGeneration = 0;
+
+    const BYTE * const pbIn = (BYTE *)data.Pv();
+    const INT cbIn = data.Cb();
+    const INT cbDict = pdict->cb;
+    BYTE * pbOut = pbDataCompressed + sizeof( DictionaryHeader );
+    const BYTE * const pbOutMax = pbDataCompressed + min( cbDataCompressedMax, cbIn - 1 );
+
+    if ( pbOut >= pbOutMax )
+    {
+        Error( ErrERRCheck( errRECCannotCompress ) );
+    }
+
+    Call( ErrDictionaryEncodeOpen_( &pencode ) );
+    ulGeneration = ++pencode->ulGeneration;
+    if ( 0 == ulGeneration )
+    {
+        memset( pencode->rgulGeneration, 0, sizeof( pencode->rgulGeneration ) );
+        ulGeneration = pencode->ulGeneration = 1;
+    }
+
+    INT ibLiteral = 0;
+    INT ib = 0;
+    while ( ib + cbPKDictionaryMatchMin <= cbIn )
+    {
+        const ULONG iHash = UlPKIDictionaryHash( pbIn + ib );
+        const INT iposCandidate = ( ulGeneration == pencode->rgulGeneration[ iHash ] ) ? pencode->rgipos[ iHash ] : pdict->rgiHash[ iHash ];
+        const INT ipos = cbDict + ib;
+        pencode->rgulGeneration[ iHash ] = ulGeneration;
+        pencode->rgipos[ iHash ] = ipos;
+
+        INT cbMatch = 0;
+        if ( iposCandidate >= 0 && ipos - iposCandidate <= (INT)wMax )
+        {
+            for ( INT iposT = iposCandidate; ib + cbMatch < cbIn; iposT++, cbMatch++ )
+            {
+                const BYTE b = ( iposT < cbDict ) ? pdict->pb[ iposT ] : pbIn[ iposT - cbDict ];
+                if ( b != pbIn[ ib + cbMatch ] )
+                {
+                    break;
+                }
+            }
+        }
+
+        if ( cbMatch < cbPKDictionaryMatchMin )
+        {
+            ib++;
+            continue;
+        }
+
+        pbOut = PbPKIWriteSequence( pbOut, pbOutMax, pbIn + ibLiteral, ib - ibLiteral, cbMatch, ipos - iposCandidate );
+        if ( NULL == pbOut )
+        {
+            Error( ErrERRCheck( errRECCannotCompress ) );
+        }
+
+        ib += cbMatch;
+        ibLiteral = ib;
+    }
+
+    if ( ibLiteral < cbIn )
+    {
+        pbOut = PbPKIWriteSequence( pbOut, pbOutMax, pbIn + ibLiteral, cbIn - ibLiteral, 0, 0 );
+        if ( NULL == pbOut )
+        {
+            Error( ErrERRCheck( errRECCannotCompress ) );
+        }
+    }
+
+    DictionaryHeader * const pHdr = (DictionaryHeader *)pbDataCompressed;
+    pHdr->m_fCompressScheme = ( COMPRESS_DICTIONARY << 3 );
+    pHdr->m_idDictionary = pdict->idDictionary;
+    pHdr->mle_cbUncompressed = (WORD)cbIn;
+    *pcbDataCompressedActual = (INT)( pbOut - pbDataCompressed );
+
+HandleError:
+    DictionaryEncodeClose_( pencode );
+
+    if ( err == JET_errSuccess )
+    {
+        PERFOpt( pstats->AddUncompressedBytes( data.Cb() ) );
+        PERFOpt( pstats->AddCompressedBytes( *pcbDataCompressedActual ) );
+        PERFOpt( pstats->IncCompressionCalls() );
+        PERFOpt( pstats->AddCompressionDhrts( HrtHRTCount() - hrtStart ) );
+    }
+
+    return err;
+}
+
+ERR CDataCompressor::ErrDecompressDictionary_(
+    const DATA& dataCompressed,
+    const PKDICTIONARY * const pdict,
+    _Out_writes_bytes_to_opt_( cbDataMax, min( cbDataMax, *pcbDataActual ) ) BYTE * const pbData,
+    const INT cbDataMax,
+    _Out_ INT * const pcbDataActual,
+    IDataCompressorStats * const pstats )
+{
+    PERFOptDeclare( const HRT hrtStart = HrtHRTCount() );
+
+    ERR err = JET_errSuccess;
+
+    if ( dataCompressed.Cb() < sizeof( DictionaryHeader ) )
+    {
+        return ErrERRCheck( JET_errDecompressionFailed );
+    }
+
+    const DictionaryHeader * const pHdr = (DictionaryHeader *)dataCompressed.Pv();
+    Assert( ( pHdr->m_fCompressScheme >> 3 ) == COMPRESS_DICTIONARY );
+
+    const INT cbUncompressed = pHdr->mle_cbUncompressed;
+    *pcbDataActual = cbUncompressed;
+
+    if ( NULL == pbData || 0 == cbDataMax )
+    {
+        return ErrERRCheck( JET_wrnBufferTruncated );
+    }
+
+    const PKDICTIONARY * pdictT = pdict;
+    while ( pdictT && pdictT->idDictionary != pHdr->m_idDictionary )
+    {
+        pdictT = pdictT->pdictPrev;
+    }
+    if ( NULL == pdictT )
+    {
+        return ErrERRCheck( JET_errDecompressionFailed );
+    }
+
+    const INT cbDict = pdictT->cb;
+    const BYTE * pbIn = (BYTE *)dataCompressed.Pv() + sizeof( DictionaryHeader );
+    const BYTE * const pbInMax = (BYTE *)dataCompressed.Pv() + dataCompressed.Cb();
+    const INT cbWanted = min( cbUncompressed, cbDataMax );
+
+    INT ib = 0;
+    while ( ib < cbWanted )
+    {
+        if ( pbIn >= pbInMax )
+        {
+            Error( ErrERRCheck( JET_errDecompressionFailed ) );
+        }
+
+        const BYTE bToken = *pbIn++;
+
+        INT cbLiteral = bToken >> 4;
+        if ( 0xF == cbLiteral )
+        {
+            Call( ErrPKIReadLength( &pbIn, pbInMax, &cbLiteral ) );
+        }
+        if ( cbLiteral > pbInMax - pbIn || cbLiteral > cbUncompressed - ib )
+        {
+            Error( ErrERRCheck( JET_errDecompressionFailed ) );
+        }
+        UtilMemCpy( pbData + ib, pbIn, min( cbLiteral, cbWanted - ib ) );
+        pbIn += cbLiteral;
+        ib += cbLiteral;
+
+        if ( ib >= cbWanted )
+        {
+            break;
+        }
+
+        if ( pbInMax - pbIn < sizeof( WORD ) )
+        {
+            Error( ErrERRCheck( JET_errDecompressionFailed ) );
+        }
+        const INT ibOffset = *(UnalignedLittleEndian<WORD> *)pbIn;
+        pbIn += sizeof( WORD );
+
+        INT cbMatch = bToken & 0xF;
+        if ( 0xF == cbMatch )
+        {
+            Call( ErrPKIReadLength( &pbIn, pbInMax, &cbMatch ) );
+        }
+        cbMatch += cbPKDictionaryMatchMin;
+
+        if ( 0 == ibOffset || ibOffset > cbDict + ib || cbMatch > cbUncompressed - ib )
+        {
+            Error( ErrERRCheck( JET_errDecompressionFailed ) );
+        }
+
+        const INT cbCopy = min( cbMatch, cbWanted - ib );
+        INT iposSrc = cbDict + ib - ibOffset;
+        INT ibCopy = 0;
+        for ( ; ibCopy < cbCopy && iposSrc < cbDict; ibCopy++, iposSrc++ )
+        {
+            pbData[ ib + ibCopy ] = pdictT->pb[ iposSrc ];
+        }
+        for ( const BYTE * pbSrc = pbData + iposSrc - cbDict; ibCopy < cbCopy; ibCopy++ )
+        {
+            pbData[ ib + ibCopy ] = *pbSrc++;
+        }
+        ib += cbCopy;
+    }
+
+    if ( cbUncompressed > cbDataMax )
+    {
+        err = ErrERRCheck( JET_wrnBufferTruncated );
+    }
+
+HandleError:
+    if ( err >= JET_errSuccess )
+    {
+        PERFOpt( pstats->AddDecompressionBytes( cbWanted ) );
+        PERFOpt( pstats->IncDecompressionCalls() );
+        PERFOpt( pstats->AddDecompressionDhrts( HrtHRTCount() - hrtStart ) );
+    }
+
+    return err;
+}
+
 ERR CDataCompressor::ErrCompress(
     const DATA& data,
     const CompressFlags compressFlags,
     IDataCompressorStats * const pstats,
     _Out_writes_bytes_to_opt_( cbDataCompressedMax, *pcbDataCompressedActual ) BYTE * const pbDataCompressed,
     const INT cbDataCompressedMax,
-    _Out_ INT * const pcbDataCompressedActual )
+    _Out_ INT * const pcbDataCompressedActual,
+    const PKDICTIONARY * const pdict )
 {
     ERR err = JET_errSuccess;
     BOOL fCompressed = fFalse;
 
     Assert( 0 != compressFlags );
 
+    if ( pdict && ( compressFlags & compressXpress ) && data.Cb() >= cbDictionaryCompressMin && data.Cb() <= wMax )
+    {
+        err = ErrCompressDictionary_( data, pdict, pbDataCompressed, cbDataCompressedMax, pcbDataCompressedActual, pstats );
+        if ( err == JET_errSuccess )
+        {
+            return JET_errSuccess;
+        }
+        if ( err != errRECCannotCompress && err != JET_errOutOfMemory )
+        {
+            return err;
+        }
+        err = JET_errSuccess;
+    }
+
     if ( data.Cb() >= m_cbMin )
     {
 #ifdef XPRESS10_COMPRESSION
@@ -2126,12 +2535,18 @@ Try7bitCompression:
     return ErrERRCheck( errRECCannotCompress );
 }
 
+BOOL CDataCompressor::FCompressedWithDictionary( const DATA& dataCompressed )
+{
+    return dataCompressed.Cb() > 0 && ( *(BYTE *)dataCompressed.Pv() >> 3 ) == COMPRESS_DICTIONARY;
+}
+
 ERR CDataCompressor::ErrDecompress(
     const DATA& dataCompressed,
     IDataCompressorStats * const pstats,
     _Out_writes_bytes_to_opt_( cbDataMax, min( cbDataMax, *pcbDataActual ) ) BYTE * const pbData,
     const INT cbDataMax,
-    _Out_ INT * const pcbDataActual )
+    _Out_ INT * const pcbDataActual,
+    const PKDICTIONARY * const pdict )
 {
     ERR err = JET_errSuccess;
     BOOL fUnused = fFalse;
@@ -2167,6 +2582,9 @@ ERR CDataCompressor::ErrDecompress(
             Call( ErrDecompressXpress10_( dataCompressed, pbData, cbDataMax, pcbDataActual, pstats, fFalse, &fUnused ) );
             break;
 #endif
+        case COMPRESS_DICTIONARY:
+            Call( ErrDecompressDictionary_( dataCompressed, pdict, pbData, cbDataMax, pcbDataActual, pstats ) );
+            break;
         default:
             *pcbDataActual = 0;
             Call( ErrERRCheck( JET_errDecompressionFailed ) );
@@ -2200,6 +2618,8 @@ ERR CDataCompressor::ErrInit( const INT cbMin, const INT cbMax )
     Assert( m_rgdecodeXpress == NULL );
     Alloc( m_rgencodeXpress = new XpressEncodeStream[ m_cencodeCachedMax ]() );
     Alloc( m_rgdecodeXpress = new XpressDecodeStream[ m_cdecodeCachedMax ]() );
+    Assert( m_rgpencodeDictionary == NULL );
+    Alloc( m_rgpencodeDictionary = new DictionaryEncode*[ m_cencodeCachedMax ]() );
 
 #ifdef XPRESS9_COMPRESSION
     Assert( m_rgencodeXpress9 == NULL );
@@ -2215,6 +2635,8 @@ HandleError:
     m_rgencodeXpress = NULL;
     delete[] m_rgdecodeXpress;
     m_rgdecodeXpress = NULL;
+    delete[] m_rgpencodeDictionary;
+    m_rgpencodeDictionary = NULL;
 #ifdef XPRESS9_COMPRESSION
     delete[] m_rgencodeXpress9;
     m_rgencodeXpress9 = NULL;
@@ -2234,6 +2656,11 @@ void CDataCompressor::Term()
             XpressEncodeRelease_( m_rgencodeXpress[iencode] );
             m_rgencodeXpress[iencode] = 0;
         }
+        if ( m_rgpencodeDictionary != NULL )
+        {
+            delete m_rgpencodeDictionary[iencode];
+            m_rgpencodeDictionary[iencode] = NULL;
+        }
 #ifdef XPRESS9_COMPRESSION
         if ( m_rgencodeXpress9 != NULL && m_rgencodeXpress9[iencode] != NULL )
         {
@@ -2262,6 +2689,8 @@ void CDataCompressor::Term()
     m_rgencodeXpress = NULL;
     delete[] m_rgdecodeXpress;
     m_rgdecodeXpress = NULL;
+    delete[] m_rgpencodeDictionary;
+    m_rgpencodeDictionary = NULL;
 #ifdef XPRESS9_COMPRESSION
     delete[] m_rgencodeXpress9;
     m_rgencodeXpress9 = NULL;
@@ -2289,21 +2718,279 @@ ERR ErrPKCompressData(
     _Out_writes_bytes_to_( cbDataCompressedMax, *pcbDataCompressedActual ) BYTE * const pbDataCompressed,
     const INT cbDataCompressedMax,
     _Out_ INT * const pcbDataCompressedActual )
+{
+    return ErrPKCompressData( data, compressFlags, pinst, NULL, pbDataCompressed, cbDataCompressedMax, pcbDataCompressedActual );
+}
+
+ERR ErrPKCompressData(
+    const DATA& data,
+    const CompressFlags compressFlags,
+    const INST* const pinst,
+    const PKDICTIONARY * const pdict,
+    _Out_writes_bytes_to_( cbDataCompressedMax, *pcbDataCompressedActual ) BYTE * const pbDataCompressed,
+    const INT cbDataCompressedMax,
+    _Out_ INT * const pcbDataCompressedActual )
 {
     CDataCompressorPerfCounters perfcounters( pinst ? pinst->m_iInstance : 0 );
     
-    return g_dataCompressor.ErrCompress( data, compressFlags, &perfcounters, pbDataCompressed, cbDataCompressedMax, pcbDataCompressedActual );
+    return g_dataCompressor.ErrCompress( data, compressFlags, &perfcounters, pbDataCompressed, cbDataCompressedMax, pcbDataCompressedActual, pdict );
+}
+
+const INT cbitPKIDmerHash = 16;
+const INT cPKIDmerHash = 1 << cbitPKIDmerHash;
+
+INLINE ULONG IPKIDmerHash( const BYTE * const pb )
+{
+    const QWORD qw = *(UnalignedLittleEndian<QWORD> *)pb;
+    return (ULONG)( ( qw * 0xCF1BBCDCB7A56463ULL ) >> ( 64 - cbitPKIDmerHash ) );
+}
+
+ERR ErrPKTrainDictionary(
+    _In_reads_( cdataSample ) const DATA * const rgdataSample,
+    const INT cdataSample,
+    _Out_writes_bytes_to_( cbDictionaryMax, *pcbDictionary ) BYTE * const pbDictionary,
+    const INT cbDictionaryMax,
+    _Out_ INT * const pcbDictionary )
+{
+    const INT cbSegment = 64;
+    const INT cbDmer = sizeof( QWORD );
+
+    ERR err = JET_errSuccess;
+    BYTE * pbSamples = NULL;
+    WORD * rgcDmer = NULL;
+    INT cbSamples = 0;
+
+    *pcbDictionary = 0;
+
+    Assert( cbDictionaryMax <= cbPKDictionaryMax );
+
+    for ( INT idata = 0; idata < cdataSample; idata++ )
+    {
+        cbSamples += rgdataSample[ idata ].Cb();
+    }
+
+    if ( cbSamples < 2 * cbSegment || cbDictionaryMax < cbSegment )
+    {
+        return JET_errSuccess;
+    }
+
+    Alloc( pbSamples = new BYTE[ cbSamples ] );
+    Alloc( rgcDmer = new WORD[ cPKIDmerHash ] );
+    memset( rgcDmer, 0, sizeof( WORD ) * cPKIDmerHash );
+
+    cbSamples = 0;
+    for ( INT idata = 0; idata < cdataSample; idata++ )
+    {
+        UtilMemCpy( pbSamples + cbSamples, rgdataSample[ idata ].Pv(), rgdataSample[ idata ].Cb() );
+        cbSamples += rgdataSample[ idata ].Cb();
+    }
+
+    const INT cdmer = cbSamples - cbDmer + 1;
+    for ( INT ib = 0; ib < cdmer; ib++ )
+    {
+        WORD * const pc = &rgcDmer[ IPKIDmerHash( pbSamples + ib ) ];
+        if ( *pc < wMax )
+        {
+            (*pc)++;
+        }
+    }
+
+    const INT cepoch = max( 1, min( cbDictionaryMax / cbSegment, cbSamples / cbSegment ) );
+    const INT cbEpoch = cbSamples / cepoch;
+    INT ibDictionary = cbDictionaryMax;
+
+    for ( INT iepoch = 0; iepoch < cepoch && ibDictionary >= cbSegment; iepoch++ )
+    {
+        const INT ibEpochMin = iepoch * cbEpoch;
+        const INT ibEpochMax = min( ibEpochMin + cbEpoch, cdmer ) - cbSegment;
+        if ( ibEpochMax <= ibEpochMin )
+        {
+            continue;
+        }
+
+        QWORD cScore = 0;
+        for ( INT ib = ibEpochMin; ib < ibEpochMin + cbSegment; ib++ )
+        {
+            cScore += rgcDmer[ IPKIDmerHash( pbSamples + ib ) ];
+        }
+
+        QWORD cScoreBest = cScore;
+        INT ibBest = ibEpochMin;
+        for ( INT ib = ibEpochMin + 1; ib <= ibEpochMax; ib++ )
+        {
+            cScore -= rgcDmer[ IPKIDmerHash( pbSamples + ib - 1 ) ];
+            cScore += rgcDmer[ IPKIDmerHash( pbSamples + ib + cbSegment - 1 ) ];
+            if ( cScore > cScoreBest )
+            {
+                cScoreBest = cScore;
+                ibBest = ib;
+            }
+        }
+
+        if ( cScoreBest <= cbSegment )
+        {
+            continue;
+        }
+
+        for ( INT ib = ibBest; ib < ibBest + cbSegment; ib++ )
+        {
+            rgcDmer[ IPKIDmerHash( pbSamples + ib ) ] = 0;
+        }
+
+        ibDictionary -= cbSegment;
+        UtilMemCpy( pbDictionary + ibDictionary, pbSamples + ibBest, cbSegment );
+    }
+
+    *pcbDictionary = cbDictionaryMax - ibDictionary;
+    memmove( pbDictionary, pbDictionary + ibDictionary, *pcbDictionary );
+
+HandleError:
+    delete[] rgcDmer;
+    delete[] pbSamples;
+    return err;
+}
+
+ERR ErrPKCreateDictionary(
+    const BYTE idDictionary,
+    const DATA& dataDictionary,
+    PKDICTIONARY * const pdictPrev,
+    _Out_ PKDICTIONARY ** const ppdict )
+{
+    ERR err = JET_errSuccess;
+    PKDICTIONARY * pdict = NULL;
+
+    *ppdict = NULL;
+
+    if ( dataDictionary.Cb() < cbPKDictionaryMatchMin || dataDictionary.Cb() > cbPKDictionaryMax )
+    {
+        Error( ErrERRCheck( JET_errInvalidParameter ) );
+    }
+
+    Alloc( pdict = new PKDICTIONARY );
+    pdict->pdictPrev = NULL;
+    pdict->idDictionary = idDictionary;
+    pdict->cb = dataDictionary.Cb();
+    Alloc( pdict->pb = new BYTE[ pdict->cb ] );
+    UtilMemCpy( pdict->pb, dataDictionary.Pv(), pdict->cb );
+
+    memset( pdict->rgiHash, 0xFF, sizeof( pdict->rgiHash ) );
+    for ( INT ib = 0; ib + cbPKDictionaryMatchMin <= pdict->cb; ib++ )
+    {
+        pdict->rgiHash[ UlPKIDictionaryHash( pdict->pb + ib ) ] = ib;
+    }
+
+    pdict->pdictPrev = pdictPrev;
+    *ppdict = pdict;
+    pdict = NULL;
+
+HandleError:
+    PKDeleteDictionaries( pdict );
+    return err;
+}
+
+BOOL FPKCompressedWithDictionary( const DATA& dataCompressed )
+{
+    return CDataCompressor::FCompressedWithDictionary( dataCompressed );
+}
+
+VOID PKLinkDictionary( PKDICTIONARY * const pdict, PKDICTIONARY * const pdictPrev )
+{
+    Assert( NULL == pdict->pdictPrev );
+    pdict->pdictPrev = pdictPrev;
+}
+
+VOID PKDeleteDictionaries( PKDICTIONARY * pdict )
+{
+    while ( pdict )
+    {
+        PKDICTIONARY * const pdictPrev = pdict->pdictPrev;
+        delete[] pdict->pb;
+        delete pdict;
+        pdict = pdictPrev;
+    }
+}
+
+LOCAL VOID PKICompressReq( const CompressFlags compressFlags, const INST* const pinst, PKCOMPRESSREQ * const preq )
+{
+    preq->pbDataCompressed = PbPKAllocCompressionBuffer();
+    preq->cbDataCompressedActual = 0;
+
+    if ( NULL == preq->pbDataCompressed )
+    {
+        preq->err = ErrERRCheck( JET_errOutOfMemory );
+        return;
+    }
+
+    preq->err = ErrPKCompressData(
+                    preq->data,
+                    compressFlags,
+                    pinst,
+                    preq->pbDataCompressed,
+                    CbPKCompressionBuffer(),
+                    &preq->cbDataCompressedActual );
+
+    if ( preq->err < JET_errSuccess || preq->cbDataCompressedActual >= preq->data.Cb() )
+    {
+        PKFreeCompressionBuffer( preq->pbDataCompressed );
+        preq->pbDataCompressed = NULL;
+        preq->cbDataCompressedActual = 0;
+    }
+}
+
+struct PKCOMPRESSJOBS
+{
+    CompressFlags       compressFlags;
+    const INST *        pinst;
+    PKCOMPRESSREQ *     rgreq;
+};
+
+LOCAL VOID PKICompressJob( VOID * const pvJobs, const LONG ireq )
+{
+    const PKCOMPRESSJOBS * const pjobs = (PKCOMPRESSJOBS *)pvJobs;
+    PKICompressReq( pjobs->compressFlags, pjobs->pinst, &pjobs->rgreq[ ireq ] );
+}
+
+VOID PKCompressDataParallel(
+    CGPTaskManager * const ptaskmgr,
+    const CompressFlags compressFlags,
+    const INST* const pinst,
+    _Inout_updates_( creq ) PKCOMPRESSREQ * const rgreq,
+    const INT creq )
+{
+    PKCOMPRESSJOBS jobs;
+    jobs.compressFlags  = compressFlags;
+    jobs.pinst          = pinst;
+    jobs.rgreq          = rgreq;
+
+    TMRunJobs( ptaskmgr, OSSyncGetProcessorCount(), PKICompressJob, &jobs, creq );
 }
 
 ERR ErrPKIDecompressData(
     const DATA& dataCompressed,
     const INST* const pinst,
+    const PKDICTIONARY * const pdict,
     _Out_writes_bytes_to_opt_( cbDataMax, min( cbDataMax, *pcbDataActual ) ) BYTE * const pbData,
     const INT cbDataMax,
     _Out_ INT * const pcbDataActual )
 {
     CDataCompressorPerfCounters perfcounters( pinst ? pinst->m_iInstance : 0 );
-    return g_dataCompressor.ErrDecompress( dataCompressed, &perfcounters, pbData, cbDataMax, pcbDataActual );
+    return g_dataCompressor.ErrDecompress( dataCompressed, &perfcounters, pbData, cbDataMax, pcbDataActual, pdict );
+}
+
+LOCAL const PKDICTIONARY * PdictPKIFromPfucb( const FUCB * const pfucb )
+{
+    if ( NULL == pfucb )
+    {
+        return NULL;
+    }
+
+    const FCB * pfcb = pfucb->u.pfcb;
+    if ( pfcb->FTypeLV() || pfcb->FTypeSecondaryIndex() )
+    {
+        pfcb = pfcb->PfcbTable();
+    }
+
+    return ( pfcb && pfcb->Ptdb() ) ? pfcb->Ptdb()->PdictCompression() : NULL;
 }
 
 VOID PKIReportDecompressionFailed(
@@ -2356,9 +3043,14 @@ ERR ErrPKDecompressData(
     const INT cbDataMax,
     _Out_ INT * const pcbDataActual )
 {
+    //  without a cursor there is no table to find a compression dictionary in, so callers that
+    //  have none must skip such values rather than report them as corrupt
+    Assert( NULL != pfucb || !FPKCompressedWithDictionary( dataCompressed ) );
+
     const ERR err = ErrPKIDecompressData(
             dataCompressed,
             pfucb ? PinstFromPfucb( pfucb ) : NULL,
+            PdictPKIFromPfucb( pfucb ),
             pbData,
             cbDataMax,
             pcbDataActual );
@@ -2385,6 +3077,7 @@ ERR ErrPKDecompressData(
     const ERR err = ErrPKIDecompressData(
             dataCompressed,
             ( ifmp != ifmpNil ) ? PinstFromIfmp( ifmp ) : NULL,
+            NULL,
             pbData,
             cbDataMax,
             pcbDataActual );
@@ -2690,6 +3383,84 @@ JETUNITTEST( CDataCompressor, Xpress10FallbackXpress )
 }
 #endif
 
+JETUNITTEST( CDataCompressor, ParallelChunkCompressThroughput )
+{
+    const INT cbChunk = 8 * 1024;
+    const INT cchunk = 512;
+    const INT cbLV = cbChunk * cchunk;
+
+    CompressFlags compressFlags = compressXpress;
+#ifdef XPRESS9_COMPRESSION
+    compressFlags = compressXpress9;
+#endif
+
+    CHECK( JET_errSuccess == ErrPKInitCompression( 32*1024, 1024, 32*1024 ) );
+
+    CGPTaskManager taskmgr;
+    CHECK( JET_errSuccess == taskmgr.ErrTMInit() );
+
+    BYTE * const pbLV = new BYTE[ cbLV ];
+    PKCOMPRESSREQ * const rgreqSerial = new PKCOMPRESSREQ[ cchunk ];
+    PKCOMPRESSREQ * const rgreqParallel = new PKCOMPRESSREQ[ cchunk ];
+    CHECK( NULL != pbLV );
+    CHECK( NULL != rgreqSerial );
+    CHECK( NULL != rgreqParallel );
+
+    const CHAR * const rgszWord[] = { "mailbox ", "message ", "attachment ", "folder ", "property ", "recipient ", "subject ", "body " };
+    ULONG ulSeed = 0x5eed;
+    for ( INT ib = 0; ib < cbLV; )
+    {
+        ulSeed = ulSeed * 1103515245 + 12345;
+        const CHAR * const szWord = rgszWord[ ( ulSeed >> 16 ) % _countof( rgszWord ) ];
+        for ( INT ich = 0; szWord[ ich ] && ib < cbLV; ich++, ib++ )
+        {
+            pbLV[ ib ] = (BYTE)szWord[ ich ];
+        }
+        if ( ib < cbLV && ( ulSeed & 0x7 ) == 0 )
+        {
+            pbLV[ ib++ ] = (BYTE)( ulSeed >> 24 );
+        }
+    }
+
+    for ( INT ichunk = 0; ichunk < cchunk; ichunk++ )
+    {
+        rgreqSerial[ ichunk ].data.SetPv( pbLV + ichunk * cbChunk );
+        rgreqSerial[ ichunk ].data.SetCb( cbChunk );
+        rgreqParallel[ ichunk ] = rgreqSerial[ ichunk ];
+    }
+
+    const HRT hrtSerialStart = HrtHRTCount();
+    PKCompressDataParallel( NULL, compressFlags, NULL, rgreqSerial, cchunk );
+    const QWORD cusecSerial = CusecHRTFromDhrt( HrtHRTCount() - hrtSerialStart );
+
+    const HRT hrtParallelStart = HrtHRTCount();
+    PKCompressDataParallel( &taskmgr, compressFlags, NULL, rgreqParallel, cchunk );
+    const QWORD cusecParallel = CusecHRTFromDhrt( HrtHRTCount() - hrtParallelStart );
+
+    for ( INT ichunk = 0; ichunk < cchunk; ichunk++ )
+    {
+        CHECK( rgreqSerial[ ichunk ].err == rgreqParallel[ ichunk ].err );
+        CHECK( rgreqSerial[ ichunk ].cbDataCompressedActual == rgreqParallel[ ichunk ].cbDataCompressedActual );
+        CHECK( ( NULL == rgreqSerial[ ichunk ].pbDataCompressed ) == ( NULL == rgreqParallel[ ichunk ].pbDataCompressed ) );
+        if ( rgreqSerial[ ichunk ].pbDataCompressed )
+        {
+            CHECK( 0 == memcmp( rgreqSerial[ ichunk ].pbDataCompressed, rgreqParallel[ ichunk ].pbDataCompressed, rgreqSerial[ ichunk ].cbDataCompressedActual ) );
+        }
+        PKFreeCompressionBuffer( rgreqSerial[ ichunk ].pbDataCompressed );
+        PKFreeCompressionBuffer( rgreqParallel[ ichunk ].pbDataCompressed );
+    }
+
+    REPORTMETRIC( "serial", (QWORD)cbLV / max( cusecSerial, (QWORD)1 ), "MB/s" );
+    REPORTMETRIC( "parallel", (QWORD)cbLV / max( cusecParallel, (QWORD)1 ), "MB/s" );
+
+    delete[] rgreqParallel;
+    delete[] rgreqSerial;
+    delete[] pbLV;
+
+    taskmgr.TMTerm();
+    PKTermCompression();
+}
+
 JETUNITTEST( CDataCompressor, XpressThreshold )
 {
     CDataCompressor compressor;
@@ -2720,6 +3491,226 @@ JETUNITTEST( CDataCompressor, XpressThreshold )
     compressor.Term();
 }
 
+JETUNITTEST( CDataCompressor, DictionaryRoundTrip )
+{
+    CDataCompressor compressor;
+    TestCompressorStats stats;
+
+    const INT csample = 256;
+    const INT cbSampleMax = 256;
+    const INT cbDictionaryMax = 4096;
+
+    ERR err;
+    CHAR rgchSamples[csample][cbSampleMax];
+    DATA rgdataSample[csample];
+    BYTE rgbDictionary[cbDictionaryMax];
+    BYTE rgbBufCompressed[cbSampleMax];
+    BYTE rgbBufDecompressed[cbSampleMax];
+    INT cbDictionary;
+    INT cbDataActual;
+    PKDICTIONARY * pdict = NULL;
+
+    CHECK( JET_errSuccess == compressor.ErrInit( 1024, 8192 ) );
+
+    for ( INT isample = 0; isample < csample; isample++ )
+    {
+        OSStrCbFormatA(
+            rgchSamples[isample],
+            cbSampleMax,
+            "{\"customerId\":%d,\"status\":\"%s\",\"region\":\"north-america\",\"priority\":%d,\"tags\":[\"retail\",\"online\"]}",
+            isample * 7919,
+            ( isample % 3 ) ? "active" : "suspended",
+            isample % 5 );
+        rgdataSample[isample].SetPv( rgchSamples[isample] );
+        rgdataSample[isample].SetCb( (INT)strlen( rgchSamples[isample] ) );
+    }
+
+    CHECK( JET_errSuccess == ErrPKTrainDictionary( rgdataSample, csample, rgbDictionary, sizeof(rgbDictionary), &cbDictionary ) );
+    CHECK( cbDictionary > 0 );
+    CHECK( cbDictionary <= cbDictionaryMax );
+
+    DATA dataDictionary;
+    dataDictionary.SetPv( rgbDictionary );
+    dataDictionary.SetCb( cbDictionary );
+    CHECK( JET_errSuccess == ErrPKCreateDictionary( 1, dataDictionary, NULL, &pdict ) );
+
+    for ( INT isample = 0; isample < csample; isample += 17 )
+    {
+        const DATA& data = rgdataSample[isample];
+
+        err = compressor.ErrCompress( data, compressXpress, &stats, rgbBufCompressed, sizeof(rgbBufCompressed), &cbDataActual, pdict );
+        CHECK( JET_errSuccess == err );
+        CHECK( cbDataActual < data.Cb() );
+        CHECK( ( rgbBufCompressed[0] >> 3 ) == 0x7 );
+
+        DATA dataCompressed;
+        dataCompressed.SetPv( rgbBufCompressed );
+        dataCompressed.SetCb( cbDataActual );
+        CHECK( FPKCompressedWithDictionary( dataCompressed ) );
+
+        err = compressor.ErrDecompress( dataCompressed, &stats, NULL, 0, &cbDataActual, pdict );
+        CHECK( JET_wrnBufferTruncated == err );
+        CHECK( data.Cb() == cbDataActual );
+
+        err = compressor.ErrDecompress( dataCompressed, &stats, rgbBufDecompressed, sizeof(rgbBufDecompressed), &cbDataActual, pdict );
+        CHECK( JET_errSuccess == err );
+        CHECK( data.Cb() == cbDataActual );
+        CHECK( 0 == memcmp( data.Pv(), rgbBufDecompressed, data.Cb() ) );
+
+        memset( rgbBufDecompressed, 0, sizeof(rgbBufDecompressed) );
+        err = compressor.ErrDecompress( dataCompressed, &stats, rgbBufDecompressed, 20, &cbDataActual, pdict );
+        CHECK( JET_wrnBufferTruncated == err );
+        CHECK( data.Cb() == cbDataActual );
+        CHECK( 0 == memcmp( data.Pv(), rgbBufDecompressed, 20 ) );
+        CHECK( 0 == rgbBufDecompressed[20] );
+
+        err = compressor.ErrDecompress( dataCompressed, &stats, rgbBufDecompressed, sizeof(rgbBufDecompressed), &cbDataActual, NULL );
+        CHECK( JET_errDecompressionFailed == err );
+    }
+
+    PKDeleteDictionaries( pdict );
+    compressor.Term();
+}
+
+LOCAL INT CchPKITestDictionaryRecord( const LONG irec, _Out_writes_( cchMax ) CHAR * const sz, const INT cchMax )
+{
+    OSStrCbFormatA(
+        sz,
+        cchMax,
+        "{\"customerId\":%d,\"status\":\"%s\",\"region\":\"north-america\",\"priority\":%d,\"tags\":[\"retail\",\"online\"]}",
+        irec * 7919,
+        ( irec % 3 ) ? "active" : "suspended",
+        irec % 5 );
+    return (INT)strlen( sz );
+}
+
+LOCAL ERR ErrPKITestInsertDictionaryRecords(
+    const JET_SESID     sesid,
+    const JET_TABLEID   tableid,
+    const JET_COLUMNID  columnidData,
+    const LONG          irecFirst,
+    const LONG          crec )
+{
+    ERR     err;
+    CHAR    szData[ 256 ];
+
+    for ( LONG irec = irecFirst; irec < irecFirst + crec; irec++ )
+    {
+        const INT cbData = CchPKITestDictionaryRecord( irec, szData, sizeof( szData ) );
+
+        Call( JetBeginTransaction( sesid ) );
+        Call( JetPrepareUpdate( sesid, tableid, JET_prepInsert ) );
+        Call( JetSetColumn( sesid, tableid, columnidData, szData, cbData, NO_GRBIT, NULL ) );
+        Call( JetUpdate( sesid, tableid, NULL, 0, NULL ) );
+        Call( JetCommitTransaction( sesid, JET_bitCommitLazyFlush ) );
+    }
+
+HandleError:
+    return err;
+}
+
+//  Values written after training are compressed with the table's dictionary; compaction must
+//  carry the dictionary over with its id or those values become undecodable.
+
+JETUNITTEST( CDataCompressor, DictionaryCompactRoundTrip )
+{
+    const LONG          crec                = 256;
+    const WCHAR * const wszDatabaseDest     = L".\\PKDictionaryCompact\\PKDictionaryCompactDest.edb";
+    const ULONG         cbDictionaryMax     = 4096;
+
+    JetTestDatabase     db;
+    JET_TABLEID         tableid             = JET_tableidNil;
+    JET_DBID            dbid                = JET_dbidNil;
+    JET_COLUMNDEF       columndef           = { sizeof( JET_COLUMNDEF ), 0, JET_coltypLong, 0, 0, 0, 0, 0, JET_bitColumnAutoincrement };
+    JET_COLUMNID        columnidKey         = JET_columnidNil;
+    JET_COLUMNID        columnidData        = JET_columnidNil;
+    CHAR                szExpected[ 256 ];
+    CHAR                szActual[ 256 ];
+    ULONG               cbActual;
+    LONG                lKey;
+    LONG                crecSeen            = 0;
+    ERR                 err;
+
+    CHECKCALLS( db.ErrCreateInstance( L"PKDictionaryCompact" ) );
+    CHECKCALLS( db.ErrSetParam( JET_paramEngineFormatVersion, JET_efvCompressionDictionaries ) );
+    CHECKCALLS( db.ErrInit() );
+    const JET_SESID sesid = db.Sesid();
+
+    CHECKCALLS( JetCreateTableA( sesid, db.Dbid(), "PKDictionary", 16, 100, &tableid ) );
+    CHECKCALLS( JetAddColumnA( sesid, tableid, "Key", &columndef, NULL, 0, &columnidKey ) );
+    columndef.coltyp = JET_coltypLongBinary;
+    columndef.grbit = JET_bitColumnTagged | JET_bitColumnCompressed;
+    CHECKCALLS( JetAddColumnA( sesid, tableid, "Data", &columndef, NULL, 0, &columnidData ) );
+    CHECKCALLS( JetCreateIndexA( sesid, tableid, "Primary", JET_bitIndexPrimary, "+Key\0", 6, 100 ) );
+
+    CHECKCALLS( ErrPKITestInsertDictionaryRecords( sesid, tableid, columnidData, 0, crec ) );
+    CHECKCALLS( JetSetTableInfoA( sesid, tableid, &cbDictionaryMax, sizeof( cbDictionaryMax ), JET_TblInfoCompressionDictionary ) );
+    CHECK( NULL != ( (FUCB *)tableid )->u.pfcb->Ptdb()->PdictCompression() );
+    CHECKCALLS( ErrPKITestInsertDictionaryRecords( sesid, tableid, columnidData, crec, crec ) );
+
+    CHECKCALLS( JetCloseTable( sesid, tableid ) );
+    CHECKCALLS( JetCloseDatabase( sesid, db.Dbid(), NO_GRBIT ) );
+    CHECKCALLS( JetDetachDatabaseW( sesid, db.WszDatabase() ) );
+    CHECKCALLS( JetAttachDatabase2W( sesid, db.WszDatabase(), 0, JET_bitDbReadOnly ) );
+    CHECKCALLS( JetCompactW( sesid, db.WszDatabase(), wszDatabaseDest, NULL, NULL, NO_GRBIT ) );
+    CHECKCALLS( JetDetachDatabaseW( sesid, db.WszDatabase() ) );
+
+    CHECKCALLS( JetAttachDatabaseW( sesid, wszDatabaseDest, NO_GRBIT ) );
+    CHECKCALLS( JetOpenDatabaseW( sesid, wszDatabaseDest, NULL, &dbid, NO_GRBIT ) );
+    CHECKCALLS( JetOpenTableA( sesid, dbid, "PKDictionary", NULL, 0, NO_GRBIT, &tableid ) );
+    CHECK( NULL != ( (FUCB *)tableid )->u.pfcb->Ptdb()->PdictCompression() );
+
+    for ( err = JetMove( sesid, tableid, JET_MoveFirst, NO_GRBIT );
+          JET_errSuccess == err;
+          err = JetMove( sesid, tableid, JET_MoveNext, NO_GRBIT ) )
+    {
+        CHECKCALLS( JetRetrieveColumn( sesid, tableid, columnidKey, &lKey, sizeof( lKey ), &cbActual, NO_GRBIT, NULL ) );
+        CHECKCALLS( JetRetrieveColumn( sesid, tableid, columnidData, szActual, sizeof( szActual ), &cbActual, NO_GRBIT, NULL ) );
+
+        const INT cbExpected = CchPKITestDictionaryRecord( lKey - 1, szExpected, sizeof( szExpected ) );
+        CHECK( (ULONG)cbExpected == cbActual );
+        CHECK( 0 == memcmp( szExpected, szActual, cbExpected ) );
+        crecSeen++;
+    }
+    CHECK( JET_errNoCurrentRecord == err );
+    CHECK( 2 * crec == crecSeen );
+
+    CHECKCALLS( JetCloseTable( sesid, tableid ) );
+    CHECKCALLS( JetCloseDatabase( sesid, dbid, NO_GRBIT ) );
+    CHECKCALLS( JetDetachDatabaseW( sesid, wszDatabaseDest ) );
+    CHECKCALLS( db.ErrTerm() );
+}
+
+JETUNITTEST( CDataCompressor, DictionaryLimit )
+{
+    const ULONG         cbDictionaryMax     = 1024;
+
+    JetTestDatabase     db;
+    JET_TABLEID         tableid             = JET_tableidNil;
+    JET_COLUMNDEF       columndef           = { sizeof( JET_COLUMNDEF ), 0, JET_coltypLongBinary, 0, 0, 0, 0, 0, JET_bitColumnTagged | JET_bitColumnCompressed };
+    JET_COLUMNID        columnidData        = JET_columnidNil;
+
+    CHECKCALLS( db.ErrCreateInstance( L"PKDictionaryLimit" ) );
+    CHECKCALLS( db.ErrSetParam( JET_paramEngineFormatVersion, JET_efvCompressionDictionaries ) );
+    CHECKCALLS( db.ErrInit() );
+    const JET_SESID sesid = db.Sesid();
+
+    CHECKCALLS( JetCreateTableA( sesid, db.Dbid(), "PKDictionary", 16, 100, &tableid ) );
+    CHECKCALLS( JetAddColumnA( sesid, tableid, "Data", &columndef, NULL, 0, &columnidData ) );
+    CHECKCALLS( ErrPKITestInsertDictionaryRecords( sesid, tableid, columnidData, 0, 64 ) );
+
+    for ( INT idict = 0; idict < cPKDictionaryMax; idict++ )
+    {
+        CHECKCALLS( JetSetTableInfoA( sesid, tableid, &cbDictionaryMax, sizeof( cbDictionaryMax ), JET_TblInfoCompressionDictionary ) );
+    }
+    CHECK( JET_errCompressionDictionaryLimit == JetSetTableInfoA( sesid, tableid, &cbDictionaryMax, sizeof( cbDictionaryMax ), JET_TblInfoCompressionDictionary ) );
+
+    CHECKCALLS( ErrPKITestInsertDictionaryRecords( sesid, tableid, columnidData, 64, 64 ) );
+
+    CHECKCALLS( JetCloseTable( sesid, tableid ) );
+    CHECKCALLS( db.ErrTerm() );
+}
+
 JETUNITTEST( CDataCompressor, Scrub )
 {
     CDataCompressor compressor;
@@ -101,6 +101,8 @@ public:
 
     virtual CPG CpgBatch() = 0;
 
+    virtual INT CReaders() = 0;
+
     virtual DWORD   DwThrottleSleep() = 0;
 
     virtual bool    FSerializeScan() = 0;
@@ -134,6 +136,8 @@ public:
 
     virtual PGNO PgnoLast() const = 0;
 
+    virtual ERR ErrCloneDBMScanReader( __out IDBMScanReader ** const ppscanreader ) = 0;
+
     enum
     {
         cpgPrereadMax = cbReadSizeMax / g_cbPageMin
@@ -156,6 +160,45 @@ struct DBMScanStats
         CPG m_cpgRecPagesScanned;
 };
 
+const INT cdbmscanRangesMax = 16;
+
+PERSISTED struct DBMScanRanges
+{
+    LONG    cRanges;
+    PGNO    rgpgnoFirst[ cdbmscanRangesMax ];
+    PGNO    rgpgnoNext[ cdbmscanRangesMax ];
+};
+
+//  Each range is read in page order, so the highest page checked is the furthest any range
+//  has got and the continuous watermark runs through every range that has been completed.
+
+INLINE PGNO PgnoDBMScanRangesHighestChecked( const DBMScanRanges& ranges )
+{
+    PGNO pgnoHighest = 0;
+    for ( INT irange = 0; irange < ranges.cRanges; irange++ )
+    {
+        if ( ranges.rgpgnoNext[irange] > ranges.rgpgnoFirst[irange] )
+        {
+            pgnoHighest = max( pgnoHighest, ranges.rgpgnoNext[irange] - 1 );
+        }
+    }
+    return pgnoHighest;
+}
+
+INLINE PGNO PgnoDBMScanRangesContinuousHighWatermark( const DBMScanRanges& ranges )
+{
+    PGNO pgnoContinuous = 0;
+    for ( INT irange = 0; irange < ranges.cRanges && ranges.rgpgnoFirst[irange] == pgnoContinuous + 1; irange++ )
+    {
+        pgnoContinuous = ranges.rgpgnoNext[irange] - 1;
+        if ( irange + 1 < ranges.cRanges && ranges.rgpgnoNext[irange] < ranges.rgpgnoFirst[irange + 1] )
+        {
+            break;
+        }
+    }
+    return pgnoContinuous;
+}
+
 class IDBMScanState
 {
 public:
@@ -179,6 +222,11 @@ public:
     virtual void BadChecksum( const PGNO pgnoBadChecksum ) = 0;
     virtual void CalculatePageLevelStats( const CPAGE& cpage ) = 0;
 
+    virtual bool FSupportsRanges() const = 0;
+    virtual const DBMScanRanges& Ranges() const = 0;
+    virtual void SetRanges( const DBMScanRanges& ranges ) = 0;
+    virtual void ReadRangePages( const INT irange, const PGNO pgnoStart, const CPG cpgRead ) = 0;
+
 protected:
     IDBMScanState() {}
 };
@@ -262,6 +310,26 @@ private:
     void DoOnePass_();
     void WaitForMinPassTime_();
 
+    struct DBMScanWorker
+    {
+        DBMScan *           pscan;
+        IDBMScanReader *    pscanreader;
+        THREAD              thread;
+    };
+
+    static DWORD DwDBMScanWorkerThreadProc_( DWORD_PTR dwContext );
+    DWORD DwDBMScanWorker_( IDBMScanReader * const pscanreader );
+
+    void LayoutRanges_();
+    bool FRangedPass_() const;
+    PGNO PgnoRangeLast_( const INT irange ) const;
+    bool FRangesDone_() const;
+    INT IrangeClaim_();
+    bool FWorkerSliceOver_() const;
+    ERR ErrRunWorkers_( const INT cworkers );
+    void DoOneRangedPass_();
+    void PassReadRangePage_( const INT irange, const PGNO pgno );
+
     
     void ForEachObserverCall_( void ( DBMScanObserver::* const pfn )( const IDBMScanState * const ) ) const;
     template<class Arg> void ForEachObserverCall_(
@@ -294,6 +362,16 @@ private:
     bool m_fNeedToSuspendPass;
     bool m_fSerializeScan;
 
+    CSemaphore                  m_semRangedPass;
+    unique_ptr<IDBMScanReader>    m_rgpscanreaderWorker[cdbmscanRangesMax];
+    DBMScanWorker               m_rgworker[cdbmscanRangesMax];
+    bool                        m_rgfRangeClaimed[cdbmscanRangesMax];
+    TICK                        m_tickNextBatch;
+    TICK                        m_tickSliceStart;
+    DWORD                       m_dtickTimeSlice;
+    __int64                     m_ftNotifyStart;
+    bool                        m_fRangedPassEOF;
+
 private:
     DBMScan( const DBMScan& );
     DBMScan& operator=( const DBMScan& );
@@ -435,6 +513,7 @@ public:
     ERR ErrReadPage( const PGNO pgno );
     void DoneWithPreread( const PGNO pgno );
     PGNO PgnoLast() const;
+    ERR ErrCloneDBMScanReader( __out IDBMScanReader ** const ppscanreader );
 
 private:
     const IFMP m_ifmp;
@@ -455,7 +534,10 @@ public:
 
     virtual __int64 FtCurrPassStartTime() const         { return m_ftCurrPassStartTime; }
     virtual CPG CpgScannedCurrPass() const              { return m_cpgScannedCurrPass; }
-    virtual PGNO PgnoContinuousHighWatermark() const    { return m_pgnoContinuousHighWatermark; }
+    virtual PGNO PgnoContinuousHighWatermark() const
+    {
+        return m_ranges.cRanges > 1 ? PgnoDBMScanRangesContinuousHighWatermark( m_ranges ) : m_pgnoContinuousHighWatermark;
+    }
     virtual PGNO PgnoHighestChecked() const             { return m_pgnoHighestChecked; }
     
     virtual __int64 FtPrevPassStartTime() const         { return m_ftPrevPassStartTime; }
@@ -471,6 +553,11 @@ public:
     virtual void SuspendedPass() {}
     virtual void ReadPages( const PGNO pgnoStart, const CPG cpgRead );
     virtual void BadChecksum( const PGNO pgnoBadChecksum ) {}
+
+    virtual bool FSupportsRanges() const                { return true; }
+    virtual const DBMScanRanges& Ranges() const         { return m_ranges; }
+    virtual void SetRanges( const DBMScanRanges& ranges ) { m_ranges = ranges; }
+    virtual void ReadRangePages( const INT irange, const PGNO pgnoStart, const CPG cpgRead );
     
 protected:
     __int64 m_ftCurrPassStartTime;
@@ -480,6 +567,7 @@ protected:
     PGNO    m_pgnoContinuousHighWatermark;
     PGNO    m_pgnoHighestChecked;
     CPG     m_cpgScannedPrevPass;
+    DBMScanRanges m_ranges;
     
 private:
     DBMSimpleScanState( const DBMSimpleScanState& );
@@ -498,6 +586,8 @@ public:
     virtual void SuspendedPass();
     virtual void ReadPages( const PGNO pgnoStart, const CPG cpgRead );
 
+    virtual bool FSupportsRanges() const { return false; }
+
     static void ResetScanStats( FMP * const pfmp );
 
 private:
@@ -543,6 +633,8 @@ public:
 	__int64 p_cbFreeLVPages;
 	__int64 p_cbFreeRecPages;
 
+    DBMScanRanges p_ranges;
+
     DataSerializer& Serializer() { return m_serializer; }
     
 private:
@@ -565,6 +657,8 @@ private:
     DataBindingOf<__int64>  m_bindingCbFreeLVPages;
     DataBindingOf<__int64>  m_bindingCbFreeRecPages;
 
+    DataBindingOf<DBMScanRanges> m_bindingRanges;
+
     DataBindings            m_bindings;
     DataSerializer          m_serializer;
 };
@@ -578,8 +672,14 @@ public:
 
     virtual __int64 FtCurrPassStartTime() const { return m_record.p_ftPassStartTime; }
     virtual CPG CpgScannedCurrPass() const { return m_record.p_cpgPassPagesRead; }
-    virtual PGNO PgnoContinuousHighWatermark() const { return ( PGNO )m_record.p_cpgPassPagesRead; }
-    virtual PGNO PgnoHighestChecked() const { return ( PGNO )m_record.p_cpgPassPagesRead; }
+    virtual PGNO PgnoContinuousHighWatermark() const
+    {
+        return m_record.p_ranges.cRanges > 1 ? PgnoDBMScanRangesContinuousHighWatermark( m_record.p_ranges ) : ( PGNO )m_record.p_cpgPassPagesRead;
+    }
+    virtual PGNO PgnoHighestChecked() const
+    {
+        return m_record.p_ranges.cRanges > 1 ? PgnoDBMScanRangesHighestChecked( m_record.p_ranges ) : ( PGNO )m_record.p_cpgPassPagesRead;
+    }
     
     virtual __int64 FtPrevPassStartTime() const { return m_record.p_ftPrevPassStartTime; }
     virtual __int64 FtPrevPassCompletionTime() const { return m_record.p_ftPrevPassEndTime; }
@@ -594,6 +694,11 @@ public:
     virtual void ReadPages( const PGNO pgnoStart, const CPG cpgRead );
     virtual void BadChecksum( const PGNO pgnoBadChecksum );
 
+    virtual bool FSupportsRanges() const { return true; }
+    virtual const DBMScanRanges& Ranges() const { return m_record.p_ranges; }
+    virtual void SetRanges( const DBMScanRanges& ranges ) { m_record.p_ranges = ranges; }
+    virtual void ReadRangePages( const INT irange, const PGNO pgnoStart, const CPG cpgRead );
+
 private:
     void LoadStateFromTable();
     void SaveStateToTable();
@@ -626,6 +731,7 @@ public:
     virtual INT CSecMax() { return INT_MAX; }
     virtual INT CSecMinScanTime();
     virtual CPG CpgBatch();
+    virtual INT CReaders();
     virtual DWORD DwThrottleSleep();
     virtual bool FSerializeScan();
     virtual INST * Pinst();
@@ -1253,7 +1359,8 @@ DBMSimpleScanState::DBMSimpleScanState() :
     m_cpgScannedCurrPass( 0 ),
     m_pgnoContinuousHighWatermark( 0 ),
     m_cpgScannedPrevPass( 0 ),
-    m_pgnoHighestChecked( 0 )
+    m_pgnoHighestChecked( 0 ),
+    m_ranges()
 {
 }
 
@@ -1262,6 +1369,7 @@ void DBMSimpleScanState::StartedPass()
     m_ftCurrPassStartTime = UtilGetCurrentFileTime();
     m_cpgScannedCurrPass = 0;
     m_pgnoHighestChecked = 0;
+    m_ranges = DBMScanRanges();
 }
 
 void DBMSimpleScanState::FinishedPass()
@@ -1273,6 +1381,7 @@ void DBMSimpleScanState::FinishedPass()
     m_pgnoContinuousHighWatermark = pgnoNull;
     m_cpgScannedCurrPass = pgnoNull;
     m_pgnoHighestChecked = pgnoNull;
+    m_ranges = DBMScanRanges();
 }
 
 void DBMSimpleScanState::ReadPages( const PGNO pgnoStart, const CPG cpgRead )
@@ -1290,6 +1399,14 @@ void DBMSimpleScanState::ReadPages( const PGNO pgnoStart, const CPG cpgRead )
     }
 }
 
+void DBMSimpleScanState::ReadRangePages( const INT irange, const PGNO pgnoStart, const CPG cpgRead )
+{
+    Assert( irange >= 0 && irange < m_ranges.cRanges );
+    Assert( pgnoStart == m_ranges.rgpgnoNext[irange] );
+    m_ranges.rgpgnoNext[irange] = pgnoStart + cpgRead;
+    ReadPages( pgnoStart, cpgRead );
+}
+
 
 
 DBMScanReader::DBMScanReader( const IFMP ifmp ) :
@@ -1327,6 +1444,24 @@ HandleError:
     return err;
 }
 
+ERR DBMScanReader::ErrCloneDBMScanReader( __out IDBMScanReader ** const ppscanreader )
+{
+    ERR err = JET_errSuccess;
+    DBMScanReader * pscanreader = NULL;
+
+    *ppscanreader = NULL;
+
+    Alloc( pscanreader = new DBMScanReader( m_ifmp ) );
+    Call( pscanreader->InitDBMScanReader() );
+
+    *ppscanreader = pscanreader;
+    pscanreader = NULL;
+
+HandleError:
+    delete pscanreader;
+    return err;
+}
+
 void DBMScanReader::PrereadPages( const PGNO pgnoFirst, const CPG cpg )
 {
     Assert( cpg <= cpgPrereadMax );
@@ -1871,6 +2006,7 @@ void DBMScanStateMSysDatabaseScan::StartedPass()
     m_record.p_ftPassStartTime  = UtilGetCurrentFileTime();
     m_record.p_cpgBadChecksumsPass = 0;
     m_record.p_cpgPassPagesRead = 0;
+    m_record.p_ranges = DBMScanRanges();
 
     m_histoCbFreeLVPages.Zero();
     m_histoCbFreeRecPages.Zero();
@@ -1900,6 +2036,7 @@ void DBMScanStateMSysDatabaseScan::FinishedPass()
     m_record.p_ftPassStartTime  = 0;
     m_record.p_cpgBadChecksumsPass = 0;
     m_record.p_cpgPassPagesRead = 0;
+    m_record.p_ranges = DBMScanRanges();
 
     SaveStateToTable();
 }
@@ -1919,6 +2056,14 @@ void DBMScanStateMSysDatabaseScan::ReadPages( const PGNO pgnoStart, const CPG cp
     }
 }
 
+void DBMScanStateMSysDatabaseScan::ReadRangePages( const INT irange, const PGNO pgnoStart, const CPG cpgRead )
+{
+    Assert( irange >= 0 && irange < m_record.p_ranges.cRanges );
+    Assert( pgnoStart == m_record.p_ranges.rgpgnoNext[irange] );
+    m_record.p_ranges.rgpgnoNext[irange] = pgnoStart + cpgRead;
+    ReadPages( pgnoStart, cpgRead );
+}
+
 void DBMScanStateMSysDatabaseScan::BadChecksum( const PGNO pgnoBadChecksum )
 {
     m_record.p_cpgBadChecksumsPass++;
@@ -1934,6 +2079,11 @@ void DBMScanStateMSysDatabaseScan::LoadStateFromTable()
         m_record.p_cpgPassPagesRead = UlFunctionalMin( m_record.p_cpgPassPagesRead, g_rgfmp[m_ifmp].PgnoLast() - 1 );
     }
 
+    if ( m_record.p_ranges.cRanges < 0 || m_record.p_ranges.cRanges > cdbmscanRangesMax )
+    {
+        m_record.p_ranges = DBMScanRanges();
+    }
+
     m_cpgScannedLastUpdate = CpgScannedCurrPass();
 
     m_histoCbFreeLVPages.Init( m_record.p_cpgLVPages, m_record.p_cbFreeLVPages );
@@ -2001,6 +2151,7 @@ MSysDatabaseScanRecord::MSysDatabaseScanRecord() :
     m_bindingCpgRecPages( &p_cpgRecPages, "TotalRecPages" ),
     m_bindingCbFreeLVPages( &p_cbFreeLVPages, "FreeBytesLVPages" ),
     m_bindingCbFreeRecPages( &p_cbFreeRecPages, "FreeBytesRecPages" ),
+    m_bindingRanges( &p_ranges, "PassRanges" ),
     m_serializer( m_bindings )
 {
     m_bindings.AddBinding( &m_bindingFtLastUpdateTime );
@@ -2018,6 +2169,7 @@ MSysDatabaseScanRecord::MSysDatabaseScanRecord() :
     m_bindings.AddBinding( &m_bindingCpgRecPages );
     m_bindings.AddBinding( &m_bindingCbFreeLVPages );
     m_bindings.AddBinding( &m_bindingCbFreeRecPages );
+    m_bindings.AddBinding( &m_bindingRanges );
     m_serializer.SetBindingsToDefault();
 }
 
@@ -2046,6 +2198,20 @@ CPG DBMScanConfig::CpgBatch()
     return cbScanBuffer / ( size_t )g_cbPage;
 }
 
+INT DBMScanConfig::CReaders()
+{
+    WCHAR   wszBuf[ 16 ];
+    INT     creaders    = 1;
+
+    if (    FOSConfigGet( L"DBM", L"Parallel Readers", wszBuf, sizeof( wszBuf ) ) &&
+            wszBuf[ 0 ] )
+    {
+        creaders = max( 1, min( cdbmscanRangesMax, (INT)_wtol( wszBuf ) ) );
+    }
+
+    return creaders;
+}
+
 DWORD DBMScanConfig::DwThrottleSleep()
 {
     return ( DWORD )UlParam( m_pinst, JET_paramDbScanThrottle );
@@ -3669,11 +3835,19 @@ DBMScan::DBMScan(
     m_pidbmScanSerializationObj( NULL ),
     m_cscansFinished( 0 ),
     m_fNeedToSuspendPass( false ),
-    m_fSerializeScan( false )
+    m_fSerializeScan( false ),
+    m_semRangedPass( CSyncBasicInfo( _T("DBMScan::m_semRangedPass" ) ) ),
+    m_tickNextBatch( 0 ),
+    m_tickSliceStart( 0 ),
+    m_dtickTimeSlice( 0 ),
+    m_ftNotifyStart( 0 ),
+    m_fRangedPassEOF( false )
 {
     Assert( NULL != pscanstate );
     Assert( NULL != pscanconfig );
     Assert( NULL != pscanreader );
+
+    m_semRangedPass.Release();
 }
 
 DBMScan::~DBMScan()
@@ -3875,6 +4049,12 @@ DWORD DBMScan::DwDBMScan_()
 
 void DBMScan::DoOnePass_()
 {
+    if ( FRangedPass_() )
+    {
+        DoOneRangedPass_();
+        return;
+    }
+
     bool fRunnable = false;
     CPG cpgBatch = m_pscanconfig->CpgBatch();
     Assert( cpgBatch > 0 );
@@ -3969,6 +4149,276 @@ Finished:
     return;
 }
 
+void DBMScan::LayoutRanges_()
+{
+    const INT creaders = m_pscanconfig->CReaders();
+    if ( creaders <= 1 || !m_pscanstate->FSupportsRanges() )
+    {
+        return;
+    }
+
+
+    const PGNO pgnoLast = m_pscanreader->PgnoLast();
+    const CPG cpgRangeMin = min( m_pscanconfig->CpgBatch(), (CPG)m_pscanreader->cpgPrereadMax );
+    Assert( cpgRangeMin > 0 );
+    const INT cRanges = (INT)min( (PGNO)min( creaders, cdbmscanRangesMax ), pgnoLast / cpgRangeMin );
+    if ( cRanges <= 1 )
+    {
+        return;
+    }
+
+    DBMScanRanges ranges = DBMScanRanges();
+    ranges.cRanges = cRanges;
+    for ( INT irange = 0; irange < cRanges; irange++ )
+    {
+        ranges.rgpgnoFirst[irange] = 1 + (PGNO)( ( (QWORD)pgnoLast * irange ) / cRanges );
+        ranges.rgpgnoNext[irange] = ranges.rgpgnoFirst[irange];
+    }
+    m_pscanstate->SetRanges( ranges );
+}
+
+bool DBMScan::FRangedPass_() const
+{
+    return m_pscanstate->FSupportsRanges() && m_pscanstate->Ranges().cRanges > 1;
+}
+
+PGNO DBMScan::PgnoRangeLast_( const INT irange ) const
+{
+    const DBMScanRanges& ranges = m_pscanstate->Ranges();
+    Assert( irange >= 0 && irange < ranges.cRanges );
+
+    const PGNO pgnoLast = m_pscanreader->PgnoLast();
+    if ( irange + 1 < ranges.cRanges )
+    {
+        return UlFunctionalMin( ranges.rgpgnoFirst[irange + 1] - 1, pgnoLast );
+    }
+    return pgnoLast;
+}
+
+bool DBMScan::FRangesDone_() const
+{
+    const DBMScanRanges& ranges = m_pscanstate->Ranges();
+    for ( INT irange = 0; irange < ranges.cRanges; irange++ )
+    {
+        if ( ranges.rgpgnoNext[irange] <= PgnoRangeLast_( irange ) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+INT DBMScan::IrangeClaim_()
+{
+    const DBMScanRanges& ranges = m_pscanstate->Ranges();
+    for ( INT irange = 0; irange < ranges.cRanges; irange++ )
+    {
+        if ( !m_rgfRangeClaimed[irange] && ranges.rgpgnoNext[irange] <= PgnoRangeLast_( irange ) )
+        {
+            m_rgfRangeClaimed[irange] = true;
+            return irange;
+        }
+    }
+    return -1;
+}
+
+bool DBMScan::FWorkerSliceOver_() const
+{
+    return m_msigDBScanStop.FIsSet() ||
+            FTimeLimitReached_() ||
+            m_fRangedPassEOF ||
+            ( TickOSTimeCurrent() - m_tickSliceStart ) >= m_dtickTimeSlice;
+}
+
+DWORD DBMScan::DwDBMScanWorkerThreadProc_( DWORD_PTR dwContext )
+{
+    DBMScanWorker * const pworker = reinterpret_cast<DBMScanWorker *>( dwContext );
+    Assert( NULL != pworker );
+    return pworker->pscan->DwDBMScanWorker_( pworker->pscanreader );
+}
+
+DWORD DBMScan::DwDBMScanWorker_( IDBMScanReader * const pscanreader )
+{
+    const CPG cpgBatch = min( m_pscanconfig->CpgBatch(), (CPG)pscanreader->cpgPrereadMax );
+    const DWORD dtickThrottle = m_pscanconfig->DwThrottleSleep();
+    INT irange = -1;
+
+    Assert( cpgBatch > 0 );
+
+    while ( !FWorkerSliceOver_() )
+    {
+        m_semRangedPass.Acquire();
+
+        if ( irange < 0 )
+        {
+            irange = IrangeClaim_();
+        }
+        if ( irange < 0 )
+        {
+            m_semRangedPass.Release();
+            break;
+        }
+
+        const PGNO pgnoFirst = m_pscanstate->Ranges().rgpgnoNext[irange];
+        const PGNO pgnoLast = UlFunctionalMin( PgnoRangeLast_( irange ), pgnoFirst + cpgBatch - 1 );
+        const CPG cpgScan = pgnoLast - pgnoFirst + 1;
+        if ( cpgScan <= 0 )
+        {
+            irange = -1;
+            m_semRangedPass.Release();
+            continue;
+        }
+
+        const TICK tickNow = TickOSTimeCurrent();
+        const LONG dtickWait = LONG( m_tickNextBatch - tickNow );
+        m_tickNextBatch = ( dtickWait > 0 ? m_tickNextBatch : tickNow ) + dtickThrottle;
+
+        m_semRangedPass.Release();
+
+        if ( dtickWait > 0 && m_msigDBScanStop.FWait( dtickWait ) )
+        {
+            break;
+        }
+
+        pscanreader->PrereadPages( pgnoFirst, cpgScan );
+        for ( PGNO pgno = pgnoFirst; pgno < pgnoFirst + cpgScan; ++pgno )
+        {
+            const ERR err = pscanreader->ErrReadPage( pgno );
+
+            m_semRangedPass.Acquire();
+            switch ( err )
+            {
+                case JET_errFileIOBeyondEOF:
+                    Expected( fFalse );
+                    m_fRangedPassEOF = true;
+                    m_semRangedPass.Release();
+                    goto Finished;
+
+                case JET_errReadPgnoVerifyFailure:
+                case JET_errReadVerifyFailure:
+                    BadChecksum_( pgno );
+                    break;
+
+                default:
+                    break;
+            }
+            PassReadRangePage_( irange, pgno );
+            m_semRangedPass.Release();
+
+            pscanreader->DoneWithPreread( pgno );
+        }
+
+        m_semRangedPass.Acquire();
+        if ( ( UtilGetCurrentFileTime() - m_ftNotifyStart ) >=
+              UtilConvertSecondsToFileTime( m_pscanconfig->CSecNotifyInterval() ) )
+        {
+            m_ftNotifyStart = UtilGetCurrentFileTime();
+            ForEachObserverCall_( &DBMScanObserver::NotifyStats );
+        }
+        m_semRangedPass.Release();
+    }
+
+Finished:
+    return 0;
+}
+
+//  The scan thread reads as the first worker, so a slice still makes progress when no extra
+//  reader can be started. Returns the first error hit while setting up the extra readers.
+
+ERR DBMScan::ErrRunWorkers_( const INT cworkers )
+{
+    ERR err = JET_errSuccess;
+    INT cworkersReady = 1;
+    INT cworkersStarted = 1;
+
+    Assert( cworkers > 0 && cworkers <= cdbmscanRangesMax );
+
+    for ( ; cworkersReady < cworkers; cworkersReady++ )
+    {
+        if ( !m_rgpscanreaderWorker[cworkersReady] )
+        {
+            IDBMScanReader * pscanreader;
+            err = m_pscanreader->ErrCloneDBMScanReader( &pscanreader );
+            if ( err < JET_errSuccess )
+            {
+                break;
+            }
+            m_rgpscanreaderWorker[cworkersReady] = unique_ptr<IDBMScanReader>( pscanreader );
+        }
+    }
+
+    memset( m_rgfRangeClaimed, 0, sizeof( m_rgfRangeClaimed ) );
+    m_tickNextBatch = TickOSTimeCurrent();
+
+    for ( ; cworkersStarted < cworkersReady; cworkersStarted++ )
+    {
+        DBMScanWorker * const pworker = &m_rgworker[cworkersStarted];
+        pworker->pscan = this;
+        pworker->pscanreader = m_rgpscanreaderWorker[cworkersStarted].get();
+        pworker->thread = NULL;
+
+        const ERR errThread = ErrUtilThreadCreate( DwDBMScanWorkerThreadProc_, 0, priorityNormal, &pworker->thread, ( DWORD_PTR )pworker );
+        if ( errThread < JET_errSuccess )
+        {
+            err = errThread;
+            break;
+        }
+    }
+
+    ( void )DwDBMScanWorker_( m_pscanreader.get() );
+
+    for ( INT iworker = 1; iworker < cworkersStarted; iworker++ )
+    {
+        UtilThreadEnd( m_rgworker[iworker].thread );
+        m_rgworker[iworker].thread = NULL;
+    }
+
+    return err;
+}
+
+void DBMScan::DoOneRangedPass_()
+{
+    const INT cworkers = min( m_pscanconfig->CReaders(), m_pscanstate->Ranges().cRanges );
+
+    m_ftNotifyStart = UtilGetCurrentFileTime();
+    m_fRangedPassEOF = false;
+
+    while ( !m_msigDBScanStop.FWait( m_pscanconfig->DwThrottleSleep() ) && !FTimeLimitReached_() )
+    {
+        if ( !m_pidbmScanSerializationObj->FEnqueueAndWait( this, CMSecBeforeTimeLimit_() ) )
+        {
+            Assert( !m_pidbmScanSerializationObj->FDBMScanCurrent( this ) );
+            continue;
+        }
+
+        Assert( m_pidbmScanSerializationObj->FDBMScanCurrent( this ) );
+        m_tickSliceStart = TickOSTimeCurrent();
+        m_dtickTimeSlice = ( DWORD )UlConfigOverrideInjection( 41007, m_pidbmScanSerializationObj->DwTimeSlice() );
+
+        const ERR errWorkers = ErrRunWorkers_( max( cworkers, 1 ) );
+        if ( errWorkers < JET_errSuccess )
+        {
+            OSTrace( JET_tracetagOLD, OSFormat( __FUNCTION__ ": could not start all %d readers, scanned with fewer (err = %d).", cworkers, errWorkers ) );
+        }
+
+        Assert( m_pidbmScanSerializationObj->FDBMScanCurrent( this ) );
+        m_pidbmScanSerializationObj->Dequeue( this );
+
+        if ( m_fRangedPassEOF || FRangesDone_() )
+        {
+            FinishPass_();
+            break;
+        }
+    }
+}
+
+void DBMScan::PassReadRangePage_( const INT irange, const PGNO pgno )
+{
+    const CPG cpgRead = 1;
+    m_pscanstate->ReadRangePages( irange, pgno, cpgRead );
+    ForEachObserverCall_( &DBMScanObserver::ReadPage, pgno );
+}
+
 bool DBMScan::FResumingPass_() const
 {
     return m_pscanstate->CpgScannedCurrPass() > 0;
@@ -3984,6 +4434,7 @@ void DBMScan::ResumePass_()
 void DBMScan::StartNewPass_()
 {
     m_pscanstate->StartedPass();
+    LayoutRanges_();
     ForEachObserverCall_( &DBMScanObserver::StartedPass );
     m_fNeedToSuspendPass = true;
 }
@@ -4961,6 +5412,7 @@ void SetMSysDatabaseScanRecord( MSysDatabaseScanRecord * precord )
     precord->p_cpgRecPages = 0xFF;
     precord->p_cbFreeLVPages = 0xFF;
     precord->p_cbFreeRecPages = 0xFF;
+    precord->p_ranges.cRanges = 0xFF;
 }
 
 JETUNITTEST( MSysDatabaseScanRecord, ConstructorZeroesMembers )
@@ -4981,6 +5433,7 @@ JETUNITTEST( MSysDatabaseScanRecord, ConstructorZeroesMembers )
     CHECK( 0 == record.p_cpgRecPages );
     CHECK( 0 == record.p_cbFreeLVPages );
     CHECK( 0 == record.p_cbFreeRecPages );
+    CHECK( 0 == record.p_ranges.cRanges );
 }
 
 JETUNITTEST( MSysDatabaseScanRecord, LoadFromEmptyStore )
@@ -5005,6 +5458,7 @@ JETUNITTEST( MSysDatabaseScanRecord, LoadFromEmptyStore )
     CHECK( 0 == record.p_cpgRecPages );
     CHECK( 0 == record.p_cbFreeLVPages );
     CHECK( 0 == record.p_cbFreeRecPages );
+    CHECK( 0 == record.p_ranges.cRanges );
 }
 
 JETUNITTEST( MSysDatabaseScanRecord, LoadAndSave )
@@ -5027,6 +5481,8 @@ JETUNITTEST( MSysDatabaseScanRecord, LoadAndSave )
     record.p_cpgRecPages = 13;
     record.p_cbFreeLVPages = 14;
     record.p_cbFreeRecPages = 15;
+    record.p_ranges.cRanges = 16;
+    record.p_ranges.rgpgnoNext[15] = 17;
     
     CHECK( JET_errSuccess == record.Serializer().ErrSaveBindings( &store ) );
     SetMSysDatabaseScanRecord( &record );
@@ -5047,6 +5503,8 @@ JETUNITTEST( MSysDatabaseScanRecord, LoadAndSave )
     CHECK( 13 == record.p_cpgRecPages );
     CHECK( 14 == record.p_cbFreeLVPages );
     CHECK( 15 == record.p_cbFreeRecPages );
+    CHECK( 16 == record.p_ranges.cRanges );
+    CHECK( 17 == record.p_ranges.rgpgnoNext[15] );
 }
 
 
@@ -5312,6 +5770,41 @@ JETUNITTEST( DBMScanStateMSysDatabaseScan, ReadingPagesSavesState )
     CHECK( 1 == state.Record().p_cInvocationsTotal );
 }
 
+JETUNITTEST( DBMScanStateMSysDatabaseScan, SuspendedSavesRanges )
+{
+    IDataStore * pstore = new MemoryDataStore();
+    TestDBMScanStateMSysDatabaseScan state( pstore );
+    state.StartedPass();
+
+    DBMScanRanges ranges = DBMScanRanges();
+    ranges.cRanges = 2;
+    ranges.rgpgnoFirst[0] = ranges.rgpgnoNext[0] = 1;
+    ranges.rgpgnoFirst[1] = ranges.rgpgnoNext[1] = 1001;
+    state.SetRanges( ranges );
+    state.ReadRangePages( 0, 1, 10 );
+    state.ReadRangePages( 1, 1001, 20 );
+    state.SuspendedPass();
+
+    SetMSysDatabaseScanRecord( &state.Record() );
+    state.Record().Serializer().ErrLoadBindings( pstore );
+
+    CHECK( 2 == state.Ranges().cRanges );
+    CHECK( 1 == state.Ranges().rgpgnoFirst[0] );
+    CHECK( 11 == state.Ranges().rgpgnoNext[0] );
+    CHECK( 1001 == state.Ranges().rgpgnoFirst[1] );
+    CHECK( 1021 == state.Ranges().rgpgnoNext[1] );
+    CHECK( 30 == state.CpgScannedCurrPass() );
+    CHECK( 1020 == state.PgnoHighestChecked() );
+    CHECK( 10 == state.PgnoContinuousHighWatermark() );
+
+    state.ReadRangePages( 0, 11, 990 );
+    CHECK( 1020 == state.PgnoHighestChecked() );
+    CHECK( 1020 == state.PgnoContinuousHighWatermark() );
+
+    state.FinishedPass();
+    CHECK( 0 == state.Ranges().cRanges );
+}
+
 JETUNITTEST( DBMScanStateMSysDatabaseScan, CalculateAverageFreeBytes )
     {
     IDataStore * pstore = new MemoryDataStore();
@@ -5392,6 +5885,7 @@ public:
     virtual INT CSecMax() { return m_csecMax; }
     virtual INT     CSecMinScanTime() { return m_csecMinScanTime; }
     virtual CPG     CpgBatch() { return m_cpgBatch; }
+    virtual INT     CReaders() { return m_creaders; }
     virtual DWORD   DwThrottleSleep() { return m_dwThrottleSleep; }
     virtual bool    FSerializeScan() { return m_fSerializeScan; }
     virtual INST * Pinst() { return NULL; }
@@ -5403,6 +5897,7 @@ public:
     void SetCSecMinScanTime( const ULONG csec ) { m_csecMinScanTime = csec; }
 
     void SetCpgBatch( const CPG cpg ) { m_cpgBatch = cpg; }
+    void SetCReaders( const INT creaders ) { m_creaders = creaders; }
     void SetDwThrottleSleep( const DWORD dw ) { m_dwThrottleSleep = dw; }
     void SetFSerializeScan( const bool f ) { m_fSerializeScan = f; }
     
@@ -5411,6 +5906,7 @@ private:
     INT m_csecMax;
     INT m_csecMinScanTime;
     CPG m_cpgBatch;
+    INT m_creaders;
     DWORD m_dwThrottleSleep;
     bool m_fSerializeScan;
 };
@@ -5421,6 +5917,7 @@ TestDBMScanConfig::TestDBMScanConfig() :
     m_csecMax( INT_MAX ),
     m_csecMinScanTime( 0 ),
     m_cpgBatch( 16 ),
+    m_creaders( 1 ),
     m_dwThrottleSleep( 0 ),
     m_fSerializeScan( false )
 {
@@ -5852,7 +6349,7 @@ JETUNITTEST( DBMScanObserverCallback, CallbackPassesCpgScanned )
 class TestDBMScanReader : public IDBMScanReader
 {
 public:
-    TestDBMScanReader( const PGNO pgnoLast = pgnoMax, const PGNO pgnoBadChecksum = pgnoNull );
+    TestDBMScanReader( const PGNO pgnoLast = pgnoMax, const PGNO pgnoBadChecksum = pgnoNull, TestDBMScanReader * const preaderRoot = NULL );
     
     virtual ~TestDBMScanReader() {}
     ERR InitDBMScanReader() { return JET_errSuccess; }
@@ -5860,6 +6357,7 @@ public:
     ERR ErrReadPage( const PGNO pgno );
     void DoneWithPreread( const PGNO pgno );
     PGNO PgnoLast() const;
+    ERR ErrCloneDBMScanReader( __out IDBMScanReader ** const ppscanreader );
 
     PGNO PgnoLastPreread() const { return m_pgnoLastPreread; }
     CPG CpgLastPreread() const { return m_cpgLastPreread; }
@@ -5885,6 +6383,7 @@ private:
 
     const PGNO  m_pgnoLast;
     const PGNO  m_pgnoBadChecksum;
+    TestDBMScanReader * const m_preaderRoot;
     
     CManualResetSignal  m_msigReadPageCalled;
 
@@ -5892,7 +6391,7 @@ private:
 };
 
 
-TestDBMScanReader::TestDBMScanReader( const PGNO pgnoLast, const PGNO pgnoBadChecksum ) :
+TestDBMScanReader::TestDBMScanReader( const PGNO pgnoLast, const PGNO pgnoBadChecksum, TestDBMScanReader * const preaderRoot ) :
     m_pgnoLastPreread( 0 ),
     m_cpgLastPreread( 0 ),
     m_pgnoLastRead( pgnoNull ),
@@ -5902,6 +6401,7 @@ TestDBMScanReader::TestDBMScanReader( const PGNO pgnoLast, const PGNO pgnoBadChe
     m_fInError( fFalse ),
     m_pgnoLast( pgnoLast ),
     m_pgnoBadChecksum( pgnoBadChecksum ),
+    m_preaderRoot( preaderRoot ? preaderRoot : this ),
     m_msigReadPageCalled( CSyncBasicInfo( _T("TestDBMScanReader::msigReadPageCalled" ) ) )
 {
 }
@@ -5910,7 +6410,7 @@ void TestDBMScanReader::PrereadPages( const PGNO pgnoFirst, const CPG cpg )
 {
     m_pgnoLastPreread = pgnoFirst;
     m_cpgLastPreread = cpg;
-    m_cpgPrereadTotal += cpg;
+    AtomicExchangeAdd( &m_preaderRoot->m_cpgPrereadTotal, cpg );
 }
 
 ERR TestDBMScanReader::ErrReadPage( const PGNO pgno )
@@ -5932,7 +6432,12 @@ ERR TestDBMScanReader::ErrReadPage( const PGNO pgno )
 
     PGNO pgnoPrevious = m_pgnoLastRead;
     m_pgnoLastRead = pgno;
-    m_msigReadPageCalled.Set();
+    m_preaderRoot->m_msigReadPageCalled.Set();
+
+    if ( m_fInError )
+    {
+        m_preaderRoot->m_fInError = fTrue;
+    }
 
     if ( m_pgnoBadChecksum == pgno )
     {
@@ -5941,7 +6446,7 @@ ERR TestDBMScanReader::ErrReadPage( const PGNO pgno )
 
     if ( pgno != pgnoPrevious )
     {
-        m_cpgReadTotal++;
+        AtomicIncrement( &m_preaderRoot->m_cpgReadTotal );
     }
 
     return JET_errSuccess;
@@ -5962,7 +6467,12 @@ void TestDBMScanReader::DoneWithPreread( const PGNO pgno )
         m_fInError = fTrue;
     }
 
-    m_cpgDoneTotal++;
+    if ( m_fInError )
+    {
+        m_preaderRoot->m_fInError = fTrue;
+    }
+
+    AtomicIncrement( &m_preaderRoot->m_cpgDoneTotal );
     return;
 }
 
@@ -5971,6 +6481,12 @@ PGNO TestDBMScanReader::PgnoLast() const
     return m_pgnoLast;
 }
 
+ERR TestDBMScanReader::ErrCloneDBMScanReader( __out IDBMScanReader ** const ppscanreader )
+{
+    *ppscanreader = new TestDBMScanReader( m_pgnoLast, m_pgnoBadChecksum, m_preaderRoot );
+    return *ppscanreader ? JET_errSuccess : ErrERRCheck( JET_errOutOfMemory );
+}
+
 JETUNITTEST( TestDBMScanReader, InfiniteReadPages )
 {
     TestDBMScanReader reader;
@@ -6430,6 +6946,77 @@ JETUNITTEST( DBMScan, PrereadPagesAreReleased )
     
 }
 
+JETUNITTEST( DBMScan, RangedPassReadsEveryPageOnce )
+{
+    const CPG cpgTotal = 1000;
+    TestDBMScanReader * preader = new TestDBMScanReader( cpgTotal );
+
+    unique_ptr<TestDBMScanConfig> pconfig( new TestDBMScanConfig() );
+    pconfig->SetCScansMax( 1 );
+    pconfig->SetCReaders( 4 );
+
+    TestDBMScanState * pstate = new TestDBMScanState();
+    unique_ptr<DBMScan> pscan( new DBMScan(
+        pstate,
+        preader,
+        pconfig.release() ) );
+
+    TestDBMScanObserver * pobserver = new TestDBMScanObserver();
+    pscan->AddObserver( pobserver );
+
+    CHECK( JET_errSuccess == pscan->ErrStartDBMScan() );
+    pobserver->WaitForFinishedPass();
+
+    CHECK( cpgTotal == pobserver->CpgRead() );
+    CHECK( cpgTotal == preader->CpgReadTotal() );
+    CHECK( cpgTotal == preader->CpgDoneWithPrereadTotal() );
+    CHECK( cpgTotal == pstate->CpgScannedPrevPass() );
+    CHECK( fFalse == preader->FInError() );
+}
+
+JETUNITTEST( DBMScan, RangedPassResumesEveryRange )
+{
+    const CPG cpgTotal = 400;
+    const PGNO rgpgnoFirst[] = { 1, 101, 201, 301 };
+    const PGNO rgpgnoNext[] = { 51, 201, 250, 301 };
+    const CPG cpgScanned = 50 + 100 + 49;
+
+    unique_ptr<TestDBMScanConfig> pconfig( new TestDBMScanConfig() );
+    pconfig->SetCScansMax( 1 );
+    pconfig->SetCReaders( 2 );
+
+    DBMScanRanges ranges = DBMScanRanges();
+    ranges.cRanges = _countof( rgpgnoFirst );
+    for ( INT irange = 0; irange < ranges.cRanges; irange++ )
+    {
+        ranges.rgpgnoFirst[irange] = rgpgnoFirst[irange];
+        ranges.rgpgnoNext[irange] = rgpgnoNext[irange];
+    }
+
+    unique_ptr<TestDBMScanState> pstate( new TestDBMScanState() );
+    pstate->SetFtCurrPassStartTime( 0x400 );
+    pstate->SetCpgScannedCurrPass( cpgScanned );
+    pstate->SetRanges( ranges );
+
+    TestDBMScanReader * preader = new TestDBMScanReader( cpgTotal );
+    unique_ptr<DBMScan> pscan( new DBMScan(
+        pstate.release(),
+        preader,
+        pconfig.release() ) );
+
+    TestDBMScanObserver * pobserver = new TestDBMScanObserver();
+    pscan->AddObserver( pobserver );
+
+    CHECK( JET_errSuccess == pscan->ErrStartDBMScan() );
+    pobserver->WaitForFinishedPass();
+
+    CHECK( true == pobserver->FResumedPassCalled() );
+    CHECK( false == pobserver->FStartedPassCalled() );
+    CHECK( cpgTotal - cpgScanned == pobserver->CpgRead() );
+    CHECK( cpgTotal - cpgScanned == preader->CpgReadTotal() );
+    CHECK( fFalse == preader->FInError() );
+}
+
 VOID CDBMScanFollower::TestSetup( IDBMScanState * pstate )
 {
     m_pstate = pstate;
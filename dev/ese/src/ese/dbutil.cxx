@@ -308,6 +308,10 @@ VOID DBUTLDumpRec( const LONG cbPage, const FUCB * const pfucbTable, const VOID
             const INT cbPrintMax = 512;
             if( fCompressed && !fEncrypted && !fSeparated )
             {
+                DATA dataCompressed;
+                dataCompressed.SetPv( (void *)ti.TagfldIterator().PbData() );
+                dataCompressed.SetCb( ti.TagfldIterator().CbData() );
+
                 szBuf[0] = 0;
                 DBUTLSprintHex(
                     szBuf,
@@ -317,31 +321,37 @@ VOID DBUTLDumpRec( const LONG cbPage, const FUCB * const pfucbTable, const VOID
                     cbWidth );
                 (*pcprintf)( "%s%s\r\n", szBuf, ( ti.TagfldIterator().CbData() > 64 ? "...\r\n" : "" ) );
 
-                BYTE rgbDecompressed[cbPrintMax];
-                DATA dataCompressed;
-                dataCompressed.SetPv( (void *)ti.TagfldIterator().PbData() );
-                dataCompressed.SetCb( ti.TagfldIterator().CbData() );
-                INT cbDecompressed;
+                //  without a cursor on the table we cannot find its compression dictionaries
 
-                CallSx( ErrPKDecompressData(
-                    dataCompressed,
-                    NULL,
-                    rgbDecompressed,
-                    sizeof(rgbDecompressed),
-                    &cbDecompressed ),
-                    JET_wrnBufferTruncated );
-                size_t cbToPrint = min( sizeof(rgbDecompressed ), cbDecompressed );
+                if ( pfucbNil == pfucbTable && FPKCompressedWithDictionary( dataCompressed ) )
+                {
+                    (*pcprintf)( ">> compressed with a table dictionary\r\n" );
+                }
+                else
+                {
+                    BYTE rgbDecompressed[cbPrintMax];
+                    INT cbDecompressed;
 
-                (*pcprintf)( ">> %d bytes uncompressed:\r\n", cbDecompressed );
+                    CallSx( ErrPKDecompressData(
+                        dataCompressed,
+                        pfucbTable,
+                        rgbDecompressed,
+                        sizeof(rgbDecompressed),
+                        &cbDecompressed ),
+                        JET_wrnBufferTruncated );
+                    size_t cbToPrint = min( sizeof(rgbDecompressed ), cbDecompressed );
 
-                szBuf[0] = 0;
-                DBUTLSprintHex(
-                    szBuf,
-                    sizeof(szBuf),
-                    rgbDecompressed,
-                    min( cbToPrint, cbPrintMax ),
-                    cbWidth );
-                (*pcprintf)( "%s%s\r\n", szBuf, ( cbDecompressed > cbPrintMax ? "...\r\n" : "" ) );
+                    (*pcprintf)( ">> %d bytes uncompressed:\r\n", cbDecompressed );
+
+                    szBuf[0] = 0;
+                    DBUTLSprintHex(
+                        szBuf,
+                        sizeof(szBuf),
+                        rgbDecompressed,
+                        min( cbToPrint, cbPrintMax ),
+                        cbWidth );
+                    (*pcprintf)( "%s%s\r\n", szBuf, ( cbDecompressed > cbPrintMax ? "...\r\n" : "" ) );
+                }
             }
             else
             {
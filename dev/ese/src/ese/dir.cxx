@@ -1462,7 +1462,7 @@ ERR ErrDIRBeginTransaction( PIB *ppib, const TRXID trxid, const JET_GRBIT grbit
         {
             if ( Ptls()->fInCallback )
             {
-                Assert( pinst->m_pver->m_pbucketGlobalHead == NULL );
+                Assert( !pinst->m_pver->FVERBucketsAllocated() );
                 Assert( trxMax == TrxOldest( pinst ) );
             }
             else
@@ -3725,8 +3725,107 @@ ERR ErrFILEIndexBatchAddEntry(
 }
 
 
+class CFILEIndexSortMerge
+{
+    public:
+        CFILEIndexSortMerge( FUCB ** const rgpfucbSort, const ULONG cPartition, const ULONG cSortStride, const BOOL fUnique )
+            :   m_cpfucbSort( 0 ),
+                m_fUnique( fUnique )
+        {
+            Assert( cPartition > 0 );
+            Assert( cPartition <= cFILEIndexBuildPartitionMax );
+            Assert( 1 == cPartition || cSortStride > 0 );
+
+            for ( ULONG ipartition = 0; ipartition < cPartition; ipartition++ )
+            {
+                m_rgpfucbSort[m_cpfucbSort++] = rgpfucbSort[ipartition * cSortStride];
+            }
+        }
+
+        ERR ErrFirst()
+        {
+            ERR err;
+
+            for ( ULONG ipfucb = m_cpfucbSort; ipfucb > 0; ipfucb-- )
+            {
+                CallR( ErrIAdvance( ipfucb - 1 ) );
+            }
+
+            return ErrISelect();
+        }
+
+        ERR ErrNext()
+        {
+            ERR err;
+
+            Assert( m_cpfucbSort > 0 );
+            CallR( ErrIAdvance( 0 ) );
+
+            return ErrISelect();
+        }
+
+        const KEYDATAFLAGS& KdfCurr() const
+        {
+            Assert( m_cpfucbSort > 0 );
+            return m_rgpfucbSort[0]->kdfCurr;
+        }
+
+    private:
+        ERR ErrIAdvance( const ULONG ipfucb )
+        {
+            const ERR err = ErrSORTNext( m_rgpfucbSort[ipfucb] );
+            if ( JET_errNoCurrentRecord == err )
+            {
+                m_rgpfucbSort[ipfucb] = m_rgpfucbSort[--m_cpfucbSort];
+                return JET_errSuccess;
+            }
+
+            return err;
+        }
+
+        ERR ErrISelect()
+        {
+            ERR err;
+
+            if ( 0 == m_cpfucbSort )
+            {
+                return ErrERRCheck( JET_errNoCurrentRecord );
+            }
+
+            for ( ULONG ipfucb = 1; ipfucb < m_cpfucbSort; ipfucb++ )
+            {
+                if ( CmpKeyData( m_rgpfucbSort[ipfucb]->kdfCurr, m_rgpfucbSort[0]->kdfCurr ) < 0 )
+                {
+                    FUCB * const pfucbT = m_rgpfucbSort[0];
+                    m_rgpfucbSort[0] = m_rgpfucbSort[ipfucb];
+                    m_rgpfucbSort[ipfucb] = pfucbT;
+                }
+            }
+
+            if ( m_fUnique )
+            {
+                for ( ULONG ipfucb = m_cpfucbSort - 1; ipfucb > 0; ipfucb-- )
+                {
+                    while ( ipfucb < m_cpfucbSort
+                        && 0 == CmpKey( m_rgpfucbSort[ipfucb]->kdfCurr.key, m_rgpfucbSort[0]->kdfCurr.key ) )
+                    {
+                        CallR( ErrIAdvance( ipfucb ) );
+                    }
+                }
+            }
+
+            return JET_errSuccess;
+        }
+
+    private:
+        FUCB *      m_rgpfucbSort[cFILEIndexBuildPartitionMax];
+        ULONG       m_cpfucbSort;
+        const BOOL  m_fUnique;
+};
+
+
 INLINE ERR ErrFILEIAppendToIndex(
-    FUCB        * const pfucbSort,
+    CFILEIndexSortMerge * const pmerge,
     FUCB        * const pfucbIndex,
     ULONG       *pcRecOutput,
     const BOOL  fLogged )
@@ -3744,13 +3843,13 @@ INLINE ERR ErrFILEIAppendToIndex(
 
         CallR( ErrDIRAppend(
                     pfucbIndex,
-                    pfucbSort->kdfCurr.key,
-                    pfucbSort->kdfCurr.data,
+                    pmerge->KdfCurr().key,
+                    pmerge->KdfCurr().data,
                     fDIRFlags ) );
         Assert( Pcsr( pfucbIndex )->FLatched() );
         (*pcRecOutput)++;
 
-        err = ErrSORTNext( pfucbSort );
+        err = pmerge->ErrNext();
     }
     while ( err >= 0 );
 
@@ -3785,7 +3884,7 @@ LOCAL VOID FILEIReportIndexCorrupt( FUCB * const pfucbIndex, CPRINTF * const pcp
 
 
 INLINE ERR ErrFILEICheckIndex(
-    FUCB    * const pfucbSort,
+    CFILEIndexSortMerge * const pmerge,
     FUCB    * const pfucbIndex,
     ULONG   *pcRecSeen,
     BOOL    *pfCorruptedIndex,
@@ -3809,7 +3908,7 @@ INLINE ERR ErrFILEICheckIndex(
 
         Assert( Pcsr( pfucbIndex )->FLatched() );
 
-        INT cmp = CmpKeyData( pfucbIndex->kdfCurr, pfucbSort->kdfCurr );
+        INT cmp = CmpKeyData( pfucbIndex->kdfCurr, pmerge->KdfCurr() );
         if( 0 != cmp )
         {
             FILEIReportIndexCorrupt( pfucbIndex, pcprintf );
@@ -3853,9 +3952,9 @@ INLINE ERR ErrFILEICheckIndex(
             }
             (*pcprintf)( "\tdata in database (%d bytes):%s\r\n", ibMax, rgchBuf );
 
-            pfucbSort->kdfCurr.key.CopyIntoBuffer( rgbKey, sizeof( rgbKey ) );
+            pmerge->KdfCurr().key.CopyIntoBuffer( rgbKey, sizeof( rgbKey ) );
             pb = rgbKey;
-            ibMax = pfucbSort->kdfCurr.key.Cb();
+            ibMax = pmerge->KdfCurr().key.Cb();
             pchBuf = rgchBuf;
             cbBufLeft = sizeof(rgchBuf);
             for( ib = 0; ib < ibMax && cbBufLeft > 0; ++ib )
@@ -3866,8 +3965,8 @@ INLINE ERR ErrFILEICheckIndex(
             }
             (*pcprintf)( "\tcalculated key (%d bytes):%s\r\n", ibMax, rgchBuf );
 
-            pb = (BYTE*)pfucbSort->kdfCurr.data.Pv();
-            ibMax = pfucbSort->kdfCurr.data.Cb();
+            pb = (BYTE*)pmerge->KdfCurr().data.Pv();
+            ibMax = pmerge->KdfCurr().data.Cb();
             pchBuf = rgchBuf;
             cbBufLeft = sizeof(rgchBuf);
             for( ib = 0; ib < ibMax && cbBufLeft > 0; ++ib )
@@ -3892,7 +3991,7 @@ INLINE ERR ErrFILEICheckIndex(
         if( err < 0 )
         {
             if ( JET_errNoCurrentRecord == err
-                && JET_errNoCurrentRecord != ErrSORTNext( pfucbSort ) )
+                && JET_errNoCurrentRecord != pmerge->ErrNext() )
             {
                 FILEIReportIndexCorrupt( pfucbIndex, pcprintf );
                 (*pcprintf)( "real index has fewer (%d) srecords\r\n", *pcRecSeen );
@@ -3902,7 +4001,7 @@ INLINE ERR ErrFILEICheckIndex(
         }
         else
         {
-            err = ErrSORTNext( pfucbSort );
+            err = pmerge->ErrNext();
             if( JET_errNoCurrentRecord == err )
             {
                 FILEIReportIndexCorrupt( pfucbIndex, pcprintf );
@@ -3931,6 +4030,8 @@ LOCAL ERR ErrFILESingleIndexTerm(
     FCB         * const pfcbIndex,
     ULONG       * const rgcRecInput,
     const ULONG iindex,
+    const ULONG cPartition,
+    const ULONG cSortStride,
     BOOL        *pfCorruptionEncountered,
     CPRINTF     * const pcprintf,
     const BOOL  fLogged )
@@ -3940,9 +4041,11 @@ LOCAL ERR ErrFILESingleIndexTerm(
     ERR         err             = JET_errSuccess;
     FUCB        *pfucbIndex     = pfucbNil;
     const BOOL  fUnique         = pfcbIndex->Pidb()->FUnique();
+    ULONG       cRecInput       = 0;
     ULONG       cRecOutput      = 0;
     BOOL        fEntriesExist   = fTrue;
     BOOL        fCorruptedIndex = fFalse;
+    CFILEIndexSortMerge merge( &rgpfucbSort[iindex], cPartition, cSortStride, fUnique );
 
     Assert( pfcbIndex->FTypeSecondaryIndex() );
     Assert( pidbNil != pfcbIndex->Pidb() );
@@ -3953,7 +4056,12 @@ LOCAL ERR ErrFILESingleIndexTerm(
     OSTrace( tracetagIndexPerf, OSFormat( "About to sort keys for index %d.\n", iindex+1 ) );
 #endif
 
-    Call( ErrSORTEndInsert( rgpfucbSort[iindex] ) );
+    for ( ULONG ipartition = 0; ipartition < cPartition; ipartition++ )
+    {
+        const ULONG isort = ipartition * cSortStride + iindex;
+        Call( ErrSORTEndInsert( rgpfucbSort[isort] ) );
+        cRecInput += rgcRecInput[isort];
+    }
 
 #ifdef SHOW_INDEX_PERF
     OSTrace( tracetagIndexPerf, OSFormat(   "Sorted keys for index %d in %d msecs.\n",
@@ -3961,7 +4069,7 @@ LOCAL ERR ErrFILESingleIndexTerm(
                                         TickOSTimeCurrent() - tickStart ) );
 #endif
 
-    err = ErrSORTNext( rgpfucbSort[iindex] );
+    err = merge.ErrFirst();
     if ( err < 0 )
     {
         if ( JET_errNoCurrentRecord != err )
@@ -3969,7 +4077,7 @@ LOCAL ERR ErrFILESingleIndexTerm(
 
         err = JET_errSuccess;
 
-        Assert( rgcRecInput[iindex] == 0 );
+        Assert( cRecInput == 0 );
         fEntriesExist = fFalse;
     }
 
@@ -3986,7 +4094,7 @@ LOCAL ERR ErrFILESingleIndexTerm(
         {
             Assert( NULL != pcprintf );
             Call( ErrFILEICheckIndex(
-                        rgpfucbSort[iindex],
+                        &merge,
                         pfucbIndex,
                         &cRecOutput,
                         &fCorruptedIndex,
@@ -4001,7 +4109,7 @@ LOCAL ERR ErrFILESingleIndexTerm(
 #endif
 
             Call( ErrFILEIAppendToIndex(
-                        rgpfucbSort[iindex],
+                        &merge,
                         pfucbIndex,
                         &cRecOutput,
                         fLogged ) );
@@ -4028,13 +4136,17 @@ LOCAL ERR ErrFILESingleIndexTerm(
 #endif
     }
 
-    SORTClose( rgpfucbSort[iindex] );
-    rgpfucbSort[iindex] = pfucbNil;
+    for ( ULONG ipartition = 0; ipartition < cPartition; ipartition++ )
+    {
+        const ULONG isort = ipartition * cSortStride + iindex;
+        SORTClose( rgpfucbSort[isort] );
+        rgpfucbSort[isort] = pfucbNil;
+    }
 
-    Assert( cRecOutput <= rgcRecInput[iindex] );
-    if ( cRecOutput != rgcRecInput[iindex] )
+    Assert( cRecOutput <= cRecInput );
+    if ( cRecOutput != cRecInput )
     {
-        if ( cRecOutput < rgcRecInput[iindex] && !fUnique )
+        if ( cRecOutput < cRecInput && !fUnique )
         {
         }
 
@@ -4044,19 +4156,19 @@ LOCAL ERR ErrFILESingleIndexTerm(
 
             if ( !fCorruptedIndex )
             {
-                if ( cRecOutput > rgcRecInput[iindex] )
+                if ( cRecOutput > cRecInput )
                 {
                     (*pcprintf)( "Too many index keys generated\n" );
                 }
                 else
                 {
                     Assert( fUnique );
-                    (*pcprintf)( "%d duplicate key(s) on unique index\n", rgcRecInput[iindex] - cRecOutput );
+                    (*pcprintf)( "%d duplicate key(s) on unique index\n", cRecInput - cRecOutput );
                 }
             }
         }
 
-        else if ( cRecOutput > rgcRecInput[iindex] )
+        else if ( cRecOutput > cRecInput )
         {
             err = ErrERRCheck( JET_errIndexBuildCorrupted );
             goto HandleError;
@@ -4064,7 +4176,7 @@ LOCAL ERR ErrFILESingleIndexTerm(
 
         else
         {
-            Assert( cRecOutput < rgcRecInput[iindex] );
+            Assert( cRecOutput < cRecInput );
             Assert( fUnique );
 
             err = ErrERRCheck( JET_errKeyDuplicate );
@@ -4107,6 +4219,8 @@ ERR ErrFILEIndexBatchTerm(
                         pfcbIndex,
                         rgcRecInput,
                         iindex,
+                        1,
+                        0,
                         pfCorruptionEncountered,
                         pcprintf,
                         fFalse ) );
@@ -4130,6 +4244,8 @@ struct CREATEINDEXCONTEXT
     FUCB *          pfucbTable;
     FUCB **         rgpfucbSort;
     ULONG *         rgcRecInput;
+    ULONG           cPartition;
+    ULONG           cSortStride;
     DATA            dataBMBuffer;
     KEY             keyBuffer;
     STATUSINFO  *   pstatus;
@@ -4163,6 +4279,8 @@ LOCAL VOID ErrFILEIndexDispatchAddEntries(
 {
     CREATEINDEXCONTEXT * const  pidxcontext     = (CREATEINDEXCONTEXT *)dwParam1;
     CSR * const                 pcsr            = (CSR *)dwParam3;
+    const INT                   ilineStart      = (INT)( dwParam2 & 0xFFFF );
+    const INT                   ilineMax        = (INT)( dwParam2 >> 16 );
     KEYDATAFLAGS                kdf;
     LONG                        cEntriesAdded;
 
@@ -4173,9 +4291,10 @@ LOCAL VOID ErrFILEIndexDispatchAddEntries(
 
     if ( JET_errSuccess == pidxcontext->err )
     {
-        const INT   ilineMax    = pcsr->Cpage().Clines();
+        Assert( ilineStart < ilineMax );
+        Assert( ilineMax <= pcsr->Cpage().Clines() );
 
-        for ( pcsr->SetILine( 0 ); pcsr->ILine() < ilineMax; pcsr->IncrementILine() )
+        for ( pcsr->SetILine( ilineStart ); pcsr->ILine() < ilineMax; pcsr->IncrementILine() )
         {
             Assert( pcsr->FLatched() );
             NDIGetKeydataflags( pcsr->Cpage(), pcsr->ILine(), &kdf );
@@ -4248,6 +4367,8 @@ LOCAL VOID ErrFILEIndexDispatchSortTerm(
                                         pfcbcontext->pfcbIndex,
                                         pidxcontext->rgcRecInput,
                                         pfcbcontext->iindex,
+                                        pidxcontext->cPartition,
+                                        pidxcontext->cSortStride,
                                         pidxcontext->fCheckOnly ? &fCorrupt : NULL,
                                         pidxcontext->pcprintf,
                                         pidxcontext->fLogged );
@@ -4319,6 +4440,9 @@ INLINE VOID FILEIPossiblyWaitForDispatchedTasks( const CREATEINDEXCONTEXT * cons
 
     CallS( ErrBFGetCacheSize( &cbfCacheT ) );
 
+    //  every partition pins pages for its own task managers
+    cbfCacheT /= pidxcontext->cPartition;
+
     if ( cTasksPending > SIZE_T( cbfCacheT * 2 / 3  ) )
     {
         ULONG   csecWait    = 1;
@@ -4343,6 +4467,389 @@ INLINE VOID FILEIPossiblyWaitForDispatchedTasks( const CREATEINDEXCONTEXT * cons
     }
 }
 
+LOCAL INT IlineFILEIFirstKeyGE( CSR * const pcsr, const KEY& key, INT iline )
+{
+    KEYDATAFLAGS    kdf;
+    const INT       clines  = pcsr->Cpage().Clines();
+
+    for ( ; iline < clines; iline++ )
+    {
+        NDIGetKeydataflags( pcsr->Cpage(), iline, &kdf );
+        if ( CmpKey( kdf.key, key ) >= 0 )
+        {
+            break;
+        }
+    }
+
+    return iline;
+}
+
+//  Walks the leaf pages of the primary index from pkeyStart (or the first node) up to, but
+//  not including, pkeyLimit and posts every page, trimmed to that key range, to each of the
+//  partition's task managers.
+
+LOCAL ERR ErrFILEIScanIndexPartition(
+    PIB * const                 ppib,
+    FUCB * const                pfucbTable,
+    const KEY * const           pkeyStart,
+    const KEY * const           pkeyLimit,
+    CREATEINDEXCONTEXT * const  rgidxcontext,
+    const ULONG                 cidxcontext,
+    volatile BOOL * const       pfCancel )
+{
+    ERR                         err;
+    INST * const                pinst           = PinstFromPfucb( pfucbTable );
+    CSR * const                 pcsrTable       = Pcsr( pfucbTable );
+    CSR *                       pcsrT           = pcsrNil;
+    BOOL                        fFirstPage      = fTrue;
+    BOOL                        fLastPage       = fFalse;
+    KEYDATAFLAGS                kdf;
+    BOOKMARK                    bm;
+    DIB                         dib;
+
+    if ( NULL == pkeyStart )
+    {
+        dib.pos     = posFirst;
+        dib.pbm     = NULL;
+        dib.dirflag = fDIRNull;
+    }
+    else
+    {
+        bm.key      = *pkeyStart;
+        bm.data.Nullify();
+
+        dib.pos     = posDown;
+        dib.pbm     = &bm;
+        dib.dirflag = fDIRAllNode;
+    }
+
+    FUCBSetPrereadForward( pfucbTable, cpgPrereadSequential );
+    err = ErrBTDown( pfucbTable, &dib, latchReadTouch );
+    if ( JET_errRecordNotFound == err )
+    {
+        err = JET_errSuccess;
+        goto HandleError;
+    }
+    Call( err );
+
+    pfucbTable->locLogical = locOnCurBM;
+
+    while ( !fLastPage )
+    {
+        Assert( pcsrTable->FLatched() );
+
+        const INT   clines      = pcsrTable->Cpage().Clines();
+        INT         ilineStart  = 0;
+        INT         ilineMax    = clines;
+
+        if ( fFirstPage && NULL != pkeyStart )
+        {
+            ilineStart = IlineFILEIFirstKeyGE( pcsrTable, *pkeyStart, 0 );
+        }
+        if ( NULL != pkeyLimit )
+        {
+            NDIGetKeydataflags( pcsrTable->Cpage(), clines - 1, &kdf );
+            if ( CmpKey( kdf.key, *pkeyLimit ) >= 0 )
+            {
+                ilineMax = IlineFILEIFirstKeyGE( pcsrTable, *pkeyLimit, ilineStart );
+                fLastPage = fTrue;
+            }
+        }
+        fFirstPage = fFalse;
+
+        for ( ULONG iProc = 0; iProc < cidxcontext && ilineStart < ilineMax; iProc++ )
+        {
+            CREATEINDEXCONTEXT * const  pidxcontext     = rgidxcontext + iProc;
+
+            Call( pidxcontext->err );
+
+            if ( NULL != pfCancel && *pfCancel )
+            {
+                goto HandleError;
+            }
+
+            Call( pinst->ErrCheckForTermination() );
+
+            Call( pinst->m_plog->ErrLGCheckState() );
+
+            Alloc( pcsrT = new CSR );
+
+            CLockDeadlockDetectionInfo::DisableOwnershipTracking();
+            Call( pcsrT->ErrGetReadPage(
+                            ppib,
+                            pfucbTable->ifmp,
+                            pcsrTable->Pgno(),
+                            bflfNoTouch,
+                            pcsrTable->Cpage().PBFLatch() ) );
+            CLockDeadlockDetectionInfo::EnableOwnershipTracking();
+
+            Call( pidxcontext->taskmgrCreateIndex.ErrTMPost(
+                                    ErrFILEIndexDispatchAddEntries,
+                                    DWORD( ilineStart | ( ilineMax << 16 ) ),
+                                    (DWORD_PTR)pcsrT ) );
+
+            pcsrT = pcsrNil;
+
+            FILEIPossiblyWaitForDispatchedTasks( pidxcontext, iProc );
+        }
+
+        if ( !fLastPage )
+        {
+            pcsrTable->SetILine( clines - 1 );
+#ifdef DEBUG
+            NDGet( pfucbTable );
+#endif
+
+            Assert( pcsrTable->FLatched() );
+            err = ErrBTNext( pfucbTable, fDIRNull );
+            if ( JET_errNoCurrentRecord == err )
+            {
+                err = JET_errSuccess;
+                break;
+            }
+            Call( err );
+        }
+    }
+
+    err = JET_errSuccess;
+
+HandleError:
+    if ( pcsrNil != pcsrT )
+    {
+        Assert( err < JET_errSuccess );
+        CLockDeadlockDetectionInfo::DisableOwnershipTracking();
+        pcsrT->ReleasePage();
+        CLockDeadlockDetectionInfo::EnableOwnershipTracking();
+        delete pcsrT;
+    }
+
+    FUCBResetPreread( pfucbTable );
+    BTUp( pfucbTable );
+    return err;
+}
+
+//  With "Parallel Build Partitions" set, the primary index is split into key ranges and
+//  every range is scanned by its own session and cursor, feeding its own set of sorts.
+//  The per-index sorts of all partitions are merged again when the sorts are terminated.
+
+struct FILEINDEXPARTITION
+{
+    PIB *                   ppib;
+    FUCB *                  pfucbTable;
+    const KEY *             pkeyStart;
+    const KEY *             pkeyLimit;
+    CREATEINDEXCONTEXT *    rgidxcontext;
+    ULONG                   cidxcontext;
+    volatile BOOL *         pfCancel;
+    THREAD                  thread;
+    ERR                     err;
+};
+
+struct FILEINDEXPARTITIONS
+{
+    ULONG               cPartition;
+    volatile BOOL       fCancel;
+    KEY                 rgkeyBoundary[cFILEIndexBuildPartitionMax - 1];
+    BYTE                rgbKeyBoundary[cFILEIndexBuildPartitionMax - 1][cbKeyAlloc];
+    FILEINDEXPARTITION  rgpartition[cFILEIndexBuildPartitionMax];
+};
+
+LOCAL ULONG CFILEIIndexBuildPartitions( PIB * const ppib, FUCB * const pfucbTable, const BOOL fCheckOnly )
+{
+    WCHAR   wszBuf[16];
+    ULONG   cPartition;
+
+    if ( fCheckOnly
+        || g_fRepair
+        || FFMPIsTempDB( pfucbTable->ifmp )
+        || !pfucbTable->u.pfcb->FDomainDenyReadByUs( ppib ) )
+    {
+        return 1;
+    }
+
+    cPartition = (ULONG)UlConfigOverrideInjection( 47196, 0 );
+    if ( 0 == cPartition
+        && FOSConfigGet( L"INDEX", L"Parallel Build Partitions", wszBuf, sizeof( wszBuf ) )
+        && wszBuf[0] )
+    {
+        cPartition = (ULONG)max( 0, _wtol( wszBuf ) );
+    }
+
+    return ( cPartition > 1 ) ? min( cFILEIndexBuildPartitionMax, cPartition ) : 1;
+}
+
+LOCAL ERR ErrFILEIIndexPartitionBoundaries( FUCB * const pfucbTable, FILEINDEXPARTITIONS * const ppartitions )
+{
+    ERR         err             = JET_errSuccess;
+    const ULONG cPartitionMax   = ppartitions->cPartition;
+    ULONG       ckey            = 0;
+    DIB         dib;
+    FRAC        frac;
+
+    dib.pos     = posFrac;
+    dib.pbm     = reinterpret_cast<BOOKMARK *>( &frac );
+    dib.dirflag = fDIRNull;
+
+    frac.ulTotal = cPartitionMax;
+
+    for ( ULONG ipartition = 1; ipartition < cPartitionMax; ipartition++ )
+    {
+        frac.ulLT = ipartition;
+
+        err = ErrBTDown( pfucbTable, &dib, latchReadNoTouch );
+        if ( JET_errRecordNotFound == err )
+        {
+            err = JET_errSuccess;
+            break;
+        }
+        Call( err );
+
+        KEY * const pkey = &ppartitions->rgkeyBoundary[ckey];
+        pkey->prefix.Nullify();
+        pkey->suffix.SetPv( ppartitions->rgbKeyBoundary[ckey] );
+        pkey->suffix.SetCb( pfucbTable->kdfCurr.key.Cb() );
+        pfucbTable->kdfCurr.key.CopyIntoBuffer( ppartitions->rgbKeyBoundary[ckey], cbKeyAlloc );
+        BTUp( pfucbTable );
+
+        //  small tables yield repeated positions, which just means fewer partitions
+        if ( 0 == ckey || CmpKey( ppartitions->rgkeyBoundary[ckey - 1], *pkey ) < 0 )
+        {
+            ckey++;
+        }
+    }
+
+    ppartitions->cPartition = ckey + 1;
+
+HandleError:
+    BTUp( pfucbTable );
+    return err;
+}
+
+LOCAL DWORD DwFILEIIndexPartitionThreadProc( DWORD_PTR dwContext )
+{
+    FILEINDEXPARTITION * const  ppartition  = (FILEINDEXPARTITION *)dwContext;
+    PIB * const                 ppib        = ppartition->ppib;
+
+    ppib->SetUserTraceContextInTls();
+    {
+        PIBTraceContextScope tcScope = ppib->InitTraceContextScope();
+        tcScope->nParentObjectClass = TceFromFUCB( ppartition->pfucbTable );
+        tcScope->SetDwEngineObjid( ObjidFDP( ppartition->pfucbTable ) );
+
+        ppartition->err = ErrFILEIScanIndexPartition(
+                                ppib,
+                                ppartition->pfucbTable,
+                                ppartition->pkeyStart,
+                                ppartition->pkeyLimit,
+                                ppartition->rgidxcontext,
+                                ppartition->cidxcontext,
+                                ppartition->pfCancel );
+    }
+    ppib->ClearUserTraceContextInTls();
+
+    return 0;
+}
+
+LOCAL ERR ErrFILEIIndexPartitionsInit( PIB * const ppib, FUCB * const pfucbTable, FILEINDEXPARTITIONS * const ppartitions )
+{
+    ERR             err     = JET_errSuccess;
+    INST * const    pinst   = PinstFromPfucb( pfucbTable );
+
+    for ( ULONG ipartition = 0; ipartition < ppartitions->cPartition; ipartition++ )
+    {
+        FILEINDEXPARTITION * const ppartition = &ppartitions->rgpartition[ipartition];
+
+        ppartition->pkeyStart   = ( 0 == ipartition ? NULL : &ppartitions->rgkeyBoundary[ipartition - 1] );
+        ppartition->pkeyLimit   = ( ppartitions->cPartition - 1 == ipartition ? NULL : &ppartitions->rgkeyBoundary[ipartition] );
+        ppartition->pfCancel    = &ppartitions->fCancel;
+
+        //  the calling session scans the first range on its own cursor
+        if ( 0 == ipartition )
+        {
+            ppartition->ppib        = ppib;
+            ppartition->pfucbTable  = pfucbTable;
+            continue;
+        }
+
+        Call( ErrPIBBeginSession( pinst, &ppartition->ppib, procidNil, fFalse ) );
+        Call( ErrDIRBeginTransaction( ppartition->ppib, 52517, JET_bitTransactionReadOnly ) );
+        Call( ErrDIROpen( ppartition->ppib, pfucbTable->u.pfcb, &ppartition->pfucbTable ) );
+        FUCBSetIndex( ppartition->pfucbTable );
+    }
+
+HandleError:
+    return err;
+}
+
+LOCAL ERR ErrFILEIIndexPartitionsStart( FILEINDEXPARTITIONS * const ppartitions )
+{
+    ERR err = JET_errSuccess;
+
+    for ( ULONG ipartition = 1; ipartition < ppartitions->cPartition; ipartition++ )
+    {
+        FILEINDEXPARTITION * const ppartition = &ppartitions->rgpartition[ipartition];
+
+        Assert( NULL == ppartition->thread );
+        ppartition->err = JET_errSuccess;
+
+        Call( ErrUtilThreadCreate(
+                    DwFILEIIndexPartitionThreadProc,
+                    0,
+                    priorityNormal,
+                    &ppartition->thread,
+                    (DWORD_PTR)ppartition ) );
+    }
+
+HandleError:
+    return err;
+}
+
+LOCAL ERR ErrFILEIIndexPartitionsWait( FILEINDEXPARTITIONS * const ppartitions )
+{
+    ERR err = JET_errSuccess;
+
+    for ( ULONG ipartition = 1; ipartition < ppartitions->cPartition; ipartition++ )
+    {
+        FILEINDEXPARTITION * const ppartition = &ppartitions->rgpartition[ipartition];
+
+        if ( NULL != ppartition->thread )
+        {
+            UtilThreadEnd( ppartition->thread );
+            ppartition->thread = NULL;
+
+            if ( ppartition->err < JET_errSuccess && err >= JET_errSuccess )
+            {
+                err = ppartition->err;
+            }
+        }
+    }
+
+    return err;
+}
+
+LOCAL VOID FILEIIndexPartitionsTerm( FILEINDEXPARTITIONS * const ppartitions )
+{
+    for ( ULONG ipartition = 1; ipartition < ppartitions->cPartition; ipartition++ )
+    {
+        FILEINDEXPARTITION * const ppartition = &ppartitions->rgpartition[ipartition];
+
+        Assert( NULL == ppartition->thread );
+
+        if ( pfucbNil != ppartition->pfucbTable )
+        {
+            DIRClose( ppartition->pfucbTable );
+        }
+        if ( ppibNil != ppartition->ppib )
+        {
+            if ( ppartition->ppib->Level() > 0 )
+            {
+                CallS( ErrDIRCommitTransaction( ppartition->ppib, NO_GRBIT ) );
+            }
+            PIBEndSession( ppartition->ppib );
+        }
+    }
+}
+
 ERR ErrFILEBuildAllIndexes(
     PIB * const             ppib,
     FUCB * const            pfucbTable,
@@ -4356,19 +4863,21 @@ ERR ErrFILEBuildAllIndexes(
     DIB                     dib;
     INST *                  pinst                       = PinstFromPpib( ppib );
     ULONG                   cProcs                      = 0;
+    ULONG                   cPartition                  = 1;
+    ULONG                   cidxcontext                 = 0;
     ULONG                   cIndexBatchMax              = 0;
     DWORD_PTR               cSCBMax                     = 0;
     DWORD_PTR               cSCBInUse                   = 0;
-    CSR *                   pcsrTable                   = Pcsr( pfucbTable );
     CREATEINDEXCONTEXT *    rgidxcontext                = NULL;
+    FILEINDEXPARTITIONS *   ppartitions                 = NULL;
     FUCB **                 rgpfucbSort                 = NULL;
     FCB *                   pfcbIndexesToBuild          = NULL;
     FCB *                   pfcbNextBuildIndex          = NULL;
     ULONG                   cIndexesToBuild             = 0;
     BOOL                    fTransactionStarted         = fFalse;
     BOOL                    fCorruptionEncountered      = fFalse;
-    CSR *                   pcsrT                       = pcsrNil;
     ULONG                   iProc                       = 0;
+    ULONG                   ipartition                  = 0;
     ULONG_PTR               ulCacheSizeMaxSave          = 0;
     ULONG_PTR               ulStartFlushThresholdSave   = 0;
     ULONG_PTR               ulStopFlushThresholdSave    = 0;
@@ -4481,7 +4990,26 @@ ERR ErrFILEBuildAllIndexes(
         }
     }
 
-    cProcs = min( CUtilProcessProcessor(), cIndexBatchMax );
+    cPartition = CFILEIIndexBuildPartitions( ppib, pfucbTable, fCheckOnly );
+    if ( cPartition > 1 )
+    {
+        Alloc( ppartitions = (FILEINDEXPARTITIONS *)PvOSMemoryHeapAlloc( sizeof( FILEINDEXPARTITIONS ) ) );
+        memset( ppartitions, 0, sizeof( FILEINDEXPARTITIONS ) );
+        ppartitions->cPartition = cPartition;
+
+        Call( ErrFILEIIndexPartitionBoundaries( pfucbTable, ppartitions ) );
+        Call( ErrFILEIIndexPartitionsInit( ppib, pfucbTable, ppartitions ) );
+        cPartition = ppartitions->cPartition;
+
+        //  every partition opens its own sort per index and gets its share of the processors
+        cIndexBatchMax = max( 1, cIndexBatchMax / cPartition );
+        cProcs = min( max( 1, CUtilProcessProcessor() / cPartition ), cIndexBatchMax );
+    }
+    else
+    {
+        cProcs = min( CUtilProcessProcessor(), cIndexBatchMax );
+    }
+    cidxcontext = cProcs * cPartition;
 
     if( pfcbNil == pfucbTable->u.pfcb->Ptdb()->PfcbLV() )
     {
@@ -4506,25 +5034,24 @@ ERR ErrFILEBuildAllIndexes(
         }
     }
 
-    Alloc( rgidxcontext = (CREATEINDEXCONTEXT *)PvOSMemoryHeapAlloc( ( sizeof(CREATEINDEXCONTEXT) + sizeof(CREATEINDEXCONTEXT *) + cbKeyAlloc + cbKeyAlloc ) * cProcs ) );
-    memset( rgidxcontext, 0, sizeof(CREATEINDEXCONTEXT) * cProcs );
+    Alloc( rgidxcontext = (CREATEINDEXCONTEXT *)PvOSMemoryHeapAlloc( ( sizeof(CREATEINDEXCONTEXT) + sizeof(CREATEINDEXCONTEXT *) + cbKeyAlloc + cbKeyAlloc ) * cidxcontext ) );
+    memset( rgidxcontext, 0, sizeof(CREATEINDEXCONTEXT) * cidxcontext );
 
-    Alloc( rgpfucbSort = (FUCB **)PvOSMemoryHeapAlloc( ( sizeof(FUCB *) + sizeof(ULONG) ) * cIndexBatchMax ) );
-    memset( rgpfucbSort, 0, sizeof(FUCB *) * cIndexBatchMax );
+    Alloc( rgpfucbSort = (FUCB **)PvOSMemoryHeapAlloc( ( sizeof(FUCB *) + sizeof(ULONG) ) * cIndexBatchMax * cPartition ) );
+    memset( rgpfucbSort, 0, sizeof(FUCB *) * cIndexBatchMax * cPartition );
 
-    CREATEINDEXCONTEXT **   rgpidxcontext   = (CREATEINDEXCONTEXT **)( (BYTE *)rgidxcontext + ( sizeof(CREATEINDEXCONTEXT) * cProcs ) );
-    BYTE * const            rgbBMBuffer     = (BYTE *)rgpidxcontext + ( sizeof(CREATEINDEXCONTEXT *) * cProcs );
-    BYTE * const            rgbKeyBuffer    = rgbBMBuffer + ( cbKeyAlloc * cProcs );
+    CREATEINDEXCONTEXT **   rgpidxcontext   = (CREATEINDEXCONTEXT **)( (BYTE *)rgidxcontext + ( sizeof(CREATEINDEXCONTEXT) * cidxcontext ) );
+    BYTE * const            rgbBMBuffer     = (BYTE *)rgpidxcontext + ( sizeof(CREATEINDEXCONTEXT *) * cidxcontext );
+    BYTE * const            rgbKeyBuffer    = rgbBMBuffer + ( cbKeyAlloc * cidxcontext );
 
-    ULONG *                 rgcRecInput     = (ULONG *)( (BYTE *)rgpfucbSort + ( sizeof(FUCB *) * cIndexBatchMax ) );
+    ULONG *                 rgcRecInput     = (ULONG *)( (BYTE *)rgpfucbSort + ( sizeof(FUCB *) * cIndexBatchMax * cPartition ) );
 
 
     dib.pos     = posFirst;
     dib.pbm     = NULL;
     dib.dirflag = fDIRNull;
 
-    FUCBSetPrereadForward( pfucbTable, cpgPrereadSequential );
-    err = ErrBTDown( pfucbTable, &dib, latchReadTouch );
+    err = ErrBTDown( pfucbTable, &dib, latchReadNoTouch );
     Assert( JET_errNoCurrentRecord != err );
     if ( err < JET_errSuccess )
     {
@@ -4534,15 +5061,17 @@ ERR ErrFILEBuildAllIndexes(
         }
         goto HandleError;
     }
+    BTUp( pfucbTable );
 
     Assert( pfucbNil == pfucbTable->pfucbCurIndex );
 
     Assert( pfcbNil != pfcbIndexes );
 
 
-    for ( iProc = 0; iProc < cProcs; iProc++ )
+    for ( iProc = 0; iProc < cidxcontext; iProc++ )
     {
         CREATEINDEXCONTEXT *    pidxcontext     = rgidxcontext + iProc;
+        const ULONG             isortPartition  = ( iProc / cProcs ) * cIndexBatchMax;
         FUCB *                  pfucbT;
 
         new( &pidxcontext->taskmgrCreateIndex ) CTaskManager;
@@ -4559,8 +5088,10 @@ ERR ErrFILEBuildAllIndexes(
         FUCBSetMayCacheLVCursor( pfucbT );
 
         pidxcontext->pfucbTable = pfucbT;
-        pidxcontext->rgpfucbSort = rgpfucbSort;
-        pidxcontext->rgcRecInput = rgcRecInput;
+        pidxcontext->rgpfucbSort = rgpfucbSort + isortPartition;
+        pidxcontext->rgcRecInput = rgcRecInput + isortPartition;
+        pidxcontext->cPartition = cPartition;
+        pidxcontext->cSortStride = cIndexBatchMax;
         pidxcontext->dataBMBuffer.SetCb( cbKeyAlloc );
         pidxcontext->dataBMBuffer.SetPv( rgbBMBuffer + ( cbKeyAlloc * iProc ) );
         pidxcontext->keyBuffer.suffix.SetCb( cbKeyAlloc );
@@ -4576,64 +5107,65 @@ ERR ErrFILEBuildAllIndexes(
 
 NextBuild:
 #ifdef SHOW_INDEX_PERF
-    ULONG   cRecs, cPages;
     TICK    tickStart;
-    cRecs = 0;
-    cPages  = 0;
     tickStart   = TickOSTimeCurrent();
 #endif
 
-    pfucbTable->locLogical = locOnCurBM;
-
     pfcbIndexesToBuild = pfcbNextBuildIndex;
     pfcbNextBuildIndex = pfcbNil;
 
-    Call( ErrFILEIndexBatchInit(
-                ppib,
-                rgpfucbSort,
-                pfcbIndexesToBuild,
-                &cIndexesToBuild,
-                rgcRecInput,
-                &pfcbNextBuildIndex,
-                cIndexBatchMax ) );
+    for ( ipartition = 0; ipartition < cPartition; ipartition++ )
+    {
+        Call( ErrFILEIndexBatchInit(
+                    ppib,
+                    rgpfucbSort + ipartition * cIndexBatchMax,
+                    pfcbIndexesToBuild,
+                    &cIndexesToBuild,
+                    rgcRecInput + ipartition * cIndexBatchMax,
+                    0 == ipartition ? &pfcbNextBuildIndex : NULL,
+                    cIndexBatchMax ) );
+    }
 
     Assert( cIndexBatchMax == cIndexesToBuild
         || pfcbNil == pfcbNextBuildIndex );
 
     ULONG   cProcsCurrBatch;
-    ULONG   iindexNext;
-    FCB *   pfcbIndexesRemaining;
 
     cProcsCurrBatch = min( cProcs, cIndexesToBuild );
-    iindexNext = 0;
-    pfcbIndexesRemaining = pfcbIndexesToBuild;
 
-    for ( iProc = 0; iProc < cProcsCurrBatch; iProc++ )
+    for ( ipartition = 0; ipartition < cPartition; ipartition++ )
     {
-        Assert( iindexNext < cIndexesToBuild );
+        ULONG   iindexNext              = 0;
+        FCB *   pfcbIndexesRemaining    = pfcbIndexesToBuild;
 
-        const ULONG             cIndexesRemaining   = cIndexesToBuild - iindexNext;
-        const ULONG             cProcsRemaining     = cProcsCurrBatch - iProc;
-        ULONG                   cIndexesThisProc    = ( cIndexesRemaining + cProcsRemaining - 1 ) / cProcsRemaining;
-        CREATEINDEXCONTEXT *    pidxcontext         = rgidxcontext + iProc;
+        for ( iProc = 0; iProc < cProcsCurrBatch; iProc++ )
+        {
+            Assert( iindexNext < cIndexesToBuild );
 
-        Assert( cIndexesThisProc > 0 );
+            const ULONG             icontext            = ipartition * cProcs + iProc;
+            const ULONG             cIndexesRemaining   = cIndexesToBuild - iindexNext;
+            const ULONG             cProcsRemaining     = cProcsCurrBatch - iProc;
+            ULONG                   cIndexesThisProc    = ( cIndexesRemaining + cProcsRemaining - 1 ) / cProcsRemaining;
+            CREATEINDEXCONTEXT *    pidxcontext         = rgidxcontext + icontext;
 
-        Call( pidxcontext->taskmgrCreateIndex.ErrTMInit( 1, (DWORD_PTR *)( rgpidxcontext + iProc ) ) );
+            Assert( cIndexesThisProc > 0 );
 
-        pidxcontext->iindexStart = iindexNext;
-        pidxcontext->cIndexesToBuild = cIndexesThisProc;
-        pidxcontext->pfcbIndexesToBuild = pfcbIndexesRemaining;
+            Call( pidxcontext->taskmgrCreateIndex.ErrTMInit( 1, (DWORD_PTR *)( rgpidxcontext + icontext ) ) );
 
-        iindexNext += cIndexesThisProc;
+            pidxcontext->iindexStart = iindexNext;
+            pidxcontext->cIndexesToBuild = cIndexesThisProc;
+            pidxcontext->pfcbIndexesToBuild = pfcbIndexesRemaining;
 
-        for ( ULONG iindex = 0; iindex < cIndexesThisProc; iindex++ )
-        {
-            pfcbIndexesRemaining = pfcbIndexesRemaining->PfcbNextIndex();
-        }
+            iindexNext += cIndexesThisProc;
 
-        DIRUp( pidxcontext->pfucbTable );
-        pidxcontext->err = JET_errSuccess;
+            for ( ULONG iindex = 0; iindex < cIndexesThisProc; iindex++ )
+            {
+                pfcbIndexesRemaining = pfcbIndexesRemaining->PfcbNextIndex();
+            }
+
+            DIRUp( pidxcontext->pfucbTable );
+            pidxcontext->err = JET_errSuccess;
+        }
     }
 
 #ifdef SHOW_INDEX_PERF
@@ -4657,73 +5189,50 @@ NextBuild:
 
     ppib->ptlsApi = NULL;
 
-    CallS( err );
-    while ( JET_errNoCurrentRecord != err )
+    if ( cPartition > 1 )
     {
-        Call( err );
-
-#ifdef SHOW_INDEX_PERF
-        cPages++;
-        cRecs += pcsrTable->Cpage().Clines();
-#endif
-
-        Assert( pcsrTable->FLatched() );
-        Assert( locOnCurBM == pfucbTable->locLogical );
-
-        for ( iProc = 0; iProc < cProcsCurrBatch; iProc++ )
+        for ( ipartition = 0; ipartition < cPartition; ipartition++ )
         {
-            CREATEINDEXCONTEXT * const  pidxcontext     = rgidxcontext + iProc;
-
-            Call( pidxcontext->err );
-
-            Call( pinst->ErrCheckForTermination() );
-
-            Call( pinst->m_plog->ErrLGCheckState() );
-
-            Alloc( pcsrT = new CSR );
-
-            CLockDeadlockDetectionInfo::DisableOwnershipTracking();
-            Call( pcsrT->ErrGetReadPage(
-                            ppib,
-                            pfucbTable->ifmp,
-                            pcsrTable->Pgno(),
-                            bflfNoTouch,
-                            pcsrTable->Cpage().PBFLatch() ) );
-            CLockDeadlockDetectionInfo::EnableOwnershipTracking();
+            ppartitions->rgpartition[ipartition].rgidxcontext = rgidxcontext + ipartition * cProcs;
+            ppartitions->rgpartition[ipartition].cidxcontext = cProcsCurrBatch;
+        }
 
-            Call( pidxcontext->taskmgrCreateIndex.ErrTMPost(
-                                    ErrFILEIndexDispatchAddEntries,
-                                    0,
-                                    (DWORD_PTR)pcsrT ) );
+        Call( ErrFILEIIndexPartitionsStart( ppartitions ) );
+    }
 
-            pcsrT = pcsrNil;
+    err = ErrFILEIScanIndexPartition(
+                ppib,
+                pfucbTable,
+                NULL,
+                cPartition > 1 ? ppartitions->rgpartition[0].pkeyLimit : NULL,
+                rgidxcontext,
+                cProcsCurrBatch,
+                cPartition > 1 ? &ppartitions->fCancel : NULL );
 
-            FILEIPossiblyWaitForDispatchedTasks( pidxcontext,iProc );
+    if ( cPartition > 1 )
+    {
+        if ( err < JET_errSuccess )
+        {
+            ppartitions->fCancel = fTrue;
         }
 
-        pcsrTable->SetILine( pcsrTable->Cpage().Clines() - 1 );
-#ifdef DEBUG
-        NDGet( pfucbTable );
-#endif
-
-        Assert( pcsrTable->FLatched() );
-        err = ErrBTNext( pfucbTable, fDIRNull );
+        const ERR errWait = ErrFILEIIndexPartitionsWait( ppartitions );
+        if ( err >= JET_errSuccess )
+        {
+            err = errWait;
+        }
     }
-    Assert( JET_errNoCurrentRecord == err );
+    Call( err );
 
 #ifdef SHOW_INDEX_PERF
-    OSTrace( tracetagIndexPerf, OSFormat(   "Scanned %d records (%d pages) and dispatched all tasks in %d msecs.\n",
-                                        cRecs,
-                                        cPages,
+    OSTrace( tracetagIndexPerf, OSFormat(   "Scanned %d partition(s) and dispatched all tasks in %d msecs.\n",
+                                        cPartition,
                                         TickOSTimeCurrent() - tickStart ) );
 #endif
 
-    FUCBResetPreread( pfucbTable );
-    BTUp( pfucbTable );
-
-    for ( iProc = 0; iProc < cProcsCurrBatch; iProc++ )
+    for ( iProc = 0; iProc < cProcsCurrBatch * cPartition; iProc++ )
     {
-        CREATEINDEXCONTEXT *    pidxcontext     = rgidxcontext + iProc;
+        CREATEINDEXCONTEXT *    pidxcontext     = rgidxcontext + ( iProc / cProcsCurrBatch ) * cProcs + ( iProc % cProcsCurrBatch );
 
         pidxcontext->taskmgrCreateIndex.TMTerm();
 
@@ -4736,12 +5245,12 @@ NextBuild:
             iindex < pidxcontext->iindexStart + pidxcontext->cIndexesToBuild;
             iindex++ )
         {
-            if ( rgpfucbSort[iindex]->u.pscb->crun > 0 )
+            if ( pidxcontext->rgpfucbSort[iindex]->u.pscb->crun > 0 )
             {
                 OSTrace( tracetagIndexPerf, OSFormat(   "Index #%d used sort runs [objid:0x%x,pgnoFDP:0x%x].\n",
                                                     iindex+1,
-                                                    rgpfucbSort[iindex]->u.pscb->fcb.ObjidFDP(),
-                                                    rgpfucbSort[iindex]->u.pscb->fcb.PgnoFDP() ) );
+                                                    pidxcontext->rgpfucbSort[iindex]->u.pscb->fcb.ObjidFDP(),
+                                                    pidxcontext->rgpfucbSort[iindex]->u.pscb->fcb.PgnoFDP() ) );
             }
             else
             {
@@ -4749,7 +5258,7 @@ NextBuild:
                                                     iindex+1 ) );
             }
 
-            cTotalKeys += rgcRecInput[iindex];
+            cTotalKeys += pidxcontext->rgcRecInput[iindex];
         }
         OSTrace( tracetagIndexPerf, OSFormat( "Task manager %d generated %d total keys.\n", iProc+1, cTotalKeys ) );
 #endif
@@ -4771,11 +5280,6 @@ NextBuild:
 
     if ( pfcbNil != pfcbNextBuildIndex )
     {
-        FUCBSetPrereadForward( pfucbTable, cpgPrereadSequential );
-        err = ErrBTDown( pfucbTable, &dib, latchReadTouch );
-        CallS( err );
-        Call( err );
-
         goto NextBuild;
     }
 
@@ -4812,9 +5316,16 @@ HandleError:
 
     Assert ( err != errDIRNoShortCircuit );
 
+    if ( NULL != ppartitions )
+    {
+        //  the partition scanners post to the task managers, so stop them first
+        ppartitions->fCancel = fTrue;
+        (VOID)ErrFILEIIndexPartitionsWait( ppartitions );
+    }
+
     if ( NULL != rgidxcontext )
     {
-        for ( iProc = 0; iProc < cProcs; iProc++ )
+        for ( iProc = 0; iProc < cidxcontext; iProc++ )
         {
             CREATEINDEXCONTEXT * const  pidxcontext     = rgidxcontext + iProc;
 
@@ -4834,17 +5345,9 @@ HandleError:
 
     if ( err < 0 )
     {
-        if ( pcsrNil != pcsrT )
-        {
-            CLockDeadlockDetectionInfo::DisableOwnershipTracking();
-            pcsrT->ReleasePage();
-            CLockDeadlockDetectionInfo::EnableOwnershipTracking();
-            delete pcsrT;
-        }
-
         if ( NULL != rgpfucbSort )
         {
-            for ( ULONG iindex = 0; iindex < cIndexBatchMax; iindex++ )
+            for ( ULONG iindex = 0; iindex < cIndexBatchMax * cPartition; iindex++ )
             {
                 if ( pfucbNil != rgpfucbSort[iindex] )
                 {
@@ -4860,8 +5363,7 @@ HandleError:
     else
     {
 #ifdef DEBUG
-        Assert( pcsrNil == pcsrT );
-        for ( ULONG iindex = 0; iindex < cIndexBatchMax; iindex++ )
+        for ( ULONG iindex = 0; iindex < cIndexBatchMax * cPartition; iindex++ )
         {
             Assert( pfucbNil == rgpfucbSort[iindex] );
         }
@@ -4873,6 +5375,12 @@ HandleError:
         OSMemoryHeapFree( rgpfucbSort );
     }
 
+    if ( NULL != ppartitions )
+    {
+        FILEIIndexPartitionsTerm( ppartitions );
+        OSMemoryHeapFree( ppartitions );
+    }
+
     if ( fTransactionStarted )
     {
         CallS( ErrDIRCommitTransaction( ppib, NO_GRBIT ) );
@@ -4932,6 +5440,7 @@ ERR ErrFILEIndexBatchTerm(
         ULONG       cRecOutput      = 0;
         BOOL        fEntriesExist   = fTrue;
         BOOL        fCorruptedIndex = fFalse;
+        CFILEIndexSortMerge merge( &rgpfucbSort[iindex], 1, 0, fUnique );
 
         Assert( pfcbNil != pfcbIndex );
         Assert( pfcbIndex->FTypeSecondaryIndex() );
@@ -4951,7 +5460,7 @@ ERR ErrFILEIndexBatchTerm(
                                             TickOSTimeCurrent() - tickStart ) );
 #endif
 
-        err = ErrSORTNext( rgpfucbSort[iindex] );
+        err = merge.ErrFirst();
         if ( err < 0 )
         {
             if ( JET_errNoCurrentRecord != err )
@@ -4976,7 +5485,7 @@ ERR ErrFILEIndexBatchTerm(
             {
                 Assert( NULL != pcprintf );
                 Call( ErrFILEICheckIndex(
-                            rgpfucbSort[iindex],
+                            &merge,
                             pfucbIndex,
                             &cRecOutput,
                             &fCorruptedIndex,
@@ -4991,7 +5500,7 @@ ERR ErrFILEIndexBatchTerm(
 #endif
 
                 Call( ErrFILEIAppendToIndex(
-                            rgpfucbSort[iindex],
+                            &merge,
                             pfucbIndex,
                             &cRecOutput,
                             g_rgfmp[pfucbIndex->ifmp].FLogOn() ) );
@@ -0,0 +1,219 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "std.hxx"
+
+#ifndef ENABLE_JET_UNIT_TEST
+#error This file should only be compiled with the unit tests!
+#endif
+
+const ULONG idFCreateTestPartitions     = 47196;    //  "INDEX"/"Parallel Build Partitions" override
+const LONG  cFCreateTestRecords         = 5000;
+
+LOCAL ERR ErrFCreateTestIPopulate(
+    const JET_SESID         sesid,
+    const JET_DBID          dbid,
+    const CHAR * const      szTable,
+    const BOOL              fDuplicate )
+{
+    ERR             err;
+    JET_TABLEID     tableid     = JET_tableidNil;
+    JET_COLUMNDEF   columndef   = { sizeof( JET_COLUMNDEF ), 0, JET_coltypLong, 0, 0, 0, 0, 0, JET_bitColumnFixed };
+    JET_COLUMNID    columnidKey;
+    JET_COLUMNID    columnidFixed;
+    JET_COLUMNID    columnidUnique;
+
+    Call( JetCreateTableA( sesid, dbid, szTable, 16, 100, &tableid ) );
+    Call( JetAddColumnA( sesid, tableid, "Key", &columndef, NULL, 0, &columnidKey ) );
+    Call( JetAddColumnA( sesid, tableid, "Fixed", &columndef, NULL, 0, &columnidFixed ) );
+    Call( JetAddColumnA( sesid, tableid, "Unique", &columndef, NULL, 0, &columnidUnique ) );
+    Call( JetCreateIndexA( sesid, tableid, "Primary", JET_bitIndexPrimary, "+Key\0", 6, 100 ) );
+
+    Call( JetBeginTransaction( sesid ) );
+    for ( LONG irec = 0; irec < cFCreateTestRecords; irec++ )
+    {
+        const LONG  lFixed  = ( irec * 7919 ) % 97;
+
+        //  the first and last records land in different partitions
+        const LONG  lUnique = ( fDuplicate && cFCreateTestRecords - 1 == irec ) ? cFCreateTestRecords : cFCreateTestRecords - irec;
+
+        Call( JetPrepareUpdate( sesid, tableid, JET_prepInsert ) );
+        Call( JetSetColumn( sesid, tableid, columnidKey, &irec, sizeof( irec ), NO_GRBIT, NULL ) );
+        Call( JetSetColumn( sesid, tableid, columnidFixed, &lFixed, sizeof( lFixed ), NO_GRBIT, NULL ) );
+        Call( JetSetColumn( sesid, tableid, columnidUnique, &lUnique, sizeof( lUnique ), NO_GRBIT, NULL ) );
+        Call( JetUpdate( sesid, tableid, NULL, 0, NULL ) );
+
+        if ( 0 == irec % 500 )
+        {
+            Call( JetCommitTransaction( sesid, JET_bitCommitLazyFlush ) );
+            Call( JetBeginTransaction( sesid ) );
+        }
+    }
+    Call( JetCommitTransaction( sesid, JET_bitCommitLazyFlush ) );
+
+HandleError:
+    if ( JET_tableidNil != tableid )
+    {
+        (VOID)JetCloseTable( sesid, tableid );
+    }
+    return err;
+}
+
+//  Builds the secondary indexes in one batch with the primary scan split into cPartition
+//  key ranges.
+
+LOCAL ERR ErrFCreateTestIBuildIndexes(
+    const JET_SESID         sesid,
+    const JET_DBID          dbid,
+    const CHAR * const      szTable,
+    const ULONG             cPartition )
+{
+    ERR                 err;
+    JET_TABLEID         tableid             = JET_tableidNil;
+    CHAR                szFixed[]           = "Fixed";
+    CHAR                szKeyFixed[]        = "+Fixed\0";
+    CHAR                szFixedDesc[]       = "FixedDesc";
+    CHAR                szKeyFixedDesc[]    = "-Fixed\0+Unique\0";
+    CHAR                szUnique[]          = "Unique";
+    CHAR                szKeyUnique[]       = "+Unique\0";
+    JET_INDEXCREATE_A   rgindexcreate[3];
+
+    memset( rgindexcreate, 0, sizeof( rgindexcreate ) );
+    for ( ULONG iindex = 0; iindex < _countof( rgindexcreate ); iindex++ )
+    {
+        rgindexcreate[iindex].cbStruct = sizeof( JET_INDEXCREATE_A );
+        rgindexcreate[iindex].ulDensity = 100;
+    }
+    rgindexcreate[0].szIndexName = szFixed;
+    rgindexcreate[0].szKey = szKeyFixed;
+    rgindexcreate[0].cbKey = sizeof( szKeyFixed );
+    rgindexcreate[1].szIndexName = szFixedDesc;
+    rgindexcreate[1].szKey = szKeyFixedDesc;
+    rgindexcreate[1].cbKey = sizeof( szKeyFixedDesc );
+    rgindexcreate[2].szIndexName = szUnique;
+    rgindexcreate[2].szKey = szKeyUnique;
+    rgindexcreate[2].cbKey = sizeof( szKeyUnique );
+    rgindexcreate[2].grbit = JET_bitIndexUnique;
+
+    //  partitioning is only used with an exclusive table lock
+    Call( JetOpenTableA( sesid, dbid, szTable, NULL, 0, JET_bitTableDenyRead, &tableid ) );
+    Call( ErrEnableTestInjection( idFCreateTestPartitions, cPartition, JET_TestInjectConfigOverride, 100, JET_bitInjectionProbabilityPct ) );
+    err = JetCreateIndex2A( sesid, tableid, rgindexcreate, _countof( rgindexcreate ) );
+    CallS( ErrEnableTestInjection( idFCreateTestPartitions, 0, JET_TestInjectConfigOverride, 0, JET_bitInjectionProbabilityPct ) );
+    Call( err );
+
+HandleError:
+    if ( JET_tableidNil != tableid )
+    {
+        (VOID)JetCloseTable( sesid, tableid );
+    }
+    return err;
+}
+
+//  Walks szIndex on both tables in lockstep and fails unless every entry has the same key
+//  and primary key.
+
+LOCAL ERR ErrFCreateTestICompareIndex(
+    const JET_SESID         sesid,
+    const JET_DBID          dbid,
+    const CHAR * const      szTableExpected,
+    const CHAR * const      szTableActual,
+    const CHAR * const      szIndex,
+    LONG * const            pcEntries )
+{
+    ERR             err;
+    ERR             errExpected;
+    ERR             errActual;
+    JET_TABLEID     tableidExpected     = JET_tableidNil;
+    JET_TABLEID     tableidActual       = JET_tableidNil;
+    JET_COLUMNDEF   columndef;
+
+    *pcEntries = 0;
+
+    Call( JetOpenTableA( sesid, dbid, szTableExpected, NULL, 0, JET_bitTableReadOnly, &tableidExpected ) );
+    Call( JetOpenTableA( sesid, dbid, szTableActual, NULL, 0, JET_bitTableReadOnly, &tableidActual ) );
+    Call( JetGetTableColumnInfoA( sesid, tableidExpected, "Key", &columndef, sizeof( columndef ), JET_ColInfo ) );
+    Call( JetSetCurrentIndexA( sesid, tableidExpected, szIndex ) );
+    Call( JetSetCurrentIndexA( sesid, tableidActual, szIndex ) );
+
+    for ( errExpected = JetMove( sesid, tableidExpected, JET_MoveFirst, NO_GRBIT ),
+            errActual = JetMove( sesid, tableidActual, JET_MoveFirst, NO_GRBIT );
+        JET_errSuccess == errExpected && JET_errSuccess == errActual;
+        errExpected = JetMove( sesid, tableidExpected, JET_MoveNext, NO_GRBIT ),
+            errActual = JetMove( sesid, tableidActual, JET_MoveNext, NO_GRBIT ) )
+    {
+        BYTE    rgbKeyExpected[ JET_cbKeyMost ];
+        BYTE    rgbKeyActual[ JET_cbKeyMost ];
+        ULONG   cbKeyExpected;
+        ULONG   cbKeyActual;
+        LONG    lKeyExpected;
+        LONG    lKeyActual;
+
+        Call( JetRetrieveKey( sesid, tableidExpected, rgbKeyExpected, sizeof( rgbKeyExpected ), &cbKeyExpected, NO_GRBIT ) );
+        Call( JetRetrieveKey( sesid, tableidActual, rgbKeyActual, sizeof( rgbKeyActual ), &cbKeyActual, NO_GRBIT ) );
+        Call( JetRetrieveColumn( sesid, tableidExpected, columndef.columnid, &lKeyExpected, sizeof( lKeyExpected ), NULL, NO_GRBIT, NULL ) );
+        Call( JetRetrieveColumn( sesid, tableidActual, columndef.columnid, &lKeyActual, sizeof( lKeyActual ), NULL, NO_GRBIT, NULL ) );
+
+        if ( cbKeyExpected != cbKeyActual
+            || 0 != memcmp( rgbKeyExpected, rgbKeyActual, cbKeyExpected )
+            || lKeyExpected != lKeyActual )
+        {
+            Error( ErrERRCheck( JET_errIndexBuildCorrupted ) );
+        }
+
+        (*pcEntries)++;
+    }
+
+    Call( errExpected == JET_errNoCurrentRecord ? JET_errSuccess : errExpected );
+    Call( errActual == JET_errNoCurrentRecord ? JET_errSuccess : errActual );
+    if ( errExpected != errActual )
+    {
+        Error( ErrERRCheck( JET_errIndexBuildCorrupted ) );
+    }
+
+HandleError:
+    if ( JET_tableidNil != tableidExpected )
+    {
+        (VOID)JetCloseTable( sesid, tableidExpected );
+    }
+    if ( JET_tableidNil != tableidActual )
+    {
+        (VOID)JetCloseTable( sesid, tableidActual );
+    }
+    return err;
+}
+
+JETUNITTEST( FCREATE, PartitionedIndexBuildMatchesSerialBuild )
+{
+    JetTestDatabase db;
+    LONG            cEntries;
+
+    CHECKCALLS( db.ErrInit( L"FCreateTest" ) );
+
+    CHECKCALLS( ErrFCreateTestIPopulate( db.Sesid(), db.Dbid(), "Serial", fFalse ) );
+    CHECKCALLS( ErrFCreateTestIPopulate( db.Sesid(), db.Dbid(), "Partitioned", fFalse ) );
+
+    CHECKCALLS( ErrFCreateTestIBuildIndexes( db.Sesid(), db.Dbid(), "Serial", 1 ) );
+    CHECKCALLS( ErrFCreateTestIBuildIndexes( db.Sesid(), db.Dbid(), "Partitioned", 4 ) );
+
+    CHECKCALLS( ErrFCreateTestICompareIndex( db.Sesid(), db.Dbid(), "Serial", "Partitioned", "Fixed", &cEntries ) );
+    CHECK( cFCreateTestRecords == cEntries );
+    CHECKCALLS( ErrFCreateTestICompareIndex( db.Sesid(), db.Dbid(), "Serial", "Partitioned", "FixedDesc", &cEntries ) );
+    CHECK( cFCreateTestRecords == cEntries );
+    CHECKCALLS( ErrFCreateTestICompareIndex( db.Sesid(), db.Dbid(), "Serial", "Partitioned", "Unique", &cEntries ) );
+    CHECK( cFCreateTestRecords == cEntries );
+
+    CHECKCALLS( db.ErrTerm() );
+}
+
+JETUNITTEST( FCREATE, PartitionedIndexBuildFindsDuplicatesAcrossPartitions )
+{
+    JetTestDatabase db;
+
+    CHECKCALLS( db.ErrInit( L"FCreateTest" ) );
+
+    CHECKCALLS( ErrFCreateTestIPopulate( db.Sesid(), db.Dbid(), "Duplicate", fTrue ) );
+    CHECK( JET_errKeyDuplicate == ErrFCreateTestIBuildIndexes( db.Sesid(), db.Dbid(), "Duplicate", 4 ) );
+
+    CHECKCALLS( db.ErrTerm() );
+}
@@ -1665,6 +1665,294 @@ HandleError:
     return err;
 }
 
+LOCAL BOOL CmpRetrieveLongValueBookmark( const JET_RETRIEVELONGVALUE * const pretrievelv1, const JET_RETRIEVELONGVALUE * const pretrievelv2 )
+{
+    const INT cmp = memcmp( pretrievelv1->pvBookmark, pretrievelv2->pvBookmark, min( pretrievelv1->cbBookmark, pretrievelv2->cbBookmark ) );
+    return cmp < 0 || ( 0 == cmp && pretrievelv1->cbBookmark < pretrievelv2->cbBookmark );
+}
+
+LOCAL BOOL FRECIRetrieveLongValueEntryError( const ERR err )
+{
+    switch ( err )
+    {
+        case JET_errRecordDeleted:
+        case JET_errRecordNotFound:
+        case JET_errNoCurrentRecord:
+        case JET_errInvalidBookmark:
+        case JET_errBadColumnId:
+        case JET_errColumnNotFound:
+        case JET_errColumnNoEncryptionKey:
+        case JET_errInvalidColumnType:
+            return fTrue;
+        default:
+            return fFalse;
+    }
+}
+
+//  Only tagged columns can hold long values. Template columns are described by the template
+//  table, whose schema never changes, so only the table's own columns need the DML latch.
+
+LOCAL BOOL FRECILongValueColumn( FUCB * const pfucb, const COLUMNID columnid )
+{
+    if ( !FCOLUMNIDTagged( columnid ) )
+    {
+        return fFalse;
+    }
+
+    FCB * const pfcb = pfucb->u.pfcb;
+    BOOL        fLongValue;
+
+    if ( FCOLUMNIDTemplateColumn( columnid ) && !pfcb->FTemplateTable() )
+    {
+        fLongValue = FRECLongValue( pfcb->Ptdb()->PfcbTemplateTable()->Ptdb()->PfieldTagged( columnid )->coltyp );
+    }
+    else
+    {
+        pfcb->EnterDML();
+        fLongValue = FRECLongValue( pfcb->Ptdb()->PfieldTagged( columnid )->coltyp );
+        pfcb->LeaveDML();
+    }
+
+    return fLongValue;
+}
+
+LOCAL VOID RECIPrereadLongValueBookmarks(
+    FUCB * const                            pfucb,
+    JET_RETRIEVELONGVALUE * const * const   rgpretrievelv,
+    const ULONG                             cretrievelv,
+    BOOKMARK * const                        rgbm )
+{
+    for ( ULONG iretrievelv = 0; iretrievelv < cretrievelv; iretrievelv++ )
+    {
+        rgbm[ iretrievelv ].key.prefix.Nullify();
+        rgbm[ iretrievelv ].key.suffix.SetPv( const_cast<VOID *>( rgpretrievelv[ iretrievelv ]->pvBookmark ) );
+        rgbm[ iretrievelv ].key.suffix.SetCb( rgpretrievelv[ iretrievelv ]->cbBookmark );
+        rgbm[ iretrievelv ].data.Nullify();
+    }
+
+    LONG cbmPreread = 0;
+    (VOID)ErrBTPrereadBookmarks( pfucb->ppib, pfucb, rgbm, cretrievelv, &cbmPreread, JET_bitPrereadForward );
+}
+
+ERR VTAPI ErrIsamRetrieveLongValues(
+    _In_ const JET_SESID                                            sesid,
+    _In_ const JET_TABLEID                                          tableid,
+    _Inout_updates_( cretrievelv ) JET_RETRIEVELONGVALUE * const    rgretrievelv,
+    _In_ const ULONG                                                cretrievelv,
+    _In_ const JET_GRBIT                                            grbit )
+{
+    ERR                         err                     = JET_errSuccess;
+    PIB* const                  ppib                    = (PIB * const)sesid;
+    FUCB* const                 pfucb                   = (FUCB * const)tableid;
+    BOOL                        fTransactionStarted     = fFalse;
+    JET_TABLEID                 tableidSeek             = JET_tableidNil;
+    BYTE*                       rgbKey                  = NULL;
+    JET_RETRIEVELONGVALUE**     rgpretrievelv           = NULL;
+    LvId*                       rglid                   = NULL;
+    BOOL*                       rgfEncrypted            = NULL;
+    LVPREREAD*                  rglvpreread             = NULL;
+    BOOKMARK*                   rgbm                    = NULL;
+    const ULONG                 cretrievelvWindow       = clidMostPreread;
+
+
+    if ( ppib == ppibNil || pfucb == pfucbNil || ( cretrievelv && !rgretrievelv ) )
+    {
+        Error( ErrERRCheck( JET_errInvalidParameter ) );
+    }
+    for ( ULONG iretrievelv = 0; iretrievelv < cretrievelv; iretrievelv++ )
+    {
+        const JET_RETRIEVELONGVALUE * const pretrievelv = &rgretrievelv[ iretrievelv ];
+        if ( !pretrievelv->pvBookmark || !pretrievelv->cbBookmark || ( pretrievelv->cbData && !pretrievelv->pvData ) )
+        {
+            Error( ErrERRCheck( JET_errInvalidParameter ) );
+        }
+    }
+    if ( FFUCBUpdatePrepared( pfucb ) )
+    {
+        Error( ErrERRCheck( JET_errInvalidOperation ) );
+    }
+
+
+    if ( grbit != NO_GRBIT )
+    {
+        Error( ErrERRCheck( JET_errInvalidGrbit ) );
+    }
+
+
+    CallR( ErrPIBCheck( ppib ) );
+    CheckFUCB( ppib, pfucb );
+    AssertDIRNoLatch( ppib );
+    Assert( FFUCBIndex( pfucb ) );
+    Assert( !FFUCBSort( pfucb ) );
+
+    if( FFMPIsTempDB( pfucb->ifmp ) )
+    {
+        Expected( fFalse );
+        Error( ErrERRCheck( JET_errInvalidParameter ) );
+    }
+
+    if ( 0 == cretrievelv )
+    {
+        goto HandleError;
+    }
+
+
+    if ( 0 == ppib->Level() )
+    {
+        Call( ErrIsamBeginTransaction( sesid, 39212, JET_bitTransactionReadOnly ) );
+        fTransactionStarted = fTrue;
+    }
+
+
+    Call( ErrIsamDupCursor( sesid, tableid, &tableidSeek, NO_GRBIT ) );
+
+    if ( pfucb->cbEncryptionKey )
+    {
+        Alloc( rgbKey = new BYTE[ pfucb->cbEncryptionKey ] );
+        Call( ErrIsamGetTableInfo( sesid, tableid, rgbKey, pfucb->cbEncryptionKey, JET_TblInfoEncryptionKey ) );
+        Call( ErrIsamSetTableInfo( sesid, tableidSeek, rgbKey, pfucb->cbEncryptionKey, JET_TblInfoEncryptionKey ) );
+    }
+
+
+    Alloc( rgpretrievelv = new JET_RETRIEVELONGVALUE*[ cretrievelv ] );
+    Alloc( rglid = new LvId[ cretrievelvWindow ] );
+    Alloc( rgfEncrypted = new BOOL[ cretrievelvWindow ] );
+    Alloc( rglvpreread = new LVPREREAD[ cretrievelvWindow ] );
+    Alloc( rgbm = new BOOKMARK[ cretrievelvWindow ] );
+
+    for ( ULONG iretrievelv = 0; iretrievelv < cretrievelv; iretrievelv++ )
+    {
+        rgpretrievelv[ iretrievelv ] = &rgretrievelv[ iretrievelv ];
+        rgretrievelv[ iretrievelv ].cbActual = 0;
+        rgretrievelv[ iretrievelv ].err = JET_errSuccess;
+    }
+    std::sort( rgpretrievelv, rgpretrievelv + cretrievelv, CmpRetrieveLongValueBookmark );
+
+
+    RECIPrereadLongValueBookmarks( pfucb, rgpretrievelv, min( cretrievelv, cretrievelvWindow ), rgbm );
+
+    for ( ULONG iretrievelvFirst = 0; iretrievelvFirst < cretrievelv; iretrievelvFirst += cretrievelvWindow )
+    {
+        const ULONG cretrievelvCurrent  = min( cretrievelvWindow, cretrievelv - iretrievelvFirst );
+        ULONG       clvpreread          = 0;
+
+
+        for ( ULONG iretrievelv = 0; iretrievelv < cretrievelvCurrent; iretrievelv++ )
+        {
+            JET_RETRIEVELONGVALUE * const   pretrievelv = rgpretrievelv[ iretrievelvFirst + iretrievelv ];
+            JET_RETINFO                     retinfo     = { sizeof( JET_RETINFO ), 0, pretrievelv->itagSequence ? pretrievelv->itagSequence : 1, 0 };
+            ULONG                           cbActual    = 0;
+
+            rglid[ iretrievelv ] = lidMin;
+
+            err = ErrIsamGotoBookmark( sesid, tableidSeek, pretrievelv->pvBookmark, pretrievelv->cbBookmark );
+            if ( err >= JET_errSuccess )
+            {
+                err = ErrRECIAccessColumn( pfucb, pretrievelv->columnid, pfieldNil, &rgfEncrypted[ iretrievelv ] );
+            }
+            if ( err >= JET_errSuccess && !FRECILongValueColumn( pfucb, pretrievelv->columnid ) )
+            {
+                err = ErrERRCheck( JET_errInvalidColumnType );
+            }
+            if ( err >= JET_errSuccess )
+            {
+                err = ErrIsamRetrieveColumn( sesid, tableidSeek, pretrievelv->columnid, &rglid[ iretrievelv ], sizeof( LvId ), &cbActual, JET_bitRetrieveLongId, &retinfo );
+            }
+            if ( FRECIRetrieveLongValueEntryError( err ) )
+            {
+                pretrievelv->err = err;
+                err = JET_errSuccess;
+                continue;
+            }
+            Call( err );
+
+
+            if ( JET_wrnSeparateLongValue == err )
+            {
+                Assert( rglid[ iretrievelv ] != lidMin );
+                if ( rgfEncrypted[ iretrievelv ] && pfucb->pbEncryptionKey == NULL )
+                {
+                    pretrievelv->err = ErrERRCheck( JET_errColumnNoEncryptionKey );
+                    rglid[ iretrievelv ] = lidMin;
+                    continue;
+                }
+
+                rglvpreread[ clvpreread ].lid       = rglid[ iretrievelv ];
+                rglvpreread[ clvpreread ].ibOffset  = pretrievelv->ibLongValue;
+                rglvpreread[ clvpreread ].cbData    = pretrievelv->cbData;
+                clvpreread++;
+                continue;
+            }
+
+
+            rglid[ iretrievelv ] = lidMin;
+            retinfo.ibLongValue = pretrievelv->ibLongValue;
+            err = ErrIsamRetrieveColumn( sesid, tableidSeek, pretrievelv->columnid, pretrievelv->pvData, pretrievelv->cbData, &pretrievelv->cbActual, NO_GRBIT, &retinfo );
+            if ( FRECIRetrieveLongValueEntryError( err ) )
+            {
+                pretrievelv->err = err;
+                err = JET_errSuccess;
+                continue;
+            }
+            Call( err );
+            pretrievelv->err = err;
+        }
+
+
+        Call( ErrLVPrereadLongValueRanges( pfucb, rglvpreread, clvpreread ) );
+
+        if ( iretrievelvFirst + cretrievelvCurrent < cretrievelv )
+        {
+            RECIPrereadLongValueBookmarks(  pfucb,
+                                            rgpretrievelv + iretrievelvFirst + cretrievelvCurrent,
+                                            min( cretrievelvWindow, cretrievelv - iretrievelvFirst - cretrievelvCurrent ),
+                                            rgbm );
+        }
+
+
+        for ( ULONG iretrievelv = 0; iretrievelv < cretrievelvCurrent; iretrievelv++ )
+        {
+            JET_RETRIEVELONGVALUE * const pretrievelv = rgpretrievelv[ iretrievelvFirst + iretrievelv ];
+
+            if ( rglid[ iretrievelv ] == lidMin )
+            {
+                continue;
+            }
+
+            Call( ErrRECRetrieveSLongField( pfucb,
+                                            rglid[ iretrievelv ],
+                                            fTrue,
+                                            pretrievelv->ibLongValue,
+                                            rgfEncrypted[ iretrievelv ],
+                                            (BYTE*)pretrievelv->pvData,
+                                            pretrievelv->cbData,
+                                            &pretrievelv->cbActual ) );
+            pretrievelv->err = ( pretrievelv->cbActual > pretrievelv->cbData ) ? ErrERRCheck( JET_wrnBufferTruncated ) : JET_errSuccess;
+        }
+    }
+
+    err = JET_errSuccess;
+
+HandleError:
+    if ( tableidSeek != JET_tableidNil )
+    {
+        CallS( ErrIsamCloseTable( sesid, tableidSeek ) );
+    }
+    if ( fTransactionStarted )
+    {
+        CallS( ErrIsamCommitTransaction( sesid, NO_GRBIT, 0, NULL ) );
+    }
+    AssertDIRNoLatch( ppib );
+
+    delete[] rgbm;
+    delete[] rglvpreread;
+    delete[] rgfEncrypted;
+    delete[] rglid;
+    delete[] rgpretrievelv;
+    delete[] rgbKey;
+    return err;
+}
+
 LOCAL ERR ErrRECIFetchMissingLVs(
     FUCB*                   pfucb,
     ULONG*                  pcEnumColumn,
@@ -2663,6 +2663,467 @@ HandleError:
     return err;
 }
 
+struct RETRIEVE_PLAN_COLUMN
+{
+    COLUMNID        columnid;
+    JET_GRBIT       grbit;
+    FCB *           pfcb;
+    FIELD           fieldFixed;
+    ULONG           ifidTagged;
+    BOOL            fPlanned;
+    BOOL            fCheckDDL;
+};
+
+struct RETRIEVE_PLAN_TAGGED
+{
+    FID             fid;
+    BOOL            fDerived;
+    ULONG           iretcol;
+};
+
+struct RETRIEVE_PLAN
+{
+    ULONG                   cretcol;
+    ULONG                   cretcolPlanned;
+    ULONG                   cfidTagged;
+    BOOL                    fRetrieveCopy;
+    BOOL                    fCheckDDL;
+    RETRIEVE_PLAN_COLUMN *  rgcolumn;
+    FID *                   rgfidTagged;
+    BOOL *                  rgfDerivedTagged;
+    DATA *                  rgdataTagged;
+    ERR *                   rgerrTagged;
+    ULONG *                 rgiretcolDeferred;
+};
+
+LOCAL VOID RECIDeleteRetrievePlan( RETRIEVE_PLAN * const pplan )
+{
+    delete[] pplan->rgcolumn;
+    delete[] pplan->rgfidTagged;
+    delete[] pplan->rgfDerivedTagged;
+    delete[] pplan->rgdataTagged;
+    delete[] pplan->rgerrTagged;
+    delete[] pplan->rgiretcolDeferred;
+    delete pplan;
+}
+
+VOID RECRemoveRetrievePlan( FUCB * const pfucb )
+{
+    if ( NULL != pfucb->pretrieveplan )
+    {
+        RECIDeleteRetrievePlan( pfucb->pretrieveplan );
+        pfucb->pretrieveplan = NULL;
+    }
+}
+
+LOCAL BOOL CmpRetrievePlanTagged( const RETRIEVE_PLAN_TAGGED& tagged1, const RETRIEVE_PLAN_TAGGED& tagged2 )
+{
+    if ( tagged1.fDerived != tagged2.fDerived )
+    {
+        return tagged1.fDerived;
+    }
+    return tagged1.fid < tagged2.fid;
+}
+
+LOCAL ERR ErrRECIPrepareRetrieveColumns(
+    FUCB                        * const pfucb,
+    const JET_RETRIEVECOLUMN    * const pretcol,
+    const ULONG                 cretcol )
+{
+    ERR                         err             = JET_errSuccess;
+    FCB * const                 pfcbTable       = pfucb->u.pfcb;
+    RETRIEVE_PLAN *             pplan           = NULL;
+    RETRIEVE_PLAN_TAGGED *      rgtagged        = NULL;
+    BOOL                        fRetrieveCopySet    = fFalse;
+
+    Assert( FFUCBIndex( pfucb ) );
+    Assert( pfucb->ppib->Level() > 0 );
+    Assert( NULL == pfucb->pretrieveplan );
+    Assert( cretcol > 0 );
+
+    Alloc( pplan = new RETRIEVE_PLAN() );
+    Alloc( pplan->rgcolumn = new RETRIEVE_PLAN_COLUMN[ cretcol ] );
+    Alloc( pplan->rgiretcolDeferred = new ULONG[ cretcol ] );
+    Alloc( rgtagged = new RETRIEVE_PLAN_TAGGED[ cretcol ] );
+    pplan->cretcol = cretcol;
+
+    for ( ULONG iretcol = 0; iretcol < cretcol; iretcol++ )
+    {
+        RETRIEVE_PLAN_COLUMN * const    pcolumn         = pplan->rgcolumn + iretcol;
+        const COLUMNID                  columnid        = pretcol[ iretcol ].columnid;
+        const JET_GRBIT                 grbit           = pretcol[ iretcol ].grbit;
+        const BOOL                      fRetrieveCopy   = !!( grbit & JET_bitRetrieveCopy );
+        BOOL                            fEncrypted      = fFalse;
+
+        memset( pcolumn, 0, sizeof( RETRIEVE_PLAN_COLUMN ) );
+        pcolumn->columnid = columnid;
+        pcolumn->grbit = grbit;
+        pcolumn->pfcb = pfcbTable;
+
+        if ( grbit & grbitRetrieveColumnInternalFlagsMask )
+        {
+            Error( ErrERRCheck( JET_errInvalidGrbit ) );
+        }
+
+        if ( 0 == columnid
+            || ( grbit & ~( JET_bitRetrieveCopy | JET_bitRetrieveIgnoreDefault ) )
+            || !FHostIsLittleEndian() )
+        {
+            continue;
+        }
+
+        Call( ErrRECIAccessColumn( pfucb, columnid, &pcolumn->fieldFixed, &fEncrypted ) );
+
+        if ( fEncrypted
+            || FFIELDEscrowUpdate( pcolumn->fieldFixed.ffield )
+            || ( fRetrieveCopySet && fRetrieveCopy != pplan->fRetrieveCopy ) )
+        {
+            continue;
+        }
+
+        pplan->fRetrieveCopy = fRetrieveCopy;
+        fRetrieveCopySet = fTrue;
+
+        if ( FCOLUMNIDTemplateColumn( columnid ) && !pfcbTable->FTemplateTable() )
+        {
+            pcolumn->pfcb = pfcbTable->Ptdb()->PfcbTemplateTable();
+        }
+        pcolumn->fCheckDDL = !pcolumn->pfcb->FFixedDDL();
+        pcolumn->fPlanned = fTrue;
+
+        if ( FCOLUMNIDTagged( columnid ) )
+        {
+            rgtagged[ pplan->cfidTagged ].fid = FidOfColumnid( columnid );
+            rgtagged[ pplan->cfidTagged ].fDerived = !!FRECUseDerivedBit( columnid, pfcbTable->Ptdb() );
+            rgtagged[ pplan->cfidTagged ].iretcol = iretcol;
+            pplan->cfidTagged++;
+        }
+
+        pplan->fCheckDDL = pplan->fCheckDDL || pcolumn->fCheckDDL;
+        pplan->cretcolPlanned++;
+    }
+
+    if ( pplan->cfidTagged > 0 )
+    {
+        std::sort( rgtagged, rgtagged + pplan->cfidTagged, CmpRetrievePlanTagged );
+
+        Alloc( pplan->rgfidTagged = new FID[ pplan->cfidTagged ] );
+        Alloc( pplan->rgfDerivedTagged = new BOOL[ pplan->cfidTagged ] );
+        Alloc( pplan->rgdataTagged = new DATA[ pplan->cfidTagged ] );
+        Alloc( pplan->rgerrTagged = new ERR[ pplan->cfidTagged ] );
+
+        for ( ULONG ifid = 0; ifid < pplan->cfidTagged; ifid++ )
+        {
+            pplan->rgfidTagged[ ifid ] = rgtagged[ ifid ].fid;
+            pplan->rgfDerivedTagged[ ifid ] = rgtagged[ ifid ].fDerived;
+            pplan->rgcolumn[ rgtagged[ ifid ].iretcol ].ifidTagged = ifid;
+        }
+    }
+
+    pfucb->pretrieveplan = pplan;
+    pplan = NULL;
+
+HandleError:
+    delete[] rgtagged;
+    if ( NULL != pplan )
+    {
+        RECIDeleteRetrievePlan( pplan );
+    }
+
+    return err;
+}
+
+LOCAL BOOL FRECIRetrievePlanMatches(
+    const RETRIEVE_PLAN         * const pplan,
+    const JET_RETRIEVECOLUMN    * const pretcol,
+    const ULONG                 cretcol )
+{
+    if ( pplan->cretcol != cretcol )
+    {
+        return fFalse;
+    }
+
+    for ( ULONG iretcol = 0; iretcol < cretcol; iretcol++ )
+    {
+        if ( pplan->rgcolumn[ iretcol ].columnid != pretcol[ iretcol ].columnid
+            || pplan->rgcolumn[ iretcol ].grbit != pretcol[ iretcol ].grbit )
+        {
+            return fFalse;
+        }
+    }
+
+    return fTrue;
+}
+
+LOCAL BOOL FRECIRetrievePlanCurrent( const RETRIEVE_PLAN * const pplan )
+{
+    for ( ULONG iretcol = 0; iretcol < pplan->cretcol; iretcol++ )
+    {
+        const RETRIEVE_PLAN_COLUMN * const  pcolumn     = pplan->rgcolumn + iretcol;
+
+        if ( !pcolumn->fPlanned || !pcolumn->fCheckDDL )
+        {
+            continue;
+        }
+
+        FCB * const         pfcb        = pcolumn->pfcb;
+        const TDB * const   ptdb        = pfcb->Ptdb();
+        const FID           fid         = FidOfColumnid( pcolumn->columnid );
+        const BOOL          fUseDMLLatch    = ( FTaggedFid( fid ) ? fid > ptdb->FidTaggedLastInitial() :
+                                                FFixedFid( fid ) ? fid > ptdb->FidFixedLastInitial() :
+                                                fid > ptdb->FidVarLastInitial() );
+
+        if ( fUseDMLLatch )
+        {
+            pfcb->EnterDML();
+        }
+
+        const FIELDFLAG     ffield      = ptdb->Pfield( pcolumn->columnid )->ffield;
+
+        if ( fUseDMLLatch )
+        {
+            pfcb->LeaveDML();
+        }
+
+        if ( FFIELDDeleted( ffield ) || FFIELDVersioned( ffield ) )
+        {
+            return fFalse;
+        }
+    }
+
+    return fTrue;
+}
+
+LOCAL ERR ErrRECIRetrieveColumnsWithPlan(
+    FUCB                * const pfucb,
+    RETRIEVE_PLAN       * const pplan,
+    JET_RETRIEVECOLUMN  * const pretcol,
+    const ULONG         cretcol,
+    BOOL                * const pfBufferTruncated )
+{
+    ERR                 err                 = JET_errSuccess;
+    const DATA *        pdataRec            = NULL;
+    ULONG               cretcolDeferred     = 0;
+    BOOL                fBufferTruncated    = fFalse;
+
+    Assert( FFUCBIndex( pfucb ) );
+    Assert( pplan->cretcol == cretcol );
+    AssertDIRNoLatch( pfucb->ppib );
+
+    *pfBufferTruncated = fFalse;
+
+    if ( 0 == pplan->cretcolPlanned
+        || ( pplan->fCheckDDL && !FRECIRetrievePlanCurrent( pplan ) ) )
+    {
+        return ErrRECRetrieveColumns( pfucb, pretcol, cretcol, pfBufferTruncated );
+    }
+
+    if ( ( pplan->fRetrieveCopy && FFUCBUpdatePrepared( pfucb ) && !FFUCBNeverRetrieveCopy( pfucb ) )
+        || FFUCBAlwaysRetrieveCopy( pfucb ) )
+    {
+        pdataRec = &pfucb->dataWorkBuf;
+    }
+    else
+    {
+        Call( ErrDIRGet( pfucb ) );
+        pdataRec = &pfucb->kdfCurr.data;
+    }
+
+    OSTraceFMP(
+        pfucb->ifmp,
+        JET_tracetagDMLRead,
+        OSFormat(
+            "Session=[0x%p:0x%x] retrieving %d planned columns from objid=[0x%x:0x%x] [copy=%c]",
+            pfucb->ppib,
+            ( ppibNil != pfucb->ppib ? pfucb->ppib->trxBegin0 : trxMax ),
+            pplan->cretcolPlanned,
+            (ULONG)pfucb->ifmp,
+            pfucb->u.pfcb->ObjidFDP(),
+            ( pdataRec == &pfucb->dataWorkBuf ? 'Y' : 'N' ) ) );
+
+    if ( pplan->cfidTagged > 0 )
+    {
+        if ( pdataRec->Cb() < REC::cbRecordMin || pdataRec->Cb() > REC::CbRecordMostCHECK( g_rgfmp[ pfucb->ifmp ].CbPage() ) )
+        {
+            FireWall( "RECIRetrieveColumnsWithPlanRecTooBig" );
+            Error( ErrERRCheck( JET_errDatabaseCorrupted ) );
+        }
+
+        TAGFIELDS   tagfields( *pdataRec );
+        tagfields.RetrieveFirstInstances(
+                    pplan->cfidTagged,
+                    pplan->rgfidTagged,
+                    pplan->rgfDerivedTagged,
+                    pplan->rgdataTagged,
+                    pplan->rgerrTagged );
+    }
+
+    for ( ULONG iretcol = 0; iretcol < cretcol; iretcol++ )
+    {
+        JET_RETRIEVECOLUMN * const          pretcolT    = pretcol + iretcol;
+        const RETRIEVE_PLAN_COLUMN * const  pcolumn     = pplan->rgcolumn + iretcol;
+        const COLUMNID                      columnid    = pcolumn->columnid;
+        DATA                                dataRetrieved;
+        ULONG                               cbCopy;
+
+        if ( !pcolumn->fPlanned
+            || 1 != pretcolT->itagSequence
+            || 0 != pretcolT->ibLongValue )
+        {
+            pplan->rgiretcolDeferred[ cretcolDeferred++ ] = iretcol;
+            continue;
+        }
+
+        if ( FCOLUMNIDTagged( columnid ) )
+        {
+            dataRetrieved = pplan->rgdataTagged[ pcolumn->ifidTagged ];
+            err = pplan->rgerrTagged[ pcolumn->ifidTagged ];
+
+            if ( JET_errColumnNotFound == err )
+            {
+                if ( !( pcolumn->grbit & JET_bitRetrieveIgnoreDefault )
+                    && pcolumn->pfcb->Ptdb()->FTableHasNonEscrowDefault() )
+                {
+                    pplan->rgiretcolDeferred[ cretcolDeferred++ ] = iretcol;
+                    continue;
+                }
+                err = ErrERRCheck( JET_wrnColumnNull );
+            }
+            else if ( wrnRECIntrinsicLV == err )
+            {
+                err = JET_errSuccess;
+            }
+        }
+        else if ( FCOLUMNIDFixed( columnid ) )
+        {
+            Call( ErrRECIRetrieveFixedColumn(
+                    pcolumn->pfcb,
+                    pcolumn->pfcb->Ptdb(),
+                    columnid,
+                    *pdataRec,
+                    &dataRetrieved,
+                    &pcolumn->fieldFixed ) );
+        }
+        else
+        {
+            Call( ErrRECIRetrieveVarColumn(
+                    pcolumn->pfcb,
+                    pcolumn->pfcb->Ptdb(),
+                    columnid,
+                    *pdataRec,
+                    &dataRetrieved ) );
+        }
+
+        if ( JET_errSuccess != err && JET_wrnColumnNull != err )
+        {
+            pplan->rgiretcolDeferred[ cretcolDeferred++ ] = iretcol;
+            continue;
+        }
+
+        if ( JET_wrnColumnNull == err )
+        {
+            dataRetrieved.Nullify();
+        }
+
+        pretcolT->cbActual = dataRetrieved.Cb();
+        if ( (ULONG)dataRetrieved.Cb() <= pretcolT->cbData )
+        {
+            pretcolT->err = err;
+            cbCopy = dataRetrieved.Cb();
+        }
+        else
+        {
+            pretcolT->err = ErrERRCheck( JET_wrnBufferTruncated );
+            cbCopy = pretcolT->cbData;
+            fBufferTruncated = fTrue;
+        }
+
+        UtilMemCpy( pretcolT->pvData, dataRetrieved.Pv(), cbCopy );
+
+        pretcolT->columnidNextTagged = columnid;
+    }
+
+    if ( Pcsr( pfucb )->FLatched() )
+    {
+        Call( ErrDIRRelease( pfucb ) );
+    }
+
+    for ( ULONG iretcolDeferred = 0; iretcolDeferred < cretcolDeferred; iretcolDeferred++ )
+    {
+        BOOL    fBufferTruncatedT   = fFalse;
+
+        Call( ErrRECRetrieveColumns(
+                    pfucb,
+                    pretcol + pplan->rgiretcolDeferred[ iretcolDeferred ],
+                    1,
+                    &fBufferTruncatedT ) );
+        fBufferTruncated = fBufferTruncated || fBufferTruncatedT;
+    }
+
+    *pfBufferTruncated = fBufferTruncated;
+    err = JET_errSuccess;
+
+HandleError:
+    if ( Pcsr( pfucb )->FLatched() )
+    {
+        CallS( ErrDIRRelease( pfucb ) );
+    }
+
+    AssertDIRNoLatch( pfucb->ppib );
+
+    return err;
+}
+
+ERR VTAPI ErrIsamPrepareRetrieveColumns(
+    _In_ const JET_SESID                                                sesid,
+    _In_ const JET_TABLEID                                              tableid,
+    _In_reads_opt_( cretrievecolumn ) const JET_RETRIEVECOLUMN * const  rgretrievecolumn,
+    _In_ const ULONG                                                    cretrievecolumn,
+    _In_ const JET_GRBIT                                                grbit )
+{
+    ERR                     err;
+    PIB                     *ppib               = (PIB *)sesid;
+    FUCB                    *pfucb              = (FUCB *)tableid;
+    BOOL                    fTransactionStarted = fFalse;
+
+    CallR( ErrPIBCheck( ppib ) );
+    CheckTable( ppib, pfucb );
+    AssertDIRNoLatch( ppib );
+
+    if ( NO_GRBIT != grbit )
+    {
+        return ErrERRCheck( JET_errInvalidGrbit );
+    }
+    if ( NULL == rgretrievecolumn && 0 != cretrievecolumn )
+    {
+        return ErrERRCheck( JET_errInvalidParameter );
+    }
+
+    RECRemoveRetrievePlan( pfucb );
+
+    if ( 0 == cretrievecolumn )
+    {
+        return JET_errSuccess;
+    }
+
+    if ( 0 == ppib->Level() )
+    {
+        Call( ErrDIRBeginTransaction( ppib, 53861, JET_bitTransactionReadOnly ) );
+        fTransactionStarted = fTrue;
+    }
+
+    Call( ErrRECIPrepareRetrieveColumns( pfucb, rgretrievecolumn, cretrievecolumn ) );
+
+HandleError:
+    if ( fTransactionStarted )
+    {
+        CallS( ErrDIRCommitTransaction( ppib, NO_GRBIT ) );
+    }
+    AssertDIRNoLatch( ppib );
+
+    return err;
+}
+
 ERR VTAPI ErrIsamRetrieveColumns(
     JET_SESID               vsesid,
     JET_VTID                vtid,
@@ -2688,11 +3149,24 @@ ERR VTAPI ErrIsamRetrieveColumns(
     AssertDIRNoLatch( ppib );
     Assert( FFUCBSort( pfucb ) || FFUCBIndex( pfucb ) );
 
-    Call( ErrRECRetrieveColumns(
-                pfucb,
-                pretcol,
-                cretcol,
-                &fBufferTruncated ) );
+    if ( NULL != pfucb->pretrieveplan
+        && FRECIRetrievePlanMatches( pfucb->pretrieveplan, pretcol, cretcol ) )
+    {
+        Call( ErrRECIRetrieveColumnsWithPlan(
+                    pfucb,
+                    pfucb->pretrieveplan,
+                    pretcol,
+                    cretcol,
+                    &fBufferTruncated ) );
+    }
+    else
+    {
+        Call( ErrRECRetrieveColumns(
+                    pfucb,
+                    pretcol,
+                    cretcol,
+                    &fBufferTruncated ) );
+    }
     if ( fBufferTruncated )
         err = ErrERRCheck( JET_wrnBufferTruncated );
 
@@ -0,0 +1,449 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "std.hxx"
+
+#ifndef ENABLE_JET_UNIT_TEST
+#error This file should only be compiled with the unit tests!
+#endif
+
+enum FLDEXTTESTCOLUMN
+{
+    fldexttestcolumnKey,
+    fldexttestcolumnFixed,
+    fldexttestcolumnVar,
+    fldexttestcolumnTagged,
+    fldexttestcolumnMultiValued,
+    fldexttestcolumnDefault,
+    fldexttestcolumnLong,
+    fldexttestcolumnMax,
+};
+
+//  the derived table inherits the first two columns from its template
+
+enum FLDEXTTESTDERIVEDCOLUMN
+{
+    fldexttestderivedcolumnTemplateFixed,
+    fldexttestderivedcolumnTemplateTagged,
+    fldexttestderivedcolumnFixed,
+    fldexttestderivedcolumnVar,
+    fldexttestderivedcolumnTagged,
+    fldexttestderivedcolumnMax,
+};
+
+const ULONG cbFldExtTestColumnMost  = 8 * 1024;
+const ULONG ccolumnFldExtTestMost   = fldexttestcolumnMax;
+
+C_ASSERT( fldexttestderivedcolumnMax <= ccolumnFldExtTestMost );
+
+LOCAL VOID FldExtTestIData( BYTE * const pb, const ULONG cb, const LONG irec )
+{
+    for ( ULONG ib = 0; ib < cb; ib++ )
+    {
+        pb[ ib ] = BYTE( irec * 13 + ib );
+    }
+}
+
+class FldExtTestFixture : public JetTestFixture
+{
+    protected:
+        JetTestDatabase     m_db;
+        JET_TABLEID         m_tableid;
+        JET_COLUMNID        m_rgcolumnid[ ccolumnFldExtTestMost ];
+
+    public:
+        FldExtTestFixture() : m_tableid( JET_tableidNil ) {}
+        ~FldExtTestFixture() {}
+
+    protected:
+        bool SetUp_()
+        {
+            return m_db.ErrInit( L"FldExtTest" ) >= JET_errSuccess;
+        }
+
+        void TearDown_()
+        {
+            if ( JET_tableidNil != m_tableid )
+            {
+                CHECKCALLS( JetCloseTable( m_db.Sesid(), m_tableid ) );
+            }
+            CHECKCALLS( m_db.ErrTerm() );
+        }
+
+        ERR ErrPopulate( const LONG crec );
+        ERR ErrPopulateDerived( const LONG crec );
+
+        VOID SetupRetrieve(
+            const ULONG                 ccolumn,
+            const INT                   icolumnMultiValued,
+            JET_RETRIEVECOLUMN * const  rgretcol,
+            BYTE * const                pbBuffer,
+            const ULONG                 cbBuffer );
+
+        VOID CompareRetrieve(
+            const ULONG                 ccolumn,
+            const INT                   icolumnMultiValued,
+            const ULONG                 cbBuffer );
+
+    public:
+        void RetrievePlanMatchesRetrieveColumns();
+        void RetrievePlanFollowsVersionedDeleteColumn();
+        void RetrievePlanMatchesOnDerivedTable();
+        void RetrievePlanPerf();
+};
+
+ERR FldExtTestFixture::ErrPopulate( const LONG crec )
+{
+    ERR             err;
+    const JET_SESID sesid       = m_db.Sesid();
+    JET_COLUMNDEF   columndef   = { sizeof( JET_COLUMNDEF ), 0, JET_coltypLong, 0, 0, 0, 0, 0, JET_bitColumnAutoincrement };
+    const LONG      lDefault    = 0x5eed;
+    BYTE            rgbData[ 300 ];
+    BYTE*           pbLong      = NULL;
+
+    Alloc( pbLong = new BYTE[ cbFldExtTestColumnMost ] );
+
+    Call( JetCreateTableA( sesid, m_db.Dbid(), "FldExtTest", 16, 100, &m_tableid ) );
+    Call( JetAddColumnA( sesid, m_tableid, "Key", &columndef, NULL, 0, &m_rgcolumnid[ fldexttestcolumnKey ] ) );
+    columndef.grbit = JET_bitColumnFixed;
+    Call( JetAddColumnA( sesid, m_tableid, "Fixed", &columndef, NULL, 0, &m_rgcolumnid[ fldexttestcolumnFixed ] ) );
+    columndef.coltyp = JET_coltypBinary;
+    columndef.grbit = NO_GRBIT;
+    Call( JetAddColumnA( sesid, m_tableid, "Var", &columndef, NULL, 0, &m_rgcolumnid[ fldexttestcolumnVar ] ) );
+    columndef.grbit = JET_bitColumnTagged;
+    Call( JetAddColumnA( sesid, m_tableid, "Tagged", &columndef, NULL, 0, &m_rgcolumnid[ fldexttestcolumnTagged ] ) );
+    columndef.grbit = JET_bitColumnTagged | JET_bitColumnMultiValued;
+    Call( JetAddColumnA( sesid, m_tableid, "MultiValued", &columndef, NULL, 0, &m_rgcolumnid[ fldexttestcolumnMultiValued ] ) );
+    columndef.coltyp = JET_coltypLong;
+    columndef.grbit = JET_bitColumnTagged;
+    Call( JetAddColumnA( sesid, m_tableid, "Default", &columndef, &lDefault, sizeof( lDefault ), &m_rgcolumnid[ fldexttestcolumnDefault ] ) );
+    columndef.coltyp = JET_coltypLongBinary;
+    Call( JetAddColumnA( sesid, m_tableid, "Long", &columndef, NULL, 0, &m_rgcolumnid[ fldexttestcolumnLong ] ) );
+    Call( JetCreateIndexA( sesid, m_tableid, "Primary", JET_bitIndexPrimary, "+Key\0", 6, 100 ) );
+
+    for ( LONG irec = 0; irec < crec; irec++ )
+    {
+        FldExtTestIData( rgbData, sizeof( rgbData ), irec );
+
+        Call( JetBeginTransaction( sesid ) );
+        Call( JetPrepareUpdate( sesid, m_tableid, JET_prepInsert ) );
+
+        if ( irec % 5 )
+        {
+            Call( JetSetColumn( sesid, m_tableid, m_rgcolumnid[ fldexttestcolumnFixed ], &irec, sizeof( irec ), NO_GRBIT, NULL ) );
+        }
+        if ( irec % 7 )
+        {
+            Call( JetSetColumn( sesid, m_tableid, m_rgcolumnid[ fldexttestcolumnVar ], rgbData, irec % 200, NO_GRBIT, NULL ) );
+        }
+        if ( irec % 3 )
+        {
+            Call( JetSetColumn( sesid, m_tableid, m_rgcolumnid[ fldexttestcolumnTagged ], rgbData + 1, 1 + irec % 250, NO_GRBIT, NULL ) );
+        }
+        for ( LONG iValue = 0; iValue < irec % 4; iValue++ )
+        {
+            JET_SETINFO setinfo = { sizeof( JET_SETINFO ), 0, 0 };
+            Call( JetSetColumn( sesid, m_tableid, m_rgcolumnid[ fldexttestcolumnMultiValued ], rgbData + iValue, 4 + iValue, NO_GRBIT, &setinfo ) );
+        }
+        if ( 0 == irec % 4 )
+        {
+            Call( JetSetColumn( sesid, m_tableid, m_rgcolumnid[ fldexttestcolumnDefault ], &irec, sizeof( irec ), NO_GRBIT, NULL ) );
+        }
+        if ( 0 == irec % 6 )
+        {
+            memset( pbLong, BYTE( irec ), cbFldExtTestColumnMost );
+            Call( JetSetColumn( sesid, m_tableid, m_rgcolumnid[ fldexttestcolumnLong ], pbLong, cbFldExtTestColumnMost, NO_GRBIT, NULL ) );
+        }
+
+        Call( JetUpdate( sesid, m_tableid, NULL, 0, NULL ) );
+        Call( JetCommitTransaction( sesid, JET_bitCommitLazyFlush ) );
+    }
+
+HandleError:
+    delete[] pbLong;
+    return err;
+}
+
+ERR FldExtTestFixture::ErrPopulateDerived( const LONG crec )
+{
+    ERR                 err;
+    const JET_SESID     sesid                   = m_db.Sesid();
+    BYTE                rgbData[ 300 ];
+    CHAR                szTemplateTable[]       = "FldExtTemplate";
+    CHAR                szDerivedTable[]        = "FldExtDerived";
+    CHAR                rgszColumn[][ 16 ]      = { "TemplateFixed", "TemplateTagged", "Fixed", "Var", "Tagged" };
+    JET_COLUMNCREATE_A  rgcolumncreate[]        =
+    {
+        { sizeof( JET_COLUMNCREATE_A ), rgszColumn[ 0 ], JET_coltypLong, 0, JET_bitColumnFixed, NULL, 0, 0, 0, JET_errSuccess },
+        { sizeof( JET_COLUMNCREATE_A ), rgszColumn[ 1 ], JET_coltypBinary, 0, JET_bitColumnTagged, NULL, 0, 0, 0, JET_errSuccess },
+        { sizeof( JET_COLUMNCREATE_A ), rgszColumn[ 2 ], JET_coltypLong, 0, JET_bitColumnFixed, NULL, 0, 0, 0, JET_errSuccess },
+        { sizeof( JET_COLUMNCREATE_A ), rgszColumn[ 3 ], JET_coltypBinary, 0, NO_GRBIT, NULL, 0, 0, 0, JET_errSuccess },
+        { sizeof( JET_COLUMNCREATE_A ), rgszColumn[ 4 ], JET_coltypBinary, 0, JET_bitColumnTagged, NULL, 0, 0, 0, JET_errSuccess },
+    };
+    JET_TABLECREATE_A   tablecreateTemplate     = { sizeof( JET_TABLECREATE_A ), szTemplateTable, NULL, 16, 100, rgcolumncreate, 2, NULL, 0, JET_bitTableCreateTemplateTable, JET_tableidNil, 0 };
+    JET_TABLECREATE_A   tablecreateDerived      = { sizeof( JET_TABLECREATE_A ), szDerivedTable, szTemplateTable, 16, 100, rgcolumncreate + 2, 3, NULL, 0, NO_GRBIT, JET_tableidNil, 0 };
+
+    C_ASSERT( _countof( rgszColumn ) == fldexttestderivedcolumnMax );
+    C_ASSERT( _countof( rgcolumncreate ) == fldexttestderivedcolumnMax );
+
+    Call( JetCreateTableColumnIndexA( sesid, m_db.Dbid(), &tablecreateTemplate ) );
+    Call( JetCloseTable( sesid, tablecreateTemplate.tableid ) );
+    Call( JetCreateTableColumnIndexA( sesid, m_db.Dbid(), &tablecreateDerived ) );
+    m_tableid = tablecreateDerived.tableid;
+
+    for ( ULONG icolumn = 0; icolumn < fldexttestderivedcolumnMax; icolumn++ )
+    {
+        JET_COLUMNDEF   columndef;
+
+        Call( JetGetTableColumnInfoA( sesid, m_tableid, rgszColumn[ icolumn ], &columndef, sizeof( columndef ), JET_ColInfo ) );
+        m_rgcolumnid[ icolumn ] = columndef.columnid;
+    }
+
+    for ( LONG irec = 0; irec < crec; irec++ )
+    {
+        FldExtTestIData( rgbData, sizeof( rgbData ), irec );
+
+        Call( JetBeginTransaction( sesid ) );
+        Call( JetPrepareUpdate( sesid, m_tableid, JET_prepInsert ) );
+
+        if ( irec % 3 )
+        {
+            Call( JetSetColumn( sesid, m_tableid, m_rgcolumnid[ fldexttestderivedcolumnTemplateFixed ], &irec, sizeof( irec ), NO_GRBIT, NULL ) );
+        }
+        if ( irec % 4 )
+        {
+            Call( JetSetColumn( sesid, m_tableid, m_rgcolumnid[ fldexttestderivedcolumnTemplateTagged ], rgbData, 1 + irec % 100, NO_GRBIT, NULL ) );
+        }
+        if ( irec % 5 )
+        {
+            Call( JetSetColumn( sesid, m_tableid, m_rgcolumnid[ fldexttestderivedcolumnFixed ], &irec, sizeof( irec ), NO_GRBIT, NULL ) );
+        }
+        if ( irec % 7 )
+        {
+            Call( JetSetColumn( sesid, m_tableid, m_rgcolumnid[ fldexttestderivedcolumnVar ], rgbData + 2, irec % 200, NO_GRBIT, NULL ) );
+        }
+        if ( irec % 2 )
+        {
+            Call( JetSetColumn( sesid, m_tableid, m_rgcolumnid[ fldexttestderivedcolumnTagged ], rgbData + 3, 1 + irec % 250, NO_GRBIT, NULL ) );
+        }
+
+        Call( JetUpdate( sesid, m_tableid, NULL, 0, NULL ) );
+        Call( JetCommitTransaction( sesid, JET_bitCommitLazyFlush ) );
+    }
+
+HandleError:
+    return err;
+}
+
+VOID FldExtTestFixture::SetupRetrieve(
+    const ULONG                 ccolumn,
+    const INT                   icolumnMultiValued,
+    JET_RETRIEVECOLUMN * const  rgretcol,
+    BYTE * const                pbBuffer,
+    const ULONG                 cbBuffer )
+{
+    memset( rgretcol, 0, sizeof( JET_RETRIEVECOLUMN ) * ccolumn );
+    memset( pbBuffer, 0, cbBuffer * ccolumn );
+
+    for ( ULONG icolumn = 0; icolumn < ccolumn; icolumn++ )
+    {
+        rgretcol[ icolumn ].columnid        = m_rgcolumnid[ icolumn ];
+        rgretcol[ icolumn ].pvData          = pbBuffer + icolumn * cbBuffer;
+        rgretcol[ icolumn ].cbData          = cbBuffer;
+        rgretcol[ icolumn ].itagSequence    = 1;
+    }
+
+    if ( icolumnMultiValued >= 0 )
+    {
+        rgretcol[ icolumnMultiValued ].itagSequence = 2;
+    }
+}
+
+VOID FldExtTestFixture::CompareRetrieve(
+    const ULONG         ccolumn,
+    const INT           icolumnMultiValued,
+    const ULONG         cbBuffer )
+{
+    const JET_SESID     sesid       = m_db.Sesid();
+    JET_RETRIEVECOLUMN  rgretcolPlan[ ccolumnFldExtTestMost ];
+    JET_RETRIEVECOLUMN  rgretcolNoPlan[ ccolumnFldExtTestMost ];
+    BYTE*               pbPlan      = new BYTE[ cbBuffer * ccolumn ];
+    BYTE*               pbNoPlan    = new BYTE[ cbBuffer * ccolumn ];
+    LONG                crec        = 0;
+    ERR                 err;
+
+    CHECK( pbPlan && pbNoPlan );
+    if ( !pbPlan || !pbNoPlan )
+    {
+        goto Cleanup;
+    }
+
+    SetupRetrieve( ccolumn, icolumnMultiValued, rgretcolPlan, pbPlan, cbBuffer );
+    CHECKCALLS( JetPrepareRetrieveColumns( sesid, m_tableid, rgretcolPlan, ccolumn, NO_GRBIT ) );
+
+    for ( err = JetMove( sesid, m_tableid, JET_MoveFirst, NO_GRBIT );
+        JET_errSuccess == err;
+        err = JetMove( sesid, m_tableid, JET_MoveNext, NO_GRBIT ) )
+    {
+        SetupRetrieve( ccolumn, icolumnMultiValued, rgretcolPlan, pbPlan, cbBuffer );
+        const ERR errPlan = JetRetrieveColumns( sesid, m_tableid, rgretcolPlan, ccolumn );
+
+        SetupRetrieve( ccolumn, icolumnMultiValued, rgretcolNoPlan, pbNoPlan, cbBuffer );
+        ERR errNoPlan = JET_errSuccess;
+        for ( ULONG icolumn = 0; icolumn < ccolumn; icolumn++ )
+        {
+            const ERR errT = JetRetrieveColumns( sesid, m_tableid, &rgretcolNoPlan[ icolumn ], 1 );
+            CHECK( errT >= JET_errSuccess );
+            errNoPlan = ( JET_errSuccess == errNoPlan ? errT : errNoPlan );
+        }
+
+        CHECK( errPlan == errNoPlan );
+        for ( ULONG icolumn = 0; icolumn < ccolumn; icolumn++ )
+        {
+            CHECK( rgretcolPlan[ icolumn ].err == rgretcolNoPlan[ icolumn ].err );
+            CHECK( rgretcolPlan[ icolumn ].cbActual == rgretcolNoPlan[ icolumn ].cbActual );
+            CHECK( rgretcolPlan[ icolumn ].columnidNextTagged == rgretcolNoPlan[ icolumn ].columnidNextTagged );
+        }
+        CHECK( 0 == memcmp( pbPlan, pbNoPlan, cbBuffer * ccolumn ) );
+
+        crec++;
+    }
+    CHECK( JET_errNoCurrentRecord == err );
+    CHECK( crec > 0 );
+
+Cleanup:
+    delete[] pbNoPlan;
+    delete[] pbPlan;
+}
+
+void FldExtTestFixture::RetrievePlanMatchesRetrieveColumns()
+{
+    const JET_SESID     sesid       = m_db.Sesid();
+    JET_RETRIEVECOLUMN  rgretcol[ fldexttestcolumnMax ];
+    BYTE                rgbBuffer[ 16 * fldexttestcolumnMax ];
+
+    CHECKCALLS( ErrPopulate( 500 ) );
+
+    CompareRetrieve( fldexttestcolumnMax, fldexttestcolumnMultiValued, cbFldExtTestColumnMost );
+    CompareRetrieve( fldexttestcolumnMax, fldexttestcolumnMultiValued, 16 );
+
+    SetupRetrieve( fldexttestcolumnMax, fldexttestcolumnMultiValued, rgretcol, rgbBuffer, 16 );
+    CHECKCALLS( JetPrepareRetrieveColumns( sesid, m_tableid, rgretcol, fldexttestcolumnMax, NO_GRBIT ) );
+    CHECKCALLS( JetDeleteColumnA( sesid, m_tableid, "Var" ) );
+    CHECKCALLS( JetMove( sesid, m_tableid, JET_MoveFirst, NO_GRBIT ) );
+    CHECK( JET_errColumnNotFound == JetRetrieveColumns( sesid, m_tableid, rgretcol, fldexttestcolumnMax ) );
+
+    CHECKCALLS( JetPrepareRetrieveColumns( sesid, m_tableid, NULL, 0, NO_GRBIT ) );
+    CHECK( JET_errInvalidGrbit == JetPrepareRetrieveColumns( sesid, m_tableid, rgretcol, fldexttestcolumnMax, JET_bitRetrieveCopy ) );
+    CHECK( JET_errColumnNotFound == JetPrepareRetrieveColumns( sesid, m_tableid, rgretcol, fldexttestcolumnMax, NO_GRBIT ) );
+}
+
+//  A column deleted by another session is versioned until that session commits or rolls back,
+//  so a plan over it is not current (FRECIRetrievePlanCurrent) and retrieval falls back to
+//  per-column retrieval, which still sees the column from this session's transaction.
+
+void FldExtTestFixture::RetrievePlanFollowsVersionedDeleteColumn()
+{
+    JET_SESID       sesidOther      = JET_sesidNil;
+    JET_DBID        dbidOther       = JET_dbidNil;
+    JET_TABLEID     tableidOther    = JET_tableidNil;
+
+    CHECKCALLS( ErrPopulate( 300 ) );
+
+    CHECKCALLS( JetBeginSessionW( m_db.Inst(), &sesidOther, NULL, NULL ) );
+    CHECKCALLS( JetOpenDatabaseW( sesidOther, m_db.WszDatabase(), NULL, &dbidOther, NO_GRBIT ) );
+    CHECKCALLS( JetOpenTableA( sesidOther, dbidOther, "FldExtTest", NULL, 0, NO_GRBIT, &tableidOther ) );
+
+    CHECKCALLS( JetBeginTransaction( m_db.Sesid() ) );
+
+    CHECKCALLS( JetBeginTransaction( sesidOther ) );
+    CHECKCALLS( JetDeleteColumnA( sesidOther, tableidOther, "Tagged" ) );
+    CHECKCALLS( JetDeleteColumnA( sesidOther, tableidOther, "Var" ) );
+
+    CompareRetrieve( fldexttestcolumnMax, fldexttestcolumnMultiValued, 64 );
+
+    CHECKCALLS( JetRollback( sesidOther, NO_GRBIT ) );
+
+    CompareRetrieve( fldexttestcolumnMax, fldexttestcolumnMultiValued, 64 );
+
+    CHECKCALLS( JetCommitTransaction( m_db.Sesid(), NO_GRBIT ) );
+
+    //  a committed delete of a column outside the plan leaves the plan in use
+
+    CHECKCALLS( JetDeleteColumnA( sesidOther, tableidOther, "Long" ) );
+    CompareRetrieve( fldexttestcolumnLong, fldexttestcolumnMultiValued, 64 );
+
+    CHECKCALLS( JetCloseTable( sesidOther, tableidOther ) );
+    CHECKCALLS( JetCloseDatabase( sesidOther, dbidOther, NO_GRBIT ) );
+    CHECKCALLS( JetEndSession( sesidOther, NO_GRBIT ) );
+}
+
+//  Template columns are planned against the template table's FCB.
+
+void FldExtTestFixture::RetrievePlanMatchesOnDerivedTable()
+{
+    CHECKCALLS( ErrPopulateDerived( 400 ) );
+
+    CompareRetrieve( fldexttestderivedcolumnMax, -1, 256 );
+    CompareRetrieve( fldexttestderivedcolumnMax, -1, 8 );
+
+    CHECKCALLS( JetDeleteColumnA( m_db.Sesid(), m_tableid, "Var" ) );
+    CompareRetrieve( fldexttestderivedcolumnVar, -1, 256 );
+    CHECK( JET_errFixedInheritedDDL == JetDeleteColumnA( m_db.Sesid(), m_tableid, "TemplateTagged" ) );
+}
+
+void FldExtTestFixture::RetrievePlanPerf()
+{
+    const LONG          crec        = 200000;
+    const ULONG         cbBuffer    = 256;
+    const JET_SESID     sesid       = m_db.Sesid();
+    JET_RETRIEVECOLUMN  rgretcol[ fldexttestcolumnMax ];
+    BYTE*               pbBuffer    = new BYTE[ cbBuffer * fldexttestcolumnMax ];
+
+    CHECK( NULL != pbBuffer );
+    if ( NULL == pbBuffer )
+    {
+        return;
+    }
+
+    CHECKCALLS( ErrPopulate( crec ) );
+
+    for ( INT iPass = 0; iPass < 2; iPass++ )
+    {
+        SetupRetrieve( fldexttestcolumnMax, fldexttestcolumnMultiValued, rgretcol, pbBuffer, cbBuffer );
+        CHECKCALLS( JetPrepareRetrieveColumns( sesid, m_tableid, rgretcol, iPass ? fldexttestcolumnMax : 0, NO_GRBIT ) );
+
+        const HRT   hrtStart    = HrtHRTCount();
+        LONG        crecSeen    = 0;
+
+        CHECKCALLS( JetBeginTransaction( sesid ) );
+        for ( ERR err = JetMove( sesid, m_tableid, JET_MoveFirst, NO_GRBIT );
+            JET_errSuccess == err;
+            err = JetMove( sesid, m_tableid, JET_MoveNext, NO_GRBIT ) )
+        {
+            (VOID)JetRetrieveColumns( sesid, m_tableid, rgretcol, fldexttestcolumnMax );
+            crecSeen++;
+        }
+        CHECKCALLS( JetCommitTransaction( sesid, NO_GRBIT ) );
+        CHECK( crec == crecSeen );
+
+        const QWORD cusec = CusecHRTFromDhrt( HrtHRTCount() - hrtStart );
+        REPORTMETRIC( iPass ? "plan" : "no plan", (QWORD)crec * 1000000 / max( cusec, (QWORD)1 ), "records/sec" );
+    }
+
+    delete[] pbBuffer;
+}
+
+static const JetTestCaller<FldExtTestFixture> fldext1(
+    "FLDEXT.RetrievePlanMatchesRetrieveColumns",
+    &FldExtTestFixture::RetrievePlanMatchesRetrieveColumns );
+static const JetTestCaller<FldExtTestFixture> fldext2(
+    "FLDEXT.RetrievePlanFollowsVersionedDeleteColumn",
+    &FldExtTestFixture::RetrievePlanFollowsVersionedDeleteColumn );
+static const JetTestCaller<FldExtTestFixture> fldext3(
+    "FLDEXT.RetrievePlanMatchesOnDerivedTable",
+    &FldExtTestFixture::RetrievePlanMatchesOnDerivedTable );
+static const JetTestCaller<FldExtTestFixture> fldext4(
+    "FLDEXT.RetrievePlanPerf",
+    JetSimpleUnitTest::dwDontRunByDefault,
+    &FldExtTestFixture::RetrievePlanPerf );
@@ -2038,51 +2038,56 @@ ERR CFlushMap::ErrSetRangePgnoFlushType_( const PGNO pgnoFirst, const CPG cpg, c
     FlushMapPageDescriptor* pfmd = NULL;
     FMPGNO fmpgnoFirst = s_fmpgnoUninit;
     FMPGNO fmpgnoLast = s_fmpgnoUninit;
+    CPG cpgInFmPage = 0;
 
     AssertSz( m_fGetSetAllowed && !m_fDumpMode, "Setting flush type not allowed in CFlushMap::ErrSetRangePgnoFlushType_()." );
     AssertSz( !m_fCleanForTerm, "Setting flush type not allowed with clean map." );
     Expected( cpg > 0 );
 
-    for ( PGNO pgno = pgnoFirst; pgno < ( pgnoFirst + cpg ); pgno++ )
+    const BOOL fValidDbTime = ( ( dbtime != dbtimeNil ) && ( dbtime != dbtimeInvalid ) && ( dbtime != dbtimeShrunk ) && ( dbtime > 0 ) && ( dbtime != dbtimeRevert ) );
+    Expected( fValidDbTime ||
+        ( dbtime == dbtimeNil ) ||
+        ( dbtime == 0 ) ||
+        ( dbtime == dbtimeShrunk ) ||
+        ( dbtime == dbtimeRevert ) );
+
+#ifndef ENABLE_JET_UNIT_TEST
+    Expected( ( cpg == 1 ) || ( pgft == CPAGE::pgftUnknown ) );
+
+    Assert( ( cpg == 1 ) || ( dbtime == dbtimeNil ) );
+
+    Assert( fValidDbTime || ( pgft == CPAGE::pgftUnknown ) );
+#endif
+
+    for ( PGNO pgno = pgnoFirst; pgno < ( pgnoFirst + cpg ); pgno += cpgInFmPage )
     {
-        const FlushMapPageDescriptor* const pfmdT = pfmd;
         Call( ErrGetDescriptorFromPgno_( pgno, &pfmd ) );
 
-        if ( pfmd != pfmdT )
+        if ( !pfmd->FValid() )
         {
-            if ( !pfmd->FValid() )
-            {
-                Error( ErrERRCheck( JET_errInvalidOperation ) );
-            }
+            Error( ErrERRCheck( JET_errInvalidOperation ) );
         }
 
-        Assert( pfmd->FValid() );
+        cpgInFmPage = (CPG)min( (PGNO)( pgnoFirst + cpg - pgno ), (PGNO)( m_cDbPagesPerFlushMapPage - ( pgno % m_cDbPagesPerFlushMapPage ) ) );
+
         Assert( pfmd->sxwl.FNotOwner() );
         pfmd->sxwl.AcquireSharedLatch();
 
-        const BOOL fValidDbTime = ( ( dbtime != dbtimeNil ) && ( dbtime != dbtimeInvalid ) && ( dbtime != dbtimeShrunk ) && ( dbtime > 0 ) && ( dbtime != dbtimeRevert ) );
-        Expected( fValidDbTime ||
-            ( dbtime == dbtimeNil ) ||
-            ( dbtime == 0 ) ||
-            ( dbtime == dbtimeShrunk ) ||
-            ( dbtime == dbtimeRevert ) );
-
-#ifndef ENABLE_JET_UNIT_TEST
-        Expected( ( cpg == 1 ) || ( pgft == CPAGE::pgftUnknown ) );
-
-        Assert( ( cpg == 1 ) || ( dbtime == dbtimeNil ) );
-
-        Assert( fValidDbTime || ( pgft == CPAGE::pgftUnknown ) );
-#endif
-
         if ( fValidDbTime )
         {
             AtomicExchangeMax( &pfmd->dbtimeMax, dbtime );
         }
 
-        SetFlushType_( pfmd, pgno, pgft );
-
-        SetFlushTypeRuntimeState_( pfmd, pgno, fTrue );
+        if ( cpgInFmPage == 1 )
+        {
+            SetFlushType_( pfmd, pgno, pgft );
+            SetFlushTypeRuntimeState_( pfmd, pgno, fTrue );
+        }
+        else
+        {
+            SetRangeFlushType_( pfmd, pgno, cpgInFmPage, pgft );
+            SetRangeFlushTypeRuntimeState_( pfmd, pgno, cpgInFmPage, fTrue );
+        }
 
         pfmd->SetDirty( m_pinst );
         pfmd->sxwl.ReleaseSharedLatch();
@@ -2185,6 +2190,77 @@ INLINE void CFlushMap::SetStateOnBitmap_(
     }
 }
 
+LOCAL INLINE void FlushMapISetBitRangeInDword(
+    BYTE* const pbBitmap, const DWORD idw,
+    const DWORD ibitFirst, const DWORD ibitEnd, const DWORD dwFill )
+{
+    DWORD dwMask = 0;
+    BYTE* const pbMask = (BYTE*)&dwMask;
+    for ( DWORD ib = 0; ib < sizeof( DWORD ); ib++ )
+    {
+        const DWORD ibitByte = 8 * ( idw * sizeof( DWORD ) + ib );
+        const DWORD ibitLow = max( ibitFirst, ibitByte );
+        const DWORD ibitHigh = min( ibitEnd, ibitByte + 8 );
+        if ( ibitLow < ibitHigh )
+        {
+            pbMask[ ib ] = (BYTE)( ( 0xFF >> ( ibitLow - ibitByte ) ) & ~( 0xFF >> ( ibitHigh - ibitByte ) ) );
+        }
+    }
+
+    volatile DWORD* const pdw = (DWORD*)pbBitmap + idw;
+    OSSYNC_FOREVER
+    {
+        const DWORD dwInitial = *pdw;
+        const DWORD dwTarget = ( dwInitial & ~dwMask ) | ( dwFill & dwMask );
+        const DWORD dwFinal = AtomicCompareExchange( (LONG*)pdw, (LONG)dwInitial, (LONG)dwTarget );
+
+        if ( dwFinal == dwInitial )
+        {
+            break;
+        }
+    }
+}
+
+INLINE void CFlushMap::SetRangeStateOnBitmap_(
+    BYTE* const pbBitmap, const size_t cbBitmap,
+    const PGNO pgnoFirst, const CPG cpg, const INT state,
+    const size_t cbHeader, const DWORD cbitPerState )
+{
+    Assert( state >= 0 );
+    Assert( state < ( 0x01 << cbitPerState ) );
+    Assert( cpg > 0 );
+    Assert( ( ( pgnoFirst % m_cDbPagesPerFlushMapPage ) + cpg ) <= m_cDbPagesPerFlushMapPage );
+
+    const DWORD cbitInDword = 8 * sizeof( DWORD );
+    const DWORD ibitFirst = IbitGetBitInPage_( pgnoFirst, cbHeader, cbitPerState );
+    const DWORD ibitEnd = ibitFirst + cpg * cbitPerState;
+    Assert( ibitEnd <= ( 8 * cbBitmap ) );
+
+    BYTE bFill = 0;
+    for ( DWORD ibit = 0; ibit < 8; ibit += cbitPerState )
+    {
+        bFill |= (BYTE)( state << ibit );
+    }
+
+    DWORD dwFill = 0;
+    memset( &dwFill, bFill, sizeof( dwFill ) );
+
+    const DWORD idwFirst = ibitFirst / cbitInDword;
+    const DWORD idwLast = ( ibitEnd - 1 ) / cbitInDword;
+    Assert( idwLast < ( cbBitmap / sizeof( DWORD ) ) );
+
+    FlushMapISetBitRangeInDword( pbBitmap, idwFirst, ibitFirst, ibitEnd, dwFill );
+    if ( idwLast > idwFirst )
+    {
+        FlushMapISetBitRangeInDword( pbBitmap, idwLast, ibitFirst, ibitEnd, dwFill );
+    }
+
+    if ( idwLast > idwFirst + 1 )
+    {
+        memset( pbBitmap + ( idwFirst + 1 ) * sizeof( DWORD ), bFill, ( idwLast - idwFirst - 1 ) * sizeof( DWORD ) );
+    }
+}
+
 CPAGE::PageFlushType CFlushMap::PgftGetFlushType_( FlushMapPageDescriptor* const pfmd, const PGNO pgno )
 {
     const INT state = IGetStateFromBitmap_( (BYTE*)pfmd->pv, s_cbFlushMapPageOnDisk, pgno, sizeof( FlushMapDataPageHdr ), s_cbitFlushType, s_mskFlushType );
@@ -2203,6 +2279,15 @@ void CFlushMap::SetFlushType_( FlushMapPageDescriptor* const pfmd, const PGNO pg
     SetStateOnBitmap_( (BYTE*)pfmd->pv, s_cbFlushMapPageOnDisk, pgno, state, sizeof( FlushMapDataPageHdr ), s_cbitFlushType, s_mskFlushType );
 }
 
+void CFlushMap::SetRangeFlushType_( FlushMapPageDescriptor* const pfmd, const PGNO pgnoFirst, const CPG cpg, const CPAGE::PageFlushType pgft )
+{
+    const INT state = (INT)pgft;
+    Assert( state >= 0 );
+    Assert( state < (INT)CPAGE::pgftMax );
+
+    SetRangeStateOnBitmap_( (BYTE*)pfmd->pv, s_cbFlushMapPageOnDisk, pgnoFirst, cpg, state, sizeof( FlushMapDataPageHdr ), s_cbitFlushType );
+}
+
 BOOL CFlushMap::FGetFlushTypeRuntime_( FlushMapPageDescriptor* const pfmd, const PGNO pgno )
 {
     if ( pfmd->rgbitRuntime == NULL )
@@ -2228,6 +2313,18 @@ void CFlushMap::SetFlushTypeRuntimeState_( FlushMapPageDescriptor* const pfmd, c
     SetStateOnBitmap_( (BYTE*)pfmd->rgbitRuntime, m_cbRuntimeBitmapPage, pgno, state, 0, 1, 0x80 );
 }
 
+void CFlushMap::SetRangeFlushTypeRuntimeState_( FlushMapPageDescriptor* const pfmd, const PGNO pgnoFirst, const CPG cpg, const BOOL fRuntime )
+{
+    if ( pfmd->rgbitRuntime == NULL )
+    {
+        return;
+    }
+
+    const INT state = fRuntime ? 1 : 0;
+
+    SetRangeStateOnBitmap_( (BYTE*)pfmd->rgbitRuntime, m_cbRuntimeBitmapPage, pgnoFirst, cpg, state, 0, 1 );
+}
+
 void CFlushMap::LogEventFmFileAttachFailed_( const WCHAR* const wszFmFilePath, const ERR err )
 {
     WCHAR wszError[ 32 ];
@@ -289,6 +289,82 @@ JETUNITTEST( CFlushMap, BasicRangeSettingAndResetting )
     delete pfm;
 }
 
+JETUNITTEST( CFlushMap, RangeSettingMatchesSinglePageSetting )
+{
+    CFlushMap* pfm = new CFlushMapForUnattachedDb();
+    pfm->SetPersisted( fFalse );
+
+    CHECK( JET_errSuccess == pfm->ErrInitFlushMap() );
+
+    const PGNO cpgMap = 3 * pfm->m_cDbPagesPerFlushMapPage;
+    BYTE* const rgpgft = new BYTE[ cpgMap ];
+    CHECK( NULL != rgpgft );
+    memset( rgpgft, CPAGE::pgftUnknown, cpgMap );
+
+    CHECK( JET_errSuccess == pfm->ErrSetFlushMapCapacity( cpgMap - 1 ) );
+
+    for ( INT iRange = 0; iRange < 500; iRange++ )
+    {
+        const PGNO pgnoFirst = rand() % cpgMap;
+        const CPG cpg = 1 + ( iRange % 2 ? rand() % 70 : rand() % ( 2 * pfm->m_cDbPagesPerFlushMapPage ) );
+        const CPG cpgActual = (CPG)min( (PGNO)cpg, cpgMap - pgnoFirst );
+        const CPAGE::PageFlushType pgft = (CPAGE::PageFlushType)( rand() % CPAGE::pgftMax );
+
+        CHECK( JET_errSuccess == pfm->ErrSetRangeFlushTypeAndWait( pgnoFirst, cpgActual, pgft ) );
+        memset( rgpgft + pgnoFirst, pgft, cpgActual );
+
+        CHECK( rgpgft[ pgnoFirst ] == pfm->PgftGetPgnoFlushType( pgnoFirst ) );
+        CHECK( rgpgft[ pgnoFirst + cpgActual - 1 ] == pfm->PgftGetPgnoFlushType( pgnoFirst + cpgActual - 1 ) );
+    }
+
+    for ( PGNO pgno = 0; pgno < cpgMap; pgno++ )
+    {
+        CHECK( rgpgft[ pgno ] == pfm->PgftGetPgnoFlushType( pgno ) );
+    }
+
+    delete[] rgpgft;
+    delete pfm;
+}
+
+JETUNITTESTEX( CFlushMap, RangeSettingPerf, JetSimpleUnitTest::dwDontRunByDefault )
+{
+    CFlushMap* pfm = new CFlushMapForUnattachedDb();
+    pfm->SetPersisted( fFalse );
+
+    CHECK( JET_errSuccess == pfm->ErrInitFlushMap() );
+
+    const CPG cpgRange = 1024 * 1024;
+    const INT cIteration = 20;
+    CHECK( JET_errSuccess == pfm->ErrSetFlushMapCapacity( cpgRange ) );
+
+    HRT hrtStart = HrtHRTCount();
+    for ( INT iIteration = 0; iIteration < cIteration; iIteration++ )
+    {
+        for ( PGNO pgno = 1; pgno <= (PGNO)cpgRange; pgno++ )
+        {
+            pfm->SetPgnoFlushType( pgno, CPAGE::PgftGetNextFlushType( (CPAGE::PageFlushType)( iIteration % CPAGE::pgftMax ) ) );
+        }
+    }
+    const QWORD cusecSinglePage = CusecHRTFromDhrt( HrtHRTCount() - hrtStart );
+
+    hrtStart = HrtHRTCount();
+    for ( INT iIteration = 0; iIteration < cIteration; iIteration++ )
+    {
+        CHECK( JET_errSuccess == pfm->ErrSetRangeFlushTypeAndWait( 1, cpgRange, CPAGE::PgftGetNextFlushType( (CPAGE::PageFlushType)( iIteration % CPAGE::pgftMax ) ) ) );
+    }
+    const QWORD cusecRange = CusecHRTFromDhrt( HrtHRTCount() - hrtStart );
+
+    for ( PGNO pgno = 1; pgno <= (PGNO)cpgRange; pgno++ )
+    {
+        CHECK( CPAGE::PgftGetNextFlushType( (CPAGE::PageFlushType)( ( cIteration - 1 ) % CPAGE::pgftMax ) ) == pfm->PgftGetPgnoFlushType( pgno ) );
+    }
+
+    REPORTMETRIC( "single-page", (QWORD)cpgRange * cIteration * 1000000 / max( cusecSinglePage, (QWORD)1 ), "pages/sec" );
+    REPORTMETRIC( "range", (QWORD)cpgRange * cIteration * 1000000 / max( cusecRange, (QWORD)1 ), "pages/sec" );
+
+    delete pfm;
+}
+
 JETUNITTEST( CFlushMap, BasicPersistedFlushMap )
 {
     CFlushMapForUnattachedDb* pfm = new CFlushMapForUnattachedDb();
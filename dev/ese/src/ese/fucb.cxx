@@ -42,6 +42,7 @@ FUCB::~FUCB()
 {
     RECReleaseKeySearchBuffer( this );
     RECRemoveCursorFilter( this );
+    RECRemoveRetrievePlan( this );
     FUCBRemoveEncryptionKey( this );
     if ( JET_LSNil != ls )
     {
@@ -1076,6 +1076,148 @@ HandleError:
 }
 
 
+LOCAL ERR ErrINFOTrainCompressionDictionary( PIB * const ppib, FUCB * const pfucb, const ULONG cbDictionaryMax )
+{
+    const INT       cbSamplesMax        = 1024 * 1024;
+    const INT       cbSampleMax         = 4096;
+    const INT       cdataSampleMax      = cbSamplesMax / 64;
+
+    ERR             err                 = JET_errSuccess;
+    FCB * const     pfcb                = pfucb->u.pfcb;
+    TDB * const     ptdb                = pfcb->Ptdb();
+    FUCB *          pfucbT              = pfucbNil;
+    BOOL            fTransactionStarted = fFalse;
+    BYTE *          pbSamples           = NULL;
+    DATA *          rgdataSample        = NULL;
+    BYTE *          pbDictionary        = NULL;
+    PKDICTIONARY *  pdict               = NULL;
+    INT             ibSamples           = 0;
+    INT             cdataSample         = 0;
+    INT             cbDictionary        = 0;
+    BYTE            idDictionary        = 0;
+    FID             fidFirst;
+    FID             fidLast;
+
+    if ( FFMPIsTempDB( pfucb->ifmp ) || cbDictionaryMax < 64 || cbDictionaryMax > cbPKDictionaryMax )
+    {
+        return ErrERRCheck( JET_errInvalidParameter );
+    }
+
+    if ( 0 != ppib->Level() )
+    {
+        return ErrERRCheck( JET_errInTransaction );
+    }
+
+    //  system tables are read through paths that have no user table FCB to find a dictionary in
+    //  (e.g. OLD's restart state in MSysDefrag2), so they never get one
+
+    pfcb->EnterDML();
+    const BOOL fSystemTable = FCATSystemTable( pfcb->PgnoFDP() ) || FOLDSystemTable( ptdb->SzTableName() );
+    pfcb->LeaveDML();
+    if ( fSystemTable )
+    {
+        return ErrERRCheck( JET_errInvalidOperation );
+    }
+
+    CallR( g_rgfmp[ pfucb->ifmp ].ErrDBFormatFeatureEnabled( JET_efvCompressionDictionaries ) );
+
+    Alloc( pbSamples = new BYTE[ cbSamplesMax ] );
+    Alloc( rgdataSample = new DATA[ cdataSampleMax ] );
+    Alloc( pbDictionary = new BYTE[ cbDictionaryMax ] );
+
+    pfcb->EnterDML();
+    fidFirst = ptdb->FidTaggedFirst();
+    fidLast = ptdb->FidTaggedLast();
+    pfcb->LeaveDML();
+
+    Call( ErrDIRBeginTransaction( ppib, 47013, JET_bitTransactionReadOnly ) );
+    fTransactionStarted = fTrue;
+
+    Call( ErrIsamDupCursor( ppib, pfucb, &pfucbT, NO_GRBIT ) );
+
+    for ( err = ErrIsamMove( ppib, pfucbT, JET_MoveFirst, NO_GRBIT );
+          err >= JET_errSuccess && ibSamples < cbSamplesMax && cdataSample < cdataSampleMax;
+          err = ErrIsamMove( ppib, pfucbT, JET_MoveNext, NO_GRBIT ) )
+    {
+        for ( FID fid = fidFirst; fid <= fidLast && ibSamples < cbSamplesMax && cdataSample < cdataSampleMax; fid++ )
+        {
+            const COLUMNID columnid = ColumnidOfFid( fid, ptdb->FTemplateTable() );
+
+            pfcb->EnterDML();
+            const FIELD * const pfield = ptdb->PfieldTagged( columnid );
+            const BOOL fSample = !FFIELDDeleted( pfield->ffield )
+                                    && FFIELDCompressed( pfield->ffield )
+                                    && !FFIELDEncrypted( pfield->ffield )
+                                    && FRECLongValue( pfield->coltyp );
+            pfcb->LeaveDML();
+
+            if ( !fSample )
+            {
+                continue;
+            }
+
+            ULONG cbActual = 0;
+            const ULONG cbMax = min( cbSampleMax, cbSamplesMax - ibSamples );
+            Call( ErrIsamRetrieveColumn( ppib, pfucbT, columnid, pbSamples + ibSamples, cbMax, &cbActual, NO_GRBIT, NULL ) );
+            if ( JET_wrnColumnNull == err || 0 == cbActual )
+            {
+                continue;
+            }
+
+            rgdataSample[ cdataSample ].SetPv( pbSamples + ibSamples );
+            rgdataSample[ cdataSample ].SetCb( min( cbActual, cbMax ) );
+            ibSamples += rgdataSample[ cdataSample ].Cb();
+            cdataSample++;
+        }
+    }
+    if ( JET_errNoCurrentRecord == err )
+    {
+        err = JET_errSuccess;
+    }
+    Call( err );
+
+    CallS( ErrIsamCloseTable( ppib, pfucbT ) );
+    pfucbT = pfucbNil;
+
+    CallS( ErrDIRCommitTransaction( ppib, NO_GRBIT ) );
+    fTransactionStarted = fFalse;
+
+    Call( ErrPKTrainDictionary( rgdataSample, cdataSample, pbDictionary, cbDictionaryMax, &cbDictionary ) );
+    if ( cbDictionary < cbPKDictionaryMatchMin )
+    {
+        Error( ErrERRCheck( JET_errInvalidOperation ) );
+    }
+
+    DATA dataDictionary;
+    dataDictionary.SetPv( pbDictionary );
+    dataDictionary.SetCb( cbDictionary );
+
+    Call( ErrCATAddCompressionDictionary( ppib, pfucb->ifmp, pfcb->ObjidFDP(), dataDictionary, &idDictionary ) );
+
+    //  build the dictionary's hash table before taking the DML latch and only publish it there
+
+    Call( ErrPKCreateDictionary( idDictionary, dataDictionary, NULL, &pdict ) );
+
+    pfcb->EnterDML();
+    PKLinkDictionary( pdict, ptdb->PdictCompression() );
+    ptdb->SetPdictCompression( pdict );
+    pfcb->LeaveDML();
+
+HandleError:
+    if ( pfucbNil != pfucbT )
+    {
+        CallS( ErrIsamCloseTable( ppib, pfucbT ) );
+    }
+    if ( fTransactionStarted )
+    {
+        CallS( ErrDIRCommitTransaction( ppib, NO_GRBIT ) );
+    }
+    delete[] pbDictionary;
+    delete[] rgdataSample;
+    delete[] pbSamples;
+    return err;
+}
+
 ERR VTAPI ErrIsamSetTableInfo(
     JET_SESID sesid,
     JET_VTID vtid,
@@ -1119,6 +1261,13 @@ ERR VTAPI ErrIsamSetTableInfo(
             }
             return JET_errSuccess;
 
+        case JET_TblInfoCompressionDictionary:
+            if ( NULL != pvParam && cbParam != sizeof( ULONG ) )
+            {
+                return ErrERRCheck( JET_errInvalidBufferSize );
+            }
+            return ErrINFOTrainCompressionDictionary( ppib, pfucb, pvParam ? *(ULONG *)pvParam : 8 * 1024 );
+
         default:
             Assert( fFalse );
             return ErrERRCheck( JET_errFeatureNotAvailable );
@@ -5965,16 +5965,15 @@ VOID FMP::FreeHeaderSignature()
 }
 
 
-struct READPAGE_DATA
-{
-    volatile ERR            err;
-    volatile LONG*          pacRead;
-    CAutoResetSignal*       pasigDone;
-    BOOL                    fCheckPagesOffset;
-    BOOL                    fExtensiveChecks;
-    IFMP                    ifmp;
-    LONG                    pgnoMost;
-};
+LOCAL VOID IOIReadDbPagesDone( READPAGE_DATA* const preaddata )
+{
+    if ( preaddata->pgnoUnlockStart != pgnoNull )
+    {
+        g_rgfmp[ preaddata->ifmp ].RangeUnlock( preaddata->pgnoUnlockStart, preaddata->pgnoUnlockEnd );
+    }
+
+    preaddata->pasigDone->Set();
+}
 
 void IOReadDbPagesCompleted(
     const ERR err,
@@ -6054,39 +6053,28 @@ void IOReadDbPagesCompleted(
     if ( !AtomicDecrement( (LONG*)preaddata->pacRead ) )
     {
         
-        preaddata->pasigDone->Set();
+        IOIReadDbPagesDone( preaddata );
     }
 }
 
 
 
-ERR ErrIOReadDbPages(
+ERR ErrIOIssueReadDbPages(
     IFMP ifmp,
     IFileAPI *pfapi,
     BYTE *pbData,
     LONG pgnoStart,
     LONG pgnoEnd,
-    BOOL fCheckPagesOffset,
-    LONG pgnoMost,
     const TraceContext& tc,
-    BOOL fExtensiveChecks )
+    READPAGE_DATA * const preaddata )
 {
     ERR     err     = JET_errSuccess;
     
 
     PGNO pgnoMaxDb = pgnoEnd + 1;
 
-    volatile LONG acRead = 0;
-    CAutoResetSignal asigDone( CSyncBasicInfo( _T( "ErrIOReadDbPages::asigDone" ) ) );
-
-    READPAGE_DATA readdata;
-    readdata.err = JET_errSuccess;
-    readdata.pacRead = &acRead;
-    readdata.pasigDone = &asigDone;
-    readdata.fCheckPagesOffset = fCheckPagesOffset;
-    readdata.fExtensiveChecks = fExtensiveChecks;
-    readdata.ifmp = ifmp;
-    readdata.pgnoMost = pgnoMost;
+    Assert( preaddata->err >= JET_errSuccess );
+    Assert( *preaddata->pacRead == 0 );
 
     DWORD cReadIssue;
     cReadIssue = 0;
@@ -6096,7 +6084,7 @@ ERR ErrIOReadDbPages(
     
     for ( pgno1 = pgnoStart,
           pgno2 = min( PGNO( ( ( pgnoStart + cpgDBReserved - 1 ) / cpgBackupChunkSize + 1 ) * cpgBackupChunkSize - cpgDBReserved + 1 ), pgnoMaxDb );
-          pgno1 < pgnoMaxDb && ( readdata.err >= 0 );
+          pgno1 < pgnoMaxDb && ( preaddata->err >= 0 );
           pgno1 = pgno2,
           pgno2 = (PGNO)min( pgno1 + cpgBackupChunkSize, pgnoMaxDb ) )
     {
@@ -6114,10 +6102,10 @@ ERR ErrIOReadDbPages(
                                 pbData,
                                 QosAsyncReadDefault( PinstFromIfmp( ifmp ) ),
                                 IFileAPI::PfnIOComplete( IOReadDbPagesCompleted ),
-                                DWORD_PTR( &readdata ) );
-        if ( err < 0 && readdata.err >= 0 )
+                                DWORD_PTR( preaddata ) );
+        if ( err < 0 && preaddata->err >= 0 )
         {
-            readdata.err = err;
+            preaddata->err = err;
         }
         pbData += cbData;
 
@@ -6125,10 +6113,13 @@ ERR ErrIOReadDbPages(
     }
 
     
-    if ( AtomicExchangeAdd( (LONG*)&acRead, cReadIssue ) + cReadIssue != 0 )
+    if ( AtomicExchangeAdd( (LONG*)preaddata->pacRead, cReadIssue ) + cReadIssue != 0 )
     {
         CallS( pfapi->ErrIOIssue() );
-        asigDone.Wait();
+    }
+    else
+    {
+        IOIReadDbPagesDone( preaddata );
     }
 
     if ( tc.iorReason.Iorp() == iorpBackup )
@@ -6136,6 +6127,40 @@ ERR ErrIOReadDbPages(
         PERFOpt( cBKReadPages.Add( PinstFromIfmp( ifmp ), cReadIssue ) );
     }
 
+    return err;
+}
+
+ERR ErrIOReadDbPages(
+    IFMP ifmp,
+    IFileAPI *pfapi,
+    BYTE *pbData,
+    LONG pgnoStart,
+    LONG pgnoEnd,
+    BOOL fCheckPagesOffset,
+    LONG pgnoMost,
+    const TraceContext& tc,
+    BOOL fExtensiveChecks )
+{
+    ERR     err     = JET_errSuccess;
+
+    volatile LONG acRead = 0;
+    CAutoResetSignal asigDone( CSyncBasicInfo( _T( "ErrIOReadDbPages::asigDone" ) ) );
+
+    READPAGE_DATA readdata;
+    readdata.err = JET_errSuccess;
+    readdata.pacRead = &acRead;
+    readdata.pasigDone = &asigDone;
+    readdata.fCheckPagesOffset = fCheckPagesOffset;
+    readdata.fExtensiveChecks = fExtensiveChecks;
+    readdata.ifmp = ifmp;
+    readdata.pgnoMost = pgnoMost;
+    readdata.pgnoUnlockStart = pgnoNull;
+    readdata.pgnoUnlockEnd = pgnoNull;
+
+    err = ErrIOIssueReadDbPages( ifmp, pfapi, pbData, pgnoStart, pgnoEnd, tc, &readdata );
+
+    asigDone.Wait();
+
     
     err = ( err < 0 ? err : readdata.err );
     return err;
@@ -584,6 +584,26 @@ ERR VTAPI ErrIllegalStreamRecords(
     return ErrERRCheck( JET_errIllegalOperation );
 }
 
+ERR VTAPI ErrIllegalRetrieveLongValues(
+    _In_ const JET_SESID                                            sesid,
+    _In_ const JET_TABLEID                                          tableid,
+    _Inout_updates_( cretrievelv ) JET_RETRIEVELONGVALUE * const    rgretrievelv,
+    _In_ const ULONG                                                cretrievelv,
+    _In_ const JET_GRBIT                                            grbit )
+{
+    return ErrERRCheck( JET_errIllegalOperation );
+}
+
+ERR VTAPI ErrIllegalPrepareRetrieveColumns(
+    _In_ const JET_SESID                                                sesid,
+    _In_ const JET_TABLEID                                              tableid,
+    _In_reads_opt_( cretrievecolumn ) const JET_RETRIEVECOLUMN * const  rgretrievecolumn,
+    _In_ const ULONG                                                    cretrievecolumn,
+    _In_ const JET_GRBIT                                                grbit )
+{
+    return ErrERRCheck( JET_errIllegalOperation );
+}
+
 ERR VTAPI ErrInvalidAddColumn(JET_SESID sesid, JET_VTID vtid,
     const char  *szColumn, const JET_COLUMNDEF  *pcolumndef,
     const void  *pvDefault, ULONG cbDefault,
@@ -1100,6 +1120,26 @@ ERR VTAPI ErrInvalidStreamRecords(
     return ErrERRCheck( JET_errIllegalOperation );
 }
 
+ERR VTAPI ErrInvalidRetrieveLongValues(
+    _In_ const JET_SESID                                            sesid,
+    _In_ const JET_TABLEID                                          tableid,
+    _Inout_updates_( cretrievelv ) JET_RETRIEVELONGVALUE * const    rgretrievelv,
+    _In_ const ULONG                                                cretrievelv,
+    _In_ const JET_GRBIT                                            grbit )
+{
+    return ErrERRCheck( JET_errIllegalOperation );
+}
+
+ERR VTAPI ErrInvalidPrepareRetrieveColumns(
+    _In_ const JET_SESID                                                sesid,
+    _In_ const JET_TABLEID                                              tableid,
+    _In_reads_opt_( cretrievecolumn ) const JET_RETRIEVECOLUMN * const  rgretrievecolumn,
+    _In_ const ULONG                                                    cretrievecolumn,
+    _In_ const JET_GRBIT                                                grbit )
+{
+    return ErrERRCheck( JET_errIllegalOperation );
+}
+
 
 
 #ifdef DEBUG
@@ -1181,6 +1221,8 @@ extern const VTFNDEF vtfndefInvalidTableid =
     ErrInvalidRetrieveColumnByReference,
     ErrInvalidPrereadColumnsByReference,
     ErrInvalidStreamRecords,
+    ErrInvalidRetrieveLongValues,
+    ErrInvalidPrepareRetrieveColumns,
 };
 
 const VTFNDEF vtfndefIsamCallback =
@@ -1242,6 +1284,8 @@ const VTFNDEF vtfndefIsamCallback =
     ErrIllegalRetrieveColumnByReference,
     ErrIllegalPrereadColumnsByReference,
     ErrIllegalStreamRecords,
+    ErrIllegalRetrieveLongValues,
+    ErrIllegalPrepareRetrieveColumns,
 };
 
 extern const ULONG  cbIDXLISTNewMembersSinceOriginalFormat;
@@ -22412,6 +22456,84 @@ JET_ERR JET_API JetPrereadColumnsByReference(
     JET_TRY( opPrereadColumnsByReference, JetPrereadColumnsByReferenceEx( sesid, tableid, rgpvReferences, rgcbReferences, cReferences, cPageCacheMin, cPageCacheMax, pcReferencesPreread, grbit ) );
 }
 
+LOCAL JET_ERR JetRetrieveLongValuesEx(
+    _In_ const JET_SESID                                            sesid,
+    _In_ const JET_TABLEID                                          tableid,
+    _Inout_updates_( cretrievelv ) JET_RETRIEVELONGVALUE * const    rgretrievelv,
+    _In_ const ULONG                                                cretrievelv,
+    _In_ const JET_GRBIT                                            grbit )
+{
+    APICALL_SESID   apicall( opRetrieveLongValues );
+
+    OSTrace(
+        JET_tracetagAPI,
+        OSFormat(
+            "Start %s(0x%Ix,0x%Ix,0x%p,%d,0x%x)",
+            __FUNCTION__,
+            sesid,
+            tableid,
+            rgretrievelv,
+            cretrievelv,
+            grbit ) );
+
+    if ( apicall.FEnter( sesid ) )
+    {
+        apicall.LeaveAfterCall( ErrDispRetrieveLongValues( sesid, tableid, rgretrievelv, cretrievelv, grbit ) );
+    }
+
+    return apicall.ErrResult();
+}
+
+JET_ERR JET_API JetRetrieveLongValues(
+    _In_ const JET_SESID                                            sesid,
+    _In_ const JET_TABLEID                                          tableid,
+    _Inout_updates_( cretrievelv ) JET_RETRIEVELONGVALUE * const    rgretrievelv,
+    _In_ const ULONG                                                cretrievelv,
+    _In_ const JET_GRBIT                                            grbit )
+{
+    JET_VALIDATE_SESID_TABLEID( sesid, tableid );
+    JET_TRY( opRetrieveLongValues, JetRetrieveLongValuesEx( sesid, tableid, rgretrievelv, cretrievelv, grbit ) );
+}
+
+LOCAL JET_ERR JetPrepareRetrieveColumnsEx(
+    _In_ const JET_SESID                                                sesid,
+    _In_ const JET_TABLEID                                              tableid,
+    _In_reads_opt_( cretrievecolumn ) const JET_RETRIEVECOLUMN * const  rgretrievecolumn,
+    _In_ const ULONG                                                    cretrievecolumn,
+    _In_ const JET_GRBIT                                                grbit )
+{
+    APICALL_SESID   apicall( opPrepareRetrieveColumns );
+
+    OSTrace(
+        JET_tracetagAPI,
+        OSFormat(
+            "Start %s(0x%Ix,0x%Ix,0x%p,%d,0x%x)",
+            __FUNCTION__,
+            sesid,
+            tableid,
+            rgretrievecolumn,
+            cretrievecolumn,
+            grbit ) );
+
+    if ( apicall.FEnter( sesid ) )
+    {
+        apicall.LeaveAfterCall( ErrDispPrepareRetrieveColumns( sesid, tableid, rgretrievecolumn, cretrievecolumn, grbit ) );
+    }
+
+    return apicall.ErrResult();
+}
+
+JET_ERR JET_API JetPrepareRetrieveColumns(
+    _In_ const JET_SESID                                                sesid,
+    _In_ const JET_TABLEID                                              tableid,
+    _In_reads_opt_( cretrievecolumn ) const JET_RETRIEVECOLUMN * const  rgretrievecolumn,
+    _In_ const ULONG                                                    cretrievecolumn,
+    _In_ const JET_GRBIT                                                grbit )
+{
+    JET_VALIDATE_SESID_TABLEID( sesid, tableid );
+    JET_TRY( opPrepareRetrieveColumns, JetPrepareRetrieveColumnsEx( sesid, tableid, rgretrievecolumn, cretrievecolumn, grbit ) );
+}
+
 LOCAL JET_ERR JetStreamRecordsEx(
     _In_ JET_SESID                                                  sesid,
     _In_ JET_TABLEID                                                tableid,
@@ -65,6 +65,11 @@ void JetUnitTestResult::AddFailure( const JetUnitTestFailure& failure )
     printf( "\n\tFAILURE: test '%s', file %s, line %d: %s\n", m_szTest, failure.SzFile(), failure.Line(), failure.SzCondition() );
 }
 
+void JetUnitTestResult::AddMetric( const char * const szMetric, const QWORD qwValue, const char * const szUnit )
+{
+    printf( "\n\tMETRIC: test '%s', %s = %I64u %s", m_szTest, szMetric, qwValue, szUnit );
+}
+
 INT JetUnitTestResult::Failures() const
 {
     return m_failures;
@@ -304,6 +309,11 @@ void JetSimpleUnitTest::Fail_( const char * const szFile, const INT line, const
 #endif
 }
 
+void JetSimpleUnitTest::Metric_( const char * const szMetric, const QWORD qwValue, const char * const szUnit )
+{
+    m_presult->AddMetric( szMetric, qwValue, szUnit );
+}
+
 
 
 JetSimpleDbUnitTest::JetSimpleDbUnitTest( const char * const szName, const DWORD dwFacilities ) :
@@ -330,6 +340,11 @@ void JetSimpleDbUnitTest::Fail_( const char * const szFile, const INT line, cons
     m_presult->AddFailure( failure );
 }
 
+void JetSimpleDbUnitTest::Metric_( const char * const szMetric, const QWORD qwValue, const char * const szUnit )
+{
+    m_presult->AddMetric( szMetric, qwValue, szUnit );
+}
+
 void JetSimpleDbUnitTest::SetTestIfmp( const IFMP ifmpTest )
 {
     m_ifmp = ifmpTest;
@@ -368,5 +383,119 @@ void JetTestFixture::Fail_( const char * const szFile, const INT line, const cha
     m_presult->AddFailure( failure );
 }
 
+void JetTestFixture::Metric_( const char * const szMetric, const QWORD qwValue, const char * const szUnit )
+{
+    m_presult->AddMetric( szMetric, qwValue, szUnit );
+}
+
+
+
+JetTestDatabase::JetTestDatabase() :
+    m_inst( JET_instanceNil ),
+    m_sesid( JET_sesidNil ),
+    m_dbid( JET_dbidNil ),
+    m_grbit( NO_GRBIT )
+{
+    m_wszPath[ 0 ] = L'\0';
+    m_wszDatabase[ 0 ] = L'\0';
+}
+
+JetTestDatabase::~JetTestDatabase()
+{
+    if ( JET_instanceNil != m_inst )
+    {
+        (void)ErrTerm( JET_bitTermAbrupt );
+    }
+}
+
+ERR JetTestDatabase::ErrInit( const WCHAR * const wszName, const JET_GRBIT grbit )
+{
+    ERR err;
+
+    Call( ErrCreateInstance( wszName, grbit ) );
+    Call( ErrInit() );
+
+HandleError:
+    return err;
+}
+
+ERR JetTestDatabase::ErrCreateInstance( const WCHAR * const wszName, const JET_GRBIT grbit )
+{
+    ERR err;
+
+    Assert( JET_instanceNil == m_inst );
+
+    m_grbit = grbit;
+    CallR( ErrOSStrCbFormatW( m_wszPath, sizeof( m_wszPath ), L".\\%ws\\", wszName ) );
+    CallR( ErrOSStrCbFormatW( m_wszDatabase, sizeof( m_wszDatabase ), L".\\%ws\\%ws.edb", wszName, wszName ) );
+
+    CallR( JetCreateInstance2W( &m_inst, wszName, wszName, JET_bitNil ) );
+    Call( ErrSetParam( JET_paramRecovery, 0, ( m_grbit & bitRecovery ) ? L"on" : L"off" ) );
+    Call( ErrSetParam( JET_paramCreatePathIfNotExist, fTrue ) );
+    Call( ErrSetParam( JET_paramSystemPath, 0, m_wszPath ) );
+    Call( ErrSetParam( JET_paramLogFilePath, 0, m_wszPath ) );
+    Call( ErrSetParam( JET_paramTempPath, 0, m_wszPath ) );
+
+    return JET_errSuccess;
+
+HandleError:
+    (void)JetTerm2( m_inst, JET_bitTermAbrupt );
+    m_inst = JET_instanceNil;
+    return err;
+}
+
+ERR JetTestDatabase::ErrSetParam( const ULONG paramid, const JET_API_PTR ulParam, const WCHAR * const wszParam )
+{
+    Assert( JET_instanceNil != m_inst );
+    return JetSetSystemParameterW( &m_inst, JET_sesidNil, paramid, ulParam, wszParam );
+}
+
+ERR JetTestDatabase::ErrInit( JET_RSTINFO2_W * const prstinfo )
+{
+    ERR err;
+
+    Assert( JET_instanceNil != m_inst );
+    Assert( JET_sesidNil == m_sesid );
+
+    Call( JetInit4W( &m_inst, prstinfo, JET_bitReplayMissingMapEntryDB ) );
+    Call( JetBeginSessionW( m_inst, &m_sesid, NULL, NULL ) );
+
+    if ( m_grbit & bitAttachExisting )
+    {
+        //  recovery may leave the database attached (JET_wrnDatabaseAttached)
+        Call( JetAttachDatabase2W( m_sesid, m_wszDatabase, 0, JET_bitNil ) );
+        Call( JetOpenDatabaseW( m_sesid, m_wszDatabase, NULL, &m_dbid, JET_bitNil ) );
+    }
+    else if ( !( m_grbit & bitNoDatabase ) )
+    {
+        Call( JetCreateDatabase2W( m_sesid, m_wszDatabase, 0, &m_dbid, JET_bitDbOverwriteExisting ) );
+    }
+
+    err = JET_errSuccess;
+
+HandleError:
+    return err;
+}
+
+ERR JetTestDatabase::ErrTerm( const JET_GRBIT grbitTerm )
+{
+    ERR err = JET_errSuccess;
+
+    if ( JET_sesidNil != m_sesid && JET_bitTermDirty != grbitTerm )
+    {
+        err = JetEndSession( m_sesid, NO_GRBIT );
+    }
+    if ( JET_instanceNil != m_inst )
+    {
+        const ERR errT = JetTerm2( m_inst, grbitTerm );
+        err = ( err < JET_errSuccess ) ? err : errT;
+    }
+
+    m_inst = JET_instanceNil;
+    m_sesid = JET_sesidNil;
+    m_dbid = JET_dbidNil;
+    return err;
+}
+
 #endif
 
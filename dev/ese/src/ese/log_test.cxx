@@ -330,3 +330,209 @@ JETUNITTEST( LGEN_LOGTIME_MAP, CheckLgenLogtimeMap )
     CHECK( memcmp( &tmOut, &tm3, sizeof(tm3) ) == 0 );
 }
 
+
+struct LOGINSERTPERFCONTEXT
+{
+    INST *  pinst;
+    LONG    cRecords;
+    ERR     err;
+};
+
+LOCAL DWORD LogInsertPerfIThread( DWORD_PTR dwContext )
+{
+    LOGINSERTPERFCONTEXT* const pctx = (LOGINSERTPERFCONTEXT*)dwContext;
+    ERR     err     = JET_errSuccess;
+    PIB*    ppib    = ppibNil;
+    CHAR    szTrace[ 200 ];
+
+    memset( szTrace, 'x', sizeof( szTrace ) - 1 );
+    szTrace[ sizeof( szTrace ) - 1 ] = 0;
+
+    Call( ErrPIBBeginSession( pctx->pinst, &ppib, procidNil, fFalse ) );
+
+    for ( LONG irec = 0; irec < pctx->cRecords; irec++ )
+    {
+        Call( pctx->pinst->m_plog->ErrLGTrace( ppib, szTrace ) );
+    }
+
+HandleError:
+    if ( ppib != ppibNil )
+    {
+        PIBEndSession( ppib );
+    }
+    pctx->err = err;
+    return 0;
+}
+
+JETUNITTESTEX( LOGWRITE, LogRecInsertPerf, JetSimpleUnitTest::dwDontRunByDefault )
+{
+    const LONG      cRecordsPerThread   = 100000;
+    const INT       cThreadMax          = 32;
+    INST*           pinst               = NULL;
+    THREAD          rgthread[ cThreadMax ];
+    LOGINSERTPERFCONTEXT rgctx[ cThreadMax ];
+
+    CHECKCALLS( JetCreateInstance2W( (JET_INSTANCE*)&pinst, L"LogInsertPerf", L"LogInsertPerf", JET_bitNil ) );
+    CHECKCALLS( JetSetSystemParameterW( (JET_INSTANCE*)&pinst, JET_sesidNil, JET_paramCreatePathIfNotExist, fTrue, NULL ) );
+    CHECKCALLS( JetSetSystemParameterW( (JET_INSTANCE*)&pinst, JET_sesidNil, JET_paramSystemPath, 0, L".\\LogInsertPerf\\" ) );
+    CHECKCALLS( JetSetSystemParameterW( (JET_INSTANCE*)&pinst, JET_sesidNil, JET_paramLogFilePath, 0, L".\\LogInsertPerf\\" ) );
+    CHECKCALLS( JetSetSystemParameterW( (JET_INSTANCE*)&pinst, JET_sesidNil, JET_paramCircularLog, fTrue, NULL ) );
+    CHECKCALLS( JetSetSystemParameterW( (JET_INSTANCE*)&pinst, JET_sesidNil, JET_paramMaxTemporaryTables, 0, NULL ) );
+    CHECKCALLS( JetInit2( (JET_INSTANCE*)&pinst, JET_bitNil ) );
+
+    for ( INT cThread = 1; cThread <= cThreadMax; cThread *= 2 )
+    {
+        const HRT hrtStart = HrtHRTCount();
+
+        for ( INT ithread = 0; ithread < cThread; ithread++ )
+        {
+            rgctx[ ithread ].pinst      = pinst;
+            rgctx[ ithread ].cRecords   = cRecordsPerThread;
+            rgctx[ ithread ].err        = JET_errSuccess;
+            CHECKCALLS( ErrUtilThreadCreate( LogInsertPerfIThread, 0, priorityNormal, &rgthread[ ithread ], (DWORD_PTR)&rgctx[ ithread ] ) );
+        }
+
+        for ( INT ithread = 0; ithread < cThread; ithread++ )
+        {
+            UtilThreadEnd( rgthread[ ithread ] );
+            CHECKCALLS( rgctx[ ithread ].err );
+        }
+
+        const double dblSec = DblHRTElapsedTimeFromHrtStart( hrtStart );
+        CHAR szMetric[ 32 ];
+
+        OSStrCbFormatA( szMetric, sizeof( szMetric ), "%d threads", cThread );
+        REPORTMETRIC( szMetric, (QWORD)( double( cThread ) * cRecordsPerThread / max( dblSec, 1e-6 ) ), "records/sec" );
+    }
+
+    CHECKCALLS( JetTerm2( (JET_INSTANCE)pinst, JET_bitTermComplete ) );
+}
+
+//  Records what redo left in the cache when recovery reaches the undo phase, so the
+//  test body can CHECK it once JetInit returns.
+
+struct LOGREDOWORKERCONTEXT
+{
+    LGPOS   lgposOldestBegin0;
+    LGPOS   lgposCheckpoint;
+    ERR     errCheckpoint;
+    BOOL    fBeginUndo;
+};
+
+LOCAL JET_ERR JET_API LogRedoWorkersIInitCallback( JET_SNP snp, JET_SNT snt, void * pv, void * pvContext )
+{
+    LOGREDOWORKERCONTEXT * const    pctx        = (LOGREDOWORKERCONTEXT *)pvContext;
+    const JET_RECOVERYCONTROL *     precctrl    = (const JET_RECOVERYCONTROL *)pv;
+
+    if ( JET_snpRecoveryControl != snp || JET_sntBeginUndo != snt )
+    {
+        return ( JET_snpRecoveryControl == snp ) ? precctrl->errDefault : JET_errSuccess;
+    }
+
+    INST * const pinst = (INST *)precctrl->instance;
+
+    pctx->fBeginUndo = fTrue;
+    pctx->lgposOldestBegin0 = lgposMax;
+    for ( DBID dbid = dbidUserLeast; dbid < dbidMax; dbid++ )
+    {
+        const IFMP ifmp = pinst->m_mpdbidifmp[ dbid ];
+        if ( ifmp < g_ifmpMax )
+        {
+            LGPOS lgposBegin0;
+            BFGetLgposOldestBegin0( ifmp, &lgposBegin0, lgposMax );
+            if ( CmpLgpos( lgposBegin0, pctx->lgposOldestBegin0 ) < 0 )
+            {
+                pctx->lgposOldestBegin0 = lgposBegin0;
+            }
+        }
+    }
+
+    pctx->errCheckpoint = pinst->m_plog->ErrLGUpdateCheckpointFile( fTrue );
+    pctx->lgposCheckpoint = pinst->m_plog->LgposGetCheckpoint();
+
+    return precctrl->errDefault;
+}
+
+//  Unversioned escrow updates are replayed on the redo page workers.  The pages they
+//  dirty must carry the dispatched record's lgpos as begin0, otherwise the checkpoint
+//  can advance past changes that are still only in the cache.
+
+JETUNITTEST( LOG, RedoPageWorkersHoldCheckpoint )
+{
+    const LONG              crec            = 200;
+    const LONG              lDefault        = 0;
+    JetTestDatabase         db;
+    JET_TABLEID             tableid         = JET_tableidNil;
+    JET_COLUMNID            columnidKey;
+    JET_COLUMNID            columnidCount;
+    JET_COLUMNDEF           columndef       = { sizeof( JET_COLUMNDEF ), 0, JET_coltypLong, 0, 0, 0, 0, 0, JET_bitColumnFixed };
+    JET_RSTINFO2_W          rstinfo;
+    LOGREDOWORKERCONTEXT    ctx;
+
+    CHECKCALLS( db.ErrInit( L"LogRedoWorkers", JetTestDatabase::bitRecovery ) );
+    CHECKCALLS( JetCreateTableA( db.Sesid(), db.Dbid(), "RedoWorkers", 16, 100, &tableid ) );
+    CHECKCALLS( JetAddColumnA( db.Sesid(), tableid, "Key", &columndef, NULL, 0, &columnidKey ) );
+    columndef.grbit = JET_bitColumnFixed | JET_bitColumnEscrowUpdate;
+    CHECKCALLS( JetAddColumnA( db.Sesid(), tableid, "Count", &columndef, &lDefault, sizeof( lDefault ), &columnidCount ) );
+    CHECKCALLS( JetCreateIndexA( db.Sesid(), tableid, "Primary", JET_bitIndexPrimary, "+Key\0", 6, 100 ) );
+
+    CHECKCALLS( JetBeginTransaction( db.Sesid() ) );
+    for ( LONG irec = 0; irec < crec; irec++ )
+    {
+        CHECKCALLS( JetPrepareUpdate( db.Sesid(), tableid, JET_prepInsert ) );
+        CHECKCALLS( JetSetColumn( db.Sesid(), tableid, columnidKey, &irec, sizeof( irec ), NO_GRBIT, NULL ) );
+        CHECKCALLS( JetUpdate( db.Sesid(), tableid, NULL, 0, NULL ) );
+    }
+    CHECKCALLS( JetCommitTransaction( db.Sesid(), NO_GRBIT ) );
+    CHECKCALLS( JetCloseTable( db.Sesid(), tableid ) );
+    CHECKCALLS( db.ErrTerm() );
+
+    //  after a clean restart the only page changes left to replay are the escrow updates
+
+    CHECKCALLS( db.ErrInit( L"LogRedoWorkers", JetTestDatabase::bitRecovery | JetTestDatabase::bitAttachExisting ) );
+    CHECKCALLS( JetOpenTableA( db.Sesid(), db.Dbid(), "RedoWorkers", NULL, 0, NO_GRBIT, &tableid ) );
+    CHECKCALLS( JetBeginTransaction( db.Sesid() ) );
+    for ( ERR err = JetMove( db.Sesid(), tableid, JET_MoveFirst, NO_GRBIT );
+        JET_errNoCurrentRecord != err;
+        err = JetMove( db.Sesid(), tableid, JET_MoveNext, NO_GRBIT ) )
+    {
+        LONG lDelta = 1;
+
+        CHECKCALLS( err );
+        CHECKCALLS( JetEscrowUpdate( db.Sesid(), tableid, columnidCount, &lDelta, sizeof( lDelta ), NULL, 0, NULL, JET_bitEscrowNoRollback ) );
+    }
+    CHECKCALLS( JetCommitTransaction( db.Sesid(), NO_GRBIT ) );
+    CHECKCALLS( db.ErrTerm( JET_bitTermDirty ) );
+
+    memset( &ctx, 0, sizeof( ctx ) );
+    memset( &rstinfo, 0, sizeof( rstinfo ) );
+    rstinfo.cbStruct = sizeof( rstinfo );
+    *(LGPOS *)&rstinfo.lgposStop = lgposMax;
+    rstinfo.pfnCallback = LogRedoWorkersIInitCallback;
+    rstinfo.pvCallbackContext = &ctx;
+
+    CHECKCALLS( ErrEnableTestInjection( 36438, 4, JET_TestInjectConfigOverride, 100, JET_bitInjectionProbabilityPct ) );
+    const ERR errCreate = db.ErrCreateInstance( L"LogRedoWorkers", JetTestDatabase::bitRecovery | JetTestDatabase::bitAttachExisting );
+    const ERR errRecover = ( errCreate >= JET_errSuccess ) ? db.ErrInit( &rstinfo ) : errCreate;
+    CHECKCALLS( ErrEnableTestInjection( 36438, 0, JET_TestInjectConfigOverride, 0, JET_bitInjectionProbabilityPct ) );
+    CHECKCALLS( errRecover );
+
+    CHECK( ctx.fBeginUndo );
+    CHECKCALLS( ctx.errCheckpoint );
+    CHECK( CmpLgpos( ctx.lgposOldestBegin0, lgposMax ) < 0 );
+    CHECK( CmpLgpos( ctx.lgposCheckpoint, ctx.lgposOldestBegin0 ) <= 0 );
+
+    CHECKCALLS( JetOpenTableA( db.Sesid(), db.Dbid(), "RedoWorkers", NULL, 0, NO_GRBIT, &tableid ) );
+    for ( ERR err = JetMove( db.Sesid(), tableid, JET_MoveFirst, NO_GRBIT );
+        JET_errNoCurrentRecord != err;
+        err = JetMove( db.Sesid(), tableid, JET_MoveNext, NO_GRBIT ) )
+    {
+        LONG lCount = 0;
+
+        CHECKCALLS( err );
+        CHECKCALLS( JetRetrieveColumn( db.Sesid(), tableid, columnidCount, &lCount, sizeof( lCount ), NULL, NO_GRBIT, NULL ) );
+        CHECK( 1 == lCount );
+    }
+    CHECKCALLS( JetCloseTable( db.Sesid(), tableid ) );
+    CHECKCALLS( db.ErrTerm() );
+}
@@ -968,6 +968,132 @@ HandleError:
 }
 
 
+BOOL CmpLVPreread( __in const LVPREREAD& lvpreread1, __in const LVPREREAD& lvpreread2 )
+{
+    return lvpreread1.lid < lvpreread2.lid;
+}
+
+ERR ErrLVPrereadLongValueRanges(
+    _In_ FUCB * const                                   pfucb,
+    _Inout_updates_( clvpreread ) LVPREREAD * const     rglvpreread,
+    _In_ const ULONG                                    clvpreread )
+{
+    JET_ERR         err             = JET_errSuccess;
+    FUCB*           pfucbLV         = pfucbNil;
+    LVKEY_BUFFER*   rglvkeyStart    = NULL;
+    LVKEY_BUFFER*   rglvkeyEnd      = NULL;
+    const VOID**    rgpvStart       = NULL;
+    const VOID**    rgpvEnd         = NULL;
+    ULONG*          rgcbStart       = NULL;
+    ULONG*          rgcbEnd         = NULL;
+    LONG            cRange          = 0;
+    LONG            cRangePreread   = 0;
+    ULONG           cpgPreread      = 0;
+    LONG            cbLVChunkMost   = 0;
+    KEY             keyT;
+
+    ASSERT_VALID( pfucb );
+    Assert( !FAssertLVFUCB( pfucb ) );
+
+    if ( clvpreread == 0 )
+    {
+        goto HandleError;
+    }
+
+    Call( ErrDIROpenLongRoot( pfucb, &pfucbLV, fFalse ) );
+    Assert( pfucbLV != pfucbNil || wrnLVNoLongValues == err );
+    if ( wrnLVNoLongValues == err )
+    {
+        err = JET_errSuccess;
+        goto HandleError;
+    }
+
+    Alloc( rglvkeyStart = new LVKEY_BUFFER[ 2 * clvpreread ] );
+    Alloc( rglvkeyEnd = new LVKEY_BUFFER[ 2 * clvpreread ] );
+    Alloc( rgpvStart = new const VOID*[ 2 * clvpreread ] );
+    Alloc( rgpvEnd = new const VOID*[ 2 * clvpreread ] );
+    Alloc( rgcbStart = new ULONG[ 2 * clvpreread ] );
+    Alloc( rgcbEnd = new ULONG[ 2 * clvpreread ] );
+
+    
+    std::sort( rglvpreread, rglvpreread + clvpreread, CmpLVPreread );
+
+    cbLVChunkMost = pfucbLV->u.pfcb->PfcbTable()->Ptdb()->CbLVChunkMost();
+
+    for ( ULONG ilvpreread = 0; ilvpreread < clvpreread; )
+    {
+        const LvId  lid         = rglvpreread[ ilvpreread ].lid;
+        ULONG       ibStart     = ulMax;
+        ULONG       ibEnd       = 0;
+
+        
+        for ( ; ilvpreread < clvpreread && rglvpreread[ ilvpreread ].lid == lid; ilvpreread++ )
+        {
+            const LVPREREAD& lvpreread = rglvpreread[ ilvpreread ];
+            if ( lvpreread.cbData > 0 )
+            {
+                const ULONG ibLast = lvpreread.ibOffset + lvpreread.cbData < lvpreread.ibOffset ? ulMax : lvpreread.ibOffset + lvpreread.cbData;
+                ibStart = min( ibStart, lvpreread.ibOffset );
+                ibEnd   = max( ibEnd, ibLast );
+            }
+        }
+
+        LVRootKeyFromLid( &rglvkeyStart[ cRange ], &keyT, lid );
+        rgpvStart[ cRange ] = (VOID *) &rglvkeyStart[ cRange ];
+        rgcbStart[ cRange ] = keyT.Cb();
+        rgpvEnd[ cRange ] = rgpvStart[ cRange ];
+        rgcbEnd[ cRange ] = rgcbStart[ cRange ];
+        cRange++;
+        cpgPreread++;
+
+        if ( ibStart < ibEnd )
+        {
+            const ULONG ulOffsetPreread     = ( ibStart / cbLVChunkMost ) * cbLVChunkMost;
+            const ULONG ulOffsetPrereadLast = ( ( ibEnd - 1 ) / cbLVChunkMost ) * cbLVChunkMost;
+
+            LVKeyFromLidOffset( &rglvkeyStart[ cRange ], &keyT, lid, ulOffsetPreread );
+            rgpvStart[ cRange ] = (VOID *) &rglvkeyStart[ cRange ];
+            rgcbStart[ cRange ] = keyT.Cb();
+            LVKeyFromLidOffset( &rglvkeyEnd[ cRange ], &keyT, lid, ulOffsetPrereadLast );
+            rgpvEnd[ cRange ] = (VOID *) &rglvkeyEnd[ cRange ];
+            rgcbEnd[ cRange ] = keyT.Cb();
+            cRange++;
+            cpgPreread += ( ulOffsetPrereadLast - ulOffsetPreread ) / cbLVChunkMost + 1;
+        }
+    }
+
+
+    Call( ErrBTPrereadKeyRanges(
+        pfucbLV->ppib,
+        pfucbLV,
+        rgpvStart,
+        rgcbStart,
+        rgpvEnd,
+        rgcbEnd,
+        cRange,
+        &cRangePreread,
+        cRange,
+        cpgPreread,
+        JET_bitPrereadForward,
+        NULL ) );
+
+HandleError:
+    if ( pfucbNil != pfucbLV )
+    {
+        DIRClose( pfucbLV );
+    }
+
+    delete[] rgcbEnd;
+    delete[] rgcbStart;
+    delete[] rgpvEnd;
+    delete[] rgpvStart;
+    delete[] rglvkeyEnd;
+    delete[] rglvkeyStart;
+
+    return err;
+}
+
+
 ERR ErrDIRDownLVData(
     FUCB            *pfucb,
     const LvId      lid,
@@ -1114,6 +1240,8 @@ LOCAL bool FLVCompressedChunk( const LONG cbLVChunkMost, const KEY& key, const D
     return false;
 }
 
+LOCAL BOOL g_fLVParallelCompress = fFalse;
+
 LOCAL CompressFlags LVIAddXpress10FlagsIfEnabled(
         CompressFlags compressFlags,
         const INST* const pinst,
@@ -1130,6 +1258,93 @@ LOCAL CompressFlags LVIAddXpress10FlagsIfEnabled(
     return compressFlags;
 }
 
+LOCAL const PKDICTIONARY * PdictLVICompression( const FUCB * const pfucb )
+{
+    const FCB * const pfcb = pfucb->u.pfcb;
+
+    if ( !pfcb->FTypeTable() ||
+         ptdbNil == pfcb->Ptdb() ||
+         g_rgfmp[ pfucb->ifmp ].ErrDBFormatFeatureEnabled( JET_efvCompressionDictionaries ) < JET_errSuccess )
+    {
+        return NULL;
+    }
+
+    return pfcb->Ptdb()->PdictCompression();
+}
+
+LOCAL BOOL FLVITryCompress( const DATA& data, const CompressFlags compressFlags )
+{
+    if ( compressNone == compressFlags )
+    {
+        return fFalse;
+    }
+
+    if ( data.Cb() >= cbMinChiSquared )
+    {
+        __declspec( align( 64 ) ) WORD rgwFreqTable[ 256 ] = { 0 };
+        const INT cbSample = min( data.Cb(), cbChiSquaredSample );
+        double dChiSquared = ChiSquaredSignificanceTest( (const BYTE*) data.Pv(), cbSample, rgwFreqTable );
+        if ( dChiSquared < dChiSquaredThreshold )
+        {
+            return fFalse;
+        }
+    }
+
+    return fTrue;
+}
+
+LOCAL ERR ErrLVIEncrypt(
+    FUCB *pfucbLV,
+    FUCB *pfucbTable,
+    __inout DATA *pdataToSet,
+    __inout BYTE ** pbAlloc )
+{
+    ERR err = JET_errSuccess;
+    BYTE *pbDataEncrypted = NULL;
+    const ULONG cbDataEncryptedNeeded = CbOSEncryptAes256SizeNeeded( pdataToSet->Cb() );
+    if ( cbDataEncryptedNeeded > (ULONG)CbPKCompressionBuffer() )
+    {
+        Assert( fFalse );
+        return ErrERRCheck( JET_errInternalError );
+    }
+
+    if ( *pbAlloc != NULL )
+    {
+        Assert( pdataToSet->Pv() == *pbAlloc );
+        pbDataEncrypted = *pbAlloc;
+    }
+    else
+    {
+        pbDataEncrypted = PbPKAllocCompressionBuffer();
+        if ( pbDataEncrypted == NULL )
+        {
+            return ErrERRCheck( JET_errOutOfMemory );
+        }
+        UtilMemCpy( pbDataEncrypted, pdataToSet->Pv(), pdataToSet->Cb() );
+    }
+
+    ULONG cbDataEncryptedActual = pdataToSet->Cb();
+    err = ErrOSUEncrypt(
+            pbDataEncrypted,
+            &cbDataEncryptedActual,
+            CbPKCompressionBuffer(),
+            pfucbTable->pbEncryptionKey,
+            pfucbTable->cbEncryptionKey,
+            PinstFromPfucb( pfucbTable )->m_iInstance,
+            pfucbLV->u.pfcb->TCE() );
+    if ( err < JET_errSuccess )
+    {
+        PKFreeCompressionBuffer( pbDataEncrypted );
+        *pbAlloc = NULL;
+        return err;
+    }
+    *pbAlloc = pbDataEncrypted;
+    pdataToSet->SetPv( pbDataEncrypted );
+    pdataToSet->SetCb( cbDataEncryptedActual );
+
+    return JET_errSuccess;
+}
+
 LOCAL ERR ErrLVITryCompress(
     FUCB *pfucbLV,
     const DATA& data,
@@ -1140,7 +1355,6 @@ LOCAL ERR ErrLVITryCompress(
     __out DATA *pdataToSet,
     __out BYTE ** pbAlloc )
 {
-    ERR err = JET_errSuccess;
     *pbAlloc = NULL;
     
     BYTE * pbDataCompressed = NULL;
@@ -1148,23 +1362,7 @@ LOCAL ERR ErrLVITryCompress(
     pdataToSet->SetPv( const_cast<VOID *>( data.Pv() ) );
     pdataToSet->SetCb( data.Cb() );
 
-    bool fTryCompress = false;
-    if ( compressNone != compressFlags )
-    {
-        fTryCompress = true;
-        if ( data.Cb() >= cbMinChiSquared )
-        {
-            __declspec( align( 64 ) ) WORD rgwFreqTable[ 256 ] = { 0 };
-            const INT cbSample = min( data.Cb(), cbChiSquaredSample );
-            double dChiSquared = ChiSquaredSignificanceTest( (const BYTE*) data.Pv(), cbSample, rgwFreqTable );
-            if ( dChiSquared < dChiSquaredThreshold )
-            {
-                fTryCompress = false;
-            }
-        }
-    }
-
-    if ( fTryCompress && NULL != ( pbDataCompressed = PbPKAllocCompressionBuffer() ) )
+    if ( FLVITryCompress( data, compressFlags ) && NULL != ( pbDataCompressed = PbPKAllocCompressionBuffer() ) )
     {
         CompressFlags compressFlagsEffective = LVIAddXpress10FlagsIfEnabled( compressFlags, pinst, pfucbTable->ifmp );
 
@@ -1198,46 +1396,7 @@ LOCAL ERR ErrLVITryCompress(
 
     if ( fEncrypted )
     {
-        BYTE *pbDataEncrypted = NULL;
-        const ULONG cbDataEncryptedNeeded = CbOSEncryptAes256SizeNeeded( pdataToSet->Cb() );
-        if ( cbDataEncryptedNeeded > (ULONG)CbPKCompressionBuffer() )
-        {
-            Assert( fFalse );
-            return ErrERRCheck( JET_errInternalError );
-        }
-
-        if ( *pbAlloc != NULL )
-        {
-            Assert( pdataToSet->Pv() == *pbAlloc );
-            pbDataEncrypted = *pbAlloc;
-        }
-        else
-        {
-            pbDataEncrypted = PbPKAllocCompressionBuffer();
-            if ( pbDataEncrypted == NULL )
-            {
-                return ErrERRCheck( JET_errOutOfMemory );
-            }
-            UtilMemCpy( pbDataEncrypted, pdataToSet->Pv(), pdataToSet->Cb() );
-        }
-
-        ULONG cbDataEncryptedActual = pdataToSet->Cb();
-        err = ErrOSUEncrypt(
-                pbDataEncrypted,
-                &cbDataEncryptedActual,
-                CbPKCompressionBuffer(),
-                pfucbTable->pbEncryptionKey,
-                pfucbTable->cbEncryptionKey,
-                PinstFromPfucb( pfucbTable )->m_iInstance,
-                pfucbLV->u.pfcb->TCE() );
-        if ( err < JET_errSuccess )
-        {
-            PKFreeCompressionBuffer( pbDataEncrypted );
-            return err;
-        }
-        *pbAlloc = pbDataEncrypted;
-        pdataToSet->SetPv( pbDataEncrypted );
-        pdataToSet->SetCb( cbDataEncryptedActual );
+        return ErrLVIEncrypt( pfucbLV, pfucbTable, pdataToSet, pbAlloc );
     }
 
     return JET_errSuccess;
@@ -1266,6 +1425,170 @@ HandleError:
 }
 
 
+class CLVCompressAhead
+{
+    public:
+        CLVCompressAhead(
+            FUCB * const pfucbLV,
+            FUCB * const pfucbTable,
+            const CompressFlags compressFlags,
+            const BOOL fEncrypted,
+            const BYTE * const pbMax );
+        ~CLVCompressAhead();
+
+        ERR ErrInsert( const KEY& key, const DATA& data, const DIRFLAG dirflag );
+
+    private:
+        VOID Prepare_( const BYTE * const pbFirst );
+        VOID Reset_();
+
+    private:
+        enum { cchunkBatchMax = 16 };
+
+        FUCB * const        m_pfucbLV;
+        FUCB * const        m_pfucbTable;
+        const CompressFlags m_compressFlags;
+        CompressFlags       m_compressFlagsEffective;
+        const BOOL          m_fEncrypted;
+        const BYTE * const  m_pbMax;
+        const INT           m_cbChunk;
+        BOOL                m_fEnabled;
+        const BYTE *        m_pbBatch;
+        INT                 m_cchunk;
+        INT                 m_creq;
+        INT                 m_rgireq[ cchunkBatchMax ];
+        PKCOMPRESSREQ       m_rgreq[ cchunkBatchMax ];
+};
+
+CLVCompressAhead::CLVCompressAhead(
+    FUCB * const pfucbLV,
+    FUCB * const pfucbTable,
+    const CompressFlags compressFlags,
+    const BOOL fEncrypted,
+    const BYTE * const pbMax ) :
+    m_pfucbLV( pfucbLV ),
+    m_pfucbTable( pfucbTable ),
+    m_compressFlags( compressFlags ),
+    m_compressFlagsEffective( compressNone ),
+    m_fEncrypted( fEncrypted ),
+    m_pbMax( pbMax ),
+    m_cbChunk( pfucbLV->u.pfcb->PfcbTable()->Ptdb()->CbLVChunkMost() ),
+    m_fEnabled( fFalse ),
+    m_pbBatch( NULL ),
+    m_cchunk( 0 ),
+    m_creq( 0 )
+{
+    if ( !g_fLVParallelCompress || compressNone == compressFlags || OSSyncGetProcessorCount() < 2 )
+    {
+        return;
+    }
+
+    m_compressFlagsEffective = LVIAddXpress10FlagsIfEnabled( compressFlags, PinstFromPfucb( pfucbLV ), pfucbTable->ifmp );
+
+    CompressFlags compressFlagsParallel = compressXpress10;
+#ifndef ESENT
+    compressFlagsParallel = CompressFlags( compressFlagsParallel | compressXpress9 );
+#endif
+    m_fEnabled = !!( m_compressFlagsEffective & compressFlagsParallel );
+}
+
+CLVCompressAhead::~CLVCompressAhead()
+{
+    Reset_();
+}
+
+VOID CLVCompressAhead::Reset_()
+{
+    for ( INT ireq = 0; ireq < m_creq; ireq++ )
+    {
+        PKFreeCompressionBuffer( m_rgreq[ ireq ].pbDataCompressed );
+        m_rgreq[ ireq ].pbDataCompressed = NULL;
+    }
+    m_pbBatch = NULL;
+    m_cchunk = 0;
+    m_creq = 0;
+}
+
+VOID CLVCompressAhead::Prepare_( const BYTE * const pbFirst )
+{
+    Reset_();
+
+    m_pbBatch = pbFirst;
+    for ( const BYTE * pb = pbFirst; pb < m_pbMax && m_cchunk < cchunkBatchMax; pb += m_cbChunk )
+    {
+        DATA data;
+        data.SetPv( const_cast<BYTE *>( pb ) );
+        data.SetCb( (INT)min( m_pbMax - pb, m_cbChunk ) );
+
+        m_rgireq[ m_cchunk ] = -1;
+        if ( FLVITryCompress( data, m_compressFlags ) )
+        {
+            m_rgireq[ m_cchunk ] = m_creq;
+            m_rgreq[ m_creq ].data = data;
+            m_rgreq[ m_creq ].pbDataCompressed = NULL;
+            m_rgreq[ m_creq ].cbDataCompressedActual = 0;
+            m_rgreq[ m_creq ].err = JET_errSuccess;
+            m_creq++;
+        }
+        m_cchunk++;
+    }
+
+    PKCompressDataParallel(
+        &PinstFromPfucb( m_pfucbLV )->Taskmgr(),
+        m_compressFlagsEffective,
+        PinstFromPfucb( m_pfucbLV ),
+        m_rgreq,
+        m_creq );
+}
+
+ERR CLVCompressAhead::ErrInsert( const KEY& key, const DATA& data, const DIRFLAG dirflag )
+{
+    ERR err = JET_errSuccess;
+
+    if ( !m_fEnabled || data.Cb() > m_cbChunk )
+    {
+        return ErrLVInsert( m_pfucbLV, key, data, m_compressFlags, m_fEncrypted, m_pfucbTable, dirflag );
+    }
+
+    const BYTE * const pbData = (const BYTE *)data.Pv();
+    if ( NULL == m_pbBatch || pbData < m_pbBatch || pbData >= m_pbBatch + m_cchunk * m_cbChunk || ( pbData - m_pbBatch ) % m_cbChunk != 0 )
+    {
+        Prepare_( pbData );
+    }
+
+    const INT ichunk = (INT)( ( pbData - m_pbBatch ) / m_cbChunk );
+    const INT ireq = m_rgireq[ ichunk ];
+
+    BYTE * pbToFree = NULL;
+    DATA dataToSet = data;
+
+    if ( ireq >= 0 )
+    {
+        PKCOMPRESSREQ * const preq = &m_rgreq[ ireq ];
+        Assert( preq->data.Pv() == data.Pv() );
+        Assert( preq->data.Cb() == data.Cb() );
+
+        if ( NULL != preq->pbDataCompressed )
+        {
+            pbToFree = preq->pbDataCompressed;
+            preq->pbDataCompressed = NULL;
+            dataToSet.SetPv( pbToFree );
+            dataToSet.SetCb( preq->cbDataCompressedActual );
+        }
+    }
+
+    if ( m_fEncrypted )
+    {
+        Call( ErrLVIEncrypt( m_pfucbLV, m_pfucbTable, &dataToSet, &pbToFree ) );
+    }
+
+    Call( ErrDIRInsert( m_pfucbLV, key, dataToSet, dirflag ) );
+
+HandleError:
+    PKFreeCompressionBuffer( pbToFree );
+    return err;
+}
+
 LOCAL ERR ErrLVReplace(
     FUCB * const pfucbLV,
     const DATA& data,
@@ -1659,6 +1982,14 @@ HandleError:
 ERR ErrLVInit( INST *pinst )
 {
     ERR err = JET_errSuccess;
+
+    WCHAR wszBuf[ 16 ] = { 0 };
+    if (    FOSConfigGet( L"LV", L"Parallel Chunk Compression", wszBuf, sizeof( wszBuf ) ) &&
+            wszBuf[ 0 ] )
+    {
+        g_fLVParallelCompress = !!_wtol( wszBuf );
+    }
+
     Call( ErrPIBBeginSession( pinst, &pinst->m_ppibLV, procidNil, fFalse ) );
 
 HandleError:
@@ -2630,6 +2961,7 @@ INLINE ERR ErrLVAppendChunks(
     DATA        data;
     CPG         cpgRequiredReserve = fContiguousLv ? CpgLVIRequired( pfucbLV->u.pfcb->PfcbTable(), cbAppend ) : 0;
     const BYTE  * const pbMax   = pbAppend + cbAppend;
+    CLVCompressAhead compressahead( pfucbLV, pfucbLV->pfucbTable, compressFlags, fEncrypted, pbMax );
 
     while( pbAppend < pbMax )
     {
@@ -2649,7 +2981,7 @@ INLINE ERR ErrLVAppendChunks(
             DIRSetActiveSpaceRequestReserve( pfucbLV, cpgRequiredReserve - 1 );
         }
 
-        err = ErrLVInsert( pfucbLV, key, data, compressFlags, fEncrypted, pfucbLV->pfucbTable, fDIRBackToFather );
+        err = compressahead.ErrInsert( key, data, fDIRBackToFather );
 
         if ( CpgDIRActiveSpaceRequestReserve( pfucbLV ) == cpgDIRReserveConsumed )
         {
@@ -3718,6 +4050,7 @@ ERR ErrRECAOIntrinsicLV(
                 dataSet,
                 compressFlagsEffective,
                 PinstFromPfucb( pfucb ),
+                PdictLVICompression( pfucb ),
                 pbDataCompressed,
                 cbDataCompressedMax,
                 &cbDataCompressedActual );
@@ -4715,7 +5048,8 @@ LOCAL ERR ErrLVIInsertLVData(
     __in const DATA * const pdata,
     const CompressFlags compressFlags,
     const BOOL fEncrypted,
-    FUCB *pfucbTable )
+    FUCB *pfucbTable,
+    CLVCompressAhead * const pcompressahead = NULL )
 {
     ERR err = JET_errSuccess;
     KEY key;
@@ -4739,7 +5073,14 @@ LOCAL ERR ErrLVIInsertLVData(
 
     PERFOpt( PERFIncCounterTable( cLVChunkAppends, PinstFromPfucb( pfucbLV ), TceFromFUCB( pfucbLV ) ) );
 
-    err = ErrLVInsert( pfucbLV, key, *pdata, compressFlags, fEncrypted, pfucbTable, fDIRBackToFather );
+    if ( pcompressahead )
+    {
+        err = pcompressahead->ErrInsert( key, *pdata, fDIRBackToFather );
+    }
+    else
+    {
+        err = ErrLVInsert( pfucbLV, key, *pdata, compressFlags, fEncrypted, pfucbTable, fDIRBackToFather );
+    }
     Assert( JET_errKeyDuplicate != err );
     Call( err );
 
@@ -4792,6 +5133,7 @@ ERR ErrRECICreateLvRootAndChunks(
     Assert( pfucbNil != pfucbLV );
     Assert( FFUCBLongValue( pfucbLV ) );
 
+    CLVCompressAhead compressahead( pfucbLV, pfucb, compressFlags, fEncrypted, (const BYTE *)pdataField->Pv() + pdataField->Cb() );
     BOOL fBeginTrx = fFalse;
 
     if ( pcpgLvSpaceRequired && *pcpgLvSpaceRequired != 0 )
@@ -4831,7 +5173,7 @@ ERR ErrRECICreateLvRootAndChunks(
         dataInsert.SetPv( dataRemaining.Pv() );
         dataInsert.SetCb( min( cbLVChunkMost, dataRemaining.Cb() ) );
         
-        Call( ErrLVIInsertLVData( pfucbLV, *plid, ulOffset, &dataInsert, compressFlags, fEncrypted, pfucb ) );
+        Call( ErrLVIInsertLVData( pfucbLV, *plid, ulOffset, &dataInsert, compressFlags, fEncrypted, pfucb, &compressahead ) );
         cbInserted += dataInsert.Cb();
         
         dataRemaining.DeltaCb( -dataInsert.Cb() );
@@ -4853,7 +5195,7 @@ ERR ErrRECICreateLvRootAndChunks(
         dataInsert.SetPv( dataRemaining.Pv() );
         dataInsert.SetCb( min( cbLVChunkMost, dataRemaining.Cb() ) );
         
-        Call( ErrLVIInsertLVData( pfucbLV, *plid, ulOffset, &dataInsert, compressFlags, fEncrypted, pfucb ) );
+        Call( ErrLVIInsertLVData( pfucbLV, *plid, ulOffset, &dataInsert, compressFlags, fEncrypted, pfucb, &compressahead ) );
         cbInserted += dataInsert.Cb();
         
         dataRemaining.DeltaCb( -dataInsert.Cb() );
@@ -0,0 +1,241 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "std.hxx"
+
+#ifndef ENABLE_JET_UNIT_TEST
+#error This file should only be compiled with the unit tests!
+#endif
+
+const ULONG cbLVTestBookmarkMost    = 16;
+
+struct LVTESTRECORD
+{
+    BYTE    rgbBookmark[ cbLVTestBookmarkMost ];
+    ULONG   cbBookmark;
+    ULONG   cbData;
+};
+
+LOCAL BYTE BLVTestIData( const LONG irec, const ULONG ib )
+{
+    return BYTE( irec * 31 + ib * 7 );
+}
+
+LOCAL ULONG CbLVTestIData( const LONG irec )
+{
+    switch ( irec % 4 )
+    {
+        case 0:
+            return 64;
+        case 1:
+            return 3 * 1024;
+        case 2:
+            return 40 * 1024;
+        default:
+            return 200 * 1024;
+    }
+}
+
+LOCAL ERR ErrLVTestIPopulate(
+    const JET_SESID         sesid,
+    const JET_DBID          dbid,
+    JET_TABLEID * const     ptableid,
+    JET_COLUMNID * const    pcolumnidLV,
+    LVTESTRECORD * const    rgrec,
+    const LONG              crec )
+{
+    ERR             err;
+    JET_COLUMNDEF   columndef   = { sizeof( JET_COLUMNDEF ), 0, JET_coltypLong, 0, 0, 0, 0, 0, JET_bitColumnAutoincrement };
+    JET_COLUMNID    columnidKey = JET_columnidNil;
+    BYTE*           pbData      = NULL;
+
+    Alloc( pbData = new BYTE[ 200 * 1024 ] );
+
+    Call( JetCreateTableA( sesid, dbid, "LVTest", 16, 100, ptableid ) );
+    Call( JetAddColumnA( sesid, *ptableid, "Key", &columndef, NULL, 0, &columnidKey ) );
+    columndef.coltyp = JET_coltypLongBinary;
+    columndef.grbit = JET_bitColumnTagged;
+    Call( JetAddColumnA( sesid, *ptableid, "Data", &columndef, NULL, 0, pcolumnidLV ) );
+    Call( JetCreateIndexA( sesid, *ptableid, "Primary", JET_bitIndexPrimary, "+Key\0", 6, 100 ) );
+
+    for ( LONG irec = 0; irec < crec; irec++ )
+    {
+        rgrec[ irec ].cbData = CbLVTestIData( irec );
+        for ( ULONG ib = 0; ib < rgrec[ irec ].cbData; ib++ )
+        {
+            pbData[ ib ] = BLVTestIData( irec, ib );
+        }
+
+        Call( JetBeginTransaction( sesid ) );
+        Call( JetPrepareUpdate( sesid, *ptableid, JET_prepInsert ) );
+        Call( JetSetColumn( sesid, *ptableid, *pcolumnidLV, pbData, rgrec[ irec ].cbData, NO_GRBIT, NULL ) );
+        Call( JetUpdate( sesid, *ptableid, rgrec[ irec ].rgbBookmark, cbLVTestBookmarkMost, &rgrec[ irec ].cbBookmark ) );
+        Call( JetCommitTransaction( sesid, JET_bitCommitLazyFlush ) );
+    }
+
+HandleError:
+    delete[] pbData;
+    return err;
+}
+
+JETUNITTEST( LV, RetrieveLongValuesMatchesRetrieveColumn )
+{
+    const LONG              crec        = 600;
+    const ULONG             cbBuffer    = 64 * 1024;
+    JetTestDatabase         db;
+    JET_TABLEID             tableid     = JET_tableidNil;
+    JET_COLUMNID            columnidLV  = JET_columnidNil;
+    LVTESTRECORD*           rgrec       = new LVTESTRECORD[ crec ];
+    JET_RETRIEVELONGVALUE*  rgretrievelv    = new JET_RETRIEVELONGVALUE[ crec + 2 ];
+    BYTE*                   rgbData     = new BYTE[ ( crec + 2 ) * cbBuffer ];
+    JET_COLUMNDEF           columndefKey;
+
+    CHECK( rgrec && rgretrievelv && rgbData );
+
+    CHECKCALLS( db.ErrInit( L"LVRetrieveMany" ) );
+    const JET_SESID sesid = db.Sesid();
+    CHECKCALLS( ErrLVTestIPopulate( sesid, db.Dbid(), &tableid, &columnidLV, rgrec, crec ) );
+
+
+    for ( LONG irec = 0; irec < crec; irec++ )
+    {
+        const LONG irecRequest = ( irec * 389 ) % crec;
+        JET_RETRIEVELONGVALUE& retrievelv = rgretrievelv[ irec ];
+
+        memset( &retrievelv, 0, sizeof( retrievelv ) );
+        retrievelv.pvBookmark   = rgrec[ irecRequest ].rgbBookmark;
+        retrievelv.cbBookmark   = rgrec[ irecRequest ].cbBookmark;
+        retrievelv.columnid     = columnidLV;
+        retrievelv.itagSequence = 1;
+        retrievelv.ibLongValue  = ( irec % 3 ) * 1000;
+        retrievelv.pvData       = rgbData + irec * cbBuffer;
+        retrievelv.cbData       = cbBuffer;
+    }
+
+
+    memset( &rgretrievelv[ crec ], 0, sizeof( rgretrievelv[ crec ] ) );
+    rgretrievelv[ crec ].pvBookmark     = rgrec[ 0 ].rgbBookmark;
+    rgretrievelv[ crec ].cbBookmark     = rgrec[ 0 ].cbBookmark;
+    rgretrievelv[ crec ].columnid       = columnidLV;
+    rgretrievelv[ crec ].itagSequence   = 2;
+    rgretrievelv[ crec ].pvData         = rgbData + crec * cbBuffer;
+    rgretrievelv[ crec ].cbData         = cbBuffer;
+
+    //  a column that cannot hold long values only fails its own entry
+
+    CHECKCALLS( JetGetTableColumnInfoA( sesid, tableid, "Key", &columndefKey, sizeof( columndefKey ), JET_ColInfo ) );
+    memset( &rgretrievelv[ crec + 1 ], 0, sizeof( rgretrievelv[ crec + 1 ] ) );
+    rgretrievelv[ crec + 1 ].pvBookmark     = rgrec[ 1 ].rgbBookmark;
+    rgretrievelv[ crec + 1 ].cbBookmark     = rgrec[ 1 ].cbBookmark;
+    rgretrievelv[ crec + 1 ].columnid       = columndefKey.columnid;
+    rgretrievelv[ crec + 1 ].itagSequence   = 1;
+    rgretrievelv[ crec + 1 ].pvData         = rgbData + ( crec + 1 ) * cbBuffer;
+    rgretrievelv[ crec + 1 ].cbData         = cbBuffer;
+
+    CHECKCALLS( JetRetrieveLongValues( sesid, tableid, rgretrievelv, crec + 2, NO_GRBIT ) );
+
+    for ( LONG irec = 0; irec < crec; irec++ )
+    {
+        const LONG irecRequest = ( irec * 389 ) % crec;
+        const JET_RETRIEVELONGVALUE& retrievelv = rgretrievelv[ irec ];
+        const ULONG cbExpected = rgrec[ irecRequest ].cbData > retrievelv.ibLongValue ? rgrec[ irecRequest ].cbData - retrievelv.ibLongValue : 0;
+
+        CHECK( retrievelv.cbActual == cbExpected );
+        CHECK( retrievelv.err == ( cbExpected > cbBuffer ? JET_wrnBufferTruncated : JET_errSuccess ) );
+
+        for ( ULONG ib = 0; ib < min( cbExpected, cbBuffer ); ib++ )
+        {
+            CHECK( ( (BYTE*)retrievelv.pvData )[ ib ] == BLVTestIData( irecRequest, retrievelv.ibLongValue + ib ) );
+        }
+    }
+
+    CHECK( rgretrievelv[ crec ].err == JET_wrnColumnNull );
+    CHECK( rgretrievelv[ crec ].cbActual == 0 );
+    CHECK( rgretrievelv[ crec + 1 ].err == JET_errInvalidColumnType );
+    CHECK( rgretrievelv[ crec + 1 ].cbActual == 0 );
+
+    CHECKCALLS( JetCloseTable( sesid, tableid ) );
+    CHECKCALLS( db.ErrTerm() );
+
+    delete[] rgbData;
+    delete[] rgretrievelv;
+    delete[] rgrec;
+}
+
+JETUNITTESTEX( LV, RetrieveLongValuesPerf, JetSimpleUnitTest::dwDontRunByDefault )
+{
+    const LONG              crec        = 4000;
+    const ULONG             cbBuffer    = 256 * 1024;
+    JetTestDatabase         db;
+    JET_DBID                dbid        = JET_dbidNil;
+    JET_TABLEID             tableid     = JET_tableidNil;
+    JET_COLUMNID            columnidLV  = JET_columnidNil;
+    LVTESTRECORD*           rgrec       = new LVTESTRECORD[ crec ];
+    JET_RETRIEVELONGVALUE*  rgretrievelv    = new JET_RETRIEVELONGVALUE[ crec ];
+    BYTE*                   pbData      = new BYTE[ cbBuffer ];
+    ULONG                   cbActual    = 0;
+
+    CHECK( rgrec && rgretrievelv && pbData );
+
+    CHECKCALLS( db.ErrInit( L"LVRetrievePerf" ) );
+    const JET_SESID sesid = db.Sesid();
+    dbid = db.Dbid();
+    CHECKCALLS( ErrLVTestIPopulate( sesid, dbid, &tableid, &columnidLV, rgrec, crec ) );
+
+
+    CHECKCALLS( JetCloseTable( sesid, tableid ) );
+    CHECKCALLS( JetCloseDatabase( sesid, dbid, NO_GRBIT ) );
+    CHECKCALLS( JetDetachDatabaseW( sesid, db.WszDatabase() ) );
+    CHECKCALLS( JetAttachDatabaseW( sesid, db.WszDatabase(), NO_GRBIT ) );
+    CHECKCALLS( JetOpenDatabaseW( sesid, db.WszDatabase(), NULL, &dbid, NO_GRBIT ) );
+    CHECKCALLS( JetOpenTableA( sesid, dbid, "LVTest", NULL, 0, NO_GRBIT, &tableid ) );
+
+    HRT hrtStart = HrtHRTCount();
+    for ( LONG irec = 0; irec < crec; irec++ )
+    {
+        CHECKCALLS( JetGotoBookmark( sesid, tableid, rgrec[ irec ].rgbBookmark, rgrec[ irec ].cbBookmark ) );
+        CHECKCALLS( JetRetrieveColumn( sesid, tableid, columnidLV, pbData, cbBuffer, &cbActual, NO_GRBIT, NULL ) );
+    }
+    const QWORD cusecSingle = CusecHRTFromDhrt( HrtHRTCount() - hrtStart );
+
+    CHECKCALLS( JetCloseTable( sesid, tableid ) );
+    CHECKCALLS( JetCloseDatabase( sesid, dbid, NO_GRBIT ) );
+    CHECKCALLS( JetDetachDatabaseW( sesid, db.WszDatabase() ) );
+    CHECKCALLS( JetAttachDatabaseW( sesid, db.WszDatabase(), NO_GRBIT ) );
+    CHECKCALLS( JetOpenDatabaseW( sesid, db.WszDatabase(), NULL, &dbid, NO_GRBIT ) );
+    CHECKCALLS( JetOpenTableA( sesid, dbid, "LVTest", NULL, 0, NO_GRBIT, &tableid ) );
+
+
+    hrtStart = HrtHRTCount();
+    for ( LONG irecFirst = 0; irecFirst < crec; irecFirst += 256 )
+    {
+        const LONG crecBatch = min( 256, crec - irecFirst );
+        BYTE* const rgbBatch = new BYTE[ crecBatch * cbBuffer ];
+        CHECK( NULL != rgbBatch );
+
+        for ( LONG irec = 0; irec < crecBatch; irec++ )
+        {
+            memset( &rgretrievelv[ irecFirst + irec ], 0, sizeof( JET_RETRIEVELONGVALUE ) );
+            rgretrievelv[ irecFirst + irec ].pvBookmark     = rgrec[ irecFirst + irec ].rgbBookmark;
+            rgretrievelv[ irecFirst + irec ].cbBookmark     = rgrec[ irecFirst + irec ].cbBookmark;
+            rgretrievelv[ irecFirst + irec ].columnid       = columnidLV;
+            rgretrievelv[ irecFirst + irec ].itagSequence   = 1;
+            rgretrievelv[ irecFirst + irec ].pvData         = rgbBatch + irec * cbBuffer;
+            rgretrievelv[ irecFirst + irec ].cbData         = cbBuffer;
+        }
+        CHECKCALLS( JetRetrieveLongValues( sesid, tableid, rgretrievelv + irecFirst, crecBatch, NO_GRBIT ) );
+
+        delete[] rgbBatch;
+    }
+    const QWORD cusecBatch = CusecHRTFromDhrt( HrtHRTCount() - hrtStart );
+
+    REPORTMETRIC( "single", cusecSingle, "usec" );
+    REPORTMETRIC( "batched", cusecBatch, "usec" );
+
+    CHECKCALLS( JetCloseTable( sesid, tableid ) );
+    CHECKCALLS( db.ErrTerm() );
+
+    delete[] pbData;
+    delete[] rgretrievelv;
+    delete[] rgrec;
+}
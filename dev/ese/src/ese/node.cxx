@@ -71,6 +71,238 @@ INLINE VOID NDIAssertCurrencyExists     ( const CSR * pcsr ) {}
 BOOL g_fNodeMiscMemoryTrashedDefenseInDepthTemp = fTrue;
 #endif
 
+//  The search hint cache keeps the first 8 bytes of the key of every line of recently seeked
+//  pages, big-endian so that they compare as integers, to narrow the bisection before any full
+//  key compare. It is a lossy direct-mapped table keyed by ( ifmp, pgno ). An entry costs 8
+//  bytes per line it can describe, so at the default of cNDSearchHintLinesMax lines an entry
+//  is a little over 8 KB; pages with more lines than an entry holds are not hinted. The cache
+//  is off unless "Search Hint Cache Size" gives it a budget in bytes, which is capped at
+//  cbNDSearchHintCacheMost. "Search Hint Lines Per Page" lowers the cost of an entry, and so
+//  fits more pages in the budget, at the price of not hinting denser pages.
+
+const INT   cNDSearchHintLinesMax   = 1024;
+const ULONG cbNDSearchHintCacheMost = 256 * 1024 * 1024;
+
+struct NDSEARCHHINT
+{
+    LONG            lSeq;
+    IFMP            ifmp;
+    PGNO            pgno;
+    DBTIME          dbtime;
+    INT             clines;
+    QWORD           rgqwKeyHead[ 0 ];
+};
+
+LOCAL BYTE *    g_rgbndsearchhint       = NULL;
+LOCAL ULONG     g_cndsearchhint         = 0;
+LOCAL SIZE_T    g_cbndsearchhint        = 0;
+LOCAL INT       g_clinesNDSearchHintMax = 0;
+
+ERR ErrNDInit()
+{
+    ERR     err             = JET_errSuccess;
+    WCHAR   wszBuf[ 16 ]    = { 0 };
+    ULONG   cbCache         = 0;
+    ULONG   clinesMax       = cNDSearchHintLinesMax;
+
+    Assert( NULL == g_rgbndsearchhint );
+    g_cndsearchhint = 0;
+
+    if (    FOSConfigGet( L"NODE", L"Search Hint Cache Size", wszBuf, sizeof( wszBuf ) ) &&
+            wszBuf[ 0 ] )
+    {
+        cbCache = (ULONG)_wtol( wszBuf );
+    }
+    cbCache = min( cbNDSearchHintCacheMost, (ULONG)UlConfigOverrideInjection( 47340, cbCache ) );
+
+    if (    FOSConfigGet( L"NODE", L"Search Hint Lines Per Page", wszBuf, sizeof( wszBuf ) ) &&
+            wszBuf[ 0 ] )
+    {
+        clinesMax = (ULONG)_wtol( wszBuf );
+    }
+    clinesMax = max( (ULONG)2, min( (ULONG)cNDSearchHintLinesMax, (ULONG)UlConfigOverrideInjection( 47356, clinesMax ) ) );
+
+    const SIZE_T    cbndsearchhint  = sizeof( NDSEARCHHINT ) + clinesMax * sizeof( QWORD );
+    const ULONG     cndsearchhint   = ULONG( cbCache / cbndsearchhint );
+
+    if ( cndsearchhint > 0 )
+    {
+        Alloc( g_rgbndsearchhint = (BYTE *)PvOSMemoryPageAlloc( cndsearchhint * cbndsearchhint, NULL ) );
+        g_cbndsearchhint        = cbndsearchhint;
+        g_clinesNDSearchHintMax = (INT)clinesMax;
+        g_cndsearchhint         = cndsearchhint;
+    }
+
+HandleError:
+    return err;
+}
+
+VOID NDTerm()
+{
+    g_cndsearchhint = 0;
+    OSMemoryPageFree( g_rgbndsearchhint );
+    g_rgbndsearchhint = NULL;
+}
+
+INLINE NDSEARCHHINT * PndsearchhintNDI( const IFMP ifmp, const PGNO pgno )
+{
+    Assert( g_cndsearchhint > 0 );
+    const ULONG ihint = ( pgno * 0x9E3779B1 + (ULONG)ifmp ) % g_cndsearchhint;
+    return (NDSEARCHHINT *)( g_rgbndsearchhint + ihint * g_cbndsearchhint );
+}
+
+VOID NDInvalidateSearchHint( const IFMP ifmp, const PGNO pgno )
+{
+    if ( 0 == g_cndsearchhint )
+    {
+        return;
+    }
+
+    NDSEARCHHINT * const    phint   = PndsearchhintNDI( ifmp, pgno );
+    const LONG              lSeq    = AtomicRead( &phint->lSeq );
+
+    if ( ( lSeq & 1 ) ||
+        phint->ifmp != ifmp ||
+        phint->pgno != pgno ||
+        AtomicCompareExchange( &phint->lSeq, lSeq, lSeq + 1 ) != lSeq )
+    {
+        return;
+    }
+
+    phint->clines = 0;
+    AtomicExchange( &phint->lSeq, lSeq + 2 );
+}
+
+#ifdef ENABLE_JET_UNIT_TEST
+BOOL FNDSearchHintCached( const IFMP ifmp, const PGNO pgno )
+{
+    if ( 0 == g_cndsearchhint )
+    {
+        return fFalse;
+    }
+
+    NDSEARCHHINT * const phint = PndsearchhintNDI( ifmp, pgno );
+    return !( AtomicRead( &phint->lSeq ) & 1 ) && phint->ifmp == ifmp && phint->pgno == pgno && phint->clines > 0;
+}
+#endif
+
+LOCAL QWORD QwNDIKeyHead( const KEY& key, const DATA& data )
+{
+    BYTE    rgb[ sizeof( QWORD ) ]  = { 0 };
+    INT     ib                      = 0;
+    const DATA * rgpdata[]          = { &key.prefix, &key.suffix, &data };
+
+    for ( INT ipdata = 0; ipdata < _countof( rgpdata ) && ib < (INT)sizeof( rgb ); ipdata++ )
+    {
+        const INT cb = min( rgpdata[ ipdata ]->Cb(), (INT)sizeof( rgb ) - ib );
+        if ( cb > 0 )
+        {
+            UtilMemCpy( rgb + ib, rgpdata[ ipdata ]->Pv(), cb );
+            ib += cb;
+        }
+    }
+
+    return *(UnalignedBigEndian< QWORD > *)rgb;
+}
+
+INLINE BOOL FNDISearchHintLatch( const CSR * const pcsr )
+{
+    return  latchReadTouch == pcsr->Latch() ||
+            latchReadNoTouch == pcsr->Latch() ||
+            latchRIW == pcsr->Latch();
+}
+
+LOCAL VOID NDISeekNarrowWithSearchHint(
+    const CPAGE&    cpage,
+    const QWORD     qwKeyHead,
+    const INT       clinesHint,
+    INT * const     pilineFirst,
+    INT * const     pilineLast )
+{
+    const INT clines = cpage.Clines();
+
+    if ( 0 == g_cndsearchhint || clinesHint < 2 || clinesHint > g_clinesNDSearchHintMax || g_fRepair )
+    {
+        return;
+    }
+
+    NDSEARCHHINT * const    phint   = PndsearchhintNDI( cpage.Ifmp(), cpage.PgnoThis() );
+    LONG                    lSeq    = AtomicRead( &phint->lSeq );
+
+    if ( lSeq & 1 )
+    {
+        return;
+    }
+
+    if ( phint->ifmp != cpage.Ifmp() ||
+        phint->pgno != cpage.PgnoThis() ||
+        phint->dbtime != cpage.Dbtime() ||
+        phint->clines != clinesHint )
+    {
+        if ( AtomicCompareExchange( &phint->lSeq, lSeq, lSeq + 1 ) != lSeq )
+        {
+            return;
+        }
+
+        KEYDATAFLAGS    kdf;
+        DATA            dataNull;
+        dataNull.Nullify();
+
+        for ( INT iline = 0; iline < clinesHint; iline++ )
+        {
+            NDIGetKeydataflags( cpage, iline, &kdf );
+            phint->rgqwKeyHead[ iline ] = QwNDIKeyHead( kdf.key, dataNull );
+        }
+        phint->ifmp     = cpage.Ifmp();
+        phint->pgno     = cpage.PgnoThis();
+        phint->dbtime   = cpage.Dbtime();
+        phint->clines   = clinesHint;
+
+        lSeq += 2;
+        AtomicExchange( &phint->lSeq, lSeq );
+    }
+
+    INT ilineLow    = 0;
+    INT ilineHigh   = clinesHint;
+    while ( ilineLow < ilineHigh )
+    {
+        const INT ilineMid = ( ilineLow + ilineHigh ) / 2;
+        if ( phint->rgqwKeyHead[ ilineMid ] < qwKeyHead )
+        {
+            ilineLow = ilineMid + 1;
+        }
+        else
+        {
+            ilineHigh = ilineMid;
+        }
+    }
+    const INT ilineFirst = ilineLow;
+
+    ilineHigh = clinesHint;
+    while ( ilineLow < ilineHigh )
+    {
+        const INT ilineMid = ( ilineLow + ilineHigh ) / 2;
+        if ( phint->rgqwKeyHead[ ilineMid ] <= qwKeyHead )
+        {
+            ilineLow = ilineMid + 1;
+        }
+        else
+        {
+            ilineHigh = ilineMid;
+        }
+    }
+    const INT ilineLast = ilineLow;
+
+    if ( AtomicRead( &phint->lSeq ) != lSeq )
+    {
+        return;
+    }
+
+    *pilineFirst    = min( ilineFirst, clines - 1 );
+    *pilineLast     = min( ilineLast, clines - 1 );
+    Assert( *pilineFirst <= *pilineLast );
+}
+
 LOCAL ERR ErrNDIReportBadLineCount(
     FUCB        * const pfucb,
     const ERR   err,
@@ -500,7 +732,7 @@ INLINE VOID NDIResetFlag( CSR * pcsr, INT fFlag )
 }
 
 
-INT IlineNDISeekGEQ( const CPAGE& cpage, const BOOKMARK& bm, const BOOL fUnique, INT * plastCompare )
+INT IlineNDISeekGEQ( const CPAGE& cpage, const BOOKMARK& bm, const BOOL fUnique, INT * plastCompare, const BOOL fSearchHint )
 {
     Assert( cpage.FLeafPage() );
 
@@ -513,6 +745,13 @@ INT IlineNDISeekGEQ( const CPAGE& cpage, const BOOKMARK& bm, const BOOL fUnique,
     INT             compare     = 0;
     BOOKMARK        bmNode;
 
+    if ( fSearchHint )
+    {
+        DATA dataNull;
+        dataNull.Nullify();
+        NDISeekNarrowWithSearchHint( cpage, QwNDIKeyHead( bm.key, dataNull ), clines, &ilineFirst, &ilineLast );
+    }
+
     while( ilineFirst <= ilineLast )
     {
         ilineMid = (ilineFirst + ilineLast)/2;
@@ -586,7 +825,8 @@ INT IlineNDISeekGEQ( const CPAGE& cpage, const BOOKMARK& bm, const BOOL fUnique,
 INT IlineNDISeekGEQInternal(
     const CPAGE& cpage,
     const BOOKMARK& bm,
-    INT * plastCompare )
+    INT * plastCompare,
+    const BOOL fSearchHint )
 {
     Assert( !cpage.FLeafPage() || g_fRepair );
 
@@ -605,6 +845,11 @@ INT IlineNDISeekGEQInternal(
 
     PageEnforce( cpage, lineExternalHeader.cb < g_cbPageMax );
 
+    if ( fSearchHint )
+    {
+        NDISeekNarrowWithSearchHint( cpage, QwNDIKeyHead( bm.key, bm.data ), clines - 1, &ilineFirst, &ilineLast );
+    }
+
     while( ilineFirst <= ilineLast )
     {
         ilineMid = (ilineFirst + ilineLast)/2;
@@ -763,7 +1008,7 @@ INLINE ERR ErrNDISeekInternalPage( const FUCB *pfucb, CSR * pcsr, const BOOKMARK
 
     ERR         err;
     INT         compare;
-    const INT   iline   = IlineNDISeekGEQInternal( pcsr->Cpage(), bm, &compare );
+    const INT   iline   = IlineNDISeekGEQInternal( pcsr->Cpage(), bm, &compare, FNDISearchHintLatch( pcsr ) );
     Assert( iline >= 0 );
     Assert( iline < pcsr->Cpage().Clines( ) );
 
@@ -801,7 +1046,8 @@ INLINE ERR ErrNDISeekLeafPage( const FUCB * pfucb, CSR * pcsr, const BOOKMARK& b
                                             pcsr->Cpage(),
                                             bm,
                                             FFUCBUnique( pfucb ),
-                                            &compare );
+                                            &compare,
+                                            FNDISearchHintLatch( pcsr ) );
     Assert( iline < pcsr->Cpage().Clines( ) );
 
     if ( iline >= 0 && 0 == compare )
@@ -1141,7 +1387,7 @@ ERR ErrNDSeekInternal( FUCB * pfucb, CSR * pcsr, const BOOKMARK& bookmark )
     Assert( !bookmark.key.FNull() );
 
     INT compare = 0;
-    const INT iline = IlineNDISeekGEQInternal( pcsr->Cpage(), bookmark, &compare );
+    const INT iline = IlineNDISeekGEQInternal( pcsr->Cpage(), bookmark, &compare, FNDISearchHintLatch( pcsr ) );
     pcsr->SetILine( iline );
     NDGet( pfucb, pcsr );
     return ( ( compare == 0 ) ? JET_errSuccess : ErrERRCheck( wrnNDFoundGreater ) );
@@ -1293,3 +1293,321 @@ JETUNITTEST ( Node, TestCorruptRandishFuzzingStress )
         }
     }
 }
+
+
+//  turns the search hint cache on for one test, through the same config overrides an
+//  instance would read at system init
+
+LOCAL ERR ErrNDITestEnableSearchHintCache( const ULONG cbCache, const ULONG clinesMax )
+{
+    ERR err = JET_errSuccess;
+
+    Call( ErrEnableTestInjection( 47340, cbCache, JET_TestInjectConfigOverride, 100, JET_bitInjectionProbabilityPct ) );
+    Call( ErrEnableTestInjection( 47356, clinesMax, JET_TestInjectConfigOverride, 100, JET_bitInjectionProbabilityPct ) );
+    err = ErrNDInit();
+
+HandleError:
+    (void)ErrEnableTestInjection( 47340, 0, JET_TestInjectConfigOverride, 0, JET_bitInjectionProbabilityPct );
+    (void)ErrEnableTestInjection( 47356, 0, JET_TestInjectConfigOverride, 0, JET_bitInjectionProbabilityPct );
+    return err;
+}
+
+class CNDTestSearchHintCacheTerm
+{
+public:
+    ~CNDTestSearchHintCacheTerm()
+    {
+        NDTerm();
+    }
+};
+
+struct NDTESTKEY
+{
+    BYTE    rgb[ 16 ];
+    INT     cb;
+};
+
+//  lays out a leaf page holding the given ascending keys. with cbPrefix > 0 the external
+//  header holds the prefix all keys share and every other line is compressed against it
+
+LOCAL VOID NDITestFillLeafPage( CPAGE& cpage, const NDTESTKEY * const rgkey, const INT ckey, const INT cbPrefix )
+{
+    BYTE    rgbData[]   = { 0xd1, 0xd2, 0xd3, 0xd4 };
+    DATA    data;
+
+    cpage.SetFlags( CPAGE::fPageLeaf );
+
+    data.SetPv( (VOID *)rgkey[ 0 ].rgb );
+    data.SetCb( cbPrefix );
+    cpage.SetExternalHeader( &data, 1, 0x0 );
+
+    for ( INT ikey = 0; ikey < ckey; ikey++ )
+    {
+        KEYDATAFLAGS    kdf;
+        DATA            rgdata[ 5 ];
+        INT             fFlagsLine;
+        LE_KEYLEN       le_keylen;
+
+        kdf.Nullify();
+        kdf.key.suffix.SetPv( (VOID *)rgkey[ ikey ].rgb );
+        kdf.key.suffix.SetCb( rgkey[ ikey ].cb );
+        kdf.data.SetPv( rgbData );
+        kdf.data.SetCb( sizeof( rgbData ) );
+
+        le_keylen.le_cbPrefix = USHORT( ( ikey % 2 ) ? cbPrefix : 0 );
+        const INT cdata = CdataNDIPrefixAndKeydataflagsToDataflags( &kdf, rgdata, &fFlagsLine, &le_keylen );
+        cpage.Insert( ikey, rgdata, cdata, fFlagsLine );
+    }
+}
+
+//  seeks with and without the search hint and returns whether both land on the same line
+//  with the same sense of comparison; the hinted result is returned for further checks
+
+LOCAL BOOL FNDITestSearchHintAgrees(
+    const CPAGE&    cpage,
+    const BYTE *    pbKey,
+    const INT       cbKey,
+    INT * const     piline  = NULL,
+    INT * const     pcompare = NULL )
+{
+    BOOKMARK    bm;
+    INT         compareFull;
+    INT         compareHint;
+
+    bm.Nullify();
+    bm.key.suffix.SetPv( (VOID *)pbKey );
+    bm.key.suffix.SetCb( cbKey );
+
+    const INT ilineFull = IlineNDISeekGEQ( cpage, bm, fTrue, &compareFull, fFalse );
+    const INT ilineHint = IlineNDISeekGEQ( cpage, bm, fTrue, &compareHint, fTrue );
+
+    if ( piline )
+    {
+        *piline = ilineHint;
+    }
+    if ( pcompare )
+    {
+        *pcompare = compareHint;
+    }
+
+    return ilineFull == ilineHint
+        && ( compareFull < 0 ) == ( compareHint < 0 )
+        && ( compareFull > 0 ) == ( compareHint > 0 );
+}
+
+//  probes around every key: the key itself, keys just past it, and each of its prefixes
+
+LOCAL BOOL FNDITestSearchHintAgreesAroundKeys( const CPAGE& cpage, const NDTESTKEY * const rgkey, const INT ckey )
+{
+    BOOL fAgrees = fTrue;
+
+    for ( INT ikey = 0; ikey < ckey; ikey++ )
+    {
+        NDTESTKEY   keyProbe    = rgkey[ ikey ];
+        INT         iline;
+        INT         compare;
+
+        fAgrees = fAgrees && FNDITestSearchHintAgrees( cpage, keyProbe.rgb, keyProbe.cb, &iline, &compare );
+        fAgrees = fAgrees && ikey == iline && 0 == compare;
+
+        for ( INT cb = 1; cb < keyProbe.cb; cb++ )
+        {
+            fAgrees = fAgrees && FNDITestSearchHintAgrees( cpage, keyProbe.rgb, cb );
+        }
+
+        keyProbe.rgb[ keyProbe.cb++ ] = 0x00;
+        fAgrees = fAgrees && FNDITestSearchHintAgrees( cpage, keyProbe.rgb, keyProbe.cb );
+        keyProbe.rgb[ keyProbe.cb - 1 ] = 0xff;
+        fAgrees = fAgrees && FNDITestSearchHintAgrees( cpage, keyProbe.rgb, keyProbe.cb );
+    }
+
+    return fAgrees;
+}
+
+//  Many lines share each 8 byte key head, and two short keys pad out to the same head as
+//  the longer keys after them, so the hint can only bound the range and the full key
+//  compares must break every tie.
+
+JETUNITTEST ( Node, SearchHintTiesOnEqualKeyHeads )
+{
+    const INT           cgroup          = 6;
+    const INT           ckeyPerGroup    = 40;
+    const INT           ckey            = 2 + cgroup * ckeyPerGroup;
+    const BYTE          rgbHead[]       = { 'H', 'E', 'A', 'D', 0, 0, 0, 0 };
+    NDTESTKEY           rgkey[ ckey ];
+    CPAGE               cpage;
+    INT                 ckeyFilled      = 0;
+
+    CHECKCALLS( ErrNDITestEnableSearchHintCache( 1024 * 1024, 1024 ) );
+    CNDTestSearchHintCacheTerm term;
+
+    for ( INT cb = sizeof( rgbHead ) - 1; cb <= (INT)sizeof( rgbHead ); cb++ )
+    {
+        memcpy( rgkey[ ckeyFilled ].rgb, rgbHead, cb );
+        rgkey[ ckeyFilled++ ].cb = cb;
+    }
+    for ( INT igroup = 0; igroup < cgroup; igroup++ )
+    {
+        for ( INT ikeyGroup = 0; ikeyGroup < ckeyPerGroup; ikeyGroup++ )
+        {
+            NDTESTKEY * const pkey = &rgkey[ ckeyFilled++ ];
+            memcpy( pkey->rgb, rgbHead, sizeof( rgbHead ) );
+            pkey->rgb[ sizeof( rgbHead ) - 1 ]  = BYTE( igroup );
+            pkey->rgb[ sizeof( rgbHead ) ]      = BYTE( ( ikeyGroup * 3 ) >> 8 );
+            pkey->rgb[ sizeof( rgbHead ) + 1 ]  = BYTE( ikeyGroup * 3 );
+            pkey->cb                            = sizeof( rgbHead ) + 2;
+        }
+    }
+    CHECK( ckey == ckeyFilled );
+
+    cpage.LoadNewTestPage( 32 * 1024 );
+    NDITestFillLeafPage( cpage, rgkey, ckey, 0 );
+    CHECK( ckey == cpage.Clines() );
+
+    CHECK( FNDITestSearchHintAgrees( cpage, rgkey[ 0 ].rgb, rgkey[ 0 ].cb ) );
+    CHECK( FNDSearchHintCached( cpage.Ifmp(), cpage.PgnoThis() ) );
+
+    CHECK( FNDITestSearchHintAgreesAroundKeys( cpage, rgkey, ckey ) );
+
+    //  between the keys of a group, and past the last group
+
+    for ( INT ikey = 2; ikey < ckey; ikey++ )
+    {
+        NDTESTKEY keyProbe = rgkey[ ikey ];
+        keyProbe.rgb[ keyProbe.cb - 1 ]++;
+        CHECK( FNDITestSearchHintAgrees( cpage, keyProbe.rgb, keyProbe.cb ) );
+    }
+
+    NDTESTKEY keyPast = rgkey[ ckey - 1 ];
+    keyPast.rgb[ sizeof( rgbHead ) - 1 ]++;
+    INT ilinePast;
+    CHECK( FNDITestSearchHintAgrees( cpage, keyPast.rgb, keyPast.cb, &ilinePast ) );
+    CHECK( -1 == ilinePast );
+
+    cpage.UnloadPage();
+}
+
+//  Keys share a 5 byte prefix that every other line stores compressed against the external
+//  header, so each key head is assembled from the prefix and the start of the suffix. The
+//  hinted seek must agree with the full key seek for every probe, and a page with more lines
+//  than an entry holds must fall back to the full bisection.
+
+JETUNITTEST ( Node, SearchHintMatchesFullKeySeekOnPrefixCompressedPage )
+{
+    const INT           ckey            = 300;
+    const BYTE          rgbPrefix[]     = { 0x7f, 0x01, 0x02, 0x03, 0x04 };
+    NDTESTKEY           rgkey[ ckey ];
+    CPAGE               cpage;
+
+    for ( INT ikey = 0; ikey < ckey; ikey++ )
+    {
+        NDTESTKEY * const pkey = &rgkey[ ikey ];
+        memcpy( pkey->rgb, rgbPrefix, sizeof( rgbPrefix ) );
+        pkey->cb = sizeof( rgbPrefix );
+        pkey->rgb[ pkey->cb++ ] = BYTE( ( ikey * 5 ) >> 8 );
+        pkey->rgb[ pkey->cb++ ] = BYTE( ikey * 5 );
+        for ( INT cbTail = rand() % 4; cbTail > 0; cbTail-- )
+        {
+            pkey->rgb[ pkey->cb++ ] = ByteRandNoFF();
+        }
+    }
+
+    cpage.LoadNewTestPage( 32 * 1024 );
+    NDITestFillLeafPage( cpage, rgkey, ckey, sizeof( rgbPrefix ) );
+    CHECK( ckey == cpage.Clines() );
+
+    {
+    CHECKCALLS( ErrNDITestEnableSearchHintCache( 1024 * 1024, 1024 ) );
+    CNDTestSearchHintCacheTerm term;
+
+    CHECK( FNDITestSearchHintAgreesAroundKeys( cpage, rgkey, ckey ) );
+    CHECK( FNDSearchHintCached( cpage.Ifmp(), cpage.PgnoThis() ) );
+
+    for ( INT iprobe = 0; iprobe < 1000; iprobe++ )
+    {
+        NDTESTKEY keyProbe;
+        memcpy( keyProbe.rgb, rgbPrefix, sizeof( rgbPrefix ) );
+        keyProbe.cb = sizeof( rgbPrefix ) + rand() % 6;
+        for ( INT ib = sizeof( rgbPrefix ); ib < keyProbe.cb; ib++ )
+        {
+            keyProbe.rgb[ ib ] = BYTE( rand() );
+        }
+        CHECK( FNDITestSearchHintAgrees( cpage, keyProbe.rgb, keyProbe.cb ) );
+    }
+    }
+
+    {
+    CHECKCALLS( ErrNDITestEnableSearchHintCache( 1024 * 1024, ckey / 2 ) );
+    CNDTestSearchHintCacheTerm term;
+
+    CHECK( FNDITestSearchHintAgreesAroundKeys( cpage, rgkey, ckey ) );
+    CHECK( !FNDSearchHintCached( cpage.Ifmp(), cpage.PgnoThis() ) );
+    }
+
+    cpage.UnloadPage();
+}
+
+//  An update to a page must drop its hint through BFDirty, and the next seek must rebuild
+//  it from the new page image.
+
+JETUNITTEST ( Node, SearchHintInvalidatedByBFDirty )
+{
+    const LONG      crec        = 100;
+    const LONG      lKeyUpdate  = crec / 2;
+    const LONG      lDataUpdate = -1;
+    JetTestDatabase db;
+    JET_TABLEID     tableid     = JET_tableidNil;
+    JET_COLUMNID    columnidKey;
+    JET_COLUMNID    columnidData;
+    JET_COLUMNDEF   columndef   = { sizeof( JET_COLUMNDEF ), 0, JET_coltypLong, 0, 0, 0, 0, 0, JET_bitColumnFixed };
+    LONG            lData       = 0;
+    ULONG           cbActual    = 0;
+
+    CHECKCALLS( ErrEnableTestInjection( 47340, 1024 * 1024, JET_TestInjectConfigOverride, 100, JET_bitInjectionProbabilityPct ) );
+    const ERR errInit = db.ErrInit( L"NodeSearchHintDirty" );
+    CHECKCALLS( ErrEnableTestInjection( 47340, 0, JET_TestInjectConfigOverride, 0, JET_bitInjectionProbabilityPct ) );
+    CHECKCALLS( errInit );
+
+    CHECKCALLS( JetCreateTableA( db.Sesid(), db.Dbid(), "Hints", 16, 100, &tableid ) );
+    CHECKCALLS( JetAddColumnA( db.Sesid(), tableid, "Key", &columndef, NULL, 0, &columnidKey ) );
+    CHECKCALLS( JetAddColumnA( db.Sesid(), tableid, "Data", &columndef, NULL, 0, &columnidData ) );
+    CHECKCALLS( JetCreateIndexA( db.Sesid(), tableid, "Primary", JET_bitIndexPrimary, "+Key\0", 6, 100 ) );
+    CHECKCALLS( JetSetCurrentIndexA( db.Sesid(), tableid, NULL ) );
+
+    CHECKCALLS( JetBeginTransaction( db.Sesid() ) );
+    for ( LONG lKey = 0; lKey < crec; lKey++ )
+    {
+        CHECKCALLS( JetPrepareUpdate( db.Sesid(), tableid, JET_prepInsert ) );
+        CHECKCALLS( JetSetColumn( db.Sesid(), tableid, columnidKey, &lKey, sizeof( lKey ), NO_GRBIT, NULL ) );
+        CHECKCALLS( JetSetColumn( db.Sesid(), tableid, columnidData, &lKey, sizeof( lKey ), NO_GRBIT, NULL ) );
+        CHECKCALLS( JetUpdate( db.Sesid(), tableid, NULL, 0, NULL ) );
+    }
+    CHECKCALLS( JetCommitTransaction( db.Sesid(), NO_GRBIT ) );
+
+    //  the records fit on the root page, which is then the only leaf
+
+    FUCB * const    pfucb   = (FUCB *)tableid;
+    const IFMP      ifmp    = pfucb->ifmp;
+    const PGNO      pgno    = pfucb->u.pfcb->PgnoFDP();
+
+    CHECKCALLS( JetMakeKey( db.Sesid(), tableid, &lKeyUpdate, sizeof( lKeyUpdate ), JET_bitNewKey ) );
+    CHECKCALLS( JetSeek( db.Sesid(), tableid, JET_bitSeekEQ ) );
+    CHECK( FNDSearchHintCached( ifmp, pgno ) );
+
+    CHECKCALLS( JetPrepareUpdate( db.Sesid(), tableid, JET_prepReplace ) );
+    CHECKCALLS( JetSetColumn( db.Sesid(), tableid, columnidData, &lDataUpdate, sizeof( lDataUpdate ), NO_GRBIT, NULL ) );
+    CHECKCALLS( JetUpdate( db.Sesid(), tableid, NULL, 0, NULL ) );
+    CHECK( !FNDSearchHintCached( ifmp, pgno ) );
+
+    for ( LONG lKey = 0; lKey < crec; lKey++ )
+    {
+        CHECKCALLS( JetMakeKey( db.Sesid(), tableid, &lKey, sizeof( lKey ), JET_bitNewKey ) );
+        CHECKCALLS( JetSeek( db.Sesid(), tableid, JET_bitSeekEQ ) );
+        CHECKCALLS( JetRetrieveColumn( db.Sesid(), tableid, columnidData, &lData, sizeof( lData ), &cbActual, NO_GRBIT, NULL ) );
+        CHECK( ( lKeyUpdate == lKey ? lDataUpdate : lKey ) == lData );
+    }
+    CHECK( FNDSearchHintCached( ifmp, pgno ) );
+
+    CHECKCALLS( JetCloseTable( db.Sesid(), tableid ) );
+    CHECKCALLS( db.ErrTerm() );
+}
@@ -2701,6 +2701,9 @@ DWORD OLDDefragDb( DWORD_PTR dw )
         }
         else if ( wrnRECCompressed == err )
         {
+            //  MSysDefrag2 is a system table, which cannot train a compression dictionary
+            Assert( !FPKCompressedWithDictionary( dataField ) );
+
             INT cbActual;
             CallS( ErrPKDecompressData(
                     dataField,
@@ -1681,5 +1681,202 @@ JETUNITTEST( IoQueue, TestQueueIODispatchMixedEmptiesVipOpsFirst )
 }
 
 
+struct IOSTRESSCONTEXT
+{
+    volatile LONG   cioPending;
+    volatile LONG   cioFailed;
+};
+
+LOCAL void IoStressIComplete(   const ERR               err,
+                                IFileAPI* const         pfapi,
+                                const FullTraceContext& tc,
+                                const OSFILEQOS         grbitQOS,
+                                const QWORD             ibOffset,
+                                const DWORD             cbData,
+                                const BYTE* const       pbData,
+                                const DWORD_PTR         keyIOComplete )
+{
+    IOSTRESSCONTEXT * const pctx = (IOSTRESSCONTEXT *)keyIOComplete;
+
+    if ( err < JET_errSuccess )
+    {
+        AtomicIncrement( &pctx->cioFailed );
+    }
+    AtomicDecrement( &pctx->cioPending );
+}
+
+LOCAL void IoStressIWait( IFileAPI * const pfapi, IOSTRESSCONTEXT * const pctx )
+{
+    CallS( pfapi->ErrIOIssue() );
+    while ( pctx->cioPending > 0 )
+    {
+        UtilSleep( 1 );
+    }
+}
+
+//  Writes every block and reads it back, in a different random order each pass.  With
+//  fRegister the buffers are registered for ring I/O, and the write buffer is unregistered
+//  and registered again while its writes are still in flight.
+
+LOCAL ERR ErrIoStressIReadWrite( const BOOL fRegister )
+{
+    ERR                 err         = JET_errSuccess;
+    const WCHAR * const wszFile     = L".\\iostress.dat";
+    const DWORD         cbBlock     = 8 * 1024;
+    const DWORD         cblock      = 512;
+    const DWORD         cbBuffer    = cbBlock * cblock;
+    const INT           cpass       = 8;
+
+    IFileSystemAPI *    pfsapi      = NULL;
+    IFileAPI *          pfapi       = NULL;
+    IOSTRESSCONTEXT     ctx         = { 0, 0 };
+    DWORD               rgiblock[ cblock ];
+    BYTE *              pbWrite     = NULL;
+    BYTE *              pbRead      = NULL;
+    BOOL                fRegistered = fFalse;
+
+    Alloc( pbWrite = (BYTE *)PvOSMemoryPageAlloc( cbBuffer, NULL ) );
+    Alloc( pbRead = (BYTE *)PvOSMemoryPageAlloc( cbBuffer, NULL ) );
+
+    if ( fRegister )
+    {
+        fRegistered = FOSDiskRegisterIOBuffer( pbWrite, cbBuffer ) && FOSDiskRegisterIOBuffer( pbRead, cbBuffer );
+    }
+
+    Call( ErrOSFSCreate( &pfsapi ) );
+    (void)pfsapi->ErrFileDelete( wszFile );
+    Call( pfsapi->ErrFileCreate( wszFile, IFileAPI::fmfOverwriteExisting, &pfapi ) );
+    Call( pfapi->ErrSetSize( *TraceContextScope( iorpDirectAccessUtil ), QWORD( cbBuffer ), fTrue, qosIONormal ) );
+
+    for ( DWORD iblock = 0; iblock < cblock; iblock++ )
+    {
+        rgiblock[ iblock ] = iblock;
+    }
+
+    for ( INT ipass = 0; ipass < cpass; ipass++ )
+    {
+        for ( DWORD iblock = cblock - 1; iblock > 0; iblock-- )
+        {
+            const DWORD iblockSwap = rand() % ( iblock + 1 );
+            const DWORD iblockT = rgiblock[ iblock ];
+            rgiblock[ iblock ] = rgiblock[ iblockSwap ];
+            rgiblock[ iblockSwap ] = iblockT;
+        }
+
+        for ( DWORD ib = 0; ib < cbBuffer; ib += sizeof( DWORD ) )
+        {
+            *(DWORD *)( pbWrite + ib ) = ( ipass << 24 ) ^ ib ^ rand();
+        }
+        memset( pbRead, 0, cbBuffer );
+
+        for ( DWORD iiblock = 0; iiblock < cblock; iiblock++ )
+        {
+            const DWORD ibBlock = rgiblock[ iiblock ] * cbBlock;
+            AtomicIncrement( &ctx.cioPending );
+            err = pfapi->ErrIOWrite(    *TraceContextScope( iorpDirectAccessUtil ),
+                                        ibBlock,
+                                        cbBlock,
+                                        pbWrite + ibBlock,
+                                        qosIODispatchImmediate,
+                                        IoStressIComplete,
+                                        DWORD_PTR( &ctx ) );
+            if ( err < JET_errSuccess )
+            {
+                AtomicDecrement( &ctx.cioPending );
+                Error( err );
+            }
+        }
+
+        //  the registered buffer table is replaced under the writes, which must drain first
+
+        if ( fRegistered )
+        {
+            CallS( pfapi->ErrIOIssue() );
+            OSDiskUnregisterIOBuffer( pbWrite, cbBuffer );
+            fRegistered = FOSDiskRegisterIOBuffer( pbWrite, cbBuffer );
+        }
+
+        IoStressIWait( pfapi, &ctx );
+        if ( ctx.cioFailed )
+        {
+            Error( ErrERRCheck( JET_errDiskIO ) );
+        }
+
+        for ( DWORD iiblock = 0; iiblock < cblock; iiblock++ )
+        {
+            const DWORD ibBlock = rgiblock[ cblock - 1 - iiblock ] * cbBlock;
+            AtomicIncrement( &ctx.cioPending );
+            err = pfapi->ErrIORead( *TraceContextScope( iorpDirectAccessUtil ),
+                                    ibBlock,
+                                    cbBlock,
+                                    pbRead + ibBlock,
+                                    qosIODispatchImmediate,
+                                    IoStressIComplete,
+                                    DWORD_PTR( &ctx ) );
+            if ( err < JET_errSuccess )
+            {
+                AtomicDecrement( &ctx.cioPending );
+                Error( err );
+            }
+        }
+        IoStressIWait( pfapi, &ctx );
+        if ( ctx.cioFailed )
+        {
+            Error( ErrERRCheck( JET_errDiskIO ) );
+        }
+
+        if ( 0 != memcmp( pbWrite, pbRead, cbBuffer ) )
+        {
+            Error( ErrERRCheck( JET_errReadVerifyFailure ) );
+        }
+    }
+
+HandleError:
+    if ( pfapi )
+    {
+        IoStressIWait( pfapi, &ctx );
+        pfapi->SetNoFlushNeeded();
+        delete pfapi;
+        (void)pfsapi->ErrFileDelete( wszFile );
+    }
+    delete pfsapi;
+    if ( fRegister )
+    {
+        OSDiskUnregisterIOBuffer( pbRead, cbBuffer );
+        OSDiskUnregisterIOBuffer( pbWrite, cbBuffer );
+    }
+    OSMemoryPageFree( pbRead );
+    OSMemoryPageFree( pbWrite );
+    return err;
+}
+
+JETUNITTEST( IoMgr, AsyncReadWriteStressLocalFile )
+{
+    CHECK( JET_errSuccess == ErrIoStressIReadWrite( fFalse ) );
+}
+
+ERR ErrOSDiskIIOIoRingInit();
+void OSDiskIIOIoRingTerm();
+
+//  "OS/IO" / "IoRing" is only read when the disk subsystem starts, so the ring is restarted
+//  with it forced on (through its config override) and then restarted again as configured.
+//  Where the platform has no IoRing support the ring stays off and this runs on IOCP.
+
+JETUNITTEST( IoMgr, AsyncReadWriteStressLocalFileIoRing )
+{
+    OSDiskIIOIoRingTerm();
+    CHECKCALLS( ErrEnableTestInjection( 59472, fTrue, JET_TestInjectConfigOverride, 100, JET_bitInjectionProbabilityPct ) );
+    CHECKCALLS( ErrOSDiskIIOIoRingInit() );
+
+    const ERR errStress = ErrIoStressIReadWrite( fTrue );
+
+    OSDiskIIOIoRingTerm();
+    CHECKCALLS( ErrEnableTestInjection( 59472, fFalse, JET_TestInjectConfigOverride, 0, JET_bitInjectionProbabilityPct ) );
+    CHECKCALLS( ErrOSDiskIIOIoRingInit() );
+
+    CHECK( JET_errSuccess == errStress );
+}
+
+
 #pragma warning( pop )
 
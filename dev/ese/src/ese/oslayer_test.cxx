@@ -450,5 +450,143 @@ JETUNITTEST( SYSINFO, BetaFeaturesExFeatEnumShouldBeListedInOneFeatureLine )
 }
 #endif
 
+class CNumaTestBuffer
+{
+    public:
+        static SIZE_T OffsetOfAPIC()    { return OffsetOf( CNumaTestBuffer, m_apic ); }
+
+        void*   m_pv;
+        DWORD   m_iNode;
+        CPool< CNumaTestBuffer, CNumaTestBuffer::OffsetOfAPIC >::CInvasiveContext m_apic;
+};
+
+typedef CPool< CNumaTestBuffer, CNumaTestBuffer::OffsetOfAPIC > NumaTestAvail;
+
+JETUNITTEST( OSMemoryNuma, LocalRemoteAllocRatio )
+{
+    const DWORD cNode = OSMemoryNumaNodeCount();
+    const INT cproc = OSSyncGetProcessorCountMax();
+    const size_t cbStripe = 2 * 1024 * 1024;
+    const size_t cbPage = OSMemoryPageCommitGranularity();
+    const size_t cb = cbStripe * 4 * cNode;
+    const size_t cbuf = cb / cbPage;
+
+    CHECK( cNode >= 1 );
+    CHECK( cNode <= cOSMemoryNumaNodeMax );
+    CHECK( OSMemoryNumaNodeCurrent() < cNode );
+
+    BYTE* const pb = (BYTE*)PvOSMemoryPageReserve( cb, NULL );
+    CHECK( pb != NULL );
+    for ( size_t ib = 0; ib < cb; ib += cbStripe )
+    {
+        CHECK( FOSMemoryPageCommitNuma( pb + ib, cbStripe, (DWORD)( ( ib / cbStripe ) % cNode ) ) );
+    }
+
+    CNumaTestBuffer* const rgbuf = new CNumaTestBuffer[ cbuf ];
+    CHECK( rgbuf != NULL );
+    for ( size_t ibuf = 0; ibuf < cbuf; ibuf++ )
+    {
+        rgbuf[ ibuf ].m_pv = pb + ibuf * cbPage;
+        memset( rgbuf[ ibuf ].m_pv, (BYTE)ibuf, cbPage );
+        if ( !FOSMemoryPageNumaNode( rgbuf[ ibuf ].m_pv, &rgbuf[ ibuf ].m_iNode ) )
+        {
+            rgbuf[ ibuf ].m_iNode = (DWORD)( ( ibuf * cbPage / cbStripe ) % cNode );
+        }
+    }
+
+    //  the pool has one bucket per processor index so these lists name the
+    //  buckets that belong to each node
+
+    INT rgcprocNode[ cOSMemoryNumaNodeMax ] = { 0 };
+    INT* const rgiprocNode = new INT[ cOSMemoryNumaNodeMax * cproc ];
+    CHECK( rgiprocNode != NULL );
+    for ( INT iproc = 0; iproc < cproc; iproc++ )
+    {
+        const DWORD iNode = OSMemoryNumaNodeProcessor( iproc );
+        rgiprocNode[ iNode * cproc + rgcprocNode[ iNode ]++ ] = iproc;
+    }
+
+    //  sample the node once so that the expected result does not depend on
+    //  where the scheduler puts us while we drain the pool
+
+    const DWORD iNodeCurrent = OSMemoryNumaNodeCurrent();
+    CHECK( rgcprocNode[ iNodeCurrent ] > 0 );
+
+    size_t cbufNodeCurrent = 0;
+    for ( size_t ibuf = 0; ibuf < cbuf; ibuf++ )
+    {
+        cbufNodeCurrent += ( rgbuf[ ibuf ].m_iNode == iNodeCurrent );
+    }
+
+    const size_t cbufRemove = cbuf / cNode;
+
+    for ( INT fAffinitize = 0; fAffinitize < 2; fAffinitize++ )
+    {
+        NumaTestAvail avail;
+        CHECK( avail.ErrInit( 0.0 ) == NumaTestAvail::ERR::errSuccess );
+
+        for ( size_t ibuf = 0; ibuf < cbuf; ibuf++ )
+        {
+            const DWORD iNode = rgbuf[ ibuf ].m_iNode;
+            const INT iprocPreferred = ( fAffinitize && rgcprocNode[ iNode ] ) ?
+                                            rgiprocNode[ iNode * cproc + ibuf % rgcprocNode[ iNode ] ] :
+                                            -1;
+            avail.Insert( &rgbuf[ ibuf ], fFalse, iprocPreferred );
+        }
+
+        size_t cbufLocal = 0;
+        QWORD qwSum = 0;
+
+        const HRT hrtStart = HrtHRTCount();
+        for ( size_t ibuf = 0; ibuf < cbufRemove; ibuf++ )
+        {
+            CNumaTestBuffer* pbuf = NULL;
+            if ( fAffinitize )
+            {
+                CHECK( avail.ErrRemove( &pbuf,
+                                        cmsecTest,
+                                        fTrue,
+                                        rgiprocNode + iNodeCurrent * cproc,
+                                        rgcprocNode[ iNodeCurrent ] ) == NumaTestAvail::ERR::errSuccess );
+            }
+            else
+            {
+                CHECK( avail.ErrRemove( &pbuf, cmsecTest ) == NumaTestAvail::ERR::errSuccess );
+            }
+            for ( size_t ib = 0; ib < cbPage; ib += sizeof( QWORD ) )
+            {
+                qwSum += *(QWORD*)( (BYTE*)pbuf->m_pv + ib );
+            }
+            cbufLocal += ( pbuf->m_iNode == iNodeCurrent );
+        }
+        const QWORD cusec = CusecHRTFromDhrt( HrtHRTCount() - hrtStart );
+
+        //  with affinity the pool must hand out every buffer of our node before
+        //  it falls back to a remote one
+
+        if ( fAffinitize )
+        {
+            CHECK( cbufLocal == min( cbufRemove, cbufNodeCurrent ) );
+        }
+
+        volatile QWORD qwSumSink = qwSum;
+        (void)qwSumSink;
+
+        REPORTMETRIC( fAffinitize ? "affinitized local" : "unaffinitized local", (QWORD)( 100 * cbufLocal / max( cbufRemove, (size_t)1 ) ), "%" );
+        REPORTMETRIC( fAffinitize ? "affinitized drain" : "unaffinitized drain", cusec, "usec" );
+
+        CNumaTestBuffer* pbuf = NULL;
+        while ( avail.ErrRemove( &pbuf, cmsecTest ) == NumaTestAvail::ERR::errSuccess )
+        {
+        }
+        avail.Term();
+    }
+
+    delete [] rgiprocNode;
+    delete [] rgbuf;
+    OSMemoryPageDecommit( pb, cb );
+    OSMemoryPageFree( pb );
+}
+
 #pragma warning( pop )
 
@@ -117,204 +117,372 @@ struct CURSOR_FILTER_CONTEXT : public MOVE_FILTER_CONTEXT
 {
     NORMALIZED_FILTER_COLUMN *  rgFilters;
     DWORD                       cFilters;
+
+    PGNO                        pgnoLast;
+    PGNO                        pgnoBatch;
+    DBTIME                      dbtimeBatch;
+    INT                         clineBatch;
+    BOOL                        fBatchValid;
+    INT                         clineBatchMax;
+    BYTE *                      rgbitBatchMatch;
+    DATA *                      rgdataBatch;
 };
 
-LOCAL ERR ErrRECICheckCursorFilter( FUCB * const pfucb, CURSOR_FILTER_CONTEXT * const pcursorFilterContext )
+LOCAL ERR ErrRECIRetrieveCursorFilterColumn(
+    FUCB * const                            pfucb,
+    const NORMALIZED_FILTER_COLUMN * const  pFilter,
+    const DATA&                             dataRec,
+    DATA * const                            pdataField )
 {
-    ERR     err         = JET_errSuccess;
-    BOOL    fMatch      = fTrue;
-    DATA    dataField;
+    ERR     err;
 
-    Call( ErrRECCheckMoveFilter( pfucb, (MOVE_FILTER_CONTEXT * const)pcursorFilterContext ) );
-    if ( err > JET_errSuccess )
+    if ( FCOLUMNIDTagged( pFilter->columnid ) )
     {
-        goto HandleError;
+        err = ErrRECRetrieveTaggedColumn(
+            pfucb->u.pfcb,
+            pFilter->columnid,
+            1,
+            dataRec,
+            pdataField,
+            NO_GRBIT );
+    }
+    else
+    {
+        Assert( FCOLUMNIDFixed( pFilter->columnid ) || FCOLUMNIDVar( pFilter->columnid ) );
+        err = ErrRECRetrieveNonTaggedColumn(
+            pfucb->u.pfcb,
+            pFilter->columnid,
+            dataRec,
+            pdataField,
+            NULL  );
     }
 
-    BOOL    fDotNetGuid = fFalse;
-    if ( pfucb->pfucbCurIndex != NULL )
+    if ( err >= JET_errSuccess && JET_errSuccess != err && JET_wrnColumnNull != err )
     {
-        fDotNetGuid = pfucb->pfucbCurIndex->u.pfcb->Pidb()->FDotNetGuid();
+        err = ErrERRCheck( JET_errFilteredMoveNotSupported );
     }
-    else if ( pfucb->u.pfcb->Pidb() != NULL )
+
+    return err;
+}
+
+LOCAL BOOL FRECICursorFilterColumnMatch(
+    const NORMALIZED_FILTER_COLUMN * const  pFilter,
+    const ERR                               errRetrieve,
+    const DATA&                             dataField,
+    const BOOL                              fDotNetGuid )
+{
+    const BOOL  fFilterNull = ( pFilter->cb == 0 && !( pFilter->grbit & JET_bitZeroLength ) );
+    BOOL        fMatch      = fTrue;
+
+    CallSx( errRetrieve, JET_wrnColumnNull );
+    if ( JET_errSuccess == errRetrieve )
     {
-        fDotNetGuid = pfucb->u.pfcb->Pidb()->FDotNetGuid();
+        const BYTE * const  pvFilter    = (BYTE *)pFilter->pv;
+        const INT           cbFilter    = pFilter->cb;
+        BYTE                *pvData;
+        INT                 cbData;
+        BYTE                rgbNormData[ sizeof(GUID) + 1 ];
+
+        if ( pFilter->fNormalized )
+        {
+            Assert( !FRECLongValue( pFilter->coltyp ) );
+            Assert( !FRECTextColumn( pFilter->coltyp ) );
+            Assert( !FRECBinaryColumn( pFilter->coltyp ) );
+            Assert( pFilter->cb > 0 );
+
+            FLDNormalizeFixedSegment(
+                (BYTE *)dataField.Pv(),
+                dataField.Cb(),
+                rgbNormData,
+                &cbData,
+                pFilter->coltyp,
+                fDotNetGuid );
+            Assert( cbData <= sizeof(rgbNormData) );
+            pvData = rgbNormData;
+        }
+        else
+        {
+            pvData = (BYTE *)dataField.Pv();
+            cbData = dataField.Cb();
+        }
+
+        switch ( pFilter->relop )
+        {
+            case JET_relopEquals:
+                fMatch = ( !fFilterNull &&
+                           FDataEqual( pvData, cbData, pvFilter, cbFilter ) );
+                break;
+            case JET_relopPrefixEquals:
+                fMatch = ( cbData >= cbFilter &&
+                           FDataEqual( pvData, cbFilter, pvFilter, cbFilter ) );
+                break;
+            case JET_relopNotEquals:
+                fMatch = ( fFilterNull ||
+                           !FDataEqual( pvData, cbData, pvFilter, cbFilter ) );
+                break;
+            case JET_relopLessThanOrEqual:
+                fMatch = ( !fFilterNull &&
+                           CmpData( pvData, cbData, pvFilter, cbFilter ) <= 0 );
+                break;
+            case JET_relopLessThan:
+                fMatch = ( CmpData( pvData, cbData, pvFilter, cbFilter ) < 0 );
+                break;
+            case JET_relopGreaterThanOrEqual:
+                fMatch = ( CmpData( pvData, cbData, pvFilter, cbFilter ) >= 0 );
+                break;
+            case JET_relopGreaterThan:
+                fMatch = ( fFilterNull ||
+                           CmpData( pvData, cbData, pvFilter, cbFilter ) > 0 );
+                break;
+            case JET_relopBitmaskEqualsZero:
+                Assert( cbData == sizeof(BYTE) || cbData == sizeof(USHORT) || cbData == sizeof(ULONG) || cbData == sizeof(QWORD) );
+                Assert( cbFilter == cbData );
+                switch ( cbData )
+                {
+                    case sizeof(BYTE):
+                        fMatch = ( 0 == ( *(BYTE *)pvData & *(BYTE *)pvFilter ) );
+                        break;
+                    case sizeof(USHORT):
+                        fMatch = ( 0 == ( *(USHORT *)pvData & *(USHORT *)pvFilter ) );
+                        break;
+                    case sizeof(ULONG):
+                        fMatch = ( 0 == ( *(ULONG *)pvData & *(ULONG *)pvFilter ) );
+                        break;
+                    case sizeof(QWORD):
+                        fMatch = ( 0 == ( *(QWORD *)pvData & *(QWORD *)pvFilter ) );
+                        break;
+                }
+                break;
+            case JET_relopBitmaskNotEqualsZero:
+                Assert( cbData == sizeof(BYTE) || cbData == sizeof(USHORT) || cbData == sizeof(ULONG) || cbData == sizeof(QWORD) );
+                Assert( cbFilter == cbData );
+                switch ( cbData )
+                {
+                    case sizeof(BYTE):
+                        fMatch = ( 0 != ( *(BYTE *)pvData & *(BYTE *)pvFilter ) );
+                        break;
+                    case sizeof(USHORT):
+                        fMatch = ( 0 != ( *(USHORT *)pvData & *(USHORT *)pvFilter ) );
+                        break;
+                    case sizeof(ULONG):
+                        fMatch = ( 0 != ( *(ULONG *)pvData & *(ULONG *)pvFilter ) );
+                        break;
+                    case sizeof(QWORD):
+                        fMatch = ( 0 != ( *(QWORD *)pvData & *(QWORD *)pvFilter ) );
+                        break;
+                }
+                break;
+            default:
+                AssertSz( fFalse, "Unrecognized relop for non-null column." );
+                fMatch = fTrue;
+        }
+    }
+    else if ( JET_wrnColumnNull == errRetrieve )
+    {
+        switch ( pFilter->relop )
+        {
+            case JET_relopEquals:
+                fMatch = fFilterNull;
+                break;
+            case JET_relopPrefixEquals:
+                fMatch = fFalse;
+                break;
+            case JET_relopNotEquals:
+                fMatch = !fFilterNull;
+                break;
+            case JET_relopLessThanOrEqual:
+                fMatch = fTrue;
+                break;
+            case JET_relopLessThan:
+                fMatch = !fFilterNull;
+                break;
+            case JET_relopGreaterThanOrEqual:
+                fMatch = fFilterNull;
+                break;
+            case JET_relopGreaterThan:
+                fMatch = fFalse;
+                break;
+            case JET_relopBitmaskEqualsZero:
+                fMatch = fTrue;
+                break;
+            case JET_relopBitmaskNotEqualsZero:
+                fMatch = fFalse;
+                break;
+            default:
+                AssertSz( fFalse, "Unrecognized relop for null column." );
+                fMatch = fTrue;
+        }
     }
 
-    for ( DWORD i = 0; i < pcursorFilterContext->cFilters; i++ )
+    return fMatch;
+}
+
+LOCAL ERR ErrRECIEvaluateCursorFilter(
+    FUCB * const                        pfucb,
+    const CURSOR_FILTER_CONTEXT * const pcursorFilterContext,
+    const DATA&                         dataRec,
+    const BOOL                          fDotNetGuid,
+    BOOL * const                        pfMatch )
+{
+    ERR     err     = JET_errSuccess;
+    DATA    dataField;
+
+    *pfMatch = fTrue;
+
+    for ( DWORD i = 0; i < pcursorFilterContext->cFilters && *pfMatch; i++ )
     {
         const NORMALIZED_FILTER_COLUMN * const  pFilter     = &pcursorFilterContext->rgFilters[i];
-        const BOOL                              fFilterNull = ( pFilter->cb == 0 && !( pFilter->grbit & JET_bitZeroLength ) );
 
-        if ( FCOLUMNIDTagged( pFilter->columnid ) )
+        Call( ErrRECIRetrieveCursorFilterColumn( pfucb, pFilter, dataRec, &dataField ) );
+        *pfMatch = FRECICursorFilterColumnMatch( pFilter, err, dataField, fDotNetGuid );
+    }
+
+    err = JET_errSuccess;
+
+HandleError:
+    return err;
+}
+
+LOCAL VOID RECIBuildCursorFilterBatch(
+    FUCB * const                    pfucb,
+    CURSOR_FILTER_CONTEXT * const   pcursorFilterContext,
+    const BOOL                      fDotNetGuid )
+{
+    const CPAGE&    cpage   = Pcsr( pfucb )->Cpage();
+    const INT       cline   = cpage.Clines();
+    BYTE *&         rgbit   = pcursorFilterContext->rgbitBatchMatch;
+    DATA *&         rgdata  = pcursorFilterContext->rgdataBatch;
+    KEYDATAFLAGS    kdf;
+    DATA            dataField;
+
+    pcursorFilterContext->pgnoBatch     = cpage.PgnoThis();
+    pcursorFilterContext->dbtimeBatch   = cpage.Dbtime();
+    pcursorFilterContext->clineBatch    = cline;
+    pcursorFilterContext->fBatchValid   = fFalse;
+
+    if ( cline > pcursorFilterContext->clineBatchMax )
+    {
+        OSMemoryHeapFree( rgbit );
+        OSMemoryHeapFree( rgdata );
+        pcursorFilterContext->clineBatchMax = 0;
+
+        rgbit = (BYTE *)PvOSMemoryHeapAlloc( ( cline + 7 ) / 8 );
+        rgdata = (DATA *)PvOSMemoryHeapAlloc( cline * sizeof( DATA ) );
+        if ( NULL == rgbit || NULL == rgdata )
         {
-            Call( ErrRECRetrieveTaggedColumn(
-                pfucb->u.pfcb,
-                pFilter->columnid,
-                1,
-                pfucb->kdfCurr.data,
-                &dataField,
-                NO_GRBIT ) );
+            OSMemoryHeapFree( rgbit );
+            OSMemoryHeapFree( rgdata );
+            rgbit = NULL;
+            rgdata = NULL;
+            return;
         }
-        else
+        pcursorFilterContext->clineBatchMax = cline;
+    }
+
+    memset( rgbit, 0xff, ( cline + 7 ) / 8 );
+
+    for ( INT iline = 0; iline < cline; iline++ )
+    {
+        if ( ErrNDIGetKeydataflags( cpage, iline, &kdf ) < JET_errSuccess
+            || kdf.data.Cb() < REC::cbRecordMin )
         {
-            Assert( FCOLUMNIDFixed( pFilter->columnid ) || FCOLUMNIDVar( pFilter->columnid ) );
-            Call( ErrRECRetrieveNonTaggedColumn(
-                pfucb->u.pfcb,
-                pFilter->columnid,
-                pfucb->kdfCurr.data,
-                &dataField,
-                NULL  ) );
+            return;
         }
+        rgdata[ iline ] = kdf.data;
+    }
 
-        CallSx( err, JET_wrnColumnNull );
-        if ( JET_errSuccess == err )
+    for ( DWORD i = 0; i < pcursorFilterContext->cFilters; i++ )
+    {
+        const NORMALIZED_FILTER_COLUMN * const  pFilter     = &pcursorFilterContext->rgFilters[i];
+
+        for ( INT iline = 0; iline < cline; iline++ )
         {
-            const BYTE * const  pvFilter    = (BYTE *)pFilter->pv;
-            const INT           cbFilter    = pFilter->cb;
-            BYTE                *pvData;
-            INT                 cbData;
-            BYTE                rgbNormData[ sizeof(GUID) + 1 ];
-
-            if ( pFilter->fNormalized )
-            {
-                Assert( !FRECLongValue( pFilter->coltyp ) );
-                Assert( !FRECTextColumn( pFilter->coltyp ) );
-                Assert( !FRECBinaryColumn( pFilter->coltyp ) );
-                Assert( pFilter->cb > 0 );
-
-                FLDNormalizeFixedSegment(
-                    (BYTE *)dataField.Pv(),
-                    dataField.Cb(),
-                    rgbNormData,
-                    &cbData,
-                    pFilter->coltyp,
-                    fDotNetGuid );
-                Assert( cbData <= sizeof(rgbNormData) );
-                pvData = rgbNormData;
-            }
-            else
+            if ( !( rgbit[ iline / 8 ] & ( 1 << ( iline % 8 ) ) ) )
             {
-                pvData = (BYTE *)dataField.Pv();
-                cbData = dataField.Cb();
+                continue;
             }
 
-            switch ( pFilter->relop )
+            const ERR errRetrieve = ErrRECIRetrieveCursorFilterColumn( pfucb, pFilter, rgdata[ iline ], &dataField );
+            if ( errRetrieve < JET_errSuccess )
             {
-                case JET_relopEquals:
-                    fMatch = ( !fFilterNull &&
-                               FDataEqual( pvData, cbData, pvFilter, cbFilter ) );
-                    break;
-                case JET_relopPrefixEquals:
-                    fMatch = ( cbData >= cbFilter &&
-                               FDataEqual( pvData, cbFilter, pvFilter, cbFilter ) );
-                    break;
-                case JET_relopNotEquals:
-                    fMatch = ( fFilterNull ||
-                               !FDataEqual( pvData, cbData, pvFilter, cbFilter ) );
-                    break;
-                case JET_relopLessThanOrEqual:
-                    fMatch = ( !fFilterNull &&
-                               CmpData( pvData, cbData, pvFilter, cbFilter ) <= 0 );
-                    break;
-                case JET_relopLessThan:
-                    fMatch = ( CmpData( pvData, cbData, pvFilter, cbFilter ) < 0 );
-                    break;
-                case JET_relopGreaterThanOrEqual:
-                    fMatch = ( CmpData( pvData, cbData, pvFilter, cbFilter ) >= 0 );
-                    break;
-                case JET_relopGreaterThan:
-                    fMatch = ( fFilterNull ||
-                               CmpData( pvData, cbData, pvFilter, cbFilter ) > 0 );
-                    break;
-                case JET_relopBitmaskEqualsZero:
-                    Assert( cbData == sizeof(BYTE) || cbData == sizeof(USHORT) || cbData == sizeof(ULONG) || cbData == sizeof(QWORD) );
-                    Assert( cbFilter == cbData );
-                    switch ( cbData )
-                    {
-                        case sizeof(BYTE):
-                            fMatch = ( 0 == ( *(BYTE *)pvData & *(BYTE *)pvFilter ) );
-                            break;
-                        case sizeof(USHORT):
-                            fMatch = ( 0 == ( *(USHORT *)pvData & *(USHORT *)pvFilter ) );
-                            break;
-                        case sizeof(ULONG):
-                            fMatch = ( 0 == ( *(ULONG *)pvData & *(ULONG *)pvFilter ) );
-                            break;
-                        case sizeof(QWORD):
-                            fMatch = ( 0 == ( *(QWORD *)pvData & *(QWORD *)pvFilter ) );
-                            break;
-                    }
-                    break;
-                case JET_relopBitmaskNotEqualsZero:
-                    Assert( cbData == sizeof(BYTE) || cbData == sizeof(USHORT) || cbData == sizeof(ULONG) || cbData == sizeof(QWORD) );
-                    Assert( cbFilter == cbData );
-                    switch ( cbData )
-                    {
-                        case sizeof(BYTE):
-                            fMatch = ( 0 != ( *(BYTE *)pvData & *(BYTE *)pvFilter ) );
-                            break;
-                        case sizeof(USHORT):
-                            fMatch = ( 0 != ( *(USHORT *)pvData & *(USHORT *)pvFilter ) );
-                            break;
-                        case sizeof(ULONG):
-                            fMatch = ( 0 != ( *(ULONG *)pvData & *(ULONG *)pvFilter ) );
-                            break;
-                        case sizeof(QWORD):
-                            fMatch = ( 0 != ( *(QWORD *)pvData & *(QWORD *)pvFilter ) );
-                            break;
-                    }
-                    break;
-                default:
-                    AssertSz( fFalse, "Unrecognized relop for non-null column." );
-                    fMatch = fTrue;
+                return;
             }
-        }
-        else if ( JET_wrnColumnNull == err )
-        {
-            switch ( pFilter->relop )
+
+            if ( !FRECICursorFilterColumnMatch( pFilter, errRetrieve, dataField, fDotNetGuid ) )
             {
-                case JET_relopEquals:
-                    fMatch = fFilterNull;
-                    break;
-                case JET_relopPrefixEquals:
-                    fMatch = fFalse;
-                    break;
-                case JET_relopNotEquals:
-                    fMatch = !fFilterNull;
-                    break;
-                case JET_relopLessThanOrEqual:
-                    fMatch = fTrue;
-                    break;
-                case JET_relopLessThan:
-                    fMatch = !fFilterNull;
-                    break;
-                case JET_relopGreaterThanOrEqual:
-                    fMatch = fFilterNull;
-                    break;
-                case JET_relopGreaterThan:
-                    fMatch = fFalse;
-                    break;
-                case JET_relopBitmaskEqualsZero:
-                    fMatch = fTrue;
-                    break;
-                case JET_relopBitmaskNotEqualsZero:
-                    fMatch = fFalse;
-                    break;
-                default:
-                    AssertSz( fFalse, "Unrecognized relop for null column." );
-                    fMatch = fTrue;
+                rgbit[ iline / 8 ] &= BYTE( ~( 1 << ( iline % 8 ) ) );
             }
         }
-        else
-        {
-            Error( ErrERRCheck( JET_errFilteredMoveNotSupported ) );
-        }
+    }
 
-        if ( !fMatch )
+    pcursorFilterContext->fBatchValid = fTrue;
+}
+
+LOCAL BOOL FRECICursorFilterBatchMatch(
+    FUCB * const                    pfucb,
+    CURSOR_FILTER_CONTEXT * const   pcursorFilterContext,
+    const BOOL                      fDotNetGuid,
+    BOOL * const                    pfMatch )
+{
+    const CSR * const   pcsr    = Pcsr( pfucb );
+
+    if ( !pcsr->FLatched()
+        || !pcsr->Cpage().FLeafPage()
+        || !pcsr->Cpage().FOnPage( pfucb->kdfCurr.data.Pv(), pfucb->kdfCurr.data.Cb() ) )
+    {
+        return fFalse;
+    }
+
+    const CPAGE&    cpage   = pcsr->Cpage();
+    const INT       iline   = pcsr->ILine();
+
+    if ( pcursorFilterContext->pgnoBatch != cpage.PgnoThis()
+        || pcursorFilterContext->dbtimeBatch != cpage.Dbtime()
+        || pcursorFilterContext->clineBatch != cpage.Clines() )
+    {
+        if ( pcursorFilterContext->pgnoLast != cpage.PgnoThis() )
         {
-            break;
+            pcursorFilterContext->pgnoLast = cpage.PgnoThis();
+            return fFalse;
         }
+
+        RECIBuildCursorFilterBatch( pfucb, pcursorFilterContext, fDotNetGuid );
+    }
+
+    if ( !pcursorFilterContext->fBatchValid )
+    {
+        return fFalse;
+    }
+
+    Assert( iline >= 0 && iline < pcursorFilterContext->clineBatch );
+    *pfMatch = !!( pcursorFilterContext->rgbitBatchMatch[ iline / 8 ] & ( 1 << ( iline % 8 ) ) );
+    return fTrue;
+}
+
+LOCAL ERR ErrRECICheckCursorFilter( FUCB * const pfucb, CURSOR_FILTER_CONTEXT * const pcursorFilterContext )
+{
+    ERR     err         = JET_errSuccess;
+    BOOL    fMatch      = fTrue;
+    BOOL    fDotNetGuid = fFalse;
+
+    Call( ErrRECCheckMoveFilter( pfucb, (MOVE_FILTER_CONTEXT * const)pcursorFilterContext ) );
+    if ( err > JET_errSuccess )
+    {
+        goto HandleError;
+    }
+
+    if ( pfucb->pfucbCurIndex != NULL )
+    {
+        fDotNetGuid = pfucb->pfucbCurIndex->u.pfcb->Pidb()->FDotNetGuid();
+    }
+    else if ( pfucb->u.pfcb->Pidb() != NULL )
+    {
+        fDotNetGuid = pfucb->u.pfcb->Pidb()->FDotNetGuid();
+    }
+
+    if ( !FRECICursorFilterBatchMatch( pfucb, pcursorFilterContext, fDotNetGuid, &fMatch ) )
+    {
+        Call( ErrRECIEvaluateCursorFilter( pfucb, pcursorFilterContext, pfucb->kdfCurr.data, fDotNetGuid, &fMatch ) );
     }
 
     err = fMatch ? JET_errSuccess : wrnBTNotVisibleRejected;
@@ -329,6 +497,8 @@ VOID RECRemoveCursorFilter( FUCB * const pfucb )
     RECRemoveMoveFilter( pfucb, (PFN_MOVE_FILTER)ErrRECICheckCursorFilter, (MOVE_FILTER_CONTEXT**)&pcursorFilterContext );
     if ( pcursorFilterContext )
     {
+        OSMemoryHeapFree( pcursorFilterContext->rgbitBatchMatch );
+        OSMemoryHeapFree( pcursorFilterContext->rgdataBatch );
         delete[] pcursorFilterContext->rgFilters;
         delete pcursorFilterContext;
     }
@@ -548,6 +718,8 @@ HandleError:
     }
     if ( pcursorFilterContext )
     {
+        OSMemoryHeapFree( pcursorFilterContext->rgbitBatchMatch );
+        OSMemoryHeapFree( pcursorFilterContext->rgdataBatch );
         delete[] pcursorFilterContext->rgFilters;
         delete pcursorFilterContext;
     }
@@ -1652,6 +1824,51 @@ HandleError:
 }
 
 
+LOCAL ERR ErrRECIJoinOpenRecordList(
+    JET_SESID                       sesid,
+    const LONG                      cbPage,
+    _Out_ JET_RECORDLIST * const    precordlist )
+{
+    Assert( 1 == sizeof( rgcolumndefJoinlist ) / sizeof( rgcolumndefJoinlist[0] ) );
+    return ErrIsamOpenTempTable(
+                sesid,
+                rgcolumndefJoinlist,
+                sizeof( rgcolumndefJoinlist ) / sizeof( rgcolumndefJoinlist[0] ),
+                NULL,
+                NO_GRBIT,
+                &(precordlist->tableid),
+                &(precordlist->columnidBookmark ),
+                CbKeyMostForPage( cbPage ),
+                CbKeyMostForPage( cbPage ) );
+}
+
+
+LOCAL ERR ErrRECIJoinInsertRecord(
+    JET_SESID                       sesid,
+    JET_RECORDLIST * const          precordlist,
+    const VOID * const              pvBookmark,
+    const ULONG                     cbBookmark )
+{
+    ERR                             err;
+
+    Call( ErrDispPrepareUpdate( sesid, precordlist->tableid, JET_prepInsert ) );
+    Call( ErrDispSetColumn(
+                sesid,
+                precordlist->tableid,
+                precordlist->columnidBookmark,
+                pvBookmark,
+                cbBookmark,
+                NO_GRBIT,
+                NULL ) );
+    Call( ErrDispUpdate( sesid, precordlist->tableid, NULL, 0, NULL, NO_GRBIT ) );
+
+    ++(precordlist->cRecord);
+
+HandleError:
+    return err;
+}
+
+
 LOCAL ERR ErrRECIJoinFindDuplicates(
     JET_SESID                       sesid,
     _In_count_( cindexes ) const JET_INDEXRANGE * const rgindexrange,
@@ -1687,17 +1904,7 @@ LOCAL ERR ErrRECIJoinFindDuplicates(
         Expected( cbPage == g_rgfmp[ rgpfucbSort[ isort ]->ifmp ].CbPage() );
     }
 
-    Assert( 1 == sizeof( rgcolumndefJoinlist ) / sizeof( rgcolumndefJoinlist[0] ) );
-    Call( ErrIsamOpenTempTable(
-                sesid,
-                rgcolumndefJoinlist,
-                sizeof( rgcolumndefJoinlist ) / sizeof( rgcolumndefJoinlist[0] ),
-                NULL,
-                NO_GRBIT,
-                &(precordlist->tableid),
-                &(precordlist->columnidBookmark ),
-                CbKeyMostForPage( cbPage ),
-                CbKeyMostForPage( cbPage ) ) );
+    Call( ErrRECIJoinOpenRecordList( sesid, cbPage, precordlist ) );
 
 
     while( 1 )
@@ -1774,21 +1981,12 @@ LOCAL ERR ErrRECIJoinFindDuplicates(
 
         if( fDuplicate )
         {
-            Call( ErrDispPrepareUpdate( sesid, precordlist->tableid, JET_prepInsert ) );
-
             Assert( rgpfucbSort[isortMin]->kdfCurr.key.prefix.FNull() );
-            Call( ErrDispSetColumn(
+            Call( ErrRECIJoinInsertRecord(
                         sesid,
-                        precordlist->tableid,
-                        precordlist->columnidBookmark,
+                        precordlist,
                         rgpfucbSort[isortMin]->kdfCurr.key.suffix.Pv(),
-                        rgpfucbSort[isortMin]->kdfCurr.key.suffix.Cb(),
-                        NO_GRBIT,
-                        NULL ) );
-
-            Call( ErrDispUpdate( sesid, precordlist->tableid, NULL, 0, NULL, NO_GRBIT ) );
-
-            ++(precordlist->cRecord);
+                        rgpfucbSort[isortMin]->kdfCurr.key.suffix.Cb() ) );
         }
 
 
@@ -1819,6 +2017,350 @@ HandleError:
 }
 
 
+const SIZE_T    cbRECIntersectHashMost      = 16 * 1024 * 1024;
+const ULONG     cbmRECIntersectChunk        = 256;
+const ULONG     ibRECIntersectEntryFree     = ulMax;
+
+struct INTERSECT_RANGE
+{
+    BYTE *  pbBookmarks;
+    SIZE_T  cbBookmarks;
+    SIZE_T  cbBookmarksMax;
+    ULONG   cBookmarks;
+    BOOL    fStarted;
+    BOOL    fExhausted;
+};
+
+struct INTERSECT_ENTRY
+{
+    ULONG   ibBookmark;
+    ULONG   cHits;
+};
+
+
+LOCAL ERR ErrRECIIntersectAppendBookmark(
+    INTERSECT_RANGE * const prange,
+    const DATA&             dataBookmark )
+{
+    const USHORT    cbBookmark  = USHORT( dataBookmark.Cb() );
+    const SIZE_T    cbNeeded    = prange->cbBookmarks + sizeof( USHORT ) + cbBookmark;
+
+    Assert( dataBookmark.Cb() <= wMax );
+
+    if ( cbNeeded > prange->cbBookmarksMax )
+    {
+        const SIZE_T    cbNew   = max( max( cbNeeded, 2 * prange->cbBookmarksMax ), (SIZE_T)4096 );
+        BYTE * const    pbNew   = (BYTE *)PvOSMemoryHeapAlloc( cbNew );
+
+        if ( NULL == pbNew )
+        {
+            return ErrERRCheck( JET_errOutOfMemory );
+        }
+        if ( prange->cbBookmarks > 0 )
+        {
+            UtilMemCpy( pbNew, prange->pbBookmarks, prange->cbBookmarks );
+        }
+        OSMemoryHeapFree( prange->pbBookmarks );
+        prange->pbBookmarks = pbNew;
+        prange->cbBookmarksMax = cbNew;
+    }
+
+    UtilMemCpy( prange->pbBookmarks + prange->cbBookmarks, &cbBookmark, sizeof( USHORT ) );
+    UtilMemCpy( prange->pbBookmarks + prange->cbBookmarks + sizeof( USHORT ), dataBookmark.Pv(), cbBookmark );
+    prange->cbBookmarks = cbNeeded;
+    prange->cBookmarks++;
+
+    return JET_errSuccess;
+}
+
+
+LOCAL ERR ErrRECIIntersectBufferBookmarks(
+    FUCB * const            pfucb,
+    INTERSECT_RANGE * const prange,
+    const ULONG             cbmMax )
+{
+    ERR                 err;
+    const INST * const  pinst       = PinstFromPfucb( pfucb );
+    ULONG               cbm         = 0;
+
+    Assert( !prange->fExhausted );
+
+    err = prange->fStarted ? ErrDIRNext( pfucb, fDIRNull ) : ErrDIRGet( pfucb );
+    prange->fStarted = fTrue;
+
+    while ( JET_errSuccess == err )
+    {
+        Call( pinst->ErrCheckForTermination() );
+        Call( ErrRECIIntersectAppendBookmark( prange, pfucb->kdfCurr.data ) );
+
+        if ( ++cbm == cbmMax )
+        {
+            break;
+        }
+
+        err = ErrDIRNext( pfucb, fDIRNull );
+    }
+
+    if ( JET_errNoCurrentRecord == err )
+    {
+        prange->fExhausted = fTrue;
+        err = JET_errSuccess;
+    }
+
+HandleError:
+    DIRUp( pfucb );
+
+    return err;
+}
+
+
+LOCAL INTERSECT_ENTRY * PentryRECIIntersectLookup(
+    INTERSECT_ENTRY * const rgentry,
+    const ULONG             centry,
+    const BYTE * const      pbBookmarksBase,
+    const BYTE * const      pbBookmark,
+    const USHORT            cbBookmark )
+{
+    Assert( 0 == ( centry & ( centry - 1 ) ) );
+
+    for ( ULONG ientry = ULONG( Ui64FNVHash( pbBookmark, cbBookmark ) ) & ( centry - 1 );
+        ;
+        ientry = ( ientry + 1 ) & ( centry - 1 ) )
+    {
+        INTERSECT_ENTRY * const pentry  = &rgentry[ ientry ];
+        USHORT                  cbEntry;
+
+        if ( ibRECIntersectEntryFree == pentry->ibBookmark )
+        {
+            return pentry;
+        }
+
+        UtilMemCpy( &cbEntry, pbBookmarksBase + pentry->ibBookmark, sizeof( USHORT ) );
+        if ( cbEntry == cbBookmark
+            && 0 == memcmp( pbBookmarksBase + pentry->ibBookmark + sizeof( USHORT ), pbBookmark, cbBookmark ) )
+        {
+            return pentry;
+        }
+    }
+}
+
+
+LOCAL ULONG CRECIIntersectProbe(
+    INTERSECT_ENTRY * const         rgentry,
+    const ULONG                     centry,
+    const INTERSECT_RANGE * const   prangeBuild,
+    const INTERSECT_RANGE * const   prangeProbe,
+    const ULONG                     cHitsPrev )
+{
+    ULONG   cMatched    = 0;
+
+    for ( SIZE_T ib = 0; ib < prangeProbe->cbBookmarks; )
+    {
+        USHORT  cbBookmark;
+
+        UtilMemCpy( &cbBookmark, prangeProbe->pbBookmarks + ib, sizeof( USHORT ) );
+
+        INTERSECT_ENTRY * const pentry  = PentryRECIIntersectLookup(
+                                                rgentry,
+                                                centry,
+                                                prangeBuild->pbBookmarks,
+                                                prangeProbe->pbBookmarks + ib + sizeof( USHORT ),
+                                                cbBookmark );
+
+        if ( ibRECIntersectEntryFree != pentry->ibBookmark && cHitsPrev == pentry->cHits )
+        {
+            pentry->cHits++;
+            cMatched++;
+        }
+
+        ib += sizeof( USHORT ) + cbBookmark;
+    }
+
+    return cMatched;
+}
+
+
+LOCAL ERR ErrRECIIntersectIndexesHash(
+    const JET_SESID                                         sesid,
+    _In_count_( cindexrange ) const JET_INDEXRANGE * const  rgindexrange,
+    _In_count_( cindexrange ) INTERSECT_RANGE * const       rgrange,
+    _In_range_( 1, 64 ) const ULONG                         cindexrange,
+    _Out_ JET_RECORDLIST * const                            precordlist,
+    BOOL * const                                            pfOverBudget )
+{
+    ERR                     err         = JET_errSuccess;
+    ULONG                   irangeBuild = cindexrange;
+    ULONG                   irange;
+    SIZE_T                  cbBuffered;
+    ULONG                   centry      = 1;
+    INTERSECT_ENTRY *       rgentry     = NULL;
+    ULONG                   cLive       = 0;
+    ULONG                   cHits       = 0;
+    const INTERSECT_RANGE * prangeBuild = NULL;
+    FUCB *                  pfucbIdx;
+    LONG                    cbPage;
+    const SIZE_T            cbHashMost  = (SIZE_T)UlConfigOverrideInjection( 47212, cbRECIntersectHashMost );
+
+    *pfOverBudget = fFalse;
+
+    while ( cindexrange == irangeBuild )
+    {
+        for ( irange = 0; irange < cindexrange; irange++ )
+        {
+            pfucbIdx = reinterpret_cast<FUCB *>( rgindexrange[irange].tableid )->pfucbCurIndex;
+            Call( ErrRECIIntersectBufferBookmarks( pfucbIdx, &rgrange[irange], cbmRECIntersectChunk ) );
+
+            if ( rgrange[irange].fExhausted )
+            {
+                irangeBuild = irange;
+                break;
+            }
+
+            cbBuffered = 0;
+            for ( ULONG irangeT = 0; irangeT < cindexrange; irangeT++ )
+            {
+                cbBuffered += rgrange[irangeT].cbBookmarksMax;
+            }
+            if ( cbBuffered > cbHashMost )
+            {
+                *pfOverBudget = fTrue;
+                goto HandleError;
+            }
+        }
+    }
+
+    prangeBuild = &rgrange[irangeBuild];
+
+    while ( centry < 2 * prangeBuild->cBookmarks )
+    {
+        centry *= 2;
+    }
+
+    cbBuffered = centry * sizeof( INTERSECT_ENTRY );
+    for ( irange = 0; irange < cindexrange; irange++ )
+    {
+        cbBuffered += rgrange[irange].cbBookmarksMax;
+    }
+    if ( cbBuffered > cbHashMost )
+    {
+        *pfOverBudget = fTrue;
+        goto HandleError;
+    }
+    Alloc( rgentry = (INTERSECT_ENTRY *)PvOSMemoryHeapAlloc( centry * sizeof( INTERSECT_ENTRY ) ) );
+    memset( rgentry, 0xff, centry * sizeof( INTERSECT_ENTRY ) );
+
+    cLive = 0;
+    for ( SIZE_T ib = 0; ib < prangeBuild->cbBookmarks; )
+    {
+        USHORT  cbBookmark;
+
+        UtilMemCpy( &cbBookmark, prangeBuild->pbBookmarks + ib, sizeof( USHORT ) );
+
+        INTERSECT_ENTRY * const pentry  = PentryRECIIntersectLookup(
+                                                rgentry,
+                                                centry,
+                                                prangeBuild->pbBookmarks,
+                                                prangeBuild->pbBookmarks + ib + sizeof( USHORT ),
+                                                cbBookmark );
+        if ( ibRECIntersectEntryFree == pentry->ibBookmark )
+        {
+            pentry->ibBookmark = ULONG( ib );
+            pentry->cHits = 0;
+            cLive++;
+        }
+
+        ib += sizeof( USHORT ) + cbBookmark;
+    }
+
+    for ( irange = 0; irange < cindexrange && cLive > 0; irange++ )
+    {
+        if ( irange == irangeBuild )
+        {
+            continue;
+        }
+
+        pfucbIdx = reinterpret_cast<FUCB *>( rgindexrange[irange].tableid )->pfucbCurIndex;
+
+        cLive = 0;
+        forever
+        {
+            cLive += CRECIIntersectProbe( rgentry, centry, prangeBuild, &rgrange[irange], cHits );
+
+            if ( rgrange[irange].fExhausted )
+            {
+                break;
+            }
+
+            rgrange[irange].cbBookmarks = 0;
+            rgrange[irange].cBookmarks = 0;
+            Call( ErrRECIIntersectBufferBookmarks( pfucbIdx, &rgrange[irange], cbmRECIntersectChunk ) );
+        }
+        cHits++;
+    }
+
+    if ( 0 == cLive )
+    {
+        goto HandleError;
+    }
+
+    pfucbIdx = reinterpret_cast<FUCB *>( rgindexrange[0].tableid )->pfucbCurIndex;
+    cbPage = CbAssertGlobalPageSizeMatchRTL( g_rgfmp[ pfucbIdx->ifmp ].CbPage() );
+    Call( ErrRECIJoinOpenRecordList( sesid, cbPage, precordlist ) );
+
+    for ( ULONG ientry = 0; ientry < centry; ientry++ )
+    {
+        if ( ibRECIntersectEntryFree != rgentry[ientry].ibBookmark && cHits == rgentry[ientry].cHits )
+        {
+            const BYTE * const  pbBookmark  = prangeBuild->pbBookmarks + rgentry[ientry].ibBookmark;
+            USHORT              cbBookmark;
+
+            UtilMemCpy( &cbBookmark, pbBookmark, sizeof( USHORT ) );
+            Call( ErrRECIJoinInsertRecord( sesid, precordlist, pbBookmark + sizeof( USHORT ), cbBookmark ) );
+        }
+    }
+
+HandleError:
+    OSMemoryHeapFree( rgentry );
+
+    if( err < 0 && JET_tableidNil != precordlist->tableid )
+    {
+        CallS( ErrDispCloseTable( sesid, precordlist->tableid ) );
+        precordlist->tableid = JET_tableidNil;
+        precordlist->cRecord = 0;
+    }
+
+    return err;
+}
+
+
+LOCAL ERR ErrRECIInsertBufferedBookmarksIntoSort(
+    const INTERSECT_RANGE * const   prange,
+    FUCB * const                    pfucbSort )
+{
+    ERR                             err         = JET_errSuccess;
+    KEY                             key;
+    DATA                            data;
+
+    key.prefix.Nullify();
+    data.Nullify();
+
+    for ( SIZE_T ib = 0; ib < prange->cbBookmarks; )
+    {
+        USHORT  cbBookmark;
+
+        UtilMemCpy( &cbBookmark, prange->pbBookmarks + ib, sizeof( USHORT ) );
+        key.suffix.SetPv( prange->pbBookmarks + ib + sizeof( USHORT ) );
+        key.suffix.SetCb( cbBookmark );
+        Call( ErrSORTInsert( pfucbSort, key, data ) );
+
+        ib += sizeof( USHORT ) + cbBookmark;
+    }
+
+HandleError:
+    return err;
+}
+
+
 ERR ErrIsamIntersectIndexes(
     const JET_SESID sesid,
     _In_count_( cindexrange ) const JET_INDEXRANGE * const rgindexrange,
@@ -1826,10 +2368,13 @@ ERR ErrIsamIntersectIndexes(
     _Out_ JET_RECORDLIST * const precordlist,
     const JET_GRBIT grbit )
 {
-    PIB * const ppib        = reinterpret_cast<PIB *>( sesid );
-    FUCB *      rgpfucbSort[64];
-    SIZE_T      ipfucb;
-    ERR         err;
+    PIB * const         ppib            = reinterpret_cast<PIB *>( sesid );
+    FUCB *              rgpfucbSort[64];
+    SIZE_T              ipfucb;
+    ERR                 err;
+    INTERSECT_RANGE *   rgrange         = NULL;
+    BOOL                fHashable       = fTrue;
+    BOOL                fOverBudget     = fFalse;
 
     CallR( ErrPIBCheck( ppib ) );
     AssertDIRNoLatch( ppib );
@@ -1863,6 +2408,24 @@ ERR ErrIsamIntersectIndexes(
     precordlist->columnidBookmark = 0;
 
     Call( ErrPIBOpenTempDatabase( ppib ) );
+
+    for( ipfucb = 0; ipfucb < cindexrange; ++ipfucb )
+    {
+        if( JET_bitRecordInIndex != rgindexrange[ipfucb].grbit )
+        {
+            fHashable = fFalse;
+        }
+    }
+
+    if( fHashable )
+    {
+        Alloc( rgrange = new INTERSECT_RANGE[ cindexrange ]() );
+        Call( ErrRECIIntersectIndexesHash( sesid, rgindexrange, rgrange, cindexrange, precordlist, &fOverBudget ) );
+        if( !fOverBudget )
+        {
+            goto HandleError;
+        }
+    }
     
     for( ipfucb = 0; ipfucb < cindexrange; ++ipfucb )
     {
@@ -1872,7 +2435,14 @@ ERR ErrIsamIntersectIndexes(
     for( ipfucb = 0; ipfucb < cindexrange; ++ipfucb )
     {
         FUCB * const pfucb  = reinterpret_cast<FUCB *>( rgindexrange[ipfucb].tableid );
-        Call( ErrRECIInsertBookmarksIntoSort( pfucb->pfucbCurIndex, rgpfucbSort[ipfucb], grbit ) );
+        if( NULL != rgrange )
+        {
+            Call( ErrRECIInsertBufferedBookmarksIntoSort( &rgrange[ipfucb], rgpfucbSort[ipfucb] ) );
+        }
+        if( NULL == rgrange || !rgrange[ipfucb].fExhausted )
+        {
+            Call( ErrRECIInsertBookmarksIntoSort( pfucb->pfucbCurIndex, rgpfucbSort[ipfucb], grbit ) );
+        }
         Call( ErrSORTEndInsert( rgpfucbSort[ipfucb] ) );
     }
 
@@ -1894,6 +2464,16 @@ HandleError:
         }
     }
 
+    if( NULL != rgrange )
+    {
+        for( ipfucb = 0; ipfucb < cindexrange; ++ipfucb )
+        {
+            FUCBResetPreread( reinterpret_cast<FUCB *>( rgindexrange[ipfucb].tableid )->pfucbCurIndex );
+            OSMemoryHeapFree( rgrange[ipfucb].pbBookmarks );
+        }
+        delete[] rgrange;
+    }
+
     return err;
 }
 
@@ -0,0 +1,493 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "std.hxx"
+
+#ifndef ENABLE_JET_UNIT_TEST
+#error This file should only be compiled with the unit tests!
+#endif
+
+const LONG  lRecTestFilterThreshold     = 40;
+const LONG  lRecTestFilterTaggedReject  = 3;
+const LONG  lRecTestNull                = -1;
+const ULONG idRecTestIntersectHashMost  = 47212;    //  JetIntersectIndexes hash budget override
+
+LOCAL ERR ErrRecTestIPopulate(
+    const JET_SESID         sesid,
+    const JET_DBID          dbid,
+    JET_TABLEID * const     ptableid,
+    JET_COLUMNID * const    pcolumnidKey,
+    JET_COLUMNID * const    pcolumnidFixed,
+    JET_COLUMNID * const    pcolumnidTagged,
+    LONG * const            rglFixed,
+    LONG * const            rglTagged,
+    const LONG              crec )
+{
+    ERR             err;
+    JET_COLUMNDEF   columndef   = { sizeof( JET_COLUMNDEF ), 0, JET_coltypLong, 0, 0, 0, 0, 0, JET_bitColumnFixed };
+    BYTE            rgbPad[ 64 ];
+    JET_COLUMNID    columnidPad;
+
+    memset( rgbPad, 'p', sizeof( rgbPad ) );
+
+    Call( JetCreateTableA( sesid, dbid, "RecFilterTest", 16, 100, ptableid ) );
+    Call( JetAddColumnA( sesid, *ptableid, "Key", &columndef, NULL, 0, pcolumnidKey ) );
+    Call( JetAddColumnA( sesid, *ptableid, "Fixed", &columndef, NULL, 0, pcolumnidFixed ) );
+    columndef.grbit = JET_bitColumnTagged;
+    Call( JetAddColumnA( sesid, *ptableid, "Tagged", &columndef, NULL, 0, pcolumnidTagged ) );
+    Call( JetCreateIndexA( sesid, *ptableid, "Primary", JET_bitIndexPrimary, "+Key\0", 6, 100 ) );
+
+    columndef.coltyp = JET_coltypBinary;
+    columndef.grbit = NO_GRBIT;
+    Call( JetAddColumnA( sesid, *ptableid, "Pad", &columndef, NULL, 0, &columnidPad ) );
+
+    Call( JetBeginTransaction( sesid ) );
+    for ( LONG irec = 0; irec < crec; irec++ )
+    {
+        rglFixed[ irec ] = ( irec % 5 ) ? irec % 100 : lRecTestNull;
+        rglTagged[ irec ] = ( irec % 3 ) ? irec % 7 : lRecTestNull;
+
+        Call( JetPrepareUpdate( sesid, *ptableid, JET_prepInsert ) );
+        Call( JetSetColumn( sesid, *ptableid, *pcolumnidKey, &irec, sizeof( irec ), NO_GRBIT, NULL ) );
+        if ( lRecTestNull != rglFixed[ irec ] )
+        {
+            Call( JetSetColumn( sesid, *ptableid, *pcolumnidFixed, &rglFixed[ irec ], sizeof( LONG ), NO_GRBIT, NULL ) );
+        }
+        if ( lRecTestNull != rglTagged[ irec ] )
+        {
+            Call( JetSetColumn( sesid, *ptableid, *pcolumnidTagged, &rglTagged[ irec ], sizeof( LONG ), NO_GRBIT, NULL ) );
+        }
+        Call( JetSetColumn( sesid, *ptableid, columnidPad, rgbPad, 1 + irec % sizeof( rgbPad ), NO_GRBIT, NULL ) );
+        Call( JetUpdate( sesid, *ptableid, NULL, 0, NULL ) );
+
+        if ( 0 == irec % 100 )
+        {
+            Call( JetCommitTransaction( sesid, JET_bitCommitLazyFlush ) );
+            Call( JetBeginTransaction( sesid ) );
+        }
+    }
+    Call( JetCommitTransaction( sesid, JET_bitCommitLazyFlush ) );
+
+HandleError:
+    return err;
+}
+
+LOCAL BOOL FRecTestIExpectedMatch( const LONG lFixed, const LONG lTagged )
+{
+    return lRecTestNull != lFixed
+        && lFixed >= lRecTestFilterThreshold
+        && lTagged != lRecTestFilterTaggedReject;
+}
+
+LOCAL ERR ErrRecTestISetFilter(
+    const JET_SESID     sesid,
+    const JET_TABLEID   tableid,
+    const JET_COLUMNID  columnidFixed,
+    const JET_COLUMNID  columnidTagged )
+{
+    LONG                lThreshold  = lRecTestFilterThreshold;
+    LONG                lReject     = lRecTestFilterTaggedReject;
+    JET_INDEX_COLUMN    rgfilter[ 2 ];
+
+    rgfilter[ 0 ].columnid  = columnidFixed;
+    rgfilter[ 0 ].relop     = JET_relopGreaterThanOrEqual;
+    rgfilter[ 0 ].pv        = &lThreshold;
+    rgfilter[ 0 ].cb        = sizeof( lThreshold );
+    rgfilter[ 0 ].grbit     = NO_GRBIT;
+    rgfilter[ 1 ].columnid  = columnidTagged;
+    rgfilter[ 1 ].relop     = JET_relopNotEquals;
+    rgfilter[ 1 ].pv        = &lReject;
+    rgfilter[ 1 ].cb        = sizeof( lReject );
+    rgfilter[ 1 ].grbit     = NO_GRBIT;
+
+    return JetSetCursorFilter( sesid, tableid, rgfilter, _countof( rgfilter ), NO_GRBIT );
+}
+
+JETUNITTEST( REC, CursorFilterPageBatchMatchesPerRecord )
+{
+    const LONG      crec            = 5000;
+    JetTestDatabase db;
+    JET_TABLEID     tableid         = JET_tableidNil;
+    JET_TABLEID     tableidUpdate   = JET_tableidNil;
+    JET_COLUMNID    columnidKey;
+    JET_COLUMNID    columnidFixed;
+    JET_COLUMNID    columnidTagged;
+    LONG*           rglFixed        = new LONG[ crec ];
+    LONG*           rglTagged       = new LONG[ crec ];
+
+    CHECK( NULL != rglFixed );
+    CHECK( NULL != rglTagged );
+
+    CHECKCALLS( db.ErrInit( L"RecFilter" ) );
+    const JET_SESID sesid = db.Sesid();
+    CHECKCALLS( ErrRecTestIPopulate( sesid, db.Dbid(), &tableid, &columnidKey, &columnidFixed, &columnidTagged, rglFixed, rglTagged, crec ) );
+    CHECKCALLS( JetDupCursor( sesid, tableid, &tableidUpdate, NO_GRBIT ) );
+    CHECKCALLS( ErrRecTestISetFilter( sesid, tableid, columnidFixed, columnidTagged ) );
+
+    for ( INT iPass = 0; iPass < 2; iPass++ )
+    {
+        LONG    irecExpected    = -1;
+        LONG    crecMatched     = 0;
+        ERR     err             = JET_errSuccess;
+
+        CHECKCALLS( JetBeginTransaction( sesid ) );
+
+        for ( err = JetMove( sesid, tableid, JET_MoveFirst, NO_GRBIT );
+            JET_errSuccess == err;
+            err = JetMove( sesid, tableid, JET_MoveNext, NO_GRBIT ) )
+        {
+            LONG    irec    = 0;
+            ULONG   cbActual;
+
+            CHECKCALLS( JetRetrieveColumn( sesid, tableid, columnidKey, &irec, sizeof( irec ), &cbActual, NO_GRBIT, NULL ) );
+
+            for ( irecExpected++; irecExpected < irec; irecExpected++ )
+            {
+                CHECK( !FRecTestIExpectedMatch( rglFixed[ irecExpected ], rglTagged[ irecExpected ] ) );
+            }
+            CHECK( FRecTestIExpectedMatch( rglFixed[ irec ], rglTagged[ irec ] ) );
+            crecMatched++;
+
+            if ( iPass && irec + 2 < crec && 0 == irec % 3 )
+            {
+                const LONG  irecUpdate  = irec + 2;
+
+                rglFixed[ irecUpdate ] = FRecTestIExpectedMatch( rglFixed[ irecUpdate ], rglTagged[ irecUpdate ] ) ? 0 : 99;
+                CHECKCALLS( JetMakeKey( sesid, tableidUpdate, &irecUpdate, sizeof( irecUpdate ), JET_bitNewKey ) );
+                CHECKCALLS( JetSeek( sesid, tableidUpdate, JET_bitSeekEQ ) );
+                CHECKCALLS( JetPrepareUpdate( sesid, tableidUpdate, JET_prepReplace ) );
+                CHECKCALLS( JetSetColumn( sesid, tableidUpdate, columnidFixed, &rglFixed[ irecUpdate ], sizeof( LONG ), NO_GRBIT, NULL ) );
+                CHECKCALLS( JetUpdate( sesid, tableidUpdate, NULL, 0, NULL ) );
+            }
+        }
+        CHECK( JET_errNoCurrentRecord == err );
+
+        for ( irecExpected++; irecExpected < crec; irecExpected++ )
+        {
+            CHECK( !FRecTestIExpectedMatch( rglFixed[ irecExpected ], rglTagged[ irecExpected ] ) );
+        }
+        CHECK( crecMatched > 0 );
+
+        CHECKCALLS( JetCommitTransaction( sesid, JET_bitCommitLazyFlush ) );
+
+        LONG    crecMatchedReverse  = 0;
+        for ( err = JetMove( sesid, tableid, JET_MoveLast, NO_GRBIT );
+            JET_errSuccess == err;
+            err = JetMove( sesid, tableid, JET_MovePrevious, NO_GRBIT ) )
+        {
+            crecMatchedReverse++;
+        }
+        CHECK( JET_errNoCurrentRecord == err );
+
+        LONG    crecExpected    = 0;
+        for ( LONG irec = 0; irec < crec; irec++ )
+        {
+            crecExpected += FRecTestIExpectedMatch( rglFixed[ irec ], rglTagged[ irec ] ) ? 1 : 0;
+        }
+        CHECK( crecExpected == crecMatchedReverse );
+    }
+
+    CHECKCALLS( JetSetCursorFilter( sesid, tableid, NULL, 0, NO_GRBIT ) );
+
+    delete[] rglTagged;
+    delete[] rglFixed;
+
+    CHECKCALLS( JetCloseTable( sesid, tableidUpdate ) );
+    CHECKCALLS( JetCloseTable( sesid, tableid ) );
+    CHECKCALLS( db.ErrTerm() );
+}
+
+JETUNITTESTEX( REC, CursorFilterScanPerf, JetSimpleUnitTest::dwDontRunByDefault )
+{
+    const LONG      crec            = 500000;
+    JetTestDatabase db;
+    JET_TABLEID     tableid         = JET_tableidNil;
+    JET_COLUMNID    columnidKey;
+    JET_COLUMNID    columnidFixed;
+    JET_COLUMNID    columnidTagged;
+    LONG*           rglFixed        = new LONG[ crec ];
+    LONG*           rglTagged       = new LONG[ crec ];
+
+    CHECK( NULL != rglFixed );
+    CHECK( NULL != rglTagged );
+
+    CHECKCALLS( db.ErrInit( L"RecFilterPerf" ) );
+    const JET_SESID sesid = db.Sesid();
+    CHECKCALLS( ErrRecTestIPopulate( sesid, db.Dbid(), &tableid, &columnidKey, &columnidFixed, &columnidTagged, rglFixed, rglTagged, crec ) );
+    CHECKCALLS( ErrRecTestISetFilter( sesid, tableid, columnidFixed, columnidTagged ) );
+
+    const HRT   hrtStart    = HrtHRTCount();
+    LONG        crecMatched = 0;
+
+    CHECKCALLS( JetBeginTransaction( sesid ) );
+    for ( ERR err = JetMove( sesid, tableid, JET_MoveFirst, NO_GRBIT );
+        JET_errSuccess == err;
+        err = JetMove( sesid, tableid, JET_MoveNext, NO_GRBIT ) )
+    {
+        crecMatched++;
+    }
+    CHECKCALLS( JetCommitTransaction( sesid, NO_GRBIT ) );
+
+    const QWORD cusec = CusecHRTFromDhrt( HrtHRTCount() - hrtStart );
+    REPORTMETRIC( "matched", crecMatched, "records" );
+    REPORTMETRIC( "scanned", (QWORD)crec * 1000000 / max( cusec, (QWORD)1 ), "records/sec" );
+
+    delete[] rglTagged;
+    delete[] rglFixed;
+
+    CHECKCALLS( JetCloseTable( sesid, tableid ) );
+    CHECKCALLS( db.ErrTerm() );
+}
+
+LOCAL ERR ErrRecTestISetEqualityRange(
+    const JET_SESID     sesid,
+    const JET_TABLEID   tableid,
+    const CHAR * const  szIndex,
+    const LONG          lValue )
+{
+    ERR err;
+
+    Call( JetSetCurrentIndexA( sesid, tableid, szIndex ) );
+    Call( JetMakeKey( sesid, tableid, &lValue, sizeof( lValue ), JET_bitNewKey ) );
+    Call( JetSeek( sesid, tableid, JET_bitSeekEQ ) );
+    Call( JetMakeKey( sesid, tableid, &lValue, sizeof( lValue ), JET_bitNewKey ) );
+    Call( JetSetIndexRange( sesid, tableid, JET_bitRangeUpperLimit | JET_bitRangeInclusive ) );
+
+HandleError:
+    return err;
+}
+
+JETUNITTEST( REC, IntersectIndexesMatchesPredicate )
+{
+    const LONG      crec            = 3000;
+    JetTestDatabase db;
+    JET_TABLEID     tableid         = JET_tableidNil;
+    JET_TABLEID     tableidFixed    = JET_tableidNil;
+    JET_TABLEID     tableidTagged   = JET_tableidNil;
+    JET_COLUMNID    columnidKey;
+    JET_COLUMNID    columnidFixed;
+    JET_COLUMNID    columnidTagged;
+    LONG*           rglFixed        = new LONG[ crec ];
+    LONG*           rglTagged       = new LONG[ crec ];
+
+    CHECK( NULL != rglFixed );
+    CHECK( NULL != rglTagged );
+
+    CHECKCALLS( db.ErrInit( L"RecIntersect" ) );
+    const JET_SESID sesid = db.Sesid();
+    CHECKCALLS( ErrRecTestIPopulate( sesid, db.Dbid(), &tableid, &columnidKey, &columnidFixed, &columnidTagged, rglFixed, rglTagged, crec ) );
+    CHECKCALLS( JetCreateIndexA( sesid, tableid, "Fixed", NO_GRBIT, "+Fixed\0", 8, 100 ) );
+    CHECKCALLS( JetCreateIndexA( sesid, tableid, "Tagged", NO_GRBIT, "+Tagged\0", 9, 100 ) );
+    CHECKCALLS( JetDupCursor( sesid, tableid, &tableidFixed, NO_GRBIT ) );
+    CHECKCALLS( JetDupCursor( sesid, tableid, &tableidTagged, NO_GRBIT ) );
+
+    for ( LONG lFixed = 0; lFixed < 100; lFixed += 33 )
+    {
+        JET_INDEXRANGE  rgindexrange[ 2 ];
+        JET_RECORDLIST  recordlist      = { sizeof( JET_RECORDLIST ) };
+        LONG            crecExpected    = 0;
+
+        CHECKCALLS( ErrRecTestISetEqualityRange( sesid, tableidFixed, "Fixed", lFixed ) );
+        CHECKCALLS( ErrRecTestISetEqualityRange( sesid, tableidTagged, "Tagged", 4 ) );
+
+        rgindexrange[ 0 ].cbStruct  = sizeof( JET_INDEXRANGE );
+        rgindexrange[ 0 ].tableid   = tableidFixed;
+        rgindexrange[ 0 ].grbit     = JET_bitRecordInIndex;
+        rgindexrange[ 1 ]           = rgindexrange[ 0 ];
+        rgindexrange[ 1 ].tableid   = tableidTagged;
+
+        CHECKCALLS( JetIntersectIndexes( sesid, rgindexrange, _countof( rgindexrange ), &recordlist, NO_GRBIT ) );
+
+        for ( LONG irec = 0; irec < crec; irec++ )
+        {
+            crecExpected += ( lFixed == rglFixed[ irec ] && 4 == rglTagged[ irec ] ) ? 1 : 0;
+        }
+        CHECK( crecExpected == (LONG)recordlist.cRecord );
+
+        if ( JET_tableidNil != recordlist.tableid )
+        {
+            for ( ERR err = JetMove( sesid, recordlist.tableid, JET_MoveFirst, NO_GRBIT );
+                JET_errSuccess == err;
+                err = JetMove( sesid, recordlist.tableid, JET_MoveNext, NO_GRBIT ) )
+            {
+                BYTE    rgbBookmark[ JET_cbBookmarkMost ];
+                ULONG   cbBookmark;
+                LONG    irec;
+                ULONG   cbActual;
+
+                CHECKCALLS( JetRetrieveColumn( sesid, recordlist.tableid, recordlist.columnidBookmark, rgbBookmark, sizeof( rgbBookmark ), &cbBookmark, NO_GRBIT, NULL ) );
+                CHECKCALLS( JetGotoBookmark( sesid, tableid, rgbBookmark, cbBookmark ) );
+                CHECKCALLS( JetRetrieveColumn( sesid, tableid, columnidKey, &irec, sizeof( irec ), &cbActual, NO_GRBIT, NULL ) );
+                CHECK( lFixed == rglFixed[ irec ] );
+                CHECK( 4 == rglTagged[ irec ] );
+            }
+            CHECKCALLS( JetCloseTable( sesid, recordlist.tableid ) );
+        }
+        else
+        {
+            CHECK( 0 == crecExpected );
+        }
+    }
+
+    delete[] rglTagged;
+    delete[] rglFixed;
+
+    CHECKCALLS( JetCloseTable( sesid, tableidTagged ) );
+    CHECKCALLS( JetCloseTable( sesid, tableidFixed ) );
+    CHECKCALLS( JetCloseTable( sesid, tableid ) );
+    CHECKCALLS( db.ErrTerm() );
+}
+
+LOCAL ERR ErrRecTestISetRange(
+    const JET_SESID     sesid,
+    const JET_TABLEID   tableid,
+    const CHAR * const  szIndex,
+    const LONG          lLow,
+    const LONG          lHigh )
+{
+    ERR err;
+
+    Call( JetSetCurrentIndexA( sesid, tableid, szIndex ) );
+    Call( JetMakeKey( sesid, tableid, &lLow, sizeof( lLow ), JET_bitNewKey ) );
+    Call( JetSeek( sesid, tableid, JET_bitSeekGE ) );
+    Call( JetMakeKey( sesid, tableid, &lHigh, sizeof( lHigh ), JET_bitNewKey ) );
+    Call( JetSetIndexRange( sesid, tableid, JET_bitRangeUpperLimit | JET_bitRangeInclusive ) );
+
+HandleError:
+    return err;
+}
+
+//  Intersects every non-NULL Fixed entry with every non-NULL Tagged entry under a hash
+//  budget of cbHashMost (0 for the default) and marks the records returned in rgfFound.
+
+LOCAL ERR ErrRecTestIIntersectAll(
+    const JET_SESID     sesid,
+    const JET_TABLEID   tableid,
+    const JET_TABLEID   tableidFixed,
+    const JET_TABLEID   tableidTagged,
+    const JET_COLUMNID  columnidKey,
+    const ULONG         cbHashMost,
+    BOOL * const        rgfFound,
+    const LONG          crec,
+    ULONG * const       pcRecord )
+{
+    ERR                 err;
+    JET_INDEXRANGE      rgindexrange[ 2 ];
+    JET_RECORDLIST      recordlist  = { sizeof( JET_RECORDLIST ) };
+
+    memset( rgfFound, 0, crec * sizeof( BOOL ) );
+    *pcRecord = 0;
+
+    Call( ErrRecTestISetRange( sesid, tableidFixed, "Fixed", 0, 99 ) );
+    Call( ErrRecTestISetRange( sesid, tableidTagged, "Tagged", 0, 6 ) );
+
+    rgindexrange[ 0 ].cbStruct  = sizeof( JET_INDEXRANGE );
+    rgindexrange[ 0 ].tableid   = tableidFixed;
+    rgindexrange[ 0 ].grbit     = JET_bitRecordInIndex;
+    rgindexrange[ 1 ]           = rgindexrange[ 0 ];
+    rgindexrange[ 1 ].tableid   = tableidTagged;
+
+    if ( 0 != cbHashMost )
+    {
+        Call( ErrEnableTestInjection( idRecTestIntersectHashMost, cbHashMost, JET_TestInjectConfigOverride, 100, JET_bitInjectionProbabilityPct ) );
+    }
+    err = JetIntersectIndexes( sesid, rgindexrange, _countof( rgindexrange ), &recordlist, NO_GRBIT );
+    CallS( ErrEnableTestInjection( idRecTestIntersectHashMost, 0, JET_TestInjectConfigOverride, 0, JET_bitInjectionProbabilityPct ) );
+    Call( err );
+
+    *pcRecord = recordlist.cRecord;
+
+    if ( JET_tableidNil != recordlist.tableid )
+    {
+        for ( err = JetMove( sesid, recordlist.tableid, JET_MoveFirst, NO_GRBIT );
+            JET_errSuccess == err;
+            err = JetMove( sesid, recordlist.tableid, JET_MoveNext, NO_GRBIT ) )
+        {
+            BYTE    rgbBookmark[ JET_cbBookmarkMost ];
+            ULONG   cbBookmark;
+            LONG    irec;
+
+            Call( JetRetrieveColumn( sesid, recordlist.tableid, recordlist.columnidBookmark, rgbBookmark, sizeof( rgbBookmark ), &cbBookmark, NO_GRBIT, NULL ) );
+            Call( JetGotoBookmark( sesid, tableid, rgbBookmark, cbBookmark ) );
+            Call( JetRetrieveColumn( sesid, tableid, columnidKey, &irec, sizeof( irec ), NULL, NO_GRBIT, NULL ) );
+            if ( irec < 0 || irec >= crec || rgfFound[ irec ] )
+            {
+                Error( ErrERRCheck( JET_errInvalidBookmark ) );
+            }
+            rgfFound[ irec ] = fTrue;
+        }
+        Call( JET_errNoCurrentRecord == err ? JET_errSuccess : err );
+    }
+
+HandleError:
+    if ( JET_tableidNil != recordlist.tableid )
+    {
+        (VOID)JetCloseTable( sesid, recordlist.tableid );
+    }
+    return err;
+}
+
+//  Both ranges hold ~2000 entries, several chunks each, so a budget of a few KB runs out
+//  after some bookmarks are already buffered and the rest of the read goes to the sort.
+
+JETUNITTEST( REC, IntersectIndexesHashOverBudgetMatchesSort )
+{
+    const LONG      crec            = 3000;
+    const ULONG     rgcbHashMost[]  = { 1, 12 * 1024 };
+    JetTestDatabase db;
+    JET_TABLEID     tableid         = JET_tableidNil;
+    JET_TABLEID     tableidFixed    = JET_tableidNil;
+    JET_TABLEID     tableidTagged   = JET_tableidNil;
+    JET_COLUMNID    columnidKey;
+    JET_COLUMNID    columnidFixed;
+    JET_COLUMNID    columnidTagged;
+    LONG*           rglFixed        = new LONG[ crec ];
+    LONG*           rglTagged       = new LONG[ crec ];
+    BOOL*           rgfHash         = new BOOL[ crec ];
+    BOOL*           rgfSort         = new BOOL[ crec ];
+    ULONG           cRecordHash;
+    ULONG           cRecordSort;
+    ULONG           crecExpected    = 0;
+
+    CHECK( NULL != rglFixed );
+    CHECK( NULL != rglTagged );
+    CHECK( NULL != rgfHash );
+    CHECK( NULL != rgfSort );
+
+    CHECKCALLS( db.ErrInit( L"RecIntersect" ) );
+    const JET_SESID sesid = db.Sesid();
+    CHECKCALLS( ErrRecTestIPopulate( sesid, db.Dbid(), &tableid, &columnidKey, &columnidFixed, &columnidTagged, rglFixed, rglTagged, crec ) );
+    CHECKCALLS( JetCreateIndexA( sesid, tableid, "Fixed", NO_GRBIT, "+Fixed\0", 8, 100 ) );
+    CHECKCALLS( JetCreateIndexA( sesid, tableid, "Tagged", NO_GRBIT, "+Tagged\0", 9, 100 ) );
+    CHECKCALLS( JetDupCursor( sesid, tableid, &tableidFixed, NO_GRBIT ) );
+    CHECKCALLS( JetDupCursor( sesid, tableid, &tableidTagged, NO_GRBIT ) );
+
+    for ( LONG irec = 0; irec < crec; irec++ )
+    {
+        crecExpected += ( lRecTestNull != rglFixed[ irec ] && lRecTestNull != rglTagged[ irec ] ) ? 1 : 0;
+    }
+
+    CHECKCALLS( ErrRecTestIIntersectAll( sesid, tableid, tableidFixed, tableidTagged, columnidKey, 0, rgfHash, crec, &cRecordHash ) );
+    CHECK( crecExpected == cRecordHash );
+    for ( LONG irec = 0; irec < crec; irec++ )
+    {
+        CHECK( rgfHash[ irec ] == ( lRecTestNull != rglFixed[ irec ] && lRecTestNull != rglTagged[ irec ] ) );
+    }
+
+    for ( ULONG icb = 0; icb < _countof( rgcbHashMost ); icb++ )
+    {
+        CHECKCALLS( ErrRecTestIIntersectAll( sesid, tableid, tableidFixed, tableidTagged, columnidKey, rgcbHashMost[ icb ], rgfSort, crec, &cRecordSort ) );
+        CHECK( cRecordHash == cRecordSort );
+        CHECK( 0 == memcmp( rgfHash, rgfSort, crec * sizeof( BOOL ) ) );
+    }
+
+    delete[] rgfSort;
+    delete[] rgfHash;
+    delete[] rglTagged;
+    delete[] rglFixed;
+
+    CHECKCALLS( JetCloseTable( sesid, tableidTagged ) );
+    CHECKCALLS( JetCloseTable( sesid, tableidFixed ) );
+    CHECKCALLS( JetCloseTable( sesid, tableid ) );
+    CHECKCALLS( db.ErrTerm() );
+}
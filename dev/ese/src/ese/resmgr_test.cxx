@@ -0,0 +1,149 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "std.hxx"
+
+#ifndef ENABLE_JET_UNIT_TEST
+#error This file should only be compiled with the unit tests!
+#endif
+
+struct RESLRUKTEST
+{
+    static SIZE_T OffsetOfLRUKTESTIC()  { return OffsetOf( RESLRUKTEST, lrukic ); }
+
+    IFMPPGNO                                                                                            ifmppgno;
+    CLRUKResourceUtilityManager< Kmax, RESLRUKTEST, OffsetOfLRUKTESTIC, IFMPPGNO >::CInvasiveContext   lrukic;
+};
+
+inline IFMPPGNO IfmppgnoRESLRUKTEST( const RESLRUKTEST* const pres )
+{
+    return pres->ifmppgno;
+}
+
+DECLARE_SHARDED_LRUK_RESOURCE_UTILITY_MANAGER( 4, Kmax, RESLRUKTEST, RESLRUKTEST::OffsetOfLRUKTESTIC, IFMPPGNO, IfmppgnoRESLRUKTEST, RESLRUKTESTLRUK );
+
+const INT cresLRUKTest = 64;
+
+template< class CLRUK >
+LOCAL BOOL FResMgrTestICacheResources( CLRUK* const plruk, RESLRUKTEST* const rgres, const DWORD* const rgdtick )
+{
+    const DWORD tickBase = TickRESMGRTimeCurrent() + 10000;
+
+    for ( INT ires = 0; ires < cresLRUKTest; ires++ )
+    {
+        rgres[ ires ].ifmppgno = IFMPPGNO( ires % 3, 1000 + ires * 7 );
+        if ( plruk->ErrCacheResource( rgres[ ires ].ifmppgno, &rgres[ ires ], tickBase + rgdtick[ ires ], 100, fFalse ) != CLRUK::ERR::errSuccess )
+        {
+            return fFalse;
+        }
+    }
+
+    return fTrue;
+}
+
+//  returns -1 if an eviction fails or more resources are found than were cached
+
+template< class CLRUK >
+LOCAL INT CResMgrTestIEvictAll( CLRUK* const plruk, RESLRUKTEST** const rgpresEvicted )
+{
+    typename CLRUK::CLock   lock;
+    RESLRUKTEST*            pres    = NULL;
+    INT                     cres    = 0;
+
+    plruk->BeginResourceScan( &lock );
+    while ( plruk->ErrGetNextResource( &lock, &pres ) == CLRUK::ERR::errSuccess )
+    {
+        if ( cres >= cresLRUKTest
+            || plruk->ErrEvictCurrentResource( &lock, pres->ifmppgno, fFalse ) != CLRUK::ERR::errSuccess )
+        {
+            cres = -1;
+            break;
+        }
+        rgpresEvicted[ cres++ ] = pres;
+    }
+    plruk->EndResourceScan( &lock );
+
+    return cres;
+}
+
+JETUNITTEST( ResMgr, ShardedLRUKEvictionOrderMatchesSingleInstance )
+{
+    RESLRUKTESTLRUKShard*   plrukSingle     = new RESLRUKTESTLRUKShard( 0 );
+    RESLRUKTESTLRUK*        plrukSharded    = new RESLRUKTESTLRUK( 0 );
+    RESLRUKTEST*            rgresSingle     = new RESLRUKTEST[ cresLRUKTest ];
+    RESLRUKTEST*            rgresSharded    = new RESLRUKTEST[ cresLRUKTest ];
+    RESLRUKTEST*            rgpresSingle[ cresLRUKTest ];
+    RESLRUKTEST*            rgpresSharded[ cresLRUKTest ];
+    DWORD                   rgdtick[ cresLRUKTest ];
+
+    CHECK( plrukSingle && plrukSharded && rgresSingle && rgresSharded );
+
+    CHECK( plrukSingle->ErrInit( 1, 0.128, 100.0, 1.0, 5.0, 1.0, 1.0 ) == RESLRUKTESTLRUKShard::ERR::errSuccess );
+    CHECK( plrukSharded->ErrInit( 1, 0.128, 100.0, 1.0, 5.0, 1.0, 1.0, 4 ) == RESLRUKTESTLRUK::ERR::errSuccess );
+    CHECK( plrukSharded->CShards() == 4 );
+
+    for ( INT ires = 0; ires < cresLRUKTest; ires++ )
+    {
+        rgdtick[ ires ] = 4000 * ( ( ires * 37 ) % cresLRUKTest );
+    }
+
+    CHECK( FResMgrTestICacheResources( plrukSingle, rgresSingle, rgdtick ) );
+    CHECK( FResMgrTestICacheResources( plrukSharded, rgresSharded, rgdtick ) );
+
+    CHECK( CResMgrTestIEvictAll( plrukSingle, rgpresSingle ) == cresLRUKTest );
+    CHECK( CResMgrTestIEvictAll( plrukSharded, rgpresSharded ) == cresLRUKTest );
+
+    for ( INT ires = 0; ires < cresLRUKTest; ires++ )
+    {
+        CHECK( rgpresSingle[ ires ]->ifmppgno == rgpresSharded[ ires ]->ifmppgno );
+    }
+
+    plrukSharded->Term();
+    plrukSingle->Term();
+
+    delete[] rgresSharded;
+    delete[] rgresSingle;
+    delete plrukSharded;
+    delete plrukSingle;
+}
+
+JETUNITTEST( ResMgr, ShardedLRUKEvictsEveryResourceApproximatelyInOrder )
+{
+    RESLRUKTESTLRUK*    plruk   = new RESLRUKTESTLRUK( 0 );
+    RESLRUKTEST*        rgres   = new RESLRUKTEST[ cresLRUKTest ];
+    RESLRUKTEST*        rgpres[ cresLRUKTest ];
+    DWORD               rgdtick[ cresLRUKTest ];
+    BOOL                rgfSeen[ cresLRUKTest ] = { fFalse };
+
+    CHECK( plruk && rgres );
+
+    CHECK( plruk->ErrInit( 1, 0.128, 100.0, 1.0, 5.0, 1.0, 1.0, 4 ) == RESLRUKTESTLRUK::ERR::errSuccess );
+
+    for ( INT ires = 0; ires < cresLRUKTest; ires++ )
+    {
+        rgdtick[ ires ] = rand() % 60000;
+    }
+
+    CHECK( FResMgrTestICacheResources( plruk, rgres, rgdtick ) );
+
+    CHECK( CResMgrTestIEvictAll( plruk, rgpres ) == cresLRUKTest );
+
+    for ( INT ires = 0; ires < cresLRUKTest; ires++ )
+    {
+        const INT iresEvicted = INT( rgpres[ ires ] - rgres );
+        CHECK( iresEvicted >= 0 && iresEvicted < cresLRUKTest );
+        CHECK( !rgfSeen[ iresEvicted ] );
+        rgfSeen[ iresEvicted ] = fTrue;
+
+        if ( ires > 0 )
+        {
+            const INT iresPrev = INT( rgpres[ ires - 1 ] - rgres );
+            CHECK( LONG( rgdtick[ iresEvicted ] - rgdtick[ iresPrev ] ) > -4 * 1024 );
+        }
+    }
+
+    plruk->Term();
+
+    delete[] rgres;
+    delete plruk;
+}
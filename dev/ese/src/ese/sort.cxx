@@ -4,6 +4,13 @@
 #include "std.hxx"
 
 
+INLINE LONG CSORTIParallelWorker( const SCB * const pscb )
+{
+    const LONG cworker = PinstFromIfmp( pscb->fcb.Ifmp() )->m_cSORTParallelWorker;
+    Assert( cworker >= 1 && cworker <= cmergeParallelMax );
+    return cworker;
+}
+
 INLINE VOID SrecToKeydataflags( const SREC * psrec, FUCB * pfucb );
 LOCAL LONG IspairSORTISeekByKey(
     const BYTE * const rgbRec,
@@ -24,28 +31,37 @@ INLINE VOID SWAPPsrec( SREC **ppsrec1, SREC **ppsrec2 );
 INLINE VOID SWAPPmtnode( MTNODE **ppmtnode1, MTNODE **ppmtnode2 );
 LOCAL VOID SORTIInsertionSort( SCB *pscb, SPAIR *pspairMinIn, SPAIR *pspairMaxIn );
 LOCAL VOID SORTIQuicksort( SCB * pscb, SPAIR *pspairMinIn, SPAIR *pspairMaxIn );
-LOCAL ERR ErrSORTIRunStart( SCB *pscb, QWORD cb, RUNINFO *pruninfo );
-LOCAL ERR ErrSORTIRunInsert( SCB *pscb, RUNINFO* pruninfo, SREC *psrec );
-INLINE VOID SORTIRunEnd( SCB * pscb, RUNINFO* pruninfo );
+LOCAL SPAIR * PspairSORTIPartition( SCB * pscb, SPAIR *pspairMin, SPAIR *pspairMax );
+LOCAL VOID SORTIParallelQuicksort( SCB * pscb, SPAIR *pspairMinIn, SPAIR *pspairMaxIn );
+LOCAL ERR ErrSORTIRunStart( MCB *pmcb, QWORD cb, RUNINFO *pruninfo );
+LOCAL ERR ErrSORTIRunInsert( MCB *pmcb, RUNINFO* pruninfo, SREC *psrec );
+INLINE VOID SORTIRunFlush( MCB * pmcb, RUNINFO* pruninfo );
+INLINE VOID SORTIRunTrim( SCB * pscb, RUNINFO* pruninfo );
+INLINE VOID SORTIRunEnd( MCB * pmcb, RUNINFO* pruninfo );
 INLINE VOID SORTIRunDelete( SCB * pscb, const RUNINFO * pruninfo );
 LOCAL VOID  SORTIRunDeleteList( SCB *pscb, RUNLINK **pprunlink, LONG crun );
 LOCAL VOID  SORTIRunDeleteListMem( SCB *pscb, RUNLINK **pprunlink, LONG crun );
-LOCAL ERR ErrSORTIRunOpen( SCB *pscb, RUNINFO *pruninfo, RCB **pprcb );
+LOCAL ERR ErrSORTIRunOpen( MCB *pmcb, RUNINFO *pruninfo, RCB **pprcb );
 LOCAL ERR ErrSORTIRunNext( RCB * prcb, SREC **ppsrec );
 LOCAL VOID SORTIRunClose( RCB *prcb );
 INLINE ERR ErrSORTIRunReadPage( RCB *prcb, PGNO pgno, LONG ipbf );
-LOCAL ERR ErrSORTIMergeToRun( SCB *pscb, RUNLINK *prunlinkSrc, RUNLINK **pprunlinkDest );
-LOCAL ERR ErrSORTIMergeStart( SCB *pscb, RUNLINK *prunlinkSrc );
-LOCAL ERR ErrSORTIMergeFirst( SCB *pscb, SREC **ppsrec );
-LOCAL ERR ErrSORTIMergeNext( SCB *pscb, SREC **ppsrec );
-LOCAL VOID SORTIMergeEnd( SCB *pscb );
-LOCAL ERR ErrSORTIMergeNextChamp( SCB *pscb, SREC **ppsrec );
+LOCAL ERR ErrSORTIMergeToRun( MCB *pmcb, RUNLINK *prunlinkSrc, RUNLINK **pprunlinkDest );
+LOCAL ERR ErrSORTIMergeToRunStart( MCB *pmcb, RUNLINK *prunlinkSrc, RUNLINK **pprunlink );
+LOCAL ERR ErrSORTIMergeToRunCopy( MCB *pmcb, RUNLINK *prunlink );
+LOCAL ERR ErrSORTIMergeToRunEnd( MCB *pmcb, const ERR errCopy, RUNLINK *prunlink, RUNLINK **pprunlinkDest );
+LOCAL ERR ErrSORTIMergeStart( MCB *pmcb, RUNLINK *prunlinkSrc );
+LOCAL ERR ErrSORTIMergeFirst( MCB *pmcb, SREC **ppsrec );
+LOCAL ERR ErrSORTIMergeNext( MCB *pmcb, SREC **ppsrec );
+LOCAL VOID SORTIMergeEnd( MCB *pmcb );
+LOCAL ERR ErrSORTIMergeNextChamp( MCB *pmcb, SREC **ppsrec );
 INLINE VOID SORTIOptTreeInit( SCB *pscb );
 LOCAL ERR ErrSORTIOptTreeAddRun( SCB *pscb, RUNINFO *pruninfo );
 LOCAL ERR ErrSORTIOptTreeMerge( SCB *pscb );
 INLINE VOID SORTIOptTreeTerm( SCB *pscb );
 LOCAL ERR ErrSORTIOptTreeBuild( SCB *pscb, OTNODE **ppotnode );
 LOCAL ERR ErrSORTIOptTreeMergeDF( SCB *pscb, OTNODE *potnode, RUNLINK **pprunlink );
+LOCAL VOID SORTIOptTreeBindRuns( SCB *pscb, OTNODE *potnode );
+LOCAL ERR ErrSORTIOptTreeMergeParallel( SCB *pscb, OTNODE *potnode );
 LOCAL VOID SORTIOptTreeFree( SCB *pscb, OTNODE *potnode );
 
 INLINE VOID SrecToKeydataflags( const SREC * psrec, FUCB * pfucb )
@@ -182,7 +198,7 @@ ERR ErrSORTInsert( FUCB *pfucb, const KEY& key, const DATA& data )
             pscb->crecBuf == cspairSortMax )
     {
 
-        SORTIQuicksort( pscb, pscb->rgspair, pscb->rgspair + pscb->ispairMac );
+        SORTIParallelQuicksort( pscb, pscb->rgspair, pscb->rgspair + pscb->ispairMac );
 
 
         Call( ErrSORTIOutputRun( pscb ) );
@@ -263,7 +279,7 @@ ERR ErrSORTEndInsert( FUCB *pfucb )
         return JET_errSuccess;
 
 
-    SORTIQuicksort( pscb, pscb->rgspair, pscb->rgspair + pscb->ispairMac );
+    SORTIParallelQuicksort( pscb, pscb->rgspair, pscb->rgspair + pscb->ispairMac );
 
 
     if ( pscb->crun )
@@ -281,7 +297,7 @@ ERR ErrSORTEndInsert( FUCB *pfucb )
         Call( ErrSORTIOptTreeMerge( pscb ) );
 
 
-        Call( ErrSORTIMergeStart( pscb, pscb->runlist.prunlinkHead ) );
+        Call( ErrSORTIMergeStart( &pscb->mcb, pscb->runlist.prunlinkHead ) );
     }
 
 
@@ -329,7 +345,7 @@ ERR ErrSORTFirst( FUCB * pfucb )
 
     if ( pscb->crun )
     {
-        CallR( ErrSORTIMergeFirst( pscb, &psrec ) );
+        CallR( ErrSORTIMergeFirst( &pscb->mcb, &psrec ) );
     }
 
 
@@ -372,14 +388,14 @@ ERR ErrSORTLast( FUCB *pfucb )
 
     if ( pscb->crun )
     {
-        err = ErrSORTIMergeNext( pscb, &psrec );
+        err = ErrSORTIMergeNext( &pscb->mcb, &psrec );
         while ( err >= 0 )
         {
             CallS( err );
 
             SrecToKeydataflags( psrec, pfucb );
 
-            err = ErrSORTIMergeNext( pscb, &psrec );
+            err = ErrSORTIMergeNext( &pscb->mcb, &psrec );
         }
 
         if ( JET_errNoCurrentRecord == err )
@@ -419,7 +435,7 @@ ERR ErrSORTNext( FUCB *pfucb )
 
     if ( pscb->crun )
     {
-        Call( ErrSORTIMergeNext( pscb, &psrec ) );
+        Call( ErrSORTIMergeNext( &pscb->mcb, &psrec ) );
     }
     else
     {
@@ -570,18 +586,18 @@ VOID SORTICloseRun( PIB * const ppib, SCB * const pscb )
     Assert( !pscb->fcb.FInList() );
 
     
-    if ( pscb->crunMerge )
-        SORTIMergeEnd( pscb );
+    if ( pscb->mcb.crunMerge )
+        SORTIMergeEnd( &pscb->mcb );
 
     
     SORTIOptTreeTerm( pscb );
 
     
-    if ( pscb->bflOut.pv != NULL )
+    if ( pscb->mcb.bflOut.pv != NULL )
     {
-        BFWriteUnlatch( &pscb->bflOut );
-        pscb->bflOut.pv         = NULL;
-        pscb->bflOut.dwContext  = NULL;
+        BFWriteUnlatch( &pscb->mcb.bflOut );
+        pscb->mcb.bflOut.pv         = NULL;
+        pscb->mcb.bflOut.dwContext  = NULL;
     }
 
     Assert( pscb->fcb.PrceOldest() == prceNil );
@@ -882,13 +898,13 @@ LOCAL ERR ErrSORTIOutputRun( SCB * pscb )
 
         SORTIOptTreeInit( pscb );
 
-        pscb->bflOut.pv         = NULL;
-        pscb->bflOut.dwContext  = NULL;
+        pscb->mcb.bflOut.pv         = NULL;
+        pscb->mcb.bflOut.dwContext  = NULL;
 
-        pscb->crunMerge = 0;
+        pscb->mcb.crunMerge = 0;
     }
 
-    CallR( ErrSORTIRunStart( pscb, QWORD( pscb->cbData ), &runinfo ) );
+    CallR( ErrSORTIRunStart( &pscb->mcb, QWORD( pscb->cbData ), &runinfo ) );
 
     for ( ispair = 0; ispair < pscb->ispairMac; ispair++ )
     {
@@ -900,11 +916,11 @@ LOCAL ERR ErrSORTIOutputRun( SCB * pscb )
         if (    !psrecLast ||
                 !FSORTIDuplicate( pscb, psrec, psrecLast ) )
         {
-            CallJ( ErrSORTIRunInsert( pscb, &runinfo, psrec ), EndRun );
+            CallJ( ErrSORTIRunInsert( &pscb->mcb, &runinfo, psrec ), EndRun );
         }
     }
 
-    SORTIRunEnd( pscb, &runinfo );
+    SORTIRunEnd( &pscb->mcb, &runinfo );
     CallJ( ErrSORTIOptTreeAddRun( pscb, &runinfo ), DeleteRun );
 
     pscb->ispairMac = 0;
@@ -915,7 +931,7 @@ LOCAL ERR ErrSORTIOutputRun( SCB * pscb )
     return JET_errSuccess;
 
 EndRun:
-    SORTIRunEnd( pscb, &runinfo );
+    SORTIRunEnd( &pscb->mcb, &runinfo );
 DeleteRun:
     SORTIRunDelete( pscb, &runinfo );
     return err;
@@ -1108,7 +1124,8 @@ LOCAL VOID SORTIInsertionSort( SCB *pscb, SPAIR *pspairMinIn, SPAIR *pspairMaxIn
 {
     SPAIR   *pspairLast;
     SPAIR   *pspairFirst;
-    SPAIR   *pspairKey = pscb->rgspair + cspairSortMax;
+    SPAIR   spairKey;
+    SPAIR   *pspairKey = &spairKey;
 
 
     for (   pspairFirst = pspairMinIn, pspairLast = pspairMinIn + 1;
@@ -1134,6 +1151,62 @@ LOCAL VOID SORTIInsertionSort( SCB *pscb, SPAIR *pspairMinIn, SPAIR *pspairMaxIn
 
 
 
+LOCAL SPAIR * PspairSORTIPartition( SCB * pscb, SPAIR *pspairMin, SPAIR *pspairMax )
+{
+    SPAIR   *pspairFirst;
+    SPAIR   *pspairLast;
+
+    Assert( pspairMax - pspairMin >= cspairQSortMin );
+
+
+    pspairFirst = pspairMin + ( ( pspairMax - pspairMin ) >> 1 );
+    pspairLast  = pspairMax - 1;
+
+    if ( ISORTICmpPspairPspair( pscb, pspairFirst, pspairMin ) > 0 )
+        SWAPSpair( pspairFirst, pspairMin );
+    if ( ISORTICmpPspairPspair( pscb, pspairFirst, pspairLast ) > 0 )
+        SWAPSpair( pspairFirst, pspairLast );
+    if ( ISORTICmpPspairPspair( pscb, pspairMin, pspairLast ) > 0 )
+        SWAPSpair( pspairMin, pspairLast );
+
+
+    pspairFirst = pspairMin + 1;
+    pspairLast--;
+
+    Assert( pspairFirst <= pspairLast );
+
+    forever
+    {
+
+        while ( pspairFirst <= pspairLast &&
+                ISORTICmpPspairPspair( pscb, pspairFirst, pspairMin ) <= 0 )
+            pspairFirst++;
+
+
+        while ( pspairFirst <= pspairLast &&
+                ISORTICmpPspairPspair( pscb, pspairLast, pspairMin ) > 0 )
+            pspairLast--;
+
+
+        Assert( pspairFirst != pspairLast );
+
+        if ( pspairFirst < pspairLast )
+            SWAPSpair( pspairFirst++, pspairLast-- );
+
+
+        else
+            break;
+    }
+
+
+    if ( pspairLast != pspairMin )
+        SWAPSpair( pspairMin, pspairLast );
+
+    return pspairLast;
+}
+
+
+
 LOCAL VOID SORTIQuicksort( SCB * pscb, SPAIR *pspairMinIn, SPAIR *pspairMaxIn )
 {
     struct _part
@@ -1145,6 +1218,7 @@ LOCAL VOID SORTIQuicksort( SCB * pscb, SPAIR *pspairMinIn, SPAIR *pspairMaxIn )
 
     SPAIR   *pspairFirst;
     SPAIR   *pspairLast;
+    SPAIR   *pspairPivot;
 
 
     SPAIR   *pspairMin  = pspairMinIn;
@@ -1169,76 +1243,123 @@ LOCAL VOID SORTIQuicksort( SCB * pscb, SPAIR *pspairMinIn, SPAIR *pspairMaxIn )
         }
 
 
-        pspairFirst = pspairMin + ( ( pspairMax - pspairMin ) >> 1 );
-        pspairLast  = pspairMax - 1;
-
-        if ( ISORTICmpPspairPspair( pscb, pspairFirst, pspairMin ) > 0 )
-            SWAPSpair( pspairFirst, pspairMin );
-        if ( ISORTICmpPspairPspair( pscb, pspairFirst, pspairLast ) > 0 )
-            SWAPSpair( pspairFirst, pspairLast );
-        if ( ISORTICmpPspairPspair( pscb, pspairMin, pspairLast ) > 0 )
-            SWAPSpair( pspairMin, pspairLast );
+        pspairPivot = PspairSORTIPartition( pscb, pspairMin, pspairMax );
 
 
-        pspairFirst = pspairMin + 1;
-        pspairLast--;
+        if ( pspairMax - pspairPivot - 1 > pspairPivot - pspairMin )
+        {
+            pspairFirst = pspairPivot + 1;
+            pspairLast  = pspairMax;
+            pspairMax   = pspairPivot;
+        }
+        else
+        {
+            pspairFirst = pspairMin;
+            pspairLast  = pspairPivot;
+            pspairMin   = pspairPivot + 1;
+        }
 
-        Assert( pspairFirst <= pspairLast );
 
-        forever
+        if ( cpart < cpartQSortMax )
         {
+            rgpart[cpart].pspairMin     = pspairFirst;
+            rgpart[cpart++].pspairMax   = pspairLast;
+        }
+        else
+            SORTIQuicksort( pscb, pspairFirst, pspairLast );
+    }
+}
 
-            while ( pspairFirst <= pspairLast &&
-                    ISORTICmpPspairPspair( pscb, pspairFirst, pspairMin ) <= 0 )
-                pspairFirst++;
 
 
-            while ( pspairFirst <= pspairLast &&
-                    ISORTICmpPspairPspair( pscb, pspairLast, pspairMin ) > 0 )
-                pspairLast--;
+LOCAL VOID SORTIParallelWorker( VOID * const pvWorker, const BOOL fEnter )
+{
+    const PIB * const ppib = (const PIB *)pvWorker;
+    if ( fEnter )
+    {
+        ppib->SetUserTraceContextInTls();
+    }
+    else
+    {
+        ppib->ClearUserTraceContextInTls();
+    }
+}
 
+LOCAL VOID SORTIDispatchJobs( SCB * const pscb, const PFNTMJOB pfnJob, VOID * const pvContext, const LONG cjob )
+{
+    TMRunJobs(  &PinstFromIfmp( pscb->fcb.Ifmp() )->Taskmgr(),
+                CSORTIParallelWorker( pscb ),
+                pfnJob,
+                pvContext,
+                cjob,
+                SORTIParallelWorker,
+                pscb->fcb.Pfucb()->ppib );
+}
 
-            Assert( pspairFirst != pspairLast );
 
-            if ( pspairFirst < pspairLast )
-                SWAPSpair( pspairFirst++, pspairLast-- );
+struct SORTPART
+{
+    SCB     *pscb;
+    SPAIR   *pspairMin;
+    SPAIR   *pspairMax;
+};
 
+LOCAL VOID SORTIQuicksortPart( VOID * const pvContext, const LONG ipart )
+{
+    SORTPART * const ppart = (SORTPART *)pvContext + ipart;
+    SORTIQuicksort( ppart->pscb, ppart->pspairMin, ppart->pspairMax );
+}
 
-            else
-                break;
-        }
+LOCAL VOID SORTIParallelQuicksort( SCB * pscb, SPAIR *pspairMinIn, SPAIR *pspairMaxIn )
+{
+    SORTPART    rgpart[cmergeParallelMax];
+    LONG        cpart   = 0;
 
 
-        if ( pspairLast != pspairMin )
-            SWAPSpair( pspairMin, pspairLast );
+    if (    CSORTIParallelWorker( pscb ) <= 1 ||
+            pspairMaxIn - pspairMinIn < cspairSortParallelMin )
+    {
+        SORTIQuicksort( pscb, pspairMinIn, pspairMaxIn );
+        return;
+    }
 
 
-        if ( pspairMax - pspairLast - 1 > pspairLast - pspairMin )
-        {
-            pspairFirst = pspairLast + 1;
-            SWAPPspair( &pspairLast, &pspairMax );
-        }
-        else
+    rgpart[cpart].pscb          = pscb;
+    rgpart[cpart].pspairMin     = pspairMinIn;
+    rgpart[cpart++].pspairMax   = pspairMaxIn;
+
+    while ( cpart < CSORTIParallelWorker( pscb ) )
+    {
+        LONG ipartSplit = 0;
+        for ( LONG ipart = 1; ipart < cpart; ipart++ )
         {
-            pspairFirst = pspairMin;
-            pspairMin   = pspairLast + 1;
+            if (    rgpart[ipart].pspairMax - rgpart[ipart].pspairMin >
+                    rgpart[ipartSplit].pspairMax - rgpart[ipartSplit].pspairMin )
+            {
+                ipartSplit = ipart;
+            }
         }
 
+        if ( rgpart[ipartSplit].pspairMax - rgpart[ipartSplit].pspairMin < cspairSortParallelMin / 2 )
+            break;
 
-        if ( cpart < cpartQSortMax )
-        {
-            rgpart[cpart].pspairMin     = pspairFirst;
-            rgpart[cpart++].pspairMax   = pspairLast;
-        }
-        else
-            SORTIQuicksort( pscb, pspairFirst, pspairLast );
+        SPAIR * const pspairPivot = PspairSORTIPartition( pscb, rgpart[ipartSplit].pspairMin, rgpart[ipartSplit].pspairMax );
+
+        rgpart[cpart].pscb          = pscb;
+        rgpart[cpart].pspairMin     = pspairPivot + 1;
+        rgpart[cpart++].pspairMax   = rgpart[ipartSplit].pspairMax;
+        rgpart[ipartSplit].pspairMax = pspairPivot;
     }
+
+
+    SORTIDispatchJobs( pscb, SORTIQuicksortPart, rgpart, cpart );
 }
 
 
-LOCAL ERR ErrSORTIRunStart( SCB *pscb, QWORD cb, RUNINFO *pruninfo )
+LOCAL ERR ErrSORTIRunStart( MCB *pmcb, QWORD cb, RUNINFO *pruninfo )
 {
     ERR             err;
+    SCB * const     pscb        = pmcb->pscb;
     const QWORD     cpgAlloc    = ( cb + cbFreeSPAGE - 1 ) / cbFreeSPAGE;
 
     if ( cpgAlloc > lMax )
@@ -1262,18 +1383,18 @@ LOCAL ERR ErrSORTIRunStart( SCB *pscb, QWORD cb, RUNINFO *pruninfo )
     Assert( pruninfo->cpg >= pruninfo->cpgUsed );
 
 
-    pscb->pgnoNext          = pruninfo->run;
-    pscb->bflOut.pv         = NULL;
-    pscb->bflOut.dwContext  = NULL;
-    pscb->pbOutMac          = NULL;
-    pscb->pbOutMax          = NULL;
+    pmcb->pgnoNext          = pruninfo->run;
+    pmcb->bflOut.pv         = NULL;
+    pmcb->bflOut.dwContext  = NULL;
+    pmcb->pbOutMac          = NULL;
+    pmcb->pbOutMax          = NULL;
 
     return JET_errSuccess;
 }
 
 
 
-LOCAL ERR ErrSORTIRunInsert( SCB *pscb, RUNINFO* pruninfo, SREC *psrec )
+LOCAL ERR ErrSORTIRunInsert( MCB *pmcb, RUNINFO* pruninfo, SREC *psrec )
 {
     ERR         err;
     ULONG       cb;
@@ -1286,56 +1407,56 @@ LOCAL ERR ErrSORTIRunInsert( SCB *pscb, RUNINFO* pruninfo, SREC *psrec )
             (SIZE_T)CbSRECSizePsrec( psrec ) < cbFreeSPAGE );
 
 
-    cb = (ULONG)min(pscb->pbOutMax - pscb->pbOutMac, (LONG)CbSRECSizePsrec( psrec ) );
+    cb = (ULONG)min(pmcb->pbOutMax - pmcb->pbOutMac, (LONG)CbSRECSizePsrec( psrec ) );
 
 
     if ( cb )
     {
-        UtilMemCpy( pscb->pbOutMac, psrec, cb );
-        pscb->pbOutMac += cb;
+        UtilMemCpy( pmcb->pbOutMac, psrec, cb );
+        pmcb->pbOutMac += cb;
     }
 
 
     if ( cb < (ULONG) CbSRECSizePsrec( psrec ) )
     {
 
-        if ( pscb->bflOut.pv != NULL )
+        if ( pmcb->bflOut.pv != NULL )
         {
-            BFWriteUnlatch( &pscb->bflOut );
-            pscb->bflOut.pv         = NULL;
-            pscb->bflOut.dwContext  = NULL;
+            BFWriteUnlatch( &pmcb->bflOut );
+            pmcb->bflOut.pv         = NULL;
+            pmcb->bflOut.dwContext  = NULL;
         }
 
-        FUCB* pFucb = pscb->fcb.Pfucb( );
+        FUCB* pFucb = pmcb->pscb->fcb.Pfucb( );
 
         PIBTraceContextScope tcRef = pFucb->ppib->InitTraceContextScope();
         tcRef->nParentObjectClass = tceNone;
         tcRef->iorReason.SetIort( iortSort );
 
 
-        pgnoNext = pscb->pgnoNext++;
+        pgnoNext = pmcb->pgnoNext++;
 
-        CallR( ErrBFWriteLatchPage( &pscb->bflOut,
+        CallR( ErrBFWriteLatchPage( &pmcb->bflOut,
                                     pFucb->ifmp,
                                     pgnoNext,
                                     bflfNew,
                                     pFucb->ppib->BfpriPriority( pFucb->ifmp ),
                                     *tcRef ) );
-        BFDirty( &pscb->bflOut, bfdfDirty, *tcRef );
+        BFDirty( &pmcb->bflOut, bfdfDirty, *tcRef );
 
 
-        pspage = (SPAGE_FIX *) pscb->bflOut.pv;
+        pspage = (SPAGE_FIX *) pmcb->bflOut.pv;
 
         pspage->pgnoThisPage = pgnoNext;
 
 
-        pscb->pbOutMac = PbDataStartPspage( pspage );
-        pscb->pbOutMax = PbDataEndPspage( pspage );
+        pmcb->pbOutMac = PbDataStartPspage( pspage );
+        pmcb->pbOutMax = PbDataEndPspage( pspage );
 
 
         cbToWrite = CbSRECSizePsrec( psrec ) - cb;
-        UtilMemCpy( pscb->pbOutMac, ( (BYTE *) psrec ) + cb, cbToWrite );
-        pscb->pbOutMac += cbToWrite;
+        UtilMemCpy( pmcb->pbOutMac, ( (BYTE *) psrec ) + cb, cbToWrite );
+        pmcb->pbOutMac += cbToWrite;
     }
 
 
@@ -1346,18 +1467,24 @@ LOCAL ERR ErrSORTIRunInsert( SCB *pscb, RUNINFO* pruninfo, SREC *psrec )
 
 
 
-INLINE VOID SORTIRunEnd( SCB * pscb, RUNINFO* pruninfo )
+INLINE VOID SORTIRunFlush( MCB * pmcb, RUNINFO* pruninfo )
 {
 
-    if ( pscb->bflOut.pv != NULL )
+    if ( pmcb->bflOut.pv != NULL )
     {
-        BFWriteUnlatch( &pscb->bflOut );
-        pscb->bflOut.pv         = NULL;
-        pscb->bflOut.dwContext  = NULL;
+        BFWriteUnlatch( &pmcb->bflOut );
+        pmcb->bflOut.pv         = NULL;
+        pmcb->bflOut.dwContext  = NULL;
     }
 
 
     pruninfo->cpgUsed = CPG( ( pruninfo->cbRun + cbFreeSPAGE - 1 ) / cbFreeSPAGE );
+}
+
+
+
+INLINE VOID SORTIRunTrim( SCB * pscb, RUNINFO* pruninfo )
+{
 
     if ( pruninfo->cpg - pruninfo->cpgUsed > 0 )
     {
@@ -1382,6 +1509,14 @@ INLINE VOID SORTIRunEnd( SCB * pscb, RUNINFO* pruninfo )
 
 
 
+INLINE VOID SORTIRunEnd( MCB * pmcb, RUNINFO* pruninfo )
+{
+    SORTIRunFlush( pmcb, pruninfo );
+    SORTIRunTrim( pmcb->pscb, pruninfo );
+}
+
+
+
 INLINE VOID SORTIRunDelete( SCB * pscb, const RUNINFO * pruninfo )
 {
 
@@ -1445,7 +1580,7 @@ LOCAL VOID  SORTIRunDeleteListMem( SCB *pscb, RUNLINK **pprunlink, LONG crun )
 
 
 
-LOCAL ERR ErrSORTIRunOpen( SCB *pscb, RUNINFO *pruninfo, RCB **pprcb )
+LOCAL ERR ErrSORTIRunOpen( MCB *pmcb, RUNINFO *pruninfo, RCB **pprcb )
 {
     ERR     err;
     RCB     *prcb   = prcbNil;
@@ -1456,7 +1591,7 @@ LOCAL ERR ErrSORTIRunOpen( SCB *pscb, RUNINFO *pruninfo, RCB **pprcb )
     Alloc( prcb = PrcbRCBAlloc() );
 
 
-    prcb->pscb = pscb;
+    prcb->pmcb = pmcb;
     prcb->runinfo = *pruninfo;
 
     for ( ipbf = 0; ipbf < cpgClusterSize; ipbf++ )
@@ -1477,7 +1612,7 @@ LOCAL ERR ErrSORTIRunOpen( SCB *pscb, RUNINFO *pruninfo, RCB **pprcb )
     {
         TraceContextScope tc( iortSort );
         tc->nParentObjectClass = tceNone;
-        FUCB * pfucbT = pscb->fcb.Pfucb();
+        FUCB * pfucbT = pmcb->pscb->fcb.Pfucb();
 
         BFPrereadPageRange( pfucbT->ifmp,
             (PGNO)prcb->runinfo.run,
@@ -1501,7 +1636,7 @@ HandleError:
 LOCAL ERR ErrSORTIRunNext( RCB * prcb, SREC **ppsrec )
 {
     ERR     err;
-    SCB     *pscb = prcb->pscb;
+    MCB     *pmcb = prcb->pmcb;
     SIZE_T  cbUnread;
     SHORT   cbRec;
     SPAGE_FIX   *pspage;
@@ -1511,21 +1646,21 @@ LOCAL ERR ErrSORTIRunNext( RCB * prcb, SREC **ppsrec )
     SIZE_T  cbToRead;
 
 
-    if ( pscb->pvAssyLast != NULL )
+    if ( pmcb->pvAssyLast != NULL )
     {
-        BFFree( pscb->pvAssyLast );
+        BFFree( pmcb->pvAssyLast );
     }
-    pscb->pvAssyLast = prcb->pvAssy;
+    pmcb->pvAssyLast = prcb->pvAssy;
     prcb->pvAssy = NULL;
 
 
-    if ( pscb->bflLast.pv != NULL )
+    if ( pmcb->bflLast.pv != NULL )
     {
         CLockDeadlockDetectionInfo::DisableOwnershipTracking();
-        BFRenouncePage( &pscb->bflLast, fTrue );
+        BFRenouncePage( &pmcb->bflLast, fTrue );
         CLockDeadlockDetectionInfo::EnableOwnershipTracking();
-        pscb->bflLast.pv        = NULL;
-        pscb->bflLast.dwContext = NULL;
+        pmcb->bflLast.pv        = NULL;
+        pmcb->bflLast.dwContext = NULL;
     }
 
 
@@ -1534,8 +1669,8 @@ LOCAL ERR ErrSORTIRunNext( RCB * prcb, SREC **ppsrec )
 
         if ( prcb->rgbfl[prcb->ipbf].pv != NULL )
         {
-            pscb->bflLast.pv        = prcb->rgbfl[prcb->ipbf].pv;
-            pscb->bflLast.dwContext = prcb->rgbfl[prcb->ipbf].dwContext;
+            pmcb->bflLast.pv        = prcb->rgbfl[prcb->ipbf].pv;
+            pmcb->bflLast.dwContext = prcb->rgbfl[prcb->ipbf].dwContext;
             prcb->rgbfl[prcb->ipbf].pv          = NULL;
             prcb->rgbfl[prcb->ipbf].dwContext   = NULL;
         }
@@ -1576,8 +1711,8 @@ LOCAL ERR ErrSORTIRunNext( RCB * prcb, SREC **ppsrec )
         pgnoNext = ( ( SPAGE_FIX * )prcb->rgbfl[prcb->ipbf].pv )->pgnoThisPage + 1;
 
 
-        pscb->bflLast.pv        = prcb->rgbfl[prcb->ipbf].pv;
-        pscb->bflLast.dwContext = prcb->rgbfl[prcb->ipbf].dwContext;
+        pmcb->bflLast.pv        = prcb->rgbfl[prcb->ipbf].pv;
+        pmcb->bflLast.dwContext = prcb->rgbfl[prcb->ipbf].dwContext;
         prcb->rgbfl[prcb->ipbf].pv          = NULL;
         prcb->rgbfl[prcb->ipbf].dwContext   = NULL;
     }
@@ -1626,7 +1761,7 @@ LOCAL ERR ErrSORTIRunNext( RCB * prcb, SREC **ppsrec )
             TraceContextScope tc;
             tc->nParentObjectClass = tceNone;
 
-            FUCB *pfucbT = pscb->fcb.Pfucb();
+            FUCB *pfucbT = pmcb->pscb->fcb.Pfucb();
             BFPrereadPageRange( pfucbT->ifmp,
                                 pgnoNext,
                                 cpgRead,
@@ -1716,7 +1851,7 @@ INLINE ERR ErrSORTIRunReadPage( RCB *prcb, PGNO pgno, LONG ipbf )
     Assert( pgno < prcb->runinfo.run + prcb->runinfo.cpgUsed );
 
 
-    FUCB* pFucb = prcb->pscb->fcb.Pfucb();
+    FUCB* pFucb = prcb->pmcb->pscb->fcb.Pfucb();
     
     PIBTraceContextScope tcScope = pFucb->ppib->InitTraceContextScope();
     tcScope->nParentObjectClass = tceNone;
@@ -1736,21 +1871,22 @@ INLINE ERR ErrSORTIRunReadPage( RCB *prcb, PGNO pgno, LONG ipbf )
 
 
 
-LOCAL ERR ErrSORTIMergeToRun( SCB *pscb, RUNLINK *prunlinkSrc, RUNLINK **pprunlinkDest )
+LOCAL ERR ErrSORTIMergeToRunStart( MCB *pmcb, RUNLINK *prunlinkSrc, RUNLINK **pprunlink )
 {
     ERR     err = JET_errSuccess;
     LONG    irun;
     QWORD   cbRun;
     RUNLINK *prunlink = prunlinkNil;
-    SREC    *psrec;
 
 
-    CallR( ErrSORTIMergeStart( pscb, prunlinkSrc ) );
+    *pprunlink = prunlinkNil;
 
+    CallR( ErrSORTIMergeStart( pmcb, prunlinkSrc ) );
 
-    for ( cbRun = 0, irun = 0; irun < pscb->crunMerge; irun++ )
+
+    for ( cbRun = 0, irun = 0; irun < pmcb->crunMerge; irun++ )
     {
-        cbRun += pscb->rgmtnode[irun].prcb->runinfo.cbRun;
+        cbRun += pmcb->rgmtnode[irun].prcb->runinfo.cbRun;
     }
 
 
@@ -1761,37 +1897,77 @@ LOCAL ERR ErrSORTIMergeToRun( SCB *pscb, RUNLINK *prunlinkSrc, RUNLINK **pprunli
         goto EndMerge;
     }
 
-    CallJ( ErrSORTIRunStart( pscb, cbRun, &prunlink->runinfo ), FreeRUNLINK );
+    CallJ( ErrSORTIRunStart( pmcb, cbRun, &prunlink->runinfo ), FreeRUNLINK );
 
+    *pprunlink = prunlink;
+    return JET_errSuccess;
+
+FreeRUNLINK:
+    RUNLINKReleasePrunlink( prunlink );
+EndMerge:
+    SORTIMergeEnd( pmcb );
+    return err;
+}
 
-    while ( ( err = ErrSORTIMergeNext( pscb, &psrec ) ) >= 0 )
-        CallJ( ErrSORTIRunInsert( pscb, &prunlink->runinfo, psrec ), DeleteRun );
 
-    if ( err < 0 && err != JET_errNoCurrentRecord )
-        goto DeleteRun;
 
-    SORTIRunEnd( pscb, &prunlink->runinfo );
-    SORTIMergeEnd( pscb );
+LOCAL ERR ErrSORTIMergeToRunCopy( MCB *pmcb, RUNLINK *prunlink )
+{
+    ERR     err;
+    SREC    *psrec;
+
+
+    while ( ( err = ErrSORTIMergeNext( pmcb, &psrec ) ) >= 0 )
+    {
+        err = ErrSORTIRunInsert( pmcb, &prunlink->runinfo, psrec );
+        if ( err < 0 )
+            break;
+    }
+
+    SORTIRunFlush( pmcb, &prunlink->runinfo );
+    SORTIMergeEnd( pmcb );
+
+    return ( err == JET_errNoCurrentRecord ) ? JET_errSuccess : err;
+}
+
+
+
+LOCAL ERR ErrSORTIMergeToRunEnd( MCB *pmcb, const ERR errCopy, RUNLINK *prunlink, RUNLINK **pprunlinkDest )
+{
+    if ( errCopy < 0 )
+    {
+        SORTIRunDelete( pmcb->pscb, &prunlink->runinfo );
+        RUNLINKReleasePrunlink( prunlink );
+        return errCopy;
+    }
+
+    SORTIRunTrim( pmcb->pscb, &prunlink->runinfo );
 
 
     prunlink->prunlinkNext = *pprunlinkDest;
     *pprunlinkDest = prunlink;
 
     return JET_errSuccess;
+}
 
-DeleteRun:
-    SORTIRunEnd( pscb, &prunlink->runinfo );
-    SORTIRunDelete( pscb, &prunlink->runinfo );
-FreeRUNLINK:
-    RUNLINKReleasePrunlink( prunlink );
-EndMerge:
-    SORTIMergeEnd( pscb );
-    return err;
+
+
+LOCAL ERR ErrSORTIMergeToRun( MCB *pmcb, RUNLINK *prunlinkSrc, RUNLINK **pprunlinkDest )
+{
+    ERR     err;
+    RUNLINK *prunlink;
+
+
+    CallR( ErrSORTIMergeToRunStart( pmcb, prunlinkSrc, &prunlink ) );
+
+    err = ErrSORTIMergeToRunCopy( pmcb, prunlink );
+
+    return ErrSORTIMergeToRunEnd( pmcb, err, prunlink, pprunlinkDest );
 }
 
 
 
-LOCAL ERR ErrSORTIMergeStart( SCB *pscb, RUNLINK *prunlinkSrc )
+LOCAL ERR ErrSORTIMergeStart( MCB *pmcb, RUNLINK *prunlinkSrc )
 {
     ERR     err;
     RUNLINK *prunlink;
@@ -1800,7 +1976,7 @@ LOCAL ERR ErrSORTIMergeStart( SCB *pscb, RUNLINK *prunlinkSrc )
     MTNODE  *pmtnode;
 
     
-    if ( PinstFromIfmp( pscb->fcb.Ifmp() )->m_fTermInProgress )
+    if ( PinstFromIfmp( pmcb->pscb->fcb.Ifmp() )->m_fTermInProgress )
         return ErrERRCheck( JET_errTermInProgress );
 
     
@@ -1816,10 +1992,10 @@ LOCAL ERR ErrSORTIMergeStart( SCB *pscb, RUNLINK *prunlinkSrc )
     Assert( crun > 1 );
 
     
-    pscb->crunMerge             = crun;
-    pscb->bflLast.pv            = NULL;
-    pscb->bflLast.dwContext     = NULL;
-    pscb->pvAssyLast            = NULL;
+    pmcb->crunMerge             = crun;
+    pmcb->bflLast.pv            = NULL;
+    pmcb->bflLast.dwContext     = NULL;
+    pmcb->pvAssyLast            = NULL;
 
     OSTrace( JET_tracetagSortPerf, OSFormat( "MERGE:  %ld runs -(details to follow)", crun ) );
 
@@ -1828,14 +2004,14 @@ LOCAL ERR ErrSORTIMergeStart( SCB *pscb, RUNLINK *prunlinkSrc )
     for ( irun = 0; irun < crun; irun++ )
     {
 
-        pmtnode = pscb->rgmtnode + irun;
-        Call( ErrSORTIRunOpen( pscb, &prunlink->runinfo, &pmtnode->prcb ) );
-        pmtnode->pmtnodeExtUp = pscb->rgmtnode + ( irun + crun ) / 2;
+        pmtnode = pmcb->rgmtnode + irun;
+        Call( ErrSORTIRunOpen( pmcb, &prunlink->runinfo, &pmtnode->prcb ) );
+        pmtnode->pmtnodeExtUp = pmcb->rgmtnode + ( irun + crun ) / 2;
 
 
         pmtnode->psrec = psrecNegInf;
         pmtnode->pmtnodeSrc = pmtnode;
-        pmtnode->pmtnodeIntUp = pscb->rgmtnode + irun / 2;
+        pmtnode->pmtnodeIntUp = pmcb->rgmtnode + irun / 2;
 
         OSTrace( JET_tracetagSortPerf, OSFormat( "  Run:  %ld(%ld)", pmtnode->prcb->runinfo.run, pmtnode->prcb->runinfo.cpgUsed ) );
 
@@ -1846,24 +2022,24 @@ LOCAL ERR ErrSORTIMergeStart( SCB *pscb, RUNLINK *prunlinkSrc )
     return JET_errSuccess;
 
 HandleError:
-    pscb->crunMerge = 0;
+    pmcb->crunMerge = 0;
     for ( irun--; irun >= 0; irun-- )
-        SORTIRunClose( pscb->rgmtnode[irun].prcb );
+        SORTIRunClose( pmcb->rgmtnode[irun].prcb );
     return err;
 }
 
 
 
-LOCAL ERR ErrSORTIMergeFirst( SCB *pscb, SREC **ppsrec )
+LOCAL ERR ErrSORTIMergeFirst( MCB *pmcb, SREC **ppsrec )
 {
     ERR     err;
 
 
-    while ( pscb->rgmtnode[0].psrec == psrecNegInf )
-        Call( ErrSORTIMergeNextChamp( pscb, ppsrec ) );
+    while ( pmcb->rgmtnode[0].psrec == psrecNegInf )
+        Call( ErrSORTIMergeNextChamp( pmcb, ppsrec ) );
 
 
-    *ppsrec = pscb->rgmtnode[0].psrec;
+    *ppsrec = pmcb->rgmtnode[0].psrec;
 
     return JET_errSuccess;
 
@@ -1875,62 +2051,62 @@ HandleError:
 
 
 
-LOCAL ERR ErrSORTIMergeNext( SCB *pscb, SREC **ppsrec )
+LOCAL ERR ErrSORTIMergeNext( MCB *pmcb, SREC **ppsrec )
 {
     ERR     err;
     SREC    *psrecLast;
 
 
-    if ( pscb->rgmtnode[0].psrec == psrecNegInf )
-        return ErrSORTIMergeFirst( pscb, ppsrec );
+    if ( pmcb->rgmtnode[0].psrec == psrecNegInf )
+        return ErrSORTIMergeFirst( pmcb, ppsrec );
 
 
     do  {
-        psrecLast = pscb->rgmtnode[0].psrec;
-        CallR( ErrSORTIMergeNextChamp( pscb, ppsrec ) );
+        psrecLast = pmcb->rgmtnode[0].psrec;
+        CallR( ErrSORTIMergeNextChamp( pmcb, ppsrec ) );
     }
-    while ( FSORTIDuplicate( pscb, *ppsrec, psrecLast ) );
+    while ( FSORTIDuplicate( pmcb->pscb, *ppsrec, psrecLast ) );
 
     return JET_errSuccess;
 }
 
 
 
-LOCAL VOID SORTIMergeEnd( SCB *pscb )
+LOCAL VOID SORTIMergeEnd( MCB *pmcb )
 {
     LONG    irun;
 
 
-    if ( pscb->bflLast.pv != NULL )
+    if ( pmcb->bflLast.pv != NULL )
     {
         CLockDeadlockDetectionInfo::DisableOwnershipTracking();
-        BFRenouncePage( &pscb->bflLast, fTrue );
+        BFRenouncePage( &pmcb->bflLast, fTrue );
         CLockDeadlockDetectionInfo::EnableOwnershipTracking();
-        pscb->bflLast.pv        = NULL;
-        pscb->bflLast.dwContext = NULL;
+        pmcb->bflLast.pv        = NULL;
+        pmcb->bflLast.dwContext = NULL;
     }
-    if ( pscb->pvAssyLast != NULL )
+    if ( pmcb->pvAssyLast != NULL )
     {
-        BFFree( pscb->pvAssyLast );
-        pscb->pvAssyLast = NULL;
+        BFFree( pmcb->pvAssyLast );
+        pmcb->pvAssyLast = NULL;
     }
 
 
-    for ( irun = 0; irun < pscb->crunMerge; irun++ )
-        SORTIRunClose( pscb->rgmtnode[irun].prcb );
-    pscb->crunMerge = 0;
+    for ( irun = 0; irun < pmcb->crunMerge; irun++ )
+        SORTIRunClose( pmcb->rgmtnode[irun].prcb );
+    pmcb->crunMerge = 0;
 }
 
 
 
-LOCAL ERR ErrSORTIMergeNextChamp( SCB *pscb, SREC **ppsrec )
+LOCAL ERR ErrSORTIMergeNextChamp( MCB *pmcb, SREC **ppsrec )
 {
     ERR     err;
     MTNODE  *pmtnodeChamp;
     MTNODE  *pmtnodeLoser;
 
 
-    pmtnodeChamp = pscb->rgmtnode + 0;
+    pmtnodeChamp = pmcb->rgmtnode + 0;
     pmtnodeLoser = pmtnodeChamp->pmtnodeSrc;
 
 
@@ -2012,7 +2188,14 @@ LOCAL ERR ErrSORTIOptTreeMerge( SCB *pscb )
     CallR( ErrSORTIOptTreeBuild( pscb, &potnode ) );
 
 
-    Call( ErrSORTIOptTreeMergeDF( pscb, potnode, NULL ) );
+    if ( CSORTIParallelWorker( pscb ) > 1 )
+    {
+        Call( ErrSORTIOptTreeMergeParallel( pscb, potnode ) );
+    }
+    else
+    {
+        Call( ErrSORTIOptTreeMergeDF( pscb, potnode, NULL ) );
+    }
 
 
     Assert( pscb->runlist.crun == 0 );
@@ -2260,7 +2443,7 @@ LOCAL ERR ErrSORTIOptTreeMergeDF( SCB *pscb, OTNODE *potnode, RUNLINK **pprunlin
     if ( pprunlink != NULL )
     {
 
-        CallR( ErrSORTIMergeToRun(  pscb,
+        CallR( ErrSORTIMergeToRun(  &pscb->mcb,
                                     potnode->runlist.prunlinkHead,
                                     pprunlink ) );
         SORTIRunDeleteList( pscb, &potnode->runlist.prunlinkHead, crunAll );
@@ -2272,6 +2455,146 @@ LOCAL ERR ErrSORTIOptTreeMergeDF( SCB *pscb, OTNODE *potnode, RUNLINK **pprunlin
 
 
 
+LOCAL VOID SORTIOptTreeBindRuns( SCB *pscb, OTNODE *potnode )
+{
+    LONG    crunPhantom = 0;
+    LONG    ipotnode;
+    LONG    irun;
+    RUNLINK *prunlinkNext;
+
+
+    if ( potnode->runlist.prunlinkHead == prunlinkNil )
+        crunPhantom = potnode->runlist.crun;
+
+
+    for ( ipotnode = 0; ipotnode < crunFanInMax; ipotnode++ )
+    {
+        if ( potnode->rgpotnode[ipotnode] != potnodeNil )
+            SORTIOptTreeBindRuns( pscb, potnode->rgpotnode[ipotnode] );
+    }
+
+
+    for ( irun = 0; irun < crunPhantom; irun++ )
+    {
+        prunlinkNext = pscb->runlist.prunlinkHead->prunlinkNext;
+        pscb->runlist.prunlinkHead->prunlinkNext = potnode->runlist.prunlinkHead;
+        potnode->runlist.prunlinkHead = pscb->runlist.prunlinkHead;
+        pscb->runlist.prunlinkHead = prunlinkNext;
+    }
+    pscb->runlist.crun -= crunPhantom;
+}
+
+
+
+struct SORTMERGE
+{
+    MCB         mcb;
+    OTNODE      *potnodeParent;
+    LONG        ipotnode;
+    RUNLINK     *prunlink;
+    ERR         err;
+};
+
+LOCAL VOID SORTIMergeToRunJob( VOID * const pvContext, const LONG imerge )
+{
+    SORTMERGE * const pmerge = (SORTMERGE *)pvContext + imerge;
+    pmerge->err = ErrSORTIMergeToRunCopy( &pmerge->mcb, pmerge->prunlink );
+}
+
+LOCAL LONG CSORTIOptTreeCollectLeaves( OTNODE *potnode, SORTMERGE *rgmerge, LONG cmerge, const LONG cmergeMax )
+{
+    for ( LONG ipotnode = 0; ipotnode < crunFanInMax && cmerge < cmergeMax; ipotnode++ )
+    {
+        OTNODE * const potnodeChild = potnode->rgpotnode[ipotnode];
+        if ( potnodeChild == potnodeNil )
+            continue;
+
+        BOOL fLeaf = fTrue;
+        for ( LONG ipotnodeChild = 0; ipotnodeChild < crunFanInMax; ipotnodeChild++ )
+        {
+            fLeaf = fLeaf && potnodeChild->rgpotnode[ipotnodeChild] == potnodeNil;
+        }
+
+        if ( fLeaf )
+        {
+            rgmerge[cmerge].potnodeParent   = potnode;
+            rgmerge[cmerge++].ipotnode      = ipotnode;
+        }
+        else
+        {
+            cmerge = CSORTIOptTreeCollectLeaves( potnodeChild, rgmerge, cmerge, cmergeMax );
+        }
+    }
+
+    return cmerge;
+}
+
+
+LOCAL ERR ErrSORTIOptTreeMergeParallel( SCB *pscb, OTNODE *potnode )
+{
+    ERR         err         = JET_errSuccess;
+    SORTMERGE   *rgmerge    = NULL;
+    LONG        cmerge;
+    LONG        cmergeStarted;
+    LONG        imerge;
+
+
+    SORTIOptTreeBindRuns( pscb, potnode );
+
+    Alloc( rgmerge = new SORTMERGE[CSORTIParallelWorker( pscb )] );
+
+
+    while ( ( cmerge = CSORTIOptTreeCollectLeaves( potnode, rgmerge, 0, CSORTIParallelWorker( pscb ) ) ) > 0 )
+    {
+
+        for ( cmergeStarted = 0; cmergeStarted < cmerge; cmergeStarted++ )
+        {
+            SORTMERGE * const pmerge    = rgmerge + cmergeStarted;
+            OTNODE * const potnodeChild = pmerge->potnodeParent->rgpotnode[pmerge->ipotnode];
+
+            pmerge->mcb.pscb        = pscb;
+            pmerge->mcb.crunMerge   = 0;
+            pmerge->err             = JET_errSuccess;
+
+            err = ErrSORTIMergeToRunStart( &pmerge->mcb, potnodeChild->runlist.prunlinkHead, &pmerge->prunlink );
+            if ( err < 0 )
+                break;
+        }
+
+
+        SORTIDispatchJobs( pscb, SORTIMergeToRunJob, rgmerge, cmergeStarted );
+
+
+        for ( imerge = 0; imerge < cmergeStarted; imerge++ )
+        {
+            SORTMERGE * const pmerge    = rgmerge + imerge;
+            OTNODE * const potnodeParent = pmerge->potnodeParent;
+            const ERR errMerge = ErrSORTIMergeToRunEnd( &pmerge->mcb,
+                                                        pmerge->err,
+                                                        pmerge->prunlink,
+                                                        &potnodeParent->runlist.prunlinkHead );
+            if ( errMerge < 0 )
+            {
+                err = ( err < 0 ) ? err : errMerge;
+                continue;
+            }
+
+            SORTIRunDeleteList( pscb, &potnodeParent->rgpotnode[pmerge->ipotnode]->runlist.prunlinkHead, crunAll );
+            OTNODEReleasePotnode( potnodeParent->rgpotnode[pmerge->ipotnode] );
+            potnodeParent->rgpotnode[pmerge->ipotnode] = potnodeNil;
+            potnodeParent->runlist.crun++;
+        }
+
+        Call( err );
+    }
+
+HandleError:
+    delete[] rgmerge;
+    return err;
+}
+
+
+
 LOCAL VOID SORTIOptTreeFree( SCB *pscb, OTNODE *potnode )
 {
     LONG    ipotnode;
@@ -0,0 +1,148 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "std.hxx"
+
+#ifndef ENABLE_JET_UNIT_TEST
+#error This file should only be compiled with the unit tests!
+#endif
+
+enum SORTTESTKEYS
+{
+    sorttestkeysRandom,
+    sorttestkeysSorted,
+    sorttestkeysDuplicates,
+};
+
+class SortTestFixture : public JetTestFixture
+{
+    protected:
+        JetTestDatabase     m_db;
+
+    public:
+        SortTestFixture() {}
+        ~SortTestFixture() {}
+
+    protected:
+        bool SetUp_()
+        {
+            return m_db.ErrCreateInstance( L"SortTest", JetTestDatabase::bitNoDatabase ) >= JET_errSuccess
+                && m_db.ErrSetParam( JET_paramMaxTemporaryTables, 16 ) >= JET_errSuccess
+                && m_db.ErrInit() >= JET_errSuccess;
+        }
+
+        void TearDown_()
+        {
+            CHECKCALLS( m_db.ErrTerm() );
+        }
+
+        QWORD CusecSort( const SORTTESTKEYS sorttestkeys, const LONG cWorker, const LONG crec );
+
+    public:
+        void ParallelSortMatchesSerialOrder();
+        void ParallelSortPerf();
+};
+
+QWORD SortTestFixture::CusecSort( const SORTTESTKEYS sorttestkeys, const LONG cWorker, const LONG crec )
+{
+    PIB*    ppib    = m_db.Ppib();
+    FUCB*   pfucb   = pfucbNil;
+    ULONG   ulSeed  = 0x5eed;
+    BYTE    rgbKey[ sizeof( ULONG ) ];
+    BYTE    rgbKeyLast[ sizeof( ULONG ) ];
+    BYTE    rgbData[ 16 ]   = { 0 };
+    KEY     key;
+    DATA    data;
+    ERR     err;
+
+    INST * const    pinst               = PinstFromPpib( ppib );
+    const LONG      cWorkerConfigured   = pinst->m_cSORTParallelWorker;
+    pinst->m_cSORTParallelWorker = max( 1, min( cWorker, cmergeParallelMax ) );
+
+    const HRT hrtStart = HrtHRTCount();
+
+    CHECKCALLS( ErrSORTOpen( ppib, &pfucb, fFalse, fFalse ) );
+
+    for ( LONG irec = 0; irec < crec; irec++ )
+    {
+        ulSeed = ulSeed * 1103515245 + 12345;
+
+        ULONG ulKey = 0;
+        switch ( sorttestkeys )
+        {
+            case sorttestkeysRandom:
+                ulKey = ulSeed;
+                break;
+            case sorttestkeysSorted:
+                ulKey = irec;
+                break;
+            case sorttestkeysDuplicates:
+                ulKey = ( ulSeed >> 16 ) % 64;
+                break;
+        }
+
+        UnalignedKeyFromLong( rgbKey, ulKey );
+        *(UnalignedLittleEndian< LONG >*)rgbData = irec;
+
+        key.prefix.Nullify();
+        key.suffix.SetPv( rgbKey );
+        key.suffix.SetCb( sizeof( rgbKey ) );
+        data.SetPv( rgbData );
+        data.SetCb( sizeof( rgbData ) );
+
+        CHECKCALLS( ErrSORTInsert( pfucb, key, data ) );
+    }
+
+    CHECK( ErrSORTEndInsert( pfucb ) >= JET_errSuccess );
+
+    LONG crecSeen = 0;
+    while ( ( err = ErrSORTNext( pfucb ) ) >= JET_errSuccess )
+    {
+        CHECK( pfucb->kdfCurr.key.Cb() == sizeof( rgbKey ) );
+        pfucb->kdfCurr.key.CopyIntoBuffer( rgbKey, sizeof( rgbKey ) );
+        CHECK( 0 == crecSeen || memcmp( rgbKeyLast, rgbKey, sizeof( rgbKey ) ) <= 0 );
+        memcpy( rgbKeyLast, rgbKey, sizeof( rgbKey ) );
+        crecSeen++;
+    }
+    CHECK( JET_errNoCurrentRecord == err );
+    CHECK( crec == crecSeen );
+
+    SORTClose( pfucb );
+
+    pinst->m_cSORTParallelWorker = cWorkerConfigured;
+
+    return CusecHRTFromDhrt( HrtHRTCount() - hrtStart );
+}
+
+void SortTestFixture::ParallelSortMatchesSerialOrder()
+{
+    (VOID)CusecSort( sorttestkeysRandom, 4, 100000 );
+    (VOID)CusecSort( sorttestkeysDuplicates, 4, 100000 );
+}
+
+void SortTestFixture::ParallelSortPerf()
+{
+    const LONG          crec        = 2000000;
+    const LONG          cWorkerMax  = min( (LONG)OSSyncGetProcessorCount(), cmergeParallelMax );
+    const CHAR * const  rgszKeys[]  = { "random", "pre-sorted", "duplicate-heavy" };
+
+    for ( INT ikeys = sorttestkeysRandom; ikeys <= sorttestkeysDuplicates; ikeys++ )
+    {
+        for ( LONG cWorker = 1; cWorker <= cWorkerMax; cWorker *= 2 )
+        {
+            const QWORD cusec = CusecSort( (SORTTESTKEYS)ikeys, cWorker, crec );
+            CHAR        szMetric[ 64 ];
+
+            OSStrCbFormatA( szMetric, sizeof( szMetric ), "%s keys, %d workers", rgszKeys[ ikeys ], cWorker );
+            REPORTMETRIC( szMetric, (QWORD)crec * 1000000 / max( cusec, (QWORD)1 ), "records/sec" );
+        }
+    }
+}
+
+static const JetTestCaller<SortTestFixture> sort1(
+    "SORT.ParallelSortMatchesSerialOrder",
+    &SortTestFixture::ParallelSortMatchesSerialOrder );
+static const JetTestCaller<SortTestFixture> sort2(
+    "SORT.ParallelSortPerf",
+    JetSimpleUnitTest::dwDontRunByDefault,
+    &SortTestFixture::ParallelSortPerf );
@@ -2591,6 +2591,8 @@ CODECONST(VTFNDEF) vtfndefIsam =
     ErrIsamRetrieveColumnByReference,
     ErrIsamPrereadColumnsByReference,
     ErrIsamStreamRecords,
+    ErrIsamRetrieveLongValues,
+    ErrIsamPrepareRetrieveColumns,
 };
 
 const VTFNDEF vtfndefIsamMustRollback =
@@ -2652,6 +2654,8 @@ const VTFNDEF vtfndefIsamMustRollback =
     ErrIllegalRetrieveColumnByReference,
     ErrIllegalPrereadColumnsByReference,
     ErrIllegalStreamRecords,
+    ErrIllegalRetrieveLongValues,
+    ErrIllegalPrepareRetrieveColumns,
 };
 
 CODECONST(VTFNDEF) vtfndefTTSortIns =
@@ -2713,6 +2717,8 @@ CODECONST(VTFNDEF) vtfndefTTSortIns =
     ErrIllegalRetrieveColumnByReference,
     ErrIllegalPrereadColumnsByReference,
     ErrIllegalStreamRecords,
+    ErrIllegalRetrieveLongValues,
+    ErrIllegalPrepareRetrieveColumns,
 };
 
 CODECONST(VTFNDEF) vtfndefTTSortRet =
@@ -2774,6 +2780,8 @@ CODECONST(VTFNDEF) vtfndefTTSortRet =
     ErrIllegalRetrieveColumnByReference,
     ErrIllegalPrereadColumnsByReference,
     ErrIllegalStreamRecords,
+    ErrIllegalRetrieveLongValues,
+    ErrIllegalPrepareRetrieveColumns,
 };
 
 CODECONST(VTFNDEF) vtfndefTTBase =
@@ -2835,6 +2843,8 @@ CODECONST(VTFNDEF) vtfndefTTBase =
     ErrIllegalRetrieveColumnByReference,
     ErrIllegalPrereadColumnsByReference,
     ErrIllegalStreamRecords,
+    ErrIllegalRetrieveLongValues,
+    ErrIllegalPrepareRetrieveColumns,
 };
 
 const VTFNDEF vtfndefTTBaseMustRollback =
@@ -2896,6 +2906,8 @@ const VTFNDEF vtfndefTTBaseMustRollback =
     ErrIllegalRetrieveColumnByReference,
     ErrIllegalPrereadColumnsByReference,
     ErrIllegalStreamRecords,
+    ErrIllegalRetrieveLongValues,
+    ErrIllegalPrepareRetrieveColumns,
 };
 
 LOCAL CODECONST(VTFNDEF) vtfndefTTSortClose =
@@ -2957,6 +2969,8 @@ LOCAL CODECONST(VTFNDEF) vtfndefTTSortClose =
     ErrIllegalRetrieveColumnByReference,
     ErrIllegalPrereadColumnsByReference,
     ErrIllegalStreamRecords,
+    ErrIllegalRetrieveLongValues,
+    ErrIllegalPrepareRetrieveColumns,
 };
 
 
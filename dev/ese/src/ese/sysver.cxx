@@ -52,6 +52,7 @@ const FormatVersions g_rgfmtversEngine[] = {
     { JET_efvXpress10Compression,             { 1568,170,380 }, { 8,80,180 }, { 3,0,0 } },
     { JET_efvRevertSnapshot,                  { 1568,180,400 }, { 8,90,200 }, { 3,0,0 } },
     { JET_efvApplyRevertSnapshot,             { 1568,190,420 }, { 8,90,200 }, { 3,0,0 } },
+    { JET_efvCompressionDictionaries,         { 1568,200,440 }, { 8,100,220 }, { 3,0,0 } },
 };
 
 const INT g_cfmtversEngine = _countof( g_rgfmtversEngine );
@@ -1617,6 +1617,83 @@ ERR TAGFIELDS::ErrRetrieveColumn(
     return ErrERRCheck( JET_wrnColumnNull );
 }
 
+VOID TAGFIELDS::RetrieveFirstInstances(
+    const ULONG     cfid,
+    const FID       * const rgfid,
+    const BOOL      * const rgfDerived,
+    DATA            * const rgdataRetrieved,
+    ERR             * const rgerrRetrieved )
+{
+    ULONG           itagfld             = 0;
+
+    for ( ULONG itagfldFind = 0; itagfldFind < cfid; itagfldFind++ )
+    {
+        const FID       fid             = rgfid[ itagfldFind ];
+        const BOOL      fDerived        = rgfDerived[ itagfldFind ];
+        DATA * const    pdataRetrieved  = rgdataRetrieved + itagfldFind;
+
+        Assert( FTaggedFid( fid ) );
+        Assert( 0 == itagfldFind
+            || TAGFLD( rgfid[ itagfldFind - 1 ], rgfDerived[ itagfldFind - 1 ] ).FIsLessThan( fid, fDerived ) );
+
+        while ( itagfld < CTaggedColumns()
+            && Ptagfld( itagfld )->FIsLessThan( fid, fDerived ) )
+        {
+            itagfld++;
+        }
+
+        if ( itagfld >= CTaggedColumns()
+            || !Ptagfld( itagfld )->FIsEqual( fid, fDerived ) )
+        {
+            pdataRetrieved->Nullify();
+            rgerrRetrieved[ itagfldFind ] = JET_errColumnNotFound;
+            continue;
+        }
+
+        const TAGFLD_HEADER     * const pheader     = Pheader( itagfld );
+        if ( Ptagfld( itagfld )->FNull( this ) )
+        {
+            pdataRetrieved->Nullify();
+            rgerrRetrieved[ itagfldFind ] = ErrERRCheck( JET_wrnColumnNull );
+        }
+        else if ( NULL != pheader
+            && pheader->FMultiValues() )
+        {
+            Assert( Ptagfld( itagfld )->FExtendedInfo() );
+
+            if ( pheader->FTwoValues() )
+            {
+                TWOVALUES   tv( PbData( itagfld ), CbData( itagfld ) );
+                tv.RetrieveInstance( 1, pdataRetrieved );
+                rgerrRetrieved[ itagfldFind ] = JET_errSuccess;
+            }
+            else
+            {
+                MULTIVALUES     mv( PbData( itagfld ), CbData( itagfld ) );
+                rgerrRetrieved[ itagfldFind ] = mv.ErrRetrieveInstance( 1, pdataRetrieved );
+            }
+        }
+        else
+        {
+            pdataRetrieved->SetPv( PbData( itagfld ) );
+            pdataRetrieved->SetCb( CbData( itagfld ) );
+
+            if ( NULL != pheader )
+            {
+                Assert( Ptagfld( itagfld )->FExtendedInfo() );
+                const INT   iDelta  = sizeof(TAGFLD_HEADER);
+                pdataRetrieved->DeltaPv( iDelta );
+                pdataRetrieved->DeltaCb( -iDelta );
+                rgerrRetrieved[ itagfldFind ] = pheader->ErrRetrievalResult();
+            }
+            else
+            {
+                rgerrRetrieved[ itagfldFind ] = JET_errSuccess;
+            }
+        }
+    }
+}
+
 
 ULONG TAGFIELDS::UlColumnInstances(
     FCB             * const pfcb,
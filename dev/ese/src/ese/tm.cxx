@@ -206,7 +206,6 @@ ERR ISAMAPI ErrIsamIdle( JET_SESID sesid, JET_GRBIT grbit )
         {
         VER* const pver = PverFromPpib( ppib );
         DWORD_PTR cVerBuckets = 0;
-        ENTERCRITICALSECTION enterCritRCEBucketGlobal( &pver->m_critBucketGlobal );
         CallS( pver->m_cresBucket.ErrGetParam( JET_resoperCurrentUse, &cVerBuckets ) );
         err = ( cVerBuckets != 0 ) ? ErrERRCheck( JET_wrnRemainingVersions ) : JET_errSuccess;
         }
@@ -330,7 +329,9 @@ ERR ISAMAPI ErrIsamSystemInit()
 
     CallJ( ErrBFInit( CbSYSMaxPageSize() ), TermCPAGE );
 
-    CallJ( ErrCATInit(), TermBF );
+    CallJ( ErrNDInit(), TermBF );
+
+    CallJ( ErrCATInit(), TermND );
 
     CallJ( ErrSNAPInit(), TermCAT );
 
@@ -360,6 +361,9 @@ TermSNAP:
     
 TermCAT:
     CATTerm();
+
+TermND:
+    NDTerm();
     
 TermBF:
     BFTerm();
@@ -406,6 +410,8 @@ VOID ISAMAPI IsamSystemTerm()
     
     CATTerm();
 
+    NDTerm();
+
     BFTerm( );
 
     CPAGE::Term();
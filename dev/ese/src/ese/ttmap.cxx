@@ -3,12 +3,25 @@
 
 #include "std.hxx"
 
-TTMAP::TTMAP( PIB * const ppib ) :
+TTMAP::TTMAP( PIB * const ppib, const ULONG cbMemoryMost ) :
     m_tableid( JET_tableidNil ),
     m_sesid( reinterpret_cast<JET_SESID>( ppib ) ),
     m_columnidKey( 0 ),
     m_columnidValue( 0 ),
-    m_crecords( 0 )
+    m_crecords( 0 ),
+    m_cbMemoryMost( cbMemoryMost ),
+    m_rgentry( NULL ),
+    m_centry( 0 ),
+    m_centryUsed( 0 ),
+    m_centryDeleted( 0 ),
+    m_rgui64KeySorted( NULL ),
+    m_cui64KeySorted( 0 ),
+    m_cui64KeySortedMax( 0 ),
+    m_iui64KeyCurrent( 0 ),
+    m_ui64KeyCurrent( 0 ),
+    m_fCurrency( fFalse ),
+    m_fSortedStale( fTrue ),
+    m_fSeekNext( fFalse )
 {
 }
 
@@ -20,10 +33,261 @@ TTMAP::~TTMAP()
         CallS( ErrDispCloseTable( m_sesid, m_tableid ) );
         m_tableid = JET_tableidNil;
     }
+
+    OSMemoryHeapFree( m_rgentry );
+    m_rgentry = NULL;
+    OSMemoryHeapFree( m_rgui64KeySorted );
+    m_rgui64KeySorted = NULL;
 }
 
 
 ERR TTMAP::ErrInit( INST * const )
+{
+    if( m_cbMemoryMost < centryInitial * sizeof( ENTRY ) )
+    {
+        return ErrOpenTempTable_();
+    }
+
+    return ErrRehash_( centryInitial );
+}
+
+
+ULONG TTMAP::IentryHash_( const unsigned __int64 ui64Key ) const
+{
+    return ULONG( ( ui64Key * 0x9E3779B97F4A7C15 ) >> 32 ) & ( m_centry - 1 );
+}
+
+
+TTMAP::ENTRY * TTMAP::PentryFind_( const unsigned __int64 ui64Key ) const
+{
+    Assert( FInMemory_() );
+
+    for( ULONG ientry = IentryHash_( ui64Key ); ; ientry = ( ientry + 1 ) & ( m_centry - 1 ) )
+    {
+        ENTRY * const pentry = &m_rgentry[ ientry ];
+
+        if( entryFree == pentry->ulState )
+        {
+            return NULL;
+        }
+        if( entryUsed == pentry->ulState && ui64Key == pentry->ui64Key )
+        {
+            return pentry;
+        }
+    }
+}
+
+
+ERR TTMAP::ErrRehash_( const ULONG centryNew )
+{
+    ENTRY * const   rgentryOld  = m_rgentry;
+    const ULONG     centryOld   = m_centry;
+    ENTRY *         rgentryNew  = (ENTRY *)PvOSMemoryHeapAlloc( centryNew * sizeof( ENTRY ) );
+
+    Assert( 0 == ( centryNew & ( centryNew - 1 ) ) );
+
+    if( NULL == rgentryNew )
+    {
+        return ErrERRCheck( JET_errOutOfMemory );
+    }
+    memset( rgentryNew, 0, centryNew * sizeof( ENTRY ) );
+
+    m_rgentry       = rgentryNew;
+    m_centry        = centryNew;
+    m_centryDeleted = 0;
+
+    for( ULONG ientryOld = 0; ientryOld < centryOld; ientryOld++ )
+    {
+        if( entryUsed != rgentryOld[ ientryOld ].ulState )
+        {
+            continue;
+        }
+
+        ULONG ientry = IentryHash_( rgentryOld[ ientryOld ].ui64Key );
+        while( entryFree != m_rgentry[ ientry ].ulState )
+        {
+            ientry = ( ientry + 1 ) & ( m_centry - 1 );
+        }
+        m_rgentry[ ientry ] = rgentryOld[ ientryOld ];
+    }
+
+    OSMemoryHeapFree( rgentryOld );
+
+    return JET_errSuccess;
+}
+
+
+ERR TTMAP::ErrInsertEntry_( const unsigned __int64 ui64Key, const ULONG ulValue )
+{
+    ERR err = JET_errSuccess;
+
+    Assert( FInMemory_() );
+    Assert( NULL == PentryFind_( ui64Key ) );
+
+    if( 4 * ( m_centryUsed + m_centryDeleted + 1 ) > 3 * m_centry )
+    {
+        const ULONG centryNew = ( 8 * ( m_centryUsed + 1 ) > 3 * m_centry ) ? 2 * m_centry : m_centry;
+
+        //  the old and the new table are both allocated while we rehash
+
+        if( (QWORD)( m_centry + centryNew ) * sizeof( ENTRY ) + CbSortedKeys_() > m_cbMemoryMost )
+        {
+            CallR( ErrSpill_() );
+            return ErrInsertKeyValue_( ui64Key, ulValue );
+        }
+
+        CallR( ErrRehash_( centryNew ) );
+    }
+
+    ULONG ientry = IentryHash_( ui64Key );
+    while( entryUsed == m_rgentry[ ientry ].ulState )
+    {
+        ientry = ( ientry + 1 ) & ( m_centry - 1 );
+    }
+
+    if( entryDeleted == m_rgentry[ ientry ].ulState )
+    {
+        m_centryDeleted--;
+    }
+    m_rgentry[ ientry ].ui64Key = ui64Key;
+    m_rgentry[ ientry ].ulValue = ulValue;
+    m_rgentry[ ientry ].ulState = entryUsed;
+
+    m_centryUsed++;
+    ++m_crecords;
+    m_fSortedStale = fTrue;
+
+    return err;
+}
+
+
+ERR TTMAP::ErrSortKeys_()
+{
+    Assert( FInMemory_() );
+
+    if( m_centryUsed > m_cui64KeySortedMax )
+    {
+        //  spill instead of growing the snapshot past our budget
+
+        if( (QWORD)m_centry * sizeof( ENTRY ) + (QWORD)m_centryUsed * sizeof( unsigned __int64 ) > m_cbMemoryMost )
+        {
+            return ErrSpill_();
+        }
+
+        unsigned __int64 * const rgui64KeyNew = (unsigned __int64 *)PvOSMemoryHeapAlloc( m_centryUsed * sizeof( unsigned __int64 ) );
+        if( NULL == rgui64KeyNew )
+        {
+            return ErrERRCheck( JET_errOutOfMemory );
+        }
+        OSMemoryHeapFree( m_rgui64KeySorted );
+        m_rgui64KeySorted = rgui64KeyNew;
+        m_cui64KeySortedMax = m_centryUsed;
+    }
+
+    m_cui64KeySorted = 0;
+    for( ULONG ientry = 0; ientry < m_centry; ientry++ )
+    {
+        if( entryUsed == m_rgentry[ ientry ].ulState )
+        {
+            m_rgui64KeySorted[ m_cui64KeySorted++ ] = m_rgentry[ ientry ].ui64Key;
+        }
+    }
+    Assert( m_cui64KeySorted == m_centryUsed );
+
+    std::sort( m_rgui64KeySorted, m_rgui64KeySorted + m_cui64KeySorted );
+    m_fSortedStale = fFalse;
+
+    return JET_errSuccess;
+}
+
+
+ERR TTMAP::ErrSpill_()
+{
+    ERR     err     = JET_errSuccess;
+    ULONG   centry  = 0;
+
+    Assert( FInMemory_() );
+
+    //  sort the entries in place so that the spill itself needs no memory beyond our budget
+
+    OSMemoryHeapFree( m_rgui64KeySorted );
+    m_rgui64KeySorted = NULL;
+    m_cui64KeySorted = 0;
+    m_cui64KeySortedMax = 0;
+    m_fSortedStale = fTrue;
+
+    for( ULONG ientry = 0; ientry < m_centry; ientry++ )
+    {
+        if( entryUsed == m_rgentry[ ientry ].ulState )
+        {
+            m_rgentry[ centry++ ] = m_rgentry[ ientry ];
+        }
+    }
+    Assert( centry == m_centryUsed );
+    for( ULONG ientry = centry; ientry < m_centry; ientry++ )
+    {
+        m_rgentry[ ientry ].ulState = entryFree;
+    }
+    std::sort( m_rgentry, m_rgentry + centry, CmpEntry_ );
+
+    Call( ErrOpenTempTable_() );
+
+    m_crecords = 0;
+    for( ULONG ientry = 0; ientry < centry; ientry++ )
+    {
+        Call( ErrInsertKeyValue_( m_rgentry[ ientry ].ui64Key, m_rgentry[ ientry ].ulValue ) );
+    }
+
+    //  the current key may have been deleted since we visited it, in which case the next
+    //  ErrMoveNext must seek past it instead of moving off of it
+
+    m_fSeekNext = fFalse;
+    if( m_fCurrency )
+    {
+        CallS( ErrDispMakeKey( m_sesid, m_tableid, (BYTE *)&m_ui64KeyCurrent, sizeof( m_ui64KeyCurrent ), JET_bitNewKey ) );
+        err = ErrDispSeek( m_sesid, m_tableid, JET_bitSeekEQ );
+        if( JET_errRecordNotFound == err )
+        {
+            m_fSeekNext = fTrue;
+            err = JET_errSuccess;
+        }
+        Call( err );
+        m_fCurrency = fFalse;
+    }
+
+    OSMemoryHeapFree( m_rgentry );
+    m_rgentry = NULL;
+    m_centry = 0;
+    m_centryUsed = 0;
+    m_centryDeleted = 0;
+
+    return JET_errSuccess;
+
+HandleError:
+    if( JET_tableidNil != m_tableid )
+    {
+        CallS( ErrDispCloseTable( m_sesid, m_tableid ) );
+        m_tableid = JET_tableidNil;
+    }
+    m_crecords = m_centryUsed;
+    m_fSeekNext = fFalse;
+
+    //  restore the hash table from the sorted entries
+
+    if( ErrRehash_( m_centry ) < JET_errSuccess )
+    {
+        OSMemoryHeapFree( m_rgentry );
+        m_rgentry = NULL;
+        m_centry = 0;
+        m_centryUsed = 0;
+        m_centryDeleted = 0;
+        m_crecords = 0;
+    }
+    return err;
+}
+
+
+ERR TTMAP::ErrOpenTempTable_()
 {
     ERR err = JET_errSuccess;
 
@@ -99,6 +363,20 @@ ERR TTMAP::ErrRetrieveValue_( const unsigned __int64 ui64Key, ULONG * const pulV
 {
     ERR err = JET_errSuccess;
 
+    if( FInMemory_() )
+    {
+        const ENTRY * const pentry = PentryFind_( ui64Key );
+        if( NULL == pentry )
+        {
+            return ErrERRCheck( JET_errRecordNotFound );
+        }
+        if( pulValue )
+        {
+            *pulValue = pentry->ulValue;
+        }
+        return JET_errSuccess;
+    }
+
     if( JET_tableidNil == m_tableid )
     {
         return ErrERRCheck( JET_errInternalError );
@@ -133,6 +411,17 @@ ERR TTMAP::ErrIncrementValue( const unsigned __int64 ui64Key )
     ERR     err         = JET_errSuccess;
     BOOL    fUpdatePrepared = fFalse;
 
+    if( FInMemory_() )
+    {
+        ENTRY * const pentry = PentryFind_( ui64Key );
+        if( NULL == pentry )
+        {
+            return ErrInsertEntry_( ui64Key, 1 );
+        }
+        ++pentry->ulValue;
+        return JET_errSuccess;
+    }
+
     CallR( ErrDIRBeginTransaction( (PIB*) m_sesid, 43045, NO_GRBIT ) );
 
     Call( ErrDispMakeKey( m_sesid, m_tableid, (BYTE *)&ui64Key, sizeof( ui64Key ), JET_bitNewKey ) );
@@ -192,6 +481,17 @@ ERR TTMAP::ErrSetValue( const unsigned __int64 ui64Key, const ULONG ulValue )
     ERR     err         = JET_errSuccess;
     BOOL    fUpdatePrepared = fFalse;
 
+    if( FInMemory_() )
+    {
+        ENTRY * const pentry = PentryFind_( ui64Key );
+        if( NULL == pentry )
+        {
+            return ErrInsertEntry_( ui64Key, ulValue );
+        }
+        pentry->ulValue = ulValue;
+        return JET_errSuccess;
+    }
+
     if( JET_tableidNil == m_tableid )
     {
         return ErrERRCheck( JET_errInternalError );
@@ -245,11 +545,33 @@ ERR TTMAP::ErrGetCurrentKeyValue( unsigned __int64 * const pui64Key, ULONG * con
 {
     ERR err = JET_errSuccess;
 
+    if( FInMemory_() )
+    {
+        if( !m_fCurrency )
+        {
+            return ErrERRCheck( JET_errNoCurrentRecord );
+        }
+
+        const ENTRY * const pentry = PentryFind_( m_ui64KeyCurrent );
+        if( NULL == pentry )
+        {
+            return ErrERRCheck( JET_errRecordDeleted );
+        }
+        *pui64Key = pentry->ui64Key;
+        *pulValue = pentry->ulValue;
+        return JET_errSuccess;
+    }
+
     if( JET_tableidNil == m_tableid )
     {
         return ErrERRCheck( JET_errInternalError );
     }
 
+    if( m_fSeekNext )
+    {
+        return ErrERRCheck( JET_errRecordDeleted );
+    }
+
     CallR( ErrDIRBeginTransaction( (PIB*) m_sesid, 34853, NO_GRBIT ) );
 
     ULONG cbActual;
@@ -283,6 +605,21 @@ ERR TTMAP::ErrDeleteKey( const unsigned __int64 ui64Key )
 {
     ERR err = JET_errSuccess;
 
+    if( FInMemory_() )
+    {
+        ENTRY * const pentry = PentryFind_( ui64Key );
+        if( NULL == pentry )
+        {
+            return ErrERRCheck( JET_errRecordNotFound );
+        }
+        pentry->ulState = entryDeleted;
+        m_centryUsed--;
+        m_centryDeleted++;
+        --m_crecords;
+        m_fSortedStale = fTrue;
+        return JET_errSuccess;
+    }
+
     if( JET_tableidNil == m_tableid )
     {
         return ErrERRCheck( JET_errInternalError );
@@ -307,11 +644,39 @@ HandleError:
 
 ERR TTMAP::ErrMoveFirst()
 {
+    if( FInMemory_() )
+    {
+        m_fCurrency = fFalse;
+        if( m_fSortedStale )
+        {
+            //  sorting may spill us to the temp table
+
+            const ERR errSort = ErrSortKeys_();
+            if( errSort < JET_errSuccess )
+            {
+                return errSort;
+            }
+        }
+    }
+
+    if( FInMemory_() )
+    {
+        if( 0 == m_cui64KeySorted )
+        {
+            return ErrERRCheck( JET_errNoCurrentRecord );
+        }
+        m_iui64KeyCurrent   = 0;
+        m_ui64KeyCurrent    = m_rgui64KeySorted[ 0 ];
+        m_fCurrency         = fTrue;
+        return JET_errSuccess;
+    }
+
     if( JET_tableidNil == m_tableid )
     {
         return ErrERRCheck( JET_errInternalError );
     }
 
+    m_fSeekNext = fFalse;
     FUCBSetSequential( (FUCB *)m_tableid );
     FUCBSetPrereadForward( (FUCB *)m_tableid, cpgPrereadSequential );
     return ErrDispMove( m_sesid, m_tableid, JET_MoveFirst, NO_GRBIT );
@@ -320,17 +685,68 @@ ERR TTMAP::ErrMoveFirst()
 
 ERR TTMAP::ErrMoveNext()
 {
+    if( FInMemory_() )
+    {
+        if( !m_fCurrency )
+        {
+            return ErrMoveFirst();
+        }
+        if( m_fSortedStale )
+        {
+            //  sorting may spill us to the temp table
+
+            const ERR errSort = ErrSortKeys_();
+            if( errSort < JET_errSuccess )
+            {
+                return errSort;
+            }
+            if( FInMemory_() )
+            {
+                m_iui64KeyCurrent = ULONG( std::upper_bound( m_rgui64KeySorted, m_rgui64KeySorted + m_cui64KeySorted, m_ui64KeyCurrent ) - m_rgui64KeySorted );
+            }
+        }
+        else
+        {
+            m_iui64KeyCurrent++;
+        }
+    }
+
+    if( FInMemory_() )
+    {
+        if( m_iui64KeyCurrent >= m_cui64KeySorted )
+        {
+            m_fCurrency = fFalse;
+            return ErrERRCheck( JET_errNoCurrentRecord );
+        }
+        m_ui64KeyCurrent = m_rgui64KeySorted[ m_iui64KeyCurrent ];
+        return JET_errSuccess;
+    }
+
     if( JET_tableidNil == m_tableid )
     {
         return ErrERRCheck( JET_errInternalError );
     }
 
+    if( m_fSeekNext )
+    {
+        m_fSeekNext = fFalse;
+        CallS( ErrDispMakeKey( m_sesid, m_tableid, (BYTE *)&m_ui64KeyCurrent, sizeof( m_ui64KeyCurrent ), JET_bitNewKey ) );
+        const ERR errSeek = ErrDispSeek( m_sesid, m_tableid, JET_bitSeekGT );
+        return JET_errRecordNotFound == errSeek ? ErrERRCheck( JET_errNoCurrentRecord ) : errSeek;
+    }
+
     return ErrDispMove( m_sesid, m_tableid, JET_MoveNext, NO_GRBIT );
 }
 
 
 ERR TTMAP::ErrFEmpty( BOOL * const pfEmpty ) const
 {
+    if( FInMemory_() )
+    {
+        *pfEmpty = ( 0 == m_centryUsed );
+        return JET_errSuccess;
+    }
+
     if( JET_tableidNil == m_tableid )
     {
         return ErrERRCheck( JET_errInternalError );
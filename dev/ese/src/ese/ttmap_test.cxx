@@ -0,0 +1,201 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "std.hxx"
+
+#ifndef ENABLE_JET_UNIT_TEST
+#error This file should only be compiled with the unit tests!
+#endif
+
+const ULONG ckeyTTMapTest   = 20000;
+
+LOCAL unsigned __int64 Ui64TTMapTestIKey( const ULONG ikey )
+{
+    return (unsigned __int64)ikey * 0x10001 + 17;
+}
+
+class TTMapTestFixture : public JetTestFixture
+{
+    protected:
+        JetTestDatabase     m_db;
+
+    public:
+        TTMapTestFixture() {}
+        ~TTMapTestFixture() {}
+
+    protected:
+        bool SetUp_()
+        {
+            return m_db.ErrInit( L"TTMapTest", JetTestDatabase::bitNoDatabase ) >= JET_errSuccess;
+        }
+
+        void TearDown_()
+        {
+            CHECKCALLS( m_db.ErrTerm() );
+        }
+
+        VOID Exercise( const ULONG cbMemoryMost );
+        VOID IterateAcrossSpill( const ULONG cbMemoryMost );
+
+    public:
+        void InMemoryAndSpilledMapsAgree();
+        void IterationSurvivesSpill();
+};
+
+VOID TTMapTestFixture::Exercise( const ULONG cbMemoryMost )
+{
+    TTMAP   ttmap( m_db.Ppib(), cbMemoryMost );
+    ULONG   ulValue;
+    BOOL    fEmpty;
+
+    CHECKCALLS( ttmap.ErrInit( m_db.Pinst() ) );
+    CHECKCALLS( ttmap.ErrFEmpty( &fEmpty ) );
+    CHECK( fEmpty );
+    CHECK( JET_errNoCurrentRecord == ttmap.ErrMoveFirst() );
+
+    for ( ULONG i = 0; i < ckeyTTMapTest; i++ )
+    {
+        const ULONG ikey = ( i * 7919 ) % ckeyTTMapTest;
+
+        for ( ULONG iIncrement = 0; iIncrement <= ikey % 3; iIncrement++ )
+        {
+            CHECKCALLS( ttmap.ErrIncrementValue( Ui64TTMapTestIKey( ikey ) ) );
+        }
+    }
+
+    CHECK( JET_errKeyDuplicate == ttmap.ErrInsertKeyValue( Ui64TTMapTestIKey( 5 ), 1 ) );
+    CHECKCALLS( ttmap.ErrInsertKeyValue( Ui64TTMapTestIKey( ckeyTTMapTest + 1 ), 42 ) );
+    CHECKCALLS( ttmap.ErrGetValue( Ui64TTMapTestIKey( ckeyTTMapTest + 1 ), &ulValue ) );
+    CHECK( 42 == ulValue );
+    CHECKCALLS( ttmap.ErrSetValue( Ui64TTMapTestIKey( ckeyTTMapTest + 1 ), ( ckeyTTMapTest + 1 ) % 3 + 1 ) );
+
+    for ( ULONG ikey = 0; ikey < ckeyTTMapTest; ikey += 10 )
+    {
+        CHECKCALLS( ttmap.ErrDeleteKey( Ui64TTMapTestIKey( ikey ) ) );
+    }
+    CHECK( JET_errRecordNotFound == ttmap.ErrDeleteKey( Ui64TTMapTestIKey( 0 ) ) );
+    CHECK( JET_errRecordNotFound == ttmap.ErrGetValue( Ui64TTMapTestIKey( 10 ), &ulValue ) );
+    CHECK( JET_errRecordNotFound == ttmap.ErrGetValue( Ui64TTMapTestIKey( 0 ) + 1, &ulValue ) );
+
+    CHECKCALLS( ttmap.ErrFEmpty( &fEmpty ) );
+    CHECK( !fEmpty );
+
+    ULONG   ikeyExpected    = 1;
+    ULONG   ckeySeen        = 0;
+    ERR     err;
+
+    for ( err = ttmap.ErrMoveFirst(); JET_errSuccess == err; err = ttmap.ErrMoveNext() )
+    {
+        unsigned __int64    ui64Key;
+
+        CHECKCALLS( ttmap.ErrGetCurrentKeyValue( &ui64Key, &ulValue ) );
+        CHECK( Ui64TTMapTestIKey( ikeyExpected ) == ui64Key );
+        CHECK( ikeyExpected % 3 + 1 == ulValue );
+
+        ckeySeen++;
+        ikeyExpected++;
+        if ( 0 == ikeyExpected % 10 )
+        {
+            ikeyExpected++;
+        }
+    }
+    CHECK( JET_errNoCurrentRecord == err );
+    CHECK( ckeyTTMapTest - ckeyTTMapTest / 10 + 1 == ckeySeen );
+}
+
+void TTMapTestFixture::InMemoryAndSpilledMapsAgree()
+{
+    Exercise( cbTTMAPMemoryMostDefault );
+    Exercise( 64 * 1024 );
+    Exercise( 0 );
+}
+
+static const JetTestCaller<TTMapTestFixture> ttmap1(
+    "TTMAP.InMemoryAndSpilledMapsAgree",
+    &TTMapTestFixture::InMemoryAndSpilledMapsAgree );
+
+//  Deletes the current key and then inserts enough keys to spill the map to its temp table.
+//  The iteration must resume at the first key after the deleted one.
+
+VOID TTMapTestFixture::IterateAcrossSpill( const ULONG cbMemoryMost )
+{
+    const ULONG         ckeyInitial     = 700;
+    const ULONG         ikeyDelete      = 5;
+    const ULONG         ikeyAppend      = 1000;
+    const ULONG         ckeyAppend      = 100;
+    TTMAP               ttmap( m_db.Ppib(), cbMemoryMost );
+    unsigned __int64    ui64Key;
+    ULONG               ulValue;
+    ULONG               ikeyExpected;
+    ULONG               ckeySeen        = 0;
+    ERR                 err;
+
+    CHECKCALLS( ttmap.ErrInit( m_db.Pinst() ) );
+    for ( ULONG ikey = 0; ikey < ckeyInitial; ikey++ )
+    {
+        CHECKCALLS( ttmap.ErrInsertKeyValue( Ui64TTMapTestIKey( ikey ), ikey ) );
+    }
+
+    CHECKCALLS( ttmap.ErrMoveFirst() );
+    for ( ULONG ikey = 0; ikey < ikeyDelete; ikey++ )
+    {
+        CHECKCALLS( ttmap.ErrMoveNext() );
+    }
+    CHECKCALLS( ttmap.ErrGetCurrentKeyValue( &ui64Key, &ulValue ) );
+    CHECK( Ui64TTMapTestIKey( ikeyDelete ) == ui64Key );
+
+    CHECKCALLS( ttmap.ErrDeleteKey( ui64Key ) );
+    for ( ULONG ikey = ikeyAppend; ikey < ikeyAppend + ckeyAppend; ikey++ )
+    {
+        CHECKCALLS( ttmap.ErrInsertKeyValue( Ui64TTMapTestIKey( ikey ), ikey ) );
+    }
+    CHECK( JET_errRecordDeleted == ttmap.ErrGetCurrentKeyValue( &ui64Key, &ulValue ) );
+
+    ikeyExpected = ikeyDelete + 1;
+    for ( err = ttmap.ErrMoveNext(); JET_errSuccess == err; err = ttmap.ErrMoveNext() )
+    {
+        CHECKCALLS( ttmap.ErrGetCurrentKeyValue( &ui64Key, &ulValue ) );
+        CHECK( Ui64TTMapTestIKey( ikeyExpected ) == ui64Key );
+        CHECK( ikeyExpected == ulValue );
+
+        ckeySeen++;
+        ikeyExpected = ( ckeyInitial - 1 == ikeyExpected ) ? ikeyAppend : ikeyExpected + 1;
+    }
+    CHECK( JET_errNoCurrentRecord == err );
+    CHECK( ckeyInitial - ikeyDelete - 1 + ckeyAppend == ckeySeen );
+}
+
+void TTMapTestFixture::IterationSurvivesSpill()
+{
+    //  the first growth of the hash table does not fit in 32KB
+
+    IterateAcrossSpill( 32 * 1024 );
+
+    //  the sorted key snapshot does not fit in 20KB either, so ErrMoveFirst spills
+
+    TTMAP   ttmap( m_db.Ppib(), 20 * 1024 );
+    ULONG   ckeySeen    = 0;
+    ERR     err;
+
+    CHECKCALLS( ttmap.ErrInit( m_db.Pinst() ) );
+    for ( ULONG ikey = 0; ikey < 700; ikey++ )
+    {
+        CHECKCALLS( ttmap.ErrInsertKeyValue( Ui64TTMapTestIKey( ikey ), ikey ) );
+    }
+    for ( err = ttmap.ErrMoveFirst(); JET_errSuccess == err; err = ttmap.ErrMoveNext() )
+    {
+        unsigned __int64    ui64Key;
+        ULONG               ulValue;
+
+        CHECKCALLS( ttmap.ErrGetCurrentKeyValue( &ui64Key, &ulValue ) );
+        CHECK( Ui64TTMapTestIKey( ckeySeen ) == ui64Key );
+        CHECK( ckeySeen == ulValue );
+        ckeySeen++;
+    }
+    CHECK( JET_errNoCurrentRecord == err );
+    CHECK( 700 == ckeySeen );
+}
+
+static const JetTestCaller<TTMapTestFixture> ttmap2(
+    "TTMAP.IterationSurvivesSpill",
+    &TTMapTestFixture::IterationSurvivesSpill );
@@ -18,15 +18,28 @@
 
 BOOL FResCloseToQuota( INST * const pinst, JET_RESID resid );
 
+enum RCECHAINLEN
+{
+    rcechainlen0To1 = 0,
+    rcechainlen2To3,
+    rcechainlen4To7,
+    rcechainlen8To15,
+    rcechainlen16Plus,
+    rcechainlenMax
+};
+
 #ifdef PERFMON_SUPPORT
 
 
 PERFInstanceDelayedTotal<> cVERcbucketAllocated;
 PERFInstanceDelayedTotal<> cVERcbucketDeleteAllocated;
 PERFInstanceDelayedTotal<> cVERBucketAllocWaitForRCEClean;
+PERFInstanceDelayedTotal<> cVERBucketChainContended;
 PERFInstanceDelayedTotal<> cVERcbBookmarkTotal;
 PERFInstanceDelayedTotal<> cVERcrceHashEntries;
 PERFInstanceDelayedTotal<> cVERUnnecessaryCalls;
+PERFInstanceDelayedTotal<> cVERRCEChainSplits;
+PERFInstanceDelayedTotal<> cVERRCEChainLookups[ rcechainlenMax ];
 PERFInstanceDelayedTotal<> cVERAsyncCleanupDispatched;
 PERFInstanceDelayedTotal<> cVERSyncCleanupDispatched;
 PERFInstanceDelayedTotal<> cVERCleanupDiscarded;
@@ -66,6 +79,13 @@ LONG LVERBucketAllocWaitForRCECleanCEFLPv( LONG iInstance, VOID * pvBuf )
 }
 
 
+LONG LVERBucketChainContendedCEFLPv( LONG iInstance, VOID * pvBuf )
+{
+    cVERBucketChainContended.PassTo( iInstance, pvBuf );
+    return 0;
+}
+
+
 LONG LVERcbAverageBookmarkCEFLPv( LONG iInstance, VOID * pvBuf )
 {
     if ( NULL != pvBuf )
@@ -121,6 +141,42 @@ LONG LVERCleanupFailedCEFLPv( LONG iInstance, VOID * pvBuf )
     return 0;
 }
 
+LONG LVERRCEChainSplitsCEFLPv( LONG iInstance, VOID * pvBuf )
+{
+    cVERRCEChainSplits.PassTo( iInstance, pvBuf );
+    return 0;
+}
+
+LONG LVERRCEChainLookups0To1CEFLPv( LONG iInstance, VOID * pvBuf )
+{
+    cVERRCEChainLookups[ rcechainlen0To1 ].PassTo( iInstance, pvBuf );
+    return 0;
+}
+
+LONG LVERRCEChainLookups2To3CEFLPv( LONG iInstance, VOID * pvBuf )
+{
+    cVERRCEChainLookups[ rcechainlen2To3 ].PassTo( iInstance, pvBuf );
+    return 0;
+}
+
+LONG LVERRCEChainLookups4To7CEFLPv( LONG iInstance, VOID * pvBuf )
+{
+    cVERRCEChainLookups[ rcechainlen4To7 ].PassTo( iInstance, pvBuf );
+    return 0;
+}
+
+LONG LVERRCEChainLookups8To15CEFLPv( LONG iInstance, VOID * pvBuf )
+{
+    cVERRCEChainLookups[ rcechainlen8To15 ].PassTo( iInstance, pvBuf );
+    return 0;
+}
+
+LONG LVERRCEChainLookups16PlusCEFLPv( LONG iInstance, VOID * pvBuf )
+{
+    cVERRCEChainLookups[ rcechainlen16Plus ].PassTo( iInstance, pvBuf );
+    return 0;
+}
+
 #endif
 
 
@@ -136,6 +192,8 @@ static const INT cbatchesMaxDefault = 128;
 static const INT ctasksPerBatchMaxDefault = 1024;
 static const INT ctasksBatchedMaxDefault = 4096;
 
+static const DWORD_PTR cbucketPerBucketChainMin = 16;
+
 VER::VER( INST *pinst )
     :   CZeroInit( sizeof( VER ) ),
         m_pinst( pinst ),
@@ -143,7 +201,6 @@ VER::VER( INST *pinst )
         m_msigRCECleanPerformedRecently( CSyncBasicInfo( _T( "m_msigRCECleanPerformedRecently" ) ) ),
         m_asigRCECleanDone( CSyncBasicInfo( _T( "m_asigRCECleanDone" ) ) ),
         m_critRCEClean( CLockBasicInfo( CSyncBasicInfo( szRCEClean ), rankRCEClean, 0 ) ),
-        m_critBucketGlobal( CLockBasicInfo( CSyncBasicInfo( szBucketGlobal ), rankBucketGlobal, 0 ) ),
 #ifdef VERPERF
         m_critVERPerf( CLockBasicInfo( CSyncBasicInfo( szVERPerf ), rankVERPerf, 0 ) ),
 #endif
@@ -194,7 +251,7 @@ INLINE BOOL VER::FVERICleanDiscardDeletes()
     {
         fDiscardDeletes = fTrue;
     }
-    else if ( m_pbucketGlobalHead != m_pbucketGlobalTail
+    else if ( cbucket > 1
             && ( cbucketMost - cbucket ) < 2 )
     {
         fDiscardDeletes = fTrue;
@@ -246,7 +303,7 @@ VOID VER::VERIReportDiscardedDeletes( const RCE * const prce )
 
 VOID VER::VERIReportVersionStoreOOM( PIB * ppibTrxOldest, BOOL fMaxTrxSize, const BOOL fCleanupWasRun )
 {
-    Assert( m_critBucketGlobal.FOwner() );
+    Assert( FInCritBucket( this ) );
     Expected( ppibTrxOldest || !fMaxTrxSize );
 
     BOOL            fLockedTrxOldest = fFalse;
@@ -419,12 +476,59 @@ VOID VER::VERIReportVersionStoreOOM( PIB * ppibTrxOldest, BOOL fMaxTrxSize, cons
 }
 
 
-INLINE ERR VER::ErrVERIBUAllocBucket( const INT cbRCE, const UINT uiHash )
+INLINE size_t VER::IbucketchainVERIGet()
 {
-    Assert( m_critBucketGlobal.FOwner() );
+    Assert( m_cbucketchain > 0 );
+    Assert( m_cbucketchain <= cbucketchainMax );
+
+    if ( m_cbucketchain == 1 || m_pinst->m_plog->FRecovering() )
+    {
+        return 0;
+    }
+
+    //  tests pin RCE creation to one chain (1-based so that 0 means no override)
 
-    Assert( m_pbucketGlobalHead == pbucketNil
-        || (size_t)cbRCE > CbBUFree( m_pbucketGlobalHead ) );
+    const size_t ibucketchainOverride = (size_t)UlConfigOverrideInjection( 47308, 0 );
+    if ( ibucketchainOverride != 0 )
+    {
+        return ( ibucketchainOverride - 1 ) % m_cbucketchain;
+    }
+
+    return (size_t)OSSyncGetCurrentProcessor() % m_cbucketchain;
+}
+
+INLINE VOID VER::VERIEnterBucketChain( const size_t ibucketchain )
+{
+    BUCKETCHAIN * const pbucketchain = m_rgbucketchain + ibucketchain;
+
+    if ( !pbucketchain->crit.FTryEnter() )
+    {
+        PERFOpt( cVERBucketChainContended.Inc( m_pinst ) );
+        pbucketchain->crit.Enter();
+    }
+}
+
+BOOL VER::FVERBucketsAllocated()
+{
+    for ( size_t ibucketchain = 0; ibucketchain < m_cbucketchain; ibucketchain++ )
+    {
+        if ( pbucketNil != m_rgbucketchain[ ibucketchain ].pbucketTail )
+        {
+            return fTrue;
+        }
+    }
+
+    return fFalse;
+}
+
+INLINE ERR VER::ErrVERIBUAllocBucket( const size_t ibucketchain, const INT cbRCE, const UINT uiHash )
+{
+    BUCKETCHAIN * const pbucketchain = m_rgbucketchain + ibucketchain;
+
+    Assert( pbucketchain->crit.FOwner() );
+
+    Assert( pbucketchain->pbucketHead == pbucketNil
+        || (size_t)cbRCE > CbBUFree( pbucketchain->pbucketHead ) );
 
     VERSignalCleanup();
 
@@ -432,7 +536,7 @@ INLINE ERR VER::ErrVERIBUAllocBucket( const INT cbRCE, const UINT uiHash )
 
     if ( pbucketNil == pbucket )
     {
-        m_critBucketGlobal.Leave();
+        pbucketchain->crit.Leave();
 
         if ( uiHashInvalid != uiHash )
         {
@@ -448,9 +552,9 @@ INLINE ERR VER::ErrVERIBUAllocBucket( const INT cbRCE, const UINT uiHash )
             RwlRCEChain( uiHash ).EnterAsWriter();
         }
 
-        m_critBucketGlobal.Enter();
+        pbucketchain->crit.Enter();
 
-        if ( m_pbucketGlobalHead == pbucketNil || (size_t)cbRCE > CbBUFree( m_pbucketGlobalHead ) )
+        if ( pbucketchain->pbucketHead == pbucketNil || (size_t)cbRCE > CbBUFree( pbucketchain->pbucketHead ) )
         {
             pbucket = new( this ) BUCKET( this );
 
@@ -473,16 +577,16 @@ INLINE ERR VER::ErrVERIBUAllocBucket( const INT cbRCE, const UINT uiHash )
     Assert( FAlignedForThisPlatform( pbucket->rgb ) );
     Assert( (BYTE *)PvAlignForThisPlatform( pbucket->rgb ) == pbucket->rgb );
 
-    pbucket->hdr.pbucketPrev = m_pbucketGlobalHead;
+    pbucket->hdr.pbucketPrev = pbucketchain->pbucketHead;
     if ( pbucket->hdr.pbucketPrev )
     {
         pbucket->hdr.pbucketPrev->hdr.pbucketNext = pbucket;
     }
     else
     {
-        m_pbucketGlobalTail = pbucket;
+        pbucketchain->pbucketTail = pbucket;
     }
-    m_pbucketGlobalHead = pbucket;
+    pbucketchain->pbucketHead = pbucket;
 
     PERFOpt( cVERcbucketAllocated.Inc( m_pinst ) );
 #ifdef BREAK_ON_PREFERRED_BUCKET_LIMIT
@@ -513,47 +617,49 @@ INLINE ERR VER::ErrVERIBUAllocBucket( const INT cbRCE, const UINT uiHash )
 }
 
 
-INLINE BUCKET *VER::PbucketVERIGetOldest( )
+INLINE BUCKET *VER::PbucketVERIGetOldest( const size_t ibucketchain )
 {
-    Assert( m_critBucketGlobal.FOwner() );
+    Assert( m_rgbucketchain[ ibucketchain ].crit.FOwner() );
 
-    BUCKET  * const pbucket = m_pbucketGlobalTail;
+    BUCKET  * const pbucket = m_rgbucketchain[ ibucketchain ].pbucketTail;
 
     Assert( pbucketNil == pbucket || pbucketNil == pbucket->hdr.pbucketPrev );
     return pbucket;
 }
 
 
-BUCKET *VER::PbucketVERIFreeAndGetNextOldestBucket( BUCKET * pbucket )
+BUCKET *VER::PbucketVERIFreeAndGetNextOldestBucket( const size_t ibucketchain, BUCKET * pbucket )
 {
-    Assert( m_critBucketGlobal.FOwner() );
+    BUCKETCHAIN * const pbucketchain = m_rgbucketchain + ibucketchain;
+
+    Assert( pbucketchain->crit.FOwner() );
 
     BUCKET * const pbucketNext = (BUCKET *)pbucket->hdr.pbucketNext;
     BUCKET * const pbucketPrev = (BUCKET *)pbucket->hdr.pbucketPrev;
 
     if ( pbucketNil != pbucketNext )
     {
-        Assert( m_pbucketGlobalHead != pbucket );
+        Assert( pbucketchain->pbucketHead != pbucket );
         pbucketNext->hdr.pbucketPrev = pbucketPrev;
     }
     else
     {
-        Assert( m_pbucketGlobalHead == pbucket );
-        m_pbucketGlobalHead = pbucketPrev;
+        Assert( pbucketchain->pbucketHead == pbucket );
+        pbucketchain->pbucketHead = pbucketPrev;
     }
 
     if ( pbucketNil != pbucketPrev )
     {
-        Assert( m_pbucketGlobalTail != pbucket );
+        Assert( pbucketchain->pbucketTail != pbucket );
         pbucketPrev->hdr.pbucketNext = pbucketNext;
     }
     else
     {
-        m_pbucketGlobalTail = pbucketNext;
+        pbucketchain->pbucketTail = pbucketNext;
     }
 
-    Assert( ( m_pbucketGlobalHead && m_pbucketGlobalTail )
-            || ( !m_pbucketGlobalHead && !m_pbucketGlobalTail ) );
+    Assert( ( pbucketchain->pbucketHead && pbucketchain->pbucketTail )
+            || ( !pbucketchain->pbucketHead && !pbucketchain->pbucketTail ) );
 
     delete pbucket;
     PERFOpt( cVERcbucketAllocated.Dec( m_pinst ) );
@@ -575,32 +681,208 @@ BUCKET *VER::PbucketVERIFreeAndGetNextOldestBucket( BUCKET * pbucket )
 }
 
 
+//  each RCEHEAD is a lock stripe selected by uiHash modulo the table size; the
+//  chains under a stripe are a linear hash table that splits one chain at a
+//  time (under the stripe's writer lock) as the number of nodes grows, so RCEs
+//  can keep their uiHash and lock stripe for their whole lifetime.  a stripe
+//  keeps its single chain in prceChain until its first split, which allocates
+//  the RCECHAINS holding the chain array and the node count
+
+INLINE UINT VER::IrceheadRCEChain( UINT ui ) const
+{
+    return UINT( ui % m_crceheadHashTable );
+}
+
+UINT VER::IprceRCEChain( const RCECHAINS * const prcechains, UINT ui )
+{
+    if ( NULL == prcechains )
+    {
+        return 0;
+    }
+
+    ui ^= ui >> 16;
+    ui *= 0x85ebca6b;
+    ui ^= ui >> 13;
+
+    UINT iprceChain = ui & prcechains->uiMaskChain;
+    if ( iprceChain >= prcechains->cprceChain )
+    {
+        iprceChain &= prcechains->uiMaskChain >> 1;
+    }
+
+    Assert( iprceChain < prcechains->cprceChain );
+    return iprceChain;
+}
+
+INLINE UINT VER::IprceRCEChain( UINT ui ) const
+{
+    return IprceRCEChain( m_rgrceheadHashTable[ IrceheadRCEChain( ui ) ].prcechains, ui );
+}
+
 INLINE CReaderWriterLock& VER::RwlRCEChain( UINT ui )
 {
     Assert( m_frceHashTableInited );
-    Assert( ui < m_crceheadHashTable );
-    return m_rgrceheadHashTable[ ui ].rwl;
+    return m_rgrceheadHashTable[ IrceheadRCEChain( ui ) ].rwl;
 }
 
 INLINE RCE *VER::GetChain( UINT ui ) const
 {
     Assert( m_frceHashTableInited );
-    Assert( ui < m_crceheadHashTable );
-    return m_rgrceheadHashTable[ ui ].prceChain;
+    const RCEHEAD * const prcehead = &m_rgrceheadHashTable[ IrceheadRCEChain( ui ) ];
+    Assert( prcehead->rwl.FReader() || prcehead->rwl.FWriter() );
+    return ( NULL == prcehead->prcechains ) ?
+                prcehead->prceChain :
+                prcehead->prcechains->rgprceChain[ IprceRCEChain( ui ) ];
 }
 
 INLINE RCE **VER::PGetChain( UINT ui )
 {
     Assert( m_frceHashTableInited );
-    Assert( ui < m_crceheadHashTable );
-    return &m_rgrceheadHashTable[ ui ].prceChain;
+    RCEHEAD * const prcehead = &m_rgrceheadHashTable[ IrceheadRCEChain( ui ) ];
+    Assert( prcehead->rwl.FReader() || prcehead->rwl.FWriter() );
+    return ( NULL == prcehead->prcechains ) ?
+                &prcehead->prceChain :
+                &prcehead->prcechains->rgprceChain[ IprceRCEChain( ui ) ];
 }
 
 INLINE VOID VER::SetChain( UINT ui, RCE *prce )
+{
+    Assert( RwlRCEChain( ui ).FWriter() );
+    *PGetChain( ui ) = prce;
+}
+
+//  peeks at the stripe without its lock.  prceChain is read before prcechains because
+//  the first split publishes prcechains before it clears prceChain
+
+INLINE BOOL VER::FRCEChainEmpty( UINT ui ) const
 {
     Assert( m_frceHashTableInited );
-    Assert( ui < m_crceheadHashTable );
-    m_rgrceheadHashTable[ ui ].prceChain = prce;
+    const RCEHEAD * const       prcehead    = &m_rgrceheadHashTable[ IrceheadRCEChain( ui ) ];
+    const RCE * const           prceChain   = *(RCE * volatile *)&prcehead->prceChain;
+    const RCECHAINS * const     prcechains  = prcehead->prcechains;
+
+    return ( NULL == prcechains ) ? ( prceNil == prceChain ) : ( 0 == prcechains->cnode );
+}
+
+VOID VER::VERIRCEChainNodeInserted( UINT ui )
+{
+    RCEHEAD * const prcehead = &m_rgrceheadHashTable[ IrceheadRCEChain( ui ) ];
+    Assert( prcehead->rwl.FWriter() );
+
+    RCECHAINS * prcechains = prcehead->prcechains;
+
+    if ( NULL == prcechains )
+    {
+        //  an unsplit stripe has no node count; its single chain is at most
+        //  cnodePerChainMost + 1 nodes long so we just count it
+
+        UINT cnode = 0;
+        for ( const RCE * prce = prcehead->prceChain; prceNil != prce; prce = prce->PrceHashOverflow() )
+        {
+            cnode++;
+        }
+
+        if ( cnode <= cnodePerChainMost )
+        {
+            return;
+        }
+
+        prcechains = new RCECHAINS;
+        if ( NULL == prcechains )
+        {
+            //  keep the single chain, we will retry on the next insert
+            return;
+        }
+
+        prcechains->rgprceChain = (RCE **)PvOSMemoryHeapAlloc( cprceChainInitial * sizeof( RCE * ) );
+        if ( NULL == prcechains->rgprceChain )
+        {
+            delete prcechains;
+            return;
+        }
+
+        memset( prcechains->rgprceChain, 0, cprceChainInitial * sizeof( RCE * ) );
+        prcechains->rgprceChain[ 0 ] = prcehead->prceChain;
+        prcechains->cprceChainMax = cprceChainInitial;
+        prcechains->cnode = cnode;
+
+        AtomicExchangePointer( (void **)&prcehead->prcechains, prcechains );
+        *(RCE * volatile *)&prcehead->prceChain = prceNil;
+    }
+    else
+    {
+        prcechains->cnode++;
+
+        if ( prcechains->cnode <= cnodePerChainMost * prcechains->cprceChain
+            || prcechains->cprceChain >= cprceChainMost )
+        {
+            return;
+        }
+
+        if ( prcechains->cprceChain == prcechains->cprceChainMax )
+        {
+            const UINT cprceChainMaxNew = 2 * prcechains->cprceChainMax;
+            RCE ** const rgprceChainNew = (RCE **)PvOSMemoryHeapAlloc( cprceChainMaxNew * sizeof( RCE * ) );
+            if ( NULL == rgprceChainNew )
+            {
+                //  keep the current chains, we will retry on the next insert
+                return;
+            }
+
+            memset( rgprceChainNew, 0, cprceChainMaxNew * sizeof( RCE * ) );
+            memcpy( rgprceChainNew, prcechains->rgprceChain, prcechains->cprceChain * sizeof( RCE * ) );
+            OSMemoryHeapFree( prcechains->rgprceChain );
+            prcechains->rgprceChain = rgprceChainNew;
+            prcechains->cprceChainMax = cprceChainMaxNew;
+        }
+    }
+
+    const UINT iprceChainNew = prcechains->cprceChain;
+    if ( iprceChainNew > prcechains->uiMaskChain )
+    {
+        prcechains->uiMaskChain = 2 * prcechains->uiMaskChain + 1;
+    }
+    const UINT iprceChainSplit = iprceChainNew & ( prcechains->uiMaskChain >> 1 );
+    prcechains->cprceChain++;
+
+    RCE ** pprce    = &prcechains->rgprceChain[ iprceChainSplit ];
+    RCE ** pprceNew = &prcechains->rgprceChain[ iprceChainNew ];
+    Assert( prceNil == *pprceNew );
+
+    while ( prceNil != *pprce )
+    {
+        RCE * const prce        = *pprce;
+        const UINT  iprceChain  = IprceRCEChain( prce->UiHash() );
+
+        Assert( prceNil == prce->PrceNextOfNode() );
+        Assert( iprceChainSplit == iprceChain || iprceChainNew == iprceChain );
+
+        if ( iprceChainNew == iprceChain )
+        {
+            *pprce = prce->PrceHashOverflow();
+            prce->SetPrceHashOverflow( prceNil );
+            *pprceNew = prce;
+            pprceNew = &prce->PrceHashOverflow();
+        }
+        else
+        {
+            pprce = &prce->PrceHashOverflow();
+        }
+    }
+
+    PERFOpt( cVERRCEChainSplits.Inc( m_pinst ) );
+}
+
+VOID VER::VERIRCEChainNodeDeleted( UINT ui )
+{
+    RCEHEAD * const prcehead = &m_rgrceheadHashTable[ IrceheadRCEChain( ui ) ];
+    Assert( prcehead->rwl.FWriter() );
+
+    if ( NULL != prcehead->prcechains )
+    {
+        Assert( prcehead->prcechains->cnode > 0 );
+        prcehead->prcechains->cnode--;
+    }
 }
 
 CReaderWriterLock& RCE::RwlChain()
@@ -611,14 +893,11 @@ CReaderWriterLock& RCE::RwlChain()
 }
 
 
-LOCAL UINT UiRCHashFunc( IFMP ifmp, PGNO pgnoFDP, const BOOKMARK& bookmark, const UINT crcehead = 0 )
+LOCAL UINT UiRCHashFunc( IFMP ifmp, PGNO pgnoFDP, const BOOKMARK& bookmark )
 {
     ASSERT_VALID( &bookmark );
     Assert( pgnoNull != pgnoFDP );
 
-    const UINT crceheadHashTable = crcehead ? crcehead : PverFromIfmp( ifmp )->m_crceheadHashTable;
-
-
     UINT uiHash =   (UINT)ifmp
                     + pgnoFDP
                     + bookmark.key.prefix.Cb()
@@ -707,17 +986,20 @@ LOCAL UINT UiRCHashFunc( IFMP ifmp, PGNO pgnoFDP, const BOOKMARK& bookmark, cons
         }
     }
 
-    uiHash %= crceheadHashTable;
+    if ( uiHashInvalid == uiHash )
+    {
+        uiHash--;
+    }
 
     return uiHash;
 }
 
 
-#ifdef DEBUGGER_EXTENSION
+#if defined( DEBUGGER_EXTENSION ) || defined( ENABLE_JET_UNIT_TEST )
 
-UINT UiVERHash( IFMP ifmp, PGNO pgnoFDP, const BOOKMARK& bookmark, const UINT crcehead )
+UINT UiVERHash( IFMP ifmp, PGNO pgnoFDP, const BOOKMARK& bookmark )
 {
-    return UiRCHashFunc( ifmp, pgnoFDP, bookmark, crcehead );
+    return UiRCHashFunc( ifmp, pgnoFDP, bookmark );
 }
 
 #endif
@@ -900,13 +1182,15 @@ ERR VER::ErrCheckRCEChain( const RCE * const prce, const UINT uiHash ) const
 }
 
 
-ERR VER::ErrCheckRCEHashList( const RCE * const prce, const UINT uiHash ) const
+ERR VER::ErrCheckRCEHashList( const RCE * const prce, const UINT ircehead, const UINT iprceChain ) const
 {
     ERR err = JET_errSuccess;
     const RCE * prceT = prce;
     for ( ; prceNil != prceT; prceT = prceT->PrceHashOverflow() )
     {
-        CallR( ErrCheckRCEChain( prceT, uiHash ) );
+        AssertRTL( IrceheadRCEChain( prceT->UiHash() ) == ircehead );
+        AssertRTL( IprceRCEChain( prceT->UiHash() ) == iprceChain );
+        CallR( ErrCheckRCEChain( prceT, prceT->UiHash() ) );
     }
     return err;
 }
@@ -915,15 +1199,28 @@ ERR VER::ErrCheckRCEHashList( const RCE * const prce, const UINT uiHash ) const
 ERR VER::ErrInternalCheck()
 {
     ERR err = JET_errSuccess;
-    UINT uiHash = 0;
-    for ( ; uiHash < m_crceheadHashTable; ++uiHash )
+    for ( UINT ircehead = 0; ircehead < m_crceheadHashTable; ++ircehead )
     {
-        if( NULL != GetChain( uiHash ) )
+        RCEHEAD * const prcehead = &m_rgrceheadHashTable[ ircehead ];
+        ENTERREADERWRITERLOCK rwlHashAsReader( &( prcehead->rwl ), fTrue );
+        const RCECHAINS * const prcechains = prcehead->prcechains;
+        if ( NULL == prcechains )
         {
-            ENTERREADERWRITERLOCK rwlHashAsReader( &(RwlRCEChain( uiHash )), fTrue );
-            const RCE * const prce = GetChain( uiHash );
-            CallR( ErrCheckRCEHashList( prce, uiHash ) );
+            CallR( ErrCheckRCEHashList( prcehead->prceChain, ircehead, 0 ) );
+            continue;
         }
+
+        UINT cnode = 0;
+        for ( UINT iprceChain = 0; iprceChain < prcechains->cprceChain; ++iprceChain )
+        {
+            const RCE * const prce = prcechains->rgprceChain[ iprceChain ];
+            CallR( ErrCheckRCEHashList( prce, ircehead, iprceChain ) );
+            for ( const RCE * prceT = prce; prceNil != prceT; prceT = prceT->PrceHashOverflow() )
+            {
+                cnode++;
+            }
+        }
+        AssertRTL( cnode == prcechains->cnode );
     }
     return err;
 }
@@ -1140,6 +1437,43 @@ BOOL RCE::FRCECorrectEDBG( IFMP ifmp, PGNO pgnoFDP, const BOOKMARK& bookmark )
 }
 
 
+#ifdef DEBUG
+
+LOCAL BOOL FVERISameRCEChain( const IFMP ifmp, const UINT uiHash1, const UINT uiHash2 )
+{
+    const VER * const pver = PverFromIfmp( ifmp );
+    return pver->IrceheadRCEChain( uiHash1 ) == pver->IrceheadRCEChain( uiHash2 )
+        && pver->IprceRCEChain( uiHash1 ) == pver->IprceRCEChain( uiHash2 );
+}
+
+#endif
+
+LOCAL INLINE VOID VERIReportRCEChainLookup( const IFMP ifmp, const INT cnode )
+{
+    RCECHAINLEN rcechainlen;
+    if ( cnode < 2 )
+    {
+        rcechainlen = rcechainlen0To1;
+    }
+    else if ( cnode < 4 )
+    {
+        rcechainlen = rcechainlen2To3;
+    }
+    else if ( cnode < 8 )
+    {
+        rcechainlen = rcechainlen4To7;
+    }
+    else if ( cnode < 16 )
+    {
+        rcechainlen = rcechainlen8To15;
+    }
+    else
+    {
+        rcechainlen = rcechainlen16Plus;
+    }
+    PERFOpt( cVERRCEChainLookups[ rcechainlen ].Inc( PinstFromIfmp( ifmp ) ) );
+}
+
 LOCAL RCE **PprceRCEChainGet( UINT uiHash, IFMP ifmp, PGNO pgnoFDP, const BOOKMARK& bookmark )
 {
     Assert( PverFromIfmp( ifmp )->RwlRCEChain( uiHash ).FReader() ||
@@ -1147,22 +1481,27 @@ LOCAL RCE **PprceRCEChainGet( UINT uiHash, IFMP ifmp, PGNO pgnoFDP, const BOOKMA
 
     AssertRTL( UiRCHashFunc( ifmp, pgnoFDP, bookmark ) == uiHash );
 
+    INT cnode = 0;
     RCE **pprceChain = PverFromIfmp( ifmp )->PGetChain( uiHash );
     while ( prceNil != *pprceChain )
     {
         RCE * const prceT = *pprceChain;
 
-        AssertRTL( prceT->UiHash() == uiHash );
+        Assert( FVERISameRCEChain( ifmp, prceT->UiHash(), uiHash ) );
+        cnode++;
 
         if ( FRCECorrect( ifmp, pgnoFDP, bookmark, prceT ) )
         {
+            AssertRTL( prceT->UiHash() == uiHash );
+            VERIReportRCEChainLookup( ifmp, cnode );
+
 #ifdef DEBUG
             Assert( prceNil == prceT->PrcePrevOfNode()
                 || prceT->PrcePrevOfNode()->UiHash() == prceT->UiHash() );
             if ( prceNil == prceT->PrceNextOfNode() )
             {
                 Assert( prceNil == prceT->PrceHashOverflow()
-                    || prceT->PrceHashOverflow()->UiHash() == prceT->UiHash() );
+                    || FVERISameRCEChain( ifmp, prceT->PrceHashOverflow()->UiHash(), prceT->UiHash() ) );
             }
             else
             {
@@ -1182,7 +1521,7 @@ LOCAL RCE **PprceRCEChainGet( UINT uiHash, IFMP ifmp, PGNO pgnoFDP, const BOOKMA
                 }
             }
             else if ( prceNil != prceT->PrceHashOverflow()
-                && prceT->PrceHashOverflow()->UiHash() != prceT->UiHash() )
+                && !FVERISameRCEChain( ifmp, prceT->PrceHashOverflow()->UiHash(), prceT->UiHash() ) )
             {
                 Assert( fFalse );
             }
@@ -1195,6 +1534,7 @@ LOCAL RCE **PprceRCEChainGet( UINT uiHash, IFMP ifmp, PGNO pgnoFDP, const BOOKMA
     }
 
     Assert( prceNil == *pprceChain );
+    VERIReportRCEChainLookup( ifmp, cnode );
     return NULL;
 }
 
@@ -1347,9 +1687,11 @@ INLINE BOOL FVERIAddUndoInfo( const RCE * const prce )
     return fAddUndoInfo;
 }
 
-ERR VER::ErrVERIAllocateRCE( INT cbRCE, RCE ** pprce, const UINT uiHash )
+ERR VER::ErrVERIAllocateRCE( const size_t ibucketchain, INT cbRCE, RCE ** pprce, const UINT uiHash )
 {
-    Assert( m_critBucketGlobal.FOwner() );
+    BUCKETCHAIN * const pbucketchain = m_rgbucketchain + ibucketchain;
+
+    Assert( pbucketchain->crit.FOwner() );
 
     ERR err = JET_errSuccess;
 
@@ -1359,21 +1701,21 @@ ERR VER::ErrVERIAllocateRCE( INT cbRCE, RCE ** pprce, const UINT uiHash )
     }
 
 
-    if ( m_pbucketGlobalHead == pbucketNil || (size_t)cbRCE > CbBUFree( m_pbucketGlobalHead ) )
+    if ( pbucketchain->pbucketHead == pbucketNil || (size_t)cbRCE > CbBUFree( pbucketchain->pbucketHead ) )
     {
-        Call( ErrVERIBUAllocBucket( cbRCE, uiHash ) );
+        Call( ErrVERIBUAllocBucket( ibucketchain, cbRCE, uiHash ) );
     }
-    Assert( (size_t)cbRCE <= CbBUFree( m_pbucketGlobalHead ) );
+    Assert( (size_t)cbRCE <= CbBUFree( pbucketchain->pbucketHead ) );
 
-    Assert( FAlignedForThisPlatform( m_pbucketGlobalHead ) );
+    Assert( FAlignedForThisPlatform( pbucketchain->pbucketHead ) );
 
 
-    *pprce = m_pbucketGlobalHead->hdr.prceNextNew;
-    m_pbucketGlobalHead->hdr.prceNextNew =
+    *pprce = pbucketchain->pbucketHead->hdr.prceNextNew;
+    pbucketchain->pbucketHead->hdr.prceNextNew =
         reinterpret_cast<RCE *>( PvAlignForThisPlatform( reinterpret_cast<BYTE *>( *pprce ) + cbRCE ) );
 
     Assert( FAlignedForThisPlatform( *pprce ) );
-    Assert( FAlignedForThisPlatform( m_pbucketGlobalHead->hdr.prceNextNew ) );
+    Assert( FAlignedForThisPlatform( pbucketchain->pbucketHead->hdr.prceNextNew ) );
 
 HandleError:
     return err;
@@ -1400,6 +1742,7 @@ ERR VER::ErrVERICreateRCE(
     ERR         err                 = JET_errSuccess;
     RCE *       prce                = prceNil;
     UINT        uiHashConcurrentOp;
+    size_t      ibucketchain;
 
     if ( FOperConcurrent( oper ) )
     {
@@ -1412,7 +1755,8 @@ ERR VER::ErrVERICreateRCE(
         uiHashConcurrentOp = uiHashInvalid;
     }
 
-    m_critBucketGlobal.Enter();
+    ibucketchain = IbucketchainVERIGet();
+    VERIEnterBucketChain( ibucketchain );
 
     Assert( pfucbNil == pfucb ? 0 == level : level > 0 );
 
@@ -1424,7 +1768,7 @@ ERR VER::ErrVERICreateRCE(
         Error( ErrERRCheck( JET_errOutOfMemory ) );
     }
 
-    Call( ErrVERIAllocateRCE( cbNewRCE, &prce, uiHashConcurrentOp ) );
+    Call( ErrVERIAllocateRCE( ibucketchain, cbNewRCE, &prce, uiHashConcurrentOp ) );
 
 #ifdef DEBUG
     if ( !PinstFromIfmp( pfcb->Ifmp() )->m_plog->FRecovering() )
@@ -1459,7 +1803,7 @@ ERR VER::ErrVERICreateRCE(
             );
 
 HandleError:
-    m_critBucketGlobal.Leave();
+    m_rgbucketchain[ ibucketchain ].crit.Leave();
 
     if ( err >= 0 )
     {
@@ -1524,9 +1868,10 @@ LOCAL ERR ErrVERIInsertRCEIntoHash( RCE * const prce )
                     Assert( FAlignedForThisPlatform( prce ) );
 
                     VER *pver = PverFromIfmp( prce->Ifmp() );
+                    BUCKET * const pbucketHead = pver->m_rgbucketchain[ 0 ].pbucketHead;
                     Assert( (RCE *)PvAlignForThisPlatform( (BYTE *)prce + prce->CbRce() )
-                                == pver->m_pbucketGlobalHead->hdr.prceNextNew );
-                    pver->m_pbucketGlobalHead->hdr.prceNextNew = prce;
+                                == pbucketHead->hdr.prceNextNew );
+                    pbucketHead->hdr.prceNextNew = prce;
 
                     ERR err = ErrERRCheck( JET_errPreviousVersion );
                     return err;
@@ -1578,16 +1923,17 @@ LOCAL ERR ErrVERIInsertRCEIntoHash( RCE * const prce )
 
         prce->SetPrceHashOverflow( PverFromIfmp( prce->Ifmp() )->GetChain( prce->UiHash() ) );
         PverFromIfmp( prce->Ifmp() )->SetChain( prce->UiHash(), prce );
+        PverFromIfmp( prce->Ifmp() )->VERIRCEChainNodeInserted( prce->UiHash() );
     }
 
     Assert( prceNil != prce->PrceNextOfNode()
         || prceNil == prce->PrceHashOverflow()
-        || prce->PrceHashOverflow()->UiHash() == prce->UiHash() );
+        || FVERISameRCEChain( prce->Ifmp(), prce->PrceHashOverflow()->UiHash(), prce->UiHash() ) );
 
 #ifdef DEBUG
     if ( prceNil == prce->PrceNextOfNode()
         && prceNil != prce->PrceHashOverflow()
-        && prce->PrceHashOverflow()->UiHash() != prce->UiHash() )
+        && !FVERISameRCEChain( prce->Ifmp(), prce->PrceHashOverflow()->UiHash(), prce->UiHash() ) )
     {
         Assert( fFalse );
     }
@@ -1644,6 +1990,7 @@ LOCAL VOID VERIDeleteRCEFromHash( RCE * const prce )
         {
             *pprce = prce->PrceHashOverflow();
             Assert( prceInvalid != *pprce );
+            PverFromIfmp( prce->Ifmp() )->VERIRCEChainNodeDeleted( prce->UiHash() );
         }
     }
     else
@@ -2192,7 +2539,7 @@ VOID VERNullifyInactiveVersionsOnBM( const FUCB * pfucb, const BOOKMARK& bm )
 
 VOID VER::VERSignalCleanup()
 {
-    if ( NULL != m_pbucketGlobalTail
+    if ( FVERBucketsAllocated()
         && 0 == AtomicCompareExchange( (LONG *)&m_fVERCleanUpWait, 0, 1 ) )
     {
         m_msigRCECleanPerformedRecently.Reset();
@@ -2336,9 +2683,15 @@ ERR VER::ErrVERInit( INST* pinst )
     PERFOpt( cVERcbucketAllocated.Clear( m_pinst ) );
     PERFOpt( cVERcbucketDeleteAllocated.Clear( m_pinst ) );
     PERFOpt( cVERBucketAllocWaitForRCEClean.Clear( m_pinst ) );
+    PERFOpt( cVERBucketChainContended.Clear( m_pinst ) );
     PERFOpt( cVERcrceHashEntries.Clear( m_pinst ) );
     PERFOpt( cVERcbBookmarkTotal.Clear( m_pinst ) );
     PERFOpt( cVERUnnecessaryCalls.Clear( m_pinst ) );
+    PERFOpt( cVERRCEChainSplits.Clear( m_pinst ) );
+    for ( INT ircechainlen = 0; ircechainlen < rcechainlenMax; ircechainlen++ )
+    {
+        PERFOpt( cVERRCEChainLookups[ ircechainlen ].Clear( m_pinst ) );
+    }
     PERFOpt( cVERSyncCleanupDispatched.Clear( m_pinst ) );
     PERFOpt( cVERAsyncCleanupDispatched.Clear( m_pinst ) );
     PERFOpt( cVERCleanupDiscarded.Clear( m_pinst ) );
@@ -2368,10 +2721,21 @@ ERR VER::ErrVERInit( INST* pinst )
     CallR( m_cresBucket.ErrInit( JET_residVERBUCKET ) );
     CallS( ErrRESGetResourceParam( m_pinst, JET_residVERBUCKET, JET_resoperSize, &m_cbBucket ) );
 
-    Assert( pbucketNil == m_pbucketGlobalHead );
-    Assert( pbucketNil == m_pbucketGlobalTail );
-    m_pbucketGlobalHead = pbucketNil;
-    m_pbucketGlobalTail = pbucketNil;
+    {
+    DWORD_PTR cbucketMost = 0;
+    CallS( m_cresBucket.ErrGetParam( JET_resoperMaxUse, &cbucketMost ) );
+    m_cbucketchain = min( (size_t)OSSyncGetProcessorCountMax(), (size_t)cbucketchainMax );
+    m_cbucketchain = max( (size_t)1, min( m_cbucketchain, (size_t)( cbucketMost / cbucketPerBucketChainMin ) ) );
+    m_cbucketchain = max( (size_t)1, min( (size_t)UlConfigOverrideInjection( 47324, m_cbucketchain ), (size_t)cbucketchainMax ) );
+    }
+
+    for ( size_t ibucketchain = 0; ibucketchain < cbucketchainMax; ibucketchain++ )
+    {
+        Assert( pbucketNil == m_rgbucketchain[ ibucketchain ].pbucketHead );
+        Assert( pbucketNil == m_rgbucketchain[ ibucketchain ].pbucketTail );
+        m_rgbucketchain[ ibucketchain ].pbucketHead = pbucketNil;
+        m_rgbucketchain[ ibucketchain ].pbucketTail = pbucketNil;
+    }
 
     Assert( ppibNil == m_ppibRCEClean );
     Assert( ppibNil == m_ppibRCECleanCallback );
@@ -2470,19 +2834,24 @@ VOID VER::VERTerm( BOOL fNormal )
         m_ppibRCECleanCallback = ppibNil;
     }
 
-    Assert( pbucketNil == m_pbucketGlobalHead || !fNormal);
-    Assert( pbucketNil == m_pbucketGlobalTail || !fNormal );
-
-    BUCKET* pbucket = m_pbucketGlobalHead;
-    while ( pbucketNil != pbucket )
+    for ( size_t ibucketchain = 0; ibucketchain < cbucketchainMax; ibucketchain++ )
     {
-        BUCKET* const pbucketPrev = pbucket->hdr.pbucketPrev;
-        delete pbucket;
-        pbucket = pbucketPrev;
-    }
+        BUCKETCHAIN * const pbucketchain = m_rgbucketchain + ibucketchain;
 
-    m_pbucketGlobalHead = pbucketNil;
-    m_pbucketGlobalTail = pbucketNil;
+        Assert( pbucketNil == pbucketchain->pbucketHead || !fNormal);
+        Assert( pbucketNil == pbucketchain->pbucketTail || !fNormal );
+
+        BUCKET* pbucket = pbucketchain->pbucketHead;
+        while ( pbucketNil != pbucket )
+        {
+            BUCKET* const pbucketPrev = pbucket->hdr.pbucketPrev;
+            delete pbucket;
+            pbucket = pbucketPrev;
+        }
+
+        pbucketchain->pbucketHead = pbucketNil;
+        pbucketchain->pbucketTail = pbucketNil;
+    }
 
     m_cresBucket.Term();
     if ( m_pinst->FRecovering() )
@@ -2502,9 +2871,15 @@ VOID VER::VERTerm( BOOL fNormal )
     PERFOpt( cVERcbucketAllocated.Clear( m_pinst ) );
     PERFOpt( cVERcbucketDeleteAllocated.Clear( m_pinst ) );
     PERFOpt( cVERBucketAllocWaitForRCEClean.Clear( m_pinst ) );
+    PERFOpt( cVERBucketChainContended.Clear( m_pinst ) );
     PERFOpt( cVERcrceHashEntries.Clear( m_pinst ) );
     PERFOpt( cVERcbBookmarkTotal.Clear( m_pinst ) );
     PERFOpt( cVERUnnecessaryCalls.Clear( m_pinst ) );
+    PERFOpt( cVERRCEChainSplits.Clear( m_pinst ) );
+    for ( INT ircechainlen = 0; ircechainlen < rcechainlenMax; ircechainlen++ )
+    {
+        PERFOpt( cVERRCEChainLookups[ ircechainlen ].Clear( m_pinst ) );
+    }
     PERFOpt( cVERSyncCleanupDispatched.Clear( m_pinst ) );
     PERFOpt( cVERAsyncCleanupDispatched.Clear( m_pinst ) );
     PERFOpt( cVERCleanupDiscarded.Clear( m_pinst ) );
@@ -2518,8 +2893,6 @@ ERR VER::ErrVERStatus( )
     DWORD_PTR       cbucketMost     = 0;
     DWORD_PTR       cbucket         = 0;
 
-    ENTERCRITICALSECTION    enterCritRCEBucketGlobal( &m_critBucketGlobal );
-
     CallS( m_cresBucket.ErrGetParam( JET_resoperMaxUse, &cbucketMost ) );
     CallS( m_cresBucket.ErrGetParam( JET_resoperCurrentUse, &cbucket ) );
 
@@ -2581,7 +2954,7 @@ ERR ErrVERAccessNode( FUCB * pfucb, const BOOKMARK& bookmark, NS * pns )
 
     const UINT uiHash = UiRCHashFunc( pfucb->ifmp, pfucb->u.pfcb->PgnoFDP(), bookmark );
 
-    if ( prceNil == PverFromIfmp( pfucb->ifmp )->GetChain( uiHash ) )
+    if ( PverFromIfmp( pfucb->ifmp )->FRCEChainEmpty( uiHash ) )
     {
         PERFOpt( cVERUnnecessaryCalls.Inc( PinstFromPfucb( pfucb ) ) );
 
@@ -3537,11 +3910,12 @@ ERR VER::ErrVERCheckTransactionSize( PIB * const ppib )
         {
             const BOOL fCleanupWasRun   = m_msigRCECleanPerformedRecently.FWait( cmsecAsyncBackgroundCleanup );
 
-            m_critBucketGlobal.Enter();
+            const size_t ibucketchain = IbucketchainVERIGet();
+            VERIEnterBucketChain( ibucketchain );
 
             VERIReportVersionStoreOOM ( ppib, fTrue , fCleanupWasRun );
 
-            m_critBucketGlobal.Leave();
+            m_rgbucketchain[ ibucketchain ].crit.Leave();
 
             Error( ErrERRCheck( JET_errVersionStoreOutOfMemory ) );
         }
@@ -4123,7 +4497,15 @@ BOOL FIsRCECleanup()
 
 BOOL FInCritBucket( VER *pver )
 {
-    return pver->m_critBucketGlobal.FOwner();
+    for ( size_t ibucketchain = 0; ibucketchain < pver->m_cbucketchain; ibucketchain++ )
+    {
+        if ( pver->m_rgbucketchain[ ibucketchain ].crit.FOwner() )
+        {
+            return fTrue;
+        }
+    }
+
+    return fFalse;
 }
 #endif
 
@@ -4790,6 +5172,84 @@ ERR VER::ErrVERRCEClean( const IFMP ifmp )
     return err;
 }
 
+INLINE VOID VER::VERICleanCursorStartBucket( BUCKETCLEANCURSOR * const pcursor )
+{
+    Assert( m_critRCEClean.FOwner() );
+
+    if ( pbucketNil != pcursor->pbucket )
+    {
+        pcursor->prce = pcursor->pbucket->hdr.prceOldest;
+    }
+    else
+    {
+        pcursor->prce = prceNil;
+    }
+    pcursor->prceLimit = pcursor->prce;
+    pcursor->fSkippedRCEInBucket = fFalse;
+}
+
+BOOL VER::FVERICleanCursorCurrent( const size_t ibucketchain, BUCKETCLEANCURSOR * const pcursor )
+{
+    Assert( m_critRCEClean.FOwner() );
+
+    BUCKETCHAIN * const pbucketchain = m_rgbucketchain + ibucketchain;
+
+    while ( pbucketNil != pcursor->pbucket )
+    {
+        BUCKET * const pbucket = pcursor->pbucket;
+
+        Assert( pbucket->rgb <= (BYTE*)pcursor->prce );
+        Assert( (BYTE*)pcursor->prce <= (BYTE*)pbucket + m_cbBucket );
+
+        if ( !pcursor->fSkippedRCEInBucket )
+        {
+            pbucket->hdr.prceOldest = pcursor->prce;
+        }
+
+        if ( pcursor->prce < pcursor->prceLimit )
+        {
+            return fTrue;
+        }
+
+        pbucketchain->crit.Enter();
+
+        Assert( pbucket->rgb <= pbucket->hdr.pbLastDelete );
+        Assert( pbucket->hdr.pbLastDelete <= reinterpret_cast<BYTE *>( pbucket->hdr.prceOldest ) );
+        Assert( pbucket->hdr.prceOldest <= pbucket->hdr.prceNextNew );
+
+        if ( pbucket->hdr.prceNextNew != pcursor->prce )
+        {
+            pcursor->prceLimit = pbucket->hdr.prceNextNew;
+            pbucketchain->crit.Leave();
+            return fTrue;
+        }
+
+#ifdef VERPERF
+        ++m_cbucketSeen;
+#endif
+
+        if ( pcursor->fSkippedRCEInBucket )
+        {
+            pcursor->pbucket = pbucket->hdr.pbucketNext;
+        }
+        else
+        {
+            Assert( pbucket->rgb == pbucket->hdr.pbLastDelete );
+            pcursor->pbucket = PbucketVERIFreeAndGetNextOldestBucket( ibucketchain, pbucket );
+
+#ifdef VERPERF
+            ++m_cbucketCleaned;
+#endif
+        }
+
+        pbucketchain->crit.Leave();
+
+        VERICleanCursorStartBucket( pcursor );
+    }
+
+    return fFalse;
+}
+
 ERR VER::ErrVERIRCEClean( const IFMP ifmp )
 {
     Assert( m_critRCEClean.FOwner() );
@@ -4816,240 +5276,185 @@ ERR VER::ErrVERIRCEClean( const IFMP ifmp )
     m_crceDeleteLV      = 0;
 #endif
 
-    ERR         err     = JET_errSuccess;
-    BUCKET *    pbucket;
+    ERR                 err     = JET_errSuccess;
+    BUCKETCLEANCURSOR   rgcursor[ cbucketchainMax ];
 
+    for ( size_t ibucketchain = 0; ibucketchain < m_cbucketchain; ibucketchain++ )
+    {
+        m_rgbucketchain[ ibucketchain ].crit.Enter();
 
-    m_critBucketGlobal.Enter();
+        rgcursor[ ibucketchain ].pbucket = PbucketVERIGetOldest( ibucketchain );
 
-    pbucket = PbucketVERIGetOldest();
+        m_rgbucketchain[ ibucketchain ].crit.Leave();
 
-    m_critBucketGlobal.Leave();
+        VERICleanCursorStartBucket( rgcursor + ibucketchain );
+    }
 
     TRX trxOldest = TrxOldest( m_pinst );
 
-    while ( pbucketNil != pbucket )
+    forever
     {
-#ifdef VERPERF
-        INT crceInBucketSeen    = 0;
-        INT crceInBucketCleaned = 0;
-#endif
-
+        BUCKETCLEANCURSOR * pcursor = NULL;
 
-        BOOL    fNeedBeInCritBucketGlobal   = ( pbucket->hdr.pbucketNext == pbucketNil );
-
-
-        Assert( m_critRCEClean.FOwner() );
-        RCE *   prce                        = pbucket->hdr.prceOldest;
-        BOOL    fSkippedRCEInBucket         = fFalse;
-
-        forever
+        for ( size_t ibucketchain = 0; ibucketchain < m_cbucketchain; ibucketchain++ )
         {
-#ifdef VERPERF
-            ++m_crceSeen;
-            ++crceInBucketSeen;
-#endif
-
-            Assert( pbucket->rgb <= (BYTE*)prce );
-            Assert( (BYTE*)prce < (BYTE*)pbucket + m_cbBucket ||
-                    (   (BYTE*)prce == (BYTE*)pbucket + m_cbBucket &&
-                        prce == pbucket->hdr.prceNextNew ) );
+            BUCKETCLEANCURSOR * const pcursorT = rgcursor + ibucketchain;
 
-            if ( fNeedBeInCritBucketGlobal )
+            if ( !FVERICleanCursorCurrent( ibucketchain, pcursorT ) )
             {
-                m_critBucketGlobal.Enter();
+                continue;
             }
 
-            const BOOL  fRecalcOldestRCE    = ( !fSkippedRCEInBucket );
+            if ( pcursorT->prce->FOperNull() )
+            {
+                pcursor = pcursorT;
+                break;
+            }
 
-            if ( fRecalcOldestRCE )
+            if ( NULL == pcursor
+                || RceidCmp( pcursorT->prce->Rceid(), pcursor->prce->Rceid() ) < 0 )
             {
-                pbucket->hdr.prceOldest = prce;
+                pcursor = pcursorT;
             }
+        }
 
-            Assert( pbucket->rgb <= pbucket->hdr.pbLastDelete );
-            Assert( pbucket->hdr.pbLastDelete <= reinterpret_cast<BYTE *>( pbucket->hdr.prceOldest ) );
-            Assert( pbucket->hdr.prceOldest <= pbucket->hdr.prceNextNew );
+        if ( NULL == pcursor )
+        {
+            break;
+        }
 
-            if ( pbucket->hdr.prceNextNew == prce )
-                break;
+#ifdef VERPERF
+        ++m_crceSeen;
+#endif
 
-            if ( fNeedBeInCritBucketGlobal )
-                m_critBucketGlobal.Leave();
+        Assert( m_critRCEClean.FOwner() );
 
-            const INT   cbRce = prce->CbRce();
+        RCE * const         prce    = pcursor->prce;
+        BUCKET * const      pbucket = pcursor->pbucket;
+        const INT           cbRce   = prce->CbRce();
 
-            Assert( pbucket->rgb <= (BYTE*)prce );
-            Assert( prce->CbRce() > 0 );
-            Assert( (BYTE*)prce + prce->CbRce() <= (BYTE*)pbucket + m_cbBucket );
+        Assert( pbucket->rgb <= (BYTE*)prce );
+        Assert( prce->CbRce() > 0 );
+        Assert( (BYTE*)prce + prce->CbRce() <= (BYTE*)pbucket + m_cbBucket );
 
-            if ( !prce->FOperNull() )
-            {
-                Assert( g_rgfmp[ prce->Ifmp() ].Pinst() == m_pinst );
+        if ( !prce->FOperNull() )
+        {
+            Assert( g_rgfmp[ prce->Ifmp() ].Pinst() == m_pinst );
 #ifdef DEBUG
-                const TRX   trxDBGOldest    = TrxOldest( m_pinst );
+            const TRX   trxDBGOldest    = TrxOldest( m_pinst );
 #endif
-                const BOOL  fFullyCommitted = prce->FFullyCommitted();
-                const TRX   trxRCECommitted = prce->TrxCommitted();
-                BOOL        fCleanable      = fFalse;
+            const BOOL  fFullyCommitted = prce->FFullyCommitted();
+            const TRX   trxRCECommitted = prce->TrxCommitted();
+            BOOL        fCleanable      = fFalse;
 
-                if ( trxMax == trxOldest )
+            if ( trxMax == trxOldest )
+            {
+                trxOldest = TrxOldest( m_pinst );
+            }
+
+            if ( fFullyCommitted && !FFMPIsTempDB( prce->Ifmp() ) )
+            {
+                Assert( trxMax != trxRCECommitted );
+                if ( TrxCmp( trxRCECommitted, trxOldest ) < 0 )
                 {
-                    trxOldest = TrxOldest( m_pinst );
+                    fCleanable = fTrue;
                 }
-
-                if ( fFullyCommitted && !FFMPIsTempDB( prce->Ifmp() ) )
+                else if ( trxMax != trxOldest )
                 {
-                    Assert( trxMax != trxRCECommitted );
+                    trxOldest = TrxOldest( m_pinst );
                     if ( TrxCmp( trxRCECommitted, trxOldest ) < 0 )
                     {
                         fCleanable = fTrue;
                     }
-                    else if ( trxMax != trxOldest )
-                    {
-                        trxOldest = TrxOldest( m_pinst );
-                        if ( TrxCmp( trxRCECommitted, trxOldest ) < 0 )
-                        {
-                            fCleanable = fTrue;
-                        }
-                    }
-                    else
-                    {
-                        Assert( fFalse );
-                    }
                 }
+                else
+                {
+                    Assert( fFalse );
+                }
+            }
 
-                if ( !fCleanable )
+            if ( !fCleanable )
+            {
+                if ( fCleanOneDb )
                 {
-                    if ( fCleanOneDb )
+                    Assert( !FFMPIsTempDB( ifmp ) );
+                    if ( prce->Ifmp() == ifmp )
                     {
-                        Assert( !FFMPIsTempDB( ifmp ) );
-                        if ( prce->Ifmp() == ifmp )
+                        if ( !prce->FFullyCommitted() )
                         {
-                            if ( !prce->FFullyCommitted() )
-                            {
-                                err = ErrERRCheck( JET_wrnRemainingVersions );
-                                goto HandleError;
-                            }
-                            else
-                            {
-                            }
+                            err = ErrERRCheck( JET_wrnRemainingVersions );
+                            goto HandleError;
                         }
                         else
                         {
-                            fSkippedRCEInBucket = fTrue;
-                            goto NextRCE;
                         }
                     }
                     else
                     {
-                        Assert( pbucketNil != pbucket );
-                        Assert( !prce->FMoved() );
-                        err = ErrERRCheck( JET_wrnRemainingVersions );
-                        goto HandleError;
+                        pcursor->fSkippedRCEInBucket = fTrue;
+                        goto NextRCE;
                     }
                 }
+                else
+                {
+                    Assert( pbucketNil != pbucket );
+                    Assert( !prce->FMoved() );
+                    err = ErrERRCheck( JET_wrnRemainingVersions );
+                    goto HandleError;
+                }
+            }
 
-                Assert( prce->FFullyCommitted() );
-                Assert( prce->TrxCommitted() != trxMax );
-                Assert( TrxCmp( prce->TrxCommitted(), trxDBGOldest ) < 0
-                        || fCleanOneDb
-                        || TrxCmp( prce->TrxCommitted(), trxOldest ) < 0 );
+            Assert( prce->FFullyCommitted() );
+            Assert( prce->TrxCommitted() != trxMax );
+            Assert( TrxCmp( prce->TrxCommitted(), trxDBGOldest ) < 0
+                    || fCleanOneDb
+                    || TrxCmp( prce->TrxCommitted(), trxOldest ) < 0 );
 
 #ifdef VERPERF
-                if ( operFlagDelete == prce->Oper() )
-                {
-                    ++m_crceFlagDelete;
-                }
-                else if ( operDelta == prce->Oper() )
+            if ( operFlagDelete == prce->Oper() )
+            {
+                ++m_crceFlagDelete;
+            }
+            else if ( operDelta == prce->Oper() )
+            {
+                const VERDELTA32* const pverdelta = reinterpret_cast<VERDELTA32*>( prce->PbData() );
+                if ( pverdelta->fDeferredDelete )
                 {
-                    const VERDELTA32* const pverdelta = reinterpret_cast<VERDELTA32*>( prce->PbData() );
-                    if ( pverdelta->fDeferredDelete )
-                    {
-                        ++m_crceDeleteLV;
-                    }
+                    ++m_crceDeleteLV;
                 }
-                else if ( operDelta64 == prce->Oper() )
+            }
+            else if ( operDelta64 == prce->Oper() )
+            {
+                const VERDELTA64* const pverdelta = reinterpret_cast<VERDELTA64*>( prce->PbData() );
+                if ( pverdelta->fDeferredDelete )
                 {
-                    const VERDELTA64* const pverdelta = reinterpret_cast<VERDELTA64*>( prce->PbData() );
-                    if ( pverdelta->fDeferredDelete )
-                    {
-                        ++m_crceDeleteLV;
-                    }
+                    ++m_crceDeleteLV;
                 }
+            }
 #endif
 
-                Call( prce->ErrPrepareToDeallocate( trxOldest ) );
+            Call( prce->ErrPrepareToDeallocate( trxOldest ) );
 
 #ifdef VERPERF
-                ++crceInBucketCleaned;
-                ++m_crceCleaned;
+            ++m_crceCleaned;
 #endif
-            }
-
-NextRCE:
-            Assert( m_critRCEClean.FOwner() );
-
-
-            const BYTE  *pbRce      = reinterpret_cast<BYTE *>( prce );
-            const BYTE  *pbNextRce  = reinterpret_cast<BYTE *>( PvAlignForThisPlatform( pbRce + cbRce ) );
-
-            prce = (RCE *)pbNextRce;
-
-            Assert( pbucket->rgb <= (BYTE*)prce );
-            Assert( (BYTE*)prce < (BYTE*)pbucket + m_cbBucket ||
-                    (   (BYTE*)prce == (BYTE*)pbucket + m_cbBucket &&
-                        prce == pbucket->hdr.prceNextNew ) );
-
-            Assert( pbucket->hdr.prceOldest <= pbucket->hdr.prceNextNew );
         }
 
+NextRCE:
+        Assert( m_critRCEClean.FOwner() );
 
-        if ( fNeedBeInCritBucketGlobal )
-            Assert( m_critBucketGlobal.FOwner() );
-        else
-            m_critBucketGlobal.Enter();
-
-#ifdef VERPERF
-        ++m_cbucketSeen;
-#endif
-
-        const BOOL  fRemainingRCEs  = ( fSkippedRCEInBucket );
+        pcursor->prce = reinterpret_cast<RCE *>( PvAlignForThisPlatform( reinterpret_cast<BYTE *>( prce ) + cbRce ) );
 
-        if ( fRemainingRCEs )
-        {
-            pbucket = pbucket->hdr.pbucketNext;
-        }
-        else
-        {
-            Assert( pbucket->rgb == pbucket->hdr.pbLastDelete );
-            pbucket = PbucketVERIFreeAndGetNextOldestBucket( pbucket );
-
-#ifdef VERPERF
-            ++m_cbucketCleaned;
-#endif
-        }
-
-        m_critBucketGlobal.Leave();
+        Assert( pbucket->rgb <= (BYTE*)pcursor->prce );
+        Assert( (BYTE*)pcursor->prce <= (BYTE*)pbucket + m_cbBucket );
+        Assert( pbucket->hdr.prceOldest <= pbucket->hdr.prceNextNew );
     }
 
-
-    Assert( pbucketNil == pbucket );
     err = JET_errSuccess;
 
-    if ( !fCleanOneDb )
+    if ( !fCleanOneDb && FVERBucketsAllocated() )
     {
-        m_critBucketGlobal.Enter();
-        if ( pbucketNil != m_pbucketGlobalHead )
-        {
-            Assert( pbucketNil != m_pbucketGlobalTail );
-            err = ErrERRCheck( JET_wrnRemainingVersions );
-        }
-        else
-        {
-            Assert( pbucketNil == m_pbucketGlobalTail );
-        }
-        m_critBucketGlobal.Leave();
+        err = ErrERRCheck( JET_wrnRemainingVersions );
     }
 
 HandleError:
@@ -209,3 +209,422 @@ JETUNITTEST( EngineFormatVersionsTable, TestLookupOfDbMajors )
     CHECK( JET_errInvalidDatabaseVersion == ErrDBFindHighestMatchingDbMajors( dbvTest3B, &pfmtversMatching, fTrue ) );
 }
 
+
+//  the version store hash of the primary index bookmark of a record with key lKey
+
+LOCAL ERR ErrVERTestUiHash( const JET_SESID sesid, const JET_TABLEID tableid, const LONG lKey, UINT * const puiHash )
+{
+    ERR             err         = JET_errSuccess;
+    FUCB * const    pfucb       = (FUCB *)tableid;
+    BYTE            rgbKey[ JET_cbKeyMost ];
+    ULONG           cbKey       = 0;
+    BOOKMARK        bookmark;
+
+    Call( JetMakeKey( sesid, tableid, &lKey, sizeof( lKey ), JET_bitNewKey ) );
+    Call( JetRetrieveKey( sesid, tableid, rgbKey, sizeof( rgbKey ), &cbKey, JET_bitRetrieveCopy ) );
+
+    bookmark.Nullify();
+    bookmark.key.suffix.SetPv( rgbKey );
+    bookmark.key.suffix.SetCb( cbKey );
+    *puiHash = UiVERHash( pfucb->ifmp, pfucb->u.pfcb->PgnoFDP(), bookmark );
+
+HandleError:
+    return err;
+}
+
+LOCAL ERR ErrVERTestSeek( const JET_SESID sesid, const JET_TABLEID tableid, const LONG lKey )
+{
+    ERR err = JET_errSuccess;
+
+    Call( JetMakeKey( sesid, tableid, &lKey, sizeof( lKey ), JET_bitNewKey ) );
+    Call( JetSeek( sesid, tableid, JET_bitSeekEQ ) );
+
+HandleError:
+    return err;
+}
+
+//  Inserts enough records whose bookmarks share one lock stripe to take the stripe from its
+//  single chain to a chain array that has to grow past its initial size, and checks that the
+//  RCE of every record can still be found by this session and by another one.
+
+JETUNITTEST( VER, RCEChainSplitsInOneStripe )
+{
+    const INT           crec            = 64;
+    JetTestDatabase     db;
+    JET_SESID           sesidOther      = JET_sesidNil;
+    JET_DBID            dbidOther       = JET_dbidNil;
+    JET_TABLEID         tableid         = JET_tableidNil;
+    JET_TABLEID         tableidOther    = JET_tableidNil;
+    JET_COLUMNID        columnidKey;
+    JET_COLUMNDEF       columndef       = { sizeof( JET_COLUMNDEF ), 0, JET_coltypLong, 0, 0, 0, 0, 0, JET_bitColumnFixed };
+    LONG                rglKey[ crec ];
+    INT                 cKey            = 0;
+    UINT                ircehead        = 0;
+
+    CHECKCALLS( db.ErrInit( L"VerRCEChainSplits" ) );
+    CHECKCALLS( JetCreateTableA( db.Sesid(), db.Dbid(), "Splits", 16, 100, &tableid ) );
+    CHECKCALLS( JetAddColumnA( db.Sesid(), tableid, "Key", &columndef, NULL, 0, &columnidKey ) );
+    CHECKCALLS( JetCreateIndexA( db.Sesid(), tableid, "Primary", JET_bitIndexPrimary, "+Key\0", 6, 100 ) );
+    CHECKCALLS( JetSetCurrentIndexA( db.Sesid(), tableid, NULL ) );
+
+    VER * const pver = db.Pinst()->m_pver;
+
+    //  pick a stripe that is idle so we see its first split, then keys that hash to it
+
+    for ( LONG lKey = 0; cKey < crec && (size_t)lKey < 16 * crec * pver->m_crceheadHashTable; lKey++ )
+    {
+        UINT uiHash = 0;
+        CHECKCALLS( ErrVERTestUiHash( db.Sesid(), tableid, lKey, &uiHash ) );
+        const UINT irceheadKey = UINT( uiHash % pver->m_crceheadHashTable );
+
+        if ( 0 == cKey )
+        {
+            const VER::RCEHEAD * const prceheadKey = &pver->m_rgrceheadHashTable[ irceheadKey ];
+            if ( NULL != prceheadKey->prcechains || prceNil != prceheadKey->prceChain )
+            {
+                continue;
+            }
+            ircehead = irceheadKey;
+        }
+        else if ( irceheadKey != ircehead )
+        {
+            continue;
+        }
+
+        rglKey[ cKey++ ] = lKey;
+    }
+    CHECK( crec == cKey );
+
+    const VER::RCEHEAD * const prcehead = &pver->m_rgrceheadHashTable[ ircehead ];
+
+    CHECKCALLS( JetBeginTransaction( db.Sesid() ) );
+    for ( INT iKey = 0; iKey < crec; iKey++ )
+    {
+        CHECKCALLS( JetPrepareUpdate( db.Sesid(), tableid, JET_prepInsert ) );
+        CHECKCALLS( JetSetColumn( db.Sesid(), tableid, columnidKey, &rglKey[ iKey ], sizeof( rglKey[ iKey ] ), NO_GRBIT, NULL ) );
+        CHECKCALLS( JetUpdate( db.Sesid(), tableid, NULL, 0, NULL ) );
+
+        if ( iKey < VER::cnodePerChainMost )
+        {
+            CHECK( NULL == prcehead->prcechains );
+            CHECK( prceNil != prcehead->prceChain );
+        }
+        else
+        {
+            CHECK( NULL != prcehead->prcechains );
+            CHECK( prceNil == prcehead->prceChain );
+            CHECK( UINT( iKey + 1 ) == prcehead->prcechains->cnode );
+            CHECK( prcehead->prcechains->cprceChain <= prcehead->prcechains->cprceChainMax );
+        }
+
+        if ( iKey == VER::cnodePerChainMost )
+        {
+            CHECK( 2 == prcehead->prcechains->cprceChain );
+        }
+    }
+    CHECK( prcehead->prcechains->cprceChain > VER::cprceChainInitial );
+
+#ifndef RTM
+    CHECKCALLS( pver->ErrInternalCheck() );
+#endif
+
+    //  a lost RCE would make the uncommitted insert visible to the other session
+
+    CHECKCALLS( JetBeginSessionW( db.Inst(), &sesidOther, NULL, NULL ) );
+    CHECKCALLS( JetOpenDatabaseW( sesidOther, db.WszDatabase(), NULL, &dbidOther, NO_GRBIT ) );
+    CHECKCALLS( JetOpenTableA( sesidOther, dbidOther, "Splits", NULL, 0, NO_GRBIT, &tableidOther ) );
+
+    CHECKCALLS( JetBeginTransaction( sesidOther ) );
+    for ( INT iKey = 0; iKey < crec; iKey++ )
+    {
+        CHECKCALLS( ErrVERTestSeek( db.Sesid(), tableid, rglKey[ iKey ] ) );
+        CHECK( JET_errRecordNotFound == ErrVERTestSeek( sesidOther, tableidOther, rglKey[ iKey ] ) );
+    }
+    CHECKCALLS( JetCommitTransaction( sesidOther, NO_GRBIT ) );
+
+    CHECKCALLS( JetCommitTransaction( db.Sesid(), NO_GRBIT ) );
+
+#ifndef RTM
+    CHECKCALLS( pver->ErrInternalCheck() );
+#endif
+
+    for ( INT iKey = 0; iKey < crec; iKey++ )
+    {
+        CHECKCALLS( ErrVERTestSeek( sesidOther, tableidOther, rglKey[ iKey ] ) );
+    }
+
+    CHECKCALLS( JetCloseTable( sesidOther, tableidOther ) );
+    CHECKCALLS( JetCloseDatabase( sesidOther, dbidOther, NO_GRBIT ) );
+    CHECKCALLS( JetEndSession( sesidOther, NO_GRBIT ) );
+    CHECKCALLS( JetCloseTable( db.Sesid(), tableid ) );
+    CHECKCALLS( db.ErrTerm() );
+}
+
+//  a run of inserts committed together while RCE creation is pinned to one bucket chain.
+//  the phase owns the rceids in ( rceidFirst, rceidLast ]
+
+struct VERTESTPHASE
+{
+    size_t  ibucketchain;
+    RCEID   rceidFirst;
+    RCEID   rceidLast;
+};
+
+//  counts the live RCEs of each phase. returns fFalse if a chain is not ordered oldest first
+//  or if an RCE of a phase is found on a chain other than the one the phase was pinned to
+
+LOCAL BOOL FVERTestCountPhaseRCEs( VER * const pver, const VERTESTPHASE * const rgphase, const INT cphase, INT * const rgcrce )
+{
+    BOOL fValid = fTrue;
+
+    memset( rgcrce, 0, cphase * sizeof( rgcrce[ 0 ] ) );
+
+    pver->m_critRCEClean.Enter();
+
+    for ( size_t ibucketchain = 0; ibucketchain < pver->m_cbucketchain; ibucketchain++ )
+    {
+        VER::BUCKETCHAIN * const    pbucketchain    = pver->m_rgbucketchain + ibucketchain;
+        RCEID                       rceidPrev       = rceidNull;
+
+        pbucketchain->crit.Enter();
+
+        for ( BUCKET * pbucket = pbucketchain->pbucketTail; pbucketNil != pbucket; pbucket = pbucket->hdr.pbucketNext )
+        {
+            for ( RCE * prce = pbucket->hdr.prceOldest;
+                    prce < pbucket->hdr.prceNextNew;
+                    prce = (RCE *)PvAlignForThisPlatform( (BYTE *)prce + prce->CbRce() ) )
+            {
+                if ( prce->FOperNull() )
+                {
+                    continue;
+                }
+
+                if ( RceidCmp( prce->Rceid(), rceidPrev ) <= 0 )
+                {
+                    fValid = fFalse;
+                }
+                rceidPrev = prce->Rceid();
+
+                for ( INT iphase = 0; iphase < cphase; iphase++ )
+                {
+                    if ( RceidCmp( prce->Rceid(), rgphase[ iphase ].rceidFirst ) > 0
+                        && RceidCmp( prce->Rceid(), rgphase[ iphase ].rceidLast ) <= 0 )
+                    {
+                        rgcrce[ iphase ]++;
+                        if ( rgphase[ iphase ].ibucketchain != ibucketchain )
+                        {
+                            fValid = fFalse;
+                        }
+                    }
+                }
+            }
+        }
+
+        pbucketchain->crit.Leave();
+    }
+
+    pver->m_critRCEClean.Leave();
+
+    return fValid;
+}
+
+//  Spreads committed transactions over several bucket chains with another session's
+//  transaction starting in the middle, and checks that cleanup merges the chains oldest
+//  first: everything committed before that transaction began is freed from every chain,
+//  including the chains that also hold newer RCEs, and nothing newer is touched.
+
+JETUNITTEST( VER, BucketChainsCleanOldestFirst )
+{
+    const size_t        cbucketchain            = 4;
+    const INT           cphase                  = 6;
+    const INT           cphaseBeforeOther       = 2;
+    const LONG          crecPerPhase            = 500;
+    JetTestDatabase     db;
+    JET_SESID           sesidOther              = JET_sesidNil;
+    JET_TABLEID         tableid                 = JET_tableidNil;
+    JET_COLUMNID        columnidKey;
+    JET_COLUMNDEF       columndef               = { sizeof( JET_COLUMNDEF ), 0, JET_coltypLong, 0, 0, 0, 0, 0, JET_bitColumnFixed };
+    VERTESTPHASE        rgphase[ cphase ]       = { { 2 }, { 0 }, { 3 }, { 1 }, { 2 }, { 0 } };
+    INT                 rgcrceBeforeClean[ cphase ];
+    INT                 rgcrce[ cphase ];
+
+    CHECKCALLS( ErrEnableTestInjection( 47324, cbucketchain, JET_TestInjectConfigOverride, 100, JET_bitInjectionProbabilityPct ) );
+    const ERR errInit = db.ErrInit( L"VerBucketChainsOldestFirst" );
+    CHECKCALLS( ErrEnableTestInjection( 47324, 0, JET_TestInjectConfigOverride, 0, JET_bitInjectionProbabilityPct ) );
+    CHECKCALLS( errInit );
+
+    VER * const pver = db.Pinst()->m_pver;
+    CHECK( cbucketchain == pver->m_cbucketchain );
+
+    CHECKCALLS( JetCreateTableA( db.Sesid(), db.Dbid(), "Chains", 16, 100, &tableid ) );
+    CHECKCALLS( JetAddColumnA( db.Sesid(), tableid, "Key", &columndef, NULL, 0, &columnidKey ) );
+    CHECKCALLS( JetCreateIndexA( db.Sesid(), tableid, "Primary", JET_bitIndexPrimary, "+Key\0", 6, 100 ) );
+    CHECKCALLS( JetBeginSessionW( db.Inst(), &sesidOther, NULL, NULL ) );
+
+    for ( INT iphase = 0; iphase < cphase; iphase++ )
+    {
+        if ( cphaseBeforeOther == iphase )
+        {
+            CHECKCALLS( JetBeginTransaction( sesidOther ) );
+        }
+
+        CHECKCALLS( ErrEnableTestInjection( 47308, rgphase[ iphase ].ibucketchain + 1, JET_TestInjectConfigOverride, 100, JET_bitInjectionProbabilityPct ) );
+        rgphase[ iphase ].rceidFirst = pver->RceidLast();
+
+        CHECKCALLS( JetBeginTransaction( db.Sesid() ) );
+        for ( LONG irec = 0; irec < crecPerPhase; irec++ )
+        {
+            const LONG lKey = iphase * crecPerPhase + irec;
+            CHECKCALLS( JetPrepareUpdate( db.Sesid(), tableid, JET_prepInsert ) );
+            CHECKCALLS( JetSetColumn( db.Sesid(), tableid, columnidKey, &lKey, sizeof( lKey ), NO_GRBIT, NULL ) );
+            CHECKCALLS( JetUpdate( db.Sesid(), tableid, NULL, 0, NULL ) );
+        }
+        CHECKCALLS( JetCommitTransaction( db.Sesid(), NO_GRBIT ) );
+
+        rgphase[ iphase ].rceidLast = pver->RceidLast();
+    }
+    CHECKCALLS( ErrEnableTestInjection( 47308, 0, JET_TestInjectConfigOverride, 0, JET_bitInjectionProbabilityPct ) );
+
+    //  background cleanup may already have freed the early phases, never the later ones
+
+    CHECK( FVERTestCountPhaseRCEs( pver, rgphase, cphase, rgcrceBeforeClean ) );
+    for ( INT iphase = cphaseBeforeOther; iphase < cphase; iphase++ )
+    {
+        CHECK( rgcrceBeforeClean[ iphase ] >= crecPerPhase );
+    }
+
+    CHECK( JET_wrnRemainingVersions == pver->ErrVERRCEClean() );
+
+    CHECK( FVERTestCountPhaseRCEs( pver, rgphase, cphase, rgcrce ) );
+    for ( INT iphase = 0; iphase < cphase; iphase++ )
+    {
+        CHECK( ( iphase < cphaseBeforeOther ? 0 : rgcrceBeforeClean[ iphase ] ) == rgcrce[ iphase ] );
+    }
+
+    //  once the other transaction ends every chain drains and frees its buckets
+
+    CHECKCALLS( JetCommitTransaction( sesidOther, NO_GRBIT ) );
+    CHECKCALLS( pver->ErrVERRCEClean() );
+    CHECK( !pver->FVERBucketsAllocated() );
+
+    CHECKCALLS( JetEndSession( sesidOther, NO_GRBIT ) );
+    CHECKCALLS( JetCloseTable( db.Sesid(), tableid ) );
+    CHECKCALLS( db.ErrTerm() );
+}
+
+#ifdef PERFMON_SUPPORT
+extern PERFInstanceDelayedTotal<> cVERBucketChainContended;
+#endif
+
+struct VERTESTINSERTCONTEXT
+{
+    JET_INSTANCE    inst;
+    const WCHAR *   wszDatabase;
+    JET_COLUMNID    columnidKey;
+    LONG            lKey;
+    ERR             err;
+};
+
+LOCAL DWORD VERTestInsertIThread( DWORD_PTR dwContext )
+{
+    VERTESTINSERTCONTEXT * const    pctx        = (VERTESTINSERTCONTEXT *)dwContext;
+    ERR                             err         = JET_errSuccess;
+    JET_SESID                       sesid       = JET_sesidNil;
+    JET_DBID                        dbid        = JET_dbidNil;
+    JET_TABLEID                     tableid     = JET_tableidNil;
+
+    Call( JetBeginSessionW( pctx->inst, &sesid, NULL, NULL ) );
+    Call( JetOpenDatabaseW( sesid, pctx->wszDatabase, NULL, &dbid, NO_GRBIT ) );
+    Call( JetOpenTableA( sesid, dbid, "Contention", NULL, 0, NO_GRBIT, &tableid ) );
+    Call( JetPrepareUpdate( sesid, tableid, JET_prepInsert ) );
+    Call( JetSetColumn( sesid, tableid, pctx->columnidKey, &pctx->lKey, sizeof( pctx->lKey ), NO_GRBIT, NULL ) );
+    Call( JetUpdate( sesid, tableid, NULL, 0, NULL ) );
+
+HandleError:
+    if ( JET_tableidNil != tableid )
+    {
+        (void)JetCloseTable( sesid, tableid );
+    }
+    if ( JET_dbidNil != dbid )
+    {
+        (void)JetCloseDatabase( sesid, dbid, NO_GRBIT );
+    }
+    if ( JET_sesidNil != sesid )
+    {
+        (void)JetEndSession( sesid, NO_GRBIT );
+    }
+    pctx->err = err;
+    return 0;
+}
+
+//  An insert that finds its bucket chain held must count the contention and then go
+//  through once the chain is released.
+
+JETUNITTEST( VER, BucketChainContentionIsCounted )
+{
+    JetTestDatabase         db;
+    JET_TABLEID             tableid         = JET_tableidNil;
+    JET_COLUMNDEF           columndef       = { sizeof( JET_COLUMNDEF ), 0, JET_coltypLong, 0, 0, 0, 0, 0, JET_bitColumnFixed };
+    VERTESTINSERTCONTEXT    ctx;
+    THREAD                  thread;
+
+    CHECKCALLS( db.ErrInit( L"VerBucketChainContention" ) );
+    CHECKCALLS( JetCreateTableA( db.Sesid(), db.Dbid(), "Contention", 16, 100, &tableid ) );
+    CHECKCALLS( JetAddColumnA( db.Sesid(), tableid, "Key", &columndef, NULL, 0, &ctx.columnidKey ) );
+    CHECKCALLS( JetCreateIndexA( db.Sesid(), tableid, "Primary", JET_bitIndexPrimary, "+Key\0", 6, 100 ) );
+
+    VER * const pver = db.Pinst()->m_pver;
+
+    ctx.inst        = db.Inst();
+    ctx.wszDatabase = db.WszDatabase();
+    ctx.lKey        = 1;
+    ctx.err         = JET_errSuccess;
+
+#ifdef PERFMON_SUPPORT
+    const LONG cContendedBefore = g_fDisablePerfmon ? 0 : cVERBucketChainContended.Get( db.Pinst()->m_iInstance );
+#endif
+
+    CHECKCALLS( ErrEnableTestInjection( 47308, 1, JET_TestInjectConfigOverride, 100, JET_bitInjectionProbabilityPct ) );
+    pver->m_rgbucketchain[ 0 ].crit.Enter();
+
+    const ERR errThread = ErrUtilThreadCreate( VERTestInsertIThread, 0, priorityNormal, &thread, (DWORD_PTR)&ctx );
+    if ( errThread >= JET_errSuccess )
+    {
+        //  without the counter to watch, give the insert time to reach the held chain
+
+#ifdef PERFMON_SUPPORT
+        const LONG dtickWaitMax = 10000;
+        const TICK tickStart    = TickOSTimeCurrent();
+        while ( !g_fDisablePerfmon
+            && cVERBucketChainContended.Get( db.Pinst()->m_iInstance ) == cContendedBefore
+            && DtickDelta( tickStart, TickOSTimeCurrent() ) < dtickWaitMax )
+        {
+            UtilSleep( 1 );
+        }
+#else
+        UtilSleep( 100 );
+#endif
+    }
+
+    pver->m_rgbucketchain[ 0 ].crit.Leave();
+    if ( errThread >= JET_errSuccess )
+    {
+        UtilThreadEnd( thread );
+    }
+    CHECKCALLS( ErrEnableTestInjection( 47308, 0, JET_TestInjectConfigOverride, 0, JET_bitInjectionProbabilityPct ) );
+
+    CHECKCALLS( errThread );
+    CHECKCALLS( ctx.err );
+
+#ifdef PERFMON_SUPPORT
+    if ( !g_fDisablePerfmon )
+    {
+        CHECK( cVERBucketChainContended.Get( db.Pinst()->m_iInstance ) > cContendedBefore );
+    }
+#endif
+
+    CHECKCALLS( ErrVERTestSeek( db.Sesid(), tableid, ctx.lKey ) );
+
+    CHECKCALLS( JetCloseTable( db.Sesid(), tableid ) );
+    CHECKCALLS( db.ErrTerm() );
+}
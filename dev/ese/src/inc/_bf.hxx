@@ -244,7 +244,7 @@ struct BF
     BYTE                fAbandoned:1;
     BYTE                grbitReserved:3;
 
-    BYTE                rgbReserved2[ 1 ];
+    BYTE                iNumaNode;
 
     TCE                 tce;
 
@@ -336,7 +336,7 @@ struct BF
     BYTE                fAbandoned:1;
     BYTE                grbitReserved:3;
 
-    BYTE                rgbReserved1[ 1 ];
+    BYTE                iNumaNode;
 
     TCE                 tce;
 
@@ -529,7 +529,14 @@ extern void * g_pvIoThreadImageCheckCache;
 #endif
 
 
-DECLARE_LRUK_RESOURCE_UTILITY_MANAGER( Kmax, BF, BF::OffsetOfLRUKIC, IFMPPGNO, BFLRUK );
+inline IFMPPGNO IfmppgnoBFLRUKKey( const BF* const pbf )
+{
+    return IFMPPGNO( pbf->ifmp, pbf->pgno );
+}
+
+const INT cBFLRUKShardMax = 16;
+
+DECLARE_SHARDED_LRUK_RESOURCE_UTILITY_MANAGER( cBFLRUKShardMax, Kmax, BF, BF::OffsetOfLRUKIC, IFMPPGNO, IfmppgnoBFLRUKKey, BFLRUK );
 
 extern BFLRUK g_bflruk;
 extern double g_csecBFLRUKUncertainty;
@@ -772,10 +779,24 @@ extern LONG_PTR                 cbfInit;
 extern LONG_PTR                 g_cbfChunk;
 extern BF**                     g_rgpbfChunk;
 
+extern BOOL                     g_fBFNumaAware;
+extern DWORD                    g_cBFNumaNode;
+extern LONG                     g_cBFNumaAllocLocal;
+extern LONG                     g_cBFNumaAllocRemote;
+
 
 ERR ErrBFICacheInit( __in const LONG cbPageSizeMax );
 void BFICacheTerm();
 
+ERR ErrBFICacheINumaInit();
+void BFICacheINumaTerm();
+INLINE DWORD IBFICacheINumaNodeIpg( const IPG ipg );
+INLINE DWORD IBFICacheINumaNodeCurrent();
+BOOL FBFICacheICommit( const LONG_PTR ipgChunk, void* const pvStart, const size_t cb );
+INLINE void BFIAvailInsert( const PBF pbf, const BOOL fMRU );
+INLINE BFAvail::ERR ErrBFIAvailRemove( PBF* const ppbf, const INT cmsecTimeout, const BOOL fMRU );
+INLINE BOOL FBFIAvailPoolLowNuma();
+
 enum eResidentCacheStatusChange
 {
     eResidentCacheStatusNoChange = 0,
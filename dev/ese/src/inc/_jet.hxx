@@ -675,7 +675,9 @@ INLINE BOOL FAlignedForThisPlatform( const VOID * const pv )
 #define opRBSPrepareRevert                  158
 #define opRBSExecuteRevert                  159
 #define opRBSCancelRevert                   160
-#define opMax                               161
+#define opRetrieveLongValues                161
+#define opPrepareRetrieveColumns            162
+#define opMax                               163
 
 
 
@@ -985,6 +987,20 @@ typedef ERR VTAPI VTFNStreamRecords(
     _Out_opt_ ULONG * const                                 pcbActual,
     _In_ const JET_GRBIT                                            grbit );
 
+typedef ERR VTAPI VTFNRetrieveLongValues(
+    _In_ const JET_SESID                                            sesid,
+    _In_ const JET_TABLEID                                          tableid,
+    _Inout_updates_( cretrievelv ) JET_RETRIEVELONGVALUE * const    rgretrievelv,
+    _In_ const ULONG                                                cretrievelv,
+    _In_ const JET_GRBIT                                            grbit );
+
+typedef ERR VTAPI VTFNPrepareRetrieveColumns(
+    _In_ const JET_SESID                                                sesid,
+    _In_ const JET_TABLEID                                              tableid,
+    _In_reads_opt_( cretrievecolumn ) const JET_RETRIEVECOLUMN * const  rgretrievecolumn,
+    _In_ const ULONG                                                    cretrievecolumn,
+    _In_ const JET_GRBIT                                                grbit );
+
 
     
     
@@ -1060,6 +1076,8 @@ typedef struct tagVTFNDEF {
     VTFNRetrieveColumnByReference   *pfnRetrieveColumnByReference;
     VTFNPrereadColumnsByReference   *pfnPrereadColumnsByReference;
     VTFNStreamRecords               *pfnStreamRecords;
+    VTFNRetrieveLongValues          *pfnRetrieveLongValues;
+    VTFNPrepareRetrieveColumns      *pfnPrepareRetrieveColumns;
 } VTFNDEF;
 
 
@@ -1122,6 +1140,8 @@ extern VTFNPrereadIndexRange            ErrIllegalPrereadIndexRange;
 extern VTFNRetrieveColumnByReference    ErrIllegalRetrieveColumnByReference;
 extern VTFNPrereadColumnsByReference    ErrIllegalPrereadColumnsByReference;
 extern VTFNStreamRecords                ErrIllegalStreamRecords;
+extern VTFNRetrieveLongValues           ErrIllegalRetrieveLongValues;
+extern VTFNPrepareRetrieveColumns       ErrIllegalPrepareRetrieveColumns;
 
 
 
@@ -2072,6 +2092,36 @@ __forceinline ERR VTAPI ErrDispStreamRecords(
     return err;
 }
 
+__forceinline ERR VTAPI ErrDispRetrieveLongValues(
+    _In_ const JET_SESID                                            sesid,
+    _In_ const JET_TABLEID                                          tableid,
+    _Inout_updates_( cretrievelv ) JET_RETRIEVELONGVALUE * const    rgretrievelv,
+    _In_ const ULONG                                                cretrievelv,
+    _In_ const JET_GRBIT                                            grbit )
+{
+    ValidateTableid( sesid, tableid );
+
+    const VTFNDEF   * const pvtfndef = *( (VTFNDEF **)tableid );
+    const ERR       err = pvtfndef->pfnRetrieveLongValues( sesid, tableid, rgretrievelv, cretrievelv, grbit );
+
+    return err;
+}
+
+__forceinline ERR VTAPI ErrDispPrepareRetrieveColumns(
+    _In_ const JET_SESID                                                sesid,
+    _In_ const JET_TABLEID                                              tableid,
+    _In_reads_opt_( cretrievecolumn ) const JET_RETRIEVECOLUMN * const  rgretrievecolumn,
+    _In_ const ULONG                                                    cretrievecolumn,
+    _In_ const JET_GRBIT                                                grbit )
+{
+    ValidateTableid( sesid, tableid );
+
+    const VTFNDEF   * const pvtfndef = *( (VTFNDEF **)tableid );
+    const ERR       err = pvtfndef->pfnPrepareRetrieveColumns( sesid, tableid, rgretrievecolumn, cretrievecolumn, grbit );
+
+    return err;
+}
+
 
 typedef enum { runInstModeNoSet, runInstModeOneInst, runInstModeMultiInst} RUNINSTMODE;
 extern RUNINSTMODE g_runInstMode;
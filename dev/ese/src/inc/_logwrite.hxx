@@ -158,6 +158,13 @@ private:
         BOOL                fAllocOnly,
         __deref BYTE**      ppbET );
 
+    BOOL FLGICopySlotAvailable();
+    ULONG IcopyslotLGIReserve( BYTE* const pbLogRec, const LGPOS& lgposMaxWritePoint );
+    VOID LGICompleteCopySlot( const ULONG icopyslot );
+    VOID LGIRetireCopySlots();
+    VOID LGIWaitForCopySlots( const ULONG icopyslotEnd );
+    BOOL FLGICopiedEntry( BYTE** const ppbCopiedEntry, LGPOS* const plgposMaxWritePoint, ULONG* const picopyslotWait );
+
     BOOL FWakeWaitingQueue(
         const LGPOS* const plgposToWrite
         );
@@ -223,6 +230,22 @@ private:
     CMeteredSection     m_msLGPendingCopyIntoBuffer;
 
 
+    struct LGCOPYSLOT
+    {
+        BYTE *          pbStart;
+        LGPOS           lgposMaxWritePoint;
+        volatile LONG   fCopied;
+    };
+
+    enum { cLGCopySlot = 256 };
+
+    BOOL            m_fCopyCompletionTracking;
+    ULONG           m_icopyslotOldest;
+    ULONG           m_icopyslotNext;
+    ULONG           m_icopyslotFileEnd;
+    LGCOPYSLOT      m_rgcopyslot[ cLGCopySlot ];
+
+
     PIB             *m_ppibLGWriteQHead;
     PIB             *m_ppibLGWriteQTail;
 
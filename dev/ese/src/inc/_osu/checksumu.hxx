@@ -49,6 +49,16 @@ void ChecksumPage(
     PAGECHECKSUM * const pchecksumActual );
 
 
+void ChecksumPages(
+    const void * const * const rgpv,
+    const ULONG * const rgpgno,
+    const UINT cpage,
+    const UINT cb,
+    const PAGETYPE pagetype,
+    PAGECHECKSUM * const rgchecksumExpected,
+    PAGECHECKSUM * const rgchecksumActual );
+
+
 void ChecksumAndPossiblyFixPage(
     void * const pv,
     const UINT cb,
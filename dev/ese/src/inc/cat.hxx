@@ -54,8 +54,9 @@ const ULONG iMSO_SpaceHint              = 24;
 const ULONG iMSO_SpaceLVDeferredHints   = 25;
 const ULONG iMSO_LocaleName             = 26;
 const ULONG iMSO_LVChunkMax             = 27;
+const ULONG iMSO_CompressionDictionary  = 28;
 
-const ULONG idataMSOMax                 = 28;
+const ULONG idataMSOMax                 = 29;
 
 
 const FID   fidMSO_ObjidTable           = fidFixedLeast;
@@ -95,8 +96,9 @@ const FID   fidMSO_SeparateLVThreshold  = fidTaggedLeast+2;
 const FID   fidMSO_SpaceHints           = fidTaggedLeast+3;
 const FID   fidMSO_SpaceLVDeferredHints = fidTaggedLeast+4;
 const FID   fidMSO_LocaleName           = fidTaggedLeast+5;
+const FID   fidMSO_CompressionDictionary = fidTaggedLeast+6;
 
-const FID   fidMSO_TaggedLast           = fidMSO_LocaleName;
+const FID   fidMSO_TaggedLast           = fidMSO_CompressionDictionary;
 
 
 extern const OBJID  objidFDPMSO;
@@ -781,6 +783,17 @@ ERR ErrCATChangeColumnDefaultValue(
     const OBJID objidTable,
     const CHAR  *szColumn,
     const DATA& dataDefault );
+ERR ErrCATAddCompressionDictionary(
+    PIB         *ppib,
+    const IFMP  ifmp,
+    const OBJID objidTable,
+    const DATA& dataDictionary,
+    BYTE        *pidDictionary );
+ERR ErrCATCopyCompressionDictionaries(
+    PIB         * const ppib,
+    const IFMP  ifmpSrc,
+    const OBJID objidSrc,
+    FUCB        * const pfucbDest );
 
 ERR ErrCATDeleteOrUpdateOutOfDateLocalizedIndexes(
         IN PIB * const ppib,
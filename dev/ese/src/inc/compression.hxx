@@ -15,6 +15,19 @@ enum CompressFlags
     compressXpress10 = 0x0020,
 };
 
+struct PKDICTIONARY;
+
+const INT cbPKDictionaryMax = 32 * 1024;
+
+//  A value compressed with a dictionary names it by id (its itagSequence in the table's catalog
+//  record) and nothing records which values use which dictionary, so a dictionary cannot be
+//  retired while the table exists.  A table can therefore train at most cPKDictionaryMax of them;
+//  after that JET_TblInfoCompressionDictionary fails with JET_errCompressionDictionaryLimit and
+//  values keep using the newest dictionary.
+
+const INT cPKDictionaryMax = 16;
+const INT cbPKDictionaryMatchMin = 4;
+
 ERR ErrPKCompressData(
     const DATA& data,
     const CompressFlags compressFlags,
@@ -22,6 +35,45 @@ ERR ErrPKCompressData(
     _Out_writes_bytes_to_( cbDataCompressedMax, *pcbDataCompressedActual ) BYTE * const pbDataCompressed,
     const INT cbDataCompressedMax,
     _Out_ INT * const pcbDataCompressedActual );
+ERR ErrPKCompressData(
+    const DATA& data,
+    const CompressFlags compressFlags,
+    const INST* const pinst,
+    const PKDICTIONARY * const pdict,
+    _Out_writes_bytes_to_( cbDataCompressedMax, *pcbDataCompressedActual ) BYTE * const pbDataCompressed,
+    const INT cbDataCompressedMax,
+    _Out_ INT * const pcbDataCompressedActual );
+
+ERR ErrPKTrainDictionary(
+    _In_reads_( cdataSample ) const DATA * const rgdataSample,
+    const INT cdataSample,
+    _Out_writes_bytes_to_( cbDictionaryMax, *pcbDictionary ) BYTE * const pbDictionary,
+    const INT cbDictionaryMax,
+    _Out_ INT * const pcbDictionary );
+ERR ErrPKCreateDictionary(
+    const BYTE idDictionary,
+    const DATA& dataDictionary,
+    PKDICTIONARY * const pdictPrev,
+    _Out_ PKDICTIONARY ** const ppdict );
+VOID PKLinkDictionary( PKDICTIONARY * const pdict, PKDICTIONARY * const pdictPrev );
+VOID PKDeleteDictionaries( PKDICTIONARY * pdict );
+BOOL FPKCompressedWithDictionary( const DATA& dataCompressed );
+
+struct PKCOMPRESSREQ
+{
+    DATA    data;
+    BYTE *  pbDataCompressed;
+    INT     cbDataCompressedActual;
+    ERR     err;
+};
+
+VOID PKCompressDataParallel(
+    CGPTaskManager * const ptaskmgr,
+    const CompressFlags compressFlags,
+    const INST* const pinst,
+    _Inout_updates_( creq ) PKCOMPRESSREQ * const rgreq,
+    const INT creq );
+
 ERR ErrPKDecompressData(
     const DATA& dataCompressed,
     const FUCB* const pfucb,
@@ -197,6 +197,8 @@ const IFMP ifmpNil                      = 0x7fffffff;
 const ULONG cbReadSizeMax   = 512 * 1024;
 const ULONG cbWriteSizeMax  = 512 * 1024;
 
+const ULONG cbTTMAPMemoryMostDefault    = 64 * 1024 * 1024;
+
 const ULONG JET_IOPriorityMax = ( JET_IOPriorityLow | JET_IOPriorityLowForCheckpoint | JET_IOPriorityLowForScavenge );
 
 
@@ -232,6 +234,7 @@ const INT rankDBMScanSignalControl      = 10;
 const INT rankBFCacheSizeSet            = 10;
 const INT rankFMPRedoMaps               = 10;
 const INT rankRBSFirstValidGen          = 10;
+const INT rankLGRedoPageWorker          = 10;
 const INT rankFlushMapAccess            = 13;
 const INT rankFlushMapGrowth            = 15;
 const INT rankFlushMapAsyncWrite        = 15;
@@ -308,6 +311,7 @@ const char szLGResFiles[]           = "LGResFiles";
 const char szLGWaitQ[]              = "LGWaitQ";
 const char szJetTmpLog[]                = "JetTmpLog";
 const char szLGWrite[]              = "LGWrite";
+const char szLGRedoPageWorker[]     = "LGRedoPageWorker";
 const char szShadowLogConsume[]     = "ShadowLogConsume";
 const char szShadowLogBuff[]        = "ShadowLogBuff";
 const char szRES[]                  = "RES";
@@ -3392,6 +3392,7 @@ ERR ErrSNAPInit();
 void SNAPTerm();
 
 class SCRUBDB;
+class BKREADPIPELINE;
 typedef struct tagLGSTATUSINFO LGSTATUSINFO;
 PERSISTED struct CHECKPOINT_FIXED;
 struct LOG_VERIFY_STATE;
@@ -3633,6 +3634,10 @@ private:
     ULONG_PTR       m_ulSecsStartScrub;
     DBTIME          m_dbtimeLastScrubNew;
 
+    BKREADPIPELINE  *m_pbkreadpipeline;
+    CPG             m_cpgbkreadahead;
+    CPG             m_cpgbkreadslot;
+
     RHF             m_rgrhf[crhfMax];
     INT             m_crhfMac;
 
@@ -3659,6 +3664,8 @@ private:
                 ULONG cbLGDBGPageList
 #endif
                 );
+    ERR ErrBKIPipelineReadPages( const IFMP ifmp, const PGNO pgnoStart, const PGNO pgnoEnd, BYTE * const pbData, const BOOL fExtensiveChecks );
+    VOID BKIPipelineTerm();
 
     ERR ErrBKICopyFile(
         const WCHAR *wszFileName,
@@ -4152,6 +4159,7 @@ public:
 
 
     CResource           m_cresSCB;
+    LONG                m_cSORTParallelWorker;
 
 
     CGPTaskManager      m_taskmgr;
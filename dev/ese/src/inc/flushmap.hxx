@@ -401,10 +401,16 @@ class CFlushMap
             BYTE* const pbBitmap, const size_t cbBitmap,
             const PGNO pgno, const INT state,
             const size_t cbHeader, const DWORD cbitPerState, const BYTE mask );
+        INLINE void SetRangeStateOnBitmap_(
+            BYTE* const pbBitmap, const size_t cbBitmap,
+            const PGNO pgnoFirst, const CPG cpg, const INT state,
+            const size_t cbHeader, const DWORD cbitPerState );
         CPAGE::PageFlushType PgftGetFlushType_( FlushMapPageDescriptor* const pfmd, const PGNO pgno );
         void SetFlushType_( FlushMapPageDescriptor* const pfmd, const PGNO pgno, const CPAGE::PageFlushType pgft );
+        void SetRangeFlushType_( FlushMapPageDescriptor* const pfmd, const PGNO pgnoFirst, const CPG cpg, const CPAGE::PageFlushType pgft );
         BOOL FGetFlushTypeRuntime_( FlushMapPageDescriptor* const pfmd, const PGNO pgno );
         void SetFlushTypeRuntimeState_( FlushMapPageDescriptor* const pfmd, const PGNO pgno, const BOOL fRuntime );
+        void SetRangeFlushTypeRuntimeState_( FlushMapPageDescriptor* const pfmd, const PGNO pgnoFirst, const CPG cpg, const BOOL fRuntime );
 
         void LogEventFmFileAttachFailed_( const WCHAR* const wszFmFilePath, const ERR err );
         void LogEventFmFileDeleted_( const WCHAR* const wszFmFilePath, const WCHAR* const wszReason );
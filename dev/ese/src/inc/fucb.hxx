@@ -51,6 +51,8 @@ struct MOVE_FILTER_CONTEXT
     PFN_MOVE_FILTER         pfnMoveFilter;
 };
 
+struct RETRIEVE_PLAN;
+
 struct FUCB
     :   public CZeroInit
 {
@@ -231,9 +233,11 @@ struct FUCB
 
     MOVE_FILTER_CONTEXT*    pmoveFilterContext;
 
+    RETRIEVE_PLAN*  pretrieveplan;
+
     CInvasiveConcurrentModSet< FUCB, OffsetOfIAE>::CElement m_iae;
 
-    BYTE           rgbAlign2[24];
+    BYTE           rgbAlign2[16];
 
 #ifdef DEBUGGER_EXTENSION
     VOID Dump( CPRINTF * pcprintf, DWORD_PTR dwOffset = 0 ) const;
@@ -333,7 +337,8 @@ INLINE VOID FUCB::VerifyOptimalPacking()
     static_assert( NoWastedSpace( FUCB, cbEncryptionKey,       cpgSpaceRequestReserve) );
     static_assert( NoWastedSpace( FUCB, cpgSpaceRequestReserve,pbEncryptionKey) );
     static_assert( NoWastedSpace( FUCB, pbEncryptionKey,       pmoveFilterContext) );
-    static_assert( NoWastedSpace( FUCB, pmoveFilterContext,    m_iae) );
+    static_assert( NoWastedSpace( FUCB, pmoveFilterContext,    pretrieveplan) );
+    static_assert( NoWastedSpace( FUCB, pretrieveplan,         m_iae) );
 }
 #endif
 
@@ -76,6 +76,25 @@ BOOL FIOCheckUserDbNonFlushedIos( const INST * const pinst, const __int64 cioPer
 
 ERR ErrIOReadDbPages( IFMP ifmp, IFileAPI *pfapi, BYTE *pbData, LONG pgnoStart, LONG pgnoEnd, BOOL fCheckPagesOffset, LONG pgnoMost, const TraceContext& tc, BOOL fExtensiveChecks );
 
+struct READPAGE_DATA
+{
+    volatile ERR            err;
+    volatile LONG*          pacRead;
+    CAutoResetSignal*       pasigDone;
+    BOOL                    fCheckPagesOffset;
+    BOOL                    fExtensiveChecks;
+    IFMP                    ifmp;
+    LONG                    pgnoMost;
+
+    //  if not pgnoNull, this range lock is released when the last read completes, before
+    //  pasigDone is set
+
+    PGNO                    pgnoUnlockStart;
+    PGNO                    pgnoUnlockEnd;
+};
+
+ERR ErrIOIssueReadDbPages( IFMP ifmp, IFileAPI *pfapi, BYTE *pbData, LONG pgnoStart, LONG pgnoEnd, const TraceContext& tc, READPAGE_DATA * const preaddata );
+
 ERR ISAMAPI   ErrIsamGetInstanceInfo( ULONG *pcInstanceInfo, JET_INSTANCE_INFO_W ** paInstanceInfo, const CESESnapshotSession * pSnapshotSession );
 
 ERR ISAMAPI ErrIsamOSSnapshotPrepare( JET_OSSNAPID * psnapId, const JET_GRBIT   grbit );
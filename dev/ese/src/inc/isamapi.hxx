@@ -521,6 +521,20 @@ ERR VTAPI ErrIsamStreamRecords(
     _Out_opt_ ULONG * const                                 pcbActual,
     _In_ const JET_GRBIT                                            grbit );
 
+ERR VTAPI ErrIsamRetrieveLongValues(
+    _In_ const JET_SESID                                            sesid,
+    _In_ const JET_TABLEID                                          tableid,
+    _Inout_updates_( cretrievelv ) JET_RETRIEVELONGVALUE * const    rgretrievelv,
+    _In_ const ULONG                                                cretrievelv,
+    _In_ const JET_GRBIT                                            grbit );
+
+ERR VTAPI ErrIsamPrepareRetrieveColumns(
+    _In_ const JET_SESID                                                sesid,
+    _In_ const JET_TABLEID                                              tableid,
+    _In_reads_opt_( cretrievecolumn ) const JET_RETRIEVECOLUMN * const  rgretrievecolumn,
+    _In_ const ULONG                                                    cretrievecolumn,
+    _In_ const JET_GRBIT                                                grbit );
+
 ERR VTAPI ErrIsamRetrieveColumnFromRecordStream(
     _Inout_updates_bytes_( cbData ) void * const    pvData,
     _In_ const ULONG                        cbData,
@@ -585,6 +599,8 @@ VTFNPrereadIndexRange           ErrIsamPrereadIndexRange;
 VTFNRetrieveColumnByReference   ErrIsamRetrieveColumnByReference;
 VTFNPrereadColumnsByReference   ErrIsamPrereadColumnsByReference;
 VTFNStreamRecords               ErrIsamStreamRecords;
+VTFNRetrieveLongValues          ErrIsamRetrieveLongValues;
+VTFNPrepareRetrieveColumns      ErrIsamPrepareRetrieveColumns;
 #ifndef ESENT
 #pragma prefast(pop)
 #endif
@@ -39,6 +39,7 @@ class JetUnitTestResult
         void Start( const char * const szTest );
         void Finish();
         void AddFailure( const JetUnitTestFailure& failure );
+        void AddMetric( const char * const szMetric, const QWORD qwValue, const char * const szUnit );
 
         INT Failures() const;
 
@@ -99,6 +100,7 @@ class JetSimpleUnitTest : public JetUnitTest
 
         virtual void Run_() = 0;
         void Fail_( const char * const szFile, const INT line, const char * const szCondition );
+        void Metric_( const char * const szMetric, const QWORD qwValue, const char * const szUnit );
 
     private:
         DWORD               m_dwFacilities;
@@ -170,6 +172,7 @@ class JetSimpleDbUnitTest : public JetSimpleUnitTest
 
         virtual void Run_() = 0;
         void Fail_( const char * const szFile, const INT line, const char * const szCondition );
+        void Metric_( const char * const szMetric, const QWORD qwValue, const char * const szUnit );
 
     private:
         IFMP                m_ifmp;
@@ -188,6 +191,7 @@ class JetTestFixture
         virtual ~JetTestFixture();
 
         void Fail_( const char * const szFile, const INT line, const char * const szCondition );
+        void Metric_( const char * const szMetric, const QWORD qwValue, const char * const szUnit );
 
         virtual bool SetUp_() = 0;
         virtual void TearDown_() = 0;
@@ -196,6 +200,49 @@ class JetTestFixture
         JetUnitTestResult * m_presult;
 };
 
+//  An instance, session and database rooted at .\<name>\ for tests that run against
+//  the full JET API.  Helpers return ERR so they can be shared by tests and fixtures.
+
+class JetTestDatabase
+{
+    public:
+        static const JET_GRBIT bitRecovery          = 0x1;  //  logged instance (logs and checkpoint under .\<name>\)
+        static const JET_GRBIT bitNoDatabase        = 0x2;  //  session only
+        static const JET_GRBIT bitAttachExisting    = 0x4;  //  attach .\<name>\<name>.edb instead of creating it
+
+        JetTestDatabase();
+        ~JetTestDatabase();
+
+        //  ErrCreateInstance() + ErrInit(), for tests that need no other system parameters.
+
+        ERR ErrInit( const WCHAR * const wszName, const JET_GRBIT grbit = NO_GRBIT );
+
+        ERR ErrCreateInstance( const WCHAR * const wszName, const JET_GRBIT grbit = NO_GRBIT );
+        ERR ErrSetParam( const ULONG paramid, const JET_API_PTR ulParam, const WCHAR * const wszParam = NULL );
+        ERR ErrInit( JET_RSTINFO2_W * const prstinfo = NULL );    //  prstinfo carries a recovery callback
+        ERR ErrTerm( const JET_GRBIT grbitTerm = JET_bitTermComplete );
+
+        JET_INSTANCE Inst() const           { return m_inst; }
+        INST * Pinst() const                { return (INST *)m_inst; }
+        JET_SESID Sesid() const             { return m_sesid; }
+        PIB * Ppib() const                  { return (PIB *)m_sesid; }
+        JET_DBID Dbid() const               { return m_dbid; }
+        IFMP Ifmp() const                   { return (IFMP)m_dbid; }
+        const WCHAR * WszDatabase() const   { return m_wszDatabase; }
+
+    private:
+        JET_INSTANCE    m_inst;
+        JET_SESID       m_sesid;
+        JET_DBID        m_dbid;
+        JET_GRBIT       m_grbit;
+        WCHAR           m_wszPath[ 64 ];
+        WCHAR           m_wszDatabase[ 64 ];
+
+    private:
+        JetTestDatabase( const JetTestDatabase& );
+        JetTestDatabase& operator=( const JetTestDatabase& );
+};
+
 
 #define JETUNITTEST(component,test) \
 class Test##component##test : public JetSimpleUnitTest                  \
@@ -252,11 +299,15 @@ void Test##component##test::Run_()
         FAIL( #_err " Failed with above throw site." );     \
     }
 
+#define REPORTMETRIC( _szMetric, _qwValue, _szUnit )    \
+    Metric_( _szMetric, _qwValue, _szUnit )
+
 #else
 
 #define FAIL(_reason)
 #define CHECK(_condition)
 #define CHECKCALLS( _err )
+#define REPORTMETRIC( _szMetric, _qwValue, _szUnit )
 
 #define JETUNITTEST(component,test)         VOID DisabledTest##component##test( VOID )
 #define JETUNITTESTEX(component,test,facilities)    VOID DisabledTest##component##test( VOID )
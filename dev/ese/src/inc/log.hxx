@@ -49,6 +49,7 @@ struct VERPROXY;
 
 class CTableHash;
 class CSessionHash;
+class CRedoPageWorkers;
 
 
 extern CCriticalSection     g_critDBGPrint;
@@ -1428,6 +1429,9 @@ private:
 
     CSessionHash    *m_pcsessionhash;
 
+    INT                 m_cLGRedoPageWorker;
+    CRedoPageWorkers    *m_predopageworkers;
+
     BOOL            m_fUseRecoveryLogFileSize;
     LONG            m_lLogFileSizeDuringRecovery;
 
@@ -1767,7 +1771,17 @@ private:
     ERR ErrLGRIRedoSplit( PIB *ppib, DBTIME dbtime );
     ERR ErrLGRIRedoMacroOperation( PIB *ppib, DBTIME dbtime );
     ERR ErrLGRIRedoNodeOperation( const LRNODE_ *plrnode, ERR *perr );
+    ERR ErrLGRIRedoNodeOperationOnPage( PIB *ppib, CTableHash *pctablehash, const LRNODE_ *plrnode );
     ERR ErrLGRIRedoScrub( const LRSCRUB * const plrscrub );
+    ERR ErrLGRIRedoScrubOnPage( PIB *ppib, const IFMP ifmp, const LRSCRUB * const plrscrub );
+    BOOL FLGRIRedoOnPageWorker( const LR * const plr, const IFMP ifmp ) const;
+    ERR ErrLGRIRedoOnPageWorker( PIB *ppib, CTableHash *pctablehash, const IFMP ifmp, const LGPOS& lgpos, const LR * const plr );
+    ERR ErrLGRIDispatchRedoPageWorker( const IFMP ifmp, const PGNO pgno, const LR * const plr );
+    ERR ErrLGRIWaitRedoPageWorker( const IFMP ifmp, const PGNO pgno );
+    ERR ErrLGRIRedoPageWorkerBarrier( const LR * const plr );
+    ERR ErrLGRIDrainRedoPageWorkers();
+    VOID LGRITermRedoPageWorkers();
+    LGPOS LgposLGRIRedoApplied();
     ERR ErrLGRIRedoNewPage( const LRNEWPAGE * const plrnewpage );
     ERR ErrLGRIIRedoPageMove( __in PIB * const ppib, const LRPAGEMOVE * const plrpagemove );
     ERR ErrLGRIRedoPageMove( const LRPAGEMOVE * const plrpagemove );
@@ -1802,6 +1816,8 @@ private:
     friend class TestLOGCheckRedoConditionForDatabaseTests;
 #endif
 
+    friend class CRedoPageWorkers;
+
     friend CHECKPOINT *        PcheckpointEDBGAccessor( const LOG * const plog );
     friend const LOG_BUFFER *  PlogbufferEDBGAddrAccessor( const LOG * const plog );
     friend ILogStream *        PlogstreamEDBGAccessor( const LOG * const plog );
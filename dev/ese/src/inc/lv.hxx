@@ -311,6 +311,18 @@ ERR ErrLVPrereadLongValue(
     _In_ const ULONG    ulOffset,
     _In_ const ULONG    cbData );
 
+struct LVPREREAD
+{
+    LvId        lid;
+    ULONG       ibOffset;
+    ULONG       cbData;
+};
+
+ERR ErrLVPrereadLongValueRanges(
+    _In_ FUCB * const                                   pfucb,
+    _Inout_updates_( clvpreread ) LVPREREAD * const     rglvpreread,
+    _In_ const ULONG                                    clvpreread );
+
 typedef struct
 {
     BOOL                    fStarted;
@@ -36,11 +36,20 @@ INT     IlineNDISeekGEQ(
             const CPAGE& cpage,
             const BOOKMARK& bm,
             const BOOL fUnique,
-            INT * plastCompare );
+            INT * plastCompare,
+            const BOOL fSearchHint = fFalse );
 INT     IlineNDISeekGEQInternal(
             const CPAGE& cpage,
             const BOOKMARK& bm,
-            INT * plastCompare );
+            INT * plastCompare,
+            const BOOL fSearchHint = fFalse );
+
+ERR     ErrNDInit();
+VOID    NDTerm();
+VOID    NDInvalidateSearchHint  ( const IFMP ifmp, const PGNO pgno );
+#ifdef ENABLE_JET_UNIT_TEST
+BOOL    FNDSearchHintCached     ( const IFMP ifmp, const PGNO pgno );
+#endif
 
 ERR     ErrNDInsert(
             FUCB * const pfucb,
@@ -1696,6 +1696,7 @@ VOID RECRemoveMoveFilter(
     MOVE_FILTER_CONTEXT ** const    ppmoveFilterContextRemoved = NULL );
 ERR ErrRECCheckMoveFilter( FUCB * const pfucb, MOVE_FILTER_CONTEXT* const pmoveFilterContext );
 VOID RECRemoveCursorFilter( FUCB * const pfucb );
+VOID RECRemoveRetrievePlan( FUCB * const pfucb );
 
 ERR ErrRECIAddToIndex(
     FUCB        *pfucb,
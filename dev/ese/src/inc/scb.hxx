@@ -22,6 +22,10 @@ const LONG crunFanInMax = 16;
 
 const LONG cpgClusterSize = 16;
 
+const LONG cspairSortParallelMin = 1024;
+
+const LONG cmergeParallelMax = 16;
+
 #include <pshpack1.h>
 
 PERSISTED
@@ -181,6 +185,27 @@ INLINE VOID OTNODEReleasePotnode( OTNODE *& potnode )
 
 
 
+struct SCB;
+
+struct MCB
+{
+    SCB         *pscb;
+
+    PGNO        pgnoNext;
+    BFLatch     bflOut;
+    BYTE        *pbOutMac;
+    BYTE        *pbOutMax;
+
+    LONG        crunMerge;
+    BYTE        rgbReserved1[4];
+    MTNODE      rgmtnode[crunFanInMax];
+
+    BFLatch     bflLast;
+    VOID        *pvAssyLast;
+};
+
+
+
 struct SCB
 {
     SCB( const IFMP ifmp, const PGNO pgnoFDP )
@@ -188,6 +213,7 @@ struct SCB
             rgbRec( NULL ),
             rgspair( NULL )
     {
+        mcb.pscb = this;
     }
     ~SCB()
     {
@@ -235,17 +261,7 @@ public:
     LONG        crun;
     RUNLIST     runlist;
 
-    PGNO        pgnoNext;
-    BFLatch     bflOut;
-    BYTE        *pbOutMac;
-    BYTE        *pbOutMax;
-
-    LONG        crunMerge;
-    BYTE        rgbReserved1[4];
-    MTNODE      rgmtnode[crunFanInMax];
-
-    BFLatch     bflLast;
-    VOID        *pvAssyLast;
+    MCB         mcb;
 
 };
 
@@ -265,6 +281,14 @@ INLINE ERR ErrSCBInit( INST *pinst )
 {
     ERR err = JET_errSuccess;
 
+    WCHAR wszBuf[ 16 ] = { 0 };
+    pinst->m_cSORTParallelWorker = 1;
+    if (    FOSConfigGet( L"SORT", L"Parallel Sort Workers", wszBuf, sizeof( wszBuf ) ) &&
+            wszBuf[ 0 ] )
+    {
+        pinst->m_cSORTParallelWorker = max( 1, min( (INT)_wtol( wszBuf ), (INT)cmergeParallelMax ) );
+    }
+
     if ( UlParam( pinst, JET_paramMaxTemporaryTables ) == 0 )
     {
         return JET_errSuccess;
@@ -376,7 +400,7 @@ INLINE LONG CbSRECKeyDataPsrec( const SREC * psrec )
 
 struct RCB
 {
-    SCB             *pscb;
+    MCB             *pmcb;
     RUNINFO         runinfo;
     BFLatch         rgbfl[cpgClusterSize];
     LONG            ipbf;
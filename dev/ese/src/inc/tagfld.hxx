@@ -807,6 +807,12 @@ class TAGFIELDS
                             const DATA&         dataRec,
                             DATA                * const pdataRetrieveBuffer,
                             const JET_GRBIT     grbit );
+        VOID            RetrieveFirstInstances(
+                            const ULONG         cfid,
+                            const FID           * const rgfid,
+                            const BOOL          * const rgfDerived,
+                            DATA                * const rgdataRetrieved,
+                            ERR                 * const rgerrRetrieved );
         ULONG           UlColumnInstances(
                             FCB                 * const pfcb,
                             const COLUMNID      columnid,
@@ -308,6 +308,9 @@ extern const WORD ibRECStartFixedColumns;
 typedef ULONG   DBK;
 ERR ErrRECIInitAutoIncrement( _In_ FUCB* const pfucb, QWORD qwAutoInc );
 
+struct PKDICTIONARY;
+VOID PKDeleteDictionaries( PKDICTIONARY * pdict );
+
 
 class TDB
     :   public CZeroInit
@@ -424,7 +427,10 @@ class TDB
     private:
         DWORD               m_dwAutoIncBatchSize;
         QWORD               m_qwAllocatedAutoIncMax;
-        BYTE                m_bReserved[8];
+        PKDICTIONARY *      m_pdictCompression;
+#ifndef _AMD64_
+        BYTE                m_bReserved[4];
+#endif
 
 
         CInitOnce< ERR, decltype( &ErrRECIInitAutoIncrement ), FUCB * const, QWORD >  m_AutoIncInitOnce;
@@ -465,6 +471,7 @@ class TDB
         FCB *PfcbLV() const;
         ULONG CbPreferredIntrinsicLV() const;
         LONG CbLVChunkMost() const;
+        PKDICTIONARY *PdictCompression() const;
         FCB *PfcbTemplateTable() const;
         BYTE *RgbitAllIndex() const;
         const CBDESC *Pcbdesc() const;
@@ -553,6 +560,7 @@ class TDB
         VOID SetPfcbLV( FCB *pfcbLV );
         VOID SetPreferredIntrinsicLV( ULONG cb );
         VOID SetLVChunkMost( LONG cb );
+        VOID SetPdictCompression( PKDICTIONARY *pdict );
         VOID SetPfcbTemplateTable( FCB *pfcb );
         VOID AssertValidTemplateTable() const;
         VOID AssertValidDerivedTable() const;
@@ -671,6 +679,9 @@ INLINE TDB::~TDB()
         m_pfcbTemplateTable = NULL;
     }
 
+    PKDeleteDictionaries( m_pdictCompression );
+    m_pdictCompression = NULL;
+
     MemPool().MEMPOOLRelease();
     OSMemoryHeapFree( PfieldsInitial() );
     OSMemoryHeapFree( PdataDefaultRecord() );
@@ -743,6 +754,7 @@ INLINE volatile unsigned __int64* TDB::PUi64LidLast()       { return &m_lidLast;
 INLINE FCB *TDB::PfcbLV() const                             { return m_pfcbLV; }
 INLINE ULONG TDB::CbPreferredIntrinsicLV() const            { return m_cbPreferredIntrinsicLV; }
 INLINE LONG TDB::CbLVChunkMost() const                      { return m_cbLVChunkMost; }
+INLINE PKDICTIONARY *TDB::PdictCompression() const          { return m_pdictCompression; }
 INLINE FCB *TDB::PfcbTemplateTable() const                  { return m_pfcbTemplateTable; }
 INLINE BYTE *TDB::RgbitAllIndex() const                     { return const_cast<TDB *>( this )->m_rgbitAllIndex; }
 INLINE const CBDESC *TDB::Pcbdesc() const                   { return m_pcbdesc; }
@@ -756,6 +768,7 @@ INLINE VOID TDB::SetPdataDefaultRecord( DATA * const pdata ){ m_pdataDefaultReco
 INLINE VOID TDB::SetPfcbLV( FCB *pfcbLV )                   { m_pfcbLV = pfcbLV; }
 INLINE VOID TDB::SetPreferredIntrinsicLV( ULONG cb )        { m_cbPreferredIntrinsicLV = cb; }
 INLINE VOID TDB::SetLVChunkMost( LONG cb )                  { m_cbLVChunkMost = cb; }
+INLINE VOID TDB::SetPdictCompression( PKDICTIONARY *pdict ) { m_pdictCompression = pdict; }
 
 INLINE VOID TDB::SetPfcbTemplateTable( FCB *pfcb )          { m_pfcbTemplateTable = pfcb; }
 
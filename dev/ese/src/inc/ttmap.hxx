@@ -60,12 +60,16 @@ class TTARRAY
 class TTMAP
 {
     public:
-        TTMAP( PIB * const ppib );
+        TTMAP( PIB * const ppib, const ULONG cbMemoryMost = cbTTMAPMemoryMostDefault );
         ~TTMAP();
 
         ERR ErrInit( INST * const );
         ERR ErrInsertKeyValue( const unsigned __int64 ui64Key, const ULONG ulValue )
         {
+            if ( FInMemory_() )
+            {
+                return PentryFind_( ui64Key ) ? ErrERRCheck( JET_errKeyDuplicate ) : ErrInsertEntry_( ui64Key, ulValue );
+            }
             return ErrInsertKeyValue_( ui64Key, ulValue );
         }
         ERR ErrSetValue( const unsigned __int64 ui64Key, const ULONG ulValue );
@@ -83,9 +87,33 @@ class TTMAP
         TTMAP( const TTMAP& );
         TTMAP& operator= ( const TTMAP& );
 
+    private:
+        struct ENTRY
+        {
+            unsigned __int64    ui64Key;
+            ULONG               ulValue;
+            ULONG               ulState;
+        };
+
+        enum { entryFree = 0, entryUsed = 1, entryDeleted = 2 };
+        enum { centryInitial = 1024 };
+
     private:
         ERR ErrInsertKeyValue_( const unsigned __int64 ui64Key, const ULONG ulValue );
         ERR ErrRetrieveValue_( const unsigned __int64 ui64Key, ULONG * const pulValue ) const;
+
+        ERR ErrOpenTempTable_();
+        ERR ErrSpill_();
+
+        BOOL FInMemory_() const     { return NULL != m_rgentry; }
+        ULONG IentryHash_( const unsigned __int64 ui64Key ) const;
+        ENTRY * PentryFind_( const unsigned __int64 ui64Key ) const;
+        ERR ErrInsertEntry_( const unsigned __int64 ui64Key, const ULONG ulValue );
+        ERR ErrRehash_( const ULONG centryNew );
+        ERR ErrSortKeys_();
+        QWORD CbSortedKeys_() const { return (QWORD)m_cui64KeySortedMax * sizeof( unsigned __int64 ); }
+
+        static BOOL CmpEntry_( const ENTRY& entry1, const ENTRY& entry2 ) { return entry1.ui64Key < entry2.ui64Key; }
         
     private:
         JET_TABLEID m_tableid;
@@ -95,6 +123,21 @@ class TTMAP
         JET_COLUMNID    m_columnidValue;
         
         LONG            m_crecords;
+
+        ULONG               m_cbMemoryMost;
+        ENTRY *             m_rgentry;
+        ULONG               m_centry;
+        ULONG               m_centryUsed;
+        ULONG               m_centryDeleted;
+
+        unsigned __int64 *  m_rgui64KeySorted;
+        ULONG               m_cui64KeySorted;
+        ULONG               m_cui64KeySortedMax;
+        ULONG               m_iui64KeyCurrent;
+        unsigned __int64    m_ui64KeyCurrent;
+        BOOL                m_fCurrency;
+        BOOL                m_fSortedStale;
+        BOOL                m_fSeekNext;
 };
 
 
@@ -1007,9 +1007,9 @@ INLINE BOOL FVERPotThere( const VS vs, const BOOL fDelete )
     return ( !fDelete || vsUncommittedByOther == vs );
 }
 
-#ifdef DEBUGGER_EXTENSION
+#if defined( DEBUGGER_EXTENSION ) || defined( ENABLE_JET_UNIT_TEST )
 
-UINT UiVERHash( IFMP ifmp, PGNO pgnoFDP, const BOOKMARK& bookmark, const UINT crcehead );
+UINT UiVERHash( IFMP ifmp, PGNO pgnoFDP, const BOOKMARK& bookmark );
 
 #endif
 
@@ -1022,18 +1022,58 @@ class VER
 {
 #ifdef DEBUGGER_EXTENSION
     friend VOID EDBGVerHashSum( INST * pinstDebuggee, BOOL fVerbose );
+    friend RCE * PrceRCEChainEDBGAccessor( const VER * const pver, const UINT ui );
+#endif
+#ifdef ENABLE_JET_UNIT_TEST
+    friend class TestVERRCEChainSplitsInOneStripe;
 #endif
 
 private:
+    enum { cprceChainInitial = 16 };
+    enum { cprceChainMost = 1024 };
+    enum { cnodePerChainMost = 2 };
+
+    //  the chain array of a lock stripe that has split at least once; allocated on
+    //  the first split so that a stripe that never splits costs one pointer
+
+    struct RCECHAINS
+    {
+        RCECHAINS() :
+        rgprceChain( NULL ),
+        cprceChainMax( 0 ),
+        cprceChain( 1 ),
+        uiMaskChain( 0 ),
+        cnode( 0 )
+        {}
+
+        ~RCECHAINS()
+        {
+            OSMemoryHeapFree( rgprceChain );
+        }
+
+        RCE**               rgprceChain;
+        UINT                cprceChainMax;
+        UINT                cprceChain;
+        UINT                uiMaskChain;
+        volatile UINT       cnode;
+    };
+
     struct RCEHEAD
     {
         RCEHEAD() :
         rwl( CLockBasicInfo( CSyncBasicInfo( szRCEChain ), rankRCEChain, 0 ) ),
-        prceChain( prceNil )
+        prceChain( prceNil ),
+        prcechains( NULL )
         {}
 
+        ~RCEHEAD()
+        {
+            delete prcechains;
+        }
+
         CReaderWriterLock   rwl;
         RCE*                prceChain;
+        RCECHAINS* volatile prcechains;
     };
 
     struct RCEHEADLEGACY
@@ -1070,9 +1110,33 @@ public:
     CAutoResetSignal    m_asigRCECleanDone;
     CNestableCriticalSection    m_critRCEClean;
 
-    CCriticalSection    m_critBucketGlobal;
-    BUCKET              *m_pbucketGlobalHead;
-    BUCKET              *m_pbucketGlobalTail;
+    enum { cbucketchainMax = 64 };
+
+    struct BUCKETCHAIN
+    {
+        BUCKETCHAIN() :
+            crit( CLockBasicInfo( CSyncBasicInfo( szBucketGlobal ), rankBucketGlobal, 0 ) ),
+            pbucketHead( pbucketNil ),
+            pbucketTail( pbucketNil )
+        {
+        }
+
+        CCriticalSection    crit;
+        BUCKET              *pbucketHead;
+        BUCKET              *pbucketTail;
+        BYTE                rgbPad[ 64 - ( sizeof( CCriticalSection ) + 2 * sizeof( BUCKET * ) ) % 64 ];
+    };
+
+    struct BUCKETCLEANCURSOR
+    {
+        BUCKET              *pbucket;
+        RCE                 *prce;
+        RCE                 *prceLimit;
+        BOOL                fSkippedRCEInBucket;
+    };
+
+    size_t              m_cbucketchain;
+    BUCKETCHAIN         m_rgbucketchain[ cbucketchainMax ];
 
     CResource           m_cresBucket;
     DWORD_PTR           m_cbBucket;
@@ -1124,11 +1188,15 @@ private:
     INLINE size_t CbBUFree( const BUCKET * pbucket );
     INLINE BOOL FVERICleanWithoutIO();
     INLINE BOOL FVERICleanDiscardDeletes();
-    INLINE ERR ErrVERIBUAllocBucket( const INT cbRCE, const UINT uiHash );
-    INLINE BUCKET *PbucketVERIGetOldest( );
-    BUCKET *PbucketVERIFreeAndGetNextOldestBucket( BUCKET * pbucket );
-
-    ERR ErrVERIAllocateRCE( INT cbRCE, RCE ** pprce, const UINT uiHash );
+    INLINE size_t IbucketchainVERIGet();
+    INLINE VOID VERIEnterBucketChain( const size_t ibucketchain );
+    INLINE ERR ErrVERIBUAllocBucket( const size_t ibucketchain, const INT cbRCE, const UINT uiHash );
+    INLINE BUCKET *PbucketVERIGetOldest( const size_t ibucketchain );
+    BUCKET *PbucketVERIFreeAndGetNextOldestBucket( const size_t ibucketchain, BUCKET * pbucket );
+
+    ERR ErrVERIAllocateRCE( const size_t ibucketchain, INT cbRCE, RCE ** pprce, const UINT uiHash );
+    INLINE VOID VERICleanCursorStartBucket( BUCKETCLEANCURSOR * const pcursor );
+    BOOL FVERICleanCursorCurrent( const size_t ibucketchain, BUCKETCLEANCURSOR * const pcursor );
     ERR ErrVERIMoveRCE( RCE * prce );
     ERR ErrVERICreateRCE(
             INT         cbNewRCE,
@@ -1199,6 +1267,8 @@ public:
     RCEID RceidLast();
     RCEID RceidLastIncrement();
 
+    BOOL FVERBucketsAllocated();
+
     VOID IncrementCAsyncCleanupDispatched();
     VOID IncrementCSyncCleanupDispatched();
     VOID IncrementCCleanupFailed();
@@ -1208,10 +1278,16 @@ public:
     VOID Dump( CPRINTF * pcprintf, DWORD_PTR dwOffset = 0 ) const;
 #endif
 
+    INLINE UINT IrceheadRCEChain( UINT ui ) const;
+    static UINT IprceRCEChain( const RCECHAINS * const prcechains, UINT ui );
+    INLINE UINT IprceRCEChain( UINT ui ) const;
     INLINE CReaderWriterLock& RwlRCEChain( UINT ui );
     INLINE RCE *GetChain( UINT ui ) const;
     INLINE RCE **PGetChain( UINT ui );
     INLINE VOID SetChain( UINT ui, RCE * );
+    INLINE BOOL FRCEChainEmpty( UINT ui ) const;
+    VOID VERIRCEChainNodeInserted( UINT ui );
+    VOID VERIRCEChainNodeDeleted( UINT ui );
 
 #ifdef RTM
 #else
@@ -1219,7 +1295,7 @@ public:
     ERR ErrInternalCheck();
 
 protected:
-    ERR ErrCheckRCEHashList( const RCE * const prce, const UINT uiHash ) const;
+    ERR ErrCheckRCEHashList( const RCE * const prce, const UINT ircehead, const UINT iprceChain ) const;
     ERR ErrCheckRCEChain( const RCE * const prce, const UINT uiHash ) const;
 #endif
 };
@@ -7171,6 +7171,29 @@ namespace Isam
 
     };
 
+    [Serializable]
+    public ref class IsamCompressionDictionaryLimitException : public IsamUsageException
+    {
+    public:
+        IsamCompressionDictionaryLimitException() : IsamUsageException( "The table already has the maximum number of compression dictionaries", JET_errCompressionDictionaryLimit)
+        {
+        }
+
+        IsamCompressionDictionaryLimitException( String ^ description, Exception^ innerException ) :
+            IsamUsageException( description, innerException )
+        {
+        }
+
+        IsamCompressionDictionaryLimitException(
+            System::Runtime::Serialization::SerializationInfo^ info,
+            System::Runtime::Serialization::StreamingContext context
+        )
+            : IsamUsageException( info, context )
+        {
+        }
+
+    };
+
     [Serializable]
     public ref class IsamTooManySortsException : public IsamMemoryException
     {
@@ -9005,6 +9028,8 @@ static IsamErrorException^ JetErrToException( const JET_ERR err )
             return gcnew IsamDecryptionFailedException;
         case JET_errEncryptionBadItag:
             return gcnew IsamEncryptionBadItagException;
+        case JET_errCompressionDictionaryLimit:
+            return gcnew IsamCompressionDictionaryLimitException;
         case JET_errTooManySorts:
             return gcnew IsamTooManySortsException;
         case JET_errTooManyAttachedDatabases:
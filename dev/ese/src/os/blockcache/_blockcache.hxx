@@ -28,9 +28,9 @@
 #include "blockcache\_journalsegmentmanager.hxx"
 #include "blockcache\_journalentryfragment.hxx"
 #include "blockcache\_journal.hxx"
+#include "blockcache\_hashedlrukcachestate.hxx"
 #include "blockcache\_hashedlrukcacheheader.hxx"
 #include "blockcache\_hashedlrukcachedfiletableentry.hxx"
-#include "blockcache\_hashedlrukcachestate.hxx"
 #include "blockcache\_hashedlrukcache.hxx"
 #include "blockcache\_cachefactory.hxx"
 #include "blockcache\_cachewrapper.hxx"
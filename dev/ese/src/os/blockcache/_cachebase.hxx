@@ -52,18 +52,20 @@ class TCacheBase
                                 _In_opt_ CSemaphore* const  psem    = NULL);
 
 
-        void ReportMiss(    _In_ CFTE* const    pcfte,
-                            _In_ const QWORD    ibOffset,
-                            _In_ const DWORD    cbData,
-                            _In_ const BOOL     fRead,
-                            _In_ const BOOL     fCacheIfPossible );
+        void ReportMiss(    _In_ CFTE* const     pcfte,
+                            _In_ const QWORD     ibOffset,
+                            _In_ const DWORD     cbData,
+                            _In_ const OSFILEQOS grbitQOS,
+                            _In_ const BOOL      fRead,
+                            _In_ const BOOL      fCacheIfPossible );
 
 
-        void ReportHit( _In_ CFTE* const    pcfte,
-                        _In_ const QWORD    ibOffset,
-                        _In_ const DWORD    cbData,
-                        _In_ const BOOL     fRead,
-                        _In_ const BOOL     fCacheIfPossible );
+        void ReportHit( _In_ CFTE* const     pcfte,
+                        _In_ const QWORD     ibOffset,
+                        _In_ const DWORD     cbData,
+                        _In_ const OSFILEQOS grbitQOS,
+                        _In_ const BOOL      fRead,
+                        _In_ const BOOL      fCacheIfPossible );
 
 
         void ReportUpdate(  _In_ CFTE* const    pcfte,
@@ -400,12 +402,18 @@ VOID TCacheBase<I, CFTE>::ReleaseCachedFile(    _In_opt_ CFTE* const   pcfte,
 }
 
 template< class I, class CFTE >
-void TCacheBase<I, CFTE>::ReportMiss(   _In_ CFTE* const    pcfte,
-                                        _In_ const QWORD    ibOffset,
-                                        _In_ const DWORD    cbData,
-                                        _In_ const BOOL     fRead,
-                                        _In_ const BOOL     fCacheIfPossible )
+void TCacheBase<I, CFTE>::ReportMiss(   _In_ CFTE* const     pcfte,
+                                        _In_ const QWORD     ibOffset,
+                                        _In_ const DWORD     cbData,
+                                        _In_ const OSFILEQOS grbitQOS,
+                                        _In_ const BOOL      fRead,
+                                        _In_ const BOOL      fCacheIfPossible )
 {
+    if ( grbitQOS == ICache::qosPrefetch )
+    {
+        return;
+    }
+
     const ICacheTelemetry::FileNumber filenumber = pcfte->Filenumber();
     const ICacheTelemetry::BlockNumber blocknumberMax = pcfte->Blocknumber( ibOffset + cbData + pcfte->CbBlockSize() - 1 );
     for (   ICacheTelemetry::BlockNumber blocknumber = pcfte->Blocknumber( ibOffset );
@@ -417,12 +425,18 @@ void TCacheBase<I, CFTE>::ReportMiss(   _In_ CFTE* const    pcfte,
 }
 
 template< class I, class CFTE >
-void TCacheBase<I, CFTE>::ReportHit(    _In_ CFTE* const    pcfte,
-                                        _In_ const QWORD    ibOffset,
-                                        _In_ const DWORD    cbData,
-                                        _In_ const BOOL     fRead,
-                                        _In_ const BOOL     fCacheIfPossible )
+void TCacheBase<I, CFTE>::ReportHit(    _In_ CFTE* const     pcfte,
+                                        _In_ const QWORD     ibOffset,
+                                        _In_ const DWORD     cbData,
+                                        _In_ const OSFILEQOS grbitQOS,
+                                        _In_ const BOOL      fRead,
+                                        _In_ const BOOL      fCacheIfPossible )
 {
+    if ( grbitQOS == ICache::qosPrefetch )
+    {
+        return;
+    }
+
     const ICacheTelemetry::FileNumber filenumber = pcfte->Filenumber();
     const ICacheTelemetry::BlockNumber blocknumberMax = pcfte->Blocknumber( ibOffset + cbData + pcfte->CbBlockSize() - 1 );
     for (   ICacheTelemetry::BlockNumber blocknumber = pcfte->Blocknumber( ibOffset );
@@ -6,6 +6,12 @@
 #include "_bfconst.hxx"
 
 
+//  Process wide block cache prefetch counts.  PrefetchHit / Prefetch is the prefetch hit rate.
+
+extern LONG g_cBlockCachePrefetch;
+extern LONG g_cBlockCachePrefetchHit;
+
+
 template< class I >
 class TCacheTelemetry
     :   public I
@@ -33,6 +39,12 @@ class TCacheTelemetry
                     _In_ const ICacheTelemetry::BlockNumber blocknumber,
                     _In_ const BOOL                         fReplacementPolicy ) override;
 
+        void Prefetch(  _In_ const ICacheTelemetry::FileNumber  filenumber,
+                        _In_ const ICacheTelemetry::BlockNumber blocknumber ) override;
+
+        void PrefetchHit(   _In_ const ICacheTelemetry::FileNumber  filenumber,
+                            _In_ const ICacheTelemetry::BlockNumber blocknumber ) override;
+
     private:
 
         BFRequestTraceFlags BfrtfReference( _In_ const BOOL fRead, _In_ const BOOL fCacheIfPossible );
@@ -171,6 +183,61 @@ void TCacheTelemetry<I>::Evict( _In_ const ICacheTelemetry::FileNumber  filenumb
                         100 );
 }
 
+template< class I >
+void TCacheTelemetry<I>::Prefetch(  _In_ const ICacheTelemetry::FileNumber  filenumber,
+                                    _In_ const ICacheTelemetry::BlockNumber blocknumber )
+{
+    AtomicIncrement( &g_cBlockCachePrefetch );
+
+    if ( filenumber == filenumberInvalid )
+    {
+        return;
+    }
+
+    GetCurrUserTraceContext getutc;
+    const TraceContext* petc = PetcTLSGetEngineContext();
+
+    ETCachePrereadPage( (DWORD)filenumber,
+                        (DWORD)blocknumber + 1,
+                        getutc->context.dwUserID,
+                        getutc->context.nOperationID,
+                        getutc->context.nOperationType,
+                        getutc->context.nClientType,
+                        getutc->context.fFlags,
+                        getutc->dwCorrelationID,
+                        petc->iorReason.Iorp(),
+                        petc->iorReason.Iors(),
+                        petc->iorReason.Iort(),
+                        petc->iorReason.Ioru(),
+                        petc->iorReason.Iorf(),
+                        petc->nParentObjectClass );
+}
+
+template< class I >
+void TCacheTelemetry<I>::PrefetchHit(   _In_ const ICacheTelemetry::FileNumber  filenumber,
+                                        _In_ const ICacheTelemetry::BlockNumber blocknumber )
+{
+    AtomicIncrement( &g_cBlockCachePrefetchHit );
+
+    if ( filenumber == filenumberInvalid )
+    {
+        return;
+    }
+
+    GetCurrUserTraceContext getutc;
+
+    ETCacheRequestPage( TickOSTimeCurrent(),
+                        (DWORD)filenumber,
+                        (DWORD)blocknumber + 1,
+                        0,
+                        0,
+                        0,
+                        0,
+                        100,
+                        (BFRequestTraceFlags)( BfrtfReference( fTrue, fTrue ) | bfrtfPrefetchHit ),
+                        getutc->context.nClientType );
+}
+
 template< class I >
 BFRequestTraceFlags TCacheTelemetry<I>::BfrtfReference( _In_ const BOOL fRead, _In_ const BOOL fCacheIfPossible )
 {
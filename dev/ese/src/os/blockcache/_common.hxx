@@ -10,6 +10,9 @@ const INT rankFileIdentification = 0;
 const INT rankFileWrapperIOComplete = 0;
 const INT rankJournalSegment = 0;
 const INT rankJournalAppend = 1;
+const INT rankHashedLRUKCacheSet = 2;
+const INT rankHashedLRUKCacheUpdate = 3;
+const INT rankHashedLRUKCacheCheckpoint = 4;
 
 
 class COffsets
@@ -372,6 +372,47 @@ class TFileFilter
 
         BOOL FAttached() const { return m_pc && m_pcfh; }
 
+        class CStream
+        {
+            public:
+
+                CStream()
+                    :   m_tickLast( 0 ),
+                        m_idStream( 0 ),
+                        m_cRead( 0 ),
+                        m_ibNext( qwMax ),
+                        m_ibPrefetched( 0 ),
+                        m_ibPrefetchTarget( 0 )
+                {
+                }
+
+            public:
+
+                TICK    m_tickLast;
+                DWORD   m_idStream;
+                ULONG   m_cRead;
+                QWORD   m_ibNext;
+                QWORD   m_ibPrefetched;
+                QWORD   m_ibPrefetchTarget;
+        };
+
+        enum { cStreamMax = 4 };
+        enum { cReadSequentialMin = 2 };
+        enum { cbPrefetchIOMax = 256 * 1024 };
+
+        ULONG CBlockPrefetchMax();
+        void DetectStream( _In_ const QWORD ibOffset, _In_ const DWORD cbData );
+        void RequestPrefetch();
+        static void Prefetch_( _In_ VOID* const pvGroupContext, _In_ VOID* const pvRuntimeContext )
+        {
+            ( (TFileFilter<I>*)pvGroupContext )->Prefetch();
+        }
+        void Prefetch();
+        ERR ErrPrefetch(    _In_                    const TraceContext& tc,
+                            _In_                    const QWORD         ibOffset,
+                            _In_                    const DWORD         cbData,
+                            _Out_writes_( cbData )  BYTE* const         pbData );
+
         ICache::CachingPolicy CpGetCachingPolicy( _In_ const TraceContext& tc, _In_ const BOOL fWrite );
 
         ERR ErrCacheRead(   _In_                    const TraceContext&             tc,
@@ -488,6 +529,13 @@ class TFileFilter
         LONG                                                        m_cCacheWriteBackForIssue;
         CInitOnceAttach                                             m_initOnceAttach;
         CSemaphore                                                  m_semCachedFileHeader;
+        CCriticalSection                                            m_critStreams;
+        CStream                                                     m_rgstream[ cStreamMax ];
+        QWORD                                                       m_rgibNextHint[ cStreamMax ];
+        LONG                                                        m_iibNextHint;
+        DWORD                                                       m_idStreamLast;
+        POSTIMERTASK                                                m_posttPrefetch;
+        LONG                                                        m_fPrefetchRequested;
 
     protected:
 
@@ -640,9 +688,18 @@ TFileFilter<I>::TFileFilter(    _Inout_     IFileAPI** const
         m_cCacheMissForIssue( 0 ),
         m_cCacheWriteThroughForIssue( 0 ),
         m_cCacheWriteBackForIssue( 0 ),
-        m_semCachedFileHeader( CSyncBasicInfo( "TFileFilter<I>::m_semCachedFileHeader" ) )
+        m_semCachedFileHeader( CSyncBasicInfo( "TFileFilter<I>::m_semCachedFileHeader" ) ),
+        m_critStreams( CLockBasicInfo( CSyncBasicInfo( "TFileFilter<I>::m_critStreams" ), rankFileFilter, 0 ) ),
+        m_iibNextHint( 0 ),
+        m_idStreamLast( 0 ),
+        m_posttPrefetch( NULL ),
+        m_fPrefetchRequested( fFalse )
 {
     SetCacheParameters();
+    for ( ULONG istream = 0; istream < cStreamMax; istream++ )
+    {
+        m_rgibNextHint[ istream ] = qwMax;
+    }
     m_rgparrayPendingWriteBacks[ 0 ] = &m_rgarrayOffsets[ 0 ];
     m_rgparrayPendingWriteBacks[ 1 ] = &m_rgarrayOffsets[ 1 ];
     m_rgparrayUnused[ 0 ] = &m_rgarrayOffsets[ 2 ];
@@ -669,6 +726,12 @@ TFileFilter<I>::~TFileFilter()
 {
     OSTrace( JET_tracetagBlockCache, OSFormat( "%s dtor", OSFormat( this ) ) );
 
+    if ( m_posttPrefetch )
+    {
+        OSTimerTaskCancelTask( m_posttPrefetch );
+        OSTimerTaskDelete( m_posttPrefetch );
+    }
+
     m_semCachedFileHeader.Acquire();
     m_semRequestWriteBacks.Acquire();
     delete m_pcfh;
@@ -852,6 +915,10 @@ ERR TFileFilter<I>::ErrRead(    _In_                    const TraceContext&
     if ( iom == IOMode::iomEngine )
     {
         Call( ErrBeginAccess( offsets, fFalse, &group, &psem ) );
+        if ( FAttached() )
+        {
+            DetectStream( ibOffset, cbData );
+        }
         fIOREQUsed = fTrue;
         Call( ErrCacheRead( tc, ibOffset, cbData, pbData, grbitQOS, pfnIOComplete, keyIOComplete, pfnIOHandoff, pioreq, &group, &psem ) );
     }
@@ -1345,6 +1412,224 @@ HandleError:
     return err;
 }
 
+template< class I >
+ULONG TFileFilter<I>::CBlockPrefetchMax()
+{
+    return m_pcfconfig ? m_pcfconfig->CBlockPrefetchMax() : 0;
+}
+
+template< class I >
+void TFileFilter<I>::DetectStream( _In_ const QWORD ibOffset, _In_ const DWORD cbData )
+{
+    const ULONG                         cBlockPrefetchMax   = CBlockPrefetchMax();
+    const QWORD                         ibEnd               = ibOffset + cbData;
+    CStream*                            pstream             = NULL;
+    CStream*                            pstreamOldest       = NULL;
+    QWORD                               ibHitEnd            = ibOffset;
+    BOOL                                fSequential         = fFalse;
+    BOOL                                fRequestPrefetch    = fFalse;
+
+    if ( cBlockPrefetchMax == 0 )
+    {
+        return;
+    }
+
+    //  only reads that continue a stream or the end of a recent read take m_critStreams.  any
+    //  other read just leaves its end as a hint.  these unlocked checks can race but the stream
+    //  match is repeated under the lock and a stale hint only delays detection by one read
+
+    for ( ULONG istream = 0; istream < cStreamMax && !fSequential; istream++ )
+    {
+        fSequential = m_rgstream[ istream ].m_ibNext == ibOffset || m_rgibNextHint[ istream ] == ibOffset;
+    }
+
+    if ( !fSequential )
+    {
+        m_rgibNextHint[ (ULONG)AtomicIncrement( &m_iibNextHint ) % cStreamMax ] = ibEnd;
+        return;
+    }
+
+    m_critStreams.Enter();
+
+    for ( ULONG istream = 0; istream < cStreamMax && !pstream; istream++ )
+    {
+        CStream* const pstreamT = &m_rgstream[ istream ];
+
+        if ( pstreamT->m_ibNext == ibOffset )
+        {
+            pstream = pstreamT;
+        }
+        else if ( !pstreamOldest || TickCmp( pstreamT->m_tickLast, pstreamOldest->m_tickLast ) < 0 )
+        {
+            pstreamOldest = pstreamT;
+        }
+    }
+
+    if ( !pstream )
+    {
+        //  the hinted read was the first read of this stream
+
+        pstream = pstreamOldest;
+        *pstream = CStream();
+        pstream->m_idStream = ++m_idStreamLast;
+        pstream->m_cRead = 1;
+        pstream->m_ibPrefetched = ibOffset;
+        pstream->m_ibPrefetchTarget = ibOffset;
+    }
+
+
+    ibHitEnd = max( ibOffset, min( ibEnd, pstream->m_ibPrefetched ) );
+
+    pstream->m_tickLast = TickOSTimeCurrent();
+    pstream->m_cRead++;
+    pstream->m_ibNext = ibEnd;
+    pstream->m_ibPrefetched = max( pstream->m_ibPrefetched, ibEnd );
+
+    if ( pstream->m_cRead >= cReadSequentialMin )
+    {
+        pstream->m_ibPrefetchTarget = max( pstream->m_ibPrefetchTarget, ibEnd + (QWORD)cBlockPrefetchMax * CbBlockSize() );
+        fRequestPrefetch = pstream->m_ibPrefetchTarget > pstream->m_ibPrefetched;
+    }
+
+    m_critStreams.Leave();
+
+
+    for (   ICacheTelemetry::BlockNumber blocknumber = Blocknumber( ibOffset );
+            ibHitEnd > ibOffset && blocknumber < Blocknumber( ibHitEnd + CbBlockSize() - 1 );
+            blocknumber = (ICacheTelemetry::BlockNumber)( (QWORD)blocknumber + 1 ) )
+    {
+        m_pctm->PrefetchHit( Filenumber(), blocknumber );
+    }
+
+    if ( fRequestPrefetch )
+    {
+        RequestPrefetch();
+    }
+}
+
+template< class I >
+void TFileFilter<I>::RequestPrefetch()
+{
+    POSTIMERTASK postt = NULL;
+
+    if ( !m_posttPrefetch && ErrOSTimerTaskCreate( Prefetch_, this, &postt ) >= JET_errSuccess )
+    {
+        if ( AtomicCompareExchangePointer( (void**)&m_posttPrefetch, NULL, postt ) != NULL )
+        {
+            OSTimerTaskDelete( postt );
+        }
+    }
+
+    if ( m_posttPrefetch && AtomicCompareExchange( &m_fPrefetchRequested, fFalse, fTrue ) == fFalse )
+    {
+        OSTimerTaskScheduleTask( m_posttPrefetch, this, 0, 0 );
+    }
+}
+
+template< class I >
+void TFileFilter<I>::Prefetch()
+{
+    ERR                 err             = JET_errSuccess;
+    BYTE*               pbPrefetch      = NULL;
+    QWORD               cbSize          = 0;
+    TraceContextScope   tcScope( iorpBlockCache );
+
+    AtomicExchange( &m_fPrefetchRequested, fFalse );
+
+    if ( !FAttached() )
+    {
+        goto HandleError;
+    }
+
+    Alloc( pbPrefetch = (BYTE*)PvOSMemoryPageAlloc( cbPrefetchIOMax, NULL ) );
+    Call( TFileWrapper<I>::ErrSize( &cbSize, IFileAPI::filesizeLogical ) );
+
+
+    for ( BOOL fMore = fTrue; fMore; )
+    {
+        fMore = fFalse;
+
+        for ( ULONG istream = 0; istream < cStreamMax; istream++ )
+        {
+            CStream* const  pstream     = &m_rgstream[ istream ];
+            DWORD           idStream    = 0;
+            QWORD           ibStart     = 0;
+            QWORD           ibEnd       = 0;
+            ERR             errPrefetch = JET_errSuccess;
+
+            m_critStreams.Enter();
+            idStream = pstream->m_idStream;
+            ibStart = rounddn( pstream->m_ibPrefetched, CbBlockSize() );
+            ibEnd = min( min( pstream->m_ibPrefetchTarget, cbSize ), ibStart + cbPrefetchIOMax );
+            ibEnd = ibEnd > ibStart ? rounddn( ibEnd - ibStart, CbBlockSize() ) + ibStart : ibStart;
+            if ( ibEnd <= pstream->m_ibPrefetched )
+            {
+                ibEnd = ibStart;
+            }
+            m_critStreams.Leave();
+
+            if ( ibEnd == ibStart )
+            {
+                continue;
+            }
+
+
+            errPrefetch = ErrPrefetch( *tcScope, ibStart, (DWORD)( ibEnd - ibStart ), pbPrefetch );
+
+
+            m_critStreams.Enter();
+            if ( pstream->m_idStream == idStream )
+            {
+                if ( errPrefetch >= JET_errSuccess )
+                {
+                    pstream->m_ibPrefetched = max( pstream->m_ibPrefetched, ibEnd );
+                }
+                else
+                {
+                    pstream->m_ibPrefetchTarget = pstream->m_ibPrefetched;
+                }
+            }
+            m_critStreams.Leave();
+
+            if ( errPrefetch >= JET_errSuccess )
+            {
+                for (   ICacheTelemetry::BlockNumber blocknumber = Blocknumber( ibStart );
+                        blocknumber < Blocknumber( ibEnd );
+                        blocknumber = (ICacheTelemetry::BlockNumber)( (QWORD)blocknumber + 1 ) )
+                {
+                    m_pctm->Prefetch( Filenumber(), blocknumber );
+                }
+
+                fMore = fTrue;
+            }
+        }
+    }
+
+HandleError:
+    OSMemoryPageFree( pbPrefetch );
+}
+
+template< class I >
+ERR TFileFilter<I>::ErrPrefetch(    _In_                    const TraceContext& tc,
+                                    _In_                    const QWORD         ibOffset,
+                                    _In_                    const DWORD         cbData,
+                                    _Out_writes_( cbData )  BYTE* const         pbData )
+{
+    ERR                     err     = JET_errSuccess;
+    CMeteredSection::Group  group   = CMeteredSection::groupInvalidNil;
+    CSemaphore*             psem    = NULL;
+
+    Call( ErrBeginAccess( COffsets( ibOffset, ibOffset + cbData - 1 ), fFalse, &group, &psem ) );
+    Call( ErrCacheRead( tc, ibOffset, cbData, pbData, ICache::qosPrefetch, NULL, NULL, NULL, NULL, &group, &psem ) );
+
+HandleError:
+    if ( group >= 0 )
+    {
+        EndAccess( group, psem );
+    }
+    return err;
+}
+
 template<class I>
 size_t TFileFilter<I>::CPendingWriteBacks()
 {
@@ -1652,7 +1937,7 @@ ERR TFileFilter<I>::ErrCacheRead(   _In_                    const TraceContext&
         const BOOL fCacheIfPossible = cp != cpDontCache;
         const ICacheTelemetry::BlockNumber blocknumberMax = Blocknumber( ibOffset + cbData + CbBlockSize() - 1 );
         for (   ICacheTelemetry::BlockNumber blocknumber = Blocknumber( ibOffset );
-                blocknumber < blocknumberMax;
+                grbitQOS != ICache::qosPrefetch && blocknumber < blocknumberMax;
                 blocknumber = (ICacheTelemetry::BlockNumber)( (QWORD)blocknumber + 1 ) )
         {
             m_pctm->Miss( filenumber, blocknumber, fTrue, fCacheIfPossible );
@@ -11,9 +11,7 @@ class THashedLRUKCache
 {
     public:
 
-        ~THashedLRUKCache()
-        {
-        }
+        ~THashedLRUKCache();
 
     public:
 
@@ -58,40 +56,355 @@ class THashedLRUKCache
                         _In_                    const DWORD_PTR             keyComplete ) override;
 
     protected:
-        
+
         THashedLRUKCache(   _In_    IFileSystemFilter* const            pfsf,
                             _In_    IFileIdentification* const          pfident,
-                            _In_    IFileSystemConfiguration* const     pfsconfig, 
+                            _In_    IFileSystemConfiguration* const     pfsconfig,
                             _Inout_ IBlockCacheConfiguration** const    ppbcconfig,
                             _Inout_ ICacheConfiguration** const         ppcconfig,
                             _In_    ICacheTelemetry* const              pctm,
                             _Inout_ IFileFilter** const                 ppffCaching,
                             _Inout_ CCacheHeader** const                ppch )
             : TCacheBase<I, CHashedLRUKCachedFileTableEntry>(   pfsf,
-                                                                pfident, 
-                                                                pfsconfig, 
-                                                                ppbcconfig, 
-                                                                ppcconfig, 
-                                                                pctm, 
-                                                                ppffCaching, 
-                                                                ppch )
+                                                                pfident,
+                                                                pfsconfig,
+                                                                ppbcconfig,
+                                                                ppcconfig,
+                                                                pctm,
+                                                                ppffCaching,
+                                                                ppch ),
+                m_pch( NULL ),
+                m_pj( NULL ),
+                m_cbCluster( 0 ),
+                m_cClusterPerSet( 0 ),
+                m_cCluster( 0 ),
+                m_cSet( 0 ),
+                m_rgclent( NULL ),
+                m_ccritSet( 0 ),
+                m_rgcritSet( NULL ),
+                m_critCheckpoint( CLockBasicInfo( CSyncBasicInfo( "THashedLRUKCache<I>::m_critCheckpoint" ), rankHashedLRUKCacheCheckpoint, 0 ) ),
+                m_rwlUpdate( CLockBasicInfo( CSyncBasicInfo( "THashedLRUKCache<I>::m_rwlUpdate" ), rankHashedLRUKCacheUpdate, 0 ) ),
+                m_semClusterRelease( CSyncBasicInfo( "THashedLRUKCache<I>::m_semClusterRelease" ) ),
+                m_cWaitClusterRelease( 0 ),
+                m_pbClusterStateTable( NULL ),
+                m_ulCheckpoint( 0 ),
+                m_jposReplay( jposInvalid ),
+                m_jposAppend( jposInvalid ),
+                m_tonoLast( 0 ),
+                m_cClusterDirty( 0 ),
+                m_cClusterDirtyMax( 0 ),
+                m_epochCurrent( 1 ),
+                m_epochDurable( 1 ),
+                m_posttWriteBack( NULL ),
+                m_fWriteBackRequested( fFalse ),
+                m_iSetWriteBack( 0 ),
+                m_rgjposReplayed( NULL ),
+                m_rgclnoUndo( NULL )
+        {
+        }
+
+    private:
+
+        enum { ccritSetMax = 128 };
+        enum { cbClusterStateTableIOMax = 1024 * 1024 };
+        enum { cSetWriteBackPerTask = 1024 };
+        enum { cmsecReserveBlockZeroMax = 1000 };
+        enum { dtonoUnreferenced = lMax / 2 };
+        enum { cjentcuMax = 2 };
+        enum { cbClusterUpdatesMax = sizeof( CJournalEntryHeader ) + cjentcuMax * sizeof( CJournalEntryClusterUpdate ) };
+
+        class CClusterEntry
+        {
+            public:
+
+                CClusterEntry()
+                    :   m_volumeid( volumeidInvalid ),
+                        m_fileid( fileidInvalid ),
+                        m_fileserial( fileserialInvalid ),
+                        m_blno( blnoInvalid ),
+                        m_ecc( 0 ),
+                        m_tono0( (TouchNumber)0 ),
+                        m_tono1( (TouchNumber)0 ),
+                        m_fValid( fFalse ),
+                        m_fDirty( fFalse ),
+                        m_fBusy( fFalse ),
+                        m_fWriteBack( fFalse ),
+                        m_fQuarantined( fFalse ),
+                        m_epochQuarantine( 0 ),
+                        m_cref( 0 )
+                {
+                }
+
+                BOOL FMatches(  _In_ const VolumeId     volumeid,
+                                _In_ const FileId       fileid,
+                                _In_ const FileSerial   fileserial,
+                                _In_ const BlockNumber  blno ) const
+                {
+                    return  m_volumeid == volumeid &&
+                            m_fileid == fileid &&
+                            m_fileserial == fileserial &&
+                            m_blno == blno;
+                }
+
+                BOOL FOlder( _In_ const CClusterEntry& other ) const
+                {
+                    const LONG dtono1 = LONG( (DWORD)m_tono1 - (DWORD)other.m_tono1 );
+                    const LONG dtono0 = LONG( (DWORD)m_tono0 - (DWORD)other.m_tono0 );
+                    return dtono1 < 0 || ( dtono1 == 0 && dtono0 < 0 );
+                }
+
+                ClusterOperation ClopCurrent() const
+                {
+                    return m_fValid ? ( m_fDirty ? clopUpdate : clopWriteBack ) : clopInvalidate;
+                }
+
+                CClusterState Clst( _In_ const ClusterNumber clno, _In_ const ClusterOperation clop ) const
+                {
+                    return CClusterState( CCachedBlock( m_volumeid, m_fileid, m_fileserial, m_blno ), clno, m_ecc, m_tono0, m_tono1, clop );
+                }
+
+                void SetClst( _In_ const CClusterState& clst )
+                {
+                    const ClusterOperation clop = clst.ClopLast();
+
+                    m_volumeid = clst.Cbl().Volumeid();
+                    m_fileid = clst.Cbl().Fileid();
+                    m_fileserial = clst.Cbl().Fileserial();
+                    m_blno = clst.Cbl().Blno();
+                    m_ecc = clst.Ecc();
+                    m_tono0 = clst.Tono0();
+                    m_tono1 = clst.Tono1();
+                    m_fValid = clop == clopUpdate || clop == clopWriteBack || clop == clopAccess;
+                    m_fDirty = clop == clopUpdate;
+                }
+
+            public:
+
+                VolumeId        m_volumeid;
+                FileId          m_fileid;
+                FileSerial      m_fileserial;
+                BlockNumber     m_blno;
+                DWORD           m_ecc;
+                TouchNumber     m_tono0;
+                TouchNumber     m_tono1;
+                BOOL            m_fValid;
+                BOOL            m_fDirty;
+                BOOL            m_fBusy;
+                BOOL            m_fWriteBack;
+                BOOL            m_fQuarantined;
+                LONG            m_epochQuarantine;
+                LONG            m_cref;
+        };
+
+    private:
+
+        ULONG ISet( _In_ const VolumeId     volumeid,
+                    _In_ const FileId       fileid,
+                    _In_ const FileSerial   fileserial,
+                    _In_ const BlockNumber  blno ) const
+        {
+            return ( CCachedFileTableEntryBase::UiHash( volumeid, fileid, fileserial ) + (ULONG)blno * 2654435761 ) % m_cSet;
+        }
+
+        CCriticalSection* PcritSet( _In_ const ULONG iSet ) const { return &m_rgcritSet[ iSet % m_ccritSet ]; }
+        CClusterEntry* Pclent( _In_ const ClusterNumber clno ) const { return &m_rgclent[ (ULONG)clno ]; }
+        CClusterState* RgclstClusterStateTable() const { return (CClusterState*)( m_pbClusterStateTable + sizeof( CClusterStateTableHeader ) ); }
+        BOOL FReleased( _In_ const CClusterEntry* const pclent ) const
+        {
+            return !pclent->m_fQuarantined || LONG( pclent->m_epochQuarantine - m_epochDurable ) < 0;
+        }
+
+        ClusterNumber ClnoFind( _In_ const ULONG        iSet,
+                                _In_ const VolumeId     volumeid,
+                                _In_ const FileId       fileid,
+                                _In_ const FileSerial   fileserial,
+                                _In_ const BlockNumber  blno ) const;
+        ClusterNumber ClnoVictim(   _In_    const ULONG         iSet,
+                                    _In_    const VolumeId      volumeid,
+                                    _In_    const FileId        fileid,
+                                    _In_    const FileSerial    fileserial,
+                                    _In_    const BlockNumber   blno,
+                                    _Out_   BOOL* const         pfQuarantined ) const;
+        ClusterNumber ClnoWriteBack( _In_ const ULONG iSet ) const;
+        ULONG CClusterUnavailable( _In_ const ULONG iSet ) const;
+
+        void Touch( _Inout_ CClusterEntry* const pclent );
+        void SetDirty( _Inout_ CClusterEntry* const pclent, _In_ const BOOL fDirty );
+        void Quarantine( _Inout_ CClusterEntry* const pclent );
+        void ReleaseQuarantine( _In_ const LONG epoch );
+        void Unpin( _In_ const ULONG iSet, _In_ const ClusterNumber clno );
+        void WaitForClusterRelease( _In_ CCriticalSection* const pcrit, _In_ const INT cmsecTimeout );
+        void ReleaseClusterWaiters();
+
+        void BuildClusterUpdates(   _In_                                const ULONG                     cjentcu,
+                                    _In_reads_( cjentcu )               const ClusterNumber* const      rgclno,
+                                    _In_reads_( cjentcu )               const ClusterOperation* const   rgclop,
+                                    _Out_writes_( cbClusterUpdatesMax ) BYTE* const                     pbEntry ) const;
+        ERR ErrAppendClusterUpdates(    _In_                    const ULONG             cjentcu,
+                                        _In_                    const BYTE* const       pbEntry,
+                                        _Out_opt_               JournalPosition* const  pjpos );
+
+        ERR ErrReadCluster( _In_                        const TraceContext&     tc,
+                            _In_                        const ClusterNumber     clno,
+                            _In_                        const DWORD             ecc,
+                            _In_                        const OSFILEQOS         grbitQOS,
+                            _Out_writes_( m_cbCluster ) BYTE* const             pbCluster );
+        ERR ErrWriteCluster(    _In_                        const TraceContext&     tc,
+                                _In_                        const ClusterNumber     clno,
+                                _In_reads_( m_cbCluster )   const BYTE* const       pbCluster );
+
+        ERR ErrReserveCluster(  _In_    CHashedLRUKCachedFileTableEntry* const  pcfte,
+                                _In_    const ULONG                             iSet,
+                                _In_    const BlockNumber                       blno,
+                                _In_    const BOOL                              fDirty,
+                                _In_    const BOOL                              fWait,
+                                _Out_   ClusterNumber* const                    pclno );
+        ERR ErrPublishCluster(  _In_    CHashedLRUKCachedFileTableEntry* const  pcfte,
+                                _In_    const ULONG                             iSet,
+                                _In_    const ClusterNumber                     clno,
+                                _In_    const BlockNumber                       blno,
+                                _In_    const DWORD                             ecc,
+                                _In_    const BOOL                              fDirty,
+                                _Out_   BOOL* const                             pfInserted );
+        ERR ErrInsertCluster(   _In_                        const TraceContext&                     tc,
+                                _In_                        CHashedLRUKCachedFileTableEntry* const  pcfte,
+                                _In_                        const BlockNumber                       blno,
+                                _In_reads_( m_cbCluster )   const BYTE* const                       pbCluster,
+                                _In_                        const BOOL                              fDirty,
+                                _In_                        const BOOL                              fWait,
+                                _Out_                       BOOL* const                             pfInserted );
+        ERR ErrDropCluster( _In_ CHashedLRUKCachedFileTableEntry* const pcfte,
+                            _In_ const BlockNumber                      blno );
+        ERR ErrWriteBackCluster( _In_ const ULONG iSet, _In_ const ClusterNumber clno );
+
+        ERR ErrReadBlock(   _In_                        const TraceContext&                     tc,
+                            _In_                        CHashedLRUKCachedFileTableEntry* const  pcfte,
+                            _In_                        const QWORD                             ibOffset,
+                            _In_                        const DWORD                             cbData,
+                            _Out_writes_( cbData )      BYTE* const                             pbData,
+                            _In_                        const OSFILEQOS                         grbitQOS,
+                            _In_                        const ICache::CachingPolicy             cp,
+                            _In_opt_                    CComplete* const                        pcomplete,
+                            _Inout_                     BYTE** const                            ppbCluster );
+        ERR ErrWriteBlock(  _In_                        const TraceContext&                     tc,
+                            _In_                        CHashedLRUKCachedFileTableEntry* const  pcfte,
+                            _In_                        const QWORD                             ibOffset,
+                            _In_                        const DWORD                             cbData,
+                            _In_reads_( cbData )        const BYTE* const                       pbData,
+                            _In_                        const OSFILEQOS                         grbitQOS,
+                            _In_                        const ICache::CachingPolicy             cp,
+                            _In_opt_                    CComplete* const                        pcomplete,
+                            _Inout_                     BYTE** const                            ppbCluster );
+        ERR ErrInvalidateBlock( _In_                        const TraceContext&                     tc,
+                                _In_                        CHashedLRUKCachedFileTableEntry* const  pcfte,
+                                _In_                        const QWORD                             ibOffset,
+                                _In_                        const DWORD                             cbData,
+                                _Inout_                     BYTE** const                            ppbCluster );
+        ERR ErrAllocCluster( _Inout_ BYTE** const ppbCluster );
+
+        ERR ErrFlushCache();
+        ERR ErrCheckpoint( _In_ const BOOL fWait, _In_ const QWORD cbJournalUsedMin );
+        ERR ErrMaybeCheckpoint();
+
+        void RequestWriteBack();
+        void WriteBack();
+        static void WriteBack_( _In_ VOID* const pvGroupContext, _In_ VOID* const pvRuntimeContext )
+        {
+            ( (THashedLRUKCache<I>*)pvGroupContext )->WriteBack();
+        }
+
+        static ERR ErrReadClusterStateTable(    _In_    IFileFilter* const                  pff,
+                                                _In_    const CHashedLRUKCacheHeader* const pch,
+                                                _In_    const ULONG                         iTable,
+                                                _Out_   BYTE* const                         pbTable );
+        static ERR ErrWriteClusterStateTable(   _In_    IFileFilter* const                  pff,
+                                                _In_    const CHashedLRUKCacheHeader* const pch,
+                                                _In_    const ULONG                         iTable,
+                                                _In_    const BYTE* const                   pbTable );
+        static BOOL FValidClusterStateTable(    _In_ const BYTE* const  pbTable,
+                                                _In_ const ULONG        cCluster );
+
+        ERR ErrLoadClusterStateTable();
+        ERR ErrReplayJournal();
+        BOOL FReplayJournalEntry( _In_ const JournalPosition jpos, _In_ const CJournalBuffer jb );
+        static BOOL FReplayJournalEntry_(   _In_ const JournalPosition  jpos,
+                                            _In_ const CJournalBuffer   jb,
+                                            _In_ const DWORD_PTR        keyVisitEntry )
         {
+            return ( (THashedLRUKCache<I>*)keyVisitEntry )->FReplayJournalEntry( jpos, jb );
         }
+        ERR ErrVerifyReplayedClusters();
+        void RemoveDuplicateClusters();
 
     private:
 
         CHashedLRUKCacheHeader* m_pch;
+        IJournal*               m_pj;
+        ULONG                   m_cbCluster;
+        ULONG                   m_cClusterPerSet;
+        ULONG                   m_cCluster;
+        ULONG                   m_cSet;
+        CClusterEntry*          m_rgclent;
+        ULONG                   m_ccritSet;
+        CCriticalSection*       m_rgcritSet;
+        CCriticalSection        m_critCheckpoint;
+        CReaderWriterLock       m_rwlUpdate;
+        CSemaphore              m_semClusterRelease;
+        LONG                    m_cWaitClusterRelease;
+        BYTE*                   m_pbClusterStateTable;
+        QWORD                   m_ulCheckpoint;
+        JournalPosition         m_jposReplay;
+        JournalPosition         m_jposAppend;
+        LONG                    m_tonoLast;
+        LONG                    m_cClusterDirty;
+        LONG                    m_cClusterDirtyMax;
+        LONG                    m_epochCurrent;
+        LONG                    m_epochDurable;
+        POSTIMERTASK            m_posttWriteBack;
+        LONG                    m_fWriteBackRequested;
+        ULONG                   m_iSetWriteBack;
+        JournalPosition*        m_rgjposReplayed;
+        ClusterNumber*          m_rgclnoUndo;
 };
 
+template< class I >
+THashedLRUKCache<I>::~THashedLRUKCache()
+{
+    if ( m_posttWriteBack )
+    {
+        OSTimerTaskCancelTask( m_posttWriteBack );
+        OSTimerTaskDelete( m_posttWriteBack );
+    }
+
+    delete m_pj;
+    OSMemoryPageFree( m_pbClusterStateTable );
+
+    if ( m_rgcritSet )
+    {
+        for ( ULONG icrit = 0; icrit < m_ccritSet; icrit++ )
+        {
+            m_rgcritSet[ icrit ].~CCriticalSection();
+        }
+        delete[] (BYTE*)m_rgcritSet;
+    }
+
+    delete[] m_rgclent;
+    delete[] m_rgjposReplayed;
+    delete[] m_rgclnoUndo;
+    delete m_pch;
+}
+
 template< class I >
 ERR THashedLRUKCache<I>::ErrCreate()
 {
-    ERR                     err     = JET_errSuccess;
-    CHashedLRUKCacheHeader* pch     = NULL;
+    ERR                     err         = JET_errSuccess;
+    CHashedLRUKCacheHeader* pch         = NULL;
+    BYTE*                   pbTable     = NULL;
+    CClusterState*          rgclst      = NULL;
     TraceContextScope       tcScope( iorpBlockCache );
 
 
-    Call( CHashedLRUKCacheHeader::ErrCreate( &pch ) );
+    Call( CHashedLRUKCacheHeader::ErrCreate( Pcconfig()->CbMaximumSize(), &pch ) );
 
 
     Call( PffCaching()->ErrSetSize( *tcScope, Pcconfig()->CbMaximumSize(), fFalse, qosIONormal ) );
@@ -101,15 +414,34 @@ ERR THashedLRUKCache<I>::ErrCreate()
                                     sizeof( CCacheHeader ),
                                     sizeof( *pch ),
                                     (const BYTE*)pch,
-                                    qosIONormal, 
-                                    NULL, 
+                                    qosIONormal,
+                                    NULL,
                                     NULL,
                                     NULL ) );
 
 
+    Alloc( pbTable = (BYTE*)PvOSMemoryPageAlloc( (size_t)pch->CbClusterStateTable(), NULL ) );
+    rgclst = (CClusterState*)( pbTable + sizeof( CClusterStateTableHeader ) );
+    for ( ULONG iCluster = 0; iCluster < pch->CCluster(); iCluster++ )
+    {
+        new( &rgclst[ iCluster ] ) CClusterState(   CCachedBlock( volumeidInvalid, fileidInvalid, fileserialInvalid, blnoInvalid ),
+                                                    (ClusterNumber)iCluster,
+                                                    0,
+                                                    (TouchNumber)0,
+                                                    (TouchNumber)0,
+                                                    clopInvalidate );
+    }
+    new( pbTable ) CClusterStateTableHeader(    1,
+                                                (JournalPosition)0,
+                                                pch->CCluster(),
+                                                Crc32Checksum( (const BYTE*)rgclst, pch->CCluster() * sizeof( CClusterState ) ) );
+    Call( ErrWriteClusterStateTable( PffCaching(), pch, 0, pbTable ) );
+
+
     Call( PffCaching()->ErrFlushFileBuffers( iofrBlockCache ) );
 
 HandleError:
+    OSMemoryPageFree( pbTable );
     delete pch;
     return err;
 }
@@ -119,6 +451,7 @@ ERR THashedLRUKCache<I>::ErrMount()
 {
     ERR                     err     = JET_errSuccess;
     CHashedLRUKCacheHeader* pch     = NULL;
+    IJournalSegmentManager* pjsm    = NULL;
 
 
     Call( CHashedLRUKCacheHeader::ErrLoad( Pfsconfig(), PffCaching(), &pch ) );
@@ -127,8 +460,62 @@ ERR THashedLRUKCache<I>::ErrMount()
     m_pch = pch;
     pch = NULL;
 
+    m_cbCluster = m_pch->CbCluster();
+    m_cClusterPerSet = m_pch->CClusterPerSet();
+    m_cCluster = m_pch->CCluster();
+    m_cSet = m_cCluster / m_cClusterPerSet;
+    m_cClusterDirtyMax = max( 1, (LONG)( m_cCluster * Pcconfig()->PctWrite() / 100 ) );
+
+
+    Alloc( m_rgclent = new CClusterEntry[ m_cCluster ] );
+
+    m_ccritSet = min( m_cSet, ccritSetMax );
+    Alloc( m_rgcritSet = (CCriticalSection*)( new BYTE[ m_ccritSet * sizeof( CCriticalSection ) ] ) );
+    for ( ULONG icrit = 0; icrit < m_ccritSet; icrit++ )
+    {
+        new( m_rgcritSet + icrit ) CCriticalSection( CLockBasicInfo( CSyncBasicInfo( "THashedLRUKCache<I>::m_rgcritSet" ), rankHashedLRUKCacheSet, icrit ) );
+    }
+
+    Alloc( m_pbClusterStateTable = (BYTE*)PvOSMemoryPageAlloc( (size_t)m_pch->CbClusterStateTable(), NULL ) );
+
+
+    Call( ErrOSBCCreateJournalSegmentManager( PffCaching(), m_pch->IbJournal(), m_pch->CbJournal(), &pjsm ) );
+    Call( ErrOSBCCreateJournal( &pjsm, (size_t)( m_pch->CbJournal() / 4 ), &m_pj ) );
+
+
+    Call( ErrLoadClusterStateTable() );
+    Call( ErrReplayJournal() );
+    Call( ErrVerifyReplayedClusters() );
+    RemoveDuplicateClusters();
+
+
+    for ( ULONG iCluster = 0; iCluster < m_cCluster; iCluster++ )
+    {
+        CClusterEntry* const pclent = &m_rgclent[ iCluster ];
+
+        if ( pclent->m_fValid )
+        {
+            m_tonoLast = max( m_tonoLast, (LONG)pclent->m_tono0 );
+            m_cClusterDirty += pclent->m_fDirty && pclent->m_blno != (BlockNumber)0 ? 1 : 0;
+        }
+    }
+
+
+    Call( ErrCheckpoint( fTrue, 0 ) );
+
+
+    Call( ErrOSTimerTaskCreate( WriteBack_, this, &m_posttWriteBack ) );
+    if ( m_cClusterDirty > m_cClusterDirtyMax )
+    {
+        RequestWriteBack();
+    }
 
 HandleError:
+    delete[] m_rgjposReplayed;
+    m_rgjposReplayed = NULL;
+    delete[] m_rgclnoUndo;
+    m_rgclnoUndo = NULL;
+    delete pjsm;
     delete pch;
     return err;
 }
@@ -152,11 +539,16 @@ ERR THashedLRUKCache<I>::ErrFlush(  _In_ const VolumeId     volumeid,
 {
     ERR                                 err     = JET_errSuccess;
     CHashedLRUKCachedFileTableEntry*    pcfte   = NULL;
-   
+
 
     Call( ErrGetCachedFile( volumeid, fileid, fileserial, fFalse, &pcfte ) );
 
 
+    Call( ErrFlushCache() );
+
+
+    Call( ErrMaybeCheckpoint() );
+
 HandleError:
     return err;
 }
@@ -168,14 +560,69 @@ ERR THashedLRUKCache<I>::ErrInvalidate( _In_ const VolumeId     volumeid,
                                         _In_ const QWORD        ibOffset,
                                         _In_ const QWORD        cbData )
 {
-    ERR                                 err     = JET_errSuccess;
-    CHashedLRUKCachedFileTableEntry*    pcfte   = NULL;
-   
+    ERR                                 err         = JET_errSuccess;
+    CHashedLRUKCachedFileTableEntry*    pcfte       = NULL;
+    const QWORD                         ibEnd       = ibOffset + min( cbData, qwMax - ibOffset );
+    const QWORD                         blnoFirst   = ibOffset / m_cbCluster;
+    const QWORD                         blnoLast    = ( ibEnd - 1 ) / m_cbCluster;
+    BYTE*                               pbCluster   = NULL;
+    TraceContextScope                   tcScope( iorpBlockCache );
+
 
     Call( ErrGetCachedFile( volumeid, fileid, fileserial, fFalse, &pcfte ) );
 
+    if ( cbData == 0 )
+    {
+        goto HandleError;
+    }
+
+
+    if ( blnoLast - blnoFirst < m_cCluster )
+    {
+        for ( QWORD blno = blnoFirst; blno <= blnoLast; blno++ )
+        {
+            const QWORD ibStart = max( ibOffset, blno * m_cbCluster );
+            const QWORD ibStop = min( ibEnd, ( blno + 1 ) * m_cbCluster );
+
+            Call( ErrInvalidateBlock( *tcScope, pcfte, ibStart, (DWORD)( ibStop - ibStart ), &pbCluster ) );
+        }
+    }
+    else
+    {
+
+        for ( ULONG iCluster = 0; iCluster < m_cCluster; iCluster++ )
+        {
+            const ULONG         iSet        = iCluster / m_cClusterPerSet;
+            CClusterEntry* const pclent     = &m_rgclent[ iCluster ];
+            BlockNumber         blno        = blnoInvalid;
+
+            PcritSet( iSet )->Enter();
+            if (    pclent->m_fValid &&
+                    pclent->m_volumeid == volumeid &&
+                    pclent->m_fileid == fileid &&
+                    pclent->m_fileserial == fileserial &&
+                    (QWORD)pclent->m_blno >= blnoFirst &&
+                    (QWORD)pclent->m_blno <= blnoLast )
+            {
+                blno = pclent->m_blno;
+            }
+            PcritSet( iSet )->Leave();
+
+            if ( blno != blnoInvalid )
+            {
+                const QWORD ibStart = max( ibOffset, (QWORD)blno * m_cbCluster );
+                const QWORD ibStop = min( ibEnd, ( (QWORD)blno + 1 ) * m_cbCluster );
+
+                Call( ErrInvalidateBlock( *tcScope, pcfte, ibStart, (DWORD)( ibStop - ibStart ), &pbCluster ) );
+            }
+        }
+    }
+
+
+    Call( ErrFlushCache() );
 
 HandleError:
+    OSMemoryPageFree( pbCluster );
     return err;
 }
 
@@ -195,16 +642,18 @@ ERR THashedLRUKCache<I>::ErrRead(   _In_                    const TraceContext&
     ERR                                 err             = JET_errSuccess;
     CHashedLRUKCachedFileTableEntry*    pcfte           = NULL;
     CComplete*                          pcomplete       = NULL;
+    BYTE*                               pbCluster       = NULL;
+    QWORD                               ibStop          = 0;
 
     if ( pfnComplete )
     {
         Alloc( pcomplete = new CComplete(   volumeid,
                                             fileid,
                                             fileserial,
-                                            ibOffset, 
+                                            ibOffset,
                                             cbData,
                                             pbData,
-                                            pfnComplete, 
+                                            pfnComplete,
                                             keyComplete ) );
     }
 
@@ -212,7 +661,15 @@ ERR THashedLRUKCache<I>::ErrRead(   _In_                    const TraceContext&
     Call( ErrGetCachedFile( volumeid, fileid, fileserial, fFalse, &pcfte ) );
 
 
+    for ( QWORD ib = ibOffset; ib < ibOffset + cbData; ib = ibStop )
+    {
+        ibStop = min( ibOffset + cbData, ( ib / m_cbCluster + 1 ) * m_cbCluster );
+
+        Call( ErrReadBlock( tc, pcfte, ib, (DWORD)( ibStop - ib ), pbData + ( ib - ibOffset ), grbitQOS, cp, pcomplete, &pbCluster ) );
+    }
+
 HandleError:
+    OSMemoryPageFree( pbCluster );
     if ( pcomplete )
     {
         pcomplete->Release( err, tc, grbitQOS );
@@ -236,16 +693,18 @@ ERR THashedLRUKCache<I>::ErrWrite(  _In_                    const TraceContext&
     ERR                                 err             = JET_errSuccess;
     CHashedLRUKCachedFileTableEntry*    pcfte           = NULL;
     CComplete*                          pcomplete       = NULL;
-    
+    BYTE*                               pbCluster       = NULL;
+    QWORD                               ibStop          = 0;
+
     if ( pfnComplete )
     {
         Alloc( pcomplete = new CComplete(   volumeid,
                                             fileid,
                                             fileserial,
-                                            ibOffset, 
+                                            ibOffset,
                                             cbData,
                                             pbData,
-                                            pfnComplete, 
+                                            pfnComplete,
                                             keyComplete ) );
     }
 
@@ -253,7 +712,15 @@ ERR THashedLRUKCache<I>::ErrWrite(  _In_                    const TraceContext&
     Call( ErrGetCachedFile( volumeid, fileid, fileserial, fFalse, &pcfte ) );
 
 
+    for ( QWORD ib = ibOffset; ib < ibOffset + cbData; ib = ibStop )
+    {
+        ibStop = min( ibOffset + cbData, ( ib / m_cbCluster + 1 ) * m_cbCluster );
+
+        Call( ErrWriteBlock( tc, pcfte, ib, (DWORD)( ibStop - ib ), pbData + ( ib - ibOffset ), grbitQOS, cp, pcomplete, &pbCluster ) );
+    }
+
 HandleError:
+    OSMemoryPageFree( pbCluster );
     if ( pcomplete )
     {
         pcomplete->Release( err, tc, grbitQOS );
@@ -261,6 +728,1449 @@ HandleError:
     return pcomplete ? JET_errSuccess : err;
 }
 
+template< class I >
+ClusterNumber THashedLRUKCache<I>::ClnoFind(    _In_ const ULONG        iSet,
+                                                _In_ const VolumeId     volumeid,
+                                                _In_ const FileId       fileid,
+                                                _In_ const FileSerial   fileserial,
+                                                _In_ const BlockNumber  blno ) const
+{
+    Assert( PcritSet( iSet )->FOwner() );
+
+    for ( ULONG iCluster = iSet * m_cClusterPerSet; iCluster < ( iSet + 1 ) * m_cClusterPerSet; iCluster++ )
+    {
+        const CClusterEntry* const pclent = &m_rgclent[ iCluster ];
+
+        if ( pclent->m_fValid && pclent->FMatches( volumeid, fileid, fileserial, blno ) )
+        {
+            return (ClusterNumber)iCluster;
+        }
+    }
+
+    return clnoInvalid;
+}
+
+template< class I >
+ClusterNumber THashedLRUKCache<I>::ClnoVictim(  _In_    const ULONG         iSet,
+                                                _In_    const VolumeId      volumeid,
+                                                _In_    const FileId        fileid,
+                                                _In_    const FileSerial    fileserial,
+                                                _In_    const BlockNumber   blno,
+                                                _Out_   BOOL* const         pfQuarantined ) const
+{
+    ClusterNumber clnoClean = clnoInvalid;
+
+    Assert( PcritSet( iSet )->FOwner() );
+
+    *pfQuarantined = fFalse;
+
+    for ( ULONG iCluster = iSet * m_cClusterPerSet; iCluster < ( iSet + 1 ) * m_cClusterPerSet; iCluster++ )
+    {
+        const CClusterEntry* const pclent = &m_rgclent[ iCluster ];
+
+        if ( pclent->m_fBusy || pclent->m_cref > 0 )
+        {
+            continue;
+        }
+
+        if ( !pclent->m_fValid )
+        {
+            if ( FReleased( pclent ) )
+            {
+                return (ClusterNumber)iCluster;
+            }
+
+            *pfQuarantined = fTrue;
+            continue;
+        }
+
+        if (    pclent->m_fDirty ||
+                pclent->m_blno == (BlockNumber)0 ||
+                pclent->FMatches( volumeid, fileid, fileserial, blno ) )
+        {
+            continue;
+        }
+
+        if ( clnoClean == clnoInvalid || pclent->FOlder( *Pclent( clnoClean ) ) )
+        {
+            clnoClean = (ClusterNumber)iCluster;
+        }
+    }
+
+    return clnoClean;
+}
+
+template< class I >
+ClusterNumber THashedLRUKCache<I>::ClnoWriteBack( _In_ const ULONG iSet ) const
+{
+    ClusterNumber clnoOldest = clnoInvalid;
+
+    Assert( PcritSet( iSet )->FOwner() );
+
+    if ( m_cClusterDirty <= m_cClusterDirtyMax && 2 * CClusterUnavailable( iSet ) < m_cClusterPerSet )
+    {
+        return clnoInvalid;
+    }
+
+    for ( ULONG iCluster = iSet * m_cClusterPerSet; iCluster < ( iSet + 1 ) * m_cClusterPerSet; iCluster++ )
+    {
+        const CClusterEntry* const pclent = &m_rgclent[ iCluster ];
+
+        if (    pclent->m_fValid &&
+                pclent->m_fDirty &&
+                !pclent->m_fBusy &&
+                !pclent->m_fWriteBack &&
+                pclent->m_blno != (BlockNumber)0 &&
+                ( clnoOldest == clnoInvalid || pclent->FOlder( *Pclent( clnoOldest ) ) ) )
+        {
+            clnoOldest = (ClusterNumber)iCluster;
+        }
+    }
+
+    return clnoOldest;
+}
+
+template< class I >
+ULONG THashedLRUKCache<I>::CClusterUnavailable( _In_ const ULONG iSet ) const
+{
+    ULONG cCluster = 0;
+
+    Assert( PcritSet( iSet )->FOwner() );
+
+    for ( ULONG iCluster = iSet * m_cClusterPerSet; iCluster < ( iSet + 1 ) * m_cClusterPerSet; iCluster++ )
+    {
+        const CClusterEntry* const pclent = &m_rgclent[ iCluster ];
+
+        if ( pclent->m_fBusy || ( pclent->m_fValid && ( pclent->m_fDirty || pclent->m_blno == (BlockNumber)0 ) ) )
+        {
+            cCluster++;
+        }
+    }
+
+    return cCluster;
+}
+
+template< class I >
+void THashedLRUKCache<I>::Touch( _Inout_ CClusterEntry* const pclent )
+{
+    pclent->m_tono1 = pclent->m_tono0;
+    pclent->m_tono0 = (TouchNumber)AtomicIncrement( &m_tonoLast );
+}
+
+template< class I >
+void THashedLRUKCache<I>::SetDirty( _Inout_ CClusterEntry* const pclent, _In_ const BOOL fDirty )
+{
+    if ( !pclent->m_fDirty != !fDirty && pclent->m_blno != (BlockNumber)0 )
+    {
+        AtomicExchangeAdd( &m_cClusterDirty, fDirty ? 1 : -1 );
+    }
+    pclent->m_fDirty = fDirty;
+}
+
+template< class I >
+void THashedLRUKCache<I>::Quarantine( _Inout_ CClusterEntry* const pclent )
+{
+    pclent->m_fQuarantined = fTrue;
+    pclent->m_epochQuarantine = m_epochCurrent;
+}
+
+template< class I >
+void THashedLRUKCache<I>::ReleaseQuarantine( _In_ const LONG epoch )
+{
+    const LONG epochDurable = epoch + 1;
+
+    for ( LONG epochDurableCurrent = m_epochDurable;
+            LONG( epochDurableCurrent - epochDurable ) < 0;
+            epochDurableCurrent = m_epochDurable )
+    {
+        if ( AtomicCompareExchange( &m_epochDurable, epochDurableCurrent, epochDurable ) == epochDurableCurrent )
+        {
+            break;
+        }
+    }
+}
+
+template< class I >
+void THashedLRUKCache<I>::Unpin( _In_ const ULONG iSet, _In_ const ClusterNumber clno )
+{
+    PcritSet( iSet )->Enter();
+    Pclent( clno )->m_cref--;
+    PcritSet( iSet )->Leave();
+
+    ReleaseClusterWaiters();
+}
+
+//  Leaves the set lock and waits until some cluster is unpinned, published, dropped or written
+//  back.  Any such release wakes every waiter so the caller must recheck its condition.
+
+template< class I >
+void THashedLRUKCache<I>::WaitForClusterRelease( _In_ CCriticalSection* const pcrit, _In_ const INT cmsecTimeout )
+{
+    Assert( pcrit->FOwner() );
+
+    AtomicIncrement( &m_cWaitClusterRelease );
+    pcrit->Leave();
+
+    RequestWriteBack();
+
+    (void)m_semClusterRelease.FAcquire( cmsecTimeout );
+}
+
+template< class I >
+void THashedLRUKCache<I>::ReleaseClusterWaiters()
+{
+    if ( m_cWaitClusterRelease > 0 )
+    {
+        const LONG cWait = AtomicExchange( &m_cWaitClusterRelease, 0 );
+        if ( cWait > 0 )
+        {
+            m_semClusterRelease.Release( cWait );
+        }
+    }
+}
+
+template< class I >
+void THashedLRUKCache<I>::BuildClusterUpdates(  _In_                                const ULONG                     cjentcu,
+                                                _In_reads_( cjentcu )               const ClusterNumber* const      rgclno,
+                                                _In_reads_( cjentcu )               const ClusterOperation* const   rgclop,
+                                                _Out_writes_( cbClusterUpdatesMax ) BYTE* const                     pbEntry ) const
+{
+    Assert( cjentcu <= cjentcuMax );
+
+    new( pbEntry ) CJournalEntryHeader( cjentcu );
+    for ( ULONG ijentcu = 0; ijentcu < cjentcu; ijentcu++ )
+    {
+        Assert( PcritSet( (ULONG)rgclno[ ijentcu ] / m_cClusterPerSet )->FOwner() );
+
+        new( pbEntry + sizeof( CJournalEntryHeader ) + ijentcu * sizeof( CJournalEntryClusterUpdate ) )
+            CJournalEntryClusterUpdate( rgclno[ ijentcu ], Pclent( rgclno[ ijentcu ] )->Clst( rgclno[ ijentcu ], rgclop[ ijentcu ] ) );
+    }
+}
+
+//  The entry is built under the set lock and appended without it.  The caller holds m_rwlUpdate
+//  shared until the update is applied in memory so that a checkpoint never truncates an entry
+//  that its cluster state table does not reflect.  The clusters in the entry stay busy meanwhile
+//  so that no other update of them can be journaled out of order.
+
+template< class I >
+ERR THashedLRUKCache<I>::ErrAppendClusterUpdates(   _In_                    const ULONG             cjentcu,
+                                                    _In_                    const BYTE* const       pbEntry,
+                                                    _Out_opt_               JournalPosition* const  pjpos )
+{
+    ERR             err     = JET_errSuccess;
+    CJournalBuffer  jb( sizeof( CJournalEntryHeader ) + cjentcu * sizeof( CJournalEntryClusterUpdate ), pbEntry );
+    JournalPosition jpos    = jposInvalid;
+
+    Assert( cjentcu <= cjentcuMax );
+
+    Call( m_pj->ErrAppendEntry( 1, &jb, &jpos ) );
+
+    m_jposAppend = jpos;
+
+    if ( pjpos )
+    {
+        *pjpos = jpos;
+    }
+
+HandleError:
+    return err;
+}
+
+template< class I >
+ERR THashedLRUKCache<I>::ErrReadCluster(    _In_                        const TraceContext&     tc,
+                                            _In_                        const ClusterNumber     clno,
+                                            _In_                        const DWORD             ecc,
+                                            _In_                        const OSFILEQOS         grbitQOS,
+                                            _Out_writes_( m_cbCluster ) BYTE* const             pbCluster )
+{
+    ERR err = JET_errSuccess;
+
+    Call( PffCaching()->ErrIORead( tc, m_pch->IbCluster( clno ), m_cbCluster, pbCluster, grbitQOS ) );
+
+    if ( Crc32Checksum( pbCluster, m_cbCluster ) != ecc )
+    {
+        Error( ErrERRCheck( JET_errReadVerifyFailure ) );
+    }
+
+HandleError:
+    return err;
+}
+
+template< class I >
+ERR THashedLRUKCache<I>::ErrWriteCluster(   _In_                        const TraceContext&     tc,
+                                            _In_                        const ClusterNumber     clno,
+                                            _In_reads_( m_cbCluster )   const BYTE* const       pbCluster )
+{
+    return PffCaching()->ErrIOWrite( tc, m_pch->IbCluster( clno ), m_cbCluster, pbCluster, qosIONormal );
+}
+
+template< class I >
+ERR THashedLRUKCache<I>::ErrReserveCluster( _In_    CHashedLRUKCachedFileTableEntry* const  pcfte,
+                                            _In_    const ULONG                             iSet,
+                                            _In_    const BlockNumber                       blno,
+                                            _In_    const BOOL                              fDirty,
+                                            _In_    const BOOL                              fWait,
+                                            _Out_   ClusterNumber* const                    pclno )
+{
+    ERR                     err             = JET_errSuccess;
+    CCriticalSection* const pcrit           = PcritSet( iSet );
+    const TICK              tickStart       = TickOSTimeCurrent();
+    TICK                    dtickWait       = 0;
+    ClusterNumber           clno            = clnoInvalid;
+    ClusterNumber           clnoOld         = clnoInvalid;
+    BOOL                    fQuarantined    = fFalse;
+    BOOL                    fEvicted        = fFalse;
+    BlockNumber             blnoEvicted     = blnoInvalid;
+
+    *pclno = clnoInvalid;
+
+    for ( ; ; )
+    {
+        pcrit->Enter();
+
+
+        clnoOld = ClnoFind( iSet, pcfte->Volumeid(), pcfte->Fileid(), pcfte->Fileserial(), blno );
+        if (    fDirty &&
+                ( clnoOld == clnoInvalid || !Pclent( clnoOld )->m_fDirty ) &&
+                CClusterUnavailable( iSet ) + 2 > m_cClusterPerSet )
+        {
+            dtickWait = DtickDelta( tickStart, TickOSTimeCurrent() );
+
+            if ( blno != (BlockNumber)0 || dtickWait > cmsecReserveBlockZeroMax )
+            {
+                pcrit->Leave();
+
+                RequestWriteBack();
+
+                if ( blno != (BlockNumber)0 )
+                {
+                    goto HandleError;
+                }
+                Error( ErrERRCheck( JET_errDiskFull ) );
+            }
+
+            WaitForClusterRelease( pcrit, (INT)( cmsecReserveBlockZeroMax - dtickWait ) );
+            continue;
+        }
+
+
+        clno = ClnoVictim( iSet, pcfte->Volumeid(), pcfte->Fileid(), pcfte->Fileserial(), blno, &fQuarantined );
+        if ( clno != clnoInvalid )
+        {
+            CClusterEntry* const pclent = Pclent( clno );
+
+            fEvicted = pclent->m_fValid && pclent->m_volumeid == pcfte->Volumeid() && pclent->m_fileid == pcfte->Fileid();
+            blnoEvicted = pclent->m_blno;
+
+            pclent->m_fValid = fFalse;
+            pclent->m_fBusy = fTrue;
+            pclent->m_fQuarantined = fFalse;
+
+            pcrit->Leave();
+            break;
+        }
+
+        if ( !fWait )
+        {
+            pcrit->Leave();
+            goto HandleError;
+        }
+
+        if ( fQuarantined )
+        {
+            pcrit->Leave();
+            Call( ErrFlushCache() );
+        }
+        else
+        {
+            WaitForClusterRelease( pcrit, cmsecInfinite );
+        }
+    }
+
+    if ( fEvicted )
+    {
+        ReportEvict( pcfte, (QWORD)blnoEvicted * m_cbCluster, m_cbCluster, fTrue );
+    }
+
+    *pclno = clno;
+
+HandleError:
+    return err;
+}
+
+template< class I >
+ERR THashedLRUKCache<I>::ErrPublishCluster( _In_    CHashedLRUKCachedFileTableEntry* const  pcfte,
+                                            _In_    const ULONG                             iSet,
+                                            _In_    const ClusterNumber                     clno,
+                                            _In_    const BlockNumber                       blno,
+                                            _In_    const DWORD                             ecc,
+                                            _In_    const BOOL                              fDirty,
+                                            _Out_   BOOL* const                             pfInserted )
+{
+    ERR                     err             = JET_errSuccess;
+    CCriticalSection* const pcrit           = PcritSet( iSet );
+    CClusterEntry* const    pclent          = Pclent( clno );
+    ClusterNumber           clnoOld         = clnoInvalid;
+    TouchNumber             tonoOld         = (TouchNumber)0;
+    ClusterNumber           rgclno[ cjentcuMax ];
+    ClusterOperation        rgclop[ cjentcuMax ];
+    BYTE                    rgbEntry[ cbClusterUpdatesMax ];
+    ULONG                   cjentcu         = 0;
+    BOOL                    fRequestWriteBack   = fFalse;
+
+    *pfInserted = fFalse;
+
+    pcrit->Enter();
+
+
+    for ( ; ; )
+    {
+        clnoOld = ClnoFind( iSet, pcfte->Volumeid(), pcfte->Fileid(), pcfte->Fileserial(), blno );
+        if ( clnoOld == clnoInvalid || !Pclent( clnoOld )->m_fBusy )
+        {
+            break;
+        }
+
+        WaitForClusterRelease( pcrit, cmsecInfinite );
+        pcrit->Enter();
+    }
+
+    if ( clnoOld != clnoInvalid && !fDirty )
+    {
+        pclent->m_fBusy = fFalse;
+        pcrit->Leave();
+        goto HandleError;
+    }
+
+
+    pclent->m_volumeid = pcfte->Volumeid();
+    pclent->m_fileid = pcfte->Fileid();
+    pclent->m_fileserial = pcfte->Fileserial();
+    pclent->m_blno = blno;
+    pclent->m_ecc = ecc;
+    tonoOld = clnoOld != clnoInvalid ? Pclent( clnoOld )->m_tono0 : (TouchNumber)0;
+    pclent->m_tono0 = tonoOld;
+    Touch( pclent );
+    if ( clnoOld == clnoInvalid )
+    {
+        pclent->m_tono1 = (TouchNumber)( (DWORD)pclent->m_tono0 - dtonoUnreferenced );
+    }
+    pclent->m_fDirty = fFalse;
+
+
+    rgclno[ 0 ] = clno;
+    rgclop[ 0 ] = fDirty ? clopUpdate : clopAccess;
+    rgclno[ 1 ] = clnoOld;
+    rgclop[ 1 ] = clopInvalidate;
+    cjentcu = clnoOld != clnoInvalid ? 2 : 1;
+    BuildClusterUpdates( cjentcu, rgclno, rgclop, rgbEntry );
+
+    if ( clnoOld != clnoInvalid )
+    {
+        Pclent( clnoOld )->m_fBusy = fTrue;
+    }
+
+    pcrit->Leave();
+
+
+    m_rwlUpdate.EnterAsReader();
+
+    err = ErrAppendClusterUpdates( cjentcu, rgbEntry, NULL );
+
+    pcrit->Enter();
+
+    pclent->m_fBusy = fFalse;
+    if ( clnoOld != clnoInvalid )
+    {
+        Pclent( clnoOld )->m_fBusy = fFalse;
+    }
+
+    if ( err >= JET_errSuccess )
+    {
+        if ( clnoOld != clnoInvalid )
+        {
+            CClusterEntry* const pclentOld = Pclent( clnoOld );
+
+            pclentOld->m_fValid = fFalse;
+            SetDirty( pclentOld, fFalse );
+            Quarantine( pclentOld );
+        }
+        pclent->m_fValid = fTrue;
+        SetDirty( pclent, fDirty );
+
+        fRequestWriteBack = fDirty && ( m_cClusterDirty > m_cClusterDirtyMax || 2 * CClusterUnavailable( iSet ) >= m_cClusterPerSet );
+
+        *pfInserted = fTrue;
+    }
+
+    pcrit->Leave();
+
+    m_rwlUpdate.LeaveAsReader();
+
+HandleError:
+    ReleaseClusterWaiters();
+    if ( fRequestWriteBack )
+    {
+        RequestWriteBack();
+    }
+    return err;
+}
+
+template< class I >
+ERR THashedLRUKCache<I>::ErrInsertCluster(  _In_                        const TraceContext&                     tc,
+                                            _In_                        CHashedLRUKCachedFileTableEntry* const  pcfte,
+                                            _In_                        const BlockNumber                       blno,
+                                            _In_reads_( m_cbCluster )   const BYTE* const                       pbCluster,
+                                            _In_                        const BOOL                              fDirty,
+                                            _In_                        const BOOL                              fWait,
+                                            _Out_                       BOOL* const                             pfInserted )
+{
+    ERR             err             = JET_errSuccess;
+    const ULONG     iSet            = ISet( pcfte->Volumeid(), pcfte->Fileid(), pcfte->Fileserial(), blno );
+    const DWORD     ecc             = Crc32Checksum( pbCluster, m_cbCluster );
+    ClusterNumber   clno            = clnoInvalid;
+    BOOL            fCheckpointed   = fFalse;
+
+    *pfInserted = fFalse;
+
+    for ( ; ; )
+    {
+        Call( ErrReserveCluster( pcfte, iSet, blno, fDirty, fWait, &clno ) );
+        if ( clno == clnoInvalid )
+        {
+            goto HandleError;
+        }
+
+
+        err = ErrWriteCluster( tc, clno, pbCluster );
+        if ( err >= JET_errSuccess )
+        {
+            err = ErrPublishCluster( pcfte, iSet, clno, blno, ecc, fDirty, pfInserted );
+        }
+        else
+        {
+            PcritSet( iSet )->Enter();
+            Pclent( clno )->m_fBusy = fFalse;
+            PcritSet( iSet )->Leave();
+
+            ReleaseClusterWaiters();
+        }
+
+
+        if ( err == JET_errDiskFull && !fCheckpointed )
+        {
+            fCheckpointed = fTrue;
+            Call( ErrCheckpoint( fTrue, 0 ) );
+            continue;
+        }
+
+        Call( err );
+        break;
+    }
+
+    if ( *pfInserted )
+    {
+        Call( ErrMaybeCheckpoint() );
+    }
+
+HandleError:
+    return err;
+}
+
+template< class I >
+ERR THashedLRUKCache<I>::ErrDropCluster(    _In_ CHashedLRUKCachedFileTableEntry* const pcfte,
+                                            _In_ const BlockNumber                      blno )
+{
+    ERR                     err     = JET_errSuccess;
+    const ULONG             iSet    = ISet( pcfte->Volumeid(), pcfte->Fileid(), pcfte->Fileserial(), blno );
+    CCriticalSection* const pcrit   = PcritSet( iSet );
+    ClusterNumber           clno    = clnoInvalid;
+    CClusterEntry*          pclent  = NULL;
+    const ClusterOperation  clop    = clopInvalidate;
+    BYTE                    rgbEntry[ cbClusterUpdatesMax ];
+
+    pcrit->Enter();
+
+    for ( ; ; )
+    {
+        clno = ClnoFind( iSet, pcfte->Volumeid(), pcfte->Fileid(), pcfte->Fileserial(), blno );
+        if ( clno == clnoInvalid || ( !Pclent( clno )->m_fWriteBack && !Pclent( clno )->m_fBusy ) )
+        {
+            break;
+        }
+
+        WaitForClusterRelease( pcrit, cmsecInfinite );
+        pcrit->Enter();
+    }
+
+    if ( clno != clnoInvalid )
+    {
+        Pclent( clno )->m_fBusy = fTrue;
+        BuildClusterUpdates( 1, &clno, &clop, rgbEntry );
+    }
+
+    pcrit->Leave();
+
+    if ( clno == clnoInvalid )
+    {
+        goto HandleError;
+    }
+
+
+    m_rwlUpdate.EnterAsReader();
+
+    err = ErrAppendClusterUpdates( 1, rgbEntry, NULL );
+
+    pcrit->Enter();
+
+    pclent = Pclent( clno );
+    pclent->m_fBusy = fFalse;
+    if ( err >= JET_errSuccess )
+    {
+        pclent->m_fValid = fFalse;
+        SetDirty( pclent, fFalse );
+        Quarantine( pclent );
+    }
+
+    pcrit->Leave();
+
+    m_rwlUpdate.LeaveAsReader();
+
+    ReleaseClusterWaiters();
+
+    Call( err );
+
+    ReportEvict( pcfte, (QWORD)blno * m_cbCluster, m_cbCluster, fFalse );
+
+HandleError:
+    return err;
+}
+
+template< class I >
+ERR THashedLRUKCache<I>::ErrWriteBackCluster( _In_ const ULONG iSet, _In_ const ClusterNumber clno )
+{
+    ERR                                 err         = JET_errSuccess;
+    CCriticalSection* const             pcrit       = PcritSet( iSet );
+    CClusterEntry* const                pclent      = Pclent( clno );
+    VolumeId                            volumeid    = volumeidInvalid;
+    FileId                              fileid      = fileidInvalid;
+    FileSerial                          fileserial  = fileserialInvalid;
+    BlockNumber                         blno        = blnoInvalid;
+    DWORD                               ecc         = 0;
+    BYTE*                               pbCluster   = NULL;
+    CHashedLRUKCachedFileTableEntry*    pcfte       = NULL;
+    BOOL                                fClose      = fFalse;
+    QWORD                               cbSize      = 0;
+    QWORD                               ib          = 0;
+    DWORD                               cb          = 0;
+    const ClusterOperation              clop        = clopWriteBack;
+    BYTE                                rgbEntry[ cbClusterUpdatesMax ];
+    BOOL                                fUpdate     = fFalse;
+    TraceContextScope                   tcScope( iorpBlockCache );
+
+    pcrit->Enter();
+    Assert( pclent->m_fWriteBack );
+    volumeid = pclent->m_volumeid;
+    fileid = pclent->m_fileid;
+    fileserial = pclent->m_fileserial;
+    blno = pclent->m_blno;
+    ecc = pclent->m_ecc;
+    pcrit->Leave();
+
+
+    Alloc( pbCluster = (BYTE*)PvOSMemoryPageAlloc( m_cbCluster, NULL ) );
+    Call( ErrReadCluster( *tcScope, clno, ecc, qosIONormal, pbCluster ) );
+
+
+    Call( ErrGetCachedFile( volumeid, fileid, fileserial, fTrue, &pcfte ) );
+    if ( !pcfte )
+    {
+        Call( ErrGetCachedFile( volumeid, fileid, fileserial, fFalse, &pcfte ) );
+        fClose = fTrue;
+    }
+
+
+    ib = (QWORD)blno * m_cbCluster;
+    Call( pcfte->Pff()->ErrSize( &cbSize, IFileAPI::filesizeLogical ) );
+    cb = (DWORD)( ib < cbSize ? min( (QWORD)m_cbCluster, cbSize - ib ) : 0 );
+
+    if ( cb > 0 )
+    {
+        Call( pcfte->Pff()->ErrWrite( *tcScope, ib, cb, pbCluster, qosIONormal, iomRaw, NULL, NULL, NULL ) );
+        Call( pcfte->Pff()->ErrFlushFileBuffers( iofrBlockCache ) );
+
+        ReportWrite( pcfte, ib, cb, fTrue );
+    }
+
+
+    pcrit->Enter();
+    fUpdate =   pclent->m_fValid &&
+                pclent->m_fDirty &&
+                !pclent->m_fBusy &&
+                pclent->m_ecc == ecc &&
+                pclent->FMatches( volumeid, fileid, fileserial, blno );
+    if ( fUpdate )
+    {
+        pclent->m_fBusy = fTrue;
+        BuildClusterUpdates( 1, &clno, &clop, rgbEntry );
+    }
+    pcrit->Leave();
+
+    if ( fUpdate )
+    {
+        m_rwlUpdate.EnterAsReader();
+
+        err = ErrAppendClusterUpdates( 1, rgbEntry, NULL );
+
+        pcrit->Enter();
+        pclent->m_fBusy = fFalse;
+        if ( err >= JET_errSuccess )
+        {
+            SetDirty( pclent, fFalse );
+        }
+        pcrit->Leave();
+
+        m_rwlUpdate.LeaveAsReader();
+    }
+
+    Call( err );
+
+
+    Call( m_pj->ErrFlush() );
+
+HandleError:
+    pcrit->Enter();
+    pclent->m_fWriteBack = fFalse;
+    pclent->m_cref--;
+    pcrit->Leave();
+    ReleaseClusterWaiters();
+    if ( fClose )
+    {
+        (void)ErrClose( volumeid, fileid, fileserial );
+    }
+    OSMemoryPageFree( pbCluster );
+    return err;
+}
+
+template< class I >
+ERR THashedLRUKCache<I>::ErrAllocCluster( _Inout_ BYTE** const ppbCluster )
+{
+    ERR err = JET_errSuccess;
+
+    if ( !*ppbCluster )
+    {
+        Alloc( *ppbCluster = (BYTE*)PvOSMemoryPageAlloc( m_cbCluster, NULL ) );
+    }
+
+HandleError:
+    return err;
+}
+
+template< class I >
+ERR THashedLRUKCache<I>::ErrReadBlock(  _In_                        const TraceContext&                     tc,
+                                        _In_                        CHashedLRUKCachedFileTableEntry* const  pcfte,
+                                        _In_                        const QWORD                             ibOffset,
+                                        _In_                        const DWORD                             cbData,
+                                        _Out_writes_( cbData )      BYTE* const                             pbData,
+                                        _In_                        const OSFILEQOS                         grbitQOS,
+                                        _In_                        const ICache::CachingPolicy             cp,
+                                        _In_opt_                    CComplete* const                        pcomplete,
+                                        _Inout_                     BYTE** const                            ppbCluster )
+{
+    ERR                     err         = JET_errSuccess;
+    const BlockNumber       blno        = (BlockNumber)( ibOffset / m_cbCluster );
+    const DWORD             ibCluster   = (DWORD)( ibOffset % m_cbCluster );
+    const BOOL              fFull       = ibCluster == 0 && cbData == m_cbCluster;
+    const ULONG             iSet        = ISet( pcfte->Volumeid(), pcfte->Fileid(), pcfte->Fileserial(), blno );
+    CCriticalSection* const pcrit       = PcritSet( iSet );
+    ClusterNumber           clno        = clnoInvalid;
+    DWORD                   ecc         = 0;
+    BOOL                    fDirty      = fFalse;
+    BOOL                    fHit        = fFalse;
+    BOOL                    fInserted   = fFalse;
+
+    if ( !fFull )
+    {
+        Call( ErrAllocCluster( ppbCluster ) );
+    }
+
+
+    pcrit->Enter();
+    clno = ClnoFind( iSet, pcfte->Volumeid(), pcfte->Fileid(), pcfte->Fileserial(), blno );
+    if ( clno != clnoInvalid )
+    {
+        CClusterEntry* const pclent = Pclent( clno );
+
+        pclent->m_cref++;
+        Touch( pclent );
+        ecc = pclent->m_ecc;
+        fDirty = pclent->m_fDirty;
+    }
+    pcrit->Leave();
+
+
+    if ( clno != clnoInvalid )
+    {
+        err = ErrReadCluster( tc, clno, ecc, grbitQOS, fFull ? pbData : *ppbCluster );
+        Unpin( iSet, clno );
+
+        if ( err == JET_errReadVerifyFailure && !fDirty )
+        {
+            Call( ErrDropCluster( pcfte, blno ) );
+        }
+        else
+        {
+            Call( err );
+            fHit = fTrue;
+        }
+    }
+
+
+    if ( fHit )
+    {
+        ReportHit( pcfte, ibOffset, cbData, grbitQOS, fTrue, cp != cpDontCache );
+
+        if ( !fFull )
+        {
+            UtilMemCpy( pbData, *ppbCluster + ibCluster, cbData );
+        }
+    }
+    else
+    {
+        ReportMiss( pcfte, ibOffset, cbData, grbitQOS, fTrue, cp != cpDontCache );
+
+        if ( blno == (BlockNumber)0 )
+        {
+            memset( pbData, 0, cbData );
+        }
+        else
+        {
+            //  a miss we will cache needs its data before we return, anything else can complete
+            //  with the rest of the request
+
+            const BOOL fInsert  = fFull && cp != cpDontCache;
+            const BOOL fAsync   = pcomplete && !fInsert;
+
+            Call( pcfte->Pff()->ErrRead(    tc,
+                                            ibOffset,
+                                            cbData,
+                                            pbData,
+                                            grbitQOS,
+                                            iomCacheMiss,
+                                            fAsync ? (IFileAPI::PfnIOComplete)CComplete::IOComplete_ : NULL,
+                                            fAsync ? DWORD_PTR( pcomplete ) : NULL,
+                                            fAsync ? (IFileAPI::PfnIOHandoff)CComplete::IOHandoff_ : NULL,
+                                            NULL ) );
+
+            if ( fInsert )
+            {
+                (void)ErrInsertCluster( tc, pcfte, blno, pbData, fFalse, fFalse, &fInserted );
+            }
+        }
+    }
+
+HandleError:
+    return err;
+}
+
+template< class I >
+ERR THashedLRUKCache<I>::ErrWriteBlock( _In_                        const TraceContext&                     tc,
+                                        _In_                        CHashedLRUKCachedFileTableEntry* const  pcfte,
+                                        _In_                        const QWORD                             ibOffset,
+                                        _In_                        const DWORD                             cbData,
+                                        _In_reads_( cbData )        const BYTE* const                       pbData,
+                                        _In_                        const OSFILEQOS                         grbitQOS,
+                                        _In_                        const ICache::CachingPolicy             cp,
+                                        _In_opt_                    CComplete* const                        pcomplete,
+                                        _Inout_                     BYTE** const                            ppbCluster )
+{
+    ERR                     err         = JET_errSuccess;
+    const BlockNumber       blno        = (BlockNumber)( ibOffset / m_cbCluster );
+    const DWORD             ibCluster   = (DWORD)( ibOffset % m_cbCluster );
+    const BOOL              fFull       = ibCluster == 0 && cbData == m_cbCluster;
+    const ULONG             iSet        = ISet( pcfte->Volumeid(), pcfte->Fileid(), pcfte->Fileserial(), blno );
+    CCriticalSection* const pcrit       = PcritSet( iSet );
+    ClusterNumber           clno        = clnoInvalid;
+    DWORD                   ecc         = 0;
+    BOOL                    fDirty      = fFalse;
+    BOOL                    fCached     = fFalse;
+    BOOL                    fInserted   = fFalse;
+    const BYTE*             pbCluster   = pbData;
+
+    pcrit->Enter();
+    clno = ClnoFind( iSet, pcfte->Volumeid(), pcfte->Fileid(), pcfte->Fileserial(), blno );
+    if ( clno != clnoInvalid )
+    {
+        CClusterEntry* const pclent = Pclent( clno );
+
+        pclent->m_cref++;
+        ecc = pclent->m_ecc;
+        fDirty = pclent->m_fDirty;
+        fCached = fTrue;
+    }
+    pcrit->Leave();
+
+
+    if ( fCached )
+    {
+        ReportHit( pcfte, ibOffset, cbData, grbitQOS, fFalse, cp != cpDontCache );
+    }
+    else
+    {
+        ReportMiss( pcfte, ibOffset, cbData, grbitQOS, fFalse, cp != cpDontCache );
+    }
+    ReportUpdate( pcfte, ibOffset, cbData );
+
+
+    if ( !fFull )
+    {
+        Call( ErrAllocCluster( ppbCluster ) );
+
+        if ( fCached )
+        {
+            err = ErrReadCluster( tc, clno, ecc, qosIONormal, *ppbCluster );
+            Unpin( iSet, clno );
+            clno = clnoInvalid;
+
+            if ( err == JET_errReadVerifyFailure && !fDirty )
+            {
+                Call( ErrDropCluster( pcfte, blno ) );
+                fCached = fFalse;
+            }
+            Call( err );
+        }
+        else if ( blno == (BlockNumber)0 )
+        {
+            memset( *ppbCluster, 0, m_cbCluster );
+        }
+
+        UtilMemCpy( *ppbCluster + ibCluster, pbData, cbData );
+        pbCluster = *ppbCluster;
+    }
+    else if ( fCached )
+    {
+        Unpin( iSet, clno );
+        clno = clnoInvalid;
+    }
+
+
+    if ( !fCached && blno != (BlockNumber)0 && ( !fFull || cp == cpDontCache ) )
+    {
+        Call( pcfte->Pff()->ErrWrite(   tc,
+                                        ibOffset,
+                                        cbData,
+                                        pbData,
+                                        grbitQOS,
+                                        iomCacheWriteThrough,
+                                        pcomplete ? (IFileAPI::PfnIOComplete)CComplete::IOComplete_ : NULL,
+                                        DWORD_PTR( pcomplete ),
+                                        pcomplete ? (IFileAPI::PfnIOHandoff)CComplete::IOHandoff_ : NULL ) );
+        ReportWrite( pcfte, ibOffset, cbData, fFalse );
+        goto HandleError;
+    }
+
+
+    Call( ErrInsertCluster( tc, pcfte, blno, pbCluster, fTrue, fTrue, &fInserted ) );
+    if ( !fInserted )
+    {
+        Assert( blno != (BlockNumber)0 );
+
+        if ( fCached )
+        {
+            Call( ErrDropCluster( pcfte, blno ) );
+            Call( ErrFlushCache() );
+        }
+
+        Call( pcfte->Pff()->ErrWrite(   tc,
+                                        ibOffset,
+                                        cbData,
+                                        pbData,
+                                        grbitQOS,
+                                        iomCacheWriteThrough,
+                                        pcomplete ? (IFileAPI::PfnIOComplete)CComplete::IOComplete_ : NULL,
+                                        DWORD_PTR( pcomplete ),
+                                        pcomplete ? (IFileAPI::PfnIOHandoff)CComplete::IOHandoff_ : NULL ) );
+        ReportWrite( pcfte, ibOffset, cbData, fFalse );
+    }
+
+HandleError:
+    if ( clno != clnoInvalid )
+    {
+        Unpin( iSet, clno );
+    }
+    return err;
+}
+
+template< class I >
+ERR THashedLRUKCache<I>::ErrInvalidateBlock(    _In_                        const TraceContext&                     tc,
+                                                _In_                        CHashedLRUKCachedFileTableEntry* const  pcfte,
+                                                _In_                        const QWORD                             ibOffset,
+                                                _In_                        const DWORD                             cbData,
+                                                _Inout_                     BYTE** const                            ppbCluster )
+{
+    ERR                     err         = JET_errSuccess;
+    const BlockNumber       blno        = (BlockNumber)( ibOffset / m_cbCluster );
+    const DWORD             ibCluster   = (DWORD)( ibOffset % m_cbCluster );
+    const BOOL              fFull       = ibCluster == 0 && cbData == m_cbCluster;
+    const ULONG             iSet        = ISet( pcfte->Volumeid(), pcfte->Fileid(), pcfte->Fileserial(), blno );
+    CCriticalSection* const pcrit       = PcritSet( iSet );
+    ClusterNumber           clno        = clnoInvalid;
+    DWORD                   ecc         = 0;
+    BOOL                    fDirty      = fFalse;
+    BOOL                    fInserted   = fFalse;
+
+    pcrit->Enter();
+    clno = ClnoFind( iSet, pcfte->Volumeid(), pcfte->Fileid(), pcfte->Fileserial(), blno );
+    if ( clno != clnoInvalid )
+    {
+        CClusterEntry* const pclent = Pclent( clno );
+
+        pclent->m_cref++;
+        ecc = pclent->m_ecc;
+        fDirty = pclent->m_fDirty;
+    }
+    pcrit->Leave();
+
+
+    if ( blno == (BlockNumber)0 || ( !fFull && fDirty ) )
+    {
+        Call( ErrAllocCluster( ppbCluster ) );
+
+        if ( clno != clnoInvalid )
+        {
+            Call( ErrReadCluster( tc, clno, ecc, qosIONormal, *ppbCluster ) );
+        }
+        else
+        {
+            memset( *ppbCluster, 0, m_cbCluster );
+        }
+
+        memset( *ppbCluster + ibCluster, 0, cbData );
+
+        Call( ErrInsertCluster( tc, pcfte, blno, *ppbCluster, fTrue, fTrue, &fInserted ) );
+        if ( !fInserted )
+        {
+            Error( ErrERRCheck( JET_errDiskFull ) );
+        }
+    }
+    else if ( clno != clnoInvalid )
+    {
+        Unpin( iSet, clno );
+        clno = clnoInvalid;
+
+        Call( ErrDropCluster( pcfte, blno ) );
+    }
+
+HandleError:
+    if ( clno != clnoInvalid )
+    {
+        Unpin( iSet, clno );
+    }
+    return err;
+}
+
+template< class I >
+ERR THashedLRUKCache<I>::ErrFlushCache()
+{
+    ERR         err     = JET_errSuccess;
+    const LONG  epoch   = AtomicExchangeAdd( &m_epochCurrent, 1 );
+
+    Call( PffCaching()->ErrFlushFileBuffers( iofrBlockCache ) );
+    Call( m_pj->ErrFlush() );
+
+    ReleaseQuarantine( epoch );
+
+HandleError:
+    return err;
+}
+
+template< class I >
+ERR THashedLRUKCache<I>::ErrMaybeCheckpoint()
+{
+    ERR         err             = JET_errSuccess;
+    const QWORD cbJournalUsed   = (QWORD)m_jposAppend - (QWORD)m_jposReplay;
+
+    if ( cbJournalUsed > m_pch->CbJournal() / 2 )
+    {
+        Call( ErrCheckpoint( fTrue, m_pch->CbJournal() / 2 ) );
+    }
+    else if ( cbJournalUsed > m_pch->CbJournal() / 4 )
+    {
+        Call( ErrCheckpoint( fFalse, m_pch->CbJournal() / 4 ) );
+    }
+
+HandleError:
+    return err;
+}
+
+template< class I >
+ERR THashedLRUKCache<I>::ErrCheckpoint( _In_ const BOOL fWait, _In_ const QWORD cbJournalUsedMin )
+{
+    ERR                     err         = JET_errSuccess;
+    BOOL                    fLeave      = fFalse;
+    ULONG                   ccritOwned  = 0;
+    JournalPosition         jposMarker  = jposInvalid;
+    LONG                    epoch       = 0;
+    CClusterState* const    rgclst      = RgclstClusterStateTable();
+    ULONG                   iTable      = 0;
+    BYTE                    rgbMarker[ cbClusterUpdatesMax ];
+
+    if ( fWait )
+    {
+        m_critCheckpoint.Enter();
+    }
+    else if ( !m_critCheckpoint.FTryEnter() )
+    {
+        goto HandleError;
+    }
+    fLeave = fTrue;
+
+    if ( (QWORD)m_jposAppend - (QWORD)m_jposReplay < cbJournalUsedMin )
+    {
+        goto HandleError;
+    }
+
+
+    //  no cluster update can be between its journal append and its in-memory update while we
+    //  hold m_rwlUpdate exclusively, so the state table matches the journal up to the marker
+
+    m_rwlUpdate.EnterAsWriter();
+
+    BuildClusterUpdates( 0, NULL, NULL, rgbMarker );
+    err = ErrAppendClusterUpdates( 0, rgbMarker, &jposMarker );
+    if ( err >= JET_errSuccess )
+    {
+        for ( ccritOwned = 0; ccritOwned < m_ccritSet; ccritOwned++ )
+        {
+            m_rgcritSet[ m_ccritSet - ccritOwned - 1 ].Enter();
+        }
+
+        for ( ULONG iCluster = 0; iCluster < m_cCluster; iCluster++ )
+        {
+            const CClusterEntry* const pclent = &m_rgclent[ iCluster ];
+            new( &rgclst[ iCluster ] ) CClusterState( pclent->Clst( (ClusterNumber)iCluster, pclent->ClopCurrent() ) );
+        }
+        epoch = AtomicExchangeAdd( &m_epochCurrent, 1 );
+
+        for ( ; ccritOwned > 0; ccritOwned-- )
+        {
+            m_rgcritSet[ m_ccritSet - ccritOwned ].Leave();
+        }
+    }
+
+    m_rwlUpdate.LeaveAsWriter();
+
+    Call( err );
+
+
+    iTable = (ULONG)( ( m_ulCheckpoint + 1 ) % CHashedLRUKCacheHeader::cClusterStateTable );
+    new( m_pbClusterStateTable ) CClusterStateTableHeader(  m_ulCheckpoint + 1,
+                                                            jposMarker,
+                                                            m_cCluster,
+                                                            Crc32Checksum( (const BYTE*)rgclst, m_cCluster * sizeof( CClusterState ) ) );
+
+    Call( PffCaching()->ErrFlushFileBuffers( iofrBlockCache ) );
+    Call( ErrWriteClusterStateTable( PffCaching(), m_pch, iTable, m_pbClusterStateTable ) );
+    Call( PffCaching()->ErrFlushFileBuffers( iofrBlockCache ) );
+
+
+    Call( m_pj->ErrFlush() );
+    Call( m_pj->ErrTruncate( jposMarker ) );
+
+    m_ulCheckpoint++;
+    m_jposReplay = jposMarker;
+
+    ReleaseQuarantine( epoch );
+
+HandleError:
+    if ( fLeave )
+    {
+        m_critCheckpoint.Leave();
+    }
+    return err;
+}
+
+template< class I >
+void THashedLRUKCache<I>::RequestWriteBack()
+{
+    if ( AtomicCompareExchange( &m_fWriteBackRequested, fFalse, fTrue ) == fFalse )
+    {
+        OSTimerTaskScheduleTask( m_posttWriteBack, this, 0, 0 );
+    }
+}
+
+template< class I >
+void THashedLRUKCache<I>::WriteBack()
+{
+    const ULONG cSetVisit   = min( m_cSet, cSetWriteBackPerTask );
+    ULONG       cWriteBack  = 0;
+
+    AtomicExchange( &m_fWriteBackRequested, fFalse );
+
+    for ( ULONG iSetVisit = 0; iSetVisit < cSetVisit; iSetVisit++ )
+    {
+        const ULONG     iSet    = m_iSetWriteBack;
+        ClusterNumber   clno    = clnoInvalid;
+
+        m_iSetWriteBack = ( iSet + 1 ) % m_cSet;
+
+        PcritSet( iSet )->Enter();
+        clno = ClnoWriteBack( iSet );
+        if ( clno != clnoInvalid )
+        {
+            Pclent( clno )->m_fWriteBack = fTrue;
+            Pclent( clno )->m_cref++;
+        }
+        PcritSet( iSet )->Leave();
+
+        if ( clno != clnoInvalid && ErrWriteBackCluster( iSet, clno ) >= JET_errSuccess )
+        {
+            cWriteBack++;
+        }
+    }
+
+    if ( cWriteBack > 0 || m_cClusterDirty > m_cClusterDirtyMax )
+    {
+        RequestWriteBack();
+    }
+}
+
+template< class I >
+ERR THashedLRUKCache<I>::ErrReadClusterStateTable(  _In_    IFileFilter* const                  pff,
+                                                    _In_    const CHashedLRUKCacheHeader* const pch,
+                                                    _In_    const ULONG                         iTable,
+                                                    _Out_   BYTE* const                         pbTable )
+{
+    ERR                 err     = JET_errSuccess;
+    const QWORD         ibTable = pch->IbClusterStateTable( iTable );
+    const QWORD         cbTable = pch->CbClusterStateTable();
+    DWORD               cbIO    = 0;
+    TraceContextScope   tcScope( iorpBlockCache );
+
+    for ( QWORD ib = 0; ib < cbTable; ib += cbIO )
+    {
+        cbIO = (DWORD)min( cbTable - ib, cbClusterStateTableIOMax );
+        Call( pff->ErrIORead( *tcScope, ibTable + ib, cbIO, pbTable + ib, qosIONormal ) );
+    }
+
+HandleError:
+    return err;
+}
+
+template< class I >
+ERR THashedLRUKCache<I>::ErrWriteClusterStateTable( _In_    IFileFilter* const                  pff,
+                                                    _In_    const CHashedLRUKCacheHeader* const pch,
+                                                    _In_    const ULONG                         iTable,
+                                                    _In_    const BYTE* const                   pbTable )
+{
+    ERR                 err     = JET_errSuccess;
+    const QWORD         ibTable = pch->IbClusterStateTable( iTable );
+    const QWORD         cbTable = pch->CbClusterStateTable();
+    DWORD               cbIO    = 0;
+    TraceContextScope   tcScope( iorpBlockCache );
+
+    for ( QWORD ib = 0; ib < cbTable; ib += cbIO )
+    {
+        cbIO = (DWORD)min( cbTable - ib, cbClusterStateTableIOMax );
+        Call( pff->ErrIOWrite( *tcScope, ibTable + ib, cbIO, pbTable + ib, qosIONormal ) );
+    }
+
+HandleError:
+    return err;
+}
+
+template< class I >
+BOOL THashedLRUKCache<I>::FValidClusterStateTable(  _In_ const BYTE* const  pbTable,
+                                                    _In_ const ULONG        cCluster )
+{
+    const CClusterStateTableHeader* const pcsth = (const CClusterStateTableHeader*)pbTable;
+
+    return  pcsth->FValid() &&
+            pcsth->CCluster() == cCluster &&
+            pcsth->UlStateChecksum() == Crc32Checksum( pbTable + sizeof( CClusterStateTableHeader ), cCluster * sizeof( CClusterState ) );
+}
+
+template< class I >
+ERR THashedLRUKCache<I>::ErrLoadClusterStateTable()
+{
+    ERR                                     err         = JET_errSuccess;
+    const CClusterStateTableHeader* const   pcsth       = (const CClusterStateTableHeader*)m_pbClusterStateTable;
+    const CClusterState* const              rgclst      = RgclstClusterStateTable();
+    ULONG                                   iTableBest  = ulMax;
+    QWORD                                   ulBest      = 0;
+    ULONG                                   iTableLast  = ulMax;
+
+
+    for ( ULONG iTable = 0; iTable < CHashedLRUKCacheHeader::cClusterStateTable; iTable++ )
+    {
+        Call( ErrReadClusterStateTable( PffCaching(), m_pch, iTable, m_pbClusterStateTable ) );
+        iTableLast = iTable;
+
+        if ( FValidClusterStateTable( m_pbClusterStateTable, m_cCluster ) && pcsth->UlCheckpoint() > ulBest )
+        {
+            iTableBest = iTable;
+            ulBest = pcsth->UlCheckpoint();
+        }
+    }
+
+    if ( iTableBest == ulMax )
+    {
+        Error( ErrERRCheck( JET_errReadVerifyFailure ) );
+    }
+
+    if ( iTableBest != iTableLast )
+    {
+        Call( ErrReadClusterStateTable( PffCaching(), m_pch, iTableBest, m_pbClusterStateTable ) );
+    }
+
+
+    for ( ULONG iCluster = 0; iCluster < m_cCluster; iCluster++ )
+    {
+        if ( rgclst[ iCluster ].Clno() == (ClusterNumber)iCluster )
+        {
+            m_rgclent[ iCluster ].SetClst( rgclst[ iCluster ] );
+        }
+    }
+
+    m_ulCheckpoint = pcsth->UlCheckpoint();
+    m_jposReplay = pcsth->JposReplay();
+    m_jposAppend = m_jposReplay;
+
+HandleError:
+    return err;
+}
+
+template< class I >
+ERR THashedLRUKCache<I>::ErrReplayJournal()
+{
+    ERR err = JET_errSuccess;
+
+    Alloc( m_rgjposReplayed = new JournalPosition[ m_cCluster ] );
+    Alloc( m_rgclnoUndo = new ClusterNumber[ m_cCluster ] );
+    for ( ULONG iCluster = 0; iCluster < m_cCluster; iCluster++ )
+    {
+        m_rgjposReplayed[ iCluster ] = jposInvalid;
+        m_rgclnoUndo[ iCluster ] = clnoInvalid;
+    }
+
+    Call( m_pj->ErrVisitEntries( FReplayJournalEntry_, (DWORD_PTR)this ) );
+
+HandleError:
+    return err;
+}
+
+template< class I >
+BOOL THashedLRUKCache<I>::FReplayJournalEntry( _In_ const JournalPosition jpos, _In_ const CJournalBuffer jb )
+{
+    const CJournalEntryHeader* const pjenth = (const CJournalEntryHeader*)jb.Rgb();
+
+    if ( (QWORD)jpos <= (QWORD)m_jposReplay || jb.Cb() < sizeof( CJournalEntryHeader ) )
+    {
+        return fTrue;
+    }
+
+    const ULONG cjentcu = pjenth->CClusterUpdate();
+    if ( sizeof( CJournalEntryHeader ) + cjentcu * sizeof( CJournalEntryClusterUpdate ) > jb.Cb() )
+    {
+        return fTrue;
+    }
+
+    for ( ULONG ijentcu = 0; ijentcu < cjentcu; ijentcu++ )
+    {
+        const CJournalEntryClusterUpdate* const pjentcu = pjenth->Pjentcu() + ijentcu;
+        const ULONG                             iCluster = (ULONG)pjentcu->Clno();
+
+        if ( iCluster < m_cCluster )
+        {
+            m_rgclent[ iCluster ].SetClst( pjentcu->Clst() );
+            m_rgjposReplayed[ iCluster ] = jpos;
+            m_rgclnoUndo[ iCluster ] = clnoInvalid;
+        }
+    }
+
+    if (    cjentcu == 2 &&
+            pjenth->Pjentcu()[ 0 ].Clst().ClopLast() == clopUpdate &&
+            pjenth->Pjentcu()[ 1 ].Clst().ClopLast() == clopInvalidate &&
+            (ULONG)pjenth->Pjentcu()[ 0 ].Clno() < m_cCluster )
+    {
+        m_rgclnoUndo[ (ULONG)pjenth->Pjentcu()[ 0 ].Clno() ] = pjenth->Pjentcu()[ 1 ].Clno();
+    }
+
+    return fTrue;
+}
+
+template< class I >
+ERR THashedLRUKCache<I>::ErrVerifyReplayedClusters()
+{
+    ERR                 err         = JET_errSuccess;
+    BYTE*               pbCluster   = NULL;
+    TraceContextScope   tcScope( iorpBlockCache );
+
+    Alloc( pbCluster = (BYTE*)PvOSMemoryPageAlloc( m_cbCluster, NULL ) );
+
+    for ( ULONG iCluster = 0; iCluster < m_cCluster; iCluster++ )
+    {
+        CClusterEntry* const    pclent      = &m_rgclent[ iCluster ];
+        const ClusterNumber     clnoUndo    = m_rgclnoUndo[ iCluster ];
+
+        if ( m_rgjposReplayed[ iCluster ] == jposInvalid || !pclent->m_fValid )
+        {
+            continue;
+        }
+
+        err = ErrReadCluster( *tcScope, (ClusterNumber)iCluster, pclent->m_ecc, qosIONormal, pbCluster );
+        if ( err != JET_errReadVerifyFailure )
+        {
+            Call( err );
+            continue;
+        }
+        err = JET_errSuccess;
+
+        pclent->m_fValid = fFalse;
+        pclent->m_fDirty = fFalse;
+
+
+        if (    clnoUndo != clnoInvalid &&
+                (ULONG)clnoUndo < m_cCluster &&
+                m_rgjposReplayed[ (ULONG)clnoUndo ] == m_rgjposReplayed[ iCluster ] &&
+                !Pclent( clnoUndo )->m_fValid &&
+                ErrReadCluster( *tcScope, clnoUndo, Pclent( clnoUndo )->m_ecc, qosIONormal, pbCluster ) >= JET_errSuccess )
+        {
+            Pclent( clnoUndo )->m_fValid = fTrue;
+            Pclent( clnoUndo )->m_fDirty = fTrue;
+        }
+    }
+
+HandleError:
+    OSMemoryPageFree( pbCluster );
+    return err;
+}
+
+template< class I >
+void THashedLRUKCache<I>::RemoveDuplicateClusters()
+{
+    for ( ULONG iSet = 0; iSet < m_cSet; iSet++ )
+    {
+        for ( ULONG iCluster = iSet * m_cClusterPerSet; iCluster < ( iSet + 1 ) * m_cClusterPerSet; iCluster++ )
+        {
+            CClusterEntry* const pclent = &m_rgclent[ iCluster ];
+
+            for ( ULONG iClusterOther = iCluster + 1; pclent->m_fValid && iClusterOther < ( iSet + 1 ) * m_cClusterPerSet; iClusterOther++ )
+            {
+                CClusterEntry* const pclentOther = &m_rgclent[ iClusterOther ];
+
+                if ( pclentOther->m_fValid && pclentOther->FMatches( pclent->m_volumeid, pclent->m_fileid, pclent->m_fileserial, pclent->m_blno ) )
+                {
+                    CClusterEntry* const pclentStale = LONG( (DWORD)pclent->m_tono0 - (DWORD)pclentOther->m_tono0 ) < 0 ? pclent : pclentOther;
+
+                    pclentStale->m_fValid = fFalse;
+                    pclentStale->m_fDirty = fFalse;
+                }
+            }
+        }
+    }
+}
+
 
 const BYTE c_rgbHashedLRUKCacheType[ sizeof( GUID ) ] = { 0x4D, 0xCC, 0x73, 0x1C, 0x35, 0xAC, 0xD9, 0x41, 0xA9, 0xE0, 0xE4, 0x61, 0x12, 0xC0, 0x3A, 0x87 };
 
@@ -275,7 +2185,7 @@ class CHashedLRUKCache : public THashedLRUKCache<ICache>
 
         static ICache* PcCreate(    _In_    IFileSystemFilter* const            pfsf,
                                     _In_    IFileIdentification* const          pfident,
-                                    _In_    IFileSystemConfiguration* const     pfsconfig, 
+                                    _In_    IFileSystemConfiguration* const     pfsconfig,
                                     _Inout_ IBlockCacheConfiguration** const    ppbcconfig,
                                     _Inout_ ICacheConfiguration** const         ppcconfig,
                                     _In_    ICacheTelemetry* const              pctm,
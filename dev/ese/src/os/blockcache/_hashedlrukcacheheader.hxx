@@ -15,7 +15,8 @@ class CHashedLRUKCacheHeader : CBlockCacheHeaderHelpers
 {
     public:
 
-        static ERR ErrCreate( _Out_ CHashedLRUKCacheHeader** const ppch );
+        static ERR ErrCreate(   _In_    const QWORD                     cbCachingFile,
+                                _Out_   CHashedLRUKCacheHeader** const  ppch );
         static ERR ErrLoad( _In_    IFileSystemConfiguration* const pfsconfig, 
                             _In_    IFileFilter* const              pff,
                             _Out_   CHashedLRUKCacheHeader** const  ppch );
@@ -26,11 +27,26 @@ class CHashedLRUKCacheHeader : CBlockCacheHeaderHelpers
 
         ERR ErrDump( _In_ CPRINTF* const pcprintf );
 
+        ULONG CbCluster() const { return m_le_cbCluster; }
+        ULONG CClusterPerSet() const { return m_le_cClusterPerSet; }
+        ULONG CCluster() const { return m_le_cCluster; }
+        QWORD IbJournal() const { return m_le_ibJournal; }
+        QWORD CbJournal() const { return m_le_cbJournal; }
+        QWORD IbClusterStateTable( _In_ const ULONG iTable ) const { return m_le_ibClusterStateTable + iTable * CbClusterStateTable(); }
+        QWORD CbClusterStateTable() const { return m_le_cbClusterStateTable; }
+        QWORD IbCluster( _In_ const ClusterNumber clno ) const { return m_le_ibCluster + (QWORD)clno * CbCluster(); }
+
+        enum { cClusterStateTable = 2 };
+
     private:
 
         friend class CBlockCacheHeaderHelpers;
 
         enum { cbCacheHeader = cbBlock };
+        enum { cbClusterDefault = cbBlock };
+        enum { cClusterPerSetDefault = 8 };
+        enum { cbJournalMin = 64 * cbBlock };
+        enum { pctJournal = 3 };
 
         CHashedLRUKCacheHeader();
 
@@ -43,10 +59,26 @@ class CHashedLRUKCacheHeader : CBlockCacheHeaderHelpers
 
         LittleEndian<ULONG> m_le_ulChecksum;
         BYTE                m_rgbHeaderType[ cbGuid ];
+        LittleEndian<ULONG> m_le_cbCluster;
+        LittleEndian<ULONG> m_le_cClusterPerSet;
+        LittleEndian<ULONG> m_le_cCluster;
+        LittleEndian<QWORD> m_le_ibJournal;
+        LittleEndian<QWORD> m_le_cbJournal;
+        LittleEndian<QWORD> m_le_ibClusterStateTable;
+        LittleEndian<QWORD> m_le_cbClusterStateTable;
+        LittleEndian<QWORD> m_le_ibCluster;
 
         BYTE                m_rgbPadding[   cbCacheHeader 
                                             - sizeof( m_le_ulChecksum )
-                                            - sizeof( m_rgbHeaderType ) ];
+                                            - sizeof( m_rgbHeaderType )
+                                            - sizeof( m_le_cbCluster )
+                                            - sizeof( m_le_cClusterPerSet )
+                                            - sizeof( m_le_cCluster )
+                                            - sizeof( m_le_ibJournal )
+                                            - sizeof( m_le_cbJournal )
+                                            - sizeof( m_le_ibClusterStateTable )
+                                            - sizeof( m_le_cbClusterStateTable )
+                                            - sizeof( m_le_ibCluster ) ];
 };
 
 #include <poppack.h>
@@ -57,16 +89,45 @@ INLINE CHashedLRUKCacheHeader::CHashedLRUKCacheHeader()
     C_ASSERT( cbCacheHeader == sizeof( CHashedLRUKCacheHeader ) );
 }
 
-INLINE ERR CHashedLRUKCacheHeader::ErrCreate( _Out_ CHashedLRUKCacheHeader** const ppch )
+INLINE ERR CHashedLRUKCacheHeader::ErrCreate( _In_    const QWORD                     cbCachingFile,
+                                                _Out_   CHashedLRUKCacheHeader** const  ppch )
 {
-    ERR                     err = JET_errSuccess;
-    CHashedLRUKCacheHeader* pch = NULL;
+    ERR                     err                     = JET_errSuccess;
+    const QWORD             ibJournal               = sizeof( CCacheHeader ) + cbCacheHeader;
+    const QWORD             cbJournal               = max( cbJournalMin, rounddn( cbCachingFile * pctJournal / 100, cbBlock ) );
+    const QWORD             ibClusterStateTable     = ibJournal + cbJournal;
+    QWORD                   cCluster                = 0;
+    QWORD                   cbClusterStateTable     = 0;
+    CHashedLRUKCacheHeader* pch                     = NULL;
 
     *ppch = NULL;
 
+
+    if ( cbCachingFile < ibClusterStateTable )
+    {
+        Error( ErrERRCheck( JET_errInvalidParameter ) );
+    }
+
+    cCluster = ( cbCachingFile - ibClusterStateTable ) / ( cbClusterDefault + cClusterStateTable * sizeof( CClusterState ) );
+    cCluster = min( rounddn( cCluster, cClusterPerSetDefault ), rounddn( (QWORD)clnoInvalid - 1, cClusterPerSetDefault ) );
+    cbClusterStateTable = roundup( sizeof( CClusterStateTableHeader ) + cCluster * sizeof( CClusterState ), cbBlock );
+
+    if ( cCluster == 0 )
+    {
+        Error( ErrERRCheck( JET_errInvalidParameter ) );
+    }
+
     Alloc( pch = new CHashedLRUKCacheHeader() );
 
-    UtilMemCpy( pch->m_rgbHeaderType, c_rgbCacheHeaderV1, cbGuid );
+    UtilMemCpy( pch->m_rgbHeaderType, c_rgbHashedLRUKCacheHeaderV1, cbGuid );
+    pch->m_le_cbCluster = cbClusterDefault;
+    pch->m_le_cClusterPerSet = cClusterPerSetDefault;
+    pch->m_le_cCluster = (ULONG)cCluster;
+    pch->m_le_ibJournal = ibJournal;
+    pch->m_le_cbJournal = cbJournal;
+    pch->m_le_ibClusterStateTable = ibClusterStateTable;
+    pch->m_le_cbClusterStateTable = cbClusterStateTable;
+    pch->m_le_ibCluster = ibClusterStateTable + cClusterStateTable * cbClusterStateTable;
 
     pch->m_le_ulChecksum = GenerateChecksum( pch );
 
@@ -92,7 +153,7 @@ INLINE ERR CHashedLRUKCacheHeader::ErrLoad( _In_    IFileSystemConfiguration* co
 
     *ppch = NULL;
 
-    Call( ErrLoadHeader( pff, &pch ) );
+    Call( ErrLoadHeader( pff, sizeof( CCacheHeader ), &pch ) );
 
     Call( pch->ErrValidate( JET_errReadVerifyFailure ) );
 
@@ -115,7 +176,7 @@ INLINE ERR CHashedLRUKCacheHeader::ErrDump( _In_ IFileFilter* const pff,
     ERR                     err = JET_errSuccess;
     CHashedLRUKCacheHeader* pch = NULL;
 
-    Call( ErrLoadHeader( pff, &pch ) );
+    Call( ErrLoadHeader( pff, sizeof( CCacheHeader ), &pch ) );
 
     Call( pch->ErrValidate( JET_errFileInvalidType ) );
 
@@ -149,6 +210,14 @@ INLINE ERR CHashedLRUKCacheHeader::ErrDump( _In_ CPRINTF* const pcprintf )
                     *((BYTE*)&m_rgbHeaderType[ 13 ]),
                     *((BYTE*)&m_rgbHeaderType[ 14 ]),
                     *((BYTE*)&m_rgbHeaderType[ 15 ]) );
+    (*pcprintf)(    "         Cluster Size:  %lu\n", CbCluster() );
+    (*pcprintf)(    "    Clusters Per Set:  %lu\n", CClusterPerSet() );
+    (*pcprintf)(    "             Clusters:  %lu\n", CCluster() );
+    (*pcprintf)(    "       Journal Offset:  %llu\n", IbJournal() );
+    (*pcprintf)(    "         Journal Size:  %llu\n", CbJournal() );
+    (*pcprintf)(    "   State Table Offset:  %llu\n", IbClusterStateTable( 0 ) );
+    (*pcprintf)(    "     State Table Size:  %llu\n", CbClusterStateTable() );
+    (*pcprintf)(    "      Clusters Offset:  %llu\n", IbCluster( (ClusterNumber)0 ) );
     (*pcprintf)(    "\n" );
 
     return JET_errSuccess;
@@ -179,6 +248,19 @@ INLINE ERR CHashedLRUKCacheHeader::ErrValidate( _In_ const ERR errInvalidType )
         Call( ErrERRCheck( errInvalidType ) );
     }
 
+    if (    CbCluster() != cbClusterDefault ||
+            CClusterPerSet() == 0 ||
+            CCluster() == 0 ||
+            CCluster() % CClusterPerSet() != 0 ||
+            CCluster() >= (ULONG)clnoInvalid ||
+            IbJournal() < sizeof( CCacheHeader ) + cbCacheHeader ||
+            IbClusterStateTable( 0 ) < IbJournal() + CbJournal() ||
+            CbClusterStateTable() < sizeof( CClusterStateTableHeader ) + (QWORD)CCluster() * sizeof( CClusterState ) ||
+            IbCluster( (ClusterNumber)0 ) < IbClusterStateTable( cClusterStateTable ) )
+    {
+        Call( ErrERRCheck( JET_errReadVerifyFailure ) );
+    }
+
 HandleError:
     return err;
 }
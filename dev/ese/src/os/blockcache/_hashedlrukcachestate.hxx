@@ -12,12 +12,16 @@ enum class ClusterNumber : DWORD
     clnoInvalid = dwMax,
 };
 
+constexpr ClusterNumber clnoInvalid = ClusterNumber::clnoInvalid;
+
 
 enum class BlockNumber : DWORD
 {
     blnoInvalid = dwMax,
 };
 
+constexpr BlockNumber blnoInvalid = BlockNumber::blnoInvalid;
+
 
 enum class ClusterOperation : BYTE
 {
@@ -27,6 +31,11 @@ enum class ClusterOperation : BYTE
     clopAccess = 4,
 };
 
+constexpr ClusterOperation clopUpdate = ClusterOperation::clopUpdate;
+constexpr ClusterOperation clopWriteBack = ClusterOperation::clopWriteBack;
+constexpr ClusterOperation clopInvalidate = ClusterOperation::clopInvalidate;
+constexpr ClusterOperation clopAccess = ClusterOperation::clopAccess;
+
 
 enum class TouchNumber : DWORD
 {
@@ -158,4 +167,51 @@ class CJournalEntryHeader
 
 #include <poppack.h>
 
+
+#include <pshpack1.h>
+
+class CClusterStateTableHeader
+{
+    public:
+
+        CClusterStateTableHeader(   _In_ const QWORD            ulCheckpoint,
+                                    _In_ const JournalPosition  jposReplay,
+                                    _In_ const ULONG            cCluster,
+                                    _In_ const ULONG            ulStateChecksum )
+            :   m_le_ulChecksum( 0 ),
+                m_le_ulCheckpoint( ulCheckpoint ),
+                m_le_jposReplay( (QWORD)jposReplay ),
+                m_le_cCluster( cCluster ),
+                m_le_ulStateChecksum( ulStateChecksum ),
+                m_rgbPadding { 0 }
+        {
+            C_ASSERT( 0 == offsetof( CClusterStateTableHeader, m_le_ulChecksum ) );
+            C_ASSERT( CBlockCacheHeaderHelpers::cbBlock == sizeof( CClusterStateTableHeader ) );
+
+            m_le_ulChecksum = CBlockCacheHeaderHelpers::GenerateChecksum( this );
+        }
+
+        BOOL FValid() const { return m_le_ulChecksum == CBlockCacheHeaderHelpers::GenerateChecksum( this ); }
+        QWORD UlCheckpoint() const { return m_le_ulCheckpoint; }
+        JournalPosition JposReplay() const { return (JournalPosition)(QWORD)m_le_jposReplay; }
+        ULONG CCluster() const { return m_le_cCluster; }
+        ULONG UlStateChecksum() const { return m_le_ulStateChecksum; }
+
+    private:
+
+        UnalignedLittleEndian<ULONG>            m_le_ulChecksum;
+        const UnalignedLittleEndian<QWORD>      m_le_ulCheckpoint;
+        const UnalignedLittleEndian<QWORD>      m_le_jposReplay;
+        const UnalignedLittleEndian<ULONG>      m_le_cCluster;
+        const UnalignedLittleEndian<ULONG>      m_le_ulStateChecksum;
+        const BYTE                              m_rgbPadding[   CBlockCacheHeaderHelpers::cbBlock
+                                                                - sizeof( ULONG )
+                                                                - sizeof( QWORD )
+                                                                - sizeof( QWORD )
+                                                                - sizeof( ULONG )
+                                                                - sizeof( ULONG ) ];
+};
+
+#include <poppack.h>
+
 #pragma warning (pop)
@@ -187,7 +187,7 @@ ERR TPassThroughCache<I>::ErrRead(  _In_                    const TraceContext&
 
 
 
-    ReportMiss( pcfte, ibOffset, cbData, fTrue, cp != cpDontCache );
+    ReportMiss( pcfte, ibOffset, cbData, grbitQOS, fTrue, cp != cpDontCache );
 
 
     if ( offsets.FOverlaps( s_offsetsCachedFileHeader ) )
@@ -267,7 +267,7 @@ ERR TPassThroughCache<I>::ErrWrite( _In_                    const TraceContext&
 
 
   
-    ReportMiss( pcfte, ibOffset, cbData, fFalse, cp != cpDontCache );
+    ReportMiss( pcfte, ibOffset, cbData, grbitQOS, fFalse, cp != cpDontCache );
     ReportUpdate( pcfte, ibOffset, cbData );
     ReportWrite( pcfte, ibOffset, cbData, fTrue );
 
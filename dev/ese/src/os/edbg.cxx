@@ -11644,6 +11644,30 @@ DEBUG_EXT( EDBGDumpRMOutStandingResObjs )
             return;
 }
 
+RCE * PrceRCEChainEDBGAccessor( const VER * const pver, const UINT ui )
+{
+    const VER::RCEHEAD * const prcehead = &pver->m_rgrceheadHashTable[ pver->IrceheadRCEChain( ui ) ];
+    VER::RCECHAINS * prcechains = NULL;
+    RCE * prceChain = prceNil;
+
+    if ( NULL == prcehead->prcechains )
+    {
+        prceChain = prcehead->prceChain;
+    }
+    else if ( !FFetchVariable( prcehead->prcechains, &prcechains ) )
+    {
+        dprintf( "Error: Couldn't read RCE chains at 0x%p from the debuggee.\n", prcehead->prcechains );
+    }
+    else if ( !FReadVariable( prcechains->rgprceChain + VER::IprceRCEChain( prcechains, ui ), &prceChain ) )
+    {
+        dprintf( "Error: Couldn't read RCE chain array at 0x%p from the debuggee.\n", prcechains->rgprceChain );
+        prceChain = prceNil;
+    }
+
+    Unfetch( prcechains );
+    return prceChain;
+}
+
 DEBUG_EXT( EDBGHash )
 {
     ULONG   ifmp;
@@ -11706,14 +11730,14 @@ DEBUG_EXT( EDBGHash )
         bookmark.data.SetCb( cbData );
 
         size_t crcehead = pver->m_crceheadHashTable;
-        const ULONG ulVERChecksum = UiVERHash( IFMP( ifmp ), PGNO( pgnoFDP ), bookmark, crcehead );
+        const ULONG ulVERChecksum = UiVERHash( IFMP( ifmp ), PGNO( pgnoFDP ), bookmark );
         dprintf( "VER checksum is: %u (0x%08X)\n", ulVERChecksum, ulVERChecksum );
 
         Unfetch( pver );
         pver = NULL;
         if ( FFetchVariable( (BYTE *)( pinst->m_pver ), (BYTE **)&pver, sizeof(VER) + ( VER::cbrcehead * crcehead ) ) )
         {
-            RCE * prceHead  = pver->GetChain( ulVERChecksum );
+            RCE * prceHead  = PrceRCEChainEDBGAccessor( pver, ulVERChecksum );
             dprintf( "Head of RCE hash chain: 0x%p\n", prceHead );
 
             RCE * prceDebuggee  = prceHead;
@@ -12907,8 +12931,14 @@ DEBUG_EXT( EDBGVerStore )
 
         dwOffset = (BYTE *)pinst->m_pver - (BYTE *)pver;
         dprintf( "VER: 0x%N\n", pinst->m_pver );
-        dprintf( FORMAT_POINTER( VER, pver, m_pbucketGlobalHead, dwOffset ) );
-        dprintf( FORMAT_POINTER( VER, pver, m_pbucketGlobalTail, dwOffset ) );
+        dprintf( FORMAT_UINT( VER, pver, m_cbucketchain, dwOffset ) );
+        for ( size_t ibucketchain = 0; ibucketchain < pver->m_cbucketchain; ibucketchain++ )
+        {
+            dprintf( "\tm_rgbucketchain[%d]: pbucketHead=0x%N pbucketTail=0x%N\n",
+                        (ULONG)ibucketchain,
+                        pver->m_rgbucketchain[ ibucketchain ].pbucketHead,
+                        pver->m_rgbucketchain[ ibucketchain ].pbucketTail );
+        }
 
         dprintf( FORMAT_VOID( VER, pver, m_cresBucket, dwOffset ) );
         dprintf( FORMAT_UINT( VER, pver, m_cbBucket, dwOffset ) );
@@ -12991,7 +13021,8 @@ DEBUG_EXT( EDBGVerStore )
 
         BUCKET *    pbucket;
         BUCKET *    pbucketDebuggee;
-        for ( pbucketDebuggee = pver->m_pbucketGlobalTail;
+        for ( size_t ibucketchain = 0; ibucketchain < pver->m_cbucketchain; ibucketchain++ )
+        for ( pbucketDebuggee = pver->m_rgbucketchain[ ibucketchain ].pbucketTail;
             NULL != pbucketDebuggee;
             pbucketDebuggee = pbucket->hdr.pbucketNext )
         {
@@ -13491,6 +13522,8 @@ VOID EDBGVerHashSum( INST * pinstDebuggee, BOOL fVerbose )
     INST *      pinst                   = NULL;
     VER *       pver                    = NULL;
     VER::RCEHEAD *  prcehead            = NULL;
+    VER::RCECHAINS *    prcechains      = NULL;
+    RCE **          rgprceChain         = NULL;
     STAT::CPerfectHistogramStats    histoChains;
 
     dprintf( "\n" );
@@ -13519,93 +13552,118 @@ VOID EDBGVerHashSum( INST * pinstDebuggee, BOOL fVerbose )
     {
         VER::RCEHEAD * prceheadCurr = &(prcehead[ircehead]);
 
-        if ( fVerbose )
+        if ( prceheadCurr->prcechains &&
+            !FFetchVariable( prceheadCurr->prcechains, &prcechains ) )
         {
-            dprintf( "    m_rgrceheadHashTable[%04d].prceChain = %p", ircehead, prceheadCurr->prceChain );
+            dprintf( "Failed to get prcechains %N\n", prceheadCurr->prcechains );
+            goto HandleError;
         }
 
-        if ( prceheadCurr->prceChain )
+        if ( prcechains &&
+            !FFetchVariable( prcechains->rgprceChain, &rgprceChain, prcechains->cprceChain ) )
         {
-            crcechainsNonNull++;
+            dprintf( "Failed to get rgprceChain %N for %d entries\n", prcechains->rgprceChain, prcechains->cprceChain );
+            goto HandleError;
         }
 
-
-        INT chashOverflow = 0;
-        RCE * prceCurr = NULL;
-        for( RCE * prceCurrDebuggee = prceheadCurr->prceChain; prceCurrDebuggee; prceCurrDebuggee = prceCurr->m_prceHashOverflow )
+        const UINT cprceChain = prcechains ? prcechains->cprceChain : 1;
+        for( UINT iprceChain = 0; iprceChain < cprceChain; iprceChain++ )
         {
-            AssertEDBG( prceCurrDebuggee );
-
-            crcechainsEntries++;
-            chashOverflow++;
+            RCE * const prceChain = rgprceChain ? rgprceChain[ iprceChain ] : prceheadCurr->prceChain;
 
-            if ( prceCurr )
+            if ( fVerbose )
             {
-                Unfetch( prceCurr );
+                dprintf( "    m_rgrceheadHashTable[%04d][%04d].prceChain = %p", ircehead, iprceChain, prceChain );
             }
-            if ( !FFetchVariable( prceCurrDebuggee, &prceCurr ) )
+
+            if ( prceChain )
             {
-                dprintf( "Failed to get RCE %N\n ", prceCurrDebuggee );
-                goto HandleError;
+                crcechainsNonNull++;
             }
 
 
-            AssertEDBG( prceCurr->UiHash() == ( ircehead % pver->m_crceheadHashTable ) );
-            INT cnodeRCEs = 0;
-            RCE * prceCurrNode = NULL;
-            for ( RCE * prceCurrNodeDebuggee = prceCurrDebuggee; prceCurrNodeDebuggee; prceCurrNodeDebuggee = prceCurrNode->m_prcePrevOfNode )
+            INT chashOverflow = 0;
+            RCE * prceCurr = NULL;
+            for( RCE * prceCurrDebuggee = prceChain; prceCurrDebuggee; prceCurrDebuggee = prceCurr->m_prceHashOverflow )
             {
-                cnodeRCEs++;
-                crces++;
+                AssertEDBG( prceCurrDebuggee );
+
+                crcechainsEntries++;
+                chashOverflow++;
+
+                if ( prceCurr )
+                {
+                    Unfetch( prceCurr );
+                }
+                if ( !FFetchVariable( prceCurrDebuggee, &prceCurr ) )
+                {
+                    dprintf( "Failed to get RCE %N\n ", prceCurrDebuggee );
+                    goto HandleError;
+                }
 
+
+                AssertEDBG( ( prceCurr->UiHash() % pver->m_crceheadHashTable ) == (size_t)ircehead );
+                INT cnodeRCEs = 0;
+                RCE * prceCurrNode = NULL;
+                for ( RCE * prceCurrNodeDebuggee = prceCurrDebuggee; prceCurrNodeDebuggee; prceCurrNodeDebuggee = prceCurrNode->m_prcePrevOfNode )
+                {
+                    cnodeRCEs++;
+                    crces++;
+
+                    if ( prceCurrNode )
+                    {
+                        Unfetch( prceCurrNode );
+                    }
+                    if ( !FFetchVariable( prceCurrNodeDebuggee, &prceCurrNode ) )
+                    {
+                        dprintf( "Failed to fetch the RCE %N\n", prceCurrNodeDebuggee );
+                        goto HandleError;
+                    }
+                }
                 if ( prceCurrNode )
                 {
                     Unfetch( prceCurrNode );
                 }
-                if ( !FFetchVariable( prceCurrNodeDebuggee, &prceCurrNode ) )
+
+                if ( fVerbose )
                 {
-                    dprintf( "Failed to fetch the RCE %N\n", prceCurrNodeDebuggee );
-                    goto HandleError;
+                    dprintf (", %d", cnodeRCEs );
                 }
+
             }
-            if ( prceCurrNode )
+            if ( prceCurr )
             {
-                Unfetch( prceCurrNode );
+                Unfetch( prceCurr );
             }
 
             if ( fVerbose )
             {
-                dprintf (", %d", cnodeRCEs );
+                dprintf( ", chashOverflow = %d", chashOverflow );
             }
 
-        }
-        if ( prceCurr )
-        {
-            Unfetch( prceCurr );
-        }
-
-        if ( fVerbose )
-        {
-            dprintf( ", chashOverflow = %d", chashOverflow );
-        }
+            crcechainsEntriesCheck += chashOverflow;
+            const CPerfectHistogramStats::ERR errStats = histoChains.ErrAddSample( chashOverflow );
+            if ( CPerfectHistogramStats::ERR::errOutOfMemory == errStats )
+            {
+                Pdls()->AddWarning( "WARNING: Out of memory trying to add stat value during verhashsum.\n" );
+                goto HandleError;
+            }
+            else if ( errStats != CPerfectHistogramStats::ERR::errSuccess )
+            {
+                Pdls()->AddWarning( "WARNING: Could not add stat value during verhashsum.\n" );
+                goto HandleError;
+            }
 
-        crcechainsEntriesCheck += chashOverflow;
-        const CPerfectHistogramStats::ERR errStats = histoChains.ErrAddSample( chashOverflow );
-        if ( CPerfectHistogramStats::ERR::errOutOfMemory == errStats )
-        {
-            Pdls()->AddWarning( "WARNING: Out of memory trying to add stat value during verhashsum.\n" );
-            goto HandleError;
-        }
-        else if ( errStats != CPerfectHistogramStats::ERR::errSuccess )
-        {
-            Pdls()->AddWarning( "WARNING: Could not add stat value during verhashsum.\n" );
-            goto HandleError;
+            if ( fVerbose )
+            {
+                dprintf( "\n" );
+            }
         }
 
-        if ( fVerbose )
-        {
-            dprintf( "\n" );
-        }
+        Unfetch( rgprceChain );
+        rgprceChain = NULL;
+        Unfetch( prcechains );
+        prcechains = NULL;
     }
 
     AssertEDBG( crcechainsEntries == crcechainsEntriesCheck );
@@ -13620,6 +13678,8 @@ VOID EDBGVerHashSum( INST * pinstDebuggee, BOOL fVerbose )
     dprintf( "\n" );
 
 HandleError:
+    Unfetch( rgprceChain );
+    Unfetch( prcechains );
     Unfetch( prcehead );
 
     Unfetch( pver );
@@ -14915,6 +14975,13 @@ DEBUG_EXT( EDBGDecompress )
     dataToDecompress.SetPv( pbToDecompress );
     dataToDecompress.SetCb( cbToDecompress );
 
+    if ( FPKCompressedWithDictionary( dataToDecompress ) )
+    {
+        dprintf( "Error: The byte stream was compressed with a table compression dictionary, which cannot be loaded here.\n" );
+        err = ErrEDBGCheck( JET_errInvalidParameter );
+        goto HandleError;
+    }
+
     (void)ErrPKDecompressData( dataToDecompress, NULL, NULL, 0, (INT *)&cbDecompressed );
     pbDecompressed = new BYTE[cbDecompressed];
     if ( NULL == pbDecompressed )
@@ -15007,6 +15074,13 @@ DEBUG_EXT( EDBGDecrypt )
     data.SetPv( pbDecrypted );
     data.SetCb( cbDecrypted );
 
+    if ( fDecompress && FPKCompressedWithDictionary( data ) )
+    {
+        dprintf( "Error: The byte stream was compressed with a table compression dictionary, which cannot be loaded here.\n" );
+        err = ErrEDBGCheck( JET_errInvalidParameter );
+        goto HandleError;
+    }
+
     if ( fDecompress )
     {
         (void)ErrPKDecompressData( data, NULL, NULL, 0, (INT *)&cbDecompressed );
@@ -16254,6 +16328,7 @@ VOID FUCB::Dump( CPRINTF * pcprintf, DWORD_PTR ulBase ) const
     (*pcprintf)( FORMAT_POINTER( FUCB, this, pbEncryptionKey, ulBase ) );
 
     (*pcprintf)( FORMAT_POINTER( FUCB, this, pmoveFilterContext, ulBase ) );
+    (*pcprintf)( FORMAT_POINTER( FUCB, this, pretrieveplan, ulBase ) );
 
     (*pcprintf)( FORMAT_UINT( FUCB, this, cpgSpaceRequestReserve, ulBase ) );
 }
@@ -16767,6 +16842,8 @@ VOID LOG::Dump( CPRINTF * pcprintf, DWORD_PTR dwOffset ) const
 
     (*pcprintf)( FORMAT_POINTER( LOG, this, m_pctablehash, dwOffset ) );
     (*pcprintf)( FORMAT_POINTER( LOG, this, m_pcsessionhash, dwOffset ) );
+    (*pcprintf)( FORMAT_INT( LOG, this, m_cLGRedoPageWorker, dwOffset ) );
+    (*pcprintf)( FORMAT_POINTER( LOG, this, m_predopageworkers, dwOffset ) );
 
     (*pcprintf)( FORMAT_BOOL( LOG, this, m_fUseRecoveryLogFileSize, dwOffset ) );
     (*pcprintf)( FORMAT_INT( LOG, this, m_lLogFileSizeDuringRecovery, dwOffset ) );
@@ -16871,6 +16948,9 @@ VOID LOG_WRITE_BUFFER::Dump( CPRINTF * pcprintf, DWORD_PTR dwOffset ) const
     (*pcprintf)( FORMAT_VOID( LOG_WRITE_BUFFER, this, m_critLGWaitQ, dwOffset ) );
 
     (*pcprintf)( FORMAT_VOID( LOG_WRITE_BUFFER, this, m_msLGPendingCopyIntoBuffer, dwOffset ) );
+    (*pcprintf)( FORMAT_BOOL( LOG_WRITE_BUFFER, this, m_fCopyCompletionTracking, dwOffset ) );
+    (*pcprintf)( FORMAT_UINT( LOG_WRITE_BUFFER, this, m_icopyslotOldest, dwOffset ) );
+    (*pcprintf)( FORMAT_UINT( LOG_WRITE_BUFFER, this, m_icopyslotNext, dwOffset ) );
 
     (*pcprintf)( FORMAT_POINTER( LOG_WRITE_BUFFER, this, m_ppibLGWriteQHead, dwOffset ) );
     (*pcprintf)( FORMAT_POINTER( LOG_WRITE_BUFFER, this, m_ppibLGWriteQTail, dwOffset ) );
@@ -16959,9 +17039,8 @@ VOID VER::Dump( CPRINTF * pcprintf, DWORD_PTR dwOffset ) const
     (*pcprintf)( FORMAT_VOID( VER, this, m_asigRCECleanDone, dwOffset ) );
     (*pcprintf)( FORMAT_VOID( VER, this, m_critRCEClean, dwOffset ) );
 
-    (*pcprintf)( FORMAT_VOID( VER, this, m_critBucketGlobal, dwOffset ) );
-    (*pcprintf)( FORMAT_POINTER( VER, this, m_pbucketGlobalHead, dwOffset ) );
-    (*pcprintf)( FORMAT_POINTER( VER, this, m_pbucketGlobalTail, dwOffset ) );
+    (*pcprintf)( FORMAT_UINT( VER, this, m_cbucketchain, dwOffset ) );
+    (*pcprintf)( FORMAT_VOID( VER, this, m_rgbucketchain, dwOffset ) );
     (*pcprintf)( FORMAT_VOID( VER, this, m_cresBucket, dwOffset ) );
     (*pcprintf)( FORMAT_UINT( VER, this, m_cbBucket, dwOffset ) );
 
@@ -17686,6 +17765,7 @@ void BF::Dump( CPRINTF* pcprintf, DWORD_PTR dwOffset ) const
 
     (*pcprintf)( FORMAT_BOOL_BF( BF, this, fSuspiciouslySlowRead, dwOffset ) );
     (*pcprintf)( FORMAT_BOOL_BF( BF, this, fSyncRead, dwOffset ) );
+    (*pcprintf)( FORMAT_UINT( BF, this, iNumaNode, dwOffset ) );
 
     (*pcprintf)( FORMAT_UINT( BF, this, tce, dwOffset ) );
     (*pcprintf)( FORMAT_BOOL_BF( BF, this, bfbitfield.FDependentPurged(), dwOffset ) );
@@ -17780,6 +17860,7 @@ void BF::Dump( CPRINTF* pcprintf, DWORD_PTR dwOffset ) const
 
     (*pcprintf)( FORMAT_BOOL_BF( BF, this, fSuspiciouslySlowRead, dwOffset ) );
     (*pcprintf)( FORMAT_BOOL_BF( BF, this, fSyncRead, dwOffset ) );
+    (*pcprintf)( FORMAT_UINT( BF, this, iNumaNode, dwOffset ) );
 
     (*pcprintf)( FORMAT_UINT( BF, this, tce, dwOffset ) );
     (*pcprintf)( FORMAT_RBSPOS( BF, this, rbsposSnapshot, dwOffset ) );
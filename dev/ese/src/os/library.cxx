@@ -110,9 +110,12 @@ VOID OSLibraryValidateLoaderPolicy( const WCHAR * const mwszzDlls, OSLoadFlags o
                     mwszzDlls == g_mwszzRtlSupportLibs ||
                     mwszzDlls == g_mwszzCpuInfoLibs ||
                     mwszzDlls == g_mwszzSysInfoLibs ||
+                    mwszzDlls == g_mwszzSysTopologyLibs ||
+                    mwszzDlls == g_mwszzMemoryNumaLibs ||
                     mwszzDlls == g_mwszzHeapLibs ||
                     mwszzDlls == g_mwszzFileLibs ||
                     mwszzDlls == g_mwszzThreadpoolLibs ||
+                    mwszzDlls == g_mwszzIoRingLibs ||
                     mwszzDlls == g_mwszzRegistryLibs ||
                     mwszzDlls == g_mwszzSecSddlLibs ||
                     mwszzDlls == g_mwszzLocalizationLibs ||
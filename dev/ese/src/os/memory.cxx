@@ -1140,6 +1140,141 @@ HandleError:
 }
 
 
+BOOL FOSMemoryPageNumaNode( const void* const pv, DWORD* const piNode )
+{
+    MEMORY_WORKING_SET_EX_INFORMATION mwsexinfo;
+
+    *piNode = iOSMemoryNumaNodeNil;
+
+    mwsexinfo.VirtualAddress = (BYTE*)pv - DWORD_PTR( pv ) % OSMemoryPageCommitGranularity();
+    memset( &mwsexinfo.u1.VirtualAttributes, 0, sizeof( mwsexinfo.u1.VirtualAttributes ) );
+
+    if ( g_pfnQueryWorkingSetEx.ErrIsPresent() < JET_errSuccess ||
+         !g_pfnQueryWorkingSetEx( GetCurrentProcess(), (void*)&mwsexinfo, sizeof( mwsexinfo ) ) ||
+         !mwsexinfo.u1.VirtualAttributes.Valid )
+    {
+        return fFalse;
+    }
+
+    *piNode = (DWORD)mwsexinfo.u1.VirtualAttributes.Node;
+    return fTrue;
+}
+
+
+
+NTOSFuncStd( g_pfnGetNumaHighestNodeNumber, g_mwszzSysTopologyLibs, GetNumaHighestNodeNumber, oslfExpectedOnWin6 );
+NTOSFuncStd( g_pfnGetNumaProcessorNodeEx, g_mwszzSysTopologyLibs, GetNumaProcessorNodeEx, oslfExpectedOnWin7 );
+NTOSFuncPtr( g_pfnVirtualAllocExNuma, g_mwszzMemoryNumaLibs, VirtualAllocExNuma, oslfExpectedOnWin6 );
+NTOSFuncCount( g_pfnGetActiveProcessorGroupCount, g_mwszzSysInfoLibs, GetActiveProcessorGroupCount, oslfExpectedOnWin7 );
+NTOSFuncCount( g_pfnGetActiveProcessorCount, g_mwszzSysInfoLibs, GetActiveProcessorCount, oslfExpectedOnWin7 );
+NTOSFuncVoid( g_pfnGetCurrentProcessorNumberEx, g_mwszzCpuInfoLibs, GetCurrentProcessorNumberEx, oslfExpectedOnWin7 );
+
+LOCAL DWORD g_cNumaNode = 0;
+
+DWORD OSMemoryNumaNodeCount()
+{
+    if ( g_cNumaNode == 0 )
+    {
+        ULONG iNodeHighest = 0;
+        if (    g_pfnVirtualAllocExNuma.ErrIsPresent() < JET_errSuccess ||
+                g_pfnGetNumaProcessorNodeEx.ErrIsPresent() < JET_errSuccess ||
+                !g_pfnGetNumaHighestNodeNumber( &iNodeHighest ) )
+        {
+            iNodeHighest = 0;
+        }
+        g_cNumaNode = min( iNodeHighest + 1, cOSMemoryNumaNodeMax );
+    }
+
+    return g_cNumaNode;
+}
+
+//  Maps a flat processor index onto a processor group and the processor's number within that
+//  group, numbering the processors of each active group one after another.
+
+LOCAL BOOL FOSMemoryIProcessorNumber( const INT iProc, _Out_ PROCESSOR_NUMBER * const pprocnum )
+{
+    WORD    iGroup  = 0;
+    DWORD   iNumber = (DWORD)iProc;
+
+    if ( g_pfnGetActiveProcessorGroupCount.ErrIsPresent() >= JET_errSuccess &&
+         g_pfnGetActiveProcessorCount.ErrIsPresent() >= JET_errSuccess )
+    {
+        const WORD cGroup = g_pfnGetActiveProcessorGroupCount();
+        for ( ; iGroup < cGroup; iGroup++ )
+        {
+            const DWORD cProcGroup = g_pfnGetActiveProcessorCount( iGroup );
+            if ( iNumber < cProcGroup )
+            {
+                break;
+            }
+            iNumber -= cProcGroup;
+        }
+
+        if ( iGroup == cGroup )
+        {
+            return fFalse;
+        }
+    }
+
+    if ( iNumber > MAXBYTE )
+    {
+        return fFalse;
+    }
+
+    pprocnum->Group = iGroup;
+    pprocnum->Number = (BYTE)iNumber;
+    pprocnum->Reserved = 0;
+    return fTrue;
+}
+
+LOCAL DWORD OSMemoryINumaNodeProcessorNumber( PROCESSOR_NUMBER * const pprocnum )
+{
+    USHORT iNode = 0;
+
+    if ( !g_pfnGetNumaProcessorNodeEx( pprocnum, &iNode ) || iNode >= OSMemoryNumaNodeCount() )
+    {
+        return 0;
+    }
+
+    return iNode;
+}
+
+DWORD OSMemoryNumaNodeProcessor( const INT iProc )
+{
+    if ( OSMemoryNumaNodeCount() == 1 )
+    {
+        return 0;
+    }
+
+    PROCESSOR_NUMBER procnum;
+    if ( !FOSMemoryIProcessorNumber( iProc, &procnum ) )
+    {
+        return 0;
+    }
+
+    return OSMemoryINumaNodeProcessorNumber( &procnum );
+}
+
+DWORD OSMemoryNumaNodeCurrent()
+{
+    if ( OSMemoryNumaNodeCount() == 1 )
+    {
+        return 0;
+    }
+
+    //  the thread's processor index is only unique within its own group, so ask for the group too
+
+    if ( g_pfnGetCurrentProcessorNumberEx.ErrIsPresent() >= JET_errSuccess )
+    {
+        PROCESSOR_NUMBER procnum;
+        g_pfnGetCurrentProcessorNumberEx( &procnum );
+        return OSMemoryINumaNodeProcessorNumber( &procnum );
+    }
+
+    return OSMemoryNumaNodeProcessor( OSSyncGetCurrentProcessor() );
+}
+
+
 #if( defined(DEBUG) || !defined(OS_LAYER_VIOLATIONS) )
 
 
@@ -2605,7 +2740,7 @@ void OSMemoryPageUnprotect( void* const pv, const size_t cbSize )
 
 
 
-BOOL FOSMemoryPageCommit( void* const pv, const size_t cb )
+LOCAL BOOL FOSMemoryPageICommit( void* const pv, const size_t cb, const DWORD iNode )
 {
 
 
@@ -2634,7 +2769,9 @@ BOOL FOSMemoryPageCommit( void* const pv, const size_t cb )
 #endif
 
 
-    const BOOL fAllocOK = VirtualAlloc( pv, cb, MEM_COMMIT, PAGE_READWRITE ) != NULL;
+    const BOOL fAllocOK = (     iNode == iOSMemoryNumaNodeNil ?
+                                    VirtualAlloc( pv, cb, MEM_COMMIT, PAGE_READWRITE ) :
+                                    g_pfnVirtualAllocExNuma( GetCurrentProcess(), pv, cb, MEM_COMMIT, PAGE_READWRITE, iNode ) ) != NULL;
 
     if ( !fAllocOK )
     {
@@ -2653,6 +2790,22 @@ BOOL FOSMemoryPageCommit( void* const pv, const size_t cb )
     return fAllocOK;
 }
 
+BOOL FOSMemoryPageCommit( void* const pv, const size_t cb )
+{
+    return FOSMemoryPageICommit( pv, cb, iOSMemoryNumaNodeNil );
+}
+
+BOOL FOSMemoryPageCommitNuma( void* const pv, const size_t cb, const DWORD iNode )
+{
+    if ( iNode == iOSMemoryNumaNodeNil || OSMemoryNumaNodeCount() == 1 )
+    {
+        return FOSMemoryPageICommit( pv, cb, iOSMemoryNumaNodeNil );
+    }
+
+    Assert( iNode < OSMemoryNumaNodeCount() );
+    return FOSMemoryPageICommit( pv, cb, iNode );
+}
+
 
 
 void OSMemoryPageDecommit( void* const pv, const size_t cb )
@@ -4,11 +4,37 @@
 #include "osstd.hxx"
 
 
+LONG g_cBlockCachePrefetch;
+LONG g_cBlockCachePrefetchHit;
+
+#ifdef MINIMAL_FUNCTIONALITY
+#else
+
+LONG LOSBlockCachePrefetchCEFLPv( LONG iInstance, void* pvBuf )
+{
+    if ( pvBuf )
+        *( (ULONG*) pvBuf ) = g_cBlockCachePrefetch;
+
+    return 0;
+}
+
+LONG LOSBlockCachePrefetchHitCEFLPv( LONG iInstance, void* pvBuf )
+{
+    if ( pvBuf )
+        *( (ULONG*) pvBuf ) = g_cBlockCachePrefetchHit;
+
+    return 0;
+}
+
+#endif
+
+
 CDefaultCachedFileConfiguration::CDefaultCachedFileConfiguration()
     :   m_fCachingEnabled( fFalse ),
         m_wszAbsPathCachingFile( L"" ),
         m_cbBlockSize( 4096 ),
         m_cConcurrentBlockWriteBackMax( 100 ),
+        m_cBlockPrefetchMax( 16 ),
         m_lCacheTelemetryFileNumber( dwMax )
 {
 }
@@ -33,6 +59,11 @@ ULONG CDefaultCachedFileConfiguration::CConcurrentBlockWriteBackMax()
     return m_cConcurrentBlockWriteBackMax;
 }
 
+ULONG CDefaultCachedFileConfiguration::CBlockPrefetchMax()
+{
+    return m_cBlockPrefetchMax;
+}
+
 ULONG CDefaultCachedFileConfiguration::LCacheTelemetryFileNumber()
 {
     return m_lCacheTelemetryFileNumber;
@@ -531,3 +562,24 @@ HandleError:
     }
     return err;
 }
+
+ERR ErrOSBCGetHashedLRUKCacheJournal(   _In_    IFileSystemConfiguration* const pfsconfig,
+                                        _In_    IFileFilter* const              pff,
+                                        _Out_   QWORD* const                    pibJournal,
+                                        _Out_   QWORD* const                    pcbJournal )
+{
+    ERR                     err = JET_errSuccess;
+    CHashedLRUKCacheHeader* pch = NULL;
+
+    *pibJournal = 0;
+    *pcbJournal = 0;
+
+    Call( CHashedLRUKCacheHeader::ErrLoad( pfsconfig, pff, &pch ) );
+
+    *pibJournal = pch->IbJournal();
+    *pcbJournal = pch->CbJournal();
+
+HandleError:
+    delete pch;
+    return err;
+}
@@ -4,6 +4,9 @@
 #include "osstd.hxx"
 
 #include <winioctl.h>
+#ifdef NTDDI_WIN10_NI
+#include <ioringapi.h>
+#endif
 
 
 
@@ -23,6 +26,8 @@ const LOCAL OSDiskMappingMode g_diskModeDefault = eOSDiskOneDiskPerPhysicalDisk;
 
 void OSDiskIIOThreadTerm( void );
 ERR ErrOSDiskIIOThreadInit( void );
+void OSDiskIIOIoRingTerm();
+ERR ErrOSDiskIIOIoRingInit();
 
 
 
@@ -1662,6 +1667,8 @@ void OSDiskTerm()
 
     OSDiskIIOPatrolDogThreadTerm();
 
+    OSDiskIIOIoRingTerm();
+
     OSDiskIIOThreadTerm();
 
 
@@ -1717,6 +1724,8 @@ ERR ErrOSDiskInit()
 
     Call( ErrOSDiskIIOThreadInit() );
 
+    Call( ErrOSDiskIIOIoRingInit() );
+
     Call( ErrOSDiskIIOPatrolDogThreadInit() );
 
     return JET_errSuccess;
@@ -5413,6 +5422,574 @@ BOOL GetOverlappedResult_(  HANDLE          hFile,
 
 
 
+#ifdef NTDDI_WIN10_NI
+
+NTOSFuncCustom( g_pfnQueryIoRingCapabilities, g_mwszzIoRingLibs, QueryIoRingCapabilities, HrFailed, oslfExpectedOnWin10 );
+NTOSFuncStd( g_pfnIsIoRingOpSupported, g_mwszzIoRingLibs, IsIoRingOpSupported, oslfExpectedOnWin10 );
+NTOSFuncCustom( g_pfnCreateIoRing, g_mwszzIoRingLibs, CreateIoRing, HrFailed, oslfExpectedOnWin10 );
+NTOSFuncCustom( g_pfnSetIoRingCompletionEvent, g_mwszzIoRingLibs, SetIoRingCompletionEvent, HrFailed, oslfExpectedOnWin10 );
+NTOSFuncCustom( g_pfnBuildIoRingReadFile, g_mwszzIoRingLibs, BuildIoRingReadFile, HrFailed, oslfExpectedOnWin10 );
+NTOSFuncCustom( g_pfnBuildIoRingWriteFile, g_mwszzIoRingLibs, BuildIoRingWriteFile, HrFailed, oslfExpectedOnWin10 );
+NTOSFuncCustom( g_pfnBuildIoRingRegisterBuffers, g_mwszzIoRingLibs, BuildIoRingRegisterBuffers, HrFailed, oslfExpectedOnWin10 );
+NTOSFuncCustom( g_pfnSubmitIoRing, g_mwszzIoRingLibs, SubmitIoRing, HrFailed, oslfExpectedOnWin10 );
+NTOSFuncCustom( g_pfnPopIoRingCompletion, g_mwszzIoRingLibs, PopIoRingCompletion, HrFailed, oslfExpectedOnWin10 );
+NTOSFuncCustom( g_pfnCloseIoRing, g_mwszzIoRingLibs, CloseIoRing, HrFailed, oslfExpectedOnWin10 );
+
+
+
+class COSIoRing
+{
+    public:
+        COSIoRing();
+        ~COSIoRing();
+
+        ERR ErrInit();
+        void Term();
+
+        BOOL FTryIssue( IOREQ * const pioreq, const DWORD cbRun );
+        void Submit();
+
+        ERR ErrRegisterBuffer( void * const pv, const size_t cb );
+        void UnregisterBuffer( void * const pv, const size_t cb );
+
+    private:
+        enum { csqeRing = 1024, ccqeReapBatch = 64, cbufinfoMax = 64 };
+        static const UINT_PTR s_keyRegisterBuffers = 0;
+
+        //  tags the user data of an SQE that refers to a registered buffer by index (IOREQs
+        //  are at least pointer aligned, so the low bit is free)
+
+        static const UINT_PTR s_fRegisteredBufferRef = 0x1;
+
+        static DWORD DwCompletionThread( DWORD_PTR dwContext );
+        static void IoRingIComplete(    const DWORD     dwError,
+                                        const DWORD_PTR dwThreadContext,
+                                        const DWORD     dwCompletionKey1,
+                                        const DWORD_PTR dwCompletionKey2 );
+
+        void SubmitI_();
+        void ReapCompletions_();
+        void WaitForRegisteredBufferRefs_();
+        ERR ErrRegisterBuffers_();
+        IORING_BUFFER_REF BufferRef_( BYTE * const pb, const DWORD cb, BOOL * const pfRegistered ) const;
+
+        HIORING             m_hioring;
+        HANDLE              m_hevtCompletion;
+        THREAD              m_threadCompletion;
+        volatile BOOL       m_fTerm;
+        BOOL                m_fWriteSupported;
+
+        CCriticalSection    m_crit;
+        ULONG               m_csqePending;
+        ULONG               m_cbufinfoActive;
+
+        //  SQEs that refer to the registered buffer table and have not been reaped yet; the
+        //  table cannot be replaced until this drains
+
+        volatile LONG       m_csqeRegisteredRef;
+        CAutoResetSignal    m_asigRegisteredRefsDone;
+
+        CCriticalSection    m_critRegister;
+        CAutoResetSignal    m_asigRegistered;
+        HRESULT             m_hrRegistered;
+        ULONG               m_cbufinfo;
+        IORING_BUFFER_INFO  m_rgbufinfo[ cbufinfoMax ];
+};
+
+COSIoRing * g_posioring = NULL;
+
+COSIoRing::COSIoRing() :
+    m_hioring( NULL ),
+    m_hevtCompletion( NULL ),
+    m_threadCompletion( NULL ),
+    m_fTerm( fFalse ),
+    m_fWriteSupported( fFalse ),
+    m_crit( CLockBasicInfo( CSyncBasicInfo( "COSIoRing::m_crit" ), rankIoRing, 0 ) ),
+    m_csqePending( 0 ),
+    m_cbufinfoActive( 0 ),
+    m_csqeRegisteredRef( 0 ),
+    m_asigRegisteredRefsDone( CSyncBasicInfo( "COSIoRing::m_asigRegisteredRefsDone" ) ),
+    m_critRegister( CLockBasicInfo( CSyncBasicInfo( "COSIoRing::m_critRegister" ), rankIoRingRegister, 0 ) ),
+    m_asigRegistered( CSyncBasicInfo( "COSIoRing::m_asigRegistered" ) ),
+    m_hrRegistered( S_OK ),
+    m_cbufinfo( 0 )
+{
+    memset( m_rgbufinfo, 0, sizeof( m_rgbufinfo ) );
+}
+
+COSIoRing::~COSIoRing()
+{
+    Term();
+}
+
+ERR COSIoRing::ErrInit()
+{
+    ERR                 err     = JET_errSuccess;
+    IORING_CAPABILITIES caps;
+
+    if ( FAILED( g_pfnQueryIoRingCapabilities( &caps ) ) )
+    {
+        Error( ErrERRCheck( JET_errFeatureNotAvailable ) );
+    }
+
+    const IORING_CREATE_FLAGS flags = { IORING_CREATE_REQUIRED_FLAGS_NONE, IORING_CREATE_ADVISORY_FLAGS_NONE };
+    if ( FAILED( g_pfnCreateIoRing( caps.MaxVersion, flags, csqeRing, 2 * csqeRing, &m_hioring ) ) )
+    {
+        m_hioring = NULL;
+        Error( ErrERRCheck( JET_errFeatureNotAvailable ) );
+    }
+
+    if ( !g_pfnIsIoRingOpSupported( m_hioring, IORING_OP_READ ) ||
+         !g_pfnIsIoRingOpSupported( m_hioring, IORING_OP_REGISTER_BUFFERS ) )
+    {
+        Error( ErrERRCheck( JET_errFeatureNotAvailable ) );
+    }
+    m_fWriteSupported = g_pfnIsIoRingOpSupported( m_hioring, IORING_OP_WRITE );
+
+    Alloc( m_hevtCompletion = CreateEventW( NULL, FALSE, FALSE, NULL ) );
+    if ( FAILED( g_pfnSetIoRingCompletionEvent( m_hioring, m_hevtCompletion ) ) )
+    {
+        Error( ErrERRCheck( JET_errFeatureNotAvailable ) );
+    }
+
+    Call( ErrUtilThreadCreate(  DwCompletionThread,
+                                OSMemoryPageReserveGranularity(),
+                                priorityAboveNormal,
+                                &m_threadCompletion,
+                                (DWORD_PTR)this ) );
+
+HandleError:
+    if ( err < JET_errSuccess )
+    {
+        Term();
+    }
+    return err;
+}
+
+void COSIoRing::Term()
+{
+    if ( m_threadCompletion )
+    {
+        m_fTerm = fTrue;
+        SetEvent( m_hevtCompletion );
+        UtilThreadEnd( m_threadCompletion );
+        m_threadCompletion = NULL;
+    }
+
+    Assert( 0 == m_csqePending );
+
+    if ( m_hioring )
+    {
+        (void)g_pfnCloseIoRing( m_hioring );
+        m_hioring = NULL;
+    }
+    if ( m_hevtCompletion )
+    {
+        CloseHandle( m_hevtCompletion );
+        m_hevtCompletion = NULL;
+    }
+    m_cbufinfo = 0;
+    m_cbufinfoActive = 0;
+}
+
+IORING_BUFFER_REF COSIoRing::BufferRef_( BYTE * const pb, const DWORD cb, BOOL * const pfRegistered ) const
+{
+    Assert( m_crit.FOwner() );
+
+    for ( ULONG ibufinfo = 0; ibufinfo < m_cbufinfoActive; ibufinfo++ )
+    {
+        BYTE * const pbRegion = (BYTE *)m_rgbufinfo[ ibufinfo ].Address;
+        if ( pb >= pbRegion && pb + cb <= pbRegion + m_rgbufinfo[ ibufinfo ].Length )
+        {
+            *pfRegistered = fTrue;
+            return IoRingBufferRefFromIndexAndOffset( ibufinfo, ULONG( pb - pbRegion ) );
+        }
+    }
+
+    *pfRegistered = fFalse;
+    return IoRingBufferRefFromPointer( pb );
+}
+
+BOOL COSIoRing::FTryIssue( IOREQ * const pioreq, const DWORD cbRun )
+{
+    Assert( NULL == pioreq->pioreqIorunNext );
+
+    if ( pioreq->fWrite && !m_fWriteSupported )
+    {
+        return fFalse;
+    }
+
+    const IORING_HANDLE_REF refFile     = IoRingHandleRefFromHandle( pioreq->p_osf->hFile );
+    const UINT64            ibOffset    = ( UINT64( pioreq->ovlp.OffsetHigh ) << 32 ) | pioreq->ovlp.Offset;
+    HRESULT                 hr          = E_FAIL;
+    BOOL                    fRegistered = fFalse;
+
+    Assert( 0 == ( UINT_PTR( pioreq ) & s_fRegisteredBufferRef ) );
+
+    m_crit.Enter();
+
+    for ( INT iTry = 0; iTry < 2; iTry++ )
+    {
+        const IORING_BUFFER_REF refBuffer   = BufferRef_( (BYTE *)pioreq->pbData, cbRun, &fRegistered );
+        const UINT_PTR          keySqe      = UINT_PTR( pioreq ) | ( fRegistered ? s_fRegisteredBufferRef : 0 );
+        if ( pioreq->fWrite )
+        {
+            hr = g_pfnBuildIoRingWriteFile( m_hioring, refFile, refBuffer, cbRun, ibOffset, FILE_WRITE_FLAGS_NONE, keySqe, IOSQE_FLAGS_NONE );
+        }
+        else
+        {
+            hr = g_pfnBuildIoRingReadFile( m_hioring, refFile, refBuffer, cbRun, ibOffset, keySqe, IOSQE_FLAGS_NONE );
+        }
+
+        if ( hr != IORING_E_SUBMISSION_QUEUE_FULL )
+        {
+            break;
+        }
+        SubmitI_();
+    }
+
+    if ( SUCCEEDED( hr ) )
+    {
+        m_csqePending++;
+        if ( fRegistered )
+        {
+            AtomicIncrement( &m_csqeRegisteredRef );
+        }
+    }
+
+    m_crit.Leave();
+
+    return SUCCEEDED( hr );
+}
+
+void COSIoRing::SubmitI_()
+{
+    Assert( m_crit.FOwner() );
+
+    if ( 0 == m_csqePending )
+    {
+        return;
+    }
+
+    UINT32 csqeSubmitted = 0;
+    if ( SUCCEEDED( g_pfnSubmitIoRing( m_hioring, 0, 0, &csqeSubmitted ) ) )
+    {
+        m_csqePending -= min( csqeSubmitted, m_csqePending );
+    }
+}
+
+void COSIoRing::Submit()
+{
+    m_crit.Enter();
+    SubmitI_();
+    m_crit.Leave();
+}
+
+void COSIoRing::IoRingIComplete(    const DWORD     dwError,
+                                    const DWORD_PTR dwThreadContext,
+                                    const DWORD     dwCompletionKey1,
+                                    const DWORD_PTR dwCompletionKey2 )
+{
+    IOREQ * const pioreq        = (IOREQ *)dwCompletionKey2;
+    const DWORD   errorIO       = DWORD( pioreq->ovlp.Internal );
+    const DWORD   cbTransfer    = DWORD( pioreq->ovlp.InternalHigh );
+
+    SetLastError( errorIO );
+    OSDiskIIOThreadIComplete( errorIO, dwThreadContext, cbTransfer, pioreq );
+}
+
+void COSIoRing::ReapCompletions_()
+{
+    IORING_CQE  rgcqe[ ccqeReapBatch ];
+    ULONG       ccqe;
+
+    do
+    {
+        m_crit.Enter();
+        for ( ccqe = 0; ccqe < _countof( rgcqe ) && S_OK == g_pfnPopIoRingCompletion( m_hioring, &rgcqe[ ccqe ] ); ccqe++ )
+        {
+        }
+        m_crit.Leave();
+
+        for ( ULONG icqe = 0; icqe < ccqe; icqe++ )
+        {
+            const IORING_CQE& cqe = rgcqe[ icqe ];
+
+            if ( cqe.UserData == s_keyRegisterBuffers )
+            {
+                m_hrRegistered = cqe.ResultCode;
+                m_asigRegistered.Set();
+                continue;
+            }
+
+            IOREQ * const pioreq = (IOREQ *)( cqe.UserData & ~s_fRegisteredBufferRef );
+            if ( ( cqe.UserData & s_fRegisteredBufferRef ) && 0 == AtomicDecrement( &m_csqeRegisteredRef ) )
+            {
+                m_asigRegisteredRefsDone.Set();
+            }
+
+            if ( SUCCEEDED( cqe.ResultCode ) )
+            {
+                pioreq->ovlp.Internal = ERROR_SUCCESS;
+            }
+            else if ( HRESULT_FACILITY( cqe.ResultCode ) == FACILITY_WIN32 )
+            {
+                pioreq->ovlp.Internal = HRESULT_CODE( cqe.ResultCode );
+            }
+            else
+            {
+                pioreq->ovlp.Internal = ERROR_IO_DEVICE;
+            }
+            pioreq->ovlp.InternalHigh = cqe.Information;
+
+            while ( g_postaskmgrFile->ErrTMPost( IoRingIComplete, 0, DWORD_PTR( pioreq ) ) < JET_errSuccess )
+            {
+                UtilSleep( 1 );
+            }
+        }
+    }
+    while ( ccqe == _countof( rgcqe ) );
+}
+
+DWORD COSIoRing::DwCompletionThread( DWORD_PTR dwContext )
+{
+    COSIoRing * const posioring = (COSIoRing *)dwContext;
+
+    while ( !posioring->m_fTerm )
+    {
+        (void)WaitForSingleObjectEx( posioring->m_hevtCompletion, 100, FALSE );
+
+        posioring->Submit();
+        posioring->ReapCompletions_();
+    }
+
+    posioring->ReapCompletions_();
+    return 0;
+}
+
+//  Waits until no submitted or pending SQE refers to the registered buffer table.  The
+//  caller must already have stopped new SQEs from using it (m_cbufinfoActive == 0).
+
+void COSIoRing::WaitForRegisteredBufferRefs_()
+{
+    Assert( m_critRegister.FOwner() );
+    Assert( !m_crit.FOwner() );
+
+    while ( m_csqeRegisteredRef > 0 )
+    {
+        Submit();
+        m_asigRegisteredRefsDone.Wait();
+    }
+}
+
+ERR COSIoRing::ErrRegisterBuffers_()
+{
+    ERR     err = JET_errSuccess;
+    HRESULT hr  = E_FAIL;
+
+    Assert( m_critRegister.FOwner() );
+
+    m_crit.Enter();
+    m_cbufinfoActive = 0;
+    m_crit.Leave();
+
+    WaitForRegisteredBufferRefs_();
+
+    m_crit.Enter();
+    for ( INT iTry = 0; iTry < 2; iTry++ )
+    {
+        hr = g_pfnBuildIoRingRegisterBuffers( m_hioring, m_cbufinfo, m_rgbufinfo, s_keyRegisterBuffers );
+        if ( hr != IORING_E_SUBMISSION_QUEUE_FULL )
+        {
+            break;
+        }
+        SubmitI_();
+    }
+    if ( SUCCEEDED( hr ) )
+    {
+        m_csqePending++;
+        SubmitI_();
+    }
+    m_crit.Leave();
+
+    if ( FAILED( hr ) )
+    {
+        Error( ErrERRCheck( JET_errOutOfMemory ) );
+    }
+
+    m_asigRegistered.Wait();
+    if ( FAILED( m_hrRegistered ) )
+    {
+        Error( ErrERRCheck( JET_errOutOfMemory ) );
+    }
+
+    m_crit.Enter();
+    m_cbufinfoActive = m_cbufinfo;
+    m_crit.Leave();
+
+HandleError:
+    return err;
+}
+
+ERR COSIoRing::ErrRegisterBuffer( void * const pv, const size_t cb )
+{
+    ERR err = JET_errSuccess;
+
+    if ( cb > ulMax )
+    {
+        return ErrERRCheck( JET_errInvalidParameter );
+    }
+
+    m_critRegister.Enter();
+
+    if ( m_cbufinfo >= _countof( m_rgbufinfo ) )
+    {
+        Error( ErrERRCheck( JET_errOutOfMemory ) );
+    }
+
+    m_rgbufinfo[ m_cbufinfo ].Address = pv;
+    m_rgbufinfo[ m_cbufinfo ].Length = ULONG( cb );
+    m_cbufinfo++;
+
+    err = ErrRegisterBuffers_();
+    if ( err < JET_errSuccess )
+    {
+        m_cbufinfo--;
+    }
+
+HandleError:
+    m_critRegister.Leave();
+    return err;
+}
+
+void COSIoRing::UnregisterBuffer( void * const pv, const size_t cb )
+{
+    BOOL fRemoved = fFalse;
+
+    m_critRegister.Enter();
+
+    for ( ULONG ibufinfo = 0; ibufinfo < m_cbufinfo; )
+    {
+        BYTE * const pbRegion = (BYTE *)m_rgbufinfo[ ibufinfo ].Address;
+        if ( pbRegion >= (BYTE *)pv && pbRegion < (BYTE *)pv + cb )
+        {
+            if ( !fRemoved )
+            {
+                m_crit.Enter();
+                m_cbufinfoActive = 0;
+                m_crit.Leave();
+                fRemoved = fTrue;
+            }
+            m_rgbufinfo[ ibufinfo ] = m_rgbufinfo[ --m_cbufinfo ];
+        }
+        else
+        {
+            ibufinfo++;
+        }
+    }
+
+    if ( fRemoved )
+    {
+        //  ErrRegisterBuffers_ drains SQEs into the old table before it is replaced, so the
+        //  caller may free the memory once this returns
+
+        (void)ErrRegisterBuffers_();
+    }
+
+    m_critRegister.Leave();
+}
+
+#endif
+
+ERR ErrOSDiskIIOIoRingInit()
+{
+#ifdef NTDDI_WIN10_NI
+    ERR         err                 = JET_errSuccess;
+    const INT   cchBuf              = 16;
+    WCHAR       wszBuf[ cchBuf ];
+
+    Assert( NULL == g_posioring );
+
+    BOOL        fIoRing             = FOSConfigGet( L"OS/IO", L"IoRing", wszBuf, sizeof( wszBuf ) ) && 0 != _wtol( wszBuf );
+
+    fIoRing = (BOOL)UlConfigOverrideInjection( 59472, fIoRing );
+    if ( !fIoRing )
+    {
+        return JET_errSuccess;
+    }
+
+    Alloc( g_posioring = new COSIoRing() );
+
+    if ( g_posioring->ErrInit() < JET_errSuccess )
+    {
+        delete g_posioring;
+        g_posioring = NULL;
+    }
+
+HandleError:
+    return err;
+#else
+    return JET_errSuccess;
+#endif
+}
+
+void OSDiskIIOIoRingTerm()
+{
+#ifdef NTDDI_WIN10_NI
+    delete g_posioring;
+    g_posioring = NULL;
+#endif
+}
+
+INLINE BOOL FOSDiskIIoRingIssue( IOREQ * const pioreq, const DWORD cbRun )
+{
+#ifdef NTDDI_WIN10_NI
+    return g_posioring && g_posioring->FTryIssue( pioreq, cbRun );
+#else
+    return fFalse;
+#endif
+}
+
+INLINE void OSDiskIIoRingSubmit()
+{
+#ifdef NTDDI_WIN10_NI
+    if ( g_posioring )
+    {
+        g_posioring->Submit();
+    }
+#endif
+}
+
+BOOL FOSDiskRegistersIOBuffers()
+{
+#ifdef NTDDI_WIN10_NI
+    return g_posioring != NULL;
+#else
+    return fFalse;
+#endif
+}
+
+BOOL FOSDiskRegisterIOBuffer( void * const pv, const size_t cb )
+{
+#ifdef NTDDI_WIN10_NI
+    return g_posioring && g_posioring->ErrRegisterBuffer( pv, cb ) >= JET_errSuccess;
+#else
+    return fFalse;
+#endif
+}
+
+void OSDiskUnregisterIOBuffer( void * const pv, const size_t cb )
+{
+#ifdef NTDDI_WIN10_NI
+    if ( g_posioring )
+    {
+        g_posioring->UnregisterBuffer( pv, cb );
+    }
+#endif
+}
+
+
+
 DWORD ErrorIOMgrIssueIO(
     __in COSDisk::IORun*                    piorun,
     __in const IOREQ::IOMETHOD              iomethod,
@@ -5589,7 +6166,12 @@ DWORD ErrorIOMgrIssueIO(
             Assert( cbRun == pioreqHead->cbData );
             Assert( pioreqHead->p_osf->fRegistered );
 
-            if ( pioreqHead->fWrite )
+            if ( !fIOOSLowPriority && FOSDiskIIoRingIssue( pioreqHead, cbRun ) )
+            {
+                SetLastError( ERROR_IO_PENDING );
+                fIOSucceeded = fFalse;
+            }
+            else if ( pioreqHead->fWrite )
             {
                 fIOSucceeded = WriteFile( pioreqHead->p_osf->hFile,
                                                     pioreqHead->pbData,
@@ -7043,6 +7625,8 @@ ERR ErrOSDiskProcessIO(
 
 HandleError:
 
+    OSDiskIIoRingSubmit();
+
     if ( err == errDiskTilt )
     {
         OSDiskIIOThreadIRetryIssue();
@@ -102,6 +102,9 @@ using namespace std;
 #define wszEventLogLegacy       L"api-ms-win-eventlog-legacy-l1-1-0.dll"
 #define wszCoreKernel32Legacy   L"api-ms-win-core-kernel32-legacy-l1-1-0.dll"
 #define wszCoreWow64            L"api-ms-win-core-wow64-l1-1-0.dll"
+#define wszCoreSysTopology      L"api-ms-win-core-systemtopology-l1-1-0.dll"
+#define wszCoreMemory11         L"api-ms-win-core-memory-l1-1-1.dll"
+#define wszCoreIoRing           L"api-ms-win-core-ioring-l1-1-0.dll"
 
 #define wszCoreFile12           L"api-ms-win-core-file-l1-2-0.dll"
 
@@ -116,10 +119,13 @@ const wchar_t * const g_mwszzRtlSupportLibs     = wszRtlSupport L"\0"  wszNtdll
 
 const wchar_t * const g_mwszzCpuInfoLibs        = wszCoreProcessThreads L"\0"  wszKernel32 L"\0";
 const wchar_t * const g_mwszzSysInfoLibs        = wszCoreSysInfo L"\0"  wszKernel32 L"\0";
+const wchar_t * const g_mwszzSysTopologyLibs    = wszCoreSysTopology L"\0"  wszKernel32 L"\0";
+const wchar_t * const g_mwszzMemoryNumaLibs     = wszCoreMemory11 L"\0"  wszKernel32 L"\0";
 const wchar_t * const g_mwszzSyncLibs           = wszCoreSynch L"\0"  wszKernel32 L"\0";
 const wchar_t * const g_mwszzHeapLibs           = wszCoreHeap L"\0"  wszKernel32 L"\0";
 const wchar_t * const g_mwszzFileLibs           = wszCoreFile12 L"\0" wszCoreFile L"\0"  wszKernel32 L"\0"  wszKernelBase L"\0";
 const wchar_t * const g_mwszzThreadpoolLibs     = wszCoreThreadpool L"\0"  wszKernel32 L"\0";
+const wchar_t * const g_mwszzIoRingLibs         = wszCoreIoRing L"\0"  wszKernelBase L"\0";
 #ifdef ESENT
 const wchar_t * const g_mwszzLocalizationLibs   = wszCoreLoc L"\0"  wszKernel32 L"\0";
 #else
@@ -166,12 +172,14 @@ const wchar_t * const g_mwszzAdvapi32CoreSystemBroken       = wszAdvapi32 L"\0";
 
 const INT rankCritTaskList                  = 0;
 const INT rankAESProv                       = 1;
+const INT rankIoRing                        = 1;
 const INT rankIoStats                       = 1;
 const INT rankIOREQ                         = 2;
 const INT rankTimerTaskList                 = 3;
 const INT rankTimerTaskEntry                = 3;
 const INT rankIOREQPoolCrit     = 3;
 const INT rankOSDiskIOQueueCrit             = 4;
+const INT rankIoRingRegister                = 5;
 const INT rankOSDiskSXWL        = 6;
 const INT rankFTLFlushBuffs                 = 6;
 const INT rankFTLFlush                      = 7;
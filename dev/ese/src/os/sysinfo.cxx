@@ -481,6 +481,8 @@ LOCAL BOOL fSSEInstructionsAvailable;
 LOCAL BOOL fSSE2InstructionsAvailable;
 LOCAL BOOL g_fPopcntAvailable;
 LOCAL BOOL g_fAVXEnabled;
+LOCAL BOOL g_fAVX2Enabled;
+LOCAL BOOL g_fAVX512Enabled;
 
 BOOL FSSEInstructionsAvailable()
 {
@@ -502,6 +504,16 @@ BOOL FAVXEnabled()
     return g_fAVXEnabled;
 }
 
+BOOL FAVX2Enabled()
+{
+    return g_fAVX2Enabled;
+}
+
+BOOL FAVX512Enabled()
+{
+    return g_fAVX512Enabled;
+}
+
 BOOL FDeterminePopcntCapabilities()
 {
 #if ( defined _AMD64_ || defined _X86_ )
@@ -536,12 +548,58 @@ BOOL FDetermineAVXCapabilities()
 #endif
 }
 
+BOOL FDetermineAVX2Capabilities()
+{
+#if ( defined _AMD64_ || defined _X86_ )
+        INT cpuidInfo[4];
+        __cpuid(cpuidInfo, 0);
+        if ( cpuidInfo[0] < 7 )
+        {
+            return false;
+        }
+
+        __cpuidex(cpuidInfo, 7, 0);
+        return !!( cpuidInfo[1] & (1 << 5) );
+
+#else
+        return false;
+#endif
+}
+
+BOOL FDetermineAVX512Capabilities()
+{
+#if defined _AMD64_
+        INT cpuidInfo[4];
+        __cpuid(cpuidInfo, 0);
+        if ( cpuidInfo[0] < 7 )
+        {
+            return false;
+        }
+
+        __cpuidex(cpuidInfo, 7, 0);
+        const bool fAVX512FSupported = !!( cpuidInfo[1] & (1 << 16) );
+        const bool fAVX512VPOPCNTDQSupported = !!( cpuidInfo[2] & (1 << 14) );
+        if ( !fAVX512FSupported || !fAVX512VPOPCNTDQSupported )
+        {
+            return false;
+        }
+
+        unsigned __int64 xcrFeatureMask = _xgetbv( _XCR_XFEATURE_ENABLED_MASK );
+        return ( ( xcrFeatureMask & 0xe6 ) == 0xe6 );
+
+#else
+        return false;
+#endif
+}
+
 LOCAL VOID DetermineProcessorCapabilities()
 {
     fSSEInstructionsAvailable   = IsProcessorFeaturePresent( PF_XMMI_INSTRUCTIONS_AVAILABLE );
     fSSE2InstructionsAvailable  = IsProcessorFeaturePresent( PF_XMMI64_INSTRUCTIONS_AVAILABLE );
     g_fPopcntAvailable            = FDeterminePopcntCapabilities();
     g_fAVXEnabled                 = FDetermineAVXCapabilities();
+    g_fAVX2Enabled                = g_fAVXEnabled && FDetermineAVX2Capabilities();
+    g_fAVX512Enabled              = g_fAVX2Enabled && FDetermineAVX512Capabilities();
 }
 
 
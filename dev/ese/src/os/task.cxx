@@ -15,6 +15,8 @@ LOCAL const CHAR * const    szAsigAllDone       = "CGPTaskManager::m_asigAllDone
 
 LOCAL const CHAR * const    szRwlPostTasks      = "CGPTaskManager::m_rwlPostTasks";
 
+LOCAL const CHAR * const    szMsigJobsDone      = "CTMJobs::m_msigJobsDone";
+
 
 
 
@@ -1043,3 +1045,138 @@ void TaskInfoGenericStats::ReportTaskInfo(const TaskInfoGeneric & taskInfo)
 
 
 
+//  shared by the caller and the tasks posted by TMRunJobs; the last reference frees it, which
+//  may be a posted task that started after the caller returned
+
+class CTMJobs
+{
+    public:
+        CTMJobs( const PFNTMJOB pfnJob, VOID * const pvJobs, const LONG cjob, const PFNTMWORKER pfnWorker, VOID * const pvWorker, const LONG cref ) :
+            m_pfnJob( pfnJob ),
+            m_pvJobs( pvJobs ),
+            m_cjob( cjob ),
+            m_pfnWorker( pfnWorker ),
+            m_pvWorker( pvWorker ),
+            m_ijobNext( 0 ),
+            m_cjobPending( cjob ),
+            m_cref( cref ),
+            m_msigJobsDone( CSyncBasicInfo( szMsigJobsDone ) )
+        {
+        }
+
+        static DWORD DispatchWorker( VOID * const pvThis );
+
+        VOID RunJobs( const BOOL fWorker );
+        VOID WaitForJobs()      { m_msigJobsDone.Wait(); }
+        VOID Release();
+
+    private:
+        ~CTMJobs() {}
+
+        VOID CompleteJob_();
+
+    private:
+        const PFNTMJOB          m_pfnJob;
+        VOID * const            m_pvJobs;
+        const LONG              m_cjob;
+        const PFNTMWORKER       m_pfnWorker;
+        VOID * const            m_pvWorker;
+        volatile LONG           m_ijobNext;
+        volatile LONG           m_cjobPending;
+        volatile LONG           m_cref;
+        CManualResetSignal      m_msigJobsDone;
+};
+
+DWORD CTMJobs::DispatchWorker( VOID * const pvThis )
+{
+    CTMJobs * const ptmjobs = (CTMJobs *)pvThis;
+    ptmjobs->RunJobs( fTrue );
+    ptmjobs->Release();
+    return 0;
+}
+
+//  The last job a thread runs is only marked complete after pfnWorker( fFalse ), because
+//  completing it may let the caller return and release pvWorker.
+
+VOID CTMJobs::RunJobs( const BOOL fWorker )
+{
+    LONG ijob = AtomicIncrement( &m_ijobNext ) - 1;
+    if ( ijob >= m_cjob )
+    {
+        return;
+    }
+
+    const BOOL fNotify = fWorker && m_pfnWorker != NULL;
+    if ( fNotify )
+    {
+        m_pfnWorker( m_pvWorker, fTrue );
+    }
+
+    for ( ; ; )
+    {
+        m_pfnJob( m_pvJobs, ijob );
+
+        const LONG ijobNext = AtomicIncrement( &m_ijobNext ) - 1;
+        if ( ijobNext >= m_cjob )
+        {
+            break;
+        }
+        CompleteJob_();
+        ijob = ijobNext;
+    }
+
+    if ( fNotify )
+    {
+        m_pfnWorker( m_pvWorker, fFalse );
+    }
+    CompleteJob_();
+}
+
+VOID CTMJobs::Release()
+{
+    if ( AtomicDecrement( &m_cref ) == 0 )
+    {
+        delete this;
+    }
+}
+
+VOID CTMJobs::CompleteJob_()
+{
+    if ( AtomicDecrement( &m_cjobPending ) == 0 )
+    {
+        m_msigJobsDone.Set();
+    }
+}
+
+VOID TMRunJobs( CGPTaskManager * const  ptaskmgr,
+                const LONG              cthreadMax,
+                const PFNTMJOB          pfnJob,
+                VOID * const            pvJobs,
+                const LONG              cjob,
+                const PFNTMWORKER       pfnWorker,
+                VOID * const            pvWorker )
+{
+    const LONG      cworker = ptaskmgr ? min( cjob, cthreadMax ) - 1 : 0;
+    CTMJobs * const ptmjobs = cworker > 0 ? new CTMJobs( pfnJob, pvJobs, cjob, pfnWorker, pvWorker, cworker + 1 ) : NULL;
+
+    if ( NULL == ptmjobs )
+    {
+        for ( LONG ijob = 0; ijob < cjob; ijob++ )
+        {
+            pfnJob( pvJobs, ijob );
+        }
+        return;
+    }
+
+    for ( LONG iworker = 0; iworker < cworker; iworker++ )
+    {
+        if ( ptaskmgr->ErrTMPost( CTMJobs::DispatchWorker, ptmjobs ) < JET_errSuccess )
+        {
+            ptmjobs->Release();
+        }
+    }
+
+    ptmjobs->RunJobs( fFalse );
+    ptmjobs->WaitForJobs();
+    ptmjobs->Release();
+}